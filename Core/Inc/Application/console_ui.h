@@ -4,6 +4,9 @@
  *  Created on: Jun 2, 2025
  *      Author: rohitimandi
  *  Updated: Added support for hierarchical menu system and multiplayer games
+ *  Modified on: Oct 18, 2026
+ *      Game rendering is its own call so the scheduler can run it as a task
+ *      Timed screens are stepped from the UI task
  */
 
 #ifndef INC_APPLICATION_CONSOLE_UI_H_
@@ -34,10 +37,12 @@ void console_ui_clear_screen(void);
 void console_ui_show_screen(ScreenType screen);
 void console_ui_show_menu(MenuItem* items, uint8_t num_items);
 void console_ui_handle_input(JoystickStatus js_status);
+bool console_ui_update_screen(void);    /* Boot, welcome and error screens - false while booting */
 
 /* Game interface functions */
 MenuItem console_ui_get_selected_menu_item(void);
 void console_ui_run_game(void);
+void console_ui_render_game(void);
 bool console_ui_is_game_active(void);
 void console_ui_set_game_active(bool is_active);
 
@@ -3,6 +3,9 @@
  *
  *  Created on: Jun 2, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Game frames are rendered separately from the update
+ *      Boot, welcome and error screens are timed and never block
  */
 
 #ifndef INC_APPLICATION_GAME_CONTROLLER_H_
@@ -18,6 +21,7 @@
 
 /* Application states */
 typedef enum {
+    APP_STATE_BOOT,          /* Display still initialising */
     APP_STATE_WELCOME,
     APP_STATE_MENU,
     APP_STATE_GAME_ACTIVE,
@@ -28,12 +32,15 @@ typedef enum {
 /* Status update intervals */
 #define STATUS_BAR_UPDATE_INTERVAL 1000  /* Update status bar every 1 sec */
 #define MENU_REFRESH_THROTTLE      100   /* Throttle menu updates to 100ms */
+#define WELCOME_SCREEN_TIME        3000  /* Welcome screen before the menu */
 
 /* Game controller initialization and main loop */
 void game_controller_init(MenuItem* menu_items, uint8_t menu_count);
 void game_controller_init_with_default_menu(void);  /* Convenience function */
 void game_controller_update(void);
+bool game_controller_update_screen(void);     /* Step timed screens, false until the display is up */
 void game_controller_handle_input(JoystickStatus js_status);
+uint32_t game_controller_get_boot_time_ms(void);  /* Reset to first menu, 0 until then */
 
 /* State management functions */
 AppState game_controller_get_state(void);
@@ -45,7 +52,8 @@ void game_controller_return_to_menu(void);
 
 /* Game management functions */
 bool game_controller_is_game_active(void);
-void game_controller_run_game_loop(void);
+void game_controller_run_game_loop(void);      /* One frame, called at FRAME_RATE by the scheduler */
+void game_controller_render_game(void);        /* Draw the frame the last loop produced */
 GameEngine* game_controller_get_current_game_engine(void);
 
 /* Input handling functions */
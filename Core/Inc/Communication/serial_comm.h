@@ -3,6 +3,11 @@
  *
  *  Created on: Jul 16, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Added the transmit service and statistics
+ *      Added the game state callback
+ *      Game data can carry the caller's sequence number
+ *      Added the body sync callback
  */
 
 #ifndef INC_COMMUNICATION_SERIAL_COMM_H_
@@ -37,6 +42,8 @@ const char* serial_comm_get_error_message(void);
 
 /* Basic message sending (maps to protocol layer) */
 UART_Status serial_comm_send_game_data(const char* data_type, const char* game_data, const char* metadata);
+UART_Status serial_comm_send_game_data_with_sequence(const char* data_type, const char* game_data,
+    const char* metadata, uint32_t sequence);  /* e.g. an input the server acknowledges by number */
 UART_Status serial_comm_send_chat_message(const char* message, const char* sender, const char* chat_type);
 UART_Status serial_comm_send_command(const char* command, const char* parameters);
 UART_Status serial_comm_send_status(uint8_t system_status, uint8_t error_code, const char* message);
@@ -58,6 +65,8 @@ int serial_comm_get_opponent_player_id(void);
 
 /* Callback registration (maps to callbacks layer) */
 void serial_comm_register_game_data_callback(game_data_received_callback_t callback);
+void serial_comm_register_game_state_callback(game_state_received_callback_t callback);
+void serial_comm_register_body_sync_callback(body_sync_received_callback_t callback);
 void serial_comm_register_chat_message_callback(chat_message_received_callback_t callback);
 void serial_comm_register_command_callback(command_received_callback_t callback);
 void serial_comm_register_status_callback(status_received_callback_t callback);
@@ -65,6 +74,10 @@ void serial_comm_register_connection_message_callback(connection_message_callbac
 
 /* Utility functions */
 void serial_comm_print_stats(void);
+uint32_t serial_comm_get_drop_count(void);     /* RX bytes lost to a full DMA buffer */
+void serial_comm_service_tx(void);             /* Start the next queued frame once the UART is free */
+void serial_comm_register_tx_done_callback(void (*callback)(void));    /* Called from the UART interrupt */
+const comm_stats_t* serial_comm_get_stats(void);   /* Including TX queue depth and send times */
 void serial_comm_send_debug(const char* message, uint32_t timeout);
 
 #endif /* INC_COMMUNICATION_SERIAL_COMM_H_ */
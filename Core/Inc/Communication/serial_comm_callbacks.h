@@ -3,6 +3,9 @@
  *
  *  Created on: Jul 16, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Added the game state callback
+ *      Added the body sync callback
  */
 
 #ifndef INC_COMMUNICATION_SERIAL_COMM_CALLBACKS_H_
@@ -16,6 +19,8 @@ void callbacks_deinit(void);
 
 /* Callback registration functions */
 void callbacks_register_game_data(game_data_received_callback_t callback);
+void callbacks_register_game_state(game_state_received_callback_t callback);
+void callbacks_register_body_sync(body_sync_received_callback_t callback);
 void callbacks_register_chat_message(chat_message_received_callback_t callback);
 void callbacks_register_command(command_received_callback_t callback);
 void callbacks_register_status(status_received_callback_t callback);
@@ -23,6 +28,8 @@ void callbacks_register_connection_message(connection_message_callback_t callbac
 
 /* Message handling functions - called by protocol layer */
 void callbacks_handle_game_data(const uart_game_data_t* game_data);
+void callbacks_handle_game_state(const uart_game_state_t* game_state);
+void callbacks_handle_body_sync(const uart_body_sync_t* body_sync);
 void callbacks_handle_chat_message(const uart_chat_message_t* chat_message);
 void callbacks_handle_command(const uart_command_t* command);
 void callbacks_handle_status(const uart_status_t* status);
@@ -0,0 +1,23 @@
+/*
+ * serial_comm_game_state.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Decodes the body sync message
+ *
+ *  Decoding of the binary game state message the ESP32 sends
+ */
+
+#ifndef INC_COMMUNICATION_SERIAL_COMM_GAME_STATE_H_
+#define INC_COMMUNICATION_SERIAL_COMM_GAME_STATE_H_
+
+#include "serial_comm_types.h"
+
+/* False if the payload is not a whole game state of this version, state is then left as it was */
+bool game_state_decode(const uint8_t* data, uint8_t length, uart_game_state_t* state);
+
+/* False if the payload is not a whole keyframe or delta, body_sync is then left as it was */
+bool body_sync_decode(const uint8_t* data, uint8_t length, uart_body_sync_t* body_sync);
+
+#endif /* INC_COMMUNICATION_SERIAL_COMM_GAME_STATE_H_ */
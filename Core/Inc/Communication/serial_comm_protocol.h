@@ -3,6 +3,8 @@
  *
  *  Created on: Jul 16, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Game data can carry the caller's sequence number
  */
 
 #ifndef INC_COMMUNICATION_SERIAL_COMM_PROTOCOL_H_
@@ -34,6 +36,8 @@ const char* protocol_get_error_message(void);
 /* Message sending functions */
 UART_Status protocol_send_message(MessageType type, const uint8_t* data, uint8_t length);
 UART_Status protocol_send_game_data(const char* data_type, const char* game_data, const char* metadata);
+UART_Status protocol_send_game_data_with_sequence(const char* data_type, const char* game_data, const char* metadata,
+    uint32_t sequence);
 UART_Status protocol_send_chat_message(const char* message, const char* sender, const char* chat_type);
 UART_Status protocol_send_command(const char* command, const char* parameters);
 UART_Status protocol_send_status(uint8_t system_status, uint8_t error_code, const char* message);
@@ -3,12 +3,19 @@
  *
  *  Created on: Jul 16, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Messages go on the wire as variable length frames, the struct is only held in memory
+ *      Received messages are handed over as a view of the slot they were decoded in
+ *      Added the binary game state message
+ *      Game state version 2 acknowledges each player's inputs
+ *      Added the snake body sync message
  */
 
 #ifndef INC_COMMUNICATION_SERIAL_COMM_TYPES_H_
 #define INC_COMMUNICATION_SERIAL_COMM_TYPES_H_
 
 #include <stdint.h>
+#include <stdbool.h>
  // #include "Console_Peripherals/Hardware/serial_comm_core.h"
 #include "../Console_Peripherals/Hardware/common_status_types.h"
 
@@ -28,9 +35,47 @@ typedef enum {
     MSG_TYPE_HEARTBEAT = 0x07,
     MSG_TYPE_CHAT = 0x08,
     MSG_TILE_SIZE_VALIDATION = 0x09,
+    MSG_TYPE_GAME_STATE = 0x0A,
+    MSG_TYPE_BODY_SYNC = 0x0B,
 } MessageType;
 
-/* Message Structure */
+/* Game State Message - MSG_TYPE_GAME_STATE payload, must match the ESP32's game_state_encoder.h.
+ * Little-endian, fixed field widths, positions in server cells:
+ *   version (1) | player count (1) | tick (4) | food x (1) | food y (1) | player records
+ * and each player record, in player id order:
+ *   head x (1) | head y (1) | length (1) | direction (1) | flags (1) | score (2) | input ack (2)
+ * input ack is the sequence_num of the last of the player's inputs the server applied. */
+#define GAME_STATE_VERSION          2
+#define GAME_STATE_MAX_PLAYERS      2
+#define GAME_STATE_HEADER_SIZE      8
+#define GAME_STATE_PLAYER_SIZE      9
+#define GAME_STATE_SIZE(players)    (GAME_STATE_HEADER_SIZE + (players) * GAME_STATE_PLAYER_SIZE)
+#define GAME_STATE_FLAG_ALIVE       0x01
+
+/* Body Sync Message - MSG_TYPE_BODY_SYNC payload, must match the ESP32's body_sync_encoder.h.
+ * One player's body as 2-bit moves, code k is the move from body segment k to segment k - 1,
+ * the head being segment -1. Codes are packed four to a byte, code k at bits 2 * (k % 4).
+ * Keyframe, the whole body anchored at the head:
+ *   kind (1) | player id (1) | tick (4) | head x (1) | head y (1) | length (1) | codes
+ * Delta, the moves since the previous tick it was sent for, oldest in the low bits, and the
+ * length after them; the tail is trimmed to it:
+ *   kind (1) | player id (1) | tick (4) | move count (1) | moves (1) | length (1) */
+#define BODY_SYNC_KIND_KEYFRAME         1
+#define BODY_SYNC_KIND_DELTA            2
+#define BODY_SYNC_MAX_SEGMENTS          64
+#define BODY_SYNC_MAX_MOVES             4
+#define BODY_SYNC_CODE_BYTES(segments)  (((segments) + 3) / 4)
+#define BODY_SYNC_KEYFRAME_HEADER_SIZE  9
+#define BODY_SYNC_KEYFRAME_SIZE(segments) (BODY_SYNC_KEYFRAME_HEADER_SIZE + BODY_SYNC_CODE_BYTES(segments))
+#define BODY_SYNC_DELTA_SIZE            9
+#define BODY_SYNC_CODE_UP               0   /* Codes are DPAD_DIR_UP + code */
+#define BODY_SYNC_CODE_RIGHT            1
+#define BODY_SYNC_CODE_DOWN             2
+#define BODY_SYNC_CODE_LEFT             3
+
+/* Message Structure - as queued for sending. On the wire only the type, length
+ * and the used part of data are sent, in a COBS frame with a sequence number and CRC-32
+ * (serial_frame_encode() in serial_frame.h); checksum is not used. */
 #pragma pack(push, 1)
 typedef struct {
     uint8_t start_byte;
@@ -42,6 +87,16 @@ typedef struct {
 } uart_message_t;
 #pragma pack(pop)
 
+/* Received Message - points into the receive slot the frame was decoded in. Only valid until
+ * the message is released, e.g. until the message callback returns; handlers read the payload
+ * in place and copy only what they keep. */
+typedef struct {
+    uint8_t msg_type;
+    uint8_t length;
+    uint16_t sequence;
+    const uint8_t* data;
+} uart_message_view_t;
+
 /* Protocol States */
 typedef enum {
     PROTO_STATE_INIT,                    // Initial state - waiting for ESP32
@@ -99,12 +154,49 @@ typedef struct {
 } uart_tile_size_validation_t;
 #pragma pack(pop)
 
+/* Game state as decoded by game_state_decode(), not the wire layout */
+typedef struct {
+    uint8_t head_x;
+    uint8_t head_y;
+    uint8_t length;
+    uint8_t direction;
+    bool alive;
+    uint16_t score;
+    uint16_t input_ack;
+} uart_game_state_player_t;
+
+typedef struct {
+    uint32_t tick;          // Server tick the state was taken at
+    uint8_t food_x;
+    uint8_t food_y;
+    uint8_t player_count;
+    uart_game_state_player_t players[GAME_STATE_MAX_PLAYERS];
+} uart_game_state_t;
+
+/* Body sync as decoded by body_sync_decode() */
+typedef struct {
+    uint8_t kind;
+    uint8_t player_id;
+    uint32_t tick;          // Server tick the body is at after it
+    uint8_t length;         // Body segments, without the head
+    uint8_t head_x;         // Keyframe only
+    uint8_t head_y;
+    uint8_t move_count;     // Delta only
+    uint8_t codes[BODY_SYNC_CODE_BYTES(BODY_SYNC_MAX_SEGMENTS)];    // Moves of a delta, the body of a keyframe
+} uart_body_sync_t;
+
+static inline uint8_t body_sync_code(const uint8_t* codes, uint8_t index) {
+    return (codes[index / 4] >> (2 * (index % 4))) & 0x03;
+}
+
 /* Callback function types */
 typedef void (*game_data_received_callback_t)(const uart_game_data_t* game_data);
+typedef void (*game_state_received_callback_t)(const uart_game_state_t* game_state);
+typedef void (*body_sync_received_callback_t)(const uart_body_sync_t* body_sync);
 typedef void (*chat_message_received_callback_t)(const uart_chat_message_t* chat_message);
 typedef void (*command_received_callback_t)(const uart_command_t* command);
 typedef void (*status_received_callback_t)(const uart_status_t* status);
 typedef void (*connection_message_callback_t)(const uart_connection_message_t* connection_msg);
-typedef void (*uart_message_received_callback_t)(const uart_message_t* message);
+typedef void (*uart_message_received_callback_t)(const uart_message_view_t* message);
 
 #endif /* INC_COMMUNICATION_SERIAL_COMM_TYPES_H_ */
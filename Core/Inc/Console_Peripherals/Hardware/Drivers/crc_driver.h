@@ -0,0 +1,24 @@
+/*
+ * crc_driver.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  The CRC calculation unit. It has one fixed mode: CRC-32 with polynomial 0x04C11DB7,
+ *  reset to 0xFFFFFFFF, taking a 32-bit word per write and shifting it in MSB first,
+ *  with no reflection and no final XOR. Fed a buffer's bytes big-endian it gives
+ *  CRC-32/MPEG-2, the same as crc32_mpeg2() in comm_utils.h, in 4 AHB cycles a word.
+ *
+ *  There is a single unit and a computation runs start to end in one call, so it is
+ *  only used from the main loop.
+ */
+
+#ifndef INC_CONSOLE_PERIPHERALS_HARDWARE_DRIVERS_CRC_DRIVER_H_
+#define INC_CONSOLE_PERIPHERALS_HARDWARE_DRIVERS_CRC_DRIVER_H_
+
+#include <stdint.h>
+
+void crc_driver_init(void);     // Clock the unit
+uint32_t crc_driver_compute(const uint8_t* data, uint16_t length);
+
+#endif /* INC_CONSOLE_PERIPHERALS_HARDWARE_DRIVERS_CRC_DRIVER_H_ */
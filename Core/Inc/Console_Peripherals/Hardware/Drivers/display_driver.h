@@ -3,6 +3,9 @@
  *
  *  Created on: Jan 11, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Added display_get_dirty_region()
+ *      Added the non-blocking display_init_start() / display_init_poll()
  */
 
 #ifndef INC_CONSOLE_PERIPHERALS_HARDWARE_DRIVERS_DISPLAY_DRIVER_H_
@@ -13,6 +16,7 @@
 //#define DISPLAY_MODULE_OLED 1
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <Utils/misc_utils.h>
 #include "string.h"
 
@@ -28,8 +32,6 @@
 #endif
 
 // Display dimensions
-#ifndef UNITY_TEST
-
 #if defined(DISPLAY_MODULE_OLED)
 #define DISPLAY_WIDTH    SSD1306_WIDTH
 #define DISPLAY_HEIGHT   SSD1306_HEIGHT
@@ -49,8 +51,6 @@ typedef uint16_t coord_t;
 typedef uint8_t coord_t;
 #endif
 
-#endif /* UNITY_TEST */
-
 // Display colors
 typedef enum {
     DISPLAY_BLACK = 0x00,
@@ -64,13 +64,19 @@ typedef struct {
     uint8_t height;
     const uint16_t *data;
 } FontDef;
+
+extern FontDef Font_7x10;
 #endif
 
 // Display driver interface
 void display_init(void);
+void display_init_start(void);      // Non-blocking init, poll until it reports ready
+bool display_init_poll(void);       // True once the panel takes drawing commands
 void display_clear(void);
 void display_clear_region(coord_t x, coord_t y, coord_t width, coord_t height);
 void display_update(void);
+// Bounding box of what was drawn since the last update, corners inclusive. False if nothing was.
+bool display_get_dirty_region(coord_t* x1, coord_t* y1, coord_t* x2, coord_t* y2);
 void display_fill_white(void);
 void display_set_cursor(coord_t x, coord_t y);
 void display_write_string(char* str, FontDef font, DisplayColor color);
@@ -83,4 +89,10 @@ void display_draw_border_at(coord_t x_offset, coord_t y_offset, coord_t dist_fro
 void display_draw_pixel(coord_t x, coord_t y, DisplayColor color);
 void display_draw_bitmap(coord_t x, coord_t y, const uint8_t* bitmap, coord_t width, coord_t height, DisplayColor color);
 
+// Hardware scrolling - drawing calls keep using screen coordinates while it is active
+void display_set_scroll_area(coord_t top, coord_t height);
+void display_set_scroll_offset(coord_t offset);
+void display_reset_scroll(void);
+bool display_has_hw_scroll(void);
+
 #endif /* INC_CONSOLE_PERIPHERALS_HARDWARE_DRIVERS_DISPLAY_DRIVER_H_ */
@@ -0,0 +1,32 @@
+/*
+ * flash_driver.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Internal flash sectors reserved for save data - sectors 14 and 15 (0x08140000-0x0817FFFF),
+ *  128 KB each, kept out of the FLASH region by the linker script. The F413 has a single flash bank,
+ *  so code fetches stall while a word is programmed (~16 us) or a sector is erased
+ *  (1-2 s). Callers keep programming to a few words at a time and erase only when a
+ *  stall cannot be seen.
+ */
+
+#ifndef INC_CONSOLE_PERIPHERALS_HARDWARE_DRIVERS_FLASH_DRIVER_H_
+#define INC_CONSOLE_PERIPHERALS_HARDWARE_DRIVERS_FLASH_DRIVER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FLASH_SAVE_SECTOR_COUNT  2
+#define FLASH_SAVE_SECTOR_SIZE   (128 * 1024)
+#define FLASH_ERASED_WORD        0xFFFFFFFFUL
+
+bool flash_driver_erase_save_sector(uint8_t sector);     // Blocking, all bytes read 0xFF after
+// Program one word at a word-aligned offset. Bits can only go from 1 to 0 until the next erase.
+bool flash_driver_program_word(uint8_t sector, uint32_t offset, uint32_t value);
+const uint8_t* flash_driver_save_sector(uint8_t sector);   // Memory-mapped, for reading
+
+// Hash of the running firmware, so data holding code addresses is only used by the image that wrote it
+uint32_t flash_driver_image_id(void);
+
+#endif /* INC_CONSOLE_PERIPHERALS_HARDWARE_DRIVERS_FLASH_DRIVER_H_ */
@@ -3,6 +3,8 @@
  *
  *  Created on: Dec 22, 2024
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Circular DMA sampling, half and full transfer callbacks
  */
 
 #ifndef INC_CONSOLE_PERIPHERALS_HARDWARE_DRIVERS_JOYSTICK_DRIVER_H_
@@ -10,26 +12,29 @@
 
 #include <stdint.h>
 
+// X/Y sequences filtered together, one filtered value per JOYSTICK_SAMPLES_PER_HALF
+// TIM3 periods (8 ms at the default 1 kHz)
+#define JOYSTICK_SAMPLES_PER_HALF   8
+#define JOYSTICK_DMA_BUFFER_LENGTH  (2 * 2 * JOYSTICK_SAMPLES_PER_HALF)
+
 // Core driver interface
 void joystick_driver_init(void);
 void joystick_driver_start_conversion(void);
 uint8_t joystick_driver_read_button(void);
-void joystick_driver_get_adc_values(uint16_t* x, uint16_t* y);
+void joystick_driver_get_adc_values(uint16_t* x, uint16_t* y);   // Latest filtered values
 
 #ifndef UNITY_TEST
     #include "stm32f4xx_hal.h"
     // HAL Callbacks
-    void joystick_driver_tim_callback(TIM_HandleTypeDef *htim);
+    void joystick_driver_adc_half_callback(ADC_HandleTypeDef* hadc);
     void joystick_driver_adc_callback(ADC_HandleTypeDef* hadc);
 #else
     // Test functions
     void joystick_driver_set_values(uint16_t x, uint16_t y, uint8_t button);
 
     // Test stubs for callbacks
-   void joystick_driver_tim_callback(void* htim);  // Using void* to avoid HAL dependency
+   void joystick_driver_adc_half_callback(void* hadc);  // Using void* to avoid HAL dependency
    void joystick_driver_adc_callback(void* hadc);
-   void __disable_irq(void);
-   void __enable_irq(void);
 #endif
 
 #endif /* INC_CONSOLE_PERIPHERALS_HARDWARE_DRIVERS_JOYSTICK_DRIVER_H_ */
@@ -3,6 +3,8 @@
  *
  *  Created on: Dec 28, 2024
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Added PB_Driver_ReadInputs() for the bitmask scan
  */
 
 #ifndef INC_CONSOLE_PERIPHERALS_HARDWARE_DRIVERS_PUSH_BUTTON_DRIVER_H_
@@ -11,6 +13,15 @@
 #include "main.h"
 #include <stdint.h>
 
+// Bit positions of each input in the PB_Driver_ReadInputs() mask, 1 = pressed
+#define BUTTON_PB1          (1U << 0)
+#define BUTTON_PB2          (1U << 1)
+#define BUTTON_DPAD_UP      (1U << 2)
+#define BUTTON_DPAD_RIGHT   (1U << 3)
+#define BUTTON_DPAD_DOWN    (1U << 4)
+#define BUTTON_DPAD_LEFT    (1U << 5)
+#define BUTTON_DPAD_MASK    (BUTTON_DPAD_UP | BUTTON_DPAD_RIGHT | BUTTON_DPAD_DOWN | BUTTON_DPAD_LEFT)
+
  // Function prototypes
  // Read raw pin state
 uint8_t PB_Driver_ReadPin1(void);
@@ -20,6 +31,9 @@ uint8_t read_dpad_pin_right(void);
 uint8_t read_dpad_pin_up(void);
 uint8_t read_dpad_pin_down(void);
 
+// Every button and D-pad line at once, one input register read per port
+uint16_t PB_Driver_ReadInputs(void);
+
 // Get system time for debouncing
 uint32_t PB_Driver_GetTick(void);
 
@@ -3,6 +3,9 @@
  *
  *  Created on: Apr 25, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Added circular DMA reception with IDLE-line events
+ *      Added DMA transmission with a completion callback
  */
 
 #ifndef INC_CONSOLE_PERIPHERALS_HARDWARE_DRIVERS_UART_DRIVER_H_
@@ -13,6 +16,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include "System/Peripherals/uart_conf.h"
+#include "Utils/comm_utils.h"
 
 /* UART Status Codes */
 typedef enum {
@@ -42,5 +46,12 @@ UART_Status UART_FlushRxBuffer(UART_Port port);
 UART_Status UART_EnableRxInterrupt(UART_Port port);
 UART_Status UART_DisableRxInterrupt(UART_Port port);
 UART_Status UART_RegisterRxCallback(UART_Port port, void (*callback)(uint8_t));
+// Receive continuously into ring by circular DMA. The ring is advanced on IDLE line,
+// half and full transfer events. Only UART_PORT_2 has an RX DMA stream.
+UART_Status UART_StartRxDma(UART_Port port, dma_rx_ring_t* ring);
+// Start sending pData by DMA and return at once. pData must stay untouched until the
+// TX complete callback, which runs in interrupt context and reports whether it all went out.
+UART_Status UART_SendBufferDma(UART_Port port, const uint8_t* pData, uint16_t size);
+UART_Status UART_RegisterTxCompleteCallback(UART_Port port, void (*callback)(bool));
 
 #endif /* INC_CONSOLE_PERIPHERALS_HARDWARE_DRIVERS_UART_DRIVER_H_ */
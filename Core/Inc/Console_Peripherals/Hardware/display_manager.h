@@ -3,6 +3,8 @@
  *
  *  Created on: Jun 2, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Non-blocking init, messages return right after drawing
  */
 
 #ifndef INC_CONSOLE_PERIPHERALS_HARDWARE_DISPLAY_MANAGER_H_
@@ -60,6 +62,8 @@
 
 /* Core display manager functions */
 void display_manager_init(void);
+void display_manager_init_start(void);
+bool display_manager_init_poll(void);      /* True once the display can be drawn on */
 void display_manager_clear_screen(void);
 void display_manager_clear_main_area(void);
 void display_manager_update(void);
@@ -0,0 +1,55 @@
+/*
+ * input_events.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Timestamped input events, queued from interrupt context and drained by the game loop.
+ *  The queue is lock-free for one producer and one consumer. All producers are ISRs at the
+ *  same NVIC priority (SysTick scan for the D-pad, the ADC DMA half/full transfer for the
+ *  joystick), so they never preempt each other and act as a single producer.
+ */
+
+#ifndef INC_CONSOLE_PERIPHERALS_HARDWARE_INPUT_EVENTS_H_
+#define INC_CONSOLE_PERIPHERALS_HARDWARE_INPUT_EVENTS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define INPUT_QUEUE_SIZE 16   // Power of two
+
+typedef enum {
+    INPUT_SOURCE_DPAD,               // state is a DPAD_DIR_*, 0 on release
+    INPUT_SOURCE_JOYSTICK,           // state is a JS_DIR_*
+    INPUT_SOURCE_JOYSTICK_BUTTON     // state is 1 while pressed
+} InputSource;
+
+typedef struct {
+    uint32_t timestamp_us;
+    uint8_t source;         // InputSource
+    uint8_t state;
+} InputEvent;
+
+typedef struct {
+    InputEvent events[INPUT_QUEUE_SIZE];
+    volatile uint8_t head;       // Next slot to write, only the producer moves it
+    volatile uint8_t tail;       // Next slot to read, only the consumer moves it
+    volatile uint16_t dropped;   // Events lost to a full queue
+} InputQueue;
+
+// Queue fed by the input ISRs
+extern InputQueue input_events;
+
+// Producer side
+bool input_queue_push(InputQueue* queue, uint8_t source, uint8_t state, uint32_t timestamp_us);
+void input_events_post(uint8_t source, uint8_t state);   // Stamps and pushes to input_events
+
+// Consumer side
+bool input_queue_pop(InputQueue* queue, InputEvent* event);
+uint8_t input_queue_count(const InputQueue* queue);
+void input_queue_flush(InputQueue* queue);               // Drop everything queued so far
+
+// Only while no producer can run
+void input_queue_reset(InputQueue* queue);
+
+#endif /* INC_CONSOLE_PERIPHERALS_HARDWARE_INPUT_EVENTS_H_ */
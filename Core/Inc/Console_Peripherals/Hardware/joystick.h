@@ -3,6 +3,8 @@
  *
  *  Created on: Dec 6, 2024
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Filtered, calibrated samples with a dead-zone around the center
  */
 
 #ifndef INC_CONSOLE_PERIPHERALS_HARDWARE_JOYSTICK_H_
@@ -11,10 +13,33 @@
 #include <Console_Peripherals/types.h>
 #include "System/system_conf.h"
 #include <stdint.h>
+#include <stdbool.h>
+
+#define JOYSTICK_ADC_MAX                4095
+#define JOYSTICK_ADC_CENTER             2048
+// Offsets this close to the calibrated center read as exactly centered
+#define JOYSTICK_DEAD_ZONE              64
+// The first filtered sample after init is taken as the rest position, unless it is
+// further than this from the ideal center (stick held at power-up)
+#define JOYSTICK_CALIBRATION_MAX_OFFSET 200
+
+typedef struct {
+    uint16_t center_x;
+    uint16_t center_y;
+    bool calibrated;
+} JoystickCalibration;
 
 void joystick_init(void);
 void update_joystick_status(); // Made public for callbacks to access
 JoystickStatus joystick_get_status();
 uint8_t calculate_direction(uint16_t x, uint16_t y);  // Made public for testing
 
+// Filter math, made public for the driver and for testing
+// Mean of count samples spaced stride apart, without the lowest and highest one
+uint16_t joystick_filter_samples(const volatile uint16_t* samples, uint8_t count, uint8_t stride);
+// Moves the calibrated center to JOYSTICK_ADC_CENTER and snaps the dead-zone to it
+uint16_t joystick_apply_calibration(uint16_t value, uint16_t center, uint16_t dead_zone);
+bool joystick_calibrate(uint16_t x, uint16_t y);     // False if the stick is not at rest
+const JoystickCalibration* joystick_get_calibration(void);
+
 #endif /* INC_CONSOLE_PERIPHERALS_HARDWARE_JOYSTICK_H_ */
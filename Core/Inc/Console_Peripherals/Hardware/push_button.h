@@ -3,6 +3,8 @@
  *
  *  Created on: Dec 28, 2024
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Buttons and D-pad lines are debounced together as one bitmask, see pb_scan()
  */
 
 #ifndef INC_CONSOLE_PERIPHERALS_HARDWARE_PUSH_BUTTON_H_
@@ -10,28 +12,48 @@
 
 #include <Console_Peripherals/Hardware/Drivers/push_button_driver.h>
 
-// Button states structure (made public for testing)
+// pb_scan() runs from SysTick every BUTTON_SCAN_PERIOD_MS. A change has to be seen on
+// four scans in a row to be taken, so the debounce time is 4 * BUTTON_SCAN_PERIOD_MS.
+#define BUTTON_SCAN_PERIOD_MS   2
+#define BUTTON_DEBOUNCE_SCANS   4
+// Held edge after 2^BUTTON_HOLD_BITS scans of a button staying down (~1 s)
+#define BUTTON_HOLD_BITS        9
+
+// Vertical counters - bit n of every field belongs to input bit n, so one update
+// debounces all inputs with a few logic operations (made public for testing)
 typedef struct {
-    uint8_t current_state;
-    uint8_t last_reading;
-    uint32_t last_debounce_time;
-    uint8_t pressed;  // New flag for edge detection
-} Button_TypeDef;
+    uint16_t state;                     // Debounced levels, 1 = pressed
+    uint16_t count0;                    // 2-bit debounce counter, low plane
+    uint16_t count1;                    // 2-bit debounce counter, high plane
+    uint16_t hold[BUTTON_HOLD_BITS];    // Hold counter planes, low plane first
+    uint16_t hold_reported;             // Held edge already given for this press
+    uint16_t pressed;                   // Edges found by the last update
+    uint16_t released;
+    uint16_t held;
+} Debouncer;
+
+void debouncer_reset(Debouncer* debouncer);
+void debouncer_update(Debouncer* debouncer, uint16_t sample);
 
 // Initialize button logic
 void pb_init(void);
+// Sample and debounce every input, called from SysTick
+void pb_scan(void);
+
+// Debounced levels of all inputs
+uint16_t pb_get_levels(void);
+// Edges since the last take, only the bits in mask are returned and cleared
+uint16_t pb_take_pressed(uint16_t mask);
+uint16_t pb_take_released(uint16_t mask);
+uint16_t pb_take_held(uint16_t mask);
 
 // Get debounced button states
-uint8_t pb1_get_state(void);
+uint8_t pb1_get_state(void);        // 1 once per press
 uint8_t pb2_get_state(void);
+uint8_t pb2_is_down(void);          // Debounced level, for timing a hold
 uint8_t dpad_pin_left_get_state();
 uint8_t dpad_pin_right_get_state();
 uint8_t dpad_pin_up_get_state();
 uint8_t dpad_pin_down_get_state();
 
-// Made public for testing
-void process_button(Button_TypeDef *button, uint8_t current_reading, uint32_t current_time);
-
-
-
 #endif /* INC_CONSOLE_PERIPHERALS_HARDWARE_PUSH_BUTTON_H_ */
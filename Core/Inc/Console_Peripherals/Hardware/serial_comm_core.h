@@ -3,6 +3,10 @@
  *
  *  Created on: Jul 16, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Sends through a prioritised queue drained by UART DMA
+ *      Frames messages with COBS, a sequence number and CRC (see serial_frame.h)
+ *      Receives into message slots, handlers read messages in place
  */
 
 #ifndef INC_CONSOLE_PERIPHERALS_HARDWARE_SERIAL_COMM_CORE_H_
@@ -44,19 +48,51 @@
 //} uart_message_t;
 //#pragma pack(pop)
 
+/* Receive slots - a frame is copied out of the DMA buffer once, into a slot, decoded there and
+ * handed to the message callback in place. Slots hold the largest message the protocol handles
+ * (uart_chat_message_t); longer frames are skipped as oversized. */
+#define RX_SLOT_COUNT           MESSAGE_QUEUE_SIZE
+#define RX_SLOT_MAX_PAYLOAD     sizeof(uart_chat_message_t)
+#define RX_SLOT_SIZE            ((SERIAL_FRAME_ENCODED_SIZE(RX_SLOT_MAX_PAYLOAD) + 3) & ~3U)
+
+/* Transmit queues - frames wait here while the DMA sends the one before */
+#define TX_QUEUE_HIGH_SIZE      4
+#define TX_QUEUE_NORMAL_SIZE    4
+
+/* Transmit priority - every waiting high priority frame goes out before a normal one */
+typedef enum {
+    TX_PRIORITY_HIGH = 0,       // Player input and game data
+    TX_PRIORITY_NORMAL,         // Handshake, status and debug traffic
+    TX_PRIORITY_COUNT
+} tx_priority_t;
+
+/* What a full queue does with a new frame */
+typedef enum {
+    TX_FULL_DROP_NEWEST = 0,    // Refuse it, the caller gets UART_BUSY
+    TX_FULL_DROP_OLDEST         // Replace the oldest waiting frame, when only the latest matters
+} tx_full_policy_t;
+
 /* Hardware UART functions */
 UART_Status hardware_serial_init(void);
 UART_Status hardware_serial_deinit(void);
-UART_Status hardware_serial_send_message(const uart_message_t* msg);
+UART_Status hardware_serial_send_message(const uart_message_t* msg);     /* Normal priority, drop newest */
+UART_Status hardware_serial_queue_message(const uart_message_t* msg, tx_priority_t priority,
+    tx_full_policy_t policy);
+void hardware_serial_service_tx(void);      /* Start the next waiting frame if the UART is free */
+void hardware_serial_register_tx_done_callback(void (*callback)(void));   /* Called from the interrupt */
 bool hardware_serial_is_message_ready(void);
-void hardware_serial_process_incoming(void);
+void hardware_serial_process_incoming(void);    /* Each waiting message to the callback, then released */
 void hardware_serial_register_callback(uart_message_received_callback_t callback);
+/* The oldest waiting message, in place - hand it back with hardware_serial_release_message() */
+bool hardware_serial_borrow_message(uart_message_view_t* msg);
+void hardware_serial_release_message(const uart_message_view_t* msg);
 
 /* Utility functions */
-uint8_t hardware_serial_calculate_checksum(const uart_message_t* msg);
-bool hardware_serial_validate_message(const uart_message_t* msg);
+bool hardware_serial_validate_message(const uart_message_view_t* msg);
 void hardware_serial_get_stats(uint32_t* bytes_sent, uint32_t* bytes_received,
     uint32_t* messages_parsed, uint32_t* parse_errors);
+uint32_t hardware_serial_get_drop_count(void);
+const comm_stats_t* hardware_serial_get_comm_stats(void);
 void hardware_serial_reset_buffers(void);
 
 #endif /* INC_CONSOLE_PERIPHERALS_HARDWARE_SERIAL_COMM_CORE_H_ */
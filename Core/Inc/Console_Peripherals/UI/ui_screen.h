@@ -0,0 +1,45 @@
+/*
+ * ui_screen.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Timed UI screens - boot, welcome and error messages. A screen is entered, updated from
+ *  the UI task and left when its duration runs out, when its update hook reports it done,
+ *  or when another screen replaces it. Nothing here waits, so comms and input keep being
+ *  serviced while a screen is up.
+ */
+
+#ifndef INC_CONSOLE_PERIPHERALS_UI_UI_SCREEN_H_
+#define INC_CONSOLE_PERIPHERALS_UI_UI_SCREEN_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define UI_SCREEN_FOREVER 0    // No timeout, left by update() or by another screen
+
+typedef struct {
+    const char* name;
+    void (*enter)(void);
+    bool (*update)(uint32_t elapsed_ms);    // Optional, returns true when the screen is done
+    void (*exit)(void);                     // Optional, runs however the screen is left
+    void (*done)(void);                     // Optional, after a timeout or update() - shows the next screen
+    uint32_t duration_ms;
+} UiScreen;
+
+typedef uint32_t (*ui_screen_counter_t)(void);     // Running count of dropped comm messages
+
+typedef struct {
+    uint32_t shown;             // Screens entered
+    uint32_t longest_ms;        // Longest a screen stayed up
+    uint32_t dropped;           // Comm drops while screens were up
+} UiScreenStats;
+
+void ui_screen_init(ui_screen_counter_t drop_counter);
+void ui_screen_show(const UiScreen* screen, uint32_t now_ms);   // Leaves the current one first
+void ui_screen_leave(uint32_t now_ms);                          // Without running done()
+bool ui_screen_update(uint32_t now_ms);                         // True while a screen is up
+const UiScreen* ui_screen_current(void);
+const UiScreenStats* ui_screen_get_stats(void);
+
+#endif /* INC_CONSOLE_PERIPHERALS_UI_UI_SCREEN_H_ */
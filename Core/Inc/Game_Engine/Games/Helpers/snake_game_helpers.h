@@ -17,23 +17,34 @@
 #include <stdlib.h>
 #include "Game_Engine/Games/game_types.h"
 #include "Game_Engine/game_engine.h"
+#include "Game_Engine/game_engine_entity.h"
+#include "Game_Engine/game_engine_collision.h"
 #include "Sprites/snake_sprite.h"
 
 #define SNAKE_SPEED 500 // Movement delay in ms
+#define SNAKE_MAX_LENGTH 64 // Body segments reserved per snake
+#define SNAKE_BORDER_REDRAW_MS 500 // Periodic border repair
 
 
-// Snake state
+// Snake state. Body segments are a block of SNAKE_MAX_LENGTH entities in game_entities,
+// segment i is entity body + i, so x and y each sit in one contiguous array.
 typedef struct {
     coord_t head_x;
     coord_t head_y;
     uint8_t direction;  // Will use DPAD_DIR  values
     uint8_t length;
-    struct {
-        coord_t x;
-        coord_t y;
-    } body[64];  // Maximum snake length
+    entity_id_t body;   // First body segment
 } SnakeState;
 
+// Segment coordinate arrays of a snake
+static inline coord_t* snake_body_x(const SnakeState* snake) {
+    return &game_entities->pos_x[snake->body];
+}
+
+static inline coord_t* snake_body_y(const SnakeState* snake) {
+    return &game_entities->pos_y[snake->body];
+}
+
 // Co-ordinates of food being spawned. This is not inside SnakeState because each snake doesn't have its own food.
 // Food is common to both snakes in multi-player game.
 Position food;
@@ -55,12 +66,13 @@ void snake_helper_spawn_food(Position* food, const SnakeState* snake);
 // Game speed calculation
 uint16_t snake_helper_calculate_speed(uint32_t score);
 
-// Snake initialization
+// Snake initialization - reserves the body block, so reset game_entities before (re)starting a game
 void snake_helper_init_snake(SnakeState* snake, coord_t start_x, coord_t start_y, uint8_t start_direction);
 
 // Rendering helpers
 void snake_helper_draw_snake(const SnakeState* snake);
 void snake_helper_draw_food(const Position* food);
+void snake_helper_load_assets(void);   // Registry load_assets hook, shared by SP and MP snake
 
 // Utility functions
 void snake_helper_copy_snake_state(SnakeState* dest, const SnakeState* src);
@@ -0,0 +1,35 @@
+/*
+ * mp_snake_game_body_sync.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  The opponent's whole body from the server - a keyframe sets it, each delta shifts the stored
+ *  body by the server's moves and trims the tail. Only keyframes decode a whole body.
+ */
+
+#ifndef INC_GAME_ENGINE_GAMES_MULTI_PLAYER_SNAKE_GAME_MP_SNAKE_GAME_BODY_SYNC_H_
+#define INC_GAME_ENGINE_GAMES_MULTI_PLAYER_SNAKE_GAME_MP_SNAKE_GAME_BODY_SYNC_H_
+
+#include "Game_Engine/Games/Helpers/snake_game_helpers.h"
+#include "Communication/serial_comm_types.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint32_t tick;          // Server tick the body is at
+    bool synced;            // False until a keyframe, and again after a delta was lost
+
+    // Statistics
+    uint32_t keyframes;
+    uint32_t deltas;
+    uint32_t gaps;          // Deltas that did not follow on, ignored until the next keyframe
+    uint32_t stale;         // Deltas for ticks already applied
+} BodySync;
+
+void mp_body_sync_init(BodySync* sync);
+
+// Applies a keyframe or delta to the snake. False if it was ignored.
+bool mp_body_sync_apply(BodySync* sync, SnakeState* snake, const uart_body_sync_t* body_sync);
+
+#endif /* INC_GAME_ENGINE_GAMES_MULTI_PLAYER_SNAKE_GAME_MP_SNAKE_GAME_BODY_SYNC_H_ */
@@ -3,6 +3,11 @@
  *
  *  Created on: Jun 4, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      The local snake is predicted and reconciled with the server's positions
+ *      The opponent's body follows the server's body sync
+ *      The opponent is shown a jitter buffer's delay behind the server
+ *      Game data lives in the game arena, with the prediction and jitter buffer in it
  *
  *  Core game logic and state management for multiplayer snake
  */
@@ -11,6 +16,9 @@
 #define INC_GAME_ENGINE_GAMES_MULTI_PLAYER_SNAKE_GAME_MP_SNAKE_GAME_CORE_H_
 
 #include "Game_Engine/Games/Helpers/snake_game_helpers.h"
+#include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_prediction.h"
+#include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_jitter.h"
+#include "Communication/serial_comm_types.h"
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
@@ -57,9 +65,19 @@ typedef struct {
     uint32_t player2_score;
     Position food_position;
     bool valid;
+
+    // Only the binary game state carries positions
+    bool has_positions;
+    uint32_t tick;
+    Position player1_head;              // Device coordinates
+    Position player2_head;
+    uint8_t player1_direction;
+    uint8_t player2_direction;
+    uint16_t player1_input_ack;         // Last input sequence the server applied
+    uint16_t player2_input_ack;
 } TempServerState;
 
-// Multiplayer Snake Game Data Structure (simplified - no prediction)
+// Multiplayer Snake Game Data Structure - the local snake is predicted, the opponent follows the server
 typedef struct {
     // Server-authoritative state (received from server)
     char session_id[7];
@@ -87,21 +105,35 @@ typedef struct {
     bool connected_to_server;
     bool opponent_connected;
 
+    // Movement runs on a periodic engine timer while playing
+    timer_id_t movement_timer;
+
+    // Inputs of the local snake not yet acknowledged by the server, and its recent moves
+    SnakePrediction local_prediction;
+
+    // Body syncs of the opponent waiting to be shown, and its body as synced so far
+    JitterBuffer opponent_jitter;
+
+    // Server reconciliation tracking
+    uint32_t last_processed_sequence;
+    uint32_t last_server_reconciliation;
+
     // Add player colors later
 
 } MultiplayerSnakeGameData;
 
-// Core game state access
-extern MultiplayerSnakeGameData mp_snake_data;
+// Core game state access, in the game arena while a session runs and NULL otherwise
+extern MultiplayerSnakeGameData* mp_snake_data;
 
 // Core game logic functions (similar to TS MultiplayerSnakeCore methods)
 void mp_snake_core_init(MultiplayerPlayerId player_id, uint32_t target_score);
 void mp_snake_core_cleanup(void);
 
-// Movement simulation (like TS moveAllPlayersLocally)
+// Movement simulation (like TS moveAllPlayersLocally). Start runs a periodic game timer that
+// moves both players, so it pauses with the game.
 void mp_snake_start_movement_simulation(void);
 void mp_snake_stop_movement_simulation(void);
-void mp_snake_move_all_players_locally(void);
+void mp_snake_move_all_players_locally(void);    // One step, called by the timer
 
 // Game state queries (similar to TS getters)
 MultiplayerPlayerId mp_snake_get_opponent_id(void);
@@ -113,6 +145,10 @@ SnakeState* mp_snake_get_all_players(uint8_t* player_count);
 // Input validation (similar to TS canChangeDirection)
 bool mp_snake_can_change_direction(uint8_t new_direction);
 
+// Turns the local snake at once. Returns the sequence to send the input with, 0 if the turn
+// is not allowed.
+uint16_t mp_snake_apply_local_input(uint8_t direction);
+
 // Game events (similar to TS event handlers)
 void mp_snake_handle_game_start(void);
 void mp_snake_handle_game_end(MultiplayerGameResult result);
@@ -123,4 +159,11 @@ void mp_snake_handle_game_event(const char* event_data);
 GameStats mp_snake_get_game_stats(void);
 void mp_snake_reconcile_with_server(const TempServerState* server_state);
 
+// Keyframe or delta of the opponent's body, held until its tick is due to be shown
+void mp_snake_apply_opponent_body(const uart_body_sync_t* body_sync);
+
+// Shows the opponent at the tick now due, called every frame. Once its body sync is being
+// shown the opponent only moves by it.
+void mp_snake_update_opponent(void);
+
 #endif /* INC_GAME_ENGINE_GAMES_MULTI_PLAYER_SNAKE_GAME_MP_SNAKE_GAME_CORE_H_ */
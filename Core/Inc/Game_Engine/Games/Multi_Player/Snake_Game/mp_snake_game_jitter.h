@@ -0,0 +1,71 @@
+/*
+ * mp_snake_game_jitter.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Jitter buffer for the opponent - body syncs are held with their arrival times and shown
+ *  one server tick at a time, a delay behind the server that follows the measured jitter.
+ *  A tick with no snapshot yet is extrapolated for a few moves and corrected once it lands.
+ */
+
+#ifndef INC_GAME_ENGINE_GAMES_MULTI_PLAYER_SNAKE_GAME_MP_SNAKE_GAME_JITTER_H_
+#define INC_GAME_ENGINE_GAMES_MULTI_PLAYER_SNAKE_GAME_MP_SNAKE_GAME_JITTER_H_
+
+#include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_body_sync.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MP_JITTER_SLOTS             16  // Snapshots of one tick waiting to be shown
+#define MP_JITTER_DEFAULT_DELAY_MS  50  // Least delay behind the server, the jitter adds to it
+#define MP_JITTER_MAX_DELAY_MS      500
+#define MP_JITTER_DELAY_PER_JITTER  3   // Delay added per ms of mean jitter
+#define MP_JITTER_MAX_EXTRAPOLATION 2   // Ticks the opponent moves on without a snapshot
+
+// A keyframe, or a delta of a single move
+typedef struct {
+    uint32_t arrival_ms;
+    uart_body_sync_t snapshot;
+} JitterSnapshot;
+
+typedef struct {
+    JitterSnapshot slots[MP_JITTER_SLOTS];  // Oldest tick first
+    uint8_t count;
+
+    // Playout clock - tick t is due at t * tick_ms + transit_ms + delay_ms
+    uint32_t tick_ms;
+    uint32_t base_delay_ms;
+    uint32_t delay_ms;
+    uint32_t transit_ms;        // Mean of arrival time less the tick's time on the server
+    uint32_t last_transit_ms;
+    uint32_t jitter_x16;        // Mean change in transit between messages, in 1/16 ms
+    bool clock_started;
+
+    // The server's body as applied so far, and the tick on screen
+    SnakeState synced;
+    BodySync sync;
+    uint32_t shown_tick;        // Tick the shown head is at
+    uint32_t shown_sync_tick;   // Synced tick the shown snake was copied from
+    bool showing;
+
+    // Statistics
+    uint32_t played;            // Synced ticks copied to the screen
+    uint32_t extrapolated;      // Ticks moved on without a snapshot
+    uint32_t corrections;       // Extrapolated heads that were not where the server went
+    uint32_t late;              // Snapshots that arrived after their tick was due
+    uint32_t dropped;           // Snapshots pushed out of a full buffer
+} JitterBuffer;
+
+// Reserves the synced body block, so call it after game_entities is reset
+void mp_jitter_init(JitterBuffer* jitter, uint32_t tick_ms, uint32_t base_delay_ms);
+
+// Holds a body sync, a delta of several moves is split into one snapshot per tick
+void mp_jitter_push(JitterBuffer* jitter, const uart_body_sync_t* body_sync, uint32_t now_ms);
+
+// Brings the shown snake to the tick due at now_ms. True if it changed.
+bool mp_jitter_update(JitterBuffer* jitter, SnakeState* shown, uint32_t now_ms);
+
+// Mean jitter in ms
+uint32_t mp_jitter_ms(const JitterBuffer* jitter);
+
+#endif /* INC_GAME_ENGINE_GAMES_MULTI_PLAYER_SNAKE_GAME_MP_SNAKE_GAME_JITTER_H_ */
@@ -3,6 +3,10 @@
  *
  *  Created on: Jun 4, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Server state also arrives as the binary game state message
+ *      Inputs are sent with the sequence the server acknowledges them by
+ *      The opponent's body arrives as body sync keyframes and deltas
  *
  *  Network communication and message parsing for multiplayer snake
  */
@@ -20,7 +24,7 @@
 #include "Utils/misc_utils.h"
 
  // Message sending functions
-void mp_snake_send_input_to_server(uint8_t direction);
+void mp_snake_send_input_to_server(uint8_t direction, uint16_t sequence);
 void mp_snake_send_player_ready(void);
 
 // Message parsing functions
@@ -30,6 +34,8 @@ bool mp_snake_parse_game_state(const char* game_data);
 
 // Callback handler for serial_comm
 void mp_snake_on_game_data_received(const uart_game_data_t* game_data);
+void mp_snake_on_game_state_received(const uart_game_state_t* game_state);
+void mp_snake_on_body_sync_received(const uart_body_sync_t* body_sync);
 void mp_snake_on_connection_received(const uart_connection_message_t* communication_message);
 
 #endif /* INC_GAME_ENGINE_GAMES_MULTI_PLAYER_SNAKE_GAME_MP_SNAKE_GAME_NETWORK_H_ */
@@ -0,0 +1,77 @@
+/*
+ * mp_snake_game_prediction.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Client-side prediction for multiplayer snake - the local snake turns and moves on local
+ *  input at once, and is rolled back and replayed when the server's state disagrees
+ */
+
+#ifndef INC_GAME_ENGINE_GAMES_MULTI_PLAYER_SNAKE_GAME_MP_SNAKE_GAME_PREDICTION_H_
+#define INC_GAME_ENGINE_GAMES_MULTI_PLAYER_SNAKE_GAME_MP_SNAKE_GAME_PREDICTION_H_
+
+#include "Game_Engine/Games/Helpers/snake_game_helpers.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MP_PREDICTION_WINDOW    16  // Ticks the local snake may run ahead of the server's state
+#define MP_PREDICTION_INPUTS    16  // Unacknowledged inputs kept for replay
+#define MP_PREDICTION_HISTORY   128 // Heads kept, a power of two so the ticks before 0 wrap onto the ring
+
+// An input the server has not acknowledged yet
+typedef struct {
+    uint16_t sequence;      // Sent with the input, the server acknowledges up to it
+    uint32_t tick;          // Turns the move from tick to tick + 1
+    uint8_t direction;
+} PredictedInput;
+
+// Head after a tick and the direction it moved in
+typedef struct {
+    coord_t head_x;
+    coord_t head_y;
+    uint8_t direction;
+} PredictedStep;
+
+typedef struct {
+    uint32_t tick;                                  // Moves made, numbered like the server's ticks
+    uint16_t next_sequence;
+    PredictedInput inputs[MP_PREDICTION_INPUTS];    // Oldest at first
+    uint8_t input_first;
+    uint8_t input_count;
+    PredictedStep steps[MP_PREDICTION_HISTORY];     // Step of tick t at t % MP_PREDICTION_HISTORY
+
+    // Statistics
+    uint32_t rollbacks;         // Server disagreed, replayed from its state
+    uint32_t replayed_ticks;
+    uint32_t snaps;             // Server state outside the window, taken as it is
+    uint32_t inputs_dropped;    // Unacknowledged inputs pushed out by newer ones
+} SnakePrediction;
+
+// The local player's part of an authoritative state
+typedef struct {
+    uint32_t tick;
+    coord_t head_x;             // Device coordinates
+    coord_t head_y;
+    uint8_t direction;
+    uint8_t length;
+    uint16_t input_ack;         // Last input sequence the server applied, 0 for none
+} PredictionServerState;
+
+void mp_prediction_init(SnakePrediction* prediction, const SnakeState* snake, uint32_t tick);
+
+// Turns the snake now and keeps the input for replay. Returns its sequence, 0 if the turn is
+// not allowed after the last move.
+uint16_t mp_prediction_apply_input(SnakePrediction* prediction, SnakeState* snake, uint8_t direction);
+
+// One move of the local snake, with the shared snake movement
+void mp_prediction_step(SnakePrediction* prediction, SnakeState* snake);
+
+// Drops acknowledged inputs and, if the server's head or direction differ from what was
+// predicted for its tick, rewinds to the server's state and replays the inputs it has not
+// seen. True if the snake was corrected.
+bool mp_prediction_reconcile(SnakePrediction* prediction, SnakeState* snake, const PredictionServerState* server);
+
+uint8_t mp_prediction_pending_inputs(const SnakePrediction* prediction);
+
+#endif /* INC_GAME_ENGINE_GAMES_MULTI_PLAYER_SNAKE_GAME_MP_SNAKE_GAME_PREDICTION_H_ */
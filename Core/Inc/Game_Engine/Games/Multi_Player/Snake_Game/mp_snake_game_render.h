@@ -5,6 +5,8 @@
  *      Author: rohitimandi
  *
  *  Rendering and UI functions for multiplayer snake
+ *  Modified on: Oct 18, 2026
+ *      Render tracking lives in the game arena for the session
  */
 
 #ifndef INC_GAME_ENGINE_GAMES_MULTI_PLAYER_SNAKE_GAME_MP_SNAKE_GAME_RENDER_H_
@@ -15,6 +17,21 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+// For dirty rectangle optimization (similar to TS private properties)
+typedef struct {
+    coord_t previous_local_head_x, previous_local_head_y;
+    coord_t previous_opponent_head_x, previous_opponent_head_y;
+    coord_t previous_food_x, previous_food_y;
+    uint8_t previous_local_length;
+    uint8_t previous_opponent_length;
+    uint32_t previous_local_score;
+    uint32_t previous_opponent_score;
+    bool first_render;
+} MpSnakeRenderState;
+
+// Takes the render tracking from the game arena, false when it is exhausted
+bool mp_snake_render_create(void);
+
 // Rendering initialization and cleanup (similar to TS constructor/destructor)
 void mp_snake_render_init(void);
 void mp_snake_render_cleanup(void);
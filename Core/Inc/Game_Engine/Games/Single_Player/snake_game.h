@@ -9,6 +9,7 @@
 #define INC_GAME_ENGINE_GAMES_SINGLE_PLAYER_SNAKE_GAME_H_
 
 #include "Game_Engine/game_engine.h"
+#include "Game_Engine/game_engine_input.h"
 #include "Game_Engine/Games/Helpers/snake_game_helpers.h"
 #include "Sprites/snake_sprite.h"
 #include "Console_Peripherals/Hardware/display_manager.h"
@@ -17,6 +18,7 @@
 typedef struct {
     SnakeState snake;
     Position food;
+    TurnBuffer turns;    // Presses waiting for a movement step
 } SnakeGameData;
 
 // Snake game engine instance
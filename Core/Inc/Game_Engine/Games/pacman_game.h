@@ -3,18 +3,31 @@
  *
  *  Created on: Feb 14, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Movement and the power pellet run on engine timers
+ *      Dots are kept in the maze tiles rather than the entity store
  */
 
 #ifndef INC_GAME_ENGINE_GAMES_PACMAN_GAME_H_
 #define INC_GAME_ENGINE_GAMES_PACMAN_GAME_H_
 
 #include "Game_Engine/game_engine.h"
+#include "Game_Engine/game_engine_entity.h"
+#include "Game_Engine/game_engine_collision.h"
 #include "Game_Engine/Games/game_types.h"
 #include "Sprites/pacman_sprite.h"
 #include "Game_Engine/Games/pacman_maze.h"
 
 #define PACMAN_SPEED      300  // Movement delay in ms
-#define MAX_DOTS         100   // Maximum number of dots
+#define PACMAN_MAZE_REFRESH_MS  5000   // Full maze redraw to repair stray pixels
+#define PACMAN_BORDER_REDRAW_MS 500
+#ifdef DISPLAY_MODULE_LCD
+#define PACMAN_START_X    13   // Maze tile Pacman starts on
+#define PACMAN_START_Y    23
+#else
+#define PACMAN_START_X    6
+#define PACMAN_START_Y    1
+#endif
 #define NUM_GHOSTS        4    // Number of ghosts in the game
 #define GHOST_SCATTER_TIME 7000 // Time ghosts remain scared after power pellet
 
@@ -42,36 +55,41 @@ typedef enum {
     MODE_FRIGHTENED
 } GhostMode;
 
-// Ghost structure
+// Entity flags, also used as collision layers
+#define PACMAN_FLAG_PLAYER  0x01
+#define PACMAN_FLAG_GHOST   0x02
+
+// Sprite ids kept in the entity store
+typedef enum {
+    PACMAN_SPRITE_PLAYER,
+    PACMAN_SPRITE_BLINKY,
+    PACMAN_SPRITE_PINKY,
+    PACMAN_SPRITE_INKY,
+    PACMAN_SPRITE_CLYDE
+} PacmanSpriteId;
+
+// Ghost AI state - position and the active flag live in the entity store
 typedef struct {
-    Position pos;
     Direction dir;
     GhostType type;
     GhostMode mode;
-    bool active;
     Position target;     // Current target tile
 } Ghost;
 
-// Dot structure
-typedef struct {
-    Position pos;
-    bool active;
-    bool is_power_pellet;
-} Dot;
-
-
-// Pacman game specific data structure
+// Pacman game specific data structure. Pacman and the ghosts are one block of
+// entities (movers) so the movement pass is a single contiguous loop. Dots are
+// MAZE_DOT and MAZE_POWER tiles in the maze, looked up by Pacman's tile.
 typedef struct {
-    Position pacman_pos;
+    entity_id_t pacman;                  // First mover, ghost i is pacman + 1 + i
     Direction curr_dir;
     Direction next_dir;
 
     Ghost ghosts[NUM_GHOSTS];
-    Dot dots[MAX_DOTS];
 
-    uint32_t ghost_mode_timer;
+    timer_id_t step_timer;               // Periodic, moves everything one tile
+    timer_id_t frightened_timer;         // One-shot, ends the power pellet
     uint32_t ghost_mode_duration;
-    uint8_t num_dots_remaining;
+    uint16_t num_dots_remaining;
     bool power_pellet_active;
 } PacmanGameData;
 
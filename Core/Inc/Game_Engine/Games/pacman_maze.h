@@ -12,6 +12,7 @@
 #include <stdbool.h>
 #include "Sprites/sprite.h"
 #include "Game_Engine/game_engine_conf.h"  // For GAME_AREA_TOP, TILE_SIZE, BORDER_OFFSET
+#include "Game_Engine/game_engine_viewport.h"
 
 // Maze elements
 typedef enum {
@@ -51,25 +52,40 @@ static const uint8_t MAZE_LAYOUT_OLED[6][16] = {
 //    {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}   // row 15
 //};
 
-// Layout for larger LCD display (320x240) with TILE_SIZE=16 - scaled to 14x19
-static const uint8_t MAZE_LAYOUT_LCD[14][19] = {
-    // Top border
-    {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1},
-
-    // Main maze
-    {1,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,1},
-    {1,0,1,1,0,1,1,1,1,0,1,1,1,1,0,1,1,0,1},
-    {1,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,1},
-    {1,0,1,0,1,1,0,1,1,1,1,1,0,1,1,0,1,0,1},
-    {1,0,0,0,0,1,0,0,0,0,0,0,0,1,0,0,0,0,1},
-    {1,0,1,1,0,1,0,1,0,1,0,1,0,1,0,1,1,0,1},
-    {1,0,0,1,0,0,0,1,0,1,0,1,0,0,0,1,0,0,1},
-    {1,1,0,1,0,1,1,1,0,1,0,1,1,1,0,1,0,1,1},
-    {1,0,0,0,0,1,0,0,0,0,0,0,0,1,0,0,0,0,1},
-    {1,0,1,1,0,1,0,1,1,0,1,1,0,1,0,1,1,0,1},
-    {1,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,1},
-    {1,3,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,3,1},
-    {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
+// Full-size classic layout (28x31) for the LCD. It is larger than the screen and
+// scrolls inside the maze viewport.
+static const uint8_t MAZE_LAYOUT_CLASSIC[31][28] = {
+    {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1},  // row 0
+    {1,2,2,2,2,2,2,2,2,2,2,2,2,1,1,2,2,2,2,2,2,2,2,2,2,2,2,1},  // row 1
+    {1,2,1,1,1,1,2,1,1,1,1,1,2,1,1,2,1,1,1,1,1,2,1,1,1,1,2,1},  // row 2
+    {1,3,1,1,1,1,2,1,1,1,1,1,2,1,1,2,1,1,1,1,1,2,1,1,1,1,3,1},  // row 3
+    {1,2,1,1,1,1,2,1,1,1,1,1,2,1,1,2,1,1,1,1,1,2,1,1,1,1,2,1},  // row 4
+    {1,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,1},  // row 5
+    {1,2,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,2,1},  // row 6
+    {1,2,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,2,1},  // row 7
+    {1,2,2,2,2,2,2,1,1,2,2,2,2,1,1,2,2,2,2,1,1,2,2,2,2,2,2,1},  // row 8
+    {1,1,1,1,1,1,2,1,1,1,1,1,0,1,1,0,1,1,1,1,1,2,1,1,1,1,1,1},  // row 9
+    {0,0,0,0,0,1,2,1,1,1,1,1,0,1,1,0,1,1,1,1,1,2,1,0,0,0,0,0},  // row 10
+    {0,0,0,0,0,1,2,1,1,0,0,0,0,0,0,0,0,0,0,1,1,2,1,0,0,0,0,0},  // row 11
+    {0,0,0,0,0,1,2,1,1,0,1,1,1,1,1,1,1,1,0,1,1,2,1,0,0,0,0,0},  // row 12
+    {1,1,1,1,1,1,2,1,1,0,1,0,0,0,0,0,0,1,0,1,1,2,1,1,1,1,1,1},  // row 13
+    {0,0,0,0,0,0,2,0,0,0,1,0,0,0,0,0,0,1,0,0,0,2,0,0,0,0,0,0},  // row 14
+    {1,1,1,1,1,1,2,1,1,0,1,0,0,0,0,0,0,1,0,1,1,2,1,1,1,1,1,1},  // row 15
+    {0,0,0,0,0,1,2,1,1,0,1,1,1,1,1,1,1,1,0,1,1,2,1,0,0,0,0,0},  // row 16
+    {0,0,0,0,0,1,2,1,1,0,0,0,0,0,0,0,0,0,0,1,1,2,1,0,0,0,0,0},  // row 17
+    {0,0,0,0,0,1,2,1,1,0,1,1,1,1,1,1,1,1,0,1,1,2,1,0,0,0,0,0},  // row 18
+    {1,1,1,1,1,1,2,1,1,0,1,1,1,1,1,1,1,1,0,1,1,2,1,1,1,1,1,1},  // row 19
+    {1,2,2,2,2,2,2,2,2,2,2,2,2,1,1,2,2,2,2,2,2,2,2,2,2,2,2,1},  // row 20
+    {1,2,1,1,1,1,2,1,1,1,1,1,2,1,1,2,1,1,1,1,1,2,1,1,1,1,2,1},  // row 21
+    {1,2,1,1,1,1,2,1,1,1,1,1,2,1,1,2,1,1,1,1,1,2,1,1,1,1,2,1},  // row 22
+    {1,3,2,2,1,1,2,2,2,2,2,2,2,0,0,2,2,2,2,2,2,2,1,1,2,2,3,1},  // row 23
+    {1,1,1,2,1,1,2,1,1,2,1,1,1,1,1,1,1,1,2,1,1,2,1,1,2,1,1,1},  // row 24
+    {1,1,1,2,1,1,2,1,1,2,1,1,1,1,1,1,1,1,2,1,1,2,1,1,2,1,1,1},  // row 25
+    {1,2,2,2,2,2,2,1,1,2,2,2,2,1,1,2,2,2,2,1,1,2,2,2,2,2,2,1},  // row 26
+    {1,2,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,1,1,1,2,1},  // row 27
+    {1,2,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,1,1,1,2,1},  // row 28
+    {1,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,1},  // row 29
+    {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}   // row 30
 };
 
 //// Layout for larger LCD display (320x240) with TILE_SIZE=12 - scaled to 19x25
@@ -143,8 +159,11 @@ static const uint8_t MAZE_LAYOUT_LCD[14][19] = {
 #endif
 
 #ifdef DISPLAY_MODULE_LCD
-#define MAZE_LAYOUT MAZE_LAYOUT_LCD
-#define MAZE_HEIGHT_ACTUAL MAZE_HEIGHT
+// The classic maze sets its own size instead of the screen
+#undef MAZE_WIDTH
+#define MAZE_WIDTH 28
+#define MAZE_LAYOUT MAZE_LAYOUT_CLASSIC
+#define MAZE_HEIGHT_ACTUAL 31
 #endif
 
 // For unit tests, default to OLED layout
@@ -153,9 +172,38 @@ static const uint8_t MAZE_LAYOUT_LCD[14][19] = {
 #define MAZE_HEIGHT_ACTUAL 6
 #endif
 
+// Screen area the maze viewport is fitted into
+#ifdef DISPLAY_MODULE_LCD
+#define MAZE_VIEW_X       (BORDER_OFFSET + 1)                            // Inside the border
+#define MAZE_VIEW_Y       (GAME_AREA_TOP + 1)
+#define MAZE_VIEW_WIDTH   (DISPLAY_WIDTH - 2 - BORDER_OFFSET - 1)
+#define MAZE_VIEW_HEIGHT  (DISPLAY_HEIGHT - 2 - GAME_AREA_TOP - 1)
+#else
+#define MAZE_VIEW_X       BORDER_OFFSET                                  // Whole maze fits on screen
+#define MAZE_VIEW_Y       GAME_AREA_TOP
+#define MAZE_VIEW_WIDTH   (MAZE_WIDTH * TILE_SIZE)
+#define MAZE_VIEW_HEIGHT  (MAZE_HEIGHT_ACTUAL * TILE_SIZE)
+#endif
+
+// Maze state for a Pacman session, taken from the game arena
+typedef struct {
+    uint8_t tiles[MAZE_HEIGHT_ACTUAL][MAZE_WIDTH];  // Working copy of the layout - dots are cleared as they are eaten
+    Tilemap tilemap;
+    Viewport viewport;
+} MazeState;
+
 // Function declarations
 
-// Convert screen coordinates to maze indices - returns int to prevent underflow
+// Convert world coordinates (pixel (0, 0) is the maze's top-left corner) to maze indices
+int world_to_maze_x(coord_t x);
+int world_to_maze_y(coord_t y);
+
+// Convert maze indices to world coordinates
+coord_t maze_to_world_x(uint8_t x);
+coord_t maze_to_world_y(uint8_t y);
+
+// Convert screen coordinates to maze indices - returns int to prevent underflow.
+// The screen variants assume the maze is drawn unscrolled at the border offset.
 int screen_to_maze_x(coord_t x);
 int screen_to_maze_y(coord_t y);
 
@@ -164,7 +212,20 @@ coord_t maze_to_screen_x(uint8_t x);
 coord_t maze_to_screen_y(uint8_t y);
 
 // Check if a coordinate contains a wall
+bool is_wall_world(coord_t x, coord_t y);
 bool is_wall(coord_t x, coord_t y);
+
+// Tile state - eaten dots are cleared so repainted tiles stay empty.
+// maze_create() takes the working copy from the game arena, once per session.
+bool maze_create(void);
+void maze_reset_tiles(void);
+uint8_t maze_get_tile(uint8_t x, uint8_t y);
+void maze_clear_tile(uint8_t x, uint8_t y);
+
+// Viewport showing the maze
+void maze_viewport_init(void);
+void maze_viewport_cleanup(void);
+Viewport* maze_get_viewport(void);
 void draw_maze(void);
 
 #endif /* INC_GAME_ENGINE_GAMES_PACMAN_MAZE_H_ */
@@ -3,6 +3,9 @@
  *
  *  Created on: Jan 14, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Games get the engine timer service with the engine header
+ *      Games get the session random stream with the engine header
  */
 
 #ifndef INC_GAME_ENGINE_GAME_ENGINE_H_
@@ -14,6 +17,10 @@
 #include <stdio.h>
 #include "Utils/misc_utils.h"
 #include "game_engine_conf.h"
+#include "game_engine_arena.h"
+#include "game_engine_timer.h"
+#include "game_engine_random.h"
+#include "Console_Peripherals/Hardware/input_events.h"
 
 typedef void (*UpdateWithJoystick)(JoystickStatus);
 typedef void (*UpdateWithDPad)(DPAD_STATUS);
@@ -37,6 +44,7 @@ typedef struct {
     void (*render)(void);            // Draw game state
     void (*cleanup)(void);           // Cleanup resources
     void (*show_game_over_message)(void); // Displays a custom game over message
+    void (*on_input_event)(const InputEvent* event);  // Optional, every queued input before each update
 
     // Union for different update function signatures
     union {
@@ -58,6 +66,7 @@ typedef struct {
     } base_state;
 
     void* game_data;  // Game-specific data
+    size_t game_data_size;  // When set, game_data is placed in the game arena on init
     bool countdown_over;
     bool return_to_main_menu;
     bool is_d_pad_game;  // Flag to determine input type
@@ -67,8 +76,11 @@ typedef struct {
 
 // Game Engine core functions
 void game_engine_init(GameEngine* engine);
+void game_engine_init_seeded(GameEngine* engine, uint32_t seed);  // Same seed and input, same game
 //void game_engine_update(GameEngine* engine, JoystickStatus js_status);
 void game_engine_update(GameEngine* engine, void* input_data);
+// One update of the game logic at now_ms with the events in queue, shared by updates and replays
+void game_engine_tick(GameEngine* engine, void* input_data, InputQueue* queue, uint32_t now_ms);
 void game_engine_render(GameEngine* engine);
 void game_engine_cleanup(GameEngine* engine);
 void game_engine_render_countdown(GameEngine* engine);
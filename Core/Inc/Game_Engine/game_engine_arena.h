@@ -0,0 +1,39 @@
+/*
+ * game_engine_arena.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Game session arena. Only one game runs at a time, so game state, render tracking
+ *  and larger per-game buffers (entity store, tilemaps) are carved out of one shared pool.
+ *  game_engine_init() resets the pool and places the game's state in it,
+ *  game_engine_cleanup() releases everything at once.
+ */
+
+#ifndef INC_GAME_ENGINE_GAME_ENGINE_ARENA_H_
+#define INC_GAME_ENGINE_GAME_ENGINE_ARENA_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Largest session is Pacman on the LCD, 4472 bytes on the target. Host builds have 8 byte
+// pointers and pass their own size.
+#ifndef GAME_ARENA_SIZE
+#define GAME_ARENA_SIZE   4472
+#endif
+#define GAME_ARENA_ALIGN  8
+
+// Bytes an allocation of size takes from the pool, for summing a game's arena needs
+#define GAME_ARENA_BLOCK(size)  (((size) + GAME_ARENA_ALIGN - 1) & ~(size_t)(GAME_ARENA_ALIGN - 1))
+
+void game_arena_reset(void);
+void* game_arena_alloc(size_t size);   // Zeroed, NULL when the pool is exhausted
+
+// Usage, for sizing GAME_ARENA_SIZE. The peak is the current session's, game_arena_reset() clears it.
+size_t game_arena_used(void);
+size_t game_arena_peak(void);
+
+// Start of the pool, save-states copy the used part out and back in place
+uint8_t* game_arena_data(void);
+
+#endif /* INC_GAME_ENGINE_GAME_ENGINE_ARENA_H_ */
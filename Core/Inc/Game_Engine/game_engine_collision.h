@@ -0,0 +1,69 @@
+/*
+ * game_engine_collision.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Collision detection for entities in the entity store.
+ *  Each entity can carry an AABB or a tile-cell collider, a layer and a mask of layers
+ *  it wants to hear about. A uniform grid (spatially hashed, so the world can be any size)
+ *  is rebuilt every step and only entities in neighbouring cells are tested, so the cost
+ *  grows with the number of entities rather than the number of pairs.
+ */
+
+#ifndef INC_GAME_ENGINE_GAME_ENGINE_COLLISION_H_
+#define INC_GAME_ENGINE_GAME_ENGINE_COLLISION_H_
+
+#include "Game_Engine/game_engine_entity.h"
+#include "Sprites/sprite.h"                  // For SPRITE_SIZE
+#include <stdint.h>
+#include <stdbool.h>
+
+#define COLLISION_CELL_SIZE    (SPRITE_SIZE * 2)  // Colliders larger than a cell are clamped
+#define COLLISION_BUCKETS      64                 // Power of two
+
+typedef enum {
+    COLLIDER_NONE = 0,
+    COLLIDER_AABB,         // Box of the given size at the entity position
+    COLLIDER_TILE          // The tile cell the entity's centre lies in
+} ColliderShape;
+
+// Called once per overlapping pair. a is the entity whose mask matched b's layer.
+typedef void (*collision_callback_t)(entity_id_t a, entity_id_t b);
+
+typedef struct {
+    uint8_t shape[ENTITY_STORE_CAPACITY];
+    uint8_t width[ENTITY_STORE_CAPACITY];
+    uint8_t height[ENTITY_STORE_CAPACITY];
+    uint8_t layer[ENTITY_STORE_CAPACITY];          // Layers this entity is on
+    uint8_t mask[ENTITY_STORE_CAPACITY];           // Layers this entity collides with, 0 if it never asks
+    entity_id_t next_in_cell[ENTITY_STORE_CAPACITY];
+    entity_id_t bucket_head[COLLISION_BUCKETS];
+    uint8_t tile_size;                             // Cell size for COLLIDER_TILE
+    collision_callback_t on_collision;
+    uint16_t candidate_pairs;                      // Pairs tested by the last update, for profiling
+} CollisionWorld;
+
+// World shared by the running game, NULL outside a session
+extern CollisionWorld* game_collisions;
+
+// Setup - the world is taken from the game arena once per session.
+// Resetting clears the colliders, set them again after creating entities.
+CollisionWorld* collision_world_create(uint8_t tile_size, collision_callback_t on_collision);
+void collision_world_reset(CollisionWorld* world, uint8_t tile_size, collision_callback_t on_collision);
+void collision_set_aabb(CollisionWorld* world, entity_id_t id, uint8_t width, uint8_t height,
+    uint8_t layer, uint8_t mask);
+void collision_set_tile(CollisionWorld* world, entity_id_t id, uint8_t layer, uint8_t mask);
+void collision_remove(CollisionWorld* world, entity_id_t id);
+
+// Rebuild the grid from the store and report every overlapping pair.
+// Entities destroyed by the callback are skipped for the rest of the update.
+void collision_update(CollisionWorld* world, const EntityStore* store);
+
+// Narrow phase test, also usable on positions that are not entities
+static inline bool collision_boxes_overlap(int32_t x1, int32_t y1, coord_t w1, coord_t h1,
+    int32_t x2, int32_t y2, coord_t w2, coord_t h2) {
+    return x1 < x2 + w2 && x2 < x1 + w1 && y1 < y2 + h2 && y2 < y1 + h1;
+}
+
+#endif /* INC_GAME_ENGINE_GAME_ENGINE_COLLISION_H_ */
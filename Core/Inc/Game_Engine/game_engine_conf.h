@@ -3,6 +3,9 @@
  *
  *  Created on: Jan 21, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Added replay recording settings
+ *      Added save-state settings
  */
 
 #ifndef INC_GAME_ENGINE_GAME_ENGINE_CONF_H_
@@ -34,6 +37,16 @@
 #define BUTTON_MENU_MIN_DURATION        2000  // Minimum hold time (2 seconds) for main menu
 #define BUTTON_MENU_MAX_DURATION        5000  // Maximum hold time (5 seconds) for main menu
 
+// Replay recording
+#define REPLAY_BUFFER_SIZE      8192    // About 100 s of play at 60 FPS
+#define REPLAY_HASH_INTERVAL    16      // Updates between state hashes, 1 to find the exact update of a desync
+#define REPLAY_DUMP_ON_EXIT     0       // Print every recording over the debug channel when the game is left
+
+// Save-states
+#define GAME_SAVE_BUFFER_SIZE   (7 * 1024)  // Staged snapshot - the game arena, timers and game statics
+#define GAME_SAVE_INTERVAL_MS   30000   // Running games are saved this often, and when paused or left
+#define GAME_SAVE_STEP_WORDS    32      // Flash words programmed per save task run, about 0.5 ms
+
 // Audio
 #define SAMPLE_COUNT 128
 extern const uint16_t SINE_WAVE_TABLE[SAMPLE_COUNT]; // Pre-calculated sine wave samples (normalized to DAC range 0-4095)
@@ -0,0 +1,77 @@
+/*
+ * game_engine_entity.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Fixed-capacity entity store laid out as structure-of-arrays.
+ *  Each component lives in its own contiguous array indexed by entity id, so
+ *  movement, collision and render passes only touch the fields they use.
+ *  One store is shared by the running game. It is taken from the game arena when
+ *  the game starts and released with the rest of the session.
+ */
+
+#ifndef INC_GAME_ENGINE_GAME_ENGINE_ENTITY_H_
+#define INC_GAME_ENGINE_GAME_ENGINE_ENTITY_H_
+
+#include "Console_Peripherals/Hardware/Drivers/display_driver.h"  // For coord_t
+#include "Game_Engine/Games/game_types.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ENTITY_STORE_CAPACITY  192                           // Multiplayer snake holds three 64 segment bodies
+#define ENTITY_MASK_WORDS      (ENTITY_STORE_CAPACITY / 32)
+#define ENTITY_NONE            0xFFFF
+
+typedef uint16_t entity_id_t;
+
+typedef struct {
+    coord_t pos_x[ENTITY_STORE_CAPACITY];
+    coord_t pos_y[ENTITY_STORE_CAPACITY];
+    int16_t vel_x[ENTITY_STORE_CAPACITY];         // Pixels per step
+    int16_t vel_y[ENTITY_STORE_CAPACITY];
+    uint8_t sprite_id[ENTITY_STORE_CAPACITY];     // Meaning is up to the game
+    uint8_t flags[ENTITY_STORE_CAPACITY];         // Game defined bits, used to filter queries
+    uint32_t active[ENTITY_MASK_WORDS];           // Bit set for every allocated entity
+} EntityStore;
+
+// Store shared by the running game, NULL outside a session
+extern EntityStore* game_entities;
+
+// Allocation - entity_store_create() is called once per session, from the game's init
+EntityStore* entity_store_create(void);
+void entity_store_reset(EntityStore* store);
+entity_id_t entity_create(EntityStore* store, coord_t x, coord_t y, uint8_t sprite_id, uint8_t flags);
+entity_id_t entity_create_block(EntityStore* store, uint16_t count);  // Contiguous ids, e.g. snake segments
+void entity_destroy(EntityStore* store, entity_id_t id);
+
+// Iteration - for (id = entity_first(s); id != ENTITY_NONE; id = entity_next(s, id))
+entity_id_t entity_next_from(const EntityStore* store, entity_id_t start);
+uint16_t entity_count(const EntityStore* store);
+
+// Passes - moving is done over a block the caller owns, e.g. the ids from entity_create_block()
+void entity_move_range(EntityStore* store, entity_id_t first, uint16_t count);
+
+static inline bool entity_is_active(const EntityStore* store, entity_id_t id) {
+    return id < ENTITY_STORE_CAPACITY && (store->active[id >> 5] & (1UL << (id & 31)));
+}
+
+static inline entity_id_t entity_first(const EntityStore* store) {
+    return entity_next_from(store, 0);
+}
+
+static inline entity_id_t entity_next(const EntityStore* store, entity_id_t id) {
+    return entity_next_from(store, id + 1);
+}
+
+static inline Position entity_get_position(const EntityStore* store, entity_id_t id) {
+    Position pos = { store->pos_x[id], store->pos_y[id] };
+    return pos;
+}
+
+static inline void entity_set_position(EntityStore* store, entity_id_t id, Position pos) {
+    store->pos_x[id] = pos.x;
+    store->pos_y[id] = pos.y;
+}
+
+#endif /* INC_GAME_ENGINE_GAME_ENGINE_ENTITY_H_ */
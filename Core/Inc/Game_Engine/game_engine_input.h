@@ -0,0 +1,45 @@
+/*
+ * game_engine_input.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Per-tick input for games. game_engine_update() drains the input event queue into the
+ *  game's on_input_event handler before calling its update, so games see every press
+ *  rather than only the latest D-pad state.
+ *
+ *  Games that move on a fixed step can keep the turns in a TurnBuffer: one turn is taken
+ *  per step, so up-then-left inside one step becomes two turns instead of the last press.
+ */
+
+#ifndef INC_GAME_ENGINE_GAME_ENGINE_INPUT_H_
+#define INC_GAME_ENGINE_GAME_ENGINE_INPUT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Console_Peripherals/Hardware/input_events.h"
+#include "Game_Engine/game_engine.h"
+
+#define GAME_TURN_BUFFER_SIZE 4
+
+typedef struct {
+    uint8_t directions[GAME_TURN_BUFFER_SIZE];
+    uint8_t count;
+    uint8_t last_queued;        // Repeats of the newest turn are not queued again
+    bool turned_this_step;      // A turn was taken since the last step
+} TurnBuffer;
+
+// Checks a turn against the current heading, e.g. to refuse reversing
+typedef bool (*turn_valid_t)(uint8_t current_direction, uint8_t new_direction);
+
+// Hand every queued event to the engine's on_input_event, returns the number drained
+uint8_t game_engine_drain_input(GameEngine* engine, InputQueue* queue);
+
+void turn_buffer_reset(TurnBuffer* turns, uint8_t direction);
+bool turn_buffer_push(TurnBuffer* turns, uint8_t direction);   // False when full
+// Next valid turn for this step, 0 if there is none or a turn was already taken.
+// Invalid turns are discarded on the way.
+uint8_t turn_buffer_take(TurnBuffer* turns, uint8_t current_direction, turn_valid_t is_valid);
+void turn_buffer_step(TurnBuffer* turns);                       // Call after each movement step
+
+#endif /* INC_GAME_ENGINE_GAME_ENGINE_INPUT_H_ */
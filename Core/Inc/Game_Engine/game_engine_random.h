@@ -0,0 +1,29 @@
+/*
+ * game_engine_random.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Random numbers for game logic. Each session draws from its own xoshiro128** stream,
+ *  seeded by game_engine_init(), so nothing else that calls get_random() moves it. The
+ *  same seed and the same input give the same game, which is what replays rely on.
+ *  xoshiro128** only needs 32-bit shifts, rotates and multiplies.
+ */
+
+#ifndef INC_GAME_ENGINE_GAME_ENGINE_RANDOM_H_
+#define INC_GAME_ENGINE_GAME_ENGINE_RANDOM_H_
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t s[4];
+} GameRandom;
+
+// Stream of the running game
+extern GameRandom game_random;
+
+void game_random_seed(GameRandom* rng, uint32_t seed);      // Any seed, 0 included
+uint32_t game_random_next(GameRandom* rng);
+uint32_t game_random_below(GameRandom* rng, uint32_t bound); // 0 to bound - 1, 0 when bound is 0
+
+#endif /* INC_GAME_ENGINE_GAME_ENGINE_RANDOM_H_ */
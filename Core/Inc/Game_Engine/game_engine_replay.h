@@ -0,0 +1,78 @@
+/*
+ * game_engine_replay.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Replay recording. Every session records its random seed, the time step of each
+ *  game update, the input events the game drained and the controller status whenever it
+ *  changes, into a RAM buffer. Every REPLAY_HASH_INTERVAL updates a hash of the game state
+ *  is added. replay_dump() prints the recording in hex over the debug channel.
+ *
+ *  replay_play() runs a recording back through the game's update without rendering and
+ *  compares the state hashes on the way, so a session that stuttered or desynced on the
+ *  console can be run again on the host, as often as needed.
+ *
+ *  Records, after the header:
+ *      0x80 | dt               Update, dt ms after the previous one (dt < 128)
+ *      0x04 dt[4]              Update with a longer step
+ *      0x01 source state       Input event drained before the update
+ *      0x02 size status[size]  Controller status handed to the update
+ *      0x03 hash[4]            State hash after the update
+ *      0x00                    End
+ *  Multi-byte values are little-endian.
+ */
+
+#ifndef INC_GAME_ENGINE_GAME_ENGINE_REPLAY_H_
+#define INC_GAME_ENGINE_GAME_ENGINE_REPLAY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Game_Engine/game_engine.h"
+
+#define REPLAY_MAGIC    0x31504C52UL   // "RPL1"
+#define REPLAY_VERSION  1
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t hash_interval;
+    uint16_t game_data_size;    // Checked against the game it is played on
+    uint32_t seed;
+    uint32_t frames;            // Updates recorded
+    uint32_t length;            // Bytes, header and end record included
+} ReplayHeader;
+
+typedef enum {
+    REPLAY_IDLE,
+    REPLAY_RECORDING,
+    REPLAY_FULL,                // Stopped at the last whole update that fit
+    REPLAY_PLAYING
+} ReplayState;
+
+typedef struct {
+    uint32_t frames;            // Updates run
+    uint32_t hashes_checked;
+    uint32_t mismatch_frame;    // First update whose hash differed, 0 if none did
+    bool complete;              // Reached the end record
+} ReplayResult;
+
+// Recorder, driven by the game engine. Does nothing while a replay is playing.
+void replay_record_start(const GameEngine* engine, uint32_t seed, uint32_t now_ms);
+void replay_record_frame(uint32_t now_ms);
+void replay_record_pause(void);     // Updates skipped while paused, the game clock stood still
+void replay_record_input(const InputEvent* event);
+void replay_record_status(const void* status, uint8_t size);
+void replay_record_frame_end(const GameEngine* engine);
+void replay_record_stop(void);
+
+ReplayState replay_get_state(void);
+const uint8_t* replay_get_recording(uint32_t* length);
+void replay_dump(void);
+
+uint32_t replay_state_hash(const GameEngine* engine);
+
+// Runs a recording on engine from game_engine_init() on, true if it ended and every hash matched
+bool replay_play(GameEngine* engine, const uint8_t* data, uint32_t length, ReplayResult* result);
+
+#endif /* INC_GAME_ENGINE_GAME_ENGINE_REPLAY_H_ */
@@ -0,0 +1,85 @@
+/*
+ * game_engine_save.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Save-states. A snapshot holds everything a session changes: the engine's base state,
+ *  the used part of the game arena (game data, entities, render tracking, tilemaps), the
+ *  game timer wheel, the session random stream and the statics the game lists in its
+ *  GameSaveDescriptor. Restoring runs the game's init first, so the arena has the same
+ *  layout, then copies the snapshot over it and the game continues from the next update.
+ *
+ *  Timers and some arena data hold code and RAM addresses, so a snapshot is only
+ *  restored by the firmware image and game version that wrote it - anything else is
+ *  dropped and the game starts fresh.
+ *
+ *  game_save_capture() copies the state into a staging buffer between frames, the save
+ *  store then writes it to flash a few words per game_save_service() call.
+ */
+
+#ifndef INC_GAME_ENGINE_GAME_ENGINE_SAVE_H_
+#define INC_GAME_ENGINE_GAME_ENGINE_SAVE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "Game_Engine/game_engine.h"
+
+#define GAME_SAVE_MAGIC     0x31545347UL   // "GST1"
+#define GAME_SAVE_FORMAT    1
+
+// Game state outside the arena, e.g. a static timer id
+typedef struct {
+    void* data;
+    size_t size;
+} GameSaveRegion;
+
+typedef struct {
+    uint16_t version;                   // Bump when the game's state layout changes
+    const GameSaveRegion* regions;      // Optional
+    uint8_t region_count;
+    void (*on_restore)(void);           // Optional, e.g. ask for a full redraw
+} GameSaveDescriptor;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t image_id;          // flash_driver_image_id() of the writer
+    uint16_t format;
+    uint16_t game_version;
+    uint16_t arena_used;
+    uint16_t region_bytes;
+} GameSaveHeader;
+
+typedef struct {
+    uint32_t snapshot_bytes;    // Of the last save
+    uint32_t capture_us;        // Copying it to the staging buffer
+    uint32_t write_us;          // Programming it, over write_steps service calls
+    uint16_t write_steps;
+    uint32_t restore_us;        // Init and copy of the last restore
+    uint32_t saves;
+    uint32_t restores;
+    uint32_t busy;              // Captures refused while a save was still being written
+    uint32_t rejected;          // Snapshots of another image or game version
+} GameSaveStats;
+
+void game_save_init(void);          // Mount the save store
+
+// Stage a snapshot of the running session under key and start writing it.
+// Returns the snapshot size, 0 if it was not taken.
+uint32_t game_save_capture(uint16_t key, const GameEngine* engine, const GameSaveDescriptor* save);
+// Initialise engine and continue from the stored snapshot of key when there is a usable
+// one. Returns true if the session was restored, false if it starts fresh.
+bool game_save_resume(uint16_t key, GameEngine* engine, const GameSaveDescriptor* save);
+void game_save_discard(uint16_t key);   // The session ended, nothing to resume
+
+// Key of the most recently saved session, false if it was discarded or there is none
+bool game_save_latest(uint16_t* key);
+
+// Save task: write the staged snapshot a few words at a time, and compact the store
+// when no game is running. True while there is more to write.
+bool game_save_service(bool game_active);
+
+const GameSaveStats* game_save_get_stats(void);
+
+#endif /* INC_GAME_ENGINE_GAME_ENGINE_SAVE_H_ */
@@ -0,0 +1,84 @@
+/*
+ * game_engine_timer.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Timer service for game and UI timeouts. Timers sit in a hierarchical timing wheel:
+ *  three levels of 64 slots at 1 ms, 64 ms and 4 s per slot. Starting or cancelling a
+ *  timer is O(1), and advancing the wheel only touches the slot of the current tick, plus
+ *  a cascade of one upper slot every 64 ticks - the cost follows the timers that expire,
+ *  not the timers that exist.
+ *
+ *  Callbacks run inside timer_wheel_advance(). game_engine_update() advances game_timers
+ *  after the game's update, and pauses it while the game is paused or over, so game
+ *  timers do not run down behind the pause screen. After a stall (a flash erase, a slow
+ *  flush) only TIMER_WHEEL_MAX_CATCHUP_MS is caught up and the rest is dropped like paused
+ *  time, so a game never runs a burst of steps in one frame.
+ */
+
+#ifndef INC_GAME_ENGINE_GAME_ENGINE_TIMER_H_
+#define INC_GAME_ENGINE_GAME_ENGINE_TIMER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TIMER_WHEEL_BITS        6
+#define TIMER_WHEEL_SLOTS       (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_LEVELS      3
+#define TIMER_WHEEL_MAX_TIMERS  16
+#define TIMER_WHEEL_TICK_MS     1
+// Longer delays are cut to this, about 4.4 minutes
+#define TIMER_WHEEL_MAX_TICKS   ((1UL << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1)
+// Most time one advance catches up - under the shortest game step, so no step runs twice
+#define TIMER_WHEEL_MAX_CATCHUP_MS  100
+
+// Slot index in the low byte, a generation in the high byte so a stale id from a fired
+// one-shot cannot cancel the timer that reused its slot
+typedef uint16_t timer_id_t;
+#define TIMER_NONE 0xFFFF
+
+typedef void (*timer_callback_t)(void* context);
+
+typedef struct {
+    timer_callback_t callback;
+    void* context;
+    uint32_t expires;       // Absolute tick
+    uint32_t period;        // Ticks, 0 for one-shot
+    uint8_t next;           // Slot list links, TIMER_WHEEL_MAX_TIMERS terminates
+    uint8_t prev;
+    uint8_t slot;           // level * TIMER_WHEEL_SLOTS + index
+    uint8_t generation;
+    bool active;
+} WheelTimer;
+
+typedef struct {
+    WheelTimer timers[TIMER_WHEEL_MAX_TIMERS];
+    uint8_t slots[TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS];   // List heads
+    uint32_t tick;          // Last tick processed
+    uint32_t last_ms;       // Time of tick
+    uint8_t free_head;      // Unused timers, linked through next
+    uint8_t active_count;
+    bool paused;
+} TimerWheel;
+
+extern TimerWheel game_timers;     // Reset by game_engine_init(), ticked with the game
+
+void timer_wheel_init(TimerWheel* wheel, uint32_t now_ms);
+// Catch up to now_ms, at most TIMER_WHEEL_MAX_CATCHUP_MS, and run the callbacks of every
+// timer that expired, in expiry order. Returns the number of callbacks run.
+uint8_t timer_wheel_advance(TimerWheel* wheel, uint32_t now_ms);
+void timer_wheel_pause(TimerWheel* wheel);
+void timer_wheel_resume(TimerWheel* wheel, uint32_t now_ms);    // Paused time is skipped
+
+// Delays are from the wheel's last advance. Returns TIMER_NONE when every timer is in use.
+timer_id_t timer_start(TimerWheel* wheel, uint32_t delay_ms, uint32_t period_ms,
+                       timer_callback_t callback, void* context);
+bool timer_cancel(TimerWheel* wheel, timer_id_t id);              // False if already gone
+bool timer_restart(TimerWheel* wheel, timer_id_t id, uint32_t delay_ms);
+// New period for a periodic timer, the running period is measured from its last expiry
+bool timer_set_period(TimerWheel* wheel, timer_id_t id, uint32_t period_ms);
+bool timer_is_active(const TimerWheel* wheel, timer_id_t id);
+uint32_t timer_remaining_ms(const TimerWheel* wheel, timer_id_t id);  // 0 if not active
+
+#endif /* INC_GAME_ENGINE_GAME_ENGINE_TIMER_H_ */
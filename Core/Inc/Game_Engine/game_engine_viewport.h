@@ -0,0 +1,65 @@
+/*
+ * game_engine_viewport.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Camera/viewport for games whose tilemap is larger than the display.
+ *  Game logic works in world coordinates, the viewport maps them to the screen,
+ *  culls what is off-screen and repaints only the tiles exposed by scrolling.
+ */
+
+#ifndef INC_GAME_ENGINE_GAME_ENGINE_VIEWPORT_H_
+#define INC_GAME_ENGINE_GAME_ENGINE_VIEWPORT_H_
+
+#include "Console_Peripherals/Hardware/Drivers/display_driver.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Paints one tile at a screen position. The tile area is already cleared to black.
+typedef void (*tile_draw_callback_t)(uint8_t tile, coord_t screen_x, coord_t screen_y);
+
+// Tilemap in world space - world pixel (0, 0) is the top-left corner of tile (0, 0)
+typedef struct {
+    const uint8_t* tiles;            // Row-major tile values
+    uint16_t width;                  // Width in tiles
+    uint16_t height;                 // Height in tiles
+    uint16_t stride;                 // Entries per row in tiles[] (>= width)
+    uint8_t tile_size;               // Tile edge in pixels
+    tile_draw_callback_t draw_tile;
+} Tilemap;
+
+typedef struct {
+    const Tilemap* map;
+    coord_t screen_x;                // Window position on the display
+    coord_t screen_y;
+    coord_t width;                   // Window size in pixels, whole tiles
+    coord_t height;
+    int32_t cam_x;                   // World position shown at the window's top-left corner
+    int32_t cam_y;
+    int32_t drawn_cam_x;             // Camera position currently on the panel
+    int32_t drawn_cam_y;
+    coord_t margin_x;                // Dead zone kept between the followed target and the window edge
+    coord_t margin_y;
+    coord_t scroll_offset;           // Rows the hardware has scrolled the window by
+    bool hw_scroll;                  // Vertical moves are done by the display controller
+    bool needs_full_redraw;
+} Viewport;
+
+// Setup and teardown - the window is fitted inside the given screen area
+void viewport_init(Viewport* vp, const Tilemap* map, coord_t area_x, coord_t area_y,
+    coord_t area_width, coord_t area_height);
+void viewport_cleanup(Viewport* vp);
+
+// Camera control
+void viewport_follow(Viewport* vp, int32_t world_x, int32_t world_y, coord_t width, coord_t height);
+void viewport_invalidate(Viewport* vp);
+bool viewport_render(Viewport* vp);  // Returns true if any tiles were repainted
+
+// World to screen mapping and culling
+bool viewport_is_visible(const Viewport* vp, int32_t world_x, int32_t world_y, coord_t width, coord_t height);
+coord_t viewport_to_screen_x(const Viewport* vp, int32_t world_x);
+coord_t viewport_to_screen_y(const Viewport* vp, int32_t world_y);
+void viewport_redraw_world_rect(const Viewport* vp, int32_t world_x, int32_t world_y, coord_t width, coord_t height);
+
+#endif /* INC_GAME_ENGINE_GAME_ENGINE_VIEWPORT_H_ */
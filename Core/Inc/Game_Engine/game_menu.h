@@ -9,6 +9,7 @@
 #define INC_GAME_ENGINE_GAME_MENU_H_
 
 #include <stdint.h>
+#include <stddef.h>
 #include "Utils/debug_conf.h"
 
 #define MAX_MENU_ITEMS  5  // Maximum number of games that can be displayed in menu
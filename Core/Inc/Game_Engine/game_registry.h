@@ -0,0 +1,63 @@
+/*
+ * game_registry.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Table of the games on the console. Each game file registers one descriptor with
+ *  REGISTER_GAME(); the linker gathers them into the game_registry section, so the
+ *  controller and menus look games up here instead of switching on ScreenType.
+ *  Per-game assets are built on the first launch of a game and kept for the rest of the boot.
+ */
+
+#ifndef INC_GAME_ENGINE_GAME_REGISTRY_H_
+#define INC_GAME_ENGINE_GAME_REGISTRY_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Console_Peripherals/UI/menu_system.h"  // For ScreenType, GameMode and MenuItem
+#include "Game_Engine/game_engine.h"
+#include "Game_Engine/game_engine_save.h"
+
+#define GAME_REGISTRY_MAX_GAMES 16    // Size of the assets-loaded mask
+#define GAME_ASSET_POOL_SIZE    512   // Cached assets of every game launched this boot
+
+typedef enum {
+    GAME_INPUT_DPAD,
+    GAME_INPUT_JOYSTICK
+} GameInputKind;
+
+typedef struct {
+    const char* name;              // Menu title
+    ScreenType screen;
+    GameMode mode;
+    GameInputKind input;
+    uint8_t menu_order;            // Position in its menu, lowest first
+    size_t arena_size;             // Game arena bytes a session needs
+    GameEngine* engine;            // init/update/render/cleanup
+    void (*load_assets)(void);     // Optional, run once before the first launch
+    const GameSaveDescriptor* save;  // Optional, the game is saved and resumed across launches
+} GameDescriptor;
+
+// Place a descriptor in the registry section, e.g.
+//     REGISTER_GAME(snake_game_descriptor) = { .name = "Snake Game", ... };
+#define REGISTER_GAME(id) \
+    const GameDescriptor id __attribute__((used, section("game_registry"), aligned(4)))
+
+// Iteration, in link order
+uint8_t game_registry_count(void);
+const GameDescriptor* game_registry_get(uint8_t index);
+const GameDescriptor* game_registry_find(ScreenType screen);
+
+// Fill items with the games of one mode, sorted by menu_order. Returns the number written.
+uint8_t game_registry_build_menu(GameMode mode, MenuItem* items, uint8_t max_items);
+
+// Load the game's assets if this is its first launch and return its engine, ready for
+// game_engine_init(). NULL if the screen has no game or the game cannot fit the arena.
+GameEngine* game_registry_prepare(ScreenType screen);
+bool game_registry_assets_loaded(const GameDescriptor* game);
+
+// For load_assets - memory that is never released. NULL when the pool is exhausted.
+void* game_registry_asset_alloc(size_t size);
+
+#endif /* INC_GAME_ENGINE_GAME_REGISTRY_H_ */
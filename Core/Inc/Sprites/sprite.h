@@ -3,12 +3,17 @@
  *
  *  Created on: Jan 14, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Animations can step on a timer instead of polling the clock
  */
 
 #ifndef INC_SPRITES_SPRITE_H_
 #define INC_SPRITES_SPRITE_H_
 
 #include <Console_Peripherals/Hardware/Drivers/display_driver.h>
+#include "Game_Engine/game_engine_timer.h"
+#include <stdbool.h>
+#include <stddef.h>
 
 #ifdef DISPLAY_MODULE_LCD
 #define STATUS_START_Y 19 // Font_11X18's height + 1
@@ -34,6 +39,14 @@ typedef struct {
     uint32_t last_update;     // Time of last frame update
 } AnimatedSprite;
 
+// Frames turned by 90, 180 and 270 degrees, built once so drawing a rotated
+// sprite is a plain bitmap copy instead of per-pixel trig
+typedef struct {
+    const Sprite* source;     // Unrotated frames
+    Sprite* turns;            // [(quarter_turn - 1) * num_frames + frame], NULL until built
+    uint8_t num_frames;
+} RotatedSprite;
+
 // Macros
 //#define SPRITE_SIZE  8    // Size of sprites in pixels
 #define BORDER_OFFSET     8    // Offset from screen border
@@ -45,6 +58,13 @@ void sprite_draw(const Sprite* sprite, uint16_t x, uint16_t y, DisplayColor colo
 void sprite_draw_rotated(const Sprite* sprite, uint16_t x, uint16_t y, uint16_t angle, DisplayColor color);
 void sprite_draw_scaled(const Sprite* sprite, uint16_t x, uint16_t y, float scale, DisplayColor color);
 void animated_sprite_update(AnimatedSprite* sprite);
+// Step the frames on a periodic timer of frame_delay instead of calling animated_sprite_update()
+timer_id_t animated_sprite_start(AnimatedSprite* sprite, TimerWheel* wheel);
 void animated_sprite_draw(const AnimatedSprite* sprite, uint16_t x, uint16_t y, DisplayColor color);
 
+// Rotation cache - frames must be square. buffer holds sprite_rotations_size() bytes.
+size_t sprite_rotations_size(const Sprite* frames, uint8_t num_frames);
+bool sprite_rotations_build(RotatedSprite* rotated, const Sprite* frames, uint8_t num_frames, void* buffer);
+const Sprite* sprite_rotation_get(const RotatedSprite* rotated, uint8_t frame, uint16_t angle);  // NULL if not cached
+
 #endif /* INC_SPRITES_SPRITE_H_ */
@@ -3,6 +3,8 @@
  *
  *  Created on: Dec 15, 2024
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      TIM3 replaces TIM6 as the joystick ADC trigger
  */
 
 #ifndef INC_SYSTEM_PERIPHERALS_TIMER_CONF_H_
@@ -10,10 +12,13 @@
 
 #include "main.h"
 
-extern TIM_HandleTypeDef htim6;
+// Joystick conversions per second, TIM3 TRGO starts one X/Y conversion sequence each period
+#define JOYSTICK_SAMPLE_RATE_HZ 1000
+
+extern TIM_HandleTypeDef htim3;
 extern TIM_HandleTypeDef htim4;
 
-void MX_TIM6_Init(void);
+void MX_TIM3_Init(void);
 void MX_TIM4_Init(void);
 
 #endif /* INC_SYSTEM_PERIPHERALS_TIMER_CONF_H_ */
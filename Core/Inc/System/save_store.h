@@ -0,0 +1,71 @@
+/*
+ * save_store.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Log-structured record store on the two save sectors of flash_driver.h. Records are
+ *  appended to the active sector, so each page is programmed once per erase, and the
+ *  newest committed record of a key wins. When the active sector fills up, compaction
+ *  copies the newest record of every key to the other sector and makes it active - the
+ *  two sectors take turns, which levels their wear.
+ *
+ *  A record is written header first, then its payload, then a commit word, a few words
+ *  per save_store_step() so writing never holds up a frame. A record cut short by a
+ *  reset has no commit word and is passed over, the previous record of its key stays
+ *  current. Compaction writes the new sector's header last for the same reason.
+ *
+ *  Compaction erases a sector, which stalls the CPU for 1-2 s - save_store_compact() is
+ *  left to the caller, for when nothing is animating.
+ */
+
+#ifndef INC_SYSTEM_SAVE_STORE_H_
+#define INC_SYSTEM_SAVE_STORE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SAVE_STORE_MAX_KEYS          16     // Distinct keys kept by compaction
+#define SAVE_STORE_COMPACT_PERCENT   75     // Active sector use at which compaction is due
+
+typedef struct {
+    uint16_t key;
+    uint16_t version;
+    uint32_t sequence;      // Store-wide write order
+    uint32_t length;        // 0 for a removed key
+    const uint8_t* data;    // In flash, valid until the next compaction
+} SaveRecord;
+
+typedef struct {
+    uint32_t records_written;
+    uint32_t bytes_written;     // Payload bytes
+    uint32_t torn_records;      // Found without a commit word or with a bad CRC
+    uint32_t write_failures;
+    uint32_t compactions;
+    uint32_t erases;
+    uint32_t used_bytes;        // Of the active sector
+    uint8_t active_sector;
+} SaveStoreStats;
+
+// Find the active sector and the end of its log, formatting blank flash
+bool save_store_init(void);
+
+// Newest committed record of key, removed keys included. False if there is none.
+bool save_store_find(uint16_t key, SaveRecord* record);
+// Newest committed record of any key
+bool save_store_latest(SaveRecord* record);
+
+// Start appending a record. data must stay unchanged until the write completes.
+// False while another write is in progress or when the active sector is full.
+bool save_store_begin(uint16_t key, uint16_t version, const void* data, uint32_t length);
+bool save_store_remove(uint16_t key);       // Append an empty record
+// Program up to max_words words of the pending record. True while more remain.
+bool save_store_step(uint16_t max_words);
+bool save_store_busy(void);
+
+bool save_store_needs_compaction(void);
+bool save_store_compact(void);              // Blocking, see above
+
+const SaveStoreStats* save_store_get_stats(void);
+
+#endif /* INC_SYSTEM_SAVE_STORE_H_ */
@@ -0,0 +1,70 @@
+/*
+ * scheduler.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Cooperative run-to-completion scheduler for the main loop. A task is periodic, event
+ *  triggered, or both: periodic tasks are released on a fixed grid of period_us, event
+ *  tasks run after scheduler_signal() (safe from ISRs). Tasks run in the order they were
+ *  added, which is their priority. When nothing is due the idle hook is called - on the
+ *  target it sleeps in WFI until the next interrupt.
+ *
+ *  Every task keeps its run count, run time, release lateness and deadline misses.
+ */
+
+#ifndef INC_SYSTEM_SCHEDULER_H_
+#define INC_SYSTEM_SCHEDULER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SCHEDULER_MAX_TASKS     8
+#define SCHEDULER_NO_TASK       0xFF
+#define SCHEDULER_MIN_IDLE_US   1000    // Shorter gaps are polled, SysTick wakes WFI every 1 ms
+
+typedef void (*scheduler_task_t)(void);
+typedef uint32_t (*scheduler_clock_t)(void);            // Free-running microseconds
+typedef void (*scheduler_idle_t)(uint32_t idle_us);     // Sleep for at most idle_us
+
+typedef struct {
+    const char* name;
+    scheduler_task_t run;
+    uint32_t period_us;         // 0 for event-only tasks
+    uint32_t deadline_us;       // From release to completion, 0 for no deadline
+    uint32_t next_release_us;
+
+    uint32_t runs;
+    uint32_t missed;            // Runs that finished after their deadline
+    uint32_t skipped;           // Periodic releases dropped while the task was behind
+    uint32_t max_run_us;
+    uint32_t max_late_us;       // Start time after release
+    uint64_t total_run_us;
+} SchedulerTask;
+
+typedef struct {
+    uint64_t busy_us;           // Time spent in tasks
+    uint64_t idle_us;           // Time spent in the idle hook
+    uint32_t idle_calls;
+} SchedulerStats;
+
+void scheduler_init(scheduler_clock_t clock, scheduler_idle_t idle);
+
+// Returns the task id, SCHEDULER_NO_TASK if the table is full
+uint8_t scheduler_add_periodic(const char* name, scheduler_task_t run, uint32_t period_us,
+                               uint32_t deadline_us);
+uint8_t scheduler_add_event(const char* name, scheduler_task_t run, uint32_t deadline_us);
+
+void scheduler_signal(uint8_t task_id);     // Release an event task, safe from ISRs
+bool scheduler_has_pending(void);           // An event is waiting to run
+
+// Run every task that is due. Returns false if nothing ran and the idle hook was called.
+bool scheduler_run_once(void);
+void scheduler_run(void);                   // Never returns
+
+const SchedulerTask* scheduler_get_task(uint8_t task_id);
+const SchedulerStats* scheduler_get_stats(void);
+void scheduler_reset_stats(void);
+void scheduler_report(void);                // Print the accounting of every task
+
+#endif /* INC_SYSTEM_SCHEDULER_H_ */
@@ -4,6 +4,14 @@
  *  Created on: Apr 25, 2025
  *      Author: rohitimandi
  *  Modified: Added circular buffer and message queue utilities
+ *  Modified on: Oct 18, 2026
+ *      Added the DMA receive ring and span parsing
+ *      Added transmit queue statistics and overwriting puts
+ *      Added COBS framing with a sequence number and CRC, and delimited parsing
+ *      Frames carry a CRC-32 the STM32 CRC unit can compute, slice-by-4 in software
+ *      Circular buffer is a lock-free single producer, single consumer ring with span copies
+ *      Added the message slot pool, frames are received and read in place
+ *      Frame codec, its software CRC and the message parser moved to serial_frame.h, shared with the ESP32
  */
 
 #ifndef INC_UTILS_COMM_UTILS_H_
@@ -12,20 +20,38 @@
 #include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "Utils/serial_frame.h"
 
 /* Circular Buffer Configuration */
-#define CIRCULAR_BUFFER_SIZE 1024
+#define CIRCULAR_BUFFER_SIZE 1024      // Power of two, at most 32768
 #define MESSAGE_QUEUE_SIZE 8
 
-/* Circular Buffer Handle */
+/* Circular Buffer Handle - lock-free for one producer (e.g. an ISR) and one consumer. head and
+ * tail are free-running and each is written by one side only, the slot is the low bits.
+ * Producer: put, write_span. Consumer: get, read_span, peek, peek_contiguous, consume, flush. */
 typedef struct {
     uint8_t buffer[CIRCULAR_BUFFER_SIZE];
-    volatile uint16_t head;
-    volatile uint16_t tail;
-    volatile uint16_t count;
-    uint32_t overflow_count;
+    volatile uint16_t head;             // Producer only
+    volatile uint16_t tail;             // Consumer only
+    uint32_t overflow_count;            // Bytes dropped by the producer, buffer full
 } circular_buffer_t;
 
+/* DMA Receive Ring - a circular DMA writes the buffer, the RX event interrupt reports how far
+ * it got and the reader takes contiguous spans straight out of it. Size must be a power of two. */
+typedef struct {
+    uint8_t* buffer;
+    uint16_t size;
+    uint16_t write_pos;                 // DMA position at the last event, ISR only
+    volatile uint32_t write_total;      // Bytes written by the DMA since init, counting skipped laps
+    volatile uint32_t gap_start;        // write_total where the DMA stopped before its last restart
+    volatile uint32_t restart_total;    // write_total where it started again
+    volatile uint16_t restarts;
+    uint16_t restarts_seen;
+    uint32_t read_total;
+    uint32_t overflow_count;            // Bytes overwritten before they were read
+    uint32_t breaks;                    // Times the stream was cut, the reader drops any partial message
+} dma_rx_ring_t;
+
 /* Message Queue Handle */
 typedef struct {
     void* queue_buffer;           // Points to array of any type
@@ -37,13 +63,22 @@ typedef struct {
     uint32_t overflow_count;
 } message_queue_t;
 
-/* Message Parser State */
+/* Message Slot Pool - fixed size slots a message is written into once and read where it lies.
+ * The writer acquires a free slot, fills it and commits it; committed slots wait in arrival
+ * order until the reader borrows one, and it goes back to the pool when the reader releases it. */
+#define MESSAGE_POOL_MAX_SLOTS  32      // Power of two
+
 typedef struct {
-    uint8_t* parse_buffer;
-    uint16_t parse_index;
-    uint16_t expected_size;
-    bool parsing_active;
-} message_parser_t;
+    uint8_t* storage;                   // slot_count * slot_size bytes
+    uint16_t slot_size;
+    uint8_t slot_count;
+    uint32_t free_slots;                // Bit per slot
+    uint8_t ready[MESSAGE_POOL_MAX_SLOTS];
+    uint8_t ready_head;                 // Free-running, the index is the low bits
+    uint8_t ready_tail;
+    uint8_t used_peak;
+    uint32_t exhausted;                 // Acquires refused, every slot was in use
+} message_pool_t;
 
 /* Statistics Structure */
 typedef struct {
@@ -52,7 +87,16 @@ typedef struct {
     uint32_t messages_parsed;
     uint32_t parse_errors;
     uint32_t buffer_overflows;
-    uint32_t queue_overflows;
+    uint32_t queue_overflows;       // Times received messages found the queue or slot pool full
+    uint32_t tx_frames_sent;
+    uint32_t tx_dropped;            // New frames refused by a full transmit queue
+    uint32_t tx_overwritten;        // Waiting frames replaced by newer ones
+    uint32_t tx_errors;             // Transmissions that failed or could not start
+    uint16_t tx_queue_depth;        // Frames waiting to go out
+    uint16_t tx_queue_peak;
+    uint32_t tx_send_us_max;        // Longest a send call held its caller
+    uint32_t rx_frames_lost;        // Gaps in the received sequence numbers
+    uint32_t rx_bytes_copied;       // Moved between the DMA buffer and the message handler
 } comm_stats_t;
 
 // Circular Buffer APIs
@@ -63,22 +107,40 @@ uint16_t circular_buffer_available(const circular_buffer_t* cb);
 uint16_t circular_buffer_free_space(const circular_buffer_t* cb);
 void circular_buffer_flush(circular_buffer_t* cb);
 uint16_t circular_buffer_peek(const circular_buffer_t* cb, uint8_t* buffer, uint16_t max_bytes);
+uint16_t circular_buffer_write_span(circular_buffer_t* cb, const uint8_t* data, uint16_t length);  // Bytes written, the rest dropped
+uint16_t circular_buffer_read_span(circular_buffer_t* cb, uint8_t* data, uint16_t max_bytes);
+// Unread bytes up to the end of the buffer, in place - hand them back with consume
+uint16_t circular_buffer_peek_contiguous(const circular_buffer_t* cb, const uint8_t** data);
+void circular_buffer_consume(circular_buffer_t* cb, uint16_t count);
+
+// DMA Receive Ring APIs
+void dma_rx_ring_init(dma_rx_ring_t* ring, uint8_t* buffer, uint16_t size);
+void dma_rx_ring_advance(dma_rx_ring_t* ring, uint16_t position);  // From the RX event interrupt
+void dma_rx_ring_restart(dma_rx_ring_t* ring);                     // From the ISR, before the DMA starts over at 0
+uint16_t dma_rx_ring_span(dma_rx_ring_t* ring, const uint8_t** data);
+void dma_rx_ring_consume(dma_rx_ring_t* ring, uint16_t count);
+uint16_t dma_rx_ring_available(const dma_rx_ring_t* ring);
+void dma_rx_ring_flush(dma_rx_ring_t* ring);
 
 // Message Queue APIs
 void message_queue_init(message_queue_t* mq, void* queue_buffer, uint8_t max_messages, uint16_t message_size);
 bool message_queue_put(message_queue_t* mq, const void* msg);
+bool message_queue_put_overwrite(message_queue_t* mq, const void* msg);  // True if the oldest was dropped for it
 bool message_queue_get(message_queue_t* mq, void* msg);
 uint8_t message_queue_available(const message_queue_t* mq);
 bool message_queue_is_full(const message_queue_t* mq);
 bool message_queue_is_empty(const message_queue_t* mq);
 void message_queue_flush(message_queue_t* mq);
 
-// Message Parser APIs
-void message_parser_init(message_parser_t* parser, uint8_t* buffer, uint16_t buffer_size);
-void message_parser_reset(message_parser_t* parser);
-bool message_parser_add_byte(message_parser_t* parser, uint8_t data, uint8_t start_byte);
-bool message_parser_is_complete(const message_parser_t* parser);
-uint8_t* message_parser_get_buffer(const message_parser_t* parser);
+// Message Slot Pool APIs
+void message_pool_init(message_pool_t* pool, uint8_t* storage, uint8_t slot_count, uint16_t slot_size);
+uint8_t* message_pool_acquire(message_pool_t* pool);                       // NULL if every slot is in use
+void message_pool_commit(message_pool_t* pool, const uint8_t* slot);
+const uint8_t* message_pool_borrow(message_pool_t* pool);                  // Oldest committed slot, NULL if none
+void message_pool_release(message_pool_t* pool, const uint8_t* slot);      // Borrowed, or acquired and not committed
+uint8_t message_pool_ready(const message_pool_t* pool);
+uint8_t message_pool_free(const message_pool_t* pool);
+void message_pool_flush(message_pool_t* pool);
 
 // Circular buffer Communication Statistics APIs
 void comm_stats_init(comm_stats_t* stats);
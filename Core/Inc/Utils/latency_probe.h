@@ -0,0 +1,74 @@
+/*
+ * latency_probe.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Input-to-photon latency, per game. Each input edge keeps its ISR timestamp through the
+ *  input queue; the probe notes the simulation tick that drained it, and the game marks
+ *  the screen area its response will be drawn in. The sample closes when a
+ *  display_manager_update() whose drawing overlaps that area returns - on the ILI9341
+ *  every drawing call goes straight out over SPI, so that is when the pixels are on the
+ *  panel. An input no game marked closes on any flush that drew something.
+ *
+ *  Build with LATENCY_PROBE_ENABLE=1 to record. Otherwise every call compiles to nothing.
+ */
+
+#ifndef INC_UTILS_LATENCY_PROBE_H_
+#define INC_UTILS_LATENCY_PROBE_H_
+
+#include "Console_Peripherals/Hardware/Drivers/display_driver.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef LATENCY_PROBE_ENABLE
+    #define LATENCY_PROBE_ENABLE 0  // Default to disabled
+#endif
+
+#define LATENCY_PROBE_GAMES      8      // Games with their own histogram
+#define LATENCY_PROBE_PENDING    8      // Inputs waiting for a flush
+#define LATENCY_PROBE_BUCKETS    16
+#define LATENCY_PROBE_BUCKET_US  4000   // 0-64 ms, the last bucket also takes anything slower
+#define LATENCY_PROBE_TIMEOUT_US 1000000 // A marked area not drawn by then is given up on
+
+typedef struct {
+    const char* name;
+    uint32_t buckets[LATENCY_PROBE_BUCKETS];
+    uint32_t count;
+    uint32_t dropped;       // Inputs that arrived while LATENCY_PROBE_PENDING were waiting
+    uint32_t expired;       // Inputs whose marked area was not drawn within LATENCY_PROBE_TIMEOUT_US
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint64_t queued_us;     // Part of total_us spent before a game tick drained the input
+    uint32_t ticks;         // Simulation ticks between draining and the flush, summed
+} LatencyHistogram;
+
+#if LATENCY_PROBE_ENABLE
+    void latency_probe_reset(void);
+    void latency_probe_begin(const char* game_name);   // Following samples go to this game
+    void latency_probe_tick(void);                     // Once per simulation tick
+    void latency_probe_input(uint32_t edge_us);        // An input edge was handed to the game
+    // The response to the inputs not yet marked is drawn within one size of the size x size
+    // square at x, y - the tile a player sprite moves into from there
+    void latency_probe_mark(coord_t x, coord_t y, coord_t size);
+    // A display flush completed, drawing the region x1, y1 to x2, y2 if drew
+    void latency_probe_flushed(bool drew, coord_t x1, coord_t y1, coord_t x2, coord_t y2);
+    void latency_probe_report(void);                   // Print the current game's histogram
+
+    const LatencyHistogram* latency_probe_get(const char* game_name);
+    // Upper bound of the bucket holding the given percentile, 0 without samples
+    uint32_t latency_probe_percentile(const LatencyHistogram* histogram, uint8_t percent);
+#else
+    static inline void latency_probe_reset(void) {}
+    static inline void latency_probe_begin(const char* game_name) { (void)game_name; }
+    static inline void latency_probe_tick(void) {}
+    static inline void latency_probe_input(uint32_t edge_us) { (void)edge_us; }
+    static inline void latency_probe_mark(coord_t x, coord_t y, coord_t size) { (void)x; (void)y; (void)size; }
+    static inline void latency_probe_flushed(bool drew, coord_t x1, coord_t y1, coord_t x2, coord_t y2) {
+        (void)drew; (void)x1; (void)y1; (void)x2; (void)y2;
+    }
+    static inline void latency_probe_report(void) {}
+#endif
+
+#endif /* INC_UTILS_LATENCY_PROBE_H_ */
@@ -17,8 +17,13 @@ void blink_led2();
 void blink_error_led();
 void add_delay(uint32_t);
 uint32_t get_current_ms(void);
+uint32_t get_current_us(void);   // From the SysTick counter, safe to call from ISRs
 
 void init_random(void);
 uint32_t get_random(void);
 
+// DWT cycle counter for profiling hot loops
+void cycle_counter_init(void);
+uint32_t get_cycle_count(void);
+
 #endif /* INC_UTILS_MISC_UTILS_H_ */
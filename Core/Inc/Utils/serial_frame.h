@@ -0,0 +1,84 @@
+/*
+ * serial_frame.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  Serial frame codec and message parser, plain C built by both the STM32 and the ESP32
+ *  (esp32/main/CMakeLists.txt) so the two ends of the link run the same code.
+ */
+
+#ifndef INC_UTILS_SERIAL_FRAME_H_
+#define INC_UTILS_SERIAL_FRAME_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Serial Frame - variable length, the same on both ends:
+ *
+ *   0x00 | COBS( type | length | sequence lo | sequence hi | payload | CRC, 4 bytes LE ) | 0x00
+ *
+ * COBS removes every zero from the frame, so a zero only ever marks a frame boundary and the
+ * receiver finds the next frame after any noise or cut. The leading zero closes whatever was
+ * left of a broken frame before it. The CRC covers the header and payload: CRC-32/MPEG-2
+ * (poly 0x04C11DB7, init 0xFFFFFFFF, not reflected, no final XOR), the variant the STM32F4
+ * CRC unit computes when fed the bytes big-endian a word at a time. */
+#define SERIAL_FRAME_DELIMITER          0x00
+#define SERIAL_FRAME_HEADER_SIZE        4
+#define SERIAL_FRAME_CRC_SIZE           4
+#define SERIAL_FRAME_MAX_PAYLOAD        250
+#define SERIAL_FRAME_MAX_RAW_SIZE       (SERIAL_FRAME_HEADER_SIZE + SERIAL_FRAME_MAX_PAYLOAD + SERIAL_FRAME_CRC_SIZE)
+#define SERIAL_FRAME_MAX_ENCODED_SIZE   (SERIAL_FRAME_MAX_RAW_SIZE + SERIAL_FRAME_MAX_RAW_SIZE / 254 + 1)
+#define SERIAL_FRAME_MAX_WIRE_SIZE      (SERIAL_FRAME_MAX_ENCODED_SIZE + 2)
+#define SERIAL_FRAME_ENCODED_SIZE(payload) \
+    ((SERIAL_FRAME_HEADER_SIZE + (payload) + SERIAL_FRAME_CRC_SIZE) \
+    + (SERIAL_FRAME_HEADER_SIZE + (payload) + SERIAL_FRAME_CRC_SIZE) / 254 + 1)
+
+typedef struct {
+    uint8_t type;
+    uint8_t length;
+    uint16_t sequence;
+    const uint8_t* payload;     // Inside the buffer the frame was decoded in
+} serial_frame_t;
+
+typedef enum {
+    SERIAL_FRAME_OK = 0,
+    SERIAL_FRAME_BAD_STUFFING,      // Not valid COBS, e.g. cut short
+    SERIAL_FRAME_BAD_LENGTH,        // Length field does not match the bytes received
+    SERIAL_FRAME_BAD_CRC
+} serial_frame_status_t;
+
+/* Message Parser State */
+typedef struct {
+    uint8_t* parse_buffer;
+    uint16_t parse_index;
+    uint16_t expected_size;         // Fixed size messages: the message size. Delimited frames: the buffer size
+    bool parsing_active;
+    bool frame_complete;            // Delimited frames: the delimiter arrived
+    bool discarding;                // Delimited frames: too long for the buffer, skipping to the next delimiter
+    uint32_t oversized_frames;
+} message_parser_t;
+
+// Message Parser APIs
+void message_parser_init(message_parser_t* parser, uint8_t* buffer, uint16_t buffer_size);
+void message_parser_reset(message_parser_t* parser);
+// Parse the next message into another buffer, NULL to stop taking bytes. Counters are kept.
+void message_parser_attach(message_parser_t* parser, uint8_t* buffer, uint16_t buffer_size);
+bool message_parser_add_byte(message_parser_t* parser, uint8_t data, uint8_t start_byte);
+uint16_t message_parser_add_span(message_parser_t* parser, const uint8_t* data, uint16_t length, uint8_t start_byte);
+uint16_t message_parser_add_delimited(message_parser_t* parser, const uint8_t* data, uint16_t length, uint8_t delimiter);
+bool message_parser_is_complete(const message_parser_t* parser);
+uint8_t* message_parser_get_buffer(const message_parser_t* parser);
+uint16_t message_parser_get_length(const message_parser_t* parser);
+
+// Serial Frame APIs
+uint16_t cobs_encode(const uint8_t* data, uint16_t length, uint8_t* encoded);
+uint16_t cobs_decode(const uint8_t* encoded, uint16_t length, uint8_t* data);   // 0 if invalid, may decode in place
+uint32_t crc32_mpeg2(const uint8_t* data, uint16_t length, uint32_t crc);      // Start with 0xFFFFFFFF
+// Compute frame CRCs with e.g. the CRC unit instead of software, NULL for software
+void serial_frame_register_crc(uint32_t (*crc)(const uint8_t* data, uint16_t length));
+uint16_t serial_frame_encode(uint8_t type, uint16_t sequence, const uint8_t* payload, uint8_t length,
+    uint8_t* wire);     // Whole frame with both delimiters, wire holds SERIAL_FRAME_MAX_WIRE_SIZE
+serial_frame_status_t serial_frame_decode(uint8_t* buffer, uint16_t length, serial_frame_t* frame);
+
+#endif /* INC_UTILS_SERIAL_FRAME_H_ */
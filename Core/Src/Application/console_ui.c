@@ -4,6 +4,8 @@
  *  Created on: Jun 2, 2025
  *      Author: rohitimandi
  *  Updated: Added support for hierarchical menu system and multiplayer games
+ *  Modified on: Oct 18, 2026
+ *      Added console_ui_update_screen() for the timed screens
  */
 
 #include "Application/console_ui.h"
@@ -119,10 +121,18 @@ MenuItem console_ui_get_selected_menu_item(void) {
     return game_controller_get_selected_menu_item();
 }
 
+bool console_ui_update_screen(void) {
+    return game_controller_update_screen();
+}
+
 void console_ui_run_game(void) {
     game_controller_update();
 }
 
+void console_ui_render_game(void) {
+    game_controller_render_game();
+}
+
 bool console_ui_is_game_active(void) {
     return game_controller_is_game_active();
 }
@@ -4,17 +4,24 @@
  *  Created on: Jan 5, 2025
  *      Author: rohitimandi
  *  Updated: Added support for hierarchical menu system and multiplayer games
+ *  Modified on: Oct 18, 2026
+ *      Games are looked up in the game registry
+ *      Each game gets its own input latency histogram
+ *      Frames are paced by the scheduler, rendering runs as its own task
+ *      The status bar refresh runs on a UI timer wheel
+ *      Boot, welcome and error screens are timed UI screens instead of delays
+ *      Controller status outlives the block it is read in
+ *      Games are saved to flash and resumed, the last one straight from boot
  */
 
 #include "Application/game_controller.h"
 #include "Console_Peripherals/Hardware/display_manager.h"
 #include "Console_Peripherals/Hardware/d_pad.h"
 #include "Communication/serial_comm.h"
-#include "Game_Engine/Games/Single_Player/snake_game.h"
-#include "Game_Engine/Games/pacman_game.h"
- // Include multiplayer game headers when available
-#include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_main.h"
+#include "Game_Engine/game_registry.h"
+#include "Console_Peripherals/UI/ui_screen.h"
 #include "Utils/debug_conf.h"
+#include "Utils/latency_probe.h"
 
 #ifdef UNITY_TEST
 #define add_delay(x)
@@ -39,10 +46,7 @@ extern uint8_t pb2_get_state(void); // Use to go back to the previous menu
 #include "Console_Peripherals/Hardware/display_manager.h"
 #include "Console_Peripherals/Hardware/d_pad.h"
 #include "Communication/serial_comm.h"
-#include "Game_Engine/Games/Single_Player/snake_game.h"
-#include "Game_Engine/Games/pacman_game.h"
- // Include multiplayer game headers when available
-#include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_main.h"
+#include "Game_Engine/game_registry.h"
 #include "Utils/debug_conf.h"
 
 #ifdef UNITY_TEST
@@ -60,15 +64,18 @@ extern uint8_t pb2_get_state(void); // Use to go back to the previous menu
 #define ERROR_DISPLAY_TIMEOUT_MS 5000 // in ms
 
 /* Private state variables */
-static AppState current_app_state = APP_STATE_WELCOME;
+static AppState current_app_state = APP_STATE_BOOT;
 static MenuState main_menu;
 static ScreenType current_game_screen = SCREEN_MENU;
 static ScreenType current_error_screen = SCREEN_ERROR;
-static uint32_t last_frame_time = 0;
+static bool frame_ready = false;           /* Updated but not yet rendered */
 static uint32_t error_start_time = 0;
-static uint32_t last_status_update_time = 0;
+static TimerWheel ui_timers;               /* Not paused with the game, unlike game_timers */
+static uint32_t boot_time_ms = 0;
 static uint32_t last_menu_refresh_time = 0;
 static uint32_t last_error_render_time = 0;
+static bool save_due = false;              /* Set by the save timer, taken on the next game frame */
+static bool was_paused = false;
 
 /* Private function declarations */
 static void handle_welcome_input(JoystickStatus js_status);
@@ -86,26 +93,62 @@ static uint8_t convert_dpad_to_menu_nav(void);
 static void game_controller_show_error_screen(ScreenType error_screen);
 static void game_controller_render_error_screen(void);
 
-void game_controller_init(MenuItem* menu_items, uint8_t menu_count) {
-    /* Initialize display manager */
-    display_manager_init();
+static void status_bar_timer_expired(void* context);
+static void save_timer_expired(void* context);
+static void save_game_if_due(GameEngine* engine);
+static void save_game_now(GameEngine* engine);
+static bool resume_last_game(void);
+
+/* Timed screens */
+static bool boot_screen_update(uint32_t elapsed_ms);
+static void boot_screen_done(void);
+static void welcome_screen_enter(void);
+
+static const UiScreen boot_ui_screen = {
+    .name = "boot",
+    .enter = display_manager_init_start,
+    .update = boot_screen_update,
+    .done = boot_screen_done,
+    .duration_ms = UI_SCREEN_FOREVER
+};
+
+static const UiScreen welcome_ui_screen = {
+    .name = "welcome",
+    .enter = welcome_screen_enter,
+    .done = game_controller_show_menu,
+    .duration_ms = WELCOME_SCREEN_TIME
+};
+
+static const UiScreen error_ui_screen = {
+    .name = "error",
+    .enter = game_controller_render_error_screen,
+    .done = game_controller_return_to_menu,
+    .duration_ms = ERROR_DISPLAY_TIMEOUT_MS
+};
 
+void game_controller_init(MenuItem* menu_items, uint8_t menu_count) {
     /* Initialize menu system with main menu */
     MenuItem* main_menu_items;
     uint8_t main_menu_count;
     menu_system_get_main_menu(&main_menu_items, &main_menu_count);
     menu_system_init(&main_menu, main_menu_items, main_menu_count);
 
-    /* Start with welcome screen */
-    current_app_state = APP_STATE_WELCOME;
-
     /* Initialize timing */
-    last_frame_time = 0;
-    last_status_update_time = 0;
+    frame_ready = false;
     last_menu_refresh_time = 0;
+    boot_time_ms = 0;
+    timer_wheel_init(&ui_timers, get_current_ms());
+    timer_start(&ui_timers, STATUS_BAR_UPDATE_INTERVAL, STATUS_BAR_UPDATE_INTERVAL,
+        status_bar_timer_expired, NULL);
+    timer_start(&ui_timers, GAME_SAVE_INTERVAL_MS, GAME_SAVE_INTERVAL_MS, save_timer_expired, NULL);
+
+    /* Find the saved games, before the boot screen decides where to go */
+    game_save_init();
 
-    /* Show welcome screen */
-    game_controller_show_welcome_screen();
+    /* Bring the display up, the welcome screen follows - the main loop runs meanwhile */
+    ui_screen_init(serial_comm_get_drop_count);
+    current_app_state = APP_STATE_BOOT;
+    ui_screen_show(&boot_ui_screen, get_current_ms());
 }
 
 void game_controller_init_with_default_menu(void) {
@@ -116,15 +159,65 @@ void game_controller_init_with_default_menu(void) {
     game_controller_init(main_menu_items, main_menu_count);
 }
 
-void game_controller_update(void) {
-    uint32_t current_time = get_current_ms();
+static void status_bar_timer_expired(void* context) {
+    (void)context;
+    game_controller_update_status_bar();
+}
 
-    /* Update status bar periodically */
-    if (current_time - last_status_update_time > STATUS_BAR_UPDATE_INTERVAL) {
-        game_controller_update_status_bar();
-        last_status_update_time = current_time;
+static void save_timer_expired(void* context) {
+    (void)context;
+    save_due = true;
+}
+
+static bool boot_screen_update(uint32_t elapsed_ms) {
+    (void)elapsed_ms;
+    return display_manager_init_poll();
+}
+
+static void boot_screen_done(void) {
+    display_manager_clear_screen();
+
+    /* Straight back into the game that was running when the console went off */
+    if (!resume_last_game()) {
+        game_controller_show_welcome_screen();
+    }
+}
+
+static bool resume_last_game(void) {
+    uint16_t key;
+
+    if (!game_save_latest(&key)) {
+        return false;
     }
 
+    const GameDescriptor* game = game_registry_find((ScreenType)key);
+    if (game == NULL || game->save == NULL) {
+        return false;
+    }
+
+    boot_time_ms = get_current_ms();
+    DEBUG_PRINTF(false, "Boot: resuming %s after %lu ms\r\n", game->name, (unsigned long)boot_time_ms);
+    game_controller_start_game(game->screen);
+    return true;
+}
+
+static void welcome_screen_enter(void) {
+    display_manager_show_welcome_message("Welcome to", "Game Console!");
+}
+
+bool game_controller_update_screen(void) {
+    ui_screen_update(get_current_ms());
+    return current_app_state != APP_STATE_BOOT;
+}
+
+uint32_t game_controller_get_boot_time_ms(void) {
+    return boot_time_ms;
+}
+
+void game_controller_update(void) {
+    /* Update status bar periodically */
+    timer_wheel_advance(&ui_timers, get_current_ms());
+
     /* Run game loop if in game state */
     if (current_app_state == APP_STATE_GAME_ACTIVE) {
         game_controller_run_game_loop();
@@ -133,6 +226,10 @@ void game_controller_update(void) {
 
 void game_controller_handle_input(JoystickStatus js_status) {
     switch (current_app_state) {
+    case APP_STATE_BOOT:
+        /* Nothing to draw on yet */
+        break;
+
     case APP_STATE_WELCOME:
         handle_welcome_input(js_status);
         break;
@@ -257,10 +354,7 @@ static void handle_error_input() {
         game_controller_return_to_menu();
     }
 
-    // To Do: Fix the error timer later
-//	/* Or, return to main menu after timer expires */
-//	handle_error_timeout();
-//	DEBUG_PRINTF(false, "Handled error. Exiting...");
+    /* Otherwise the error screen returns to the main menu when it times out */
 
 }
 
@@ -332,30 +426,35 @@ void game_controller_handle_game_input(JoystickStatus js_status) {
 }
 
 void game_controller_run_game_loop(void) {
-    uint32_t current_time = get_current_ms();
-
-    if (current_time - last_frame_time >= FRAME_RATE) {
-        GameEngine* current_engine = game_controller_get_current_game_engine();
+    /* Called once per frame by the scheduler's game tick */
+    GameEngine* current_engine = game_controller_get_current_game_engine();
 
-        if (current_engine) {
-            /* Handle button-triggered actions (reset, return to menu) */
-            if (!handle_game_button_actions(current_engine)) {
-                last_frame_time = current_time;
-                return;
-            }
+    if (current_engine) {
+        /* Handle button-triggered actions (reset, return to menu) */
+        if (!handle_game_button_actions(current_engine)) {
+            return;
+        }
 
-            /* Regular game processing */
-            process_game_loop(current_engine);
+        /* Regular game processing */
+        process_game_loop(current_engine);
+        save_game_if_due(current_engine);
+        frame_ready = true;
+    }
+}
 
-            /* Handle game over condition */
-            if (!handle_game_over(current_engine)) {
-                last_frame_time = current_time;
-                return;
-            }
-        }
+void game_controller_render_game(void) {
+    GameEngine* current_engine = game_controller_get_current_game_engine();
 
-        last_frame_time = current_time;
+    if (!frame_ready || current_app_state != APP_STATE_GAME_ACTIVE || !current_engine) {
+        return;
     }
+    frame_ready = false;
+
+    /* Render the game */
+    game_engine_render(current_engine);
+
+    /* Handle game over condition once the countdown has been drawn */
+    handle_game_over(current_engine);
 }
 
 static bool handle_game_button_actions(GameEngine* engine) {
@@ -364,11 +463,12 @@ static bool handle_game_button_actions(GameEngine* engine) {
         game_engine_cleanup(engine);
         game_engine_init(engine);
         engine->base_state.is_reset = false;
+        save_due = true;    /* The old session is not the one to come back to */
     }
 
     /* Check for return to main menu request */
     if (engine->return_to_main_menu) {
-        add_delay(100);
+        save_game_now(engine);
         game_engine_cleanup(engine);
         engine->return_to_main_menu = false;
         game_controller_return_to_menu();
@@ -379,28 +479,63 @@ static bool handle_game_button_actions(GameEngine* engine) {
 }
 
 static void process_game_loop(GameEngine* engine) {
+    /* Both live until the update below, it reads through controller_data */
+    DPAD_STATUS dpad_status;
+    JoystickStatus js_status;
     void* controller_data;
 
     if (engine->is_d_pad_game) {
-        DPAD_STATUS dpad_status = d_pad_get_status();
+        dpad_status = d_pad_get_status();
         controller_data = &dpad_status;
     }
     else {
-        JoystickStatus js_status = joystick_get_status();
+        js_status = joystick_get_status();
         controller_data = &js_status;
     }
 
     /* Update game state with the appropriate controller data */
     game_engine_update(engine, controller_data);
+}
 
-    /* Render the game */
-    game_engine_render(engine);
+/* Snapshots are staged between frames, the save task writes them out while the game runs.
+ * Pausing is often the last thing before the power switch, so it saves too. */
+static void save_game_if_due(GameEngine* engine) {
+    bool paused = engine->base_state.paused;
+
+    if (paused && !was_paused) {
+        save_due = true;
+    }
+    was_paused = paused;
+
+    if (save_due && !engine->base_state.game_over) {
+        const GameDescriptor* game = game_registry_find(current_game_screen);
+        if (game == NULL || game->save == NULL
+            || game_save_capture(game->screen, engine, game->save) > 0) {
+            save_due = false;
+        }
+    }
+}
+
+/* Leaving a game keeps it for the next launch, unless it is already over */
+static void save_game_now(GameEngine* engine) {
+    const GameDescriptor* game = game_registry_find(current_game_screen);
+
+    if (game == NULL || game->save == NULL) {
+        return;
+    }
+    if (engine->base_state.game_over) {
+        game_save_discard(game->screen);
+    }
+    else {
+        game_save_capture(game->screen, engine, game->save);
+    }
 }
 
 /* Auto-returns to main menu and is in sync with the countdown */
 static bool handle_game_over(GameEngine* engine) {
     if (engine->base_state.game_over && engine->countdown_over) {
-        /* Clean up after displaying the score */
+        /* Clean up after displaying the score, a finished game is not resumed */
+        game_save_discard(current_game_screen);
         game_engine_cleanup(engine);
         current_app_state = APP_STATE_GAME_OVER;
         return false;
@@ -417,8 +552,8 @@ static void game_controller_show_error_screen(ScreenType error_screen) {
     error_start_time = get_current_ms();
     last_error_render_time = 0;
 
-    //    /* Render the error screen immediately */
-    game_controller_render_error_screen();
+    /* Rendered on enter, returns to the menu after ERROR_DISPLAY_TIMEOUT_MS */
+    ui_screen_show(&error_ui_screen, error_start_time);
 }
 
 static void game_controller_render_error_screen(void) {
@@ -492,11 +627,21 @@ void game_controller_set_state(AppState new_state) {
 }
 
 void game_controller_show_welcome_screen(void) {
-    display_manager_show_welcome_message("Welcome to", "Game Console!");
     current_app_state = APP_STATE_WELCOME;
+    ui_screen_show(&welcome_ui_screen, get_current_ms());
 }
 
 void game_controller_show_menu(void) {
+    uint32_t now = get_current_ms();
+
+    /* Whatever timed screen was up is replaced by the menu */
+    ui_screen_leave(now);
+    if (boot_time_ms == 0) {
+        boot_time_ms = now;
+        DEBUG_PRINTF(false, "Boot: interactive after %lu ms, %lu comm drops during screens\r\n",
+            (unsigned long)boot_time_ms, (unsigned long)ui_screen_get_stats()->dropped);
+    }
+
     /* Reset to main menu */
     MenuItem* main_menu_items;
     uint8_t main_menu_count;
@@ -510,16 +655,27 @@ void game_controller_show_menu(void) {
 void game_controller_start_game(ScreenType game_screen) {
     current_game_screen = game_screen;
 
-    /* Initialize the appropriate game engine */
-    GameEngine* engine = game_controller_get_current_game_engine();
+    /* Look the game up in the registry, building its assets on first launch */
+    GameEngine* engine = game_registry_prepare(game_screen);
 
     if (engine) {
+        const GameDescriptor* game = game_registry_find(game_screen);
+        latency_probe_begin(game->name);
+
     	if (engine->is_mp_game) {
     		// Notify ESP32 to connect to WebSocket server
     		protocol_send_status(SYSTEM_STATUS_STM32_GAME_READY, 0, "Multiplayer Game Starting");
     	}
 
-        game_engine_init(engine);
+        /* Games with a save-state continue where they were left */
+        save_due = false;
+        was_paused = false;
+        if (game->save != NULL) {
+            game_save_resume(game_screen, engine, game->save);
+        }
+        else {
+            game_engine_init(engine);
+        }
     }
 
     // Update the current app state
@@ -537,30 +693,8 @@ bool game_controller_is_game_active(void) {
 }
 
 GameEngine* game_controller_get_current_game_engine(void) {
-    switch (current_game_screen) {
-    case SCREEN_GAME_SNAKE:
-        return &snake_game_engine;
-    case SCREEN_GAME_PACMAN:
-        return &pacman_game_engine;
-    case SCREEN_MP_GAME_SNAKE:
-        return &mp_snake_game_engine;  // From mp_snake_game_main.h
-        /* Add other multiplayer games as they become available */
-    case SCREEN_MP_GAME_PACMAN:
-        /* return &multiplayer_pacman_game_engine; // When implemented */
-        return NULL;  // For now, return NULL until implemented
-    case SCREEN_MP_GAME_3:
-    case SCREEN_MP_GAME_4:
-    case SCREEN_MP_GAME_5:
-        /* return respective multiplayer engines when implemented */
-        return NULL;
-    case SCREEN_GAME_3:
-    case SCREEN_GAME_4:
-    case SCREEN_GAME_5:
-        /* return respective single player engines when implemented */
-        return NULL;
-    default:
-        return NULL;
-    }
+    const GameDescriptor* game = game_registry_find(current_game_screen);
+    return (game != NULL) ? game->engine : NULL;
 }
 
 void game_controller_update_status_bar(void) {
@@ -3,6 +3,11 @@
  *
  *  Created on: Jul 16, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Added the transmit service and statistics
+ *      Added the game state callback
+ *      Game data can carry the caller's sequence number
+ *      Added the body sync callback
  */
 
 #include "Communication/serial_comm.h"
@@ -83,6 +88,11 @@ UART_Status serial_comm_send_game_data(const char* data_type, const char* game_d
     return protocol_send_game_data(data_type, game_data, metadata);
 }
 
+UART_Status serial_comm_send_game_data_with_sequence(const char* data_type, const char* game_data,
+    const char* metadata, uint32_t sequence) {
+    return protocol_send_game_data_with_sequence(data_type, game_data, metadata, sequence);
+}
+
 UART_Status serial_comm_send_chat_message(const char* message, const char* sender, const char* chat_type) {
     return protocol_send_chat_message(message, sender, chat_type);
 }
@@ -147,6 +157,14 @@ void serial_comm_register_game_data_callback(game_data_received_callback_t callb
     callbacks_register_game_data(callback);
 }
 
+void serial_comm_register_game_state_callback(game_state_received_callback_t callback) {
+    callbacks_register_game_state(callback);
+}
+
+void serial_comm_register_body_sync_callback(body_sync_received_callback_t callback) {
+    callbacks_register_body_sync(callback);
+}
+
 void serial_comm_register_chat_message_callback(chat_message_received_callback_t callback) {
     callbacks_register_chat_message(callback);
 }
@@ -168,6 +186,22 @@ void serial_comm_print_stats(void) {
     protocol_print_stats();
 }
 
+uint32_t serial_comm_get_drop_count(void) {
+    return hardware_serial_get_drop_count();
+}
+
+void serial_comm_service_tx(void) {
+    hardware_serial_service_tx();
+}
+
+void serial_comm_register_tx_done_callback(void (*callback)(void)) {
+    hardware_serial_register_tx_done_callback(callback);
+}
+
+const comm_stats_t* serial_comm_get_stats(void) {
+    return hardware_serial_get_comm_stats();
+}
+
 void serial_comm_send_debug(const char* message, uint32_t timeout) {
     protocol_send_debug(message, timeout);
 }
@@ -3,6 +3,9 @@
  *
  *  Created on: Jul 16, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Added the game state callback
+ *      Added the body sync callback
  */
 
 #include "Communication/serial_comm_callbacks.h"
@@ -11,6 +14,8 @@
 
 /* Registered callback functions */
 static game_data_received_callback_t game_data_callback = NULL;
+static game_state_received_callback_t game_state_callback = NULL;
+static body_sync_received_callback_t body_sync_callback = NULL;
 static chat_message_received_callback_t chat_message_callback = NULL;
 static command_received_callback_t command_callback = NULL;
 static status_received_callback_t status_callback = NULL;
@@ -20,6 +25,8 @@ static connection_message_callback_t connection_message_callback = NULL;
 void callbacks_init(void) {
     /* Initialize all callbacks to NULL */
     game_data_callback = NULL;
+    game_state_callback = NULL;
+    body_sync_callback = NULL;
     chat_message_callback = NULL;
     command_callback = NULL;
     status_callback = NULL;
@@ -31,6 +38,8 @@ void callbacks_init(void) {
 void callbacks_deinit(void) {
     /* Clear all callbacks */
     game_data_callback = NULL;
+    game_state_callback = NULL;
+    body_sync_callback = NULL;
     chat_message_callback = NULL;
     command_callback = NULL;
     status_callback = NULL;
@@ -45,6 +54,16 @@ void callbacks_register_game_data(game_data_received_callback_t callback) {
     DEBUG_PRINTF(false, "CALLBACKS: Game data callback registered\r\n");
 }
 
+void callbacks_register_game_state(game_state_received_callback_t callback) {
+    game_state_callback = callback;
+    DEBUG_PRINTF(false, "CALLBACKS: Game state callback registered\r\n");
+}
+
+void callbacks_register_body_sync(body_sync_received_callback_t callback) {
+    body_sync_callback = callback;
+    DEBUG_PRINTF(false, "CALLBACKS: Body sync callback registered\r\n");
+}
+
 void callbacks_register_chat_message(chat_message_received_callback_t callback) {
     chat_message_callback = callback;
     DEBUG_PRINTF(false, "CALLBACKS: Chat message callback registered\r\n");
@@ -74,6 +93,22 @@ void callbacks_handle_game_data(const uart_game_data_t* game_data) {
     }
 }
 
+void callbacks_handle_game_state(const uart_game_state_t* game_state) {
+    if (game_state_callback) {
+        game_state_callback(game_state);
+    } else {
+        DEBUG_PRINTF(false, "CALLBACKS: No game state callback registered\r\n");
+    }
+}
+
+void callbacks_handle_body_sync(const uart_body_sync_t* body_sync) {
+    if (body_sync_callback) {
+        body_sync_callback(body_sync);
+    } else {
+        DEBUG_PRINTF(false, "CALLBACKS: No body sync callback registered\r\n");
+    }
+}
+
 void callbacks_handle_chat_message(const uart_chat_message_t* chat_message) {
     if (chat_message_callback) {
         chat_message_callback(chat_message);
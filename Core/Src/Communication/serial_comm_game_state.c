@@ -0,0 +1,104 @@
+/*
+ * serial_comm_game_state.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Reads the input acknowledgement of version 2
+ *      Decodes the body sync message
+ */
+
+#include "Communication/serial_comm_game_state.h"
+#include "Utils/debug_conf.h"
+#include <string.h>
+
+static uint16_t read_u16_le(const uint8_t* bytes) {
+    return (uint16_t)(bytes[0] | (bytes[1] << 8));
+}
+
+static uint32_t read_u32_le(const uint8_t* bytes) {
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) |
+        ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+bool game_state_decode(const uint8_t* data, uint8_t length, uart_game_state_t* state) {
+    if (!data || !state || length < GAME_STATE_HEADER_SIZE) {
+        DEBUG_PRINTF(false, "GAME STATE: Truncated game state: %d bytes\r\n", length);
+        return false;
+    }
+
+    if (data[0] != GAME_STATE_VERSION) {
+        DEBUG_PRINTF(false, "GAME STATE: Unsupported version %d\r\n", data[0]);
+        return false;
+    }
+
+    uint8_t player_count = data[1];
+    if (player_count > GAME_STATE_MAX_PLAYERS || length != GAME_STATE_SIZE(player_count)) {
+        DEBUG_PRINTF(false, "GAME STATE: %d players in %d bytes\r\n", player_count, length);
+        return false;
+    }
+
+    memset(state, 0, sizeof(*state));
+    state->tick = read_u32_le(&data[2]);
+    state->food_x = data[6];
+    state->food_y = data[7];
+    state->player_count = player_count;
+
+    const uint8_t* record = &data[GAME_STATE_HEADER_SIZE];
+    for (uint8_t i = 0; i < player_count; i++) {
+        uart_game_state_player_t* player = &state->players[i];
+
+        player->head_x = record[0];
+        player->head_y = record[1];
+        player->length = record[2];
+        player->direction = record[3];
+        player->alive = (record[4] & GAME_STATE_FLAG_ALIVE) != 0;
+        player->score = read_u16_le(&record[5]);
+        player->input_ack = read_u16_le(&record[7]);
+        record += GAME_STATE_PLAYER_SIZE;
+    }
+
+    return true;
+}
+
+bool body_sync_decode(const uint8_t* data, uint8_t length, uart_body_sync_t* body_sync) {
+    if (!data || !body_sync || length < BODY_SYNC_DELTA_SIZE) {
+        DEBUG_PRINTF(false, "BODY SYNC: Truncated body sync: %d bytes\r\n", length);
+        return false;
+    }
+
+    uint8_t kind = data[0];
+    if (kind == BODY_SYNC_KIND_KEYFRAME) {
+        uint8_t segments = data[8];
+        if (segments > BODY_SYNC_MAX_SEGMENTS || length != BODY_SYNC_KEYFRAME_SIZE(segments)) {
+            DEBUG_PRINTF(false, "BODY SYNC: Keyframe of %d segments in %d bytes\r\n", segments, length);
+            return false;
+        }
+
+        memset(body_sync, 0, sizeof(*body_sync));
+        body_sync->head_x = data[6];
+        body_sync->head_y = data[7];
+        body_sync->length = segments;
+        memcpy(body_sync->codes, &data[BODY_SYNC_KEYFRAME_HEADER_SIZE], BODY_SYNC_CODE_BYTES(segments));
+    }
+    else if (kind == BODY_SYNC_KIND_DELTA) {
+        if (length != BODY_SYNC_DELTA_SIZE || data[6] > BODY_SYNC_MAX_MOVES || data[8] > BODY_SYNC_MAX_SEGMENTS) {
+            DEBUG_PRINTF(false, "BODY SYNC: Delta of %d moves in %d bytes\r\n", data[6], length);
+            return false;
+        }
+
+        memset(body_sync, 0, sizeof(*body_sync));
+        body_sync->move_count = data[6];
+        body_sync->codes[0] = data[7];
+        body_sync->length = data[8];
+    }
+    else {
+        DEBUG_PRINTF(false, "BODY SYNC: Unknown kind %d\r\n", kind);
+        return false;
+    }
+
+    body_sync->kind = kind;
+    body_sync->player_id = data[1];
+    body_sync->tick = read_u32_le(&data[2]);
+    return true;
+}
@@ -3,10 +3,18 @@
  *
  *  Created on: Jul 16, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Sends through the prioritised transmit queue instead of blocking
+ *      Leaves framing and the CRC to the hardware layer
+ *      Handles received messages in the slot they were decoded in
+ *      Decodes the binary game state message
+ *      Game data can carry the caller's sequence number
+ *      Decodes the body sync message
  */
 
 #include "Communication/serial_comm_protocol.h"
 #include "Communication/serial_comm_callbacks.h"
+#include "Communication/serial_comm_game_state.h"
 #include "Utils/debug_conf.h"
 
  /* Protocol state */
@@ -22,6 +30,7 @@ static volatile bool ui_needs_status_update = false;
 
 /* Game related data */
 static char stored_client_id[7] = { 0 };
+static uint32_t game_data_sequence = 0;
 static bool is_game_over = false;
 
 typedef struct {
@@ -41,11 +50,13 @@ static uint32_t last_error_display_time = 0;
 static const uint32_t ERROR_DISPLAY_COOLDOWN_MS = 5000;
 
 /* Private function prototypes */
-static void protocol_message_handler(const uart_message_t* msg);
+static void protocol_message_handler(const uart_message_view_t* msg);
 static void handle_esp32_status(const uart_status_t* status);
-static void handle_connection_message(uart_connection_message_t* msg);
+static void handle_connection_message(const uart_connection_message_t* msg);
 static void handle_esp32_command(const uart_command_t* command);
 static void handle_game_data(const uart_game_data_t* game_data);
+static void handle_game_state(const uart_message_view_t* msg);
+static void handle_body_sync(const uart_message_view_t* msg);
 static void handle_chat_message(const uart_chat_message_t* chat_message);
 static bool is_tile_size_valid(const char* message, uint8_t array_length);
 static bool parse_and_store_player_data(const char* data_string, bool is_local_player);
@@ -146,8 +157,37 @@ static void handle_game_data(const uart_game_data_t* game_data) {
     protocol_send_ack();
 }
 
+/* Handle game state messages - read straight out of the payload, no text to scan */
+static void handle_game_state(const uart_message_view_t* msg) {
+    uart_game_state_t game_state;
+
+    if (!game_state_decode(msg->data, msg->length, &game_state)) {
+        DEBUG_PRINTF(false, "PROTO: Invalid game state, %d bytes\r\n", msg->length);
+        return;
+    }
+
+    DEBUG_PRINTF(false, "PROTO: GAME STATE: Tick=%lu, Players=%d\r\n",
+        game_state.tick, game_state.player_count);
+
+    callbacks_handle_game_state(&game_state);
+    protocol_send_ack();
+}
+
+/* Handle body sync messages - one comes every tick and a lost one is made good by the next
+ * keyframe, so they are not acknowledged */
+static void handle_body_sync(const uart_message_view_t* msg) {
+    uart_body_sync_t body_sync;
+
+    if (!body_sync_decode(msg->data, msg->length, &body_sync)) {
+        DEBUG_PRINTF(false, "PROTO: Invalid body sync, %d bytes\r\n", msg->length);
+        return;
+    }
+
+    callbacks_handle_body_sync(&body_sync);
+}
+
 /* Handle connection messages */
-static void handle_connection_message(uart_connection_message_t* msg) {
+static void handle_connection_message(const uart_connection_message_t* msg) {
     DEBUG_PRINTF(false, "PROTO: Connection Message: ID=%.6s, Message=%.63s\r\n",
         msg->client_id, msg->message);
 
@@ -351,39 +391,47 @@ static void handle_esp32_command(const uart_command_t* command) {
     callbacks_handle_command(command);
 }
 
-/* Protocol message handler - processes decoded messages */
-static void protocol_message_handler(const uart_message_t* msg) {
+/* Protocol message handler - processes decoded messages, the payload is read in place */
+static void protocol_message_handler(const uart_message_view_t* msg) {
     DEBUG_PRINTF(false, "PROTO: Processing message type: 0x%02X, length: %d\r\n",
         msg->msg_type, msg->length);
 
     switch (msg->msg_type) {
     case MSG_TYPE_DATA:
         if (msg->length == sizeof(uart_game_data_t)) {
-            handle_game_data((uart_game_data_t*)msg->data);
+            handle_game_data((const uart_game_data_t*)msg->data);
         }
         break;
 
+    case MSG_TYPE_GAME_STATE:
+        handle_game_state(msg);
+        break;
+
+    case MSG_TYPE_BODY_SYNC:
+        handle_body_sync(msg);
+        break;
+
     case MSG_TYPE_CHAT:
         if (msg->length == sizeof(uart_chat_message_t)) {
-            handle_chat_message((uart_chat_message_t*)msg->data);
+            handle_chat_message((const uart_chat_message_t*)msg->data);
         }
         break;
 
     case MSG_TYPE_COMMAND:
         if (msg->length == sizeof(uart_command_t)) {
-            handle_esp32_command((uart_command_t*)msg->data);
+            handle_esp32_command((const uart_command_t*)msg->data);
         }
         break;
 
     case MSG_TYPE_STATUS:
         if (msg->length == sizeof(uart_status_t)) {
-            handle_esp32_status((uart_status_t*)msg->data);
+            handle_esp32_status((const uart_status_t*)msg->data);
         }
         break;
 
     case MSG_TYPE_CONNECTION:
         if (msg->length == sizeof(uart_connection_message_t)) {
-            handle_connection_message((uart_connection_message_t*)msg->data);
+            handle_connection_message((const uart_connection_message_t*)msg->data);
         }
         break;
 
@@ -466,6 +514,9 @@ void protocol_process(void) {
         hardware_serial_process_incoming();
         last_activity_time = get_current_ms();
     }
+
+    /* Replies queued above, or a frame that could not start earlier */
+    hardware_serial_service_tx();
 }
 
 void protocol_reset(void) {
@@ -622,16 +673,26 @@ UART_Status protocol_send_message(MessageType type, const uint8_t* data, uint8_t
         memcpy(msg.data, data, length);
     }
 
-    msg.checksum = hardware_serial_calculate_checksum(&msg);
+    /* Sequence number and CRC are added when the frame is encoded for the wire */
     msg.end_byte = MSG_END_BYTE;
 
-    DEBUG_PRINTF(false, "PROTO: Sending message: type=0x%02X, length=%d, checksum=0x%02X\r\n",
-        type, length, msg.checksum);
+    DEBUG_PRINTF(false, "PROTO: Sending message: type=0x%02X, length=%d\r\n", type, length);
 
-    return hardware_serial_send_message(&msg);
+    /* Game data carries player input: it jumps the queue, and when the link falls behind
+     * the newest input replaces the oldest. Everything else waits its turn. */
+    if (type == MSG_TYPE_DATA) {
+        return hardware_serial_queue_message(&msg, TX_PRIORITY_HIGH, TX_FULL_DROP_OLDEST);
+    }
+    return hardware_serial_queue_message(&msg, TX_PRIORITY_NORMAL, TX_FULL_DROP_NEWEST);
 }
 
 UART_Status protocol_send_game_data(const char* data_type, const char* game_data, const char* metadata) {
+    /* Bytes sent only counts once a frame is out, queued frames need their own number */
+    return protocol_send_game_data_with_sequence(data_type, game_data, metadata, ++game_data_sequence);
+}
+
+UART_Status protocol_send_game_data_with_sequence(const char* data_type, const char* game_data, const char* metadata,
+    uint32_t sequence) {
     uart_game_data_t payload;
     memset(&payload, 0, sizeof(payload));
 
@@ -641,9 +702,7 @@ UART_Status protocol_send_game_data(const char* data_type, const char* game_data
         strncpy(payload.metadata, metadata, sizeof(payload.metadata) - 1);
     }
 
-    uint32_t bytes_sent = 0;
-    hardware_serial_get_stats(&bytes_sent, NULL, NULL, NULL);
-    payload.sequence_num = bytes_sent;
+    payload.sequence_num = sequence;
 
     DEBUG_PRINTF(false, "PROTO: Sending game data: type='%s', data='%s', meta='%s'\r\n",
         data_type, game_data, metadata ? metadata : "");
@@ -747,6 +806,8 @@ void protocol_print_stats(void) {
     DEBUG_PRINTF(false, "Parse errors: %lu\r\n", parse_errors);
     DEBUG_PRINTF(false, "Bytes received: %lu\r\n", bytes_received);
     DEBUG_PRINTF(false, "Bytes sent: %lu\r\n", bytes_sent);
+    DEBUG_PRINTF(false, "Dropped: %lu\r\n", hardware_serial_get_drop_count());
+    comm_stats_print(hardware_serial_get_comm_stats());
     DEBUG_PRINTF(false, "Current state: %d\r\n", current_state);
     DEBUG_PRINTF(false, "ESP32 ready: %s\r\n", is_esp32_ready ? "Yes" : "No");
     DEBUG_PRINTF(false, "WiFi connected: %s\r\n", is_wifi_connected ? "Yes" : "No");
@@ -3,26 +3,32 @@
  *
  *  Created on: Dec 22, 2024
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Filtered on DMA half and full transfer, TIM6 no longer restarts the ADC
  */
 
 #include <Console_Peripherals/Hardware/Driver_Callbacks/joystick_callbacks.h>
 #include <Console_Peripherals/Hardware/Drivers/joystick_driver.h>
 #include <Console_Peripherals/Hardware/joystick.h>
 
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* hadc)
+{
+    if(hadc->Instance == ADC1) {
+        joystick_driver_adc_half_callback(hadc);
+        update_joystick_status();  // Call logic update after new filtered values
+    }
+}
+
 void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc)
 {
     if(hadc->Instance == ADC1) {
         joystick_driver_adc_callback(hadc);
-        update_joystick_status();  // Call logic update after new ADC values
+        update_joystick_status();
     }
 }
 
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
 {
-    if (htim->Instance == TIM6) {
-        joystick_driver_tim_callback(htim);
-    }
-
 //    if (htim->Instance == TIM4) {
 //    	blink_led1();
 //    }
@@ -0,0 +1,30 @@
+/*
+ * crc_driver.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Console_Peripherals/Hardware/Drivers/crc_driver.h"
+#include "Utils/comm_utils.h"
+#include "stm32f4xx_hal.h"
+#include <string.h>
+
+void crc_driver_init(void) {
+    __HAL_RCC_CRC_CLK_ENABLE();
+}
+
+uint32_t crc_driver_compute(const uint8_t* data, uint16_t length) {
+    uint16_t words = length / 4;
+    uint32_t word;
+
+    CRC->CR = CRC_CR_RESET;
+    for (uint16_t i = 0; i < words; i++) {
+        // Frame bytes have no alignment, and the unit wants the first byte in the top bits
+        memcpy(&word, &data[i * 4], sizeof(word));
+        CRC->DR = __REV(word);
+    }
+
+    // Only whole words go in, the last 1 to 3 bytes are finished in software
+    return crc32_mpeg2(&data[words * 4], length % 4, CRC->DR);
+}
@@ -3,6 +3,9 @@
  *
  *  Created on: Jan 11, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Added display_get_dirty_region()
+ *      Added the non-blocking display_init_start() / display_init_poll()
  */
 
 #include <Console_Peripherals/Hardware/Drivers/display_driver.h>
@@ -49,6 +52,54 @@ static void update_dirty_region(coord_t x1, coord_t y1, coord_t x2, coord_t y2)
 }
 #endif
 
+#ifdef DISPLAY_MODULE_LCD
+// Hardware vertical scrolling state (LCD only)
+static coord_t scroll_top = 0;      // First screen row of the scrolling area
+static coord_t scroll_height = 0;   // Rows in the scrolling area, 0 when scrolling is off
+static coord_t scroll_offset = 0;   // Rows the content has been scrolled up by
+
+// Map a screen row to the panel memory row currently shown there
+static uint16_t map_scroll_y(uint16_t y) {
+    if (scroll_height == 0 || y < scroll_top || y >= scroll_top + scroll_height) {
+        return y;
+    }
+    return scroll_top + (y - scroll_top + scroll_offset) % scroll_height;
+}
+
+// Fill a rectangle given in screen rows, splitting it where panel memory wraps inside the scrolling area
+static void lcd_fill_rectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    uint16_t area_end = scroll_top + scroll_height;
+
+    if (scroll_height == 0 || y + h <= scroll_top || y >= area_end) {
+        ILI9341_FillRectangle(x, y, w, h, color);
+        return;
+    }
+
+    // Part above the scrolling area
+    if (y < scroll_top) {
+        ILI9341_FillRectangle(x, y, w, scroll_top - y, color);
+        h -= scroll_top - y;
+        y = scroll_top;
+    }
+
+    // Part below the scrolling area
+    if (y + h > area_end) {
+        ILI9341_FillRectangle(x, area_end, w, y + h - area_end, color);
+        h = area_end - y;
+    }
+
+    // Part inside the scrolling area
+    uint16_t mapped_y = map_scroll_y(y);
+    uint16_t rows_before_wrap = area_end - mapped_y;
+    if (h <= rows_before_wrap) {
+        ILI9341_FillRectangle(x, mapped_y, w, h, color);
+    } else {
+        ILI9341_FillRectangle(x, mapped_y, w, rows_before_wrap, color);
+        ILI9341_FillRectangle(x, scroll_top, w, h - rows_before_wrap, color);
+    }
+}
+#endif
+
 #ifdef DISPLAY_MODULE_OLED
 // Translate DisplayColor to SSD1306_COLOR
 static SSD1306_COLOR translate_color(DisplayColor color) {
@@ -70,6 +121,28 @@ void display_init(void) {
 #endif
 }
 
+void display_init_start(void) {
+#ifdef DISPLAY_MODULE_OLED
+    // The OLED init is short, it completes here
+    ssd1306_Init();
+#elif DISPLAY_MODULE_LCD
+    ILI9341_InitStart();
+#endif
+}
+
+bool display_init_poll(void) {
+#ifdef DISPLAY_MODULE_LCD
+    if (ILI9341_GetInitState() == ILI9341_INIT_DONE) {
+        return true;
+    }
+    if (!ILI9341_InitStep()) {
+        return false;
+    }
+    reset_dirty_region();
+#endif
+    return true;
+}
+
 void display_clear(void) {
 #ifdef DISPLAY_MODULE_OLED
     ssd1306_Fill(Black);
@@ -91,6 +164,23 @@ void display_update(void) {
 #endif
 }
 
+bool display_get_dirty_region(coord_t* x1, coord_t* y1, coord_t* x2, coord_t* y2) {
+#ifdef DISPLAY_MODULE_LCD
+    *x1 = dirty_min_x;
+    *y1 = dirty_min_y;
+    *x2 = dirty_max_x;
+    *y2 = dirty_max_y;
+    return dirty_flag;
+#else
+    // The OLED frame buffer is sent whole, assume all of it changed
+    *x1 = 0;
+    *y1 = 0;
+    *x2 = DISPLAY_WIDTH - 1;
+    *y2 = DISPLAY_HEIGHT - 1;
+    return true;
+#endif
+}
+
 void display_fill_white(void) {
 #ifdef DISPLAY_MODULE_OLED
     ssd1306_Fill(White);
@@ -132,7 +222,7 @@ void display_write_string(char* str, FontDef font, DisplayColor color) {
                         lcd_cursor_x + str_width - 1,
                         lcd_cursor_y + font.height - 1);
 
-    ILI9341_WriteString(lcd_cursor_x, lcd_cursor_y, str, font, ili_color, bg_color);
+    ILI9341_WriteString(lcd_cursor_x, map_scroll_y(lcd_cursor_y), str, font, ili_color, bg_color);
 
     // Update cursor position after writing
     lcd_cursor_x += str_width;
@@ -161,7 +251,7 @@ void display_write_string_centered(char* str, FontDef font, coord_t y, DisplayCo
     // Update dirty region
     update_dirty_region(x, y, x + str_width - 1, y + font.height - 1);
 
-    ILI9341_WriteString(x, y, str, font, ili_color, bg_color);
+    ILI9341_WriteString(x, map_scroll_y(y), str, font, ili_color, bg_color);
 #endif
 }
 
@@ -177,7 +267,7 @@ void display_draw_horizontal_line(coord_t x, coord_t y, coord_t length, DisplayC
     update_dirty_region(x, y, x + length - 1, y);
 
     // Draw a 1-pixel high rectangle as a horizontal line
-    ILI9341_FillRectangle(x, y, length, 1, ili_color);
+    lcd_fill_rectangle(x, y, length, 1, ili_color);
 #endif
 }
 
@@ -194,12 +284,12 @@ void display_draw_rectangle(coord_t x1, coord_t y1, coord_t x2, coord_t y2, Disp
     update_dirty_region(x1, y1, x2, y2);
 
     // Draw horizontal lines
-    ILI9341_FillRectangle(x1, y1, width, 1, ili_color);
-    ILI9341_FillRectangle(x1, y2, width, 1, ili_color);
+    lcd_fill_rectangle(x1, y1, width, 1, ili_color);
+    lcd_fill_rectangle(x1, y2, width, 1, ili_color);
 
     // Draw vertical lines
-    ILI9341_FillRectangle(x1, y1, 1, height, ili_color);
-    ILI9341_FillRectangle(x2, y1, 1, height, ili_color);
+    lcd_fill_rectangle(x1, y1, 1, height, ili_color);
+    lcd_fill_rectangle(x2, y1, 1, height, ili_color);
 #endif
 }
 
@@ -214,7 +304,7 @@ void display_fill_rectangle(coord_t x1, coord_t y1, coord_t x2, coord_t y2, Disp
     // Update dirty region
     update_dirty_region(x1, y1, x2, y2);
 
-    ILI9341_FillRectangle(x1, y1, width, height, ili_color);
+    lcd_fill_rectangle(x1, y1, width, height, ili_color);
 #endif
 }
 
@@ -247,7 +337,7 @@ void display_draw_pixel(coord_t x, coord_t y, DisplayColor color) {
     // Update dirty region for single pixel
     update_dirty_region(x, y, x, y);
 
-    ILI9341_DrawPixel(x, y, ili_color);
+    ILI9341_DrawPixel(x, map_scroll_y(y), ili_color);
 #endif
 }
 
@@ -271,10 +361,10 @@ void display_draw_bitmap(coord_t x, coord_t y, const uint8_t* bitmap,
             uint8_t bit = byte & (1 << (7 - (j % 8)));
 
             if (bit) {
-                ILI9341_DrawPixel(x + j, y + i, fg_color);
+                ILI9341_DrawPixel(x + j, map_scroll_y(y + i), fg_color);
             } else {
                 // Optional: uncomment if you want to draw background pixels
-                // ILI9341_DrawPixel(x + j, y + i, bg_color);
+                // ILI9341_DrawPixel(x + j, map_scroll_y(y + i), bg_color);
             }
         }
     }
@@ -291,7 +381,7 @@ void display_clear_region(coord_t x, coord_t y, coord_t width, coord_t height) {
     // Update dirty region
     update_dirty_region(x, y, x + width - 1, y + height - 1);
 
-    ILI9341_FillRectangle(x, y, width, height, ILI9341_BLACK);
+    lcd_fill_rectangle(x, y, width, height, ILI9341_BLACK);
 #endif
 }
 
@@ -309,3 +399,48 @@ void display_get_dirty_bounds(coord_t* min_x, coord_t* min_y, coord_t* max_x, co
     if (max_y) *max_y = dirty_max_y;
 }
 #endif
+
+// Set up hardware vertical scrolling for screen rows [top, top + height)
+void display_set_scroll_area(coord_t top, coord_t height) {
+#ifdef DISPLAY_MODULE_LCD
+    scroll_top = top;
+    scroll_height = height;
+    scroll_offset = 0;
+    ILI9341_SetVerticalScrollArea(top, height);
+    ILI9341_SetVerticalScrollStart(top);
+#endif
+}
+
+// Scroll the content of the scrolling area up by offset rows (modulo the area height)
+void display_set_scroll_offset(coord_t offset) {
+#ifdef DISPLAY_MODULE_LCD
+    if (scroll_height == 0) {
+        return;
+    }
+    scroll_offset = offset % scroll_height;
+    ILI9341_SetVerticalScrollStart(scroll_top + scroll_offset);
+#endif
+}
+
+// Return to an unscrolled display
+void display_reset_scroll(void) {
+#ifdef DISPLAY_MODULE_LCD
+    if (scroll_height == 0) {
+        return;
+    }
+    scroll_top = 0;
+    scroll_height = 0;
+    scroll_offset = 0;
+    ILI9341_SetVerticalScrollArea(0, ILI9341_SCROLL_LINES);
+    ILI9341_SetVerticalScrollStart(0);
+#endif
+}
+
+// Whether display_set_scroll_offset() scrolls along screen rows
+bool display_has_hw_scroll(void) {
+#ifdef DISPLAY_MODULE_LCD
+    return ILI9341_SCROLL_ALONG_Y;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,74 @@
+/*
+ * flash_driver.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Console_Peripherals/Hardware/Drivers/flash_driver.h"
+#include "stm32f4xx_hal.h"
+#include "Utils/debug_conf.h"
+
+// From the linker script
+extern uint8_t _save_start[];
+extern uint8_t _etext[];
+
+// First sector at _save_start - the SAVE region starts at 0x08140000
+#define SAVE_FIRST_SECTOR  FLASH_SECTOR_14
+
+static uint32_t image_id = 0;
+
+bool flash_driver_erase_save_sector(uint8_t sector) {
+    if (sector >= FLASH_SAVE_SECTOR_COUNT) {
+        return false;
+    }
+
+    FLASH_EraseInitTypeDef erase = {
+        .TypeErase = FLASH_TYPEERASE_SECTORS,
+        .Sector = SAVE_FIRST_SECTOR + sector,
+        .NbSectors = 1,
+        .VoltageRange = FLASH_VOLTAGE_RANGE_3
+    };
+    uint32_t sector_error = 0;
+
+    HAL_FLASH_Unlock();
+    HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&erase, &sector_error);
+    HAL_FLASH_Lock();
+
+    if (status != HAL_OK) {
+        DEBUG_PRINTF(false, "Flash: Erase of save sector %u failed, error 0x%lx\r\n",
+            (unsigned)sector, (unsigned long)HAL_FLASH_GetError());
+        return false;
+    }
+    return true;
+}
+
+bool flash_driver_program_word(uint8_t sector, uint32_t offset, uint32_t value) {
+    if (sector >= FLASH_SAVE_SECTOR_COUNT || offset > FLASH_SAVE_SECTOR_SIZE - 4 || (offset & 3) != 0) {
+        return false;
+    }
+
+    uint32_t address = (uint32_t)flash_driver_save_sector(sector) + offset;
+
+    HAL_FLASH_Unlock();
+    HAL_StatusTypeDef status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, value);
+    HAL_FLASH_Lock();
+
+    return status == HAL_OK;
+}
+
+const uint8_t* flash_driver_save_sector(uint8_t sector) {
+    return _save_start + (uint32_t)sector * FLASH_SAVE_SECTOR_SIZE;
+}
+
+uint32_t flash_driver_image_id(void) {
+    // FNV-1a over the code, a few ms once per boot
+    if (image_id == 0) {
+        uint32_t hash = 2166136261UL;
+        for (const uint32_t* word = (const uint32_t*)FLASH_BASE; word < (const uint32_t*)_etext; word++) {
+            hash = (hash ^ *word) * 16777619UL;
+        }
+        image_id = (hash != 0) ? hash : 1;
+    }
+    return image_id;
+}
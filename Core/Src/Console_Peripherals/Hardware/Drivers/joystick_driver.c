@@ -3,21 +3,33 @@
  *
  *  Created on: Dec 22, 2024
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      TIM3-triggered conversions into a circular DMA buffer, filtered per half transfer
  */
 
 #include <Console_Peripherals/Hardware/Drivers/joystick_driver.h>
 #include <Console_Peripherals/Hardware/joystick.h>
 
-// Private variables for hardware interaction
-static volatile uint16_t adc_buf[2];
-static volatile uint8_t conversion_complete = 0;
+// Rank 1 (Y) and rank 2 (X) interleaved, JOYSTICK_SAMPLES_PER_HALF sequences per half.
+// DMA fills one half while the other is filtered.
+static volatile uint16_t adc_buf[JOYSTICK_DMA_BUFFER_LENGTH];
+
+// Latest filtered pair, X in the low half. One word so readers never see a torn pair.
+static volatile uint32_t filtered_xy = ((uint32_t)JOYSTICK_ADC_CENTER << 16) | JOYSTICK_ADC_CENTER;
 
 #ifndef UNITY_TEST
 
 #include "stm32f4xx_hal.h"
 
+static void filter_half(const volatile uint16_t* half) {
+    uint16_t y = joystick_filter_samples(&half[0], JOYSTICK_SAMPLES_PER_HALF, 2);
+    uint16_t x = joystick_filter_samples(&half[1], JOYSTICK_SAMPLES_PER_HALF, 2);
+    filtered_xy = ((uint32_t)y << 16) | x;
+}
+
 void joystick_driver_start_conversion(void) {
-    if(HAL_ADC_Start_DMA(&hadc1, (uint32_t*)adc_buf, 2) != HAL_OK) {
+    // Started once, conversions then follow TIM3 TRGO with no CPU involvement
+    if(HAL_ADC_Start_DMA(&hadc1, (uint32_t*)adc_buf, JOYSTICK_DMA_BUFFER_LENGTH) != HAL_OK) {
     	Error_Handler();
     }
 }
@@ -27,28 +39,27 @@ uint8_t joystick_driver_read_button(void) {
 }
 
 void joystick_driver_get_adc_values(uint16_t* x, uint16_t* y) {
-    *x = adc_buf[1];
-    *y = adc_buf[0];
+    uint32_t xy = filtered_xy;
+    *x = (uint16_t)(xy & 0xFFFF);
+    *y = (uint16_t)(xy >> 16);
 }
 
-void joystick_driver_tim_callback(TIM_HandleTypeDef *htim) {
-    if (htim->Instance == TIM6 && conversion_complete) {
-        conversion_complete = 0;
-        joystick_driver_start_conversion();
+void joystick_driver_adc_half_callback(ADC_HandleTypeDef* hadc) {
+    if(hadc->Instance == ADC1) {
+        filter_half(&adc_buf[0]);
     }
 }
 
 void joystick_driver_adc_callback(ADC_HandleTypeDef* hadc) {
     if(hadc->Instance == ADC1) {
-        conversion_complete = 1;
-        HAL_ADC_Stop_DMA(&hadc1);
+        filter_half(&adc_buf[JOYSTICK_DMA_BUFFER_LENGTH / 2]);
     }
 }
 
 void joystick_driver_init(void) {
 	joystick_driver_start_conversion();
 
-    if(HAL_TIM_Base_Start_IT(&htim6) != HAL_OK) {
+    if(HAL_TIM_Base_Start(&htim3) != HAL_OK) {
             Error_Handler();
     }
 
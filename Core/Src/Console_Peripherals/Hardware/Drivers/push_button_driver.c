@@ -3,6 +3,8 @@
  *
  *  Created on: Dec 28, 2024
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Added PB_Driver_ReadInputs() for the bitmask scan
  */
 
 #include <Console_Peripherals/Hardware/Drivers/push_button_driver.h>
@@ -31,6 +33,19 @@ uint8_t read_dpad_pin_down(void) {
     return (HAL_GPIO_ReadPin(D_PAD_GPIO_Port_1, D_PAD_Pin_Down) == GPIO_PIN_SET) ? 1 : 0;
 }
 
+uint16_t PB_Driver_ReadInputs(void) {
+    uint32_t port_e = D_PAD_GPIO_Port_1->IDR;
+    uint32_t port_f = PB_GPIO_Port->IDR;
+    uint32_t port_g = D_PAD_GPIO_Port_2->IDR;
+
+    return (uint16_t)(((port_f & PB_1_Pin) ? BUTTON_PB1 : 0) |
+                      ((port_f & PB_2_Pin) ? BUTTON_PB2 : 0) |
+                      ((port_e & D_PAD_Pin_Up) ? BUTTON_DPAD_UP : 0) |
+                      ((port_e & D_PAD_Pin_Right) ? BUTTON_DPAD_RIGHT : 0) |
+                      ((port_e & D_PAD_Pin_Down) ? BUTTON_DPAD_DOWN : 0) |
+                      ((port_g & D_PAD_Pin_Left) ? BUTTON_DPAD_LEFT : 0));
+}
+
 uint32_t PB_Driver_GetTick(void) {
     return HAL_GetTick();
 }
@@ -3,6 +3,10 @@
  *
  *  Created on: Apr 25, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      USART2 receives by circular DMA with IDLE-line events instead of an
+ *      interrupt per byte
+ *      USART2 sends by DMA and reports completion from the interrupt
  */
 
 #include <Console_Peripherals/Hardware/Drivers/uart_driver.h>
@@ -17,6 +21,9 @@ static void (*uart2_rx_callback)(uint8_t) = NULL;
 static void (*uart3_rx_callback)(uint8_t) = NULL;
 static uint8_t uart2_rx_buffer[1];
 static uint8_t uart3_rx_buffer[1];
+static dma_rx_ring_t* uart2_rx_ring = NULL;    // Set while USART2 receives by DMA
+static void (*uart2_tx_callback)(bool) = NULL;
+static volatile bool uart2_tx_active = false;   // A DMA transmission is in flight
 
 /* Helper function to get HAL UART handle based on port */
 static UART_HandleTypeDef* UART_GetHandle(UART_Port port) {
@@ -202,7 +209,10 @@ UART_Status UART_DisableRxInterrupt(UART_Port port) {
         return UART_ERROR;
     }
 
-    /* Abort any ongoing receive operations */
+    /* Abort any ongoing receive operations, DMA included */
+    if (port == UART_PORT_2) {
+        uart2_rx_ring = NULL;
+    }
     if (HAL_UART_AbortReceive_IT(huart) != HAL_OK) {
         return UART_ERROR;
     }
@@ -225,6 +235,69 @@ UART_Status UART_RegisterRxCallback(UART_Port port, void (*callback)(uint8_t)) {
     return UART_OK;
 }
 
+/* Start circular DMA reception into the ring */
+UART_Status UART_StartRxDma(UART_Port port, dma_rx_ring_t* ring) {
+    UART_HandleTypeDef* huart = UART_GetHandle(port);
+
+    if (port != UART_PORT_2 || huart == NULL || ring == NULL || huart->hdmarx == NULL) {
+        return UART_ERROR;
+    }
+
+    uart2_rx_ring = ring;
+    if (HAL_UARTEx_ReceiveToIdle_DMA(huart, ring->buffer, ring->size) != HAL_OK) {
+        uart2_rx_ring = NULL;
+        return UART_ERROR;
+    }
+
+    return UART_OK;
+}
+
+/* Start a DMA transmission, the TX complete callback follows */
+UART_Status UART_SendBufferDma(UART_Port port, const uint8_t* pData, uint16_t size) {
+    UART_HandleTypeDef* huart = UART_GetHandle(port);
+
+    if (port != UART_PORT_2 || huart == NULL || pData == NULL || size == 0 || huart->hdmatx == NULL) {
+        return UART_ERROR;
+    }
+
+    uart2_tx_active = true;
+    HAL_StatusTypeDef status = HAL_UART_Transmit_DMA(huart, (uint8_t*)pData, size);
+    if (status != HAL_OK) {
+        uart2_tx_active = false;
+        return (status == HAL_BUSY) ? UART_BUSY : UART_ERROR;
+    }
+
+    return UART_OK;
+}
+
+/* Register callback function for the end of a DMA transmission */
+UART_Status UART_RegisterTxCompleteCallback(UART_Port port, void (*callback)(bool)) {
+    if (port != UART_PORT_2) {
+        return UART_ERROR;
+    }
+
+    uart2_tx_callback = callback;
+    return UART_OK;
+}
+
+/* HAL UART Tx Complete callback - the last byte of a DMA transmission has gone out */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart) {
+    if (huart->Instance == USART2 && uart2_tx_active) {
+        uart2_tx_active = false;
+        if (uart2_tx_callback != NULL) {
+            uart2_tx_callback(true);
+        }
+    }
+}
+
+/* HAL UART Rx Event callback - IDLE line, half and full transfer of the DMA reception.
+ * Size is the DMA write position in the buffer. */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef* huart, uint16_t Size) {
+    if (huart->Instance == USART2 && uart2_rx_ring != NULL) {
+        dma_rx_ring_advance(uart2_rx_ring, Size);
+    }
+}
+
 /* HAL UART Rx Complete callback - implement in this file to automatically restart reception */
 void HAL_UART_RxCpltCallback(UART_HandleTypeDef* huart) {
     /* Check which UART triggered the callback */
@@ -266,8 +339,23 @@ void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
     __HAL_UART_CLEAR_FEFLAG(huart);
 
     if (huart->Instance == USART2) {
-        // Restart reception
-        HAL_UART_Receive_IT(huart, uart2_rx_buffer, 1);
+        // A DMA error stops the transmission too
+        if (uart2_tx_active && huart->gState == HAL_UART_STATE_READY) {
+            uart2_tx_active = false;
+            if (uart2_tx_callback != NULL) {
+                uart2_tx_callback(false);
+            }
+        }
+
+        if (uart2_rx_ring != NULL) {
+            // The HAL aborted the DMA, it starts again at the top of the buffer
+            dma_rx_ring_restart(uart2_rx_ring);
+            HAL_UARTEx_ReceiveToIdle_DMA(huart, uart2_rx_ring->buffer, uart2_rx_ring->size);
+        }
+        else {
+            // Restart reception
+            HAL_UART_Receive_IT(huart, uart2_rx_buffer, 1);
+        }
     }
 
     if(huart->Instance == USART3) {
@@ -3,17 +3,26 @@
  *
  *  Created on: Mar 7, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Every change is queued as a timestamped input event, reads no longer mask interrupts
+ *      Updated from the debounced button scan instead of EXTI
  */
 
 #ifndef SRC_PERIPHERALS_D_PAD_C_
 #define SRC_PERIPHERALS_D_PAD_C_
 
 #include <Console_Peripherals/Hardware/d_pad.h>
+#include <Console_Peripherals/Hardware/input_events.h>
 #include "Utils/debug_conf.h"
 
 static uint8_t last_direction = 0;
-static uint8_t d_pad_changed = 0;
-static volatile DPAD_STATUS d_pad_status = { 0, 0 };
+
+// Written by pb_scan() in SysTick only. Readers compare the change count with the last one
+// they saw instead of clearing a flag, so neither side has to mask interrupts.
+static volatile uint8_t d_pad_direction = 0;
+static volatile uint8_t d_pad_change_count = 0;
+static uint8_t status_seen_count = 0;    // Last change returned by d_pad_get_status()
+static uint8_t changed_seen_count = 0;   // Last change returned by d_pad_direction_changed()
 
 void update_d_pad_status(void) {
     // Read the D-pad states from push button interface
@@ -40,35 +49,33 @@ void update_d_pad_status(void) {
 
 
     if (current_dir != last_direction) {
-            last_direction = current_dir;
-            __disable_irq();
-            d_pad_status.direction = current_dir;
-            d_pad_status.is_new = 1;
-            d_pad_changed = 1;
-//            DEBUG_PRINTF(true, "*** SETTING is_new=1 for direction %d ***\n", current_dir);
-            __enable_irq();
+        last_direction = current_dir;
+        d_pad_direction = current_dir;
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        d_pad_change_count++;
+
+        // Keep every change, a game tick may see several
+        input_events_post(INPUT_SOURCE_DPAD, current_dir);
     }
 }
 
 
 DPAD_STATUS d_pad_get_status(void) {
     DPAD_STATUS status;
-    __disable_irq();
-    status = d_pad_status;
-//    if (d_pad_status.is_new) {
-//        DEBUG_PRINTF(true, "*** CLEARING is_new flag, was 1 for direction %d ***\n",
-//                   d_pad_status.direction);
-//    }
-    d_pad_status.is_new = 0;
-    __enable_irq();
+
+    // Count first - a change landing in between is reported again, never lost
+    uint8_t count = d_pad_change_count;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    status.direction = d_pad_direction;
+    status.is_new = (count != status_seen_count);
+    status_seen_count = count;
     return status;
 }
 
 uint8_t d_pad_direction_changed(void) {
-    __disable_irq();
-    uint8_t changed = d_pad_changed;
-    d_pad_changed = 0;  // Clear the flag
-    __enable_irq();
+    uint8_t count = d_pad_change_count;
+    uint8_t changed = (count != changed_seen_count);
+    changed_seen_count = count;
     return changed;
 }
 
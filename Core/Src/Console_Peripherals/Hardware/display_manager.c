@@ -3,10 +3,14 @@
  *
  *  Created on: Jun 2, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Flushes close the pending input latency samples they drew over
+ *      Screens no longer hold the loop in delays, see ui_screen.h
  */
 
 #include "Console_Peripherals/Hardware/display_manager.h"
 #include "Sprites/status_bar_sprite.h"
+#include "Utils/latency_probe.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -48,6 +52,14 @@ void display_manager_init(void) {
 	display_clear();
 }
 
+void display_manager_init_start(void) {
+	display_init_start();
+}
+
+bool display_manager_init_poll(void) {
+	return display_init_poll();
+}
+
 void display_manager_clear_screen(void) {
 	display_clear();
 }
@@ -60,7 +72,11 @@ void display_manager_clear_main_area(void) {
 }
 
 void display_manager_update(void) {
+	coord_t x1, y1, x2, y2;
+	bool drew = display_get_dirty_region(&x1, &y1, &x2, &y2);
+
 	display_update();
+	latency_probe_flushed(drew, x1, y1, x2, y2);
 }
 
 void display_manager_show_welcome_message(char* line1, char* line2) {
@@ -73,7 +89,6 @@ void display_manager_show_welcome_message(char* line1, char* line2) {
 			DISPLAY_WELCOME_LINE2_Y, DISPLAY_WHITE);
 
 	display_update();
-	add_delay(3000);  /* Show welcome screen for 3 seconds */
 }
 
 void display_manager_show_game_title(char* title) {
@@ -105,7 +120,6 @@ void display_manager_show_status_message(char* message) {
 	display_clear();
 	display_write_string_centered((char*) message, DISPLAY_STATUS_FONT, 25, DISPLAY_WHITE);
 	display_update();
-	add_delay(100);
 }
 
 void display_manager_show_centered_message(char* message, uint8_t y_position) {
@@ -117,7 +131,6 @@ void display_manager_show_error_message(char* error) {
 	display_write_string_centered("ERROR", DISPLAY_ERROR_FONT, 20, DISPLAY_WHITE);
 	display_write_string_centered(error, DISPLAY_ERROR_FONT, 50, DISPLAY_WHITE);
 	display_update();
-	add_delay(2000);
 }
 
 /* WiFi error with countdown timer */
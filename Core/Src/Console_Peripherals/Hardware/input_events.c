@@ -0,0 +1,66 @@
+/*
+ * input_events.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include <Console_Peripherals/Hardware/input_events.h>
+#include "Utils/misc_utils.h"
+#include <string.h>
+
+InputQueue input_events;
+
+// head and tail are free-running, the slot is the low bits
+#define INPUT_QUEUE_MASK (INPUT_QUEUE_SIZE - 1)
+
+bool input_queue_push(InputQueue* queue, uint8_t source, uint8_t state, uint32_t timestamp_us) {
+    uint8_t head = queue->head;
+
+    if ((uint8_t)(head - queue->tail) >= INPUT_QUEUE_SIZE) {
+        queue->dropped++;
+        return false;
+    }
+
+    InputEvent* event = &queue->events[head & INPUT_QUEUE_MASK];
+    event->timestamp_us = timestamp_us;
+    event->source = source;
+    event->state = state;
+
+    // The event must be complete before the consumer can see it
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    queue->head = head + 1;
+    return true;
+}
+
+void input_events_post(uint8_t source, uint8_t state) {
+    input_queue_push(&input_events, source, state, get_current_us());
+}
+
+bool input_queue_pop(InputQueue* queue, InputEvent* event) {
+    uint8_t tail = queue->tail;
+
+    if (tail == queue->head) {
+        return false;
+    }
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    *event = queue->events[tail & INPUT_QUEUE_MASK];
+
+    // Copy out before handing the slot back to the producer
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    queue->tail = tail + 1;
+    return true;
+}
+
+uint8_t input_queue_count(const InputQueue* queue) {
+    return (uint8_t)(queue->head - queue->tail);
+}
+
+void input_queue_flush(InputQueue* queue) {
+    queue->tail = queue->head;
+}
+
+void input_queue_reset(InputQueue* queue) {
+    memset(queue, 0, sizeof(InputQueue));
+}
@@ -3,6 +3,9 @@
  *
  *  Created on: Dec 6, 2024
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Direction and button changes are queued as input events
+ *      Samples are filtered and calibrated, status reads no longer mask interrupts
  */
 
  // joystick.c
@@ -11,9 +14,71 @@
 
 #include <Console_Peripherals/Hardware/Drivers/joystick_driver.h>
 #include <Console_Peripherals/Hardware/joystick.h>
+#include <Console_Peripherals/Hardware/input_events.h>
 
 static uint8_t last_direction = JS_DIR_CENTERED;
-static volatile JoystickStatus joystick_status = { JS_DIR_CENTERED, 0, 0 };
+static JoystickCalibration calibration = { JOYSTICK_ADC_CENTER, JOYSTICK_ADC_CENTER, false };
+
+// Written from the ADC DMA callbacks only, read like the D-pad status through a change count
+static volatile uint8_t joystick_direction = JS_DIR_CENTERED;
+static volatile uint8_t joystick_button = 0;
+static volatile uint8_t joystick_change_count = 0;
+static uint8_t status_seen_count = 0;
+
+uint16_t joystick_filter_samples(const volatile uint16_t* samples, uint8_t count, uint8_t stride) {
+    uint32_t sum = 0;
+    uint16_t lowest = JOYSTICK_ADC_MAX;
+    uint16_t highest = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint16_t sample = samples[i * stride];
+        sum += sample;
+        if (sample < lowest) lowest = sample;
+        if (sample > highest) highest = sample;
+    }
+
+    if (count <= 2) {
+        return (count == 0) ? JOYSTICK_ADC_CENTER : (uint16_t)(sum / count);
+    }
+
+    // Dropping the extremes removes single-sample spikes
+    return (uint16_t)((sum - lowest - highest) / (count - 2));
+}
+
+uint16_t joystick_apply_calibration(uint16_t value, uint16_t center, uint16_t dead_zone) {
+    int32_t offset = (int32_t)value - (int32_t)center;
+
+    if (offset <= (int32_t)dead_zone && offset >= -(int32_t)dead_zone) {
+        return JOYSTICK_ADC_CENTER;
+    }
+
+    int32_t corrected = JOYSTICK_ADC_CENTER + offset;
+    if (corrected < 0) corrected = 0;
+    if (corrected > JOYSTICK_ADC_MAX) corrected = JOYSTICK_ADC_MAX;
+    return (uint16_t)corrected;
+}
+
+bool joystick_calibrate(uint16_t x, uint16_t y) {
+    int32_t dx = (int32_t)x - JOYSTICK_ADC_CENTER;
+    int32_t dy = (int32_t)y - JOYSTICK_ADC_CENTER;
+
+    calibration.calibrated = true;
+    if (dx > JOYSTICK_CALIBRATION_MAX_OFFSET || dx < -JOYSTICK_CALIBRATION_MAX_OFFSET ||
+        dy > JOYSTICK_CALIBRATION_MAX_OFFSET || dy < -JOYSTICK_CALIBRATION_MAX_OFFSET) {
+        // Keep the ideal center rather than a deflected stick
+        calibration.center_x = JOYSTICK_ADC_CENTER;
+        calibration.center_y = JOYSTICK_ADC_CENTER;
+        return false;
+    }
+
+    calibration.center_x = x;
+    calibration.center_y = y;
+    return true;
+}
+
+const JoystickCalibration* joystick_get_calibration(void) {
+    return &calibration;
+}
 
 uint8_t calculate_direction(uint16_t x, uint16_t y) {
     // Clamp out-of-range values
@@ -57,29 +122,47 @@ void update_joystick_status(void) {
     uint16_t x, y;
     joystick_driver_get_adc_values(&x, &y);
 
+    if (!calibration.calibrated) {
+        joystick_calibrate(x, y);
+    }
+    x = joystick_apply_calibration(x, calibration.center_x, JOYSTICK_DEAD_ZONE);
+    y = joystick_apply_calibration(y, calibration.center_y, JOYSTICK_DEAD_ZONE);
+
     uint8_t current_dir = calculate_direction(x, y);
     uint8_t current_button = joystick_driver_read_button();
 
-    if (current_dir != last_direction || current_button != joystick_status.button) {
+    if (current_dir != last_direction || current_button != joystick_button) {
+        if (current_dir != last_direction) {
+            input_events_post(INPUT_SOURCE_JOYSTICK, current_dir);
+        }
+        if (current_button != joystick_button) {
+            input_events_post(INPUT_SOURCE_JOYSTICK_BUTTON, current_button);
+        }
+
         last_direction = current_dir;
-        __disable_irq();
-        joystick_status.direction = current_dir;
-        joystick_status.button = current_button;
-        joystick_status.is_new = 1;
-        __enable_irq();
+        joystick_direction = current_dir;
+        joystick_button = current_button;
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        joystick_change_count++;
     }
 }
 
 JoystickStatus joystick_get_status(void) {
     JoystickStatus status;
-    __disable_irq();
-    status = joystick_status;
-    joystick_status.is_new = 0;
-    __enable_irq();
+
+    // Count first - a change landing in between is reported again, never lost
+    uint8_t count = joystick_change_count;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    status.direction = joystick_direction;
+    status.button = joystick_button;
+    status.is_new = (count != status_seen_count);
+    status_seen_count = count;
     return status;
 }
 
 void joystick_init(void) {
+    calibration.calibrated = false;
+    status_seen_count = joystick_change_count;
     joystick_driver_init();
 }
 
@@ -3,108 +3,114 @@
  *
  *  Created on: Dec 28, 2024
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Replaced the per-button debounce with vertical counters over the whole input mask
  */
 
 #include <Console_Peripherals/Hardware/push_button.h>
+#include <Console_Peripherals/Hardware/d_pad.h>
+#include <string.h>
 
- // Debounce configuration
-#define DEBOUNCE_DELAY_MS    10
+static Debouncer inputs;
 
-// Button instances
-static Button_TypeDef button1 = { 0 };
-static Button_TypeDef button2 = { 0 };
-static Button_TypeDef d_pad_left = { 0 };
-static Button_TypeDef d_pad_right = { 0 };
-static Button_TypeDef d_pad_up = { 0 };
-static Button_TypeDef d_pad_down = { 0 };
+// Set by pb_scan() in SysTick, cleared by the game loop through the take functions
+static volatile uint16_t pressed_events = 0;
+static volatile uint16_t released_events = 0;
+static volatile uint16_t held_events = 0;
+
+void debouncer_reset(Debouncer* debouncer) {
+    memset(debouncer, 0, sizeof(Debouncer));
+    debouncer->count0 = 0xFFFF;
+    debouncer->count1 = 0xFFFF;
+}
+
+void debouncer_update(Debouncer* debouncer, uint16_t sample) {
+    // Bits that differ from the debounced state count down, the rest are reloaded
+    uint16_t changed = debouncer->state ^ sample;
+    debouncer->count0 = ~(debouncer->count0 & changed);
+    debouncer->count1 = debouncer->count0 ^ (debouncer->count1 & changed);
+
+    // Toggle the bits whose counter rolled over
+    changed &= debouncer->count0 & debouncer->count1;
+    debouncer->state ^= changed;
+    debouncer->pressed = debouncer->state & changed;
+    debouncer->released = ~debouncer->state & changed;
+
+    // Ripple-carry add 1 to the hold counter of every pressed, not yet reported bit.
+    // Released bits are cleared on the way.
+    uint16_t carry = debouncer->state & ~debouncer->hold_reported;
+    for (uint8_t plane = 0; plane < BUTTON_HOLD_BITS; plane++) {
+        uint16_t bits = debouncer->hold[plane];
+        debouncer->hold[plane] = (bits ^ carry) & debouncer->state;
+        carry &= bits;
+    }
+    debouncer->held = carry;
+    debouncer->hold_reported = (debouncer->hold_reported | carry) & debouncer->state;
+}
 
 void pb_init(void) {
-    button1.current_state = 0;
-    button1.last_reading = 0;
-    button1.last_debounce_time = 0;
-    button1.pressed = 0;
-
-    button2.current_state = 0;
-    button2.last_reading = 0;
-    button2.last_debounce_time = 0;
-    button2.pressed = 0;
-
-    d_pad_left.current_state = 0;
-    d_pad_left.last_reading = 0;
-    d_pad_left.last_debounce_time = 0;
-    d_pad_left.pressed = 0;
-
-    d_pad_right.current_state = 0;
-    d_pad_right.last_reading = 0;
-    d_pad_right.last_debounce_time = 0;
-    d_pad_right.pressed = 0;
-
-    d_pad_up.current_state = 0;
-    d_pad_up.last_reading = 0;
-    d_pad_up.last_debounce_time = 0;
-    d_pad_up.pressed = 0;
-
-    d_pad_down.current_state = 0;
-    d_pad_down.last_reading = 0;
-    d_pad_down.last_debounce_time = 0;
-    d_pad_down.pressed = 0;
+    debouncer_reset(&inputs);
+    pressed_events = 0;
+    released_events = 0;
+    held_events = 0;
 }
 
-void process_button(Button_TypeDef* button, uint8_t current_reading, uint32_t current_time) {
-    button->pressed = 0;  // Reset pressed flag
+void pb_scan(void) {
+    debouncer_update(&inputs, PB_Driver_ReadInputs());
 
-    // If the switch reading changed, due to noise or pressing
-    if (current_reading != button->last_reading) {
-        // Reset the debouncing timer
-        button->last_debounce_time = current_time;
+    if ((inputs.pressed | inputs.released | inputs.held) == 0) {
+        return;
     }
 
-    // If enough time has passed, check if the state has changed
-    if ((current_time - button->last_debounce_time) > DEBOUNCE_DELAY_MS) {
-        // If the button state has changed
-        if (current_reading != button->current_state) {
-            button->current_state = current_reading;
-
-            // Set pressed flag only on rising edge (button press)
-            if (button->current_state == 1) {
-                button->pressed = 1;
-            }
-        }
+    __atomic_fetch_or(&pressed_events, inputs.pressed, __ATOMIC_RELAXED);
+    __atomic_fetch_or(&released_events, inputs.released, __ATOMIC_RELAXED);
+    __atomic_fetch_or(&held_events, inputs.held, __ATOMIC_RELAXED);
+
+    if ((inputs.pressed | inputs.released) & BUTTON_DPAD_MASK) {
+        update_d_pad_status();
     }
+}
 
-    button->last_reading = current_reading;
+uint16_t pb_get_levels(void) {
+    return inputs.state;
+}
+
+uint16_t pb_take_pressed(uint16_t mask) {
+    return __atomic_fetch_and(&pressed_events, (uint16_t)~mask, __ATOMIC_RELAXED) & mask;
+}
+
+uint16_t pb_take_released(uint16_t mask) {
+    return __atomic_fetch_and(&released_events, (uint16_t)~mask, __ATOMIC_RELAXED) & mask;
+}
+
+uint16_t pb_take_held(uint16_t mask) {
+    return __atomic_fetch_and(&held_events, (uint16_t)~mask, __ATOMIC_RELAXED) & mask;
 }
 
 uint8_t pb1_get_state(void) {
-    process_button(&button1, PB_Driver_ReadPin1(), PB_Driver_GetTick());
-    return button1.pressed;
+    return pb_take_pressed(BUTTON_PB1) ? 1 : 0;
 }
 
 uint8_t pb2_get_state(void) {
-    process_button(&button2, PB_Driver_ReadPin2(), PB_Driver_GetTick());
-    return button2.pressed;
+    return pb_take_pressed(BUTTON_PB2) ? 1 : 0;
+}
+
+uint8_t pb2_is_down(void) {
+    return (inputs.state & BUTTON_PB2) ? 1 : 0;
 }
 
 uint8_t dpad_pin_left_get_state(void) {
-//	process_button(&d_pad_left, read_dpad_pin_left(), PB_Driver_GetTick());
-//	return d_pad_left.pressed;
-    return read_dpad_pin_left();
+    return (inputs.state & BUTTON_DPAD_LEFT) ? 1 : 0;
 }
 
 uint8_t dpad_pin_right_get_state(void) {
-//        process_button(&d_pad_right, read_dpad_pin_right(), PB_Driver_GetTick());
-//        return d_pad_right.pressed;
-    return read_dpad_pin_right();
+    return (inputs.state & BUTTON_DPAD_RIGHT) ? 1 : 0;
 }
 
 uint8_t dpad_pin_up_get_state(void) {
-//        process_button(&d_pad_up, read_dpad_pin_up(), PB_Driver_GetTick());
-//        return d_pad_up.pressed;
-    return read_dpad_pin_up();
+    return (inputs.state & BUTTON_DPAD_UP) ? 1 : 0;
 }
 
 uint8_t dpad_pin_down_get_state(void) {
-//        process_button(&d_pad_down, read_dpad_pin_down(), PB_Driver_GetTick());
-//        return d_pad_down.pressed;
-    return read_dpad_pin_down();
+    return (inputs.state & BUTTON_DPAD_DOWN) ? 1 : 0;
 }
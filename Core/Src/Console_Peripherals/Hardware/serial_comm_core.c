@@ -3,94 +3,176 @@
  *
  *  Created on: Jul 16, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Counts bytes lost to a full DMA buffer
+ *      Receives through circular DMA and parses spans straight from its buffer
+ *      Queues outgoing frames by priority and sends them by DMA
+ *      Sends and receives variable length COBS frames with a sequence number and CRC
+ *      Frame CRCs come from the CRC unit
+ *      Frames are received into message slots and handed to the callback in place
+ *      Accepts the game state message type
+ *      Accepts the body sync message type
+ *      Counts the times the receiver stalled with every slot in use
  */
 
 
 #include "Console_Peripherals/Hardware/serial_comm_core.h"
+#include "Console_Peripherals/Hardware/Drivers/crc_driver.h"
 #include "Utils/debug_conf.h"
+#include "Utils/misc_utils.h"
 
 /* Hardware communication handles */
-static circular_buffer_t rx_buffer;
-static message_queue_t msg_queue;
+static dma_rx_ring_t rx_ring;
+static uint32_t rx_breaks_seen;
+static message_pool_t rx_pool;
 static message_parser_t parser;
 static comm_stats_t stats;
 
 /* Message storage */
-static uart_message_t message_storage[MESSAGE_QUEUE_SIZE];
-static uint8_t parse_buffer[sizeof(uart_message_t)];
+static uint8_t rx_dma_buffer[CIRCULAR_BUFFER_SIZE];
+static uint8_t rx_slots[RX_SLOT_COUNT * RX_SLOT_SIZE] __attribute__((aligned(4)));
+static uint16_t rx_sequence_expected;
+static bool rx_sequence_valid = false;
+static bool rx_pool_stalled = false;       // Every slot was lent out when the last frame started
+
+/* Transmit queues and the frame the DMA is reading */
+static message_queue_t tx_queues[TX_PRIORITY_COUNT];
+static uart_message_t tx_storage_high[TX_QUEUE_HIGH_SIZE];
+static uart_message_t tx_storage_normal[TX_QUEUE_NORMAL_SIZE];
+static uint8_t tx_wire[SERIAL_FRAME_MAX_WIRE_SIZE];
+static uint16_t tx_wire_length;
+static uint16_t tx_sequence;
+static bool tx_frame_ready = false;         // Taken off a queue and encoded, waiting for the UART
+static volatile bool tx_in_flight = false;
+static void (*tx_done_callback)(void) = NULL;
 
 /* Callback for processed messages */
 static uart_message_received_callback_t message_callback = NULL;
 
 /* Private function prototypes */
-static void UART_RxCallback(uint8_t data);
 static void parse_incoming_data(void);
+static void UART_TxDoneCallback(bool ok);
+static void update_tx_depth(void);
+static bool receive_frame(uint8_t* encoded, uint16_t length);
 
-/* UART receive callback - called from interrupt (keep minimal!) */
-static void UART_RxCallback(uint8_t data)
+/* DMA transmission finished - called from interrupt */
+static void UART_TxDoneCallback(bool ok)
 {
-    // Simply store data in circular buffer - keep ISR minimal
-    circular_buffer_put(&rx_buffer, data);
+    if (ok) {
+        stats.tx_frames_sent++;
+        stats.bytes_sent += tx_wire_length;
+    }
+    else {
+        stats.tx_errors++;
+    }
+    tx_in_flight = false;
+
+    // The next frame is started from the main loop, the queues are not touched here
+    if (tx_done_callback) {
+        tx_done_callback();
+    }
+}
+
+static void update_tx_depth(void)
+{
+    stats.tx_queue_depth = message_queue_available(&tx_queues[TX_PRIORITY_HIGH])
+        + message_queue_available(&tx_queues[TX_PRIORITY_NORMAL]);
+    if (stats.tx_queue_depth > stats.tx_queue_peak) {
+        stats.tx_queue_peak = stats.tx_queue_depth;
+    }
+}
+
+/* Decode a frame in its slot and queue it - true if the slot now holds a message */
+static bool receive_frame(uint8_t* encoded, uint16_t length)
+{
+    serial_frame_t frame;
+    serial_frame_status_t status = serial_frame_decode(encoded, length, &frame);
+
+    if (status != SERIAL_FRAME_OK) {
+        // Noise or a frame cut short, the next delimiter starts over
+        DEBUG_PRINTF(false, "Serial Comm Core: Frame dropped, error %d, %u bytes\r\n", status, length);
+        stats.parse_errors++;
+        return false;
+    }
+    // Decoding moves the bytes down over the COBS codes
+    stats.rx_bytes_copied += SERIAL_FRAME_HEADER_SIZE + frame.length + SERIAL_FRAME_CRC_SIZE;
+
+    if (rx_sequence_valid && frame.sequence != rx_sequence_expected) {
+        stats.rx_frames_lost += (uint16_t)(frame.sequence - rx_sequence_expected);
+    }
+    rx_sequence_expected = frame.sequence + 1;
+    rx_sequence_valid = true;
+
+    uart_message_view_t msg = { frame.type, frame.length, frame.sequence, frame.payload };
+    if (!hardware_serial_validate_message(&msg)) {
+        DEBUG_PRINTF(false, "Serial Comm Core: Message validation failed\r\n");
+        return false;
+    }
+
+    message_pool_commit(&rx_pool, encoded);
+    DEBUG_PRINTF(false, "Serial Comm Core: Message parsed and queued: type=0x%02X\r\n", msg.msg_type);
+    stats.messages_parsed++;
+    return true;
 }
 
-/* Parse incoming data from circular buffer */
+/* Parse whatever the DMA has written since the last call, each frame straight into a slot */
 static void parse_incoming_data(void)
 {
-    uint8_t data;
+    const uint8_t* span;
+    uint16_t length;
 
-    while (circular_buffer_get(&rx_buffer, &data)) {
-        if (message_parser_add_byte(&parser, data, MSG_START_BYTE)) {
-            stats.bytes_received++;
+    while (true) {
+        length = dma_rx_ring_span(&rx_ring, &span);
 
-            // Check if we have a complete message
-            if (message_parser_is_complete(&parser)) {
-                uart_message_t* msg = (uart_message_t*)message_parser_get_buffer(&parser);
+        // Overwritten bytes or a receive error leave a partial message behind
+        if (rx_ring.breaks != rx_breaks_seen) {
+            rx_breaks_seen = rx_ring.breaks;
+            stats.buffer_overflows = rx_ring.overflow_count;
+            message_parser_attach(&parser, parser.parse_buffer, RX_SLOT_SIZE);
+        }
+        if (length == 0) {
+            break;
+        }
 
-                if (hardware_serial_validate_message(msg)) {
-                    if (message_queue_put(&msg_queue, msg)) {
-                        DEBUG_PRINTF(false, "Serial Comm Core: Message parsed and queued: type=0x%02X\r\n", msg->msg_type);
-                        stats.messages_parsed++;
-                    }
-                    else {
-                        DEBUG_PRINTF(false, "Serial Comm Core: Message queue full, dropping message\r\n");
-                    }
+        if (parser.parse_buffer == NULL) {
+            uint8_t* slot = message_pool_acquire(&rx_pool);
+            if (slot == NULL) {
+                // Every slot holds a message not handled yet, the rest waits in the DMA buffer.
+                // Counted once per stall, not on every poll that finds the pool still empty
+                if (!rx_pool_stalled) {
+                    rx_pool_stalled = true;
+                    stats.queue_overflows++;
                 }
-                else {
-                    DEBUG_PRINTF(false, "Serial Comm Core: Message validation failed\r\n");
-                }
-                message_parser_reset(&parser);
+                break;
             }
+            rx_pool_stalled = false;
+            message_parser_attach(&parser, slot, RX_SLOT_SIZE);
         }
-    }
-}
 
-/* Calculate checksum to match ESP32 */
-uint8_t hardware_serial_calculate_checksum(const uart_message_t* msg)
-{
-    uint8_t checksum = 0;
-    const uint8_t* data = (const uint8_t*)msg;
+        uint16_t before = message_parser_get_length(&parser);
+        uint16_t used = message_parser_add_delimited(&parser, span, length, SERIAL_FRAME_DELIMITER);
+        dma_rx_ring_consume(&rx_ring, used);
+        stats.bytes_received += used;
+        if (message_parser_get_length(&parser) > before) {
+            stats.rx_bytes_copied += message_parser_get_length(&parser) - before;
+        }
 
-    // Calculate for all bytes except checksum and end_byte (last 2 bytes)
-    size_t total_length = sizeof(uart_message_t);
-    for (size_t i = 0; i < total_length - 2; i++) {
-        checksum ^= data[i];
-    }
+        // A delimiter closed a frame
+        if (message_parser_is_complete(&parser)) {
+            uint8_t* slot = message_parser_get_buffer(&parser);
+            bool queued = receive_frame(slot, message_parser_get_length(&parser));
 
-    return checksum;
+            // A rejected frame leaves the slot for the next one
+            message_parser_attach(&parser, queued ? NULL : slot, RX_SLOT_SIZE);
+        }
+    }
 }
 
-/* Validate received message */
-bool hardware_serial_validate_message(const uart_message_t* msg)
+/* Validate a received message - framing and CRC were checked when it was decoded */
+bool hardware_serial_validate_message(const uart_message_view_t* msg)
 {
-    /* Check start and end bytes */
-    if (msg->start_byte != MSG_START_BYTE || msg->end_byte != MSG_END_BYTE) {
-        DEBUG_PRINTF(false, "Serial Comm Core: Invalid delimiters: start=0x%02X, end=0x%02X\r\n",
-            msg->start_byte, msg->end_byte);
-        return false;
-    }
-
     /* Check message type */
-    if (msg->msg_type < MSG_TYPE_DATA || msg->msg_type > MSG_TILE_SIZE_VALIDATION) {
+    if (msg->msg_type < MSG_TYPE_DATA || msg->msg_type > MSG_TYPE_BODY_SYNC) {
         DEBUG_PRINTF(false, "Serial Comm Core: Invalid message type: 0x%02X\r\n", msg->msg_type);
         return false;
     }
@@ -101,15 +183,6 @@ bool hardware_serial_validate_message(const uart_message_t* msg)
         return false;
     }
 
-    /* Calculate and verify checksum */
-    uint8_t calculated_checksum = hardware_serial_calculate_checksum(msg);
-    if (msg->checksum != calculated_checksum) {
-        DEBUG_PRINTF(false, "Serial Comm Core: Checksum mismatch: expected=0x%02X, calculated=0x%02X\r\n",
-            msg->checksum, calculated_checksum);
-        stats.parse_errors++;
-        return false;
-    }
-
     return true;
 }
 
@@ -117,11 +190,23 @@ bool hardware_serial_validate_message(const uart_message_t* msg)
 UART_Status hardware_serial_init(void)
 {
     /* Initialize all communication utilities */
-    circular_buffer_init(&rx_buffer);
-    message_queue_init(&msg_queue, message_storage, MESSAGE_QUEUE_SIZE, sizeof(uart_message_t));
-    message_parser_init(&parser, parse_buffer, sizeof(uart_message_t));
+    dma_rx_ring_init(&rx_ring, rx_dma_buffer, sizeof(rx_dma_buffer));
+    rx_breaks_seen = 0;
+    rx_sequence_valid = false;
+    rx_pool_stalled = false;
+    message_pool_init(&rx_pool, rx_slots, RX_SLOT_COUNT, RX_SLOT_SIZE);
+    message_parser_init(&parser, message_pool_acquire(&rx_pool), RX_SLOT_SIZE);
+    message_queue_init(&tx_queues[TX_PRIORITY_HIGH], tx_storage_high, TX_QUEUE_HIGH_SIZE, sizeof(uart_message_t));
+    message_queue_init(&tx_queues[TX_PRIORITY_NORMAL], tx_storage_normal, TX_QUEUE_NORMAL_SIZE, sizeof(uart_message_t));
+    tx_frame_ready = false;
+    tx_in_flight = false;
+    tx_sequence = 0;
     comm_stats_init(&stats);
 
+    /* Frame CRCs in hardware, a word per write */
+    crc_driver_init();
+    serial_frame_register_crc(crc_driver_compute);
+
     /* Initialize callback to NULL */
     message_callback = NULL;
 
@@ -132,17 +217,16 @@ UART_Status hardware_serial_init(void)
         return status;
     }
 
-    /* Register callback for interrupt-based reception */
-    status = UART_RegisterRxCallback(UART_PORT_2, UART_RxCallback);
+    status = UART_RegisterTxCompleteCallback(UART_PORT_2, UART_TxDoneCallback);
     if (status != UART_OK) {
-        DEBUG_PRINTF(false, "Serial Comm Core: UART callback registration failed: %d\r\n", status);
+        DEBUG_PRINTF(false, "Serial Comm Core: UART TX callback registration failed: %d\r\n", status);
         return status;
     }
 
-    /* Enable Rx interrupt */
-    status = UART_EnableRxInterrupt(UART_PORT_2);
+    /* Receive into the ring by circular DMA, interrupts come per burst and per half buffer */
+    status = UART_StartRxDma(UART_PORT_2, &rx_ring);
     if (status != UART_OK) {
-        DEBUG_PRINTF(false, "Serial Comm Core: UART interrupt enable failed: %d\r\n", status);
+        DEBUG_PRINTF(false, "Serial Comm Core: UART DMA reception failed to start: %d\r\n", status);
         return status;
     }
 
@@ -159,31 +243,94 @@ UART_Status hardware_serial_deinit(void)
     message_callback = NULL;
 
     /* Clear all buffers */
-    circular_buffer_flush(&rx_buffer);
-    message_queue_flush(&msg_queue);
-    message_parser_reset(&parser);
+    dma_rx_ring_flush(&rx_ring);
+    message_pool_flush(&rx_pool);
+    message_parser_attach(&parser, NULL, RX_SLOT_SIZE);
+    message_queue_flush(&tx_queues[TX_PRIORITY_HIGH]);
+    message_queue_flush(&tx_queues[TX_PRIORITY_NORMAL]);
+    tx_frame_ready = false;
+    update_tx_depth();
 
     DEBUG_PRINTF(false, "Serial Comm Core: UART Communication Hardware Deinitialized\r\n");
     return UART_OK;
 }
 
-/* Send raw message over UART */
+/* Queue a message at normal priority */
 UART_Status hardware_serial_send_message(const uart_message_t* msg)
 {
-    UART_Status status = UART_SendBuffer(UART_PORT_2, (uint8_t*)msg,
-        sizeof(uart_message_t), 1000);
+    return hardware_serial_queue_message(msg, TX_PRIORITY_NORMAL, TX_FULL_DROP_NEWEST);
+}
+
+/* Queue a message and start sending it if the UART is free - never waits for the wire */
+UART_Status hardware_serial_queue_message(const uart_message_t* msg, tx_priority_t priority,
+    tx_full_policy_t policy)
+{
+    if (msg == NULL || priority >= TX_PRIORITY_COUNT) {
+        return UART_ERROR;
+    }
 
-    if (status == UART_OK) {
-        stats.bytes_sent += sizeof(uart_message_t);
-        DEBUG_PRINTF(false, "Serial Comm Core: Message sent successfully\r\n");
+    uint32_t start_us = get_current_us();
+    message_queue_t* queue = &tx_queues[priority];
+    UART_Status status = UART_OK;
+
+    if (!message_queue_is_full(queue)) {
+        message_queue_put(queue, msg);
+    }
+    else if (policy == TX_FULL_DROP_OLDEST) {
+        message_queue_put_overwrite(queue, msg);
+        stats.tx_overwritten++;
     }
     else {
-        DEBUG_PRINTF(false, "Serial Comm Core: Failed to send message, status: %d\r\n", status);
+        DEBUG_PRINTF(false, "Serial Comm Core: TX queue full, dropping message type=0x%02X\r\n", msg->msg_type);
+        stats.tx_dropped++;
+        status = UART_BUSY;
     }
 
+    update_tx_depth();
+    hardware_serial_service_tx();
+
+    uint32_t elapsed_us = get_current_us() - start_us;
+    if (elapsed_us > stats.tx_send_us_max) {
+        stats.tx_send_us_max = elapsed_us;
+    }
     return status;
 }
 
+/* Start the next frame, high priority first, once the previous one is out */
+void hardware_serial_service_tx(void)
+{
+    if (tx_in_flight) {
+        return;
+    }
+
+    if (!tx_frame_ready) {
+        uart_message_t msg;
+        if (!message_queue_get(&tx_queues[TX_PRIORITY_HIGH], &msg)
+            && !message_queue_get(&tx_queues[TX_PRIORITY_NORMAL], &msg)) {
+            return;
+        }
+        // Only the used part of the payload goes on the wire
+        tx_wire_length = serial_frame_encode(msg.msg_type, tx_sequence++, msg.data, msg.length, tx_wire);
+        tx_frame_ready = true;
+        update_tx_depth();
+    }
+
+    tx_in_flight = true;
+    if (UART_SendBufferDma(UART_PORT_2, tx_wire, tx_wire_length) != UART_OK) {
+        // Kept for the next try
+        tx_in_flight = false;
+        stats.tx_errors++;
+        return;
+    }
+    tx_frame_ready = false;
+}
+
+/* Register a hook for the end of each transmission, e.g. to schedule hardware_serial_service_tx() */
+void hardware_serial_register_tx_done_callback(void (*callback)(void))
+{
+    tx_done_callback = callback;
+}
+
 /* Check if messages are ready for processing */
 bool hardware_serial_is_message_ready(void)
 {
@@ -191,20 +338,47 @@ bool hardware_serial_is_message_ready(void)
     parse_incoming_data();
 
     /* Check if we have any parsed messages ready */
-    return !message_queue_is_empty(&msg_queue);
+    return message_pool_ready(&rx_pool) > 0;
 }
 
 /* Process incoming messages and call callback */
 void hardware_serial_process_incoming(void)
 {
-    uart_message_t msg;
+    uart_message_view_t msg;
 
-    /* Process all available messages */
-    while (message_queue_get(&msg_queue, &msg)) {
+    /* Process all available messages, each read where it was decoded */
+    while (hardware_serial_borrow_message(&msg)) {
         if (message_callback) {
             message_callback(&msg);
         }
+        hardware_serial_release_message(&msg);
+    }
+}
+
+/* Lend out the oldest waiting message - its slot is not reused until it is released */
+bool hardware_serial_borrow_message(uart_message_view_t* msg)
+{
+    if (msg == NULL) {
+        return false;
+    }
+
+    const uint8_t* slot = message_pool_borrow(&rx_pool);
+    if (slot == NULL) {
+        return false;
+    }
+    msg->msg_type = slot[0];
+    msg->length = slot[1];
+    msg->sequence = (uint16_t)(slot[2] | (slot[3] << 8));
+    msg->data = &slot[SERIAL_FRAME_HEADER_SIZE];
+    return true;
+}
+
+void hardware_serial_release_message(const uart_message_view_t* msg)
+{
+    if (msg == NULL || msg->data == NULL) {
+        return;
     }
+    message_pool_release(&rx_pool, msg->data - SERIAL_FRAME_HEADER_SIZE);
 }
 
 /* Register callback for received messages */
@@ -224,11 +398,24 @@ void hardware_serial_get_stats(uint32_t* bytes_sent, uint32_t* bytes_received,
     if (parse_errors) *parse_errors = stats.parse_errors;
 }
 
+/* Bytes the RX DMA overwrote before they were parsed - a stall on a full slot pool loses nothing */
+uint32_t hardware_serial_get_drop_count(void)
+{
+    return stats.buffer_overflows;
+}
+
+/* Counters of both directions, with the current transmit queue depth */
+const comm_stats_t* hardware_serial_get_comm_stats(void)
+{
+    return &stats;
+}
+
 /* Reset hardware buffers */
 void hardware_serial_reset_buffers(void)
 {
-    circular_buffer_flush(&rx_buffer);
-    message_queue_flush(&msg_queue);
-    message_parser_reset(&parser);
+    dma_rx_ring_flush(&rx_ring);
+    message_pool_flush(&rx_pool);
+    message_parser_attach(&parser, NULL, RX_SLOT_SIZE);
+    rx_sequence_valid = false;
     DEBUG_PRINTF(false, "Serial Comm Core: Buffers reset\r\n");
 }
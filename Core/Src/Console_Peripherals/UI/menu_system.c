@@ -4,11 +4,14 @@
  *  Created on: Jun 2, 2025
  *      Author: rohitimandi
  *  Updated: Added Single Player / Multiplayer support
+ *  Modified on: Oct 18, 2026
+ *      Game menus are built from the game registry
  */
 
 #include "Console_Peripherals/UI/menu_system.h"
 #include "Console_Peripherals/Hardware/display_manager.h"
 #include "Communication/serial_comm.h"
+#include "Game_Engine/game_registry.h"
 
  /* Private function declarations */
 static bool handle_navigation_up(MenuState* menu_state);
@@ -22,21 +25,9 @@ static MenuItem main_menu[] = {
     {"Multi Player", 0, SCREEN_MENU, 0, GAME_MODE_MULTIPLAYER}
 };
 
-static MenuItem single_player_menu[] = {
-    {"Snake Game", 0, SCREEN_GAME_SNAKE, 1, GAME_MODE_SINGLE_PLAYER},
-    {"Pacman Game", 0, SCREEN_GAME_PACMAN, 1, GAME_MODE_SINGLE_PLAYER},
-    {"Game 3", 0, SCREEN_GAME_3, 1, GAME_MODE_SINGLE_PLAYER},
-    {"Game 4", 0, SCREEN_GAME_4, 1, GAME_MODE_SINGLE_PLAYER},
-    {"Game 5", 0, SCREEN_GAME_5, 1, GAME_MODE_SINGLE_PLAYER}
-};
-
-static MenuItem multiplayer_menu[] = {
-    {"Snake Game", 0, SCREEN_MP_GAME_SNAKE, 1, GAME_MODE_MULTIPLAYER},
-    {"Pacman Game", 0, SCREEN_MP_GAME_PACMAN, 1, GAME_MODE_MULTIPLAYER},
-    {"Game 3", 0, SCREEN_MP_GAME_3, 1, GAME_MODE_MULTIPLAYER},
-    {"Game 4", 0, SCREEN_MP_GAME_4, 1, GAME_MODE_MULTIPLAYER},
-    {"Game 5", 0, SCREEN_MP_GAME_5, 1, GAME_MODE_MULTIPLAYER}
-};
+// Game menus are filled from the game registry
+static MenuItem single_player_menu[MAX_MENU_ITEMS];
+static MenuItem multiplayer_menu[MAX_MENU_ITEMS];
 
 /* Menu system initialization and cleanup */
 void menu_system_init(MenuState* menu_state, MenuItem* items, uint8_t item_count) {
@@ -350,7 +341,7 @@ void menu_system_get_single_player_menu(MenuItem** menu_ptr, uint8_t* size_ptr)
     }
 
     *menu_ptr = single_player_menu;
-    *size_ptr = sizeof(single_player_menu) / sizeof(single_player_menu[0]);
+    *size_ptr = game_registry_build_menu(GAME_MODE_SINGLE_PLAYER, single_player_menu, MAX_MENU_ITEMS);
 }
 
 void menu_system_get_multiplayer_menu(MenuItem** menu_ptr, uint8_t* size_ptr) {
@@ -361,7 +352,7 @@ void menu_system_get_multiplayer_menu(MenuItem** menu_ptr, uint8_t* size_ptr) {
     }
 
     *menu_ptr = multiplayer_menu;
-    *size_ptr = sizeof(multiplayer_menu) / sizeof(multiplayer_menu[0]);
+    *size_ptr = game_registry_build_menu(GAME_MODE_MULTIPLAYER, multiplayer_menu, MAX_MENU_ITEMS);
 }
 
 /* Legacy compatibility functions - for backward compatibility */
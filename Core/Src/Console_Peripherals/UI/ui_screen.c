@@ -0,0 +1,97 @@
+/*
+ * ui_screen.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Console_Peripherals/UI/ui_screen.h"
+#include "Utils/debug_conf.h"
+#include <string.h>
+
+static const UiScreen* current = NULL;
+static uint32_t entered_ms = 0;
+static uint32_t drops_at_enter = 0;
+static ui_screen_counter_t count_drops = NULL;
+static UiScreenStats stats;
+
+void ui_screen_init(ui_screen_counter_t drop_counter) {
+    current = NULL;
+    count_drops = drop_counter;
+    memset(&stats, 0, sizeof(stats));
+}
+
+static void leave_current(uint32_t now_ms) {
+    const UiScreen* screen = current;
+    uint32_t shown_ms = now_ms - entered_ms;
+    uint32_t dropped = (count_drops != NULL) ? count_drops() - drops_at_enter : 0;
+
+    current = NULL;
+    if (shown_ms > stats.longest_ms) {
+        stats.longest_ms = shown_ms;
+    }
+    stats.dropped += dropped;
+
+    DEBUG_PRINTF(false, "UI: %s screen up for %lu ms, %lu comm drops\r\n",
+        screen->name, (unsigned long)shown_ms, (unsigned long)dropped);
+
+    if (screen->exit) {
+        screen->exit();
+    }
+}
+
+void ui_screen_show(const UiScreen* screen, uint32_t now_ms) {
+    if (current != NULL) {
+        leave_current(now_ms);
+    }
+
+    current = screen;
+    entered_ms = now_ms;
+    drops_at_enter = (count_drops != NULL) ? count_drops() : 0;
+    stats.shown++;
+
+    if (screen->enter) {
+        screen->enter();
+    }
+}
+
+void ui_screen_leave(uint32_t now_ms) {
+    if (current != NULL) {
+        leave_current(now_ms);
+    }
+}
+
+bool ui_screen_update(uint32_t now_ms) {
+    const UiScreen* screen = current;
+    if (screen == NULL) {
+        return false;
+    }
+
+    uint32_t elapsed_ms = now_ms - entered_ms;
+    bool finished = screen->update ? screen->update(elapsed_ms) : false;
+
+    // The update hook may have moved on to another screen itself
+    if (current != screen) {
+        return current != NULL;
+    }
+
+    if (screen->duration_ms != UI_SCREEN_FOREVER && elapsed_ms >= screen->duration_ms) {
+        finished = true;
+    }
+
+    if (finished) {
+        leave_current(now_ms);
+        if (screen->done) {
+            screen->done();
+        }
+    }
+    return current != NULL;
+}
+
+const UiScreen* ui_screen_current(void) {
+    return current;
+}
+
+const UiScreenStats* ui_screen_get_stats(void) {
+    return &stats;
+}
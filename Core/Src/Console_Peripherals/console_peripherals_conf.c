@@ -14,6 +14,7 @@ void console_peripherals_init(void) {
 
 	// Initialize random seed to spawn food and snake
 	init_random();
+	cycle_counter_init();
 
 	joystick_init();
 	pb_init();
@@ -6,10 +6,16 @@
  *
  * Helper functions for snake game logic that can be shared between
  * single-player and multi-player implementations
+ *
+ *  Modified on: Oct 18, 2026
+ *      Food is placed from the session's random stream
  */
 
 
 #include "Game_Engine/Games/Helpers/snake_game_helpers.h"
+#include "Game_Engine/game_registry.h"
+
+static RotatedSprite snake_head_rotations;   // Built on the first snake launch
 
 void snake_helper_wrap_coordinates(coord_t* x, coord_t* y) {
     // Handle X wrapping with proper underflow check
@@ -43,28 +49,29 @@ void snake_helper_move_snake(SnakeState* snake) {
 	// Wrap around screen borders
 	snake_helper_wrap_coordinates(&snake->head_x, &snake->head_y);
 
-	// Update body segments
-	for(uint8_t i = 0; i < snake->length; i++) {
-		coord_t temp_x = snake->body[i].x;
-		coord_t temp_y = snake->body[i].y;
-
-		snake->body[i].x = prev_x;
-		snake->body[i].y = prev_y;
+	// Update body segments - shift each coordinate array down by one, the old head becomes segment 0
+	if (snake->length > 0) {
+		coord_t* body_x = snake_body_x(snake);
+		coord_t* body_y = snake_body_y(snake);
 
-		prev_x = temp_x;
-		prev_y = temp_y;
+		memmove(&body_x[1], &body_x[0], (snake->length - 1) * sizeof(coord_t));
+		memmove(&body_y[1], &body_y[0], (snake->length - 1) * sizeof(coord_t));
+		body_x[0] = prev_x;
+		body_y[0] = prev_y;
 	}
 }
 
 // Checks if snake collided with itself
 bool snake_helper_check_self_collision(SnakeState* snake) {
+	const coord_t* segment_x = snake_body_x(snake);
+	const coord_t* segment_y = snake_body_y(snake);
+
 	for (uint8_t i = 1; i < snake->length; i++) {
-		coord_t body_x = snake->body[i].x;
-		coord_t body_y = snake->body[i].y;
+		coord_t body_x = segment_x[i];
+		coord_t body_y = segment_y[i];
 		snake_helper_wrap_coordinates(&body_x, &body_y);
 
-		if (abs(snake->head_x - body_x) < SPRITE_SIZE &&
-				abs(snake->head_y - body_y) < SPRITE_SIZE) {
+		if (snake_helper_positions_overlap(snake->head_x, snake->head_y, body_x, body_y)) {
 			return true;
 		}
 	}
@@ -78,16 +85,19 @@ bool snake_helper_check_food_collision(SnakeState* snake, const Position* food)
 	coord_t food_y = food->y;
 	snake_helper_wrap_coordinates(&food_x, &food_y);
 
-	return (abs(snake->head_x - food_x) < SPRITE_SIZE && abs(snake->head_y - food_y) < SPRITE_SIZE);
+	return snake_helper_positions_overlap(snake->head_x, snake->head_y, food_x, food_y);
 }
 
 // Grow snake by one segment
 void snake_helper_grow_snake(SnakeState* snake) {
-    if (snake->length < 63) {  // Prevent overflow
+    if (snake->length < SNAKE_MAX_LENGTH - 1) {  // Prevent overflow
+        coord_t* body_x = snake_body_x(snake);
+        coord_t* body_y = snake_body_y(snake);
+
         snake->length++;
         // New segment takes position of previous tail
-        snake->body[snake->length - 1].x = snake->body[snake->length - 2].x;
-        snake->body[snake->length - 1].y = snake->body[snake->length - 2].y;
+        body_x[snake->length - 1] = body_x[snake->length - 2];
+        body_y[snake->length - 1] = body_y[snake->length - 2];
     }
 }
 
@@ -116,9 +126,9 @@ void snake_helper_spawn_food(Position* food, const SnakeState* snake) {
     while (!valid_position && attempts < max_attempts) {
         // Generate random position for food
         food->x = BORDER_OFFSET +
-            (get_random() % (DISPLAY_WIDTH - 2 * BORDER_OFFSET - SPRITE_SIZE));
+            game_random_below(&game_random, DISPLAY_WIDTH - 2 * BORDER_OFFSET - SPRITE_SIZE);
         food->y = GAME_AREA_TOP +
-            (get_random() % (DISPLAY_HEIGHT - GAME_AREA_TOP - BORDER_OFFSET - SPRITE_SIZE));
+            game_random_below(&game_random, DISPLAY_HEIGHT - GAME_AREA_TOP - BORDER_OFFSET - SPRITE_SIZE);
 
         // Check if food spawns on snake head
         if (snake_helper_positions_overlap(food->x, food->y, snake->head_x, snake->head_y)) {
@@ -127,9 +137,11 @@ void snake_helper_spawn_food(Position* food, const SnakeState* snake) {
         }
 
         // Check if food spawns on snake body
+        const coord_t* body_x = snake_body_x(snake);
+        const coord_t* body_y = snake_body_y(snake);
         valid_position = true;
         for (uint8_t i = 0; i < snake->length; i++) {
-            if (snake_helper_positions_overlap(food->x, food->y, snake->body[i].x, snake->body[i].y)) {
+            if (snake_helper_positions_overlap(food->x, food->y, body_x[i], body_y[i])) {
                 valid_position = false;
                 break;
             }
@@ -156,36 +168,44 @@ void snake_helper_init_snake(SnakeState* snake, coord_t start_x, coord_t start_y
     snake->head_y = start_y;
     snake->direction = start_direction;
     snake->length = 1;
+    snake->body = entity_create_block(game_entities, SNAKE_MAX_LENGTH);  // Block comes back zeroed
+
+    coord_t* body_x = snake_body_x(snake);
+    coord_t* body_y = snake_body_y(snake);
 
     // Initialize first body segment behind the head
     switch (start_direction) {
     case DPAD_DIR_RIGHT:
-        snake->body[0].x = start_x - SPRITE_SIZE;
-        snake->body[0].y = start_y;
+        body_x[0] = start_x - SPRITE_SIZE;
+        body_y[0] = start_y;
         break;
     case DPAD_DIR_LEFT:
-        snake->body[0].x = start_x + SPRITE_SIZE;
-        snake->body[0].y = start_y;
+        body_x[0] = start_x + SPRITE_SIZE;
+        body_y[0] = start_y;
         break;
     case DPAD_DIR_UP:
-        snake->body[0].x = start_x;
-        snake->body[0].y = start_y + SPRITE_SIZE;
+        body_x[0] = start_x;
+        body_y[0] = start_y + SPRITE_SIZE;
         break;
     case DPAD_DIR_DOWN:
-        snake->body[0].x = start_x;
-        snake->body[0].y = start_y - SPRITE_SIZE;
+        body_x[0] = start_x;
+        body_y[0] = start_y - SPRITE_SIZE;
         break;
     default:
-        snake->body[0].x = start_x - SPRITE_SIZE;
-        snake->body[0].y = start_y;
+        body_x[0] = start_x - SPRITE_SIZE;
+        body_y[0] = start_y;
         break;
     }
+}
 
-    // Clear remaining body segments
-    for (uint8_t i = 1; i < 64; i++) {
-        snake->body[i].x = 0;
-        snake->body[i].y = 0;
+void snake_helper_load_assets(void) {
+    if (snake_head_rotations.turns != NULL) {
+        return;
     }
+
+    size_t size = sprite_rotations_size(snake_head_animated.frames, snake_head_animated.num_frames);
+    sprite_rotations_build(&snake_head_rotations, snake_head_animated.frames,
+        snake_head_animated.num_frames, game_registry_asset_alloc(size));
 }
 
 // Draw snake using sprites
@@ -199,12 +219,19 @@ void snake_helper_draw_snake(const SnakeState* snake) {
     case DPAD_DIR_UP:    rotation = 270; break;
     }
 
-    sprite_draw_rotated(&snake_head_animated.frames[snake_head_animated.current_frame],
-        snake->head_x, snake->head_y, rotation, DISPLAY_WHITE);
+    const Sprite* head = sprite_rotation_get(&snake_head_rotations, snake_head_animated.current_frame, rotation);
+    if (head != NULL) {
+        sprite_draw(head, snake->head_x, snake->head_y, DISPLAY_WHITE);
+    } else {
+        sprite_draw_rotated(&snake_head_animated.frames[snake_head_animated.current_frame],
+            snake->head_x, snake->head_y, rotation, DISPLAY_WHITE);
+    }
 
     // Draw snake body segments
+    const coord_t* body_x = snake_body_x(snake);
+    const coord_t* body_y = snake_body_y(snake);
     for (uint8_t i = 0; i < snake->length; i++) {
-        sprite_draw(&snake_body_sprite, snake->body[i].x, snake->body[i].y, DISPLAY_WHITE);
+        sprite_draw(&snake_body_sprite, body_x[i], body_y[i], DISPLAY_WHITE);
     }
 }
 
@@ -221,14 +248,14 @@ void snake_helper_draw_food(const Position* food) {
     sprite_draw(&food_sprite, food->x, food->y, DISPLAY_WHITE);
 }
 
-// Copy snake state from source to destination
+// Copy snake state from source to destination. Both share the same body segments.
 void snake_helper_copy_snake_state(SnakeState* dest, const SnakeState* src) {
     memcpy(dest, src, sizeof(SnakeState));
 }
 
-// Check if two positions overlap (within sprite size)
+// Check if two sprite sized boxes at these positions overlap
 bool snake_helper_positions_overlap(coord_t x1, coord_t y1, coord_t x2, coord_t y2) {
-    return (abs(x1 - x2) < SPRITE_SIZE && abs(y1 - y2) < SPRITE_SIZE);
+    return collision_boxes_overlap(x1, y1, SPRITE_SIZE, SPRITE_SIZE, x2, y2, SPRITE_SIZE, SPRITE_SIZE);
 }
 
 // Convert server co-ordinates to device grid co-ordindates
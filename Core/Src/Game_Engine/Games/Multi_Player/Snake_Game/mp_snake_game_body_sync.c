@@ -0,0 +1,109 @@
+/*
+ * mp_snake_game_body_sync.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_body_sync.h"
+#include "Utils/debug_conf.h"
+
+// One server cell in the direction of code, or against it, wrapped like local movement
+static void step(coord_t* x, coord_t* y, uint8_t code, bool backwards) {
+    if (backwards) {
+        code ^= 0x02;   // Opposite direction
+    }
+
+    switch (code) {
+    case BODY_SYNC_CODE_UP:    *y -= MP_DEVICE_TILE_SIZE; break;
+    case BODY_SYNC_CODE_RIGHT: *x += MP_DEVICE_TILE_SIZE; break;
+    case BODY_SYNC_CODE_DOWN:  *y += MP_DEVICE_TILE_SIZE; break;
+    case BODY_SYNC_CODE_LEFT:  *x -= MP_DEVICE_TILE_SIZE; break;
+    }
+    snake_helper_wrap_coordinates(x, y);
+}
+
+// Walks the codes back from the head, the only time the body is rebuilt
+static void apply_keyframe(SnakeState* snake, const uart_body_sync_t* body_sync) {
+    coord_t* body_x = snake_body_x(snake);
+    coord_t* body_y = snake_body_y(snake);
+    coord_t x = mp_snake_server_to_device_coord(body_sync->head_x);
+    coord_t y = mp_snake_server_to_device_coord(body_sync->head_y);
+
+    snake->head_x = x;
+    snake->head_y = y;
+    for (uint8_t i = 0; i < body_sync->length; i++) {
+        step(&x, &y, body_sync_code(body_sync->codes, i), true);
+        body_x[i] = x;
+        body_y[i] = y;
+    }
+    snake->length = body_sync->length;
+    if (body_sync->length > 0) {
+        snake->direction = DPAD_DIR_UP + body_sync_code(body_sync->codes, 0);
+    }
+}
+
+// The old head becomes segment 0 for every move, the tail is whatever the new length leaves.
+// Segments up to the longer of the two lengths are kept, so a growing snake keeps its tail.
+static void apply_delta(SnakeState* snake, const uart_body_sync_t* body_sync) {
+    coord_t* body_x = snake_body_x(snake);
+    coord_t* body_y = snake_body_y(snake);
+    uint8_t kept = (body_sync->length > snake->length) ? body_sync->length : snake->length;
+
+    if (kept > SNAKE_MAX_LENGTH) {
+        kept = SNAKE_MAX_LENGTH;
+    }
+
+    for (uint8_t i = 0; i < body_sync->move_count; i++) {
+        uint8_t code = body_sync_code(body_sync->codes, i);
+
+        if (kept > 1) {
+            memmove(&body_x[1], &body_x[0], (kept - 1) * sizeof(coord_t));
+            memmove(&body_y[1], &body_y[0], (kept - 1) * sizeof(coord_t));
+        }
+        body_x[0] = snake->head_x;
+        body_y[0] = snake->head_y;
+        step(&snake->head_x, &snake->head_y, code, false);
+        snake->direction = DPAD_DIR_UP + code;
+    }
+    snake->length = body_sync->length;
+}
+
+void mp_body_sync_init(BodySync* sync) {
+    memset(sync, 0, sizeof(BodySync));
+}
+
+bool mp_body_sync_apply(BodySync* sync, SnakeState* snake, const uart_body_sync_t* body_sync) {
+    if (body_sync->length > SNAKE_MAX_LENGTH) {
+        return false;
+    }
+
+    if (body_sync->kind == BODY_SYNC_KIND_KEYFRAME) {
+        apply_keyframe(snake, body_sync);
+        sync->tick = body_sync->tick;
+        sync->synced = true;
+        sync->keyframes++;
+        return true;
+    }
+
+    // A delta only fits onto the tick its moves start from
+    uint32_t from_tick = body_sync->tick - body_sync->move_count;
+    if (!sync->synced || from_tick != sync->tick) {
+        if (sync->synced && (int32_t)(body_sync->tick - sync->tick) <= 0) {
+            sync->stale++;
+            return false;
+        }
+        if (sync->synced) {
+            DEBUG_PRINTF(false, "Body sync: Delta from tick %lu, body at %lu - waiting for a keyframe\r\n",
+                from_tick, sync->tick);
+            sync->synced = false;
+        }
+        sync->gaps++;
+        return false;
+    }
+
+    apply_delta(snake, body_sync);
+    sync->tick = body_sync->tick;
+    sync->deltas++;
+    return true;
+}
@@ -5,62 +5,67 @@
  *      Author: rohitimandi
  *  Core game logic and state management for multiplayer snake
  *  Similar to TypeScript MultiplayerSnakeCore class
+ *  Modified on: Oct 18, 2026
+ *      Local movement runs on a periodic engine timer
+ *      The local snake is predicted and rolled back to the server's positions
+ *      The opponent's body follows the server's body sync
+ *      The opponent is shown through a jitter buffer, a measured delay behind the server
+ *      Game state, prediction and jitter buffer live in the game arena for the session
  */
 
 #include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_core.h"
+#include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_prediction.h"
+#include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_jitter.h"
 #include "Utils/misc_utils.h"
 #include "Utils/debug_conf.h"
 
 
- // Static game state (similar to private properties in TS class)
-MultiplayerSnakeGameData mp_snake_data = { 0 };
+ // Game state (similar to private properties in TS class), placed in the game arena by the engine
+MultiplayerSnakeGameData* mp_snake_data = NULL;
 
-// Movement simulation state
-static uint32_t last_movement_time = 0;
-static bool movement_simulation_active = false;
+// Movement simulation period - a periodic timer on the engine wheel while playing
 static const uint32_t MOVEMENT_INTERVAL_MS = 100;
 
-// Server reconciliation tracking
-static uint32_t last_processed_sequence = 0;
-static uint32_t last_server_reconciliation = 0;
-
 // Utility helpers
 static void mp_snake_apply_server_state(const TempServerState* server_state);
+static void movement_step(void* context);
 
 // Core game logic functions
 void mp_snake_core_init(MultiplayerPlayerId player_id, uint32_t target_score) {
-    // Reset all state
-    memset(&mp_snake_data, 0, sizeof(MultiplayerSnakeGameData));
+    // Reset all state, the movement timer is dropped before its id is cleared
+    timer_cancel(&game_timers, mp_snake_data->movement_timer);
+    memset(mp_snake_data, 0, sizeof(MultiplayerSnakeGameData));
 
-    mp_snake_data.local_player_id = player_id;
-    mp_snake_data.target_score = target_score;
-    mp_snake_data.phase = MP_PHASE_WAITING;
-    mp_snake_data.winner = MP_RESULT_ONGOING;
+    mp_snake_data->local_player_id = player_id;
+    mp_snake_data->target_score = target_score;
+    mp_snake_data->phase = MP_PHASE_WAITING;
+    mp_snake_data->winner = MP_RESULT_ONGOING;
 
     // Initialize both players using helper functions
     coord_t start_x = DISPLAY_WIDTH / 2;
     coord_t start_y = DISPLAY_HEIGHT / 2;
 
     // Player 1 starts on left side, Player 2 on right side (like TS)
-    snake_helper_init_snake(&mp_snake_data.player1,
+    // Both bodies are blocks in the shared entity store
+    entity_store_reset(game_entities);
+    snake_helper_init_snake(&mp_snake_data->player1,
         start_x - 32, start_y, DPAD_DIR_RIGHT);
-    snake_helper_init_snake(&mp_snake_data.player2,
+    snake_helper_init_snake(&mp_snake_data->player2,
         start_x + 32, start_y, DPAD_DIR_LEFT);
 
     // Initialize food position
-    mp_snake_data.server_food.x = start_x;
-    mp_snake_data.server_food.y = start_y - 32;
+    mp_snake_data->server_food.x = start_x;
+    mp_snake_data->server_food.y = start_y - 32;
+    mp_prediction_init(&mp_snake_data->local_prediction, mp_snake_get_local_player_state(), 0);
+    mp_jitter_init(&mp_snake_data->opponent_jitter, MOVEMENT_INTERVAL_MS, MP_JITTER_DEFAULT_DELAY_MS);
 
     // Set both players as alive initially
-    mp_snake_data.players_alive[0] = true;
-    mp_snake_data.players_alive[1] = true;
+    mp_snake_data->players_alive[0] = true;
+    mp_snake_data->players_alive[1] = true;
 
     // Reset timing
-    last_movement_time = get_current_ms();
-    last_processed_sequence = 0;
-    last_server_reconciliation = 0;
-    mp_snake_data.game_start_time = get_current_ms();
-    movement_simulation_active = false;
+    mp_snake_data->movement_timer = TIMER_NONE;
+    mp_snake_data->game_start_time = get_current_ms();
 
     DEBUG_PRINTF(false, "Core: Multiplayer snake initialized for Player %d\r\n", player_id);
 }
@@ -69,82 +74,75 @@ void mp_snake_core_cleanup(void) {
     // Stop movement simulation first
     mp_snake_stop_movement_simulation();
 
-    // Reset all state (similar to TS cleanup)
-    memset(&mp_snake_data, 0, sizeof(MultiplayerSnakeGameData));
-
-    // Reset timing
-    last_movement_time = 0;
-    last_processed_sequence = 0;
-    last_server_reconciliation = 0;
-    movement_simulation_active = false;
+    // The rest of the state goes back with the game arena
 
     DEBUG_PRINTF(false, "Core: Multiplayer snake cleanup completed\r\n");
 }
 
 // Movement simulation
 void mp_snake_start_movement_simulation(void) {
-    movement_simulation_active = true;
-    last_movement_time = get_current_ms();
+    timer_cancel(&game_timers, mp_snake_data->movement_timer);
+    mp_snake_data->movement_timer = timer_start(&game_timers, MOVEMENT_INTERVAL_MS, MOVEMENT_INTERVAL_MS,
+        movement_step, NULL);
     DEBUG_PRINTF(false, "Core: Movement simulation started\r\n");
 }
 
 void mp_snake_stop_movement_simulation(void) {
-    movement_simulation_active = false;
+    timer_cancel(&game_timers, mp_snake_data->movement_timer);
+    mp_snake_data->movement_timer = TIMER_NONE;
     DEBUG_PRINTF(false, "Core: Movement simulation stopped\r\n");
 }
 
+static void movement_step(void* context) {
+    (void)context;
+    mp_snake_move_all_players_locally();
+}
+
 void mp_snake_move_all_players_locally(void) {
     // Moves both players based on server state
-    if (!movement_simulation_active || mp_snake_data.phase != MP_PHASE_PLAYING) {
+    if (!timer_is_active(&game_timers, mp_snake_data->movement_timer) || mp_snake_data->phase != MP_PHASE_PLAYING) {
         return;
     }
 
-    uint32_t current_time = get_current_ms();
-    if (current_time - last_movement_time < MOVEMENT_INTERVAL_MS) {
-        return; // Not time to move yet
-    }
+    // Move all players, the local one through its prediction so the move can be replayed
+    SnakeState* local_player = mp_snake_get_local_player_state();
+    SnakeState* opponent = mp_snake_get_opponent_state();
 
-    // Move all players
-    if (mp_snake_data.players_alive[0]) {
-        snake_helper_move_snake(&mp_snake_data.player1);
-        snake_helper_wrap_coordinates(&mp_snake_data.player1.head_x,
-            &mp_snake_data.player1.head_y);
+    if (mp_snake_data->players_alive[mp_snake_data->local_player_id - 1]) {
+        mp_prediction_step(&mp_snake_data->local_prediction, local_player);
     }
 
-    if (mp_snake_data.players_alive[1]) {
-        snake_helper_move_snake(&mp_snake_data.player2);
-        snake_helper_wrap_coordinates(&mp_snake_data.player2.head_x,
-            &mp_snake_data.player2.head_y);
+    // The opponent is simulated until its body sync is being shown
+    if (mp_snake_data->players_alive[mp_snake_get_opponent_id() - 1] && !mp_snake_data->opponent_jitter.showing) {
+        snake_helper_move_snake(opponent);
     }
-
-    last_movement_time = current_time;
 }
 
 // Game state utility functions
 MultiplayerPlayerId mp_snake_get_opponent_id(void) {
-    return (mp_snake_data.local_player_id == MP_PLAYER_1) ? MP_PLAYER_2 : MP_PLAYER_1;
+    return (mp_snake_data->local_player_id == MP_PLAYER_1) ? MP_PLAYER_2 : MP_PLAYER_1;
 }
 
 SnakeState* mp_snake_get_local_player_state(void) {
-    return (mp_snake_data.local_player_id == MP_PLAYER_1) ?
-        &mp_snake_data.player1 : &mp_snake_data.player2;
+    return (mp_snake_data->local_player_id == MP_PLAYER_1) ?
+        &mp_snake_data->player1 : &mp_snake_data->player2;
 }
 
 SnakeState* mp_snake_get_opponent_state(void) {
-    return (mp_snake_data.local_player_id == MP_PLAYER_1) ?
-        &mp_snake_data.player2 : &mp_snake_data.player1;
+    return (mp_snake_data->local_player_id == MP_PLAYER_1) ?
+        &mp_snake_data->player2 : &mp_snake_data->player1;
 }
 
 Position* mp_snake_get_food(void) {
-    return &mp_snake_data.server_food;
+    return &mp_snake_data->server_food;
 }
 
 // Get all players for renderer
 SnakeState* mp_snake_get_all_players(uint8_t* player_count) {
     static SnakeState players[2];
 
-    players[0] = mp_snake_data.player1;
-    players[1] = mp_snake_data.player2;
+    players[0] = mp_snake_data->player1;
+    players[1] = mp_snake_data->player2;
 
     if (player_count) {
         *player_count = 2;
@@ -161,7 +159,7 @@ bool mp_snake_can_change_direction(uint8_t new_direction) {
         return false;
     }
 
-    if (!mp_snake_data.players_alive[mp_snake_data.local_player_id - 1]) {
+    if (!mp_snake_data->players_alive[mp_snake_data->local_player_id - 1]) {
         DEBUG_PRINTF(false, "canChangeDirection: Local player is dead\r\n");
         return false;
     }
@@ -170,6 +168,31 @@ bool mp_snake_can_change_direction(uint8_t new_direction) {
     return snake_helper_is_valid_direction_change(local_player->direction, new_direction);
 }
 
+uint16_t mp_snake_apply_local_input(uint8_t direction) {
+    if (!mp_snake_data->players_alive[mp_snake_data->local_player_id - 1]) {
+        return 0;
+    }
+    return mp_prediction_apply_input(&mp_snake_data->local_prediction, mp_snake_get_local_player_state(), direction);
+}
+
+static void mp_snake_reconcile_local_player(const TempServerState* server_state) {
+    bool is_player1 = (mp_snake_data->local_player_id == MP_PLAYER_1);
+    const Position* head = is_player1 ? &server_state->player1_head : &server_state->player2_head;
+    PredictionServerState server = {
+        .tick = server_state->tick,
+        .head_x = head->x,
+        .head_y = head->y,
+        .direction = is_player1 ? server_state->player1_direction : server_state->player2_direction,
+        .length = is_player1 ? server_state->player1_length : server_state->player2_length,
+        .input_ack = is_player1 ? server_state->player1_input_ack : server_state->player2_input_ack
+    };
+
+    if (mp_prediction_reconcile(&mp_snake_data->local_prediction, mp_snake_get_local_player_state(), &server)) {
+        DEBUG_PRINTF(false, "[RECONCILIATION] Local player corrected at tick %lu, %d inputs replayed\r\n",
+            server.tick, mp_prediction_pending_inputs(&mp_snake_data->local_prediction));
+    }
+}
+
 // Reconcile with server
 void mp_snake_reconcile_with_server(const TempServerState* server_state) {
     if (!server_state || !server_state->valid) {
@@ -182,64 +205,64 @@ void mp_snake_reconcile_with_server(const TempServerState* server_state) {
     bool discrepancies_found = false;
 
     // Player 1 reconciliation
-    if (mp_snake_data.player1.length != server_state->player1_length) {
+    if (mp_snake_data->player1.length != server_state->player1_length) {
         DEBUG_PRINTF(false, "[RECONCILIATION] P1 length mismatch: local=%d, server=%d\r\n",
-            mp_snake_data.player1.length, server_state->player1_length);
+            mp_snake_data->player1.length, server_state->player1_length);
         discrepancies_found = true;
     }
 
-    if (mp_snake_data.players_alive[0] != server_state->player1_alive) {
+    if (mp_snake_data->players_alive[0] != server_state->player1_alive) {
         DEBUG_PRINTF(false, "[RECONCILIATION] P1 alive status mismatch: local=%d, server=%d\r\n",
-            mp_snake_data.players_alive[0], server_state->player1_alive);
+            mp_snake_data->players_alive[0], server_state->player1_alive);
         discrepancies_found = true;
 
         // Special handling for death state changes
-        if (mp_snake_data.players_alive[0] && !server_state->player1_alive) {
+        if (mp_snake_data->players_alive[0] && !server_state->player1_alive) {
             DEBUG_PRINTF(false, "[RECONCILIATION] P1 died on server\r\n");
         }
-        else if (!mp_snake_data.players_alive[0] && server_state->player1_alive) {
+        else if (!mp_snake_data->players_alive[0] && server_state->player1_alive) {
             DEBUG_PRINTF(false, "[RECONCILIATION] P1 revived on server (unusual)\r\n");
         }
     }
 
-    if (mp_snake_data.server_scores[0] != server_state->player1_score) {
+    if (mp_snake_data->server_scores[0] != server_state->player1_score) {
         DEBUG_PRINTF(false, "[RECONCILIATION] P1 score mismatch: local=%lu, server=%lu\r\n",
-            mp_snake_data.server_scores[0], server_state->player1_score);
+            mp_snake_data->server_scores[0], server_state->player1_score);
         discrepancies_found = true;
     }
 
     // Player 2 reconciliation
-    if (mp_snake_data.player2.length != server_state->player2_length) {
+    if (mp_snake_data->player2.length != server_state->player2_length) {
         DEBUG_PRINTF(false, "[RECONCILIATION] P2 length mismatch: local=%d, server=%d\r\n",
-            mp_snake_data.player2.length, server_state->player2_length);
+            mp_snake_data->player2.length, server_state->player2_length);
         discrepancies_found = true;
     }
 
-    if (mp_snake_data.players_alive[1] != server_state->player2_alive) {
+    if (mp_snake_data->players_alive[1] != server_state->player2_alive) {
         DEBUG_PRINTF(false, "[RECONCILIATION] P2 alive status mismatch: local=%d, server=%d\r\n",
-            mp_snake_data.players_alive[1], server_state->player2_alive);
+            mp_snake_data->players_alive[1], server_state->player2_alive);
         discrepancies_found = true;
 
         // Special handling for death state changes
-        if (mp_snake_data.players_alive[1] && !server_state->player2_alive) {
+        if (mp_snake_data->players_alive[1] && !server_state->player2_alive) {
             DEBUG_PRINTF(false, "[RECONCILIATION] P2 died on server\r\n");
         }
-        else if (!mp_snake_data.players_alive[1] && server_state->player2_alive) {
+        else if (!mp_snake_data->players_alive[1] && server_state->player2_alive) {
             DEBUG_PRINTF(false, "[RECONCILIATION] P2 revived on server (unusual)\r\n");
         }
     }
 
-    if (mp_snake_data.server_scores[1] != server_state->player2_score) {
+    if (mp_snake_data->server_scores[1] != server_state->player2_score) {
         DEBUG_PRINTF(false, "[RECONCILIATION] P2 score mismatch: local=%lu, server=%lu\r\n",
-            mp_snake_data.server_scores[1], server_state->player2_score);
+            mp_snake_data->server_scores[1], server_state->player2_score);
         discrepancies_found = true;
     }
 
     // Food position reconciliation
-    if (mp_snake_data.server_food.x != server_state->food_position.x ||
-        mp_snake_data.server_food.y != server_state->food_position.y) {
+    if (mp_snake_data->server_food.x != server_state->food_position.x ||
+        mp_snake_data->server_food.y != server_state->food_position.y) {
         DEBUG_PRINTF(false, "[RECONCILIATION] Food position mismatch: local(%d,%d), server(%d,%d)\r\n",
-            mp_snake_data.server_food.x, mp_snake_data.server_food.y,
+            mp_snake_data->server_food.x, mp_snake_data->server_food.y,
             server_state->food_position.x, server_state->food_position.y);
         discrepancies_found = true;
     }
@@ -254,47 +277,71 @@ void mp_snake_reconcile_with_server(const TempServerState* server_state) {
     // Apply server state after reconciliation
     mp_snake_apply_server_state(server_state);
 
+    if (server_state->has_positions) {
+        mp_snake_reconcile_local_player(server_state);
+    }
+
 
     // Update reconciliation timestamp
-    mp_snake_data.last_server_update_time = get_current_ms();
+    mp_snake_data->last_server_update_time = get_current_ms();
+}
+
+void mp_snake_apply_opponent_body(const uart_body_sync_t* body_sync) {
+    if (!body_sync || body_sync->player_id != mp_snake_get_opponent_id()) {
+        return;
+    }
+
+    mp_jitter_push(&mp_snake_data->opponent_jitter, body_sync, get_current_ms());
+}
+
+void mp_snake_update_opponent(void) {
+    if (mp_snake_data->phase != MP_PHASE_PLAYING ||
+        !mp_snake_data->players_alive[mp_snake_get_opponent_id() - 1]) {
+        return;
+    }
+
+    if (mp_jitter_update(&mp_snake_data->opponent_jitter, mp_snake_get_opponent_state(), get_current_ms())) {
+        DEBUG_PRINTF(false, "Core: Opponent at tick %lu, delay %lu ms, jitter %lu ms\r\n",
+            mp_snake_data->opponent_jitter.shown_tick, mp_snake_data->opponent_jitter.delay_ms, mp_jitter_ms(&mp_snake_data->opponent_jitter));
+    }
 }
 
 // Game event handlers (similar to TS event handlers)
 void mp_snake_handle_game_start(void) {
-    mp_snake_data.phase = MP_PHASE_PLAYING;
-    mp_snake_data.opponent_connected = true;
+    mp_snake_data->phase = MP_PHASE_PLAYING;
+    mp_snake_data->opponent_connected = true;
     mp_snake_start_movement_simulation(); // Start local movement simulation
     DEBUG_PRINTF(false, "Core: Multiplayer game started!\r\n");
 }
 
 void mp_snake_handle_game_end(MultiplayerGameResult result) {
-    mp_snake_data.phase = MP_PHASE_ENDED;
-    mp_snake_data.winner = result;
+    mp_snake_data->phase = MP_PHASE_ENDED;
+    mp_snake_data->winner = result;
     mp_snake_stop_movement_simulation(); // Stop movement simulation
     DEBUG_PRINTF(false, "Core: Game ended with result: %d\r\n", result);
 }
 
 void mp_snake_handle_player_collision(MultiplayerPlayerId player_id) {
     if (player_id == MP_PLAYER_1) {
-        mp_snake_data.players_alive[0] = false;
+        mp_snake_data->players_alive[0] = false;
     }
     else if (player_id == MP_PLAYER_2) {
-        mp_snake_data.players_alive[1] = false;
+        mp_snake_data->players_alive[1] = false;
     }
     DEBUG_PRINTF(false, "Core: Player %d collided\r\n", player_id);
 }
 
 void mp_snake_handle_food_eaten(MultiplayerPlayerId player_id) {
     if (player_id == MP_PLAYER_1) {
-        mp_snake_data.server_scores[0]++;
-        mp_snake_data.player1.length++;
+        mp_snake_data->server_scores[0]++;
+        mp_snake_data->player1.length++;
     }
     else if (player_id == MP_PLAYER_2) {
-        mp_snake_data.server_scores[1]++;
-        mp_snake_data.player2.length++;
+        mp_snake_data->server_scores[1]++;
+        mp_snake_data->player2.length++;
     }
     DEBUG_PRINTF(false, "Core: Player %d ate food, new score: %lu\r\n",
-        player_id, mp_snake_data.server_scores[player_id - 1]);
+        player_id, mp_snake_data->server_scores[player_id - 1]);
 }
 
 // Game event parsing (similar to TS handleGameEvent)
@@ -322,18 +369,23 @@ void mp_snake_handle_game_event(const char* event_data) {
             sequence = strtoul(seq_pos + 11, NULL, 10);
         }
 
-        if (sequence <= last_processed_sequence) {
+        // The local player's turns are predicted and come back with the game state
+        if (player == mp_snake_data->local_player_id) {
+            return;
+        }
+
+        if (sequence <= mp_snake_data->last_processed_sequence) {
             DEBUG_PRINTF(false, "Ignoring old sequence %lu (last: %lu)\r\n",
-                sequence, last_processed_sequence);
+                sequence, mp_snake_data->last_processed_sequence);
             return;
         }
-        last_processed_sequence = sequence;
+        mp_snake_data->last_processed_sequence = sequence;
 
         if (player == MP_PLAYER_1) {
-            mp_snake_data.player1.direction = direction;
+            mp_snake_data->player1.direction = direction;
         }
         else if (player == MP_PLAYER_2) {
-            mp_snake_data.player2.direction = direction;
+            mp_snake_data->player2.direction = direction;
         }
 
         DEBUG_PRINTF(false, "Player %d direction changed to %d\r\n", player, direction);
@@ -355,11 +407,11 @@ void mp_snake_handle_game_event(const char* event_data) {
             coord_t server_y = atoi(food_y_pos + 11);
 
             // Convert server coordinates to device coordinates
-            mp_snake_data.server_food.x = mp_snake_server_to_device_coord(server_x);
-            mp_snake_data.server_food.y = mp_snake_server_to_device_coord(server_y);
+            mp_snake_data->server_food.x = mp_snake_server_to_device_coord(server_x);
+            mp_snake_data->server_food.y = mp_snake_server_to_device_coord(server_y);
 
             DEBUG_PRINTF(false, "New food: server(%d,%d) -> device(%d,%d)\r\n",
-                server_x, server_y, mp_snake_data.server_food.x, mp_snake_data.server_food.y);
+                server_x, server_y, mp_snake_data->server_food.x, mp_snake_data->server_food.y);
         }
     }
     else if (strstr(event_data, "\"event\":\"collision\"")) {
@@ -378,11 +430,11 @@ void mp_snake_handle_game_event(const char* event_data) {
 // Game stats (similar to TS getGameStats)
 GameStats mp_snake_get_game_stats(void) {
     GameStats stats = {
-        .p1_score = mp_snake_data.server_scores[0],
-        .p1_lives = mp_snake_data.players_alive[0] ? 1 : 0,
-        .p2_score = mp_snake_data.server_scores[1],
-        .p2_lives = mp_snake_data.players_alive[1] ? 1 : 0,
-        .target_score = mp_snake_data.target_score
+        .p1_score = mp_snake_data->server_scores[0],
+        .p1_lives = mp_snake_data->players_alive[0] ? 1 : 0,
+        .p2_score = mp_snake_data->server_scores[1],
+        .p2_lives = mp_snake_data->players_alive[1] ? 1 : 0,
+        .target_score = mp_snake_data->target_score
     };
     return stats;
 }
@@ -397,22 +449,22 @@ void mp_snake_apply_server_state(const TempServerState* server_state) {
     DEBUG_PRINTF(false, "Core: Applying authoritative server state\r\n");
 
     // Apply player 1 state
-    mp_snake_data.player1.length = server_state->player1_length;
-    mp_snake_data.players_alive[0] = server_state->player1_alive;
-    mp_snake_data.server_scores[0] = server_state->player1_score;
+    mp_snake_data->player1.length = server_state->player1_length;
+    mp_snake_data->players_alive[0] = server_state->player1_alive;
+    mp_snake_data->server_scores[0] = server_state->player1_score;
 
     // Apply player 2 state
-    mp_snake_data.player2.length = server_state->player2_length;
-    mp_snake_data.players_alive[1] = server_state->player2_alive;
-    mp_snake_data.server_scores[1] = server_state->player2_score;
+    mp_snake_data->player2.length = server_state->player2_length;
+    mp_snake_data->players_alive[1] = server_state->player2_alive;
+    mp_snake_data->server_scores[1] = server_state->player2_score;
 
     // Apply food position
-    mp_snake_data.server_food.x = server_state->food_position.x;
-    mp_snake_data.server_food.y = server_state->food_position.y;
+    mp_snake_data->server_food.x = server_state->food_position.x;
+    mp_snake_data->server_food.y = server_state->food_position.y;
 
     DEBUG_PRINTF(false, "Core: Server state applied - P1(len=%d,alive=%d,score=%lu) P2(len=%d,alive=%d,score=%lu)\r\n",
-        mp_snake_data.player1.length, mp_snake_data.players_alive[0], mp_snake_data.server_scores[0],
-        mp_snake_data.player2.length, mp_snake_data.players_alive[1], mp_snake_data.server_scores[1]);
+        mp_snake_data->player1.length, mp_snake_data->players_alive[0], mp_snake_data->server_scores[0],
+        mp_snake_data->player2.length, mp_snake_data->players_alive[1], mp_snake_data->server_scores[1]);
 }
 
 
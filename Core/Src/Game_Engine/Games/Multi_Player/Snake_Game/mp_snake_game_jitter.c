@@ -0,0 +1,190 @@
+/*
+ * mp_snake_game_jitter.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_jitter.h"
+#include "Utils/debug_conf.h"
+#include <stdlib.h>
+
+// Ticks and times wrap, compare them by difference
+static bool is_after(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) > 0;
+}
+
+// Tick whose time has come at now_ms, false before the first one
+static bool due_tick(const JitterBuffer* jitter, uint32_t now_ms, uint32_t* tick) {
+    int32_t elapsed = (int32_t)(now_ms - jitter->transit_ms - jitter->delay_ms);
+
+    if (!jitter->clock_started || elapsed < 0) {
+        return false;
+    }
+    *tick = (uint32_t)elapsed / jitter->tick_ms;
+    return true;
+}
+
+// Follows the link's transit and jitter, and moves the delay a step towards what the jitter needs
+static void update_clock(JitterBuffer* jitter, uint32_t tick, uint32_t now_ms) {
+    uint32_t transit = now_ms - tick * jitter->tick_ms;
+
+    if (!jitter->clock_started) {
+        jitter->transit_ms = transit;
+        jitter->last_transit_ms = transit;
+        jitter->delay_ms = jitter->base_delay_ms;
+        jitter->clock_started = true;
+        return;
+    }
+
+    int32_t change = abs((int32_t)(transit - jitter->last_transit_ms));
+    if (change > MP_JITTER_MAX_DELAY_MS) {
+        change = MP_JITTER_MAX_DELAY_MS;
+    }
+    jitter->last_transit_ms = transit;
+    jitter->jitter_x16 += change - (int32_t)((jitter->jitter_x16 + 8) >> 4);
+    jitter->transit_ms += (int32_t)(transit - jitter->transit_ms) / 16;
+
+    uint32_t wanted = jitter->base_delay_ms + MP_JITTER_DELAY_PER_JITTER * mp_jitter_ms(jitter);
+    if (wanted > MP_JITTER_MAX_DELAY_MS) {
+        wanted = MP_JITTER_MAX_DELAY_MS;
+    }
+    jitter->delay_ms += ((int32_t)wanted - (int32_t)jitter->delay_ms) / 8;
+}
+
+// In tick order after any of the same tick, the oldest is dropped when full
+static void insert(JitterBuffer* jitter, const uart_body_sync_t* snapshot, uint32_t now_ms) {
+    uint8_t index = jitter->count;
+
+    while (index > 0 && is_after(jitter->slots[index - 1].snapshot.tick, snapshot->tick)) {
+        index--;
+    }
+
+    if (jitter->count == MP_JITTER_SLOTS) {
+        jitter->dropped++;
+        if (index == 0) {
+            return;
+        }
+        memmove(&jitter->slots[0], &jitter->slots[1], (MP_JITTER_SLOTS - 1) * sizeof(JitterSnapshot));
+        jitter->count--;
+        index--;
+    }
+
+    memmove(&jitter->slots[index + 1], &jitter->slots[index], (jitter->count - index) * sizeof(JitterSnapshot));
+    jitter->slots[index].arrival_ms = now_ms;
+    jitter->slots[index].snapshot = *snapshot;
+    jitter->count++;
+}
+
+static void copy_snake(SnakeState* to, const SnakeState* from) {
+    to->head_x = from->head_x;
+    to->head_y = from->head_y;
+    to->direction = from->direction;
+    to->length = from->length;
+    memcpy(snake_body_x(to), snake_body_x(from), from->length * sizeof(coord_t));
+    memcpy(snake_body_y(to), snake_body_y(from), from->length * sizeof(coord_t));
+}
+
+// An extrapolated head the server has since passed - its head at that tick is the segment
+// as many ticks back
+static void count_correction(JitterBuffer* jitter, const SnakeState* shown) {
+    uint32_t back = jitter->sync.tick - jitter->shown_tick;
+    coord_t x = jitter->synced.head_x;
+    coord_t y = jitter->synced.head_y;
+
+    if ((int32_t)back < 0 || back > jitter->synced.length) {
+        return;
+    }
+    if (back > 0) {
+        x = snake_body_x(&jitter->synced)[back - 1];
+        y = snake_body_y(&jitter->synced)[back - 1];
+    }
+    if (x != shown->head_x || y != shown->head_y) {
+        jitter->corrections++;
+        DEBUG_PRINTF(false, "Jitter: Extrapolated tick %lu corrected\r\n", jitter->shown_tick);
+    }
+}
+
+void mp_jitter_init(JitterBuffer* jitter, uint32_t tick_ms, uint32_t base_delay_ms) {
+    memset(jitter, 0, sizeof(JitterBuffer));
+    jitter->tick_ms = tick_ms;
+    jitter->base_delay_ms = base_delay_ms;
+    jitter->delay_ms = base_delay_ms;
+    snake_helper_init_snake(&jitter->synced, 0, 0, DPAD_DIR_RIGHT);
+    mp_body_sync_init(&jitter->sync);
+}
+
+void mp_jitter_push(JitterBuffer* jitter, const uart_body_sync_t* body_sync, uint32_t now_ms) {
+    uint32_t due;
+
+    if (jitter->showing && due_tick(jitter, now_ms, &due) && !is_after(body_sync->tick, due)) {
+        jitter->late++;
+    }
+    update_clock(jitter, body_sync->tick, now_ms);
+
+    if (body_sync->kind == BODY_SYNC_KIND_KEYFRAME || body_sync->move_count <= 1) {
+        insert(jitter, body_sync, now_ms);
+        return;
+    }
+
+    // The moves are shown a tick apart, each with the length they end at
+    uart_body_sync_t move = *body_sync;
+    move.move_count = 1;
+    for (uint8_t i = 0; i < body_sync->move_count; i++) {
+        move.tick = body_sync->tick - body_sync->move_count + 1 + i;
+        move.codes[0] = body_sync_code(body_sync->codes, i);
+        insert(jitter, &move, now_ms);
+    }
+}
+
+bool mp_jitter_update(JitterBuffer* jitter, SnakeState* shown, uint32_t now_ms) {
+    uint32_t due;
+    uint8_t applied = 0;
+
+    if (!due_tick(jitter, now_ms, &due)) {
+        return false;
+    }
+
+    // Everything due goes onto the server's body, in tick order
+    while (applied < jitter->count && !is_after(jitter->slots[applied].snapshot.tick, due)) {
+        mp_body_sync_apply(&jitter->sync, &jitter->synced, &jitter->slots[applied].snapshot);
+        applied++;
+    }
+    if (applied > 0) {
+        jitter->count -= applied;
+        memmove(&jitter->slots[0], &jitter->slots[applied], jitter->count * sizeof(JitterSnapshot));
+    }
+
+    bool changed = false;
+
+    // The server's body replaces whatever was shown once it has moved on
+    if (jitter->sync.synced && (!jitter->showing || jitter->sync.tick != jitter->shown_sync_tick)) {
+        if (jitter->showing && jitter->shown_tick != jitter->shown_sync_tick) {
+            count_correction(jitter, shown);
+        }
+        copy_snake(shown, &jitter->synced);
+        jitter->shown_tick = jitter->sync.tick;
+        jitter->shown_sync_tick = jitter->sync.tick;
+        jitter->showing = true;
+        jitter->played++;
+        changed = true;
+    }
+    if (!jitter->showing) {
+        return false;
+    }
+
+    // Ticks with no snapshot yet - keep moving for a few, then wait. A lost delta leaves nothing
+    // to wait for until the next keyframe, so the snake keeps moving like an unsynced one.
+    while (is_after(due, jitter->shown_tick) &&
+        (!jitter->sync.synced || jitter->shown_tick - jitter->shown_sync_tick < MP_JITTER_MAX_EXTRAPOLATION)) {
+        snake_helper_move_snake(shown);
+        jitter->shown_tick++;
+        jitter->extrapolated++;
+        changed = true;
+    }
+    return changed;
+}
+
+uint32_t mp_jitter_ms(const JitterBuffer* jitter) {
+    return jitter->jitter_x16 >> 4;
+}
@@ -6,9 +6,17 @@
  *
  *  Main public interface for multiplayer snake game
  *  Orchestrates core, network, and renderer modules like TypeScript version
+ *  Modified on: Oct 18, 2026
+ *      Movement is no longer stepped from the D-pad update
+ *      Registers for the binary game state message
+ *      Turns the local snake at once and sends the input with its sequence
+ *      Registers for the body sync message
+ *      Brings the opponent to the tick due each frame before rendering
+ *      Game data and render tracking are placed in the game arena for the session
  */
 
 #include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_main.h"
+#include "Game_Engine/game_registry.h"
 #include "Utils/debug_conf.h"
 
  // Internal game state
@@ -46,7 +54,8 @@ GameEngine mp_snake_game_engine = {
     .update_func = {
         .update_dpad = mp_snake_update_dpad_internal
     },
-    .game_data = &mp_snake_data,
+    .game_data = NULL,
+    .game_data_size = sizeof(MultiplayerSnakeGameData),
     .base_state = {
         .state_data = {
                 .multi = {
@@ -64,19 +73,34 @@ GameEngine mp_snake_game_engine = {
     .is_mp_game = true
 };
 
+REGISTER_GAME(mp_snake_game_descriptor) = {
+    .name = "Snake Game",
+    .screen = SCREEN_MP_GAME_SNAKE,
+    .mode = GAME_MODE_MULTIPLAYER,
+    .input = GAME_INPUT_DPAD,
+    .menu_order = 0,
+    .arena_size = GAME_ARENA_BLOCK(sizeof(MultiplayerSnakeGameData)) + GAME_ARENA_BLOCK(sizeof(EntityStore))
+        + GAME_ARENA_BLOCK(sizeof(MpSnakeRenderState)),
+    .engine = &mp_snake_game_engine,
+    .load_assets = snake_helper_load_assets
+};
+
 // Public interface implementation
 void mp_snake_update_dpad(DPAD_STATUS dpad_status) {
-    if (!is_initialized || mp_snake_data.phase != MP_PHASE_PLAYING) return;
-    if (!mp_snake_data.players_alive[mp_snake_data.local_player_id - 1]) return;
-
-    // Just send to server, no local prediction (like TS)
-    if (dpad_status.is_new && mp_snake_can_change_direction(dpad_status.direction)) {
-        mp_snake_send_input_to_server(dpad_status.direction);
-        DEBUG_PRINTF(false, "Input sent to server: direction=%d\r\n", dpad_status.direction);
+    if (!is_initialized || mp_snake_data->phase != MP_PHASE_PLAYING) return;
+    if (!mp_snake_data->players_alive[mp_snake_data->local_player_id - 1]) return;
+
+    // Turn locally now, the server's state confirms or corrects it later
+    if (dpad_status.is_new) {
+        uint16_t sequence = mp_snake_apply_local_input(dpad_status.direction);
+        if (sequence != 0) {
+            mp_snake_send_input_to_server(dpad_status.direction, sequence);
+            DEBUG_PRINTF(false, "Input predicted and sent: direction=%d, sequence=%u\r\n",
+                dpad_status.direction, sequence);
+        }
     }
 
-    // Update movement simulation (like TS moveAllPlayersLocally)
-    mp_snake_move_all_players_locally();
+    // Movement simulation (like TS moveAllPlayersLocally) runs on the game timers
 }
 
 void mp_snake_render(void) {
@@ -85,8 +109,11 @@ void mp_snake_render(void) {
     // Process any pending communication first (like TS version)
     mp_snake_process_communication();
 
+    // The opponent plays out of its jitter buffer at the frame rate, not as messages land
+    mp_snake_update_opponent();
+
     // Gather all data for renderer (like TS render method parameters)
-    MultiplayerGamePhase game_phase = mp_snake_data.phase;
+    MultiplayerGamePhase game_phase = mp_snake_data->phase;
     uint8_t player_count;
     SnakeState* players = mp_snake_get_all_players(&player_count);
     Position* food = mp_snake_get_food();
@@ -108,7 +135,7 @@ void mp_snake_render(void) {
         food,
         &game_stats,
         connection_status,
-        mp_snake_data.local_player_id,
+        mp_snake_data->local_player_id,
         is_spectator
     );
 }
@@ -129,6 +156,16 @@ void mp_snake_cleanup(void) {
         is_initialized = false;
     }
 
+    // Nothing is left to receive game messages once the state goes back with the game arena
+    serial_comm_register_game_data_callback(NULL);
+    serial_comm_register_game_state_callback(NULL);
+    serial_comm_register_body_sync_callback(NULL);
+    serial_comm_register_connection_message_callback(NULL);
+    serial_comm_register_status_callback(NULL);
+    serial_comm_register_command_callback(NULL);
+    mp_snake_data = NULL;
+    game_entities = NULL;
+
     // Reset game engine state
     mp_snake_game_engine.base_state.paused = false;
     mp_snake_game_engine.base_state.game_over = false;
@@ -143,29 +180,29 @@ void mp_snake_process_communication(void) {
 
 // Game state query functions
 MultiplayerGamePhase mp_snake_get_game_phase(void) {
-    return mp_snake_data.phase;
+    return mp_snake_data->phase;
 }
 
 MultiplayerGameResult mp_snake_get_game_result(void) {
-    return mp_snake_data.winner;
+    return mp_snake_data->winner;
 }
 
 uint32_t mp_snake_get_player_score(MultiplayerPlayerId player_id) {
-    if (player_id == MP_PLAYER_1) return mp_snake_data.server_scores[0];
-    if (player_id == MP_PLAYER_2) return mp_snake_data.server_scores[1];
+    if (player_id == MP_PLAYER_1) return mp_snake_data->server_scores[0];
+    if (player_id == MP_PLAYER_2) return mp_snake_data->server_scores[1];
     return 0;
 }
 
 bool mp_snake_is_player_alive(MultiplayerPlayerId player_id) {
-    if (player_id == MP_PLAYER_1) return mp_snake_data.players_alive[0];
-    if (player_id == MP_PLAYER_2) return mp_snake_data.players_alive[1];
+    if (player_id == MP_PLAYER_1) return mp_snake_data->players_alive[0];
+    if (player_id == MP_PLAYER_2) return mp_snake_data->players_alive[1];
     return false;
 }
 
 // Internal game engine functions
 //static void mp_snake_init_game_engine(void) {
 //
-//    DEBUG_PRINTF(false, "Multiplayer snake initializing for Player %d\r\n", mp_snake_data.local_player_id);
+//    DEBUG_PRINTF(false, "Multiplayer snake initializing for Player %d\r\n", mp_snake_data->local_player_id);
 //    // Set game over flag based on tile validation response from server
 //    mp_snake_game_engine.base_state.game_over = serial_comm_get_mp_game_over();
 //
@@ -174,7 +211,7 @@ bool mp_snake_is_player_alive(MultiplayerPlayerId player_id) {
 //    mp_snake_load_local_player_data();
 //
 //    // 2. Initialize core game logic with loaded player ID
-//    mp_snake_core_init(mp_snake_data.local_player_id, mp_snake_data.target_score);
+//    mp_snake_core_init(mp_snake_data->local_player_id, mp_snake_data->target_score);
 //
 //    // 3. Try to load opponent data (may not be available yet)
 //    mp_snake_load_opponent_data();
@@ -199,8 +236,20 @@ static void mp_snake_init_game_engine(void) {
     // Set game over flag based on tile validation response from server
     mp_snake_game_engine.base_state.game_over = serial_comm_get_mp_game_over();
 
+    // game_data was placed in the game arena by the engine, snake bodies and render tracking follow it
+    mp_snake_data = (MultiplayerSnakeGameData*)mp_snake_game_engine.game_data;
+    if (mp_snake_data == NULL || entity_store_create() == NULL || !mp_snake_render_create()) {
+        DEBUG_PRINTF(false, "Not enough arena memory for the session\r\n");
+        mp_snake_data = NULL;
+        mp_snake_game_engine.base_state.game_over = true;
+        return;
+    }
+    mp_snake_data->movement_timer = TIMER_NONE;
+
     // Register network callbacks (serial_comm already initialized by game_controller)
     serial_comm_register_game_data_callback(mp_snake_on_game_data_received);
+    serial_comm_register_game_state_callback(mp_snake_on_game_state_received);
+    serial_comm_register_body_sync_callback(mp_snake_on_body_sync_received);
     serial_comm_register_connection_message_callback(mp_snake_on_connection_received);
     serial_comm_register_status_callback(on_status_received_in_game);
     serial_comm_register_command_callback(on_command_received);
@@ -224,7 +273,7 @@ static void mp_snake_complete_initialization(void) {
     mp_snake_load_local_player_data();
 
     // Initialize core game logic with loaded player ID
-    mp_snake_core_init(mp_snake_data.local_player_id, mp_snake_data.target_score);
+    mp_snake_core_init(mp_snake_data->local_player_id, mp_snake_data->target_score);
 
     // Try to load opponent data (may not be available yet, but that's okay)
     mp_snake_load_opponent_data();
@@ -235,7 +284,7 @@ static void mp_snake_complete_initialization(void) {
     // Initialize rendering function
     mp_snake_render_init();
 
-    DEBUG_PRINTF(false, "Full initialization complete for Player %d\r\n", mp_snake_data.local_player_id);
+    DEBUG_PRINTF(false, "Full initialization complete for Player %d\r\n", mp_snake_data->local_player_id);
 }
 
 // Game over message function implementation
@@ -246,7 +295,7 @@ static void mp_snake_show_game_over_message_internal(void) {
 
     // Determine winner and construct message (similar to render_game_over_screen logic)
     if (game_stats.p1_score > game_stats.p2_score) {
-        if (mp_snake_data.local_player_id == MP_PLAYER_1) {
+        if (mp_snake_data->local_player_id == MP_PLAYER_1) {
             strcpy(result_message, "YOU WIN!");
             final_score = game_stats.p1_score;
         }
@@ -256,7 +305,7 @@ static void mp_snake_show_game_over_message_internal(void) {
         }
     }
     else if (game_stats.p2_score > game_stats.p1_score) {
-        if (mp_snake_data.local_player_id == MP_PLAYER_2) {
+        if (mp_snake_data->local_player_id == MP_PLAYER_2) {
             strcpy(result_message, "YOU WIN!");
             final_score = game_stats.p2_score;
         }
@@ -303,12 +352,12 @@ static void on_status_received_in_game(const uart_status_t* status) {
     	}
     	break;
     case SYSTEM_STATUS_OPPONENT_DISCONNECTED:
-        mp_snake_data.opponent_connected = false;
+        mp_snake_data->opponent_connected = false;
         DEBUG_PRINTF(false, "Opponent disconnected\r\n");
         break;
 
     case SYSTEM_STATUS_WEBSOCKET_CONNECTED:
-        mp_snake_data.connected_to_server = true;
+        mp_snake_data->connected_to_server = true;
         break;
 
     case SYSTEM_STATUS_SESSION_TIMEOUT:
@@ -316,8 +365,8 @@ static void on_status_received_in_game(const uart_status_t* status) {
     case SYSTEM_STATUS_WIFI_DISCONNECTED:
     case SYSTEM_STATUS_ERROR:
         mp_snake_game_engine.base_state.game_over = true;
-        mp_snake_data.connected_to_server = false;
-        mp_snake_data.opponent_connected = false;
+        mp_snake_data->connected_to_server = false;
+        mp_snake_data->opponent_connected = false;
         break;
 
     default:
@@ -343,7 +392,7 @@ static void on_command_received(const uart_command_t* command) {
     }
     else if (strcmp(command->command, "game_restart") == 0) {
         // Reset game state
-        mp_snake_core_init(mp_snake_data.local_player_id, mp_snake_data.target_score);
+        mp_snake_core_init(mp_snake_data->local_player_id, mp_snake_data->target_score);
         mp_snake_game_engine.base_state.game_over = false;
     }
     else {
@@ -356,9 +405,9 @@ static void mp_snake_load_local_player_data(void) {
     int player_id;
     char session_id[32];
     if (serial_comm_get_player_assignment(&player_id, session_id, sizeof(session_id), NULL, NULL, 0)) {
-        mp_snake_data.local_player_id = (MultiplayerPlayerId)player_id;
-        strncpy(mp_snake_data.session_id, session_id, sizeof(mp_snake_data.session_id) - 1);
-        mp_snake_data.session_id[sizeof(mp_snake_data.session_id) - 1] = '\0';
+        mp_snake_data->local_player_id = (MultiplayerPlayerId)player_id;
+        strncpy(mp_snake_data->session_id, session_id, sizeof(mp_snake_data->session_id) - 1);
+        mp_snake_data->session_id[sizeof(mp_snake_data->session_id) - 1] = '\0';
 
         DEBUG_PRINTF(false, "Loaded local player data: ID=%d, Session=%s\r\n", player_id, session_id);
 
@@ -374,8 +423,8 @@ static void mp_snake_load_local_player_data(void) {
 static void mp_snake_load_opponent_data(void) {
     int opponent_id;
     if (serial_comm_get_opponent_data(&opponent_id, NULL, 0, NULL, NULL, 0)) {
-        mp_snake_data.opponent_player_id = (MultiplayerPlayerId)opponent_id;
-        mp_snake_data.opponent_connected = true;
+        mp_snake_data->opponent_player_id = (MultiplayerPlayerId)opponent_id;
+        mp_snake_data->opponent_connected = true;
         DEBUG_PRINTF(false, "Loaded opponent data: ID=%d\r\n", opponent_id);
     }
 }
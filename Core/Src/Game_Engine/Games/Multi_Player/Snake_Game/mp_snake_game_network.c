@@ -3,7 +3,10 @@
  *
  *  Created on: Jun 4, 2025
  *      Author: rohitimandi
- *
+ *  Modified on: Oct 18, 2026
+ *      Player sections are parsed in place in the received message
+ *      Reconciles with the binary game state message, the text format is kept for older servers
+ *      Passes body sync messages on to the core
  *
  *  Network communication and message parsing for multiplayer snake
  *  Similar to TypeScript MultiplayerSnakeNetwork class
@@ -16,6 +19,7 @@ static TempServerState temp_server_state = {0};
 
  // Private function declarations
 static void mp_snake_parse_coordinate_pair(const char* str, coord_t* x, coord_t* y);
+static uint8_t mp_snake_parse_section_value(const char* section, const char* end, const char* key);
 static bool mp_snake_extract_target_score(const char* game_data);
 
 // Utility parsing functions
@@ -34,6 +38,15 @@ static void mp_snake_parse_coordinate_pair(const char* str, coord_t* x, coord_t*
     }
 }
 
+// Value of "key:" between section and end, e.g. "len:" in "p1:len:5,alive:1;"
+static uint8_t mp_snake_parse_section_value(const char* section, const char* end, const char* key) {
+    const char* pos = strstr(section, key);
+
+    if (pos == NULL || pos >= end) {
+        return 0;
+    }
+    return (uint8_t)atoi(pos + strlen(key));
+}
 
 static bool mp_snake_extract_target_score(const char* game_data) {
     if (!game_data) return false;
@@ -63,7 +76,7 @@ static bool mp_snake_extract_target_score(const char* game_data) {
 
     if (i > 0) {
         uint32_t extracted_target_score = (uint32_t)atoi(temp_buffer);
-        mp_snake_data.target_score = extracted_target_score;
+        mp_snake_data->target_score = extracted_target_score;
         DEBUG_PRINTF(false, "Network: Target score extracted and set to: %lu\r\n", extracted_target_score);
         return true;
     }
@@ -73,17 +86,17 @@ static bool mp_snake_extract_target_score(const char* game_data) {
 
 
 // Message sending functions
-void mp_snake_send_input_to_server(uint8_t direction) {
+void mp_snake_send_input_to_server(uint8_t direction, uint16_t sequence) {
     char metadata[32];
     snprintf(metadata, sizeof(metadata), "player:%d,time:%lu",
-        mp_snake_data.local_player_id, get_current_ms());
+        mp_snake_data->local_player_id, get_current_ms());
 
     char game_data[64];
     snprintf(game_data, sizeof(game_data), "direction:%d", direction);
 
-    UART_Status status = serial_comm_send_game_data("player_action", game_data, metadata);
+    UART_Status status = serial_comm_send_game_data_with_sequence("player_action", game_data, metadata, sequence);
     if (status == UART_OK) {
-        DEBUG_PRINTF(false, "Network: Sent input to server: direction=%d\r\n", direction);
+        DEBUG_PRINTF(false, "Network: Sent input to server: direction=%d, sequence=%u\r\n", direction, sequence);
     }
     else {
         DEBUG_PRINTF(false, "Network: Failed to send input to server: %d\r\n", status);
@@ -92,10 +105,10 @@ void mp_snake_send_input_to_server(uint8_t direction) {
 
 void mp_snake_send_player_ready(void) {
     char metadata[32];
-    snprintf(metadata, sizeof(metadata), "player:%d", mp_snake_data.local_player_id);
+    snprintf(metadata, sizeof(metadata), "player:%d", mp_snake_data->local_player_id);
 
     char game_data[64];
-    snprintf(game_data, sizeof(game_data), "target_score:%lu", mp_snake_data.target_score);
+    snprintf(game_data, sizeof(game_data), "target_score:%lu", mp_snake_data->target_score);
 
     UART_Status status = serial_comm_send_game_data("game_event", game_data, metadata);
     if (status == UART_OK) {
@@ -116,23 +129,16 @@ bool mp_snake_parse_player_update(const char* game_data) {
     memset(&temp_server_state, 0, sizeof(TempServerState));
     temp_server_state.valid = false;
 
-    // Parse player 1 data into temporary buffer
+    // Parse player 1 data into temporary buffer, in place up to the end of its section
     const char* p1_data = strstr(game_data, "p1:");
     if (p1_data) {
         const char* p1_end = strstr(p1_data, ";");
         if (p1_end) {
-            char p1_section[64];
-            size_t len = p1_end - p1_data;
-            if (len < sizeof(p1_section)) {
-                strncpy(p1_section, p1_data, len);
-                p1_section[len] = '\0';
-
-                temp_server_state.player1_length = mp_snake_parse_single_value(p1_section, "len");
-                temp_server_state.player1_alive = (mp_snake_parse_single_value(p1_section, "alive") == 1);
-
-                DEBUG_PRINTF(false, "Parsed P1: len=%d, alive=%d\r\n",
-                           temp_server_state.player1_length, temp_server_state.player1_alive);
-            }
+            temp_server_state.player1_length = mp_snake_parse_section_value(p1_data, p1_end, "len:");
+            temp_server_state.player1_alive = (mp_snake_parse_section_value(p1_data, p1_end, "alive:") == 1);
+
+            DEBUG_PRINTF(false, "Parsed P1: len=%d, alive=%d\r\n",
+                       temp_server_state.player1_length, temp_server_state.player1_alive);
         }
     }
 
@@ -141,18 +147,11 @@ bool mp_snake_parse_player_update(const char* game_data) {
     if (p2_data) {
         const char* p2_end = strstr(p2_data, ";");
         if (p2_end) {
-            char p2_section[64];
-            size_t len = p2_end - p2_data;
-            if (len < sizeof(p2_section)) {
-                strncpy(p2_section, p2_data, len);
-                p2_section[len] = '\0';
-
-                temp_server_state.player2_length = mp_snake_parse_single_value(p2_section, "len");
-                temp_server_state.player2_alive = (mp_snake_parse_single_value(p2_section, "alive") == 1);
-
-                DEBUG_PRINTF(false, "Parsed P2: len=%d, alive=%d\r\n",
-                           temp_server_state.player2_length, temp_server_state.player2_alive);
-            }
+            temp_server_state.player2_length = mp_snake_parse_section_value(p2_data, p2_end, "len:");
+            temp_server_state.player2_alive = (mp_snake_parse_section_value(p2_data, p2_end, "alive:") == 1);
+
+            DEBUG_PRINTF(false, "Parsed P2: len=%d, alive=%d\r\n",
+                       temp_server_state.player2_length, temp_server_state.player2_alive);
         }
     }
 
@@ -239,6 +238,51 @@ void mp_snake_on_game_data_received(const uart_game_data_t* game_data) {
     }
 }
 
+// Callback handler for serial_comm game state - the fields are already decoded, nothing to scan
+void mp_snake_on_game_state_received(const uart_game_state_t* game_state) {
+    if (!game_state || game_state->player_count < 2) {
+        DEBUG_PRINTF(false, "Network: Game state without both players\r\n");
+        return;
+    }
+
+    const uart_game_state_player_t* p1 = &game_state->players[0];
+    const uart_game_state_player_t* p2 = &game_state->players[1];
+
+    memset(&temp_server_state, 0, sizeof(TempServerState));
+    temp_server_state.player1_length = p1->length;
+    temp_server_state.player1_alive = p1->alive;
+    temp_server_state.player1_score = p1->score;
+    temp_server_state.player2_length = p2->length;
+    temp_server_state.player2_alive = p2->alive;
+    temp_server_state.player2_score = p2->score;
+    temp_server_state.food_position.x = mp_snake_server_to_device_coord(game_state->food_x);
+    temp_server_state.food_position.y = mp_snake_server_to_device_coord(game_state->food_y);
+    temp_server_state.valid = true;
+
+    temp_server_state.has_positions = true;
+    temp_server_state.tick = game_state->tick;
+    temp_server_state.player1_head.x = mp_snake_server_to_device_coord(p1->head_x);
+    temp_server_state.player1_head.y = mp_snake_server_to_device_coord(p1->head_y);
+    temp_server_state.player2_head.x = mp_snake_server_to_device_coord(p2->head_x);
+    temp_server_state.player2_head.y = mp_snake_server_to_device_coord(p2->head_y);
+    temp_server_state.player1_direction = p1->direction;
+    temp_server_state.player2_direction = p2->direction;
+    temp_server_state.player1_input_ack = p1->input_ack;
+    temp_server_state.player2_input_ack = p2->input_ack;
+
+    DEBUG_PRINTF(false, "Network: Game state tick %lu: P1 len=%d, P2 len=%d, scores %d,%d\r\n",
+        game_state->tick, p1->length, p2->length, p1->score, p2->score);
+
+    mp_snake_reconcile_with_server(&temp_server_state);
+}
+
+void mp_snake_on_body_sync_received(const uart_body_sync_t* body_sync) {
+    if (!body_sync || mp_snake_data->phase != MP_PHASE_PLAYING) {
+        return;
+    }
+    mp_snake_apply_opponent_body(body_sync);
+}
+
 // Callback handler for serial_comm connection_message
 void mp_snake_on_connection_received(const uart_connection_message_t* connection_message) {
 	// Don't really need the connection_message parameter in this function
@@ -248,9 +292,9 @@ void mp_snake_on_connection_received(const uart_connection_message_t* connection
     const char* client_id = serial_comm_get_client_id();
 
     if (client_id && strlen(client_id) > 0) {
-        strncpy(mp_snake_data.local_player_client_id, client_id,
-                sizeof(mp_snake_data.local_player_client_id) - 1);
-        mp_snake_data.local_player_client_id[sizeof(mp_snake_data.local_player_client_id) - 1] = '\0';
+        strncpy(mp_snake_data->local_player_client_id, client_id,
+                sizeof(mp_snake_data->local_player_client_id) - 1);
+        mp_snake_data->local_player_client_id[sizeof(mp_snake_data->local_player_client_id) - 1] = '\0';
 
         DEBUG_PRINTF(false, "Retrieved stored client ID: %s\r\n", client_id);
     } else {
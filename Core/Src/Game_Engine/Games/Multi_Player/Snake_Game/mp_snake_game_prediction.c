@@ -0,0 +1,174 @@
+/*
+ * mp_snake_game_prediction.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ *
+ *  The body of a snake is the heads of its last moves, so the step history is all a rollback
+ *  needs to put the snake back as it was at the server's tick.
+ */
+
+#include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_prediction.h"
+#include "Utils/debug_conf.h"
+
+// The body at the oldest tick in the window has to be rebuilt from the heads before it
+_Static_assert(MP_PREDICTION_HISTORY >= SNAKE_MAX_LENGTH + MP_PREDICTION_WINDOW &&
+    (MP_PREDICTION_HISTORY & (MP_PREDICTION_HISTORY - 1)) == 0,
+    "MP_PREDICTION_HISTORY must be a power of two that holds a body and the window");
+
+static PredictedStep* step_at(SnakePrediction* prediction, uint32_t tick) {
+    return &prediction->steps[tick % MP_PREDICTION_HISTORY];
+}
+
+static void record_step(SnakePrediction* prediction, const SnakeState* snake) {
+    PredictedStep* step = step_at(prediction, prediction->tick);
+
+    step->head_x = snake->head_x;
+    step->head_y = snake->head_y;
+    step->direction = snake->direction;
+}
+
+// Current head at the current tick, the body segments as the heads of the ticks before
+static void seed_history(SnakePrediction* prediction, const SnakeState* snake) {
+    const coord_t* body_x = snake_body_x(snake);
+    const coord_t* body_y = snake_body_y(snake);
+
+    record_step(prediction, snake);
+    for (uint8_t i = 0; i < snake->length && i + 1 < MP_PREDICTION_HISTORY; i++) {
+        PredictedStep* step = step_at(prediction, prediction->tick - 1 - i);
+        step->head_x = body_x[i];
+        step->head_y = body_y[i];
+        step->direction = snake->direction;
+    }
+}
+
+// A turn is checked against the direction of the last move, not against an earlier turn in
+// the same tick, so two quick presses cannot reverse the snake onto itself
+static bool apply_turn(SnakeState* snake, uint8_t moved_direction, uint8_t direction) {
+    if (!snake_helper_is_valid_direction_change(moved_direction, direction)) {
+        return false;
+    }
+    snake->direction = direction;
+    return true;
+}
+
+static PredictedInput* input_at(SnakePrediction* prediction, uint8_t index) {
+    return &prediction->inputs[(prediction->input_first + index) % MP_PREDICTION_INPUTS];
+}
+
+static void drop_acknowledged(SnakePrediction* prediction, uint16_t input_ack) {
+    while (prediction->input_count > 0 &&
+        (int16_t)(input_at(prediction, 0)->sequence - input_ack) <= 0) {
+        prediction->input_first = (prediction->input_first + 1) % MP_PREDICTION_INPUTS;
+        prediction->input_count--;
+    }
+}
+
+void mp_prediction_init(SnakePrediction* prediction, const SnakeState* snake, uint32_t tick) {
+    memset(prediction, 0, sizeof(SnakePrediction));
+    prediction->tick = tick;
+    prediction->next_sequence = 1;
+    seed_history(prediction, snake);
+}
+
+uint16_t mp_prediction_apply_input(SnakePrediction* prediction, SnakeState* snake, uint8_t direction) {
+    if (!apply_turn(snake, step_at(prediction, prediction->tick)->direction, direction)) {
+        return 0;
+    }
+
+    if (prediction->input_count == MP_PREDICTION_INPUTS) {
+        prediction->input_first = (prediction->input_first + 1) % MP_PREDICTION_INPUTS;
+        prediction->input_count--;
+        prediction->inputs_dropped++;
+    }
+
+    PredictedInput* input = input_at(prediction, prediction->input_count++);
+    input->sequence = prediction->next_sequence;
+    input->tick = prediction->tick;
+    input->direction = direction;
+
+    // 0 means no input acknowledged
+    if (++prediction->next_sequence == 0) {
+        prediction->next_sequence = 1;
+    }
+    return input->sequence;
+}
+
+void mp_prediction_step(SnakePrediction* prediction, SnakeState* snake) {
+    snake_helper_move_snake(snake);
+    prediction->tick++;
+    record_step(prediction, snake);
+}
+
+bool mp_prediction_reconcile(SnakePrediction* prediction, SnakeState* snake, const PredictionServerState* server) {
+    drop_acknowledged(prediction, server->input_ack);
+    snake->length = (server->length < SNAKE_MAX_LENGTH) ? server->length : SNAKE_MAX_LENGTH - 1;
+
+    // Ahead of us, or so far behind its step is gone - nothing to compare with
+    if (server->tick > prediction->tick || prediction->tick - server->tick >= MP_PREDICTION_WINDOW) {
+        DEBUG_PRINTF(false, "Prediction: Server tick %lu, local %lu - taking server state\r\n",
+            server->tick, prediction->tick);
+
+        snake->head_x = server->head_x;
+        snake->head_y = server->head_y;
+        snake->direction = server->direction;
+        prediction->tick = server->tick;
+        seed_history(prediction, snake);
+        for (uint8_t i = 0; i < prediction->input_count; i++) {
+            input_at(prediction, i)->tick = prediction->tick;
+            apply_turn(snake, server->direction, input_at(prediction, i)->direction);
+        }
+        prediction->snaps++;
+        return true;
+    }
+
+    const PredictedStep* predicted = step_at(prediction, server->tick);
+    if (predicted->head_x == server->head_x && predicted->head_y == server->head_y &&
+        predicted->direction == server->direction) {
+        return false;
+    }
+
+    DEBUG_PRINTF(false, "Prediction: Tick %lu predicted (%d,%d) dir %d, server (%d,%d) dir %d\r\n",
+        server->tick, predicted->head_x, predicted->head_y, predicted->direction,
+        server->head_x, server->head_y, server->direction);
+
+    // Rewind - the body at the server's tick is the heads before it
+    coord_t* body_x = snake_body_x(snake);
+    coord_t* body_y = snake_body_y(snake);
+    for (uint8_t i = 0; i < snake->length; i++) {
+        const PredictedStep* step = step_at(prediction, server->tick - 1 - i);
+        body_x[i] = step->head_x;
+        body_y[i] = step->head_y;
+    }
+    snake->head_x = server->head_x;
+    snake->head_y = server->head_y;
+    snake->direction = server->direction;
+
+    uint32_t now = prediction->tick;
+    prediction->tick = server->tick;
+    record_step(prediction, snake);
+
+    // Replay what the server has not seen, each input before the move it turned. Inputs older
+    // than the server's tick are still on their way to it and turn the first move.
+    uint8_t next_input = 0;
+    while (true) {
+        uint8_t moved_direction = snake->direction;
+        while (next_input < prediction->input_count &&
+            input_at(prediction, next_input)->tick <= prediction->tick) {
+            apply_turn(snake, moved_direction, input_at(prediction, next_input)->direction);
+            next_input++;
+        }
+        if (prediction->tick == now) {
+            break;
+        }
+        mp_prediction_step(prediction, snake);
+        prediction->replayed_ticks++;
+    }
+
+    prediction->rollbacks++;
+    return true;
+}
+
+uint8_t mp_prediction_pending_inputs(const SnakePrediction* prediction) {
+    return prediction->input_count;
+}
@@ -4,6 +4,8 @@
  *  Created on: Jun 4, 2025
  *      Author: rohitimandi
  *  Rendering and UI functions for multiplayer snake
+ *  Modified on: Oct 18, 2026
+ *      Render tracking lives in the game arena for the session
  */
 
 #include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_render.h"
@@ -15,15 +17,8 @@
 #include <string.h>
 #include <stdio.h>
 
- // Rendering optimization tracking (similar to TS private properties)
-static coord_t previous_local_head_x = 0, previous_local_head_y = 0;
-static coord_t previous_opponent_head_x = 0, previous_opponent_head_y = 0;
-static coord_t previous_food_x = 0, previous_food_y = 0;
-static uint8_t previous_local_length = 0;
-static uint8_t previous_opponent_length = 0;
-static uint32_t previous_local_score = 0;
-static uint32_t previous_opponent_score = 0;
-static bool first_render = true;
+ // Rendering optimization tracking, taken from the game arena with the rest of the session
+static MpSnakeRenderState* render_state = NULL;
 
 // Private function prototypes (similar to TS private methods)
 static void render_waiting_screen(ProtocolState connection_status, uint8_t local_player_id);
@@ -39,14 +34,26 @@ static void render_multiplayer_ui(uint8_t local_player_id);
 static void clear_previous_positions(SnakeState* players, uint8_t player_count, Position* food);
 static void reset_render_tracking(SnakeState* players, uint8_t player_count, Position* food);
 
+bool mp_snake_render_create(void) {
+    render_state = (MpSnakeRenderState*)game_arena_alloc(sizeof(MpSnakeRenderState));
+    if (render_state == NULL) {
+        return false;
+    }
+
+    // The waiting screen is drawn before the game is fully initialised
+    render_state->first_render = true;
+    return true;
+}
+
 // Rendering initialization and cleanup (similar to TS constructor/destructor)
 void mp_snake_render_init(void) {
-    first_render = true;
+    render_state->first_render = true;
     DEBUG_PRINTF(false, "Render: Multiplayer snake rendering initialized\r\n");
 }
 
 void mp_snake_render_cleanup(void) {
-    first_render = true;
+    // The render tracking goes back with the game arena
+    render_state = NULL;
     DEBUG_PRINTF(false, "Render: Multiplayer snake rendering cleanup completed\r\n");
 }
 
@@ -77,12 +84,12 @@ void mp_snake_render_game(
 
 // Phase-specific rendering functions (similar to TS screen rendering methods)
 static void render_waiting_screen(ProtocolState connection_status, uint8_t local_player_id) {
-	if (first_render || serial_comm_needs_ui_update()) {
+	if (render_state->first_render || serial_comm_needs_ui_update()) {
 		display_manager_clear_main_area();
 		if (serial_comm_needs_ui_update()) {
 			serial_comm_clear_ui_update_flag();
 		}
-		first_render = false;
+		render_state->first_render = false;
 	}
 
 
@@ -146,10 +153,10 @@ static void render_gameplay(SnakeState* players, uint8_t player_count, Position*
 }
 
 static void render_game_area(SnakeState* players, uint8_t player_count, Position* food, GameStats* game_stats, uint8_t local_player_id) {
-    if (first_render) {
+    if (render_state->first_render) {
         display_draw_border_at(1, STATUS_START_Y, 3, 3);
         reset_render_tracking(players, player_count, food);
-        first_render = false;
+        render_state->first_render = false;
     }
 
     // Clear previous positions (like TS dirty rectangle optimization)
@@ -220,91 +227,79 @@ static void render_multiplayer_ui(uint8_t local_player_id) {
 }
 
 
+// True if any body segment of any snake sits at (x, y)
+static bool is_on_any_body(const SnakeState* players, uint8_t player_count, coord_t x, coord_t y) {
+    for (uint8_t p = 0; p < player_count; p++) {
+        const coord_t* body_x = snake_body_x(&players[p]);
+        const coord_t* body_y = snake_body_y(&players[p]);
+        for (uint8_t i = 0; i < players[p].length; i++) {
+            if (x == body_x[i] && y == body_y[i]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 // Optimization functions (like TS rendering optimization)
 static void clear_previous_positions(SnakeState* players, uint8_t player_count, Position* food) {
     // Optimized dirty rectangle clearing for multiplayer (like TS optimization)
 
     // Clear previous player 1 head if it moved
     if (player_count > 0 &&
-        (previous_local_head_x != players[0].head_x || previous_local_head_y != players[0].head_y)) {
+        (render_state->previous_local_head_x != players[0].head_x || render_state->previous_local_head_y != players[0].head_y)) {
 
         // Check if previous position is not occupied by any snake
-        bool is_occupied = false;
-
-        for (uint8_t p = 0; p < player_count; p++) {
-            for (uint8_t i = 0; i < players[p].length; i++) {
-                if (previous_local_head_x == players[p].body[i].x &&
-                    previous_local_head_y == players[p].body[i].y) {
-                    is_occupied = true;
-                    break;
-                }
-            }
-            if (is_occupied) break;
-        }
-
-        if (!is_occupied) {
-            display_clear_region(previous_local_head_x, previous_local_head_y, SPRITE_SIZE, SPRITE_SIZE);
+        if (!is_on_any_body(players, player_count, render_state->previous_local_head_x, render_state->previous_local_head_y)) {
+            display_clear_region(render_state->previous_local_head_x, render_state->previous_local_head_y, SPRITE_SIZE, SPRITE_SIZE);
         }
     }
 
     // Clear previous player 2 head if it moved
     if (player_count > 1 &&
-        (previous_opponent_head_x != players[1].head_x || previous_opponent_head_y != players[1].head_y)) {
+        (render_state->previous_opponent_head_x != players[1].head_x || render_state->previous_opponent_head_y != players[1].head_y)) {
 
         // Check if previous position is not occupied by any snake
-        bool is_occupied = false;
-
-        for (uint8_t p = 0; p < player_count; p++) {
-            for (uint8_t i = 0; i < players[p].length; i++) {
-                if (previous_opponent_head_x == players[p].body[i].x &&
-                    previous_opponent_head_y == players[p].body[i].y) {
-                    is_occupied = true;
-                    break;
-                }
-            }
-            if (is_occupied) break;
-        }
-
-        if (!is_occupied) {
-            display_clear_region(previous_opponent_head_x, previous_opponent_head_y, SPRITE_SIZE, SPRITE_SIZE);
+        if (!is_on_any_body(players, player_count, render_state->previous_opponent_head_x, render_state->previous_opponent_head_y)) {
+            display_clear_region(render_state->previous_opponent_head_x, render_state->previous_opponent_head_y, SPRITE_SIZE, SPRITE_SIZE);
         }
     }
 
     // Clear previous food position if changed
-    if (previous_food_x != food->x || previous_food_y != food->y) {
-        if (previous_food_x != 0 && previous_food_y != 0) {
-            display_clear_region(previous_food_x, previous_food_y, SPRITE_SIZE, SPRITE_SIZE);
+    if (render_state->previous_food_x != food->x || render_state->previous_food_y != food->y) {
+        if (render_state->previous_food_x != 0 && render_state->previous_food_y != 0) {
+            display_clear_region(render_state->previous_food_x, render_state->previous_food_y, SPRITE_SIZE, SPRITE_SIZE);
         }
     }
 
     // Update previous positions for next frame
     if (player_count > 0) {
-        previous_local_head_x = players[0].head_x;
-        previous_local_head_y = players[0].head_y;
-        previous_local_length = players[0].length;
+        render_state->previous_local_head_x = players[0].head_x;
+        render_state->previous_local_head_y = players[0].head_y;
+        render_state->previous_local_length = players[0].length;
     }
     if (player_count > 1) {
-        previous_opponent_head_x = players[1].head_x;
-        previous_opponent_head_y = players[1].head_y;
-        previous_opponent_length = players[1].length;
+        render_state->previous_opponent_head_x = players[1].head_x;
+        render_state->previous_opponent_head_y = players[1].head_y;
+        render_state->previous_opponent_length = players[1].length;
     }
-    previous_food_x = food->x;
-    previous_food_y = food->y;
+    render_state->previous_food_x = food->x;
+    render_state->previous_food_y = food->y;
 }
 
 static void reset_render_tracking(SnakeState* players, uint8_t player_count, Position* food) {
     if (player_count > 0) {
-        previous_local_head_x = players[0].head_x;
-        previous_local_head_y = players[0].head_y;
-        previous_local_length = players[0].length;
+        render_state->previous_local_head_x = players[0].head_x;
+        render_state->previous_local_head_y = players[0].head_y;
+        render_state->previous_local_length = players[0].length;
     }
     if (player_count > 1) {
-        previous_opponent_head_x = players[1].head_x;
-        previous_opponent_head_y = players[1].head_y;
-        previous_opponent_length = players[1].length;
+        render_state->previous_opponent_head_x = players[1].head_x;
+        render_state->previous_opponent_head_y = players[1].head_y;
+        render_state->previous_opponent_length = players[1].length;
     }
-    previous_food_x = food->x;
-    previous_food_y = food->y;
-    previous_local_score = 0;
-    previous_opponent_score = 0;
+    render_state->previous_food_x = food->x;
+    render_state->previous_food_y = food->y;
+    render_state->previous_local_score = 0;
+    render_state->previous_opponent_score = 0;
 }
@@ -3,30 +3,52 @@
  *
  *  Created on: Jun 3, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Turns come from the input event queue, one per movement step
+ *      Movement, the head animation and the border redraw run on engine timers
+ *      Sessions are saved and resumed through a save descriptor
+ *      Turns mark the head's tile for the input latency probe
  */
 
 #include <stdlib.h>
 #include "Game_Engine/Games/Single_Player/snake_game.h"
+#include "Game_Engine/game_registry.h"
 #include "Utils/debug_conf.h"
 #include "Utils/misc_utils.h"
-
-static uint32_t last_move_time = 0;
-
-// For dirty rectangle optimization - use separate coordinates instead of Position struct
-static coord_t previous_head_x = 0, previous_head_y = 0;
-static coord_t previous_tail_x = 0, previous_tail_y = 0;
-static coord_t previous_food_x = 0, previous_food_y = 0;
-static uint8_t previous_length = 0;
-static uint32_t previous_score = 0;
-static uint8_t previous_lives = 0;
-static bool first_render = true;
+#include "Utils/latency_probe.h"
+
+// Periodic on the engine wheel, its period follows the score
+static timer_id_t step_timer = TIMER_NONE;
+static uint16_t step_period = 0;
+
+// For dirty rectangle optimization - use separate coordinates instead of Position struct.
+// Taken from the game arena with the rest of the session.
+typedef struct {
+    coord_t previous_head_x, previous_head_y;
+    coord_t previous_tail_x, previous_tail_y;
+    coord_t previous_food_x, previous_food_y;
+    uint8_t previous_length;
+    uint32_t previous_score;
+    uint8_t previous_lives;
+    bool first_render;
+    bool border_redraw_due;     // Set by the border timer, handled on the next render
+} SnakeRenderState;
+
+static SnakeRenderState* render_state = NULL;
 
 // Forward declarations of game engine functions
 static void snake_init(void);
+static void snake_start_round(void);
 static void snake_update_dpad(DPAD_STATUS dpad_status);
+static void snake_on_input_event(const InputEvent* event);
 static void snake_render(void);
 static void snake_cleanup(void);
 static void snake_show_game_over_message(void);
+static void snake_on_restore(void);
+
+// Timer callbacks
+static void snake_step(void* context);
+static void request_border_redraw(void* context);
 
 // Forward declarations pf rendering functions
 static void render_status_area(bool force_redraw);
@@ -36,20 +58,6 @@ static void clear_previous_tail_position(SnakeGameData* data);
 static void clear_previous_food_position(SnakeGameData* data);
 static void draw_snake_and_food(SnakeGameData* data);
 
-SnakeGameData snake_data = {
-    .snake = {
-        .head_x = 0,
-        .head_y = 0,
-        .direction = DPAD_DIR_RIGHT,
-        .length = DEFAULT_LIVES,
-        .body = {{0}}
-    },
-    .food = {
-        .x = 0,
-        .y = 0
-    }
-};
-
 // Initialize the snake game engine instance
 GameEngine snake_game_engine = {
     .init = snake_init,
@@ -59,7 +67,9 @@ GameEngine snake_game_engine = {
         .update_dpad = snake_update_dpad
     },
     .show_game_over_message = snake_show_game_over_message,
-    .game_data = &snake_data,
+    .on_input_event = snake_on_input_event,
+    .game_data = NULL,
+    .game_data_size = sizeof(SnakeGameData),
     .base_state = {
         .state_data = {
             .single = {
@@ -75,33 +85,112 @@ GameEngine snake_game_engine = {
     .is_mp_game = false,
 };
 
+// The step timer lives outside the arena, everything else is saved with it
+static const GameSaveRegion snake_save_regions[] = {
+    { &step_timer, sizeof(step_timer) },
+    { &step_period, sizeof(step_period) }
+};
+
+static const GameSaveDescriptor snake_save = {
+    .version = 1,
+    .regions = snake_save_regions,
+    .region_count = sizeof(snake_save_regions) / sizeof(snake_save_regions[0]),
+    .on_restore = snake_on_restore
+};
+
+REGISTER_GAME(snake_game_descriptor) = {
+    .name = "Snake Game",
+    .screen = SCREEN_GAME_SNAKE,
+    .mode = GAME_MODE_SINGLE_PLAYER,
+    .input = GAME_INPUT_DPAD,
+    .menu_order = 0,
+    .arena_size = GAME_ARENA_BLOCK(sizeof(SnakeGameData)) + GAME_ARENA_BLOCK(sizeof(SnakeRenderState))
+        + GAME_ARENA_BLOCK(sizeof(EntityStore)),
+    .engine = &snake_game_engine,
+    .load_assets = snake_helper_load_assets,
+    .save = &snake_save
+};
+
 static void snake_init(void) {
+    // game_data was placed in the game arena by the engine, body segments and render tracking follow it
+    if (snake_game_engine.game_data == NULL || entity_store_create() == NULL) {
+        DEBUG_PRINTF(false, "Snake: Not enough arena memory for the session\r\n");
+        snake_game_engine.base_state.game_over = true;
+        return;
+    }
+
+    // Allocated last, so a non-NULL render state means the whole session is in place
+    render_state = (SnakeRenderState*)game_arena_alloc(sizeof(SnakeRenderState));
+    if (render_state == NULL) {
+        snake_game_engine.base_state.game_over = true;
+        return;
+    }
+
+    step_period = snake_helper_calculate_speed(0);
+    step_timer = timer_start(&game_timers, step_period, step_period, snake_step, NULL);
+    timer_start(&game_timers, SNAKE_BORDER_REDRAW_MS, SNAKE_BORDER_REDRAW_MS, request_border_redraw, NULL);
+    animated_sprite_start(&snake_head_animated, &game_timers);
+
+    snake_start_round();
+}
+
+// Resumed from a save-state, the screen is drawn from scratch
+static void snake_on_restore(void) {
+    if (render_state != NULL) {
+        render_state->first_render = true;
+    }
+}
+
+// Place the snake and food - also used to restart after a lost life
+static void snake_start_round(void) {
     SnakeGameData* data = (SnakeGameData*)snake_game_engine.game_data;
 
+    // Body segments live in the shared entity store
+    entity_store_reset(game_entities);
     snake_helper_init_snake(&data->snake, DISPLAY_WIDTH / 2, DISPLAY_HEIGHT / 2, DPAD_DIR_RIGHT);
+    turn_buffer_reset(&data->turns, DPAD_DIR_RIGHT);
 
     // Initialize food position
     data->food.x = 16;
     data->food.y = 16;
 
     // Reset dirty rectangle tracking
-    first_render = true;
-    previous_head_x = data->snake.head_x;
-    previous_head_y = data->snake.head_y;
-    previous_tail_x = data->snake.body[0].x;
-    previous_tail_y = data->snake.body[0].y;
-    previous_food_x = data->food.x;
-    previous_food_y = data->food.y;
-    previous_length = data->snake.length;
-    previous_score = 0;
-    previous_lives = DEFAULT_LIVES;
-
-    last_move_time = get_current_ms();
+    render_state->first_render = true;
+    render_state->previous_head_x = data->snake.head_x;
+    render_state->previous_head_y = data->snake.head_y;
+    render_state->previous_tail_x = snake_body_x(&data->snake)[0];
+    render_state->previous_tail_y = snake_body_y(&data->snake)[0];
+    render_state->previous_food_x = data->food.x;
+    render_state->previous_food_y = data->food.y;
+    render_state->previous_length = data->snake.length;
+    render_state->previous_score = 0;
+    render_state->previous_lives = DEFAULT_LIVES;
+    render_state->border_redraw_due = false;
+
+    // A full step before the snake moves
+    timer_restart(&game_timers, step_timer, step_period);
+}
+
+static void snake_on_input_event(const InputEvent* event) {
+    SnakeGameData* data = (SnakeGameData*)snake_game_engine.game_data;
+    if (event->source == INPUT_SOURCE_DPAD) {
+        turn_buffer_push(&data->turns, event->state);
+        // The turn shows as the next head, drawn next to the current one
+        latency_probe_mark(data->snake.head_x, data->snake.head_y, SPRITE_SIZE);
+    }
 }
 
 static void handle_direction_change(SnakeGameData* data, DPAD_STATUS dpad_status) {
-    if (!dpad_status.is_new) return;
-    snake_helper_apply_direction_change(&data->snake, dpad_status.direction);
+    // The latest state covers callers that do not go through the event queue
+    if (dpad_status.is_new) {
+        turn_buffer_push(&data->turns, dpad_status.direction);
+    }
+
+    uint8_t turn = turn_buffer_take(&data->turns, data->snake.direction,
+        snake_helper_is_valid_direction_change);
+    if (turn != 0) {
+        snake_helper_apply_direction_change(&data->snake, turn);
+    }
 }
 
 static void handle_food_collision(SnakeGameData* data) {
@@ -131,45 +220,62 @@ static void handle_collision(SnakeGameData* data) {
                     DISPLAY_HEIGHT - BORDER_OFFSET,
                     DISPLAY_BLACK
                 );
-                snake_init();
+                snake_start_round();
             }
         }
     }
 }
 
+// Step timer callback - the snake moves one tile
+static void snake_step(void* context) {
+    (void)context;
+    SnakeGameData* data = (SnakeGameData*)snake_game_engine.game_data;
+
+    // The last life can go on a step earlier in the same advance
+    if (snake_game_engine.base_state.game_over) {
+        return;
+    }
+
+    // Store previous positions for rendering optimization
+    render_state->previous_head_x = data->snake.head_x;
+    render_state->previous_head_y = data->snake.head_y;
+    if (data->snake.length > 0) {
+        render_state->previous_tail_x = snake_body_x(&data->snake)[data->snake.length - 1];
+        render_state->previous_tail_y = snake_body_y(&data->snake)[data->snake.length - 1];
+    }
+
+    snake_helper_move_snake(&data->snake);
+    turn_buffer_step(&data->turns);
+
+    handle_food_collision(data);
+    handle_collision(data);
+}
+
+static void request_border_redraw(void* context) {
+    (void)context;
+    render_state->border_redraw_due = true;
+}
+
+// Movement runs on the step timer after this, see snake_step()
 static void snake_update_dpad(DPAD_STATUS dpad_status) {
     SnakeGameData* data = (SnakeGameData*)snake_game_engine.game_data;
-    uint32_t current_time = get_current_ms();
 
     handle_direction_change(data, dpad_status);
 
-    // Use helper function to calculate snake speed
+    // Use helper function to calculate snake speed, the step timer follows it
     uint16_t current_speed = snake_helper_calculate_speed(snake_game_engine.base_state.state_data.single.score);
-    if (current_time - last_move_time >= current_speed) {
-        // Store previous positions for rendering optimization
-        previous_head_x = data->snake.head_x;
-        previous_head_y = data->snake.head_y;
-        if (data->snake.length > 0) {
-            previous_tail_x = data->snake.body[data->snake.length - 1].x;
-            previous_tail_y = data->snake.body[data->snake.length - 1].y;
-        }
-
-        snake_helper_move_snake(&data->snake);
-
-        handle_food_collision(data);
-        handle_collision(data);
-        last_move_time = current_time;
+    if (current_speed != step_period) {
+        step_period = current_speed;
+        timer_set_period(&game_timers, step_timer, step_period);
     }
-
-    animated_sprite_update(&snake_head_animated);
 }
 
 // Function to render the score and lives in the status area
 static void render_status_area(bool force_redraw) {
     // Check if there's a reason to redraw
     if (!force_redraw &&
-        previous_score == snake_game_engine.base_state.state_data.single.score &&
-        previous_lives == snake_game_engine.base_state.state_data.single.lives) {
+        render_state->previous_score == snake_game_engine.base_state.state_data.single.score &&
+        render_state->previous_lives == snake_game_engine.base_state.state_data.single.lives) {
         return;
     }
 
@@ -189,8 +295,8 @@ static void render_status_area(bool force_redraw) {
 #endif
 
     // Update previous values
-    previous_score = snake_game_engine.base_state.state_data.single.score;
-    previous_lives = snake_game_engine.base_state.state_data.single.lives;
+    render_state->previous_score = snake_game_engine.base_state.state_data.single.score;
+    render_state->previous_lives = snake_game_engine.base_state.state_data.single.lives;
 }
 
 // Function to clear a region and redraw border if needed
@@ -212,14 +318,16 @@ static void clear_and_redraw_border_if_needed(coord_t x, coord_t y) {
 
 // Function to clear previous head position
 static void clear_previous_head_position(SnakeGameData* data) {
-    if (previous_head_x == data->snake.head_x && previous_head_y == data->snake.head_y) {
+    if (render_state->previous_head_x == data->snake.head_x && render_state->previous_head_y == data->snake.head_y) {
         return; // Head didn't move
     }
 
     // Only clear if not occupied by a body segment
+    const coord_t* body_x = snake_body_x(&data->snake);
+    const coord_t* body_y = snake_body_y(&data->snake);
     bool is_occupied = false;
     for (uint8_t i = 0; i < data->snake.length; i++) {
-        if (previous_head_x == data->snake.body[i].x && previous_head_y == data->snake.body[i].y) {
+        if (render_state->previous_head_x == body_x[i] && render_state->previous_head_y == body_y[i]) {
             is_occupied = true;
             break;
         }
@@ -227,15 +335,15 @@ static void clear_previous_head_position(SnakeGameData* data) {
 
     if (!is_occupied) {
         // Check if we can safely clear with buffer
-        if (previous_head_x > BORDER_OFFSET &&
-            previous_head_x < DISPLAY_WIDTH - BORDER_OFFSET - SPRITE_SIZE &&
-            previous_head_y > GAME_AREA_TOP &&
-            previous_head_y < DISPLAY_HEIGHT - BORDER_OFFSET - SPRITE_SIZE) {
-            display_clear_region(previous_head_x, previous_head_y, SPRITE_SIZE, SPRITE_SIZE);
+        if (render_state->previous_head_x > BORDER_OFFSET &&
+            render_state->previous_head_x < DISPLAY_WIDTH - BORDER_OFFSET - SPRITE_SIZE &&
+            render_state->previous_head_y > GAME_AREA_TOP &&
+            render_state->previous_head_y < DISPLAY_HEIGHT - BORDER_OFFSET - SPRITE_SIZE) {
+            display_clear_region(render_state->previous_head_x, render_state->previous_head_y, SPRITE_SIZE, SPRITE_SIZE);
         }
         else {
             // Near border - clear and redraw border
-            clear_and_redraw_border_if_needed(previous_head_x, previous_head_y);
+            clear_and_redraw_border_if_needed(render_state->previous_head_x, render_state->previous_head_y);
         }
     }
 }
@@ -243,18 +351,20 @@ static void clear_previous_head_position(SnakeGameData* data) {
 // Function to clear previous tail position
 static void clear_previous_tail_position(SnakeGameData* data) {
     // Only needed when snake didn't grow
-    if (previous_length != data->snake.length || (previous_tail_x == 0 && previous_tail_y == 0)) {
+    if (render_state->previous_length != data->snake.length || (render_state->previous_tail_x == 0 && render_state->previous_tail_y == 0)) {
         return;
     }
 
     // Check if previous tail position is part of current snake
     bool is_part_of_snake = false;
-    if (previous_tail_x == data->snake.head_x && previous_tail_y == data->snake.head_y) {
+    if (render_state->previous_tail_x == data->snake.head_x && render_state->previous_tail_y == data->snake.head_y) {
         is_part_of_snake = true;
     }
     else {
+        const coord_t* body_x = snake_body_x(&data->snake);
+        const coord_t* body_y = snake_body_y(&data->snake);
         for (uint8_t i = 0; i < data->snake.length; i++) {
-            if (previous_tail_x == data->snake.body[i].x && previous_tail_y == data->snake.body[i].y) {
+            if (render_state->previous_tail_x == body_x[i] && render_state->previous_tail_y == body_y[i]) {
                 is_part_of_snake = true;
                 break;
             }
@@ -263,33 +373,33 @@ static void clear_previous_tail_position(SnakeGameData* data) {
 
     if (!is_part_of_snake) {
         // Check if we can safely clear with buffer
-        if (previous_tail_x > BORDER_OFFSET + 1 &&
-            previous_tail_x < DISPLAY_WIDTH - BORDER_OFFSET - SPRITE_SIZE - 1 &&
-            previous_tail_y > GAME_AREA_TOP + 1 &&
-            previous_tail_y < DISPLAY_HEIGHT - BORDER_OFFSET - SPRITE_SIZE - 1) {
+        if (render_state->previous_tail_x > BORDER_OFFSET + 1 &&
+            render_state->previous_tail_x < DISPLAY_WIDTH - BORDER_OFFSET - SPRITE_SIZE - 1 &&
+            render_state->previous_tail_y > GAME_AREA_TOP + 1 &&
+            render_state->previous_tail_y < DISPLAY_HEIGHT - BORDER_OFFSET - SPRITE_SIZE - 1) {
             // Safe to clear with buffer
             display_clear_region(
-                previous_tail_x - 1,
-                previous_tail_y - 1,
+                render_state->previous_tail_x - 1,
+                render_state->previous_tail_y - 1,
                 SPRITE_SIZE + 2,
                 SPRITE_SIZE + 2
             );
         }
         else {
             // Near border - clear and redraw border
-            clear_and_redraw_border_if_needed(previous_tail_x, previous_tail_y);
+            clear_and_redraw_border_if_needed(render_state->previous_tail_x, render_state->previous_tail_y);
         }
     }
 }
 
 // Function to clear previous food position
 static void clear_previous_food_position(SnakeGameData* data) {
-    if ((previous_food_x == data->food.x && previous_food_y == data->food.y) ||
-        previous_food_x == 0 || previous_food_y == 0) {
+    if ((render_state->previous_food_x == data->food.x && render_state->previous_food_y == data->food.y) ||
+        render_state->previous_food_x == 0 || render_state->previous_food_y == 0) {
         return; // Food didn't move or is not initialized
     }
 
-    clear_and_redraw_border_if_needed(previous_food_x, previous_food_y);
+    clear_and_redraw_border_if_needed(render_state->previous_food_x, render_state->previous_food_y);
 }
 
 // Function to draw the snake and food using helper functions
@@ -298,25 +408,30 @@ static void draw_snake_and_food(SnakeGameData* data) {
     snake_helper_draw_food(&data->food);
 
     // Periodically redraw border to ensure it's intact
-    if (get_current_ms() % 500 == 0) {
+    if (render_state->border_redraw_due) {
         display_draw_border_at(1, STATUS_START_Y, 3, 3);
+        render_state->border_redraw_due = false;
     }
 }
 
 static void snake_render(void) {
     SnakeGameData* data = (SnakeGameData*)snake_game_engine.game_data;
 
+    if (render_state == NULL) {
+        return;  // Session didn't start
+    }
+
     // Initialize display on first render
-    if (first_render) {
+    if (render_state->first_render) {
         // Draw border
         display_draw_border_at(1, STATUS_START_Y, 3, 3);
         //        render_status_area(true);
-        first_render = false;
+        render_state->first_render = false;
     }
 
     // Update status area if score or lives changed
-    bool status_changed = (previous_score != snake_game_engine.base_state.state_data.single.score) ||
-        (previous_lives != snake_game_engine.base_state.state_data.single.lives);
+    bool status_changed = (render_state->previous_score != snake_game_engine.base_state.state_data.single.score) ||
+        (render_state->previous_lives != snake_game_engine.base_state.state_data.single.lives);
     if (status_changed) {
         //        render_status_area(true);
     }
@@ -330,7 +445,7 @@ static void snake_render(void) {
     draw_snake_and_food(data);
 
     // Update tracking for next frame
-    previous_length = data->snake.length;
+    render_state->previous_length = data->snake.length;
 }
 
 static void snake_show_game_over_message(void) {
@@ -343,31 +458,17 @@ static void snake_show_game_over_message(void) {
 }
 
 static void snake_cleanup(void) {
-    // Reset game state using helper structure
-    memset(&snake_data.snake, 0, sizeof(SnakeState));
-    snake_data.snake.direction = DPAD_DIR_RIGHT;
-    snake_data.snake.length = 1;
+    // Game data, body segments and render tracking go back with the arena
+    render_state = NULL;
+    game_entities = NULL;
 
-    memset(&snake_data.food, 0, sizeof(Position));
-
-    // Reset timing
-    last_move_time = 0;
+    // The engine drops the timers after cleanup
+    step_timer = TIMER_NONE;
+    step_period = 0;
 
     // Reset game engine state
     snake_game_engine.base_state.state_data.single.score = 0;
     snake_game_engine.base_state.state_data.single.lives = DEFAULT_LIVES;
     snake_game_engine.base_state.paused = false;
     snake_game_engine.base_state.game_over = false;
-
-    // Reset dirty rectangle tracking
-    first_render = true;
-    previous_head_x = 0;
-    previous_head_y = 0;
-    previous_tail_x = 0;
-    previous_tail_y = 0;
-    previous_food_x = 0;
-    previous_food_y = 0;
-    previous_length = 0;
-    previous_score = 0;
-    previous_lives = 0;
 }
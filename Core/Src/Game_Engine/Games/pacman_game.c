@@ -5,58 +5,75 @@
  *      Author: rohitimandi
  *  Modified on: Apr 17, 2025
  *      Added dirty rectangle optimization
+ *  Modified on: Oct 18, 2026
+ *      Positions are in world coordinates, the maze scrolls in a viewport
+ *      Pacman and the ghosts are kept in the SoA entity store
+ *      Ghost collisions go through the engine collision world, dots are looked up in the maze tiles
+ *      Movement, the power pellet, animations and redraws run on engine timers
+ *      Ghost targets are drawn from the session's random stream
+ *      Sessions are saved and resumed through a save descriptor
+ *      Turns mark Pacman's tile for the input latency probe
  */
 
 #include "Game_Engine/Games/pacman_game.h"
+#include "Game_Engine/game_registry.h"
 #include "Utils/misc_utils.h"
+#include "Utils/debug_conf.h"
+#include "Utils/latency_probe.h"
 #include <stdlib.h>
 #include <limits.h>
 
-static uint32_t last_move_time = 0;
+static bool pacman_caught = false;   // Set by the collision callback, handled after the pass
 
 // For dirty rectangle optimization
-static Position previous_pacman_pos = { 0, 0 };
-static Position previous_ghost_pos[NUM_GHOSTS] = { {{0}} };
-static bool maze_drawn = false;
-static uint32_t previous_score = 0;
-static uint8_t previous_lives = 0;
-static bool first_render = true;
-static uint32_t last_border_redraw_time = 0;
-
-// Initial game data
-static PacmanGameData pacman_data = {
-    .pacman_pos = {0, 0},
-    .curr_dir = DIR_RIGHT,
-    .next_dir = DIR_RIGHT,
-    .ghosts = {{{0}}},    // Triple braces for nested struct
-    .dots = {{{0}}},      // Triple braces for nested struct
-    .ghost_mode_timer = 0,
-    .ghost_mode_duration = 0,
-    .num_dots_remaining = 0,
-    .power_pellet_active = false
-};
+typedef struct {
+    Position previous_pacman_pos;
+    Position previous_ghost_pos[NUM_GHOSTS];
+    bool maze_drawn;
+    uint32_t previous_score;
+    uint8_t previous_lives;
+    bool first_render;
+    bool maze_refresh_due;      // Set by the timers, handled on the next render
+    bool border_redraw_due;
+} PacmanRenderState;
+
+// Both live in the game arena for the length of a session
+static PacmanGameData* pacman_data = NULL;
+static PacmanRenderState* render_state = NULL;
+
+static RotatedSprite pacman_rotations;   // Built on the first launch, kept across sessions
 
 // Forward declarations
 static void pacman_init(void);
+static void pacman_start_round(void);
 static void pacman_update_dpad(DPAD_STATUS dpad_status);
 static void pacman_render(void);
 static void pacman_cleanup(void);
+static void pacman_load_assets(void);
+static void pacman_on_restore(void);
 static void init_dots(void);
 static void init_ghosts(void);
 static void update_ghosts(void);
 static bool check_wall_collision(Position pos);
-static void handle_dot_collision(void);
-static void handle_ghost_collision(void);
+static void on_pacman_collision(entity_id_t a, entity_id_t b);
+static void eat_dot(int tile_x, int tile_y);
+static void touch_ghost(entity_id_t id);
+static void lose_life(void);
 static void move_pacman(void);
-static Position get_ghost_target(Ghost* ghost);
-static Direction get_next_direction(Ghost* ghost);
+static Position get_ghost_target(uint8_t index);
+static Direction get_next_direction(uint8_t index);
+
+// Timer callbacks
+static void pacman_step(void* context);
+static void end_frightened(void* context);
+static void request_maze_refresh(void* context);
+static void request_border_redraw(void* context);
 
 // New functions for dirty rectangle optimization
 static void render_status_area(bool force_redraw);
-static void clear_and_redraw_border_if_needed(coord_t x, coord_t y);
+static void clear_and_redraw_border_if_needed(Position world_pos);
 static void clear_previous_positions(void);
 static void draw_game_elements(void);
-static void draw_dots_and_pellets(void);
 static void redraw_full_maze_if_needed(void);
 
 // Game engine instance
@@ -67,7 +84,8 @@ GameEngine pacman_game_engine = {
     },
     .render = pacman_render,
     .cleanup = pacman_cleanup,
-    .game_data = &pacman_data,
+    .game_data = NULL,
+    .game_data_size = sizeof(PacmanGameData),
     .base_state = {
         .state_data = {
             .single = {
@@ -82,9 +100,38 @@ GameEngine pacman_game_engine = {
     .is_mp_game = false
 };
 
+// The whole session is in the arena
+static const GameSaveDescriptor pacman_save = {
+    .version = 2,      // Dots moved from the entity store into the maze tiles
+    .on_restore = pacman_on_restore
+};
+
+REGISTER_GAME(pacman_game_descriptor) = {
+    .name = "Pacman Game",
+    .screen = SCREEN_GAME_PACMAN,
+    .mode = GAME_MODE_SINGLE_PLAYER,
+    .input = GAME_INPUT_DPAD,
+    .menu_order = 1,
+    .arena_size = GAME_ARENA_BLOCK(sizeof(PacmanGameData)) + GAME_ARENA_BLOCK(sizeof(PacmanRenderState))
+        + GAME_ARENA_BLOCK(sizeof(EntityStore)) + GAME_ARENA_BLOCK(sizeof(CollisionWorld))
+        + GAME_ARENA_BLOCK(sizeof(MazeState)),
+    .engine = &pacman_game_engine,
+    .load_assets = pacman_load_assets,
+    .save = &pacman_save
+};
+
+// Entity id of a ghost
+static inline entity_id_t ghost_id(uint8_t index) {
+    return pacman_data->pacman + 1 + index;
+}
+
+static inline Position pacman_position(void) {
+    return entity_get_position(game_entities, pacman_data->pacman);
+}
+
 static bool check_wall_collision(Position pos) {
-    // Just pass through the screen coordinates to is_wall
-    return is_wall(pos.x, pos.y);
+    // Positions are in world coordinates
+    return is_wall_world(pos.x, pos.y);
 }
 
 static Position get_next_position(Position current, Direction dir) {
@@ -97,42 +144,40 @@ static Position get_next_position(Position current, Direction dir) {
     case DIR_NONE:  break;
     }
 
-    // Add border constraints
-    // Keep within horizontal bounds
-    if (next.x < BORDER_OFFSET) {
-        next.x = BORDER_OFFSET;
+    // Keep within the maze - open rows wrap around horizontally (tunnel)
+    if (dir == DIR_LEFT && current.x < TILE_SIZE) {
+        next.x = maze_to_world_x(MAZE_WIDTH - 1);
     }
-    else if (next.x > DISPLAY_WIDTH - BORDER_OFFSET - TILE_SIZE) {
-        next.x = DISPLAY_WIDTH - BORDER_OFFSET - TILE_SIZE;
+    else if (next.x > maze_to_world_x(MAZE_WIDTH - 1)) {
+        next.x = 0;
     }
 
-    // Keep within vertical bounds
-    if (next.y < GAME_AREA_TOP) {
-        next.y = GAME_AREA_TOP;
+    if (dir == DIR_UP && current.y < TILE_SIZE) {
+        next.y = 0;
     }
-    else if (next.y > DISPLAY_HEIGHT - BORDER_OFFSET - TILE_SIZE) {
-        next.y = DISPLAY_HEIGHT - BORDER_OFFSET - TILE_SIZE;
+    else if (next.y > maze_to_world_y(MAZE_HEIGHT_ACTUAL - 1)) {
+        next.y = maze_to_world_y(MAZE_HEIGHT_ACTUAL - 1);
     }
     return next;
 }
 
+// Velocity for one step in a direction. Steps that get_next_position() wraps or clamps
+// are written back after the move pass.
+static void set_step_velocity(entity_id_t id, Direction dir) {
+    game_entities->vel_x[id] = (dir == DIR_RIGHT) ? TILE_SIZE : (dir == DIR_LEFT) ? -TILE_SIZE : 0;
+    game_entities->vel_y[id] = (dir == DIR_DOWN) ? TILE_SIZE : (dir == DIR_UP) ? -TILE_SIZE : 0;
+}
+
+// Dots live in the maze tiles, Pacman eats the one on its tile in O(1)
 static void init_dots(void) {
-    pacman_data.num_dots_remaining = 0;
+    pacman_data->num_dots_remaining = 0;
 
-    // Place dots according to maze layout
+    maze_reset_tiles();
     for (uint8_t y = 0; y < MAZE_HEIGHT_ACTUAL; y++) {
         for (uint8_t x = 0; x < MAZE_WIDTH; x++) {
-            if (MAZE_LAYOUT[y][x] == MAZE_DOT || MAZE_LAYOUT[y][x] == MAZE_POWER) {
-                Position pos = {
-                    .x = maze_to_screen_x(x),
-                    .y = maze_to_screen_y(y)
-                };
-
-                pacman_data.dots[pacman_data.num_dots_remaining].pos = pos;
-                pacman_data.dots[pacman_data.num_dots_remaining].active = true;
-                pacman_data.dots[pacman_data.num_dots_remaining].is_power_pellet =
-                    (MAZE_LAYOUT[y][x] == MAZE_POWER);
-                pacman_data.num_dots_remaining++;
+            uint8_t tile = maze_get_tile(x, y);
+            if (tile == MAZE_DOT || tile == MAZE_POWER) {
+                pacman_data->num_dots_remaining++;
             }
         }
     }
@@ -140,76 +185,135 @@ static void init_dots(void) {
 
 static void init_ghosts(void) {
     const Position ghost_starts[NUM_GHOSTS] = {
-           {maze_to_screen_x(1), maze_to_screen_y(1)},    // Blinky - top left
-           {maze_to_screen_x(MAZE_WIDTH - 2), maze_to_screen_y(1)},   // Pinky - top right
-           {maze_to_screen_x(1), maze_to_screen_y(MAZE_HEIGHT_ACTUAL - 2)},    // Inky - bottom left
-           {maze_to_screen_x(MAZE_WIDTH - 2), maze_to_screen_y(MAZE_HEIGHT_ACTUAL - 2)}    // Clyde - bottom right
+           {maze_to_world_x(1), maze_to_world_y(1)},    // Blinky - top left
+           {maze_to_world_x(MAZE_WIDTH - 2), maze_to_world_y(1)},   // Pinky - top right
+           {maze_to_world_x(1), maze_to_world_y(MAZE_HEIGHT_ACTUAL - 2)},    // Inky - bottom left
+           {maze_to_world_x(MAZE_WIDTH - 2), maze_to_world_y(MAZE_HEIGHT_ACTUAL - 2)}    // Clyde - bottom right
     };
 
     for (uint8_t i = 0; i < NUM_GHOSTS; i++) {
-        pacman_data.ghosts[i].pos = ghost_starts[i];
-        previous_ghost_pos[i] = ghost_starts[i];
-        pacman_data.ghosts[i].dir = DIR_RIGHT;
-        pacman_data.ghosts[i].type = (GhostType)i;
-        pacman_data.ghosts[i].mode = MODE_CHASE;
-        pacman_data.ghosts[i].active = true;
-        pacman_data.ghosts[i].target = ghost_starts[i]; // Initial target is start position
+        entity_id_t id = ghost_id(i);
+        entity_set_position(game_entities, id, ghost_starts[i]);
+        game_entities->sprite_id[id] = PACMAN_SPRITE_BLINKY + i;
+        game_entities->flags[id] = PACMAN_FLAG_GHOST;
+        collision_set_tile(game_collisions, id, PACMAN_FLAG_GHOST, 0);
+        render_state->previous_ghost_pos[i] = ghost_starts[i];
+        pacman_data->ghosts[i].dir = DIR_RIGHT;
+        pacman_data->ghosts[i].type = (GhostType)i;
+        pacman_data->ghosts[i].mode = MODE_CHASE;
+        pacman_data->ghosts[i].target = ghost_starts[i]; // Initial target is start position
     }
 }
 
 static void pacman_init(void) {
-    // Start Pacman at index 8 (an open path '0') in row 1
-    pacman_data.pacman_pos.x = maze_to_screen_x(6);
-    pacman_data.pacman_pos.y = maze_to_screen_y(1); // Second row
-    previous_pacman_pos = pacman_data.pacman_pos;
+    // game_data was placed in the game arena by the engine, the rest of the session follows it
+    pacman_data = (PacmanGameData*)pacman_game_engine.game_data;
+    if (pacman_data == NULL || entity_store_create() == NULL ||
+        collision_world_create(TILE_SIZE, on_pacman_collision) == NULL || !maze_create()) {
+        DEBUG_PRINTF(false, "Pacman: Not enough arena memory for the session\r\n");
+        pacman_game_engine.base_state.game_over = true;
+        return;
+    }
 
-    pacman_data.curr_dir = DIR_RIGHT;
-    pacman_data.next_dir = DIR_RIGHT;
+    // Allocated last, so a non-NULL render state means the whole session is in place
+    render_state = (PacmanRenderState*)game_arena_alloc(sizeof(PacmanRenderState));
+    if (render_state == NULL) {
+        pacman_game_engine.base_state.game_over = true;
+        return;
+    }
+
+    // The engine wheel holds these while the game is paused and drops them on cleanup
+    pacman_data->step_timer = timer_start(&game_timers, PACMAN_SPEED, PACMAN_SPEED, pacman_step, NULL);
+    pacman_data->frightened_timer = TIMER_NONE;
+    timer_start(&game_timers, PACMAN_MAZE_REFRESH_MS, PACMAN_MAZE_REFRESH_MS, request_maze_refresh, NULL);
+    timer_start(&game_timers, PACMAN_BORDER_REDRAW_MS, PACMAN_BORDER_REDRAW_MS, request_border_redraw, NULL);
+
+    animated_sprite_start(&pacman_animated, &game_timers);
+    animated_sprite_start(&scared_ghost_animated, &game_timers);
+    animated_sprite_start(&blinky_animated, &game_timers);
+    animated_sprite_start(&pinky_animated, &game_timers);
+    animated_sprite_start(&inky_animated, &game_timers);
+    animated_sprite_start(&clyde_animated, &game_timers);
+
+    pacman_start_round();
+}
+
+// Place Pacman, ghosts and dots - also used to restart after a lost life
+static void pacman_start_round(void) {
+    // Pacman and the ghosts are one contiguous block
+    entity_store_reset(game_entities);
+    pacman_data->pacman = entity_create_block(game_entities, 1 + NUM_GHOSTS);
+
+    // Start Pacman on an open path
+    game_entities->pos_x[pacman_data->pacman] = maze_to_world_x(PACMAN_START_X);
+    game_entities->pos_y[pacman_data->pacman] = maze_to_world_y(PACMAN_START_Y);
+    game_entities->sprite_id[pacman_data->pacman] = PACMAN_SPRITE_PLAYER;
+    game_entities->flags[pacman_data->pacman] = PACMAN_FLAG_PLAYER;
+    render_state->previous_pacman_pos = pacman_position();
+
+    // Everything sits on a tile, so tile colliders match what the player sees.
+    // Only Pacman asks about collisions, ghosts are just filed in the grid.
+    collision_world_reset(game_collisions, TILE_SIZE, on_pacman_collision);
+    collision_set_tile(game_collisions, pacman_data->pacman, PACMAN_FLAG_PLAYER, PACMAN_FLAG_GHOST);
+    pacman_caught = false;
+
+    pacman_data->curr_dir = DIR_RIGHT;
+    pacman_data->next_dir = DIR_RIGHT;
 
     init_dots();
     init_ghosts();
 
-    last_move_time = get_current_ms();
-    pacman_data.ghost_mode_timer = last_move_time;
-    pacman_data.ghost_mode_duration = GHOST_SCATTER_TIME;
-    pacman_data.power_pellet_active = false;
+    // Start with the camera on Pacman
+    maze_viewport_init();
+    viewport_follow(maze_get_viewport(), render_state->previous_pacman_pos.x, render_state->previous_pacman_pos.y,
+        TILE_SIZE, TILE_SIZE);
+
+    // A full step before anything moves, and no power pellet carried over
+    timer_restart(&game_timers, pacman_data->step_timer, PACMAN_SPEED);
+    timer_cancel(&game_timers, pacman_data->frightened_timer);
+    pacman_data->frightened_timer = TIMER_NONE;
+    pacman_data->ghost_mode_duration = GHOST_SCATTER_TIME;
+    pacman_data->power_pellet_active = false;
 
     // Reset dirty rectangle tracking
-    first_render = true;
-    maze_drawn = false;
-    previous_score = 0;
-    previous_lives = 3;
-    last_border_redraw_time = 0;
+    render_state->first_render = true;
+    render_state->maze_drawn = false;
+    render_state->previous_score = 0;
+    render_state->previous_lives = 3;
+    render_state->maze_refresh_due = false;
+    render_state->border_redraw_due = false;
 }
 
-static Position get_ghost_target(Ghost* ghost) {
-    Position target = pacman_data.pacman_pos; // Default target
+static Position get_ghost_target(uint8_t index) {
+    Ghost* ghost = &pacman_data->ghosts[index];
+    Position pacman_pos = pacman_position();
+    Position target = pacman_pos; // Default target
 
     switch (ghost->mode) {
     case MODE_FRIGHTENED:
         // Random target when frightened
-        target.x = maze_to_screen_x(get_random() % MAZE_WIDTH);
-        target.y = maze_to_screen_y(get_random() % MAZE_HEIGHT_ACTUAL);
+        target.x = maze_to_world_x(game_random_below(&game_random, MAZE_WIDTH));
+        target.y = maze_to_world_y(game_random_below(&game_random, MAZE_HEIGHT_ACTUAL));
         break;
 
     case MODE_SCATTER:
         // Return to home corner
         switch (ghost->type) {
         case GHOST_BLINKY:
-            target.x = maze_to_screen_x(1);
-            target.y = maze_to_screen_y(1);
+            target.x = maze_to_world_x(1);
+            target.y = maze_to_world_y(1);
             break;
         case GHOST_PINKY:
-            target.x = maze_to_screen_x(MAZE_WIDTH - 2);
-            target.y = maze_to_screen_y(1);
+            target.x = maze_to_world_x(MAZE_WIDTH - 2);
+            target.y = maze_to_world_y(1);
             break;
         case GHOST_INKY:
-            target.x = maze_to_screen_x(1);
-            target.y = maze_to_screen_y(MAZE_HEIGHT_ACTUAL - 2);
+            target.x = maze_to_world_x(1);
+            target.y = maze_to_world_y(MAZE_HEIGHT_ACTUAL - 2);
             break;
         case GHOST_CLYDE:
-            target.x = maze_to_screen_x(MAZE_WIDTH - 2);
-            target.y = maze_to_screen_y(MAZE_HEIGHT_ACTUAL - 2);
+            target.x = maze_to_world_x(MAZE_WIDTH - 2);
+            target.y = maze_to_world_y(MAZE_HEIGHT_ACTUAL - 2);
             break;
         }
         break;
@@ -218,14 +322,14 @@ static Position get_ghost_target(Ghost* ghost) {
         switch (ghost->type) {
         case GHOST_BLINKY:
             // Directly target Pacman
-            target = pacman_data.pacman_pos;
+            target = pacman_pos;
             break;
 
         case GHOST_PINKY: {
             // Target 4 tiles ahead of Pacman
-            target = pacman_data.pacman_pos;
+            target = pacman_pos;
             for (int i = 0; i < 4; i++) {
-                Position next = get_next_position(target, pacman_data.curr_dir);
+                Position next = get_next_position(target, pacman_data->curr_dir);
                 if (!check_wall_collision(next)) {
                     target = next;
                 }
@@ -235,9 +339,9 @@ static Position get_ghost_target(Ghost* ghost) {
 
         case GHOST_INKY: {
             // Target based on Blinky's position
-            Position blinky_pos = pacman_data.ghosts[GHOST_BLINKY].pos;
-            int dx = pacman_data.pacman_pos.x - blinky_pos.x;
-            int dy = pacman_data.pacman_pos.y - blinky_pos.y;
+            Position blinky_pos = entity_get_position(game_entities, ghost_id(GHOST_BLINKY));
+            int dx = pacman_pos.x - blinky_pos.x;
+            int dy = pacman_pos.y - blinky_pos.y;
             target.x = blinky_pos.x + dx * 2;
             target.y = blinky_pos.y + dy * 2;
             break;
@@ -245,12 +349,12 @@ static Position get_ghost_target(Ghost* ghost) {
 
         case GHOST_CLYDE:
             // Random behavior or chase based on distance
-            if (get_random() % 2) {
-                target = pacman_data.pacman_pos;
+            if (game_random_below(&game_random, 2)) {
+                target = pacman_pos;
             }
             else {
-                target.x = maze_to_screen_x(get_random() % MAZE_WIDTH);
-                target.y = maze_to_screen_y(get_random() % MAZE_HEIGHT_ACTUAL);
+                target.x = maze_to_world_x(game_random_below(&game_random, MAZE_WIDTH));
+                target.y = maze_to_world_y(game_random_below(&game_random, MAZE_HEIGHT_ACTUAL));
             }
             break;
         }
@@ -259,7 +363,9 @@ static Position get_ghost_target(Ghost* ghost) {
     return target;
 }
 
-static Direction get_next_direction(Ghost* ghost) {
+static Direction get_next_direction(uint8_t index) {
+    Ghost* ghost = &pacman_data->ghosts[index];
+    Position ghost_pos = entity_get_position(game_entities, ghost_id(index));
     Direction possible_dirs[4] = { DIR_UP, DIR_RIGHT, DIR_DOWN, DIR_LEFT };
     Direction best_dir = ghost->dir;
     int min_distance = INT_MAX;
@@ -269,7 +375,7 @@ static Direction get_next_direction(Ghost* ghost) {
         // Don't reverse direction unless necessary
         if (possible_dirs[i] == (ghost->dir + 2) % 4) continue;
 
-        Position next_pos = get_next_position(ghost->pos, possible_dirs[i]);
+        Position next_pos = get_next_position(ghost_pos, possible_dirs[i]);
         if (!check_wall_collision(next_pos)) {
             // Calculate distance to target
             int dx = next_pos.x - ghost->target.x;
@@ -286,169 +392,215 @@ static Direction get_next_direction(Ghost* ghost) {
     return best_dir;
 }
 
+// Sets Pacman's step velocity, the move itself happens in move_entities()
 static void move_pacman(void) {
+    Position pacman_pos = pacman_position();
+
     // Store previous position for dirty rectangle optimization
-    previous_pacman_pos = pacman_data.pacman_pos;
+    render_state->previous_pacman_pos = pacman_pos;
+    set_step_velocity(pacman_data->pacman, DIR_NONE);
 
-    Position next_pos = get_next_position(pacman_data.pacman_pos, pacman_data.next_dir);
+    Position next_pos = get_next_position(pacman_pos, pacman_data->next_dir);
 
     if (!check_wall_collision(next_pos)) {
-        pacman_data.pacman_pos = next_pos;
-        pacman_data.curr_dir = pacman_data.next_dir;
+        set_step_velocity(pacman_data->pacman, pacman_data->next_dir);
+        pacman_data->curr_dir = pacman_data->next_dir;
     }
     else {
-        next_pos = get_next_position(pacman_data.pacman_pos, pacman_data.curr_dir);
+        next_pos = get_next_position(pacman_pos, pacman_data->curr_dir);
         if (!check_wall_collision(next_pos)) {
-            pacman_data.pacman_pos = next_pos;
+            set_step_velocity(pacman_data->pacman, pacman_data->curr_dir);
         }
     }
 }
 
-static void update_ghosts(void) {
-    uint32_t current_time = get_current_ms();
+// One pass over the mover block, then apply the same wrap and clamp as get_next_position()
+// to the few that left the maze
+static void move_entities(void) {
+    coord_t max_x = maze_to_world_x(MAZE_WIDTH - 1);
+    coord_t max_y = maze_to_world_y(MAZE_HEIGHT_ACTUAL - 1);
 
-    // Update ghost mode if timer expired
-    if (current_time - pacman_data.ghost_mode_timer >= pacman_data.ghost_mode_duration) {
-        for (uint8_t i = 0; i < NUM_GHOSTS; i++) {
-            if (pacman_data.ghosts[i].mode == MODE_FRIGHTENED) {
-                pacman_data.ghosts[i].mode = MODE_CHASE;
-            }
+    entity_move_range(game_entities, pacman_data->pacman, 1 + NUM_GHOSTS);
+
+    for (entity_id_t id = pacman_data->pacman; id <= ghost_id(NUM_GHOSTS - 1); id++) {
+        if (game_entities->pos_x[id] > max_x) {
+            game_entities->pos_x[id] = (game_entities->vel_x[id] < 0) ? max_x : 0;
+        }
+        if (game_entities->pos_y[id] > max_y) {
+            game_entities->pos_y[id] = (game_entities->vel_y[id] < 0) ? 0 : max_y;
+        }
+    }
+}
+
+// Frightened timer callback - the power pellet wore off
+static void end_frightened(void* context) {
+    (void)context;
+
+    for (uint8_t i = 0; i < NUM_GHOSTS; i++) {
+        if (pacman_data->ghosts[i].mode == MODE_FRIGHTENED) {
+            pacman_data->ghosts[i].mode = MODE_CHASE;
         }
-        pacman_data.power_pellet_active = false;
     }
+    pacman_data->power_pellet_active = false;
+    pacman_data->frightened_timer = TIMER_NONE;
+}
 
+static void update_ghosts(void) {
     // Update each ghost
     for (uint8_t i = 0; i < NUM_GHOSTS; i++) {
-        Ghost* ghost = &pacman_data.ghosts[i];
-        if (!ghost->active) continue;
+        Ghost* ghost = &pacman_data->ghosts[i];
+        entity_id_t id = ghost_id(i);
+        set_step_velocity(id, DIR_NONE);
+        if (!entity_is_active(game_entities, id)) continue;
 
         // Store previous position for dirty rectangle optimization
-        previous_ghost_pos[i] = ghost->pos;
+        render_state->previous_ghost_pos[i] = entity_get_position(game_entities, id);
 
         // Update target
-        ghost->target = get_ghost_target(ghost);
+        ghost->target = get_ghost_target(i);
 
         // Get new direction
-        ghost->dir = get_next_direction(ghost);
+        ghost->dir = get_next_direction(i);
 
-        // Move ghost
-        Position next_pos = get_next_position(ghost->pos, ghost->dir);
+        // Step the ghost if the way is open
+        Position next_pos = get_next_position(render_state->previous_ghost_pos[i], ghost->dir);
         if (!check_wall_collision(next_pos)) {
-            ghost->pos = next_pos;
+            set_step_velocity(id, ghost->dir);
         }
     }
 }
 
-static void handle_dot_collision(void) {
-    for (uint8_t i = 0; i < MAX_DOTS; i++) {
-        if (!pacman_data.dots[i].active) continue;
-
-        Position dot_pos = pacman_data.dots[i].pos;
-        if (abs(pacman_data.pacman_pos.x - dot_pos.x) < TILE_SIZE / 2 &&
-            abs(pacman_data.pacman_pos.y - dot_pos.y) < TILE_SIZE / 2) {
+static void eat_dot(int tile_x, int tile_y) {
+    uint8_t tile = maze_get_tile(tile_x, tile_y);
+    if (tile != MAZE_DOT && tile != MAZE_POWER) {
+        return;
+    }
+    bool is_power_pellet = (tile == MAZE_POWER);
 
-            pacman_data.dots[i].active = false;
-            pacman_data.num_dots_remaining--;
+    // Keep the eaten dot from coming back when its tile is repainted
+    maze_clear_tile(tile_x, tile_y);
+    pacman_data->num_dots_remaining--;
 
-            if (pacman_data.dots[i].is_power_pellet) {
-                // Activate power pellet mode
-                pacman_data.power_pellet_active = true;
-                pacman_data.ghost_mode_timer = get_current_ms();
-                pacman_game_engine.base_state.state_data.single.score += 50;
+    if (is_power_pellet) {
+        // Activate power pellet mode
+        pacman_data->power_pellet_active = true;
+        timer_cancel(&game_timers, pacman_data->frightened_timer);
+        pacman_data->frightened_timer = timer_start(&game_timers, pacman_data->ghost_mode_duration, 0,
+            end_frightened, NULL);
+        pacman_game_engine.base_state.state_data.single.score += 50;
 
-                for (uint8_t j = 0; j < NUM_GHOSTS; j++) {
-                    pacman_data.ghosts[j].mode = MODE_FRIGHTENED;
-                }
-            }
-            else {
-                pacman_game_engine.base_state.state_data.single.score += 10;
-            }
+        for (uint8_t j = 0; j < NUM_GHOSTS; j++) {
+            pacman_data->ghosts[j].mode = MODE_FRIGHTENED;
         }
     }
+    else {
+        pacman_game_engine.base_state.state_data.single.score += 10;
+    }
 }
 
-static void handle_ghost_collision(void) {
-    for (uint8_t i = 0; i < NUM_GHOSTS; i++) {
-        Ghost* ghost = &pacman_data.ghosts[i];
-        if (!ghost->active) continue;
-
-        if (abs(pacman_data.pacman_pos.x - ghost->pos.x) < TILE_SIZE / 2 &&
-            abs(pacman_data.pacman_pos.y - ghost->pos.y) < TILE_SIZE / 2) {
+static void touch_ghost(entity_id_t id) {
+    Ghost* ghost = &pacman_data->ghosts[id - ghost_id(0)];
 
-            if (ghost->mode == MODE_FRIGHTENED) {
-                // Eat ghost
-                ghost->active = false;
-                pacman_game_engine.base_state.state_data.single.score += 200;
-            }
-            else {
-                // Lose life
-                if (pacman_game_engine.base_state.state_data.single.lives > 0) {
-                    pacman_game_engine.base_state.state_data.single.lives--;
-                    if (pacman_game_engine.base_state.state_data.single.lives == 0) {
-                        pacman_game_engine.base_state.game_over = true;
-                    }
-                    else {
-                        // Clear the game area before reinitializing
-                        display_fill_rectangle(
-                            BORDER_OFFSET,
-                            GAME_AREA_TOP,
-                            DISPLAY_WIDTH - BORDER_OFFSET,
-                            DISPLAY_HEIGHT - BORDER_OFFSET,
-                            DISPLAY_BLACK
-                        );
-                        maze_drawn = false; // Force maze redraw
-                        pacman_init();
-                    }
-                }
-            }
-        }
+    if (ghost->mode == MODE_FRIGHTENED) {
+        // Eat ghost
+        entity_destroy(game_entities, id);
+        pacman_game_engine.base_state.state_data.single.score += 200;
+    }
+    else {
+        // Entities are recreated on a lost life, which can't happen mid-pass
+        pacman_caught = true;
     }
 }
 
-static void pacman_update_dpad(DPAD_STATUS dpad_status) {
-    uint32_t current_time = get_current_ms();
+static void on_pacman_collision(entity_id_t a, entity_id_t b) {
+    (void)a;  // Only Pacman has a mask, and only ghosts are on its layers
 
-    // Handle direction change from D-pad
-    if (dpad_status.is_new) {
-        switch (dpad_status.direction) {
-        case DPAD_DIR_UP:    pacman_data.next_dir = DIR_UP;    break;
-        case DPAD_DIR_RIGHT: pacman_data.next_dir = DIR_RIGHT; break;
-        case DPAD_DIR_DOWN:  pacman_data.next_dir = DIR_DOWN;  break;
-        case DPAD_DIR_LEFT:  pacman_data.next_dir = DIR_LEFT;  break;
-        default: break;
-        }
+    if (!pacman_caught) {
+        touch_ghost(b);
     }
+}
 
-    if (current_time - last_move_time >= PACMAN_SPEED) {
-        move_pacman();
-        update_ghosts();
-        handle_dot_collision();
-        handle_ghost_collision();
+static void lose_life(void) {
+    pacman_caught = false;
+    if (pacman_game_engine.base_state.state_data.single.lives == 0) {
+        return;
+    }
 
-        last_move_time = current_time;
+    pacman_game_engine.base_state.state_data.single.lives--;
+    if (pacman_game_engine.base_state.state_data.single.lives == 0) {
+        pacman_game_engine.base_state.game_over = true;
     }
+    else {
+        // Clear the game area before reinitializing
+        display_fill_rectangle(
+            BORDER_OFFSET,
+            GAME_AREA_TOP,
+            DISPLAY_WIDTH - BORDER_OFFSET,
+            DISPLAY_HEIGHT - BORDER_OFFSET,
+            DISPLAY_BLACK
+        );
+        render_state->maze_drawn = false; // Force maze redraw
+        pacman_start_round();
+    }
+}
 
-    // Update animations
-    animated_sprite_update(&pacman_animated);
+// Step timer callback - Pacman and the ghosts move one tile
+static void pacman_step(void* context) {
+    (void)context;
 
-    // Also update scared ghost animation if active
-    if (pacman_data.power_pellet_active) {
-        animated_sprite_update(&scared_ghost_animated);
+    // The last life can go on a step earlier in the same advance
+    if (pacman_game_engine.base_state.game_over) {
+        return;
+    }
+    move_pacman();
+    update_ghosts();
+    move_entities();
+    collision_update(game_collisions, game_entities);
+    if (pacman_caught) {
+        lose_life();
+        return;
     }
 
-    // Update regular ghost animations
-    animated_sprite_update(&blinky_animated);
-    animated_sprite_update(&pinky_animated);
-    animated_sprite_update(&inky_animated);
-    animated_sprite_update(&clyde_animated);
+    // The dot on Pacman's tile, if there is one
+    Position pos = pacman_position();
+    eat_dot(world_to_maze_x(pos.x), world_to_maze_y(pos.y));
+}
+
+static void request_maze_refresh(void* context) {
+    (void)context;
+    render_state->maze_refresh_due = true;
+}
+
+static void request_border_redraw(void* context) {
+    (void)context;
+    render_state->border_redraw_due = true;
+}
+
+// Movement and animation run on the game timers after this, see pacman_step()
+static void pacman_update_dpad(DPAD_STATUS dpad_status) {
+    // Handle direction change from D-pad
+    if (dpad_status.is_new) {
+        switch (dpad_status.direction) {
+        case DPAD_DIR_UP:    pacman_data->next_dir = DIR_UP;    break;
+        case DPAD_DIR_RIGHT: pacman_data->next_dir = DIR_RIGHT; break;
+        case DPAD_DIR_DOWN:  pacman_data->next_dir = DIR_DOWN;  break;
+        case DPAD_DIR_LEFT:  pacman_data->next_dir = DIR_LEFT;  break;
+        default: break;
+        }
+
+        // The turn shows as Pacman's next tile
+        Position pos = pacman_position();
+        latency_probe_mark(viewport_to_screen_x(maze_get_viewport(), pos.x),
+            viewport_to_screen_y(maze_get_viewport(), pos.y), TILE_SIZE);
+    }
 }
 
 // Function to render the score and lives in the status area
 static void render_status_area(bool force_redraw) {
     // Check if there's a reason to redraw
     if (!force_redraw &&
-        previous_score == pacman_game_engine.base_state.state_data.single.score &&
-        previous_lives == pacman_game_engine.base_state.state_data.single.lives) {
+        render_state->previous_score == pacman_game_engine.base_state.state_data.single.score &&
+        render_state->previous_lives == pacman_game_engine.base_state.state_data.single.lives) {
         return;
     }
 
@@ -468,85 +620,68 @@ static void render_status_area(bool force_redraw) {
 #endif
 
     // Update previous values
-    previous_score = pacman_game_engine.base_state.state_data.single.score;
-    previous_lives = pacman_game_engine.base_state.state_data.single.lives;
+    render_state->previous_score = pacman_game_engine.base_state.state_data.single.score;
+    render_state->previous_lives = pacman_game_engine.base_state.state_data.single.lives;
 }
 
-// Function to clear a region and redraw border if needed
-static void clear_and_redraw_border_if_needed(coord_t x, coord_t y) {
+// Function to repaint the maze under a world position and redraw border if needed
+static void clear_and_redraw_border_if_needed(Position world_pos) {
+    Viewport* viewport = maze_get_viewport();
+    coord_t x = viewport_to_screen_x(viewport, world_pos.x);
+    coord_t y = viewport_to_screen_y(viewport, world_pos.y);
+
     // Check if position is near any border
     bool near_border = (x <= BORDER_OFFSET + TILE_SIZE ||
         x >= DISPLAY_WIDTH - BORDER_OFFSET - TILE_SIZE - 1 ||
         y <= GAME_AREA_TOP + TILE_SIZE ||
         y >= DISPLAY_HEIGHT - BORDER_OFFSET - TILE_SIZE - 1);
 
-    // Clear the region
-    display_clear_region(x, y, TILE_SIZE, TILE_SIZE);
+    // Repaint the tiles (and any dot on them), skipped if scrolled out of view
+    viewport_redraw_world_rect(viewport, world_pos.x, world_pos.y, TILE_SIZE, TILE_SIZE);
 
     // Redraw border if needed
     if (near_border) {
         display_draw_border_at(BORDER_OFFSET, GAME_AREA_TOP, 2, 2);
-        last_border_redraw_time = get_current_ms();
     }
 }
 
 // Function to clear previous positions of game elements
 static void clear_previous_positions(void) {
     // Clear previous Pacman position if it moved
-    if (previous_pacman_pos.x != pacman_data.pacman_pos.x ||
-        previous_pacman_pos.y != pacman_data.pacman_pos.y) {
-        clear_and_redraw_border_if_needed(previous_pacman_pos.x, previous_pacman_pos.y);
+    if (render_state->previous_pacman_pos.x != game_entities->pos_x[pacman_data->pacman] ||
+        render_state->previous_pacman_pos.y != game_entities->pos_y[pacman_data->pacman]) {
+        clear_and_redraw_border_if_needed(render_state->previous_pacman_pos);
     }
 
     // Clear previous ghost positions
     for (uint8_t i = 0; i < NUM_GHOSTS; i++) {
-        Ghost* ghost = &pacman_data.ghosts[i];
-        if (!ghost->active) continue;
+        entity_id_t id = ghost_id(i);
+        if (!entity_is_active(game_entities, id)) continue;
 
-        if (previous_ghost_pos[i].x != ghost->pos.x ||
-            previous_ghost_pos[i].y != ghost->pos.y) {
-            clear_and_redraw_border_if_needed(previous_ghost_pos[i].x, previous_ghost_pos[i].y);
-        }
-    }
-}
-
-// Function to draw dots and power pellets
-static void draw_dots_and_pellets(void) {
-    for (uint8_t i = 0; i < MAX_DOTS; i++) {
-        if (!pacman_data.dots[i].active) continue;
-
-        if (pacman_data.dots[i].is_power_pellet) {
-            sprite_draw(&power_pellet_sprite,
-                pacman_data.dots[i].pos.x,
-                pacman_data.dots[i].pos.y,
-                DISPLAY_WHITE);
-        }
-        else {
-            sprite_draw(&dot_sprite,
-                pacman_data.dots[i].pos.x,
-                pacman_data.dots[i].pos.y,
-                DISPLAY_WHITE);
+        if (render_state->previous_ghost_pos[i].x != game_entities->pos_x[id] ||
+            render_state->previous_ghost_pos[i].y != game_entities->pos_y[id]) {
+            clear_and_redraw_border_if_needed(render_state->previous_ghost_pos[i]);
         }
     }
 }
 
 // Function to redraw the maze if needed
 static void redraw_full_maze_if_needed(void) {
-    uint32_t current_time = get_current_ms();
-
-    // Redraw the maze if it hasn't been drawn yet or if enough time has passed
-    if (!maze_drawn || (current_time - last_border_redraw_time) > 5000) {
+    // Redraw the maze if it hasn't been drawn yet or the refresh timer asked for it
+    if (!render_state->maze_drawn || render_state->maze_refresh_due) {
         draw_maze();
-        maze_drawn = true;
-        last_border_redraw_time = current_time;
+        render_state->maze_drawn = true;
+        render_state->maze_refresh_due = false;
     }
 }
 
-// Function to draw all game elements (Pacman and ghosts)
+// Function to draw all game elements (Pacman and ghosts) that are inside the viewport
 static void draw_game_elements(void) {
+    Viewport* viewport = maze_get_viewport();
+
     // Draw Pacman with rotation
     uint16_t rotation = 0;
-    switch (pacman_data.curr_dir) {
+    switch (pacman_data->curr_dir) {
     case DIR_RIGHT: rotation = 0;   break;
     case DIR_DOWN:  rotation = 90;  break;
     case DIR_LEFT:  rotation = 180; break;
@@ -554,54 +689,61 @@ static void draw_game_elements(void) {
     case DIR_NONE:  break;
     }
 
-    sprite_draw_rotated(
-        &pacman_animated.frames[pacman_animated.current_frame],
-        pacman_data.pacman_pos.x,
-        pacman_data.pacman_pos.y,
-        rotation,
-        DISPLAY_WHITE
-    );
+    coord_t screen_x = viewport_to_screen_x(viewport, game_entities->pos_x[pacman_data->pacman]);
+    coord_t screen_y = viewport_to_screen_y(viewport, game_entities->pos_y[pacman_data->pacman]);
+    const Sprite* frame = sprite_rotation_get(&pacman_rotations, pacman_animated.current_frame, rotation);
+    if (frame != NULL) {
+        sprite_draw(frame, screen_x, screen_y, DISPLAY_WHITE);
+    } else {
+        sprite_draw_rotated(&pacman_animated.frames[pacman_animated.current_frame],
+            screen_x, screen_y, rotation, DISPLAY_WHITE);
+    }
 
-    // Draw ghosts
+    // Draw ghosts - the sprite comes from the entity's sprite id
     for (uint8_t i = 0; i < NUM_GHOSTS; i++) {
-        Ghost* ghost = &pacman_data.ghosts[i];
-        if (!ghost->active) continue;
-
-        if (ghost->mode == MODE_FRIGHTENED) {
-            sprite_draw(&scared_ghost_animated.frames[scared_ghost_animated.current_frame],
-                ghost->pos.x,
-                ghost->pos.y,
-                DISPLAY_WHITE);
+        entity_id_t id = ghost_id(i);
+        coord_t x = game_entities->pos_x[id];
+        coord_t y = game_entities->pos_y[id];
+        if (!entity_is_active(game_entities, id)) continue;
+        if (!viewport_is_visible(viewport, x, y, TILE_SIZE, TILE_SIZE)) continue;
+
+        AnimatedSprite* ghost_sprite;
+        if (pacman_data->ghosts[i].mode == MODE_FRIGHTENED) {
+            ghost_sprite = &scared_ghost_animated;
         }
         else {
-            AnimatedSprite* ghost_sprite;
-            switch (ghost->type) {
-            case GHOST_BLINKY: ghost_sprite = &blinky_animated; break;
-            case GHOST_PINKY:  ghost_sprite = &pinky_animated;  break;
-            case GHOST_INKY:   ghost_sprite = &inky_animated;   break;
-            case GHOST_CLYDE:  ghost_sprite = &clyde_animated;  break;
+            switch (game_entities->sprite_id[id]) {
+            case PACMAN_SPRITE_PINKY: ghost_sprite = &pinky_animated; break;
+            case PACMAN_SPRITE_INKY:  ghost_sprite = &inky_animated;  break;
+            case PACMAN_SPRITE_CLYDE: ghost_sprite = &clyde_animated; break;
+            default:                  ghost_sprite = &blinky_animated; break;
             }
-            sprite_draw(&ghost_sprite->frames[ghost_sprite->current_frame],
-                ghost->pos.x,
-                ghost->pos.y,
-                DISPLAY_WHITE);
         }
+
+        sprite_draw(&ghost_sprite->frames[ghost_sprite->current_frame],
+            viewport_to_screen_x(viewport, x),
+            viewport_to_screen_y(viewport, y),
+            DISPLAY_WHITE);
     }
 }
 
 static void pacman_render(void) {
+    if (render_state == NULL) {
+        return;  // Session didn't start
+    }
+
     // Initialize display on first render
-    if (first_render) {
+    if (render_state->first_render) {
         // Only set the flag, the maze will be drawn in redraw_full_maze_if_needed
         draw_maze();
-        maze_drawn = true;
+        render_state->maze_drawn = true;
         render_status_area(true);
-        first_render = false;
+        render_state->first_render = false;
     }
 
     // Update status area if score or lives changed
-    bool status_changed = (previous_score != pacman_game_engine.base_state.state_data.single.score) ||
-        (previous_lives != pacman_game_engine.base_state.state_data.single.lives);
+    bool status_changed = (render_state->previous_score != pacman_game_engine.base_state.state_data.single.score) ||
+        (render_state->previous_lives != pacman_game_engine.base_state.state_data.single.lives);
     if (status_changed) {
         render_status_area(true);
     }
@@ -609,18 +751,20 @@ static void pacman_render(void) {
     // Make sure maze is drawn
     redraw_full_maze_if_needed();
 
-    // Clear previous positions
-    clear_previous_positions();
+    // Keep Pacman in view - scrolling repaints only the tiles it exposes
+    viewport_follow(maze_get_viewport(), game_entities->pos_x[pacman_data->pacman],
+        game_entities->pos_y[pacman_data->pacman], TILE_SIZE, TILE_SIZE);
+    viewport_render(maze_get_viewport());
 
-    // Draw dots and pellets (they may be eaten, so redraw them)
-    draw_dots_and_pellets();
+    // Clear previous positions - repainted tiles bring back any uneaten dots
+    clear_previous_positions();
 
     // Draw game elements (Pacman and ghosts)
     draw_game_elements();
 
     // Draw game over or win text
     if (pacman_game_engine.base_state.game_over) {
-        char* message = (pacman_data.num_dots_remaining == 0) ?
+        char* message = (pacman_data->num_dots_remaining == 0) ?
             "YOU WIN!" : "GAME OVER";
 #ifdef DISPLAY_MODULE_LCD
         display_write_string_centered(message, Font_11x18, 30, DISPLAY_WHITE);
@@ -630,58 +774,45 @@ static void pacman_render(void) {
     }
 
     // Periodically redraw border to ensure it's intact
-    if (get_current_ms() % 500 == 0) {
+    if (render_state->border_redraw_due) {
         display_draw_border_at(BORDER_OFFSET, GAME_AREA_TOP, 2, 2);
-        last_border_redraw_time = get_current_ms();
+        render_state->border_redraw_due = false;
     }
 }
 
-static void pacman_cleanup(void) {
-    // Reset pacman position and direction
-    pacman_data.pacman_pos.x = 0;
-    pacman_data.pacman_pos.y = 0;
-    pacman_data.curr_dir = DIR_RIGHT;
-    pacman_data.next_dir = DIR_RIGHT;
+// Resumed from a save-state - init set the panel up for a fresh maze, match it to the
+// restored viewport and draw everything again
+static void pacman_on_restore(void) {
+    if (render_state == NULL) {
+        return;
+    }
 
-    // Reset ghosts
-    for (uint8_t i = 0; i < NUM_GHOSTS; i++) {
-        Ghost* ghost = &pacman_data.ghosts[i];
-        ghost->pos.x = 0;
-        ghost->pos.y = 0;
-        previous_ghost_pos[i].x = 0;
-        previous_ghost_pos[i].y = 0;
-        ghost->dir = DIR_RIGHT;
-        ghost->mode = MODE_CHASE;
-        ghost->active = false;
-        ghost->target.x = 0;
-        ghost->target.y = 0;
-    }
-
-    // Reset dots
-    for (uint8_t i = 0; i < MAX_DOTS; i++) {
-        pacman_data.dots[i].active = false;
-        pacman_data.dots[i].pos.x = 0;
-        pacman_data.dots[i].pos.y = 0;
-        pacman_data.dots[i].is_power_pellet = false;
-    }
-
-    // Reset game state
-    pacman_data.ghost_mode_timer = 0;
-    pacman_data.ghost_mode_duration = 0;
-    pacman_data.num_dots_remaining = 0;
-    pacman_data.power_pellet_active = false;
-
-    // Reset timing
-    last_move_time = 0;
+    Viewport* viewport = maze_get_viewport();
+    if (viewport->hw_scroll) {
+        display_set_scroll_offset(viewport->scroll_offset);
+    }
+    viewport_invalidate(viewport);
+    render_state->first_render = true;
+}
 
-    // Reset dirty rectangle tracking
-    previous_pacman_pos.x = 0;
-    previous_pacman_pos.y = 0;
-    maze_drawn = false;
-    previous_score = 0;
-    previous_lives = 0;
-    first_render = true;
-    last_border_redraw_time = 0;
+static void pacman_load_assets(void) {
+    size_t size = sprite_rotations_size(pacman_animated.frames, pacman_animated.num_frames);
+    sprite_rotations_build(&pacman_rotations, pacman_animated.frames, pacman_animated.num_frames,
+        game_registry_asset_alloc(size));
+}
+
+static void pacman_cleanup(void) {
+    // Release the display scroll area
+    if (render_state != NULL) {
+        maze_viewport_cleanup();
+    }
+
+    // Game data, entities, collision world, maze and render tracking go back with the arena
+    pacman_data = NULL;
+    render_state = NULL;
+    game_entities = NULL;
+    game_collisions = NULL;
+    pacman_caught = false;
 
     // Reset game engine state
     pacman_game_engine.base_state.state_data.single.score = 0;
@@ -6,6 +6,34 @@
  */
 
 #include "Game_Engine/Games/pacman_maze.h"
+#include "Sprites/pacman_sprite.h"
+#include "Game_Engine/game_engine_arena.h"
+
+static MazeState* maze = NULL;
+
+static void draw_maze_tile(uint8_t tile, coord_t screen_x, coord_t screen_y);
+
+inline int world_to_maze_x(coord_t x) {
+    int maze_x = (int)x / TILE_SIZE;
+    return (maze_x >= MAZE_WIDTH) ? MAZE_WIDTH - 1 : maze_x;
+}
+
+inline int world_to_maze_y(coord_t y) {
+    int maze_y = (int)y / TILE_SIZE;
+    return (maze_y >= MAZE_HEIGHT_ACTUAL) ? MAZE_HEIGHT_ACTUAL - 1 : maze_y;
+}
+
+inline coord_t maze_to_world_x(uint8_t x) {
+    // Clamp x to valid range
+    x = (x >= MAZE_WIDTH) ? MAZE_WIDTH : x;
+    return x * TILE_SIZE;
+}
+
+inline coord_t maze_to_world_y(uint8_t y) {
+    // Clamp y to valid range
+    y = (y >= MAZE_HEIGHT_ACTUAL) ? MAZE_HEIGHT_ACTUAL : y;
+    return y * TILE_SIZE;
+}
 
 inline int screen_to_maze_x(coord_t x) {
     // Convert to first tile if before border
@@ -49,6 +77,86 @@ bool is_wall(coord_t x, coord_t y) {
     return MAZE_LAYOUT[maze_y][maze_x] == MAZE_WALL;
 }
 
+bool is_wall_world(coord_t x, coord_t y) {
+    int maze_x = (int)x / TILE_SIZE;
+    int maze_y = (int)y / TILE_SIZE;
+
+    if (maze_x >= MAZE_WIDTH || maze_y >= MAZE_HEIGHT_ACTUAL) {
+        return true;  // Out of bounds is considered a wall
+    }
+
+    return maze->tiles[maze_y][maze_x] == MAZE_WALL;
+}
+
+bool maze_create(void) {
+    maze = (MazeState*)game_arena_alloc(sizeof(MazeState));
+    if (maze == NULL) {
+        return false;
+    }
+
+    maze->tilemap.tiles = &maze->tiles[0][0];
+    maze->tilemap.width = MAZE_WIDTH;
+    maze->tilemap.height = MAZE_HEIGHT_ACTUAL;
+    maze->tilemap.stride = MAZE_WIDTH;
+    maze->tilemap.tile_size = TILE_SIZE;
+    maze->tilemap.draw_tile = draw_maze_tile;
+    return true;
+}
+
+void maze_reset_tiles(void) {
+    for (uint8_t y = 0; y < MAZE_HEIGHT_ACTUAL; y++) {
+        for (uint8_t x = 0; x < MAZE_WIDTH; x++) {
+            maze->tiles[y][x] = MAZE_LAYOUT[y][x];
+        }
+    }
+}
+
+uint8_t maze_get_tile(uint8_t x, uint8_t y) {
+    if (x >= MAZE_WIDTH || y >= MAZE_HEIGHT_ACTUAL) {
+        return MAZE_WALL;
+    }
+    return maze->tiles[y][x];
+}
+
+void maze_clear_tile(uint8_t x, uint8_t y) {
+    if (x < MAZE_WIDTH && y < MAZE_HEIGHT_ACTUAL && maze->tiles[y][x] != MAZE_WALL) {
+        maze->tiles[y][x] = MAZE_PATH;
+    }
+}
+
+void maze_viewport_init(void) {
+    viewport_init(&maze->viewport, &maze->tilemap, MAZE_VIEW_X, MAZE_VIEW_Y,
+        MAZE_VIEW_WIDTH, MAZE_VIEW_HEIGHT);
+}
+
+void maze_viewport_cleanup(void) {
+    viewport_cleanup(&maze->viewport);
+}
+
+Viewport* maze_get_viewport(void) {
+    return &maze->viewport;
+}
+
+// Paint one maze tile - the viewport has already cleared it
+static void draw_maze_tile(uint8_t tile, coord_t screen_x, coord_t screen_y) {
+    switch (tile) {
+    case MAZE_WALL:
+        display_fill_rectangle(screen_x, screen_y,
+            screen_x + TILE_SIZE - 1,
+            screen_y + TILE_SIZE - 1,
+            DISPLAY_WHITE);
+        break;
+
+    case MAZE_DOT:
+        sprite_draw(&dot_sprite, screen_x, screen_y, DISPLAY_WHITE);
+        break;
+
+    case MAZE_POWER:
+        sprite_draw(&power_pellet_sprite, screen_x, screen_y, DISPLAY_WHITE);
+        break;
+    }
+}
+
 void draw_maze(void) {
     static bool already_drawing = false;
 
@@ -73,46 +181,9 @@ void draw_maze(void) {
     );
 #endif
 
-    // Then draw internal walls and items
-    for (uint8_t y = 0; y < MAZE_HEIGHT_ACTUAL; y++) {
-        for (uint8_t x = 0; x < MAZE_WIDTH; x++) {
-            coord_t screen_x = maze_to_screen_x(x);
-            coord_t screen_y = maze_to_screen_y(y);
-
-            switch (MAZE_LAYOUT[y][x]) {
-            case MAZE_WALL:
-                // Draw ALL walls
-#ifdef DISPLAY_MODULE_LCD
-            	display_fill_rectangle(screen_x, screen_y,
-            			screen_x + TILE_SIZE - 1,
-						screen_y + TILE_SIZE - 1,
-						DISPLAY_WHITE);
-#else
-            	display_fill_rectangle(screen_x, screen_y,
-            			screen_x + TILE_SIZE - 1,
-						screen_y + TILE_SIZE - 1,
-						DISPLAY_WHITE);
-#endif
-                break;
-
-            case MAZE_DOT:
-                // Single pixel dot
-                display_draw_pixel(screen_x + (TILE_SIZE / 2),
-                    screen_y + (TILE_SIZE / 2),
-                    DISPLAY_WHITE);
-                break;
-
-            case MAZE_POWER:
-                // Draw 2x2 power pellet
-                display_fill_rectangle(screen_x + (TILE_SIZE / 2) - 1,
-                    screen_y + (TILE_SIZE / 2) - 1,
-                    screen_x + (TILE_SIZE / 2),
-                    screen_y + (TILE_SIZE / 2),
-                    DISPLAY_WHITE);
-                break;
-            }
-        }
-    }
+    // Then draw the walls and items under the viewport. Only tiles inside the window are visited.
+    viewport_invalidate(&maze->viewport);
+    viewport_render(&maze->viewport);
 
     already_drawing = false;
 }
@@ -7,12 +7,23 @@
  *      Added dirty rectangle optimization
  *  Refactored on: Jun 5, 2025
  *      Updated to use modular display architecture
+ *  Modified on: Oct 18, 2026
+ *      Game state lives in the game arena for the length of a session
+ *      Queued input events are drained into the game before each update
+ *      Button 2 hold is timed on its debounced level
+ *      Ticks and drained inputs feed the latency probe
+ *      Game timers run on the engine timer wheel and stop while the game is paused
+ *      Every session is seeded and recorded for replays
  */
 
 #include "Console_Peripherals/Hardware/push_button.h"
 #include "Console_Peripherals/Hardware/display_manager.h"
 #include "Game_Engine/game_engine.h"
 #include "Game_Engine/game_engine_network.h"
+#include "Game_Engine/game_engine_input.h"
+#include "Game_Engine/game_engine_replay.h"
+#include "Utils/debug_conf.h"
+#include "Utils/latency_probe.h"
 
 static uint32_t game_over_start_time = 0;
 static uint32_t button2_press_start_time = 0;
@@ -23,6 +34,10 @@ static bool require_full_refresh = true;
 
 // Common game engine functions
 void game_engine_init(GameEngine* engine) {
+    game_engine_init_seeded(engine, get_random());
+}
+
+void game_engine_init_seeded(GameEngine* engine, uint32_t seed) {
     if (engine && engine->init) {
         // Initialize base state
         engine->base_state.state_data.single.score = 0;
@@ -43,6 +58,22 @@ void game_engine_init(GameEngine* engine) {
         // Initialize network error handling
         game_engine_network_init();
 
+        // Start the session with an empty arena - the game's init can borrow more from it
+        game_arena_reset();
+        if (engine->game_data_size > 0) {
+            engine->game_data = game_arena_alloc(engine->game_data_size);
+        }
+
+        // Presses from the menu are not game input
+        input_queue_flush(&input_events);
+
+        // No timers carry over from the last session, the game's init starts its own
+        timer_wheel_init(&game_timers, get_current_ms());
+
+        // Game logic only draws from the session stream, the seed is all a replay needs
+        game_random_seed(&game_random, seed);
+        replay_record_start(engine, seed, get_current_ms());
+
         // Call game-specific initialization
         engine->init();
 
@@ -63,10 +94,9 @@ void game_engine_handle_buttons(GameEngine* engine) {
     }
 
     // Handle Button 2 (Restart/Main Menu)
-    // Using raw pin value instead of debounced state (pb2_get_state()) as we need
-    // to track how long the button is held down, which requires continuous monitoring
-    // of the raw pin state.
-    if (PB_Driver_ReadPin2()) {
+    // Using the debounced level instead of the press edge (pb2_get_state()) as we need
+    // to track how long the button is held down.
+    if (pb2_is_down()) {
         if (!button2_being_held) {
             // Start tracking button press duration
             button2_being_held = true;
@@ -118,26 +148,49 @@ void game_engine_update(GameEngine* engine, void* input_data) {
 
         // Only update game logic if not paused and not game over
         if (!engine->base_state.game_over && !engine->base_state.paused) {
-            if (engine->is_d_pad_game) {
-                // Cast input to DPAD_STATUS for D-pad games
-                DPAD_STATUS* dpad_status = (DPAD_STATUS*)input_data;
-                // Check if the function pointer is valid before calling
-                if (engine->update_func.update_dpad != NULL) {
-                    engine->update_func.update_dpad(*dpad_status);
-                }
-            }
-            else {
-                // Cast input to JoystickStatus for joystick games
-                JoystickStatus* js_status = (JoystickStatus*)input_data;
-                // Check if the function pointer is valid before calling
-                if (engine->update_func.update_joystick != NULL) {
-                    engine->update_func.update_joystick(*js_status);
-                }
-            }
+            uint32_t current_time = get_current_ms();
+
+            latency_probe_tick();
+            replay_record_frame(current_time);
+            game_engine_tick(engine, input_data, &input_events, current_time);
+            replay_record_frame_end(engine);
+        }
+        else {
+            // Input while paused or over is not replayed on resume, and timers hold
+            input_queue_flush(&input_events);
+            timer_wheel_pause(&game_timers);
+            replay_record_pause();
         }
     }
 }
 
+void game_engine_tick(GameEngine* engine, void* input_data, InputQueue* queue, uint32_t now_ms) {
+    timer_wheel_resume(&game_timers, now_ms);
+    game_engine_drain_input(engine, queue);
+
+    if (engine->is_d_pad_game) {
+        // Cast input to DPAD_STATUS for D-pad games
+        DPAD_STATUS* dpad_status = (DPAD_STATUS*)input_data;
+        replay_record_status(dpad_status, sizeof(DPAD_STATUS));
+        // Check if the function pointer is valid before calling
+        if (engine->update_func.update_dpad != NULL) {
+            engine->update_func.update_dpad(*dpad_status);
+        }
+    }
+    else {
+        // Cast input to JoystickStatus for joystick games
+        JoystickStatus* js_status = (JoystickStatus*)input_data;
+        replay_record_status(js_status, sizeof(JoystickStatus));
+        // Check if the function pointer is valid before calling
+        if (engine->update_func.update_joystick != NULL) {
+            engine->update_func.update_joystick(*js_status);
+        }
+    }
+
+    // Timer callbacks run after the game has seen this tick's input
+    timer_wheel_advance(&game_timers, now_ms);
+}
+
 void game_engine_render_countdown(GameEngine* engine) {
     if (engine && engine->base_state.game_over) {
         uint32_t current_time = get_current_ms();
@@ -237,6 +290,9 @@ void game_engine_cleanup(GameEngine* engine) {
     if (engine && engine->cleanup) {
         engine->cleanup();
         engine->countdown_over = false;
+
+        // Session timers point into data that is about to go
+        timer_wheel_init(&game_timers, 0);
         game_over_start_time = 0;  // Reset timer on cleanup
         button2_press_start_time = 0;
         button2_being_held = false;
@@ -244,6 +300,21 @@ void game_engine_cleanup(GameEngine* engine) {
         // Cleanup network error handling
         game_engine_network_cleanup();
 
+        latency_probe_report();
+
+        replay_record_stop();
+#if REPLAY_DUMP_ON_EXIT
+        replay_dump();
+#endif
+
+        // Release everything the session took from the arena
+        DEBUG_PRINTF(false, "Game Engine: Arena peak usage %u of %u bytes\r\n",
+            (unsigned)game_arena_peak(), (unsigned)GAME_ARENA_SIZE);
+        if (engine->game_data_size > 0) {
+            engine->game_data = NULL;
+        }
+        game_arena_reset();
+
         // Force full refresh after cleanup
         require_full_refresh = true;
     }
@@ -0,0 +1,53 @@
+/*
+ * game_engine_arena.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Game_Engine/game_engine_arena.h"
+#include "Utils/debug_conf.h"
+#include <stdbool.h>
+#include <string.h>
+
+static uint8_t arena_pool[GAME_ARENA_SIZE] __attribute__((aligned(GAME_ARENA_ALIGN)));
+static size_t arena_used = 0;
+static size_t arena_peak = 0;
+
+// Starts a session, its peak is counted from zero
+void game_arena_reset(void) {
+    arena_used = 0;
+    arena_peak = 0;
+}
+
+void* game_arena_alloc(size_t size) {
+    size_t aligned_size = GAME_ARENA_BLOCK(size);
+
+    if (aligned_size > GAME_ARENA_SIZE - arena_used) {
+        DEBUG_PRINTF(false, "Game Arena: Out of memory, %u of %u bytes used, %u requested\r\n",
+            (unsigned)arena_used, (unsigned)GAME_ARENA_SIZE, (unsigned)size);
+        return NULL;
+    }
+
+    void* block = &arena_pool[arena_used];
+    arena_used += aligned_size;
+    if (arena_used > arena_peak) {
+        arena_peak = arena_used;
+    }
+
+    // Sessions start from zeroed state, like the statics they replace
+    memset(block, 0, aligned_size);
+    return block;
+}
+
+size_t game_arena_used(void) {
+    return arena_used;
+}
+
+size_t game_arena_peak(void) {
+    return arena_peak;
+}
+
+uint8_t* game_arena_data(void) {
+    return arena_pool;
+}
@@ -0,0 +1,172 @@
+/*
+ * game_engine_collision.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Game_Engine/game_engine_collision.h"
+#include "Game_Engine/game_engine_arena.h"
+#include <string.h>
+
+CollisionWorld* game_collisions = NULL;
+
+// World space box of an entity's collider
+typedef struct {
+    int32_t x;
+    int32_t y;
+    coord_t width;
+    coord_t height;
+} CollisionBox;
+
+static CollisionBox collider_box(const CollisionWorld* world, const EntityStore* store, entity_id_t id) {
+    CollisionBox box = { store->pos_x[id], store->pos_y[id], world->width[id], world->height[id] };
+
+    if (world->shape[id] == COLLIDER_TILE) {
+        uint8_t ts = world->tile_size;
+        box.x = ((box.x + ts / 2) / ts) * ts;
+        box.y = ((box.y + ts / 2) / ts) * ts;
+        box.width = ts;
+        box.height = ts;
+    }
+    return box;
+}
+
+static inline int32_t cell_of(int32_t value) {
+    return value / COLLISION_CELL_SIZE;
+}
+
+static inline uint8_t bucket_of(int32_t cell_x, int32_t cell_y) {
+    return ((uint32_t)cell_x * 73856093UL ^ (uint32_t)cell_y * 19349663UL) & (COLLISION_BUCKETS - 1);
+}
+
+static inline bool has_collider(const CollisionWorld* world, entity_id_t id) {
+    return world->shape[id] != COLLIDER_NONE && world->layer[id] != 0;
+}
+
+CollisionWorld* collision_world_create(uint8_t tile_size, collision_callback_t on_collision) {
+    game_collisions = (CollisionWorld*)game_arena_alloc(sizeof(CollisionWorld));
+    if (game_collisions != NULL) {
+        collision_world_reset(game_collisions, tile_size, on_collision);
+    }
+    return game_collisions;
+}
+
+void collision_world_reset(CollisionWorld* world, uint8_t tile_size, collision_callback_t on_collision) {
+    memset(world, 0, sizeof(CollisionWorld));
+    memset(world->bucket_head, 0xFF, sizeof(world->bucket_head));  // ENTITY_NONE
+    world->tile_size = tile_size;
+    world->on_collision = on_collision;
+}
+
+void collision_set_aabb(CollisionWorld* world, entity_id_t id, uint8_t width, uint8_t height,
+    uint8_t layer, uint8_t mask) {
+    if (id >= ENTITY_STORE_CAPACITY) {
+        return;
+    }
+
+    // The broadphase only looks one cell around an entity
+    world->shape[id] = COLLIDER_AABB;
+    world->width[id] = (width > COLLISION_CELL_SIZE) ? COLLISION_CELL_SIZE : width;
+    world->height[id] = (height > COLLISION_CELL_SIZE) ? COLLISION_CELL_SIZE : height;
+    world->layer[id] = layer;
+    world->mask[id] = mask;
+}
+
+void collision_set_tile(CollisionWorld* world, entity_id_t id, uint8_t layer, uint8_t mask) {
+    if (id >= ENTITY_STORE_CAPACITY) {
+        return;
+    }
+
+    world->shape[id] = COLLIDER_TILE;
+    world->width[id] = world->tile_size;
+    world->height[id] = world->tile_size;
+    world->layer[id] = layer;
+    world->mask[id] = mask;
+}
+
+void collision_remove(CollisionWorld* world, entity_id_t id) {
+    if (id < ENTITY_STORE_CAPACITY) {
+        world->shape[id] = COLLIDER_NONE;
+        world->layer[id] = 0;
+        world->mask[id] = 0;
+    }
+}
+
+// Entities are filed under the cell holding their top-left corner
+static void build_grid(CollisionWorld* world, const EntityStore* store) {
+    memset(world->bucket_head, 0xFF, sizeof(world->bucket_head));
+
+    for (entity_id_t id = entity_first(store); id != ENTITY_NONE; id = entity_next(store, id)) {
+        if (!has_collider(world, id)) {
+            continue;
+        }
+
+        CollisionBox box = collider_box(world, store, id);
+        uint8_t bucket = bucket_of(cell_of(box.x), cell_of(box.y));
+        world->next_in_cell[id] = world->bucket_head[bucket];
+        world->bucket_head[bucket] = id;
+    }
+}
+
+// Test one entity against everything filed in one cell
+static void query_cell(CollisionWorld* world, const EntityStore* store, entity_id_t a,
+    const CollisionBox* box_a, int32_t cell_x, int32_t cell_y) {
+    entity_id_t b = world->bucket_head[bucket_of(cell_x, cell_y)];
+
+    for (; b != ENTITY_NONE; b = world->next_in_cell[b]) {
+        if (b == a || !entity_is_active(store, b) || (world->mask[a] & world->layer[b]) == 0) {
+            continue;
+        }
+
+        // Both ends asking about each other - report the pair once, from the lower id
+        if ((world->mask[b] & world->layer[a]) != 0 && b < a) {
+            continue;
+        }
+
+        // Different cells can share a bucket
+        CollisionBox box_b = collider_box(world, store, b);
+        if (cell_of(box_b.x) != cell_x || cell_of(box_b.y) != cell_y) {
+            continue;
+        }
+
+        world->candidate_pairs++;
+        if (collision_boxes_overlap(box_a->x, box_a->y, box_a->width, box_a->height,
+            box_b.x, box_b.y, box_b.width, box_b.height)) {
+            world->on_collision(a, b);
+
+            if (!entity_is_active(store, a)) {
+                return;
+            }
+        }
+    }
+}
+
+void collision_update(CollisionWorld* world, const EntityStore* store) {
+    world->candidate_pairs = 0;
+    if (world->on_collision == NULL) {
+        return;
+    }
+
+    build_grid(world, store);
+
+    // Only entities with a mask go looking - static ones like dots are just filed in the grid
+    for (entity_id_t a = entity_first(store); a != ENTITY_NONE; a = entity_next(store, a)) {
+        if (!has_collider(world, a) || world->mask[a] == 0) {
+            continue;
+        }
+
+        CollisionBox box_a = collider_box(world, store, a);
+        int32_t cell_x = cell_of(box_a.x);
+        int32_t cell_y = cell_of(box_a.y);
+
+        // Colliders are no larger than a cell, so anything touching a is filed in a neighbouring cell
+        for (int32_t y = cell_y - 1; y <= cell_y + 1 && entity_is_active(store, a); y++) {
+            for (int32_t x = cell_x - 1; x <= cell_x + 1 && entity_is_active(store, a); x++) {
+                if (x >= 0 && y >= 0) {
+                    query_cell(world, store, a, &box_a, x, y);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ * game_engine_entity.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Game_Engine/game_engine_entity.h"
+#include "Game_Engine/game_engine_arena.h"
+#include <string.h>
+
+EntityStore* game_entities = NULL;
+
+// The arena hands out zeroed memory, which is an empty store
+EntityStore* entity_store_create(void) {
+    game_entities = (EntityStore*)game_arena_alloc(sizeof(EntityStore));
+    return game_entities;
+}
+
+void entity_store_reset(EntityStore* store) {
+    memset(store, 0, sizeof(EntityStore));
+}
+
+entity_id_t entity_create(EntityStore* store, coord_t x, coord_t y, uint8_t sprite_id, uint8_t flags) {
+    for (uint8_t word = 0; word < ENTITY_MASK_WORDS; word++) {
+        uint32_t free_bits = ~store->active[word];
+        if (free_bits == 0) {
+            continue;
+        }
+
+        entity_id_t id = (word << 5) + __builtin_ctz(free_bits);
+        store->active[word] |= (1UL << (id & 31));
+        store->pos_x[id] = x;
+        store->pos_y[id] = y;
+        store->vel_x[id] = 0;
+        store->vel_y[id] = 0;
+        store->sprite_id[id] = sprite_id;
+        store->flags[id] = flags;
+        return id;
+    }
+
+    return ENTITY_NONE;
+}
+
+entity_id_t entity_create_block(EntityStore* store, uint16_t count) {
+    uint16_t run = 0;
+
+    if (count == 0) {
+        return ENTITY_NONE;
+    }
+
+    // First fit - look for count free ids in a row
+    for (entity_id_t id = 0; id < ENTITY_STORE_CAPACITY; id++) {
+        run = entity_is_active(store, id) ? 0 : run + 1;
+        if (run == count) {
+            entity_id_t first = id + 1 - count;
+            for (entity_id_t i = first; i <= id; i++) {
+                store->active[i >> 5] |= (1UL << (i & 31));
+                store->pos_x[i] = 0;
+                store->pos_y[i] = 0;
+                store->vel_x[i] = 0;
+                store->vel_y[i] = 0;
+                store->sprite_id[i] = 0;
+                store->flags[i] = 0;
+            }
+            return first;
+        }
+    }
+
+    return ENTITY_NONE;
+}
+
+void entity_destroy(EntityStore* store, entity_id_t id) {
+    if (id < ENTITY_STORE_CAPACITY) {
+        store->active[id >> 5] &= ~(1UL << (id & 31));
+    }
+}
+
+entity_id_t entity_next_from(const EntityStore* store, entity_id_t start) {
+    if (start >= ENTITY_STORE_CAPACITY) {
+        return ENTITY_NONE;
+    }
+
+    // Mask off ids below start in the first word, then skip empty words whole
+    uint8_t word = start >> 5;
+    uint32_t bits = store->active[word] & (0xFFFFFFFFUL << (start & 31));
+
+    while (bits == 0) {
+        if (++word >= ENTITY_MASK_WORDS) {
+            return ENTITY_NONE;
+        }
+        bits = store->active[word];
+    }
+
+    return (word << 5) + __builtin_ctz(bits);
+}
+
+uint16_t entity_count(const EntityStore* store) {
+    uint16_t count = 0;
+    for (uint8_t word = 0; word < ENTITY_MASK_WORDS; word++) {
+        count += __builtin_popcount(store->active[word]);
+    }
+    return count;
+}
+
+// Tight loop over contiguous component arrays - movers are allocated as one block
+// so the pass never visits static entities
+void entity_move_range(EntityStore* store, entity_id_t first, uint16_t count) {
+    if (first >= ENTITY_STORE_CAPACITY) {
+        return;
+    }
+    if (count > ENTITY_STORE_CAPACITY - first) {
+        count = ENTITY_STORE_CAPACITY - first;
+    }
+
+    coord_t* pos_x = &store->pos_x[first];
+    coord_t* pos_y = &store->pos_y[first];
+    const int16_t* vel_x = &store->vel_x[first];
+    const int16_t* vel_y = &store->vel_y[first];
+
+    for (uint16_t i = 0; i < count; i++) {
+        pos_x[i] += vel_x[i];
+        pos_y[i] += vel_y[i];
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * game_engine_input.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Game_Engine/game_engine_input.h"
+#include "Game_Engine/game_engine_replay.h"
+#include "Utils/latency_probe.h"
+#include <string.h>
+
+uint8_t game_engine_drain_input(GameEngine* engine, InputQueue* queue) {
+    InputEvent event;
+    uint8_t drained = 0;
+
+    while (input_queue_pop(queue, &event)) {
+        // Releases and returns to center draw nothing, only presses are timed
+        if (event.state != 0) {
+            latency_probe_input(event.timestamp_us);
+        }
+        if (engine->on_input_event != NULL) {
+            replay_record_input(&event);
+            engine->on_input_event(&event);
+        }
+        drained++;
+    }
+    return drained;
+}
+
+void turn_buffer_reset(TurnBuffer* turns, uint8_t direction) {
+    memset(turns, 0, sizeof(TurnBuffer));
+    turns->last_queued = direction;
+}
+
+bool turn_buffer_push(TurnBuffer* turns, uint8_t direction) {
+    // Releases and repeats of the same heading are not turns
+    if (direction == 0 || direction == turns->last_queued) {
+        return true;
+    }
+
+    if (turns->count >= GAME_TURN_BUFFER_SIZE) {
+        return false;
+    }
+
+    turns->directions[turns->count++] = direction;
+    turns->last_queued = direction;
+    return true;
+}
+
+uint8_t turn_buffer_take(TurnBuffer* turns, uint8_t current_direction, turn_valid_t is_valid) {
+    while (!turns->turned_this_step && turns->count > 0) {
+        uint8_t direction = turns->directions[0];
+        turns->count--;
+        memmove(&turns->directions[0], &turns->directions[1], turns->count);
+
+        if (is_valid == NULL || is_valid(current_direction, direction)) {
+            turns->turned_this_step = true;
+            return direction;
+        }
+    }
+    return 0;
+}
+
+void turn_buffer_step(TurnBuffer* turns) {
+    turns->turned_this_step = false;
+}
@@ -0,0 +1,49 @@
+/*
+ * game_engine_random.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Game_Engine/game_engine_random.h"
+
+GameRandom game_random;
+
+static inline uint32_t rotl(uint32_t x, uint8_t k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+// splitmix32 spreads the seed over the whole state, which must not be all zero
+static uint32_t splitmix32(uint32_t* x) {
+    uint32_t z = (*x += 0x9E3779B9u);
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return z ^ (z >> 16);
+}
+
+void game_random_seed(GameRandom* rng, uint32_t seed) {
+    for (uint8_t i = 0; i < 4; i++) {
+        rng->s[i] = splitmix32(&seed);
+    }
+}
+
+uint32_t game_random_next(GameRandom* rng) {
+    uint32_t* s = rng->s;
+    uint32_t result = rotl(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 11);
+
+    return result;
+}
+
+uint32_t game_random_below(GameRandom* rng, uint32_t bound) {
+    // Multiply-shift takes the high bits instead of the weaker low ones that % would use.
+    // The bias is below bound / 2^32, nothing a game can see.
+    return (uint32_t)(((uint64_t)game_random_next(rng) * bound) >> 32);
+}
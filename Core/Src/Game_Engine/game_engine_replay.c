@@ -0,0 +1,318 @@
+/*
+ * game_engine_replay.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Game_Engine/game_engine_replay.h"
+#include "Game_Engine/game_engine_entity.h"
+#include "Utils/debug_conf.h"
+#include <string.h>
+
+#define TAG_END         0x00
+#define TAG_INPUT       0x01
+#define TAG_STATUS      0x02
+#define TAG_HASH        0x03
+#define TAG_FRAME_LONG  0x04
+#define TAG_FRAME       0x80    // Low bits carry the step
+#define FRAME_SHORT_MAX 0x7F
+
+#define REPLAY_STATUS_MAX 8     // Largest controller status, JoystickStatus is 3 bytes
+
+#define FNV_OFFSET  2166136261UL
+#define FNV_PRIME   16777619UL
+
+static uint8_t buffer[REPLAY_BUFFER_SIZE];
+static ReplayHeader header;
+static ReplayState state = REPLAY_IDLE;
+static uint32_t used = 0;
+static uint32_t frame_start = 0;        // Where the open update's records begin
+static uint32_t last_frame_ms = 0;
+static bool clock_stopped = false;
+static uint8_t last_status[REPLAY_STATUS_MAX];
+static uint8_t last_status_size = 0;
+
+static void put_u32(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t get_u32(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+// Header in front, end record behind the last whole update
+static void seal(void) {
+    buffer[used] = TAG_END;
+    header.length = used + 1;
+    memcpy(buffer, &header, sizeof(header));
+}
+
+// Room for size more bytes and the end record, or the open update is dropped and recording stops
+static bool reserve(uint32_t size) {
+    if (state != REPLAY_RECORDING) {
+        return false;
+    }
+    if (used + size + 1 <= REPLAY_BUFFER_SIZE) {
+        return true;
+    }
+
+    used = frame_start;
+    state = REPLAY_FULL;
+    seal();
+    DEBUG_PRINTF(false, "Replay: buffer full after %lu frames\r\n", (unsigned long)header.frames);
+    return false;
+}
+
+void replay_record_start(const GameEngine* engine, uint32_t seed, uint32_t now_ms) {
+    if (state == REPLAY_PLAYING) {
+        return;
+    }
+
+    memset(&header, 0, sizeof(header));
+    header.magic = REPLAY_MAGIC;
+    header.version = REPLAY_VERSION;
+    header.hash_interval = REPLAY_HASH_INTERVAL;
+    header.game_data_size = (uint16_t)engine->game_data_size;
+    header.seed = seed;
+
+    used = sizeof(ReplayHeader);
+    frame_start = used;
+    last_frame_ms = now_ms;
+    clock_stopped = false;
+    last_status_size = 0;
+    state = REPLAY_RECORDING;
+    seal();
+}
+
+void replay_record_frame(uint32_t now_ms) {
+    // The timer wheel restarts from now after a pause, the update sees no time pass
+    uint32_t dt = clock_stopped ? 0 : now_ms - last_frame_ms;
+
+    frame_start = used;
+    if (dt <= FRAME_SHORT_MAX) {
+        if (reserve(1)) {
+            buffer[used++] = TAG_FRAME | (uint8_t)dt;
+        }
+    }
+    else if (reserve(5)) {
+        buffer[used++] = TAG_FRAME_LONG;
+        put_u32(&buffer[used], dt);
+        used += 4;
+    }
+    last_frame_ms = now_ms;
+    clock_stopped = false;
+}
+
+void replay_record_pause(void) {
+    clock_stopped = true;
+}
+
+void replay_record_input(const InputEvent* event) {
+    // The timestamp only matters to the latency probe
+    if (reserve(3)) {
+        buffer[used++] = TAG_INPUT;
+        buffer[used++] = event->source;
+        buffer[used++] = event->state;
+    }
+}
+
+void replay_record_status(const void* status, uint8_t size) {
+    if (size > REPLAY_STATUS_MAX) {
+        return;
+    }
+    // Most updates see the same status as the last one
+    if (size == last_status_size && memcmp(status, last_status, size) == 0) {
+        return;
+    }
+    if (reserve(2 + size)) {
+        buffer[used++] = TAG_STATUS;
+        buffer[used++] = size;
+        memcpy(&buffer[used], status, size);
+        used += size;
+        memcpy(last_status, status, size);
+        last_status_size = size;
+    }
+}
+
+void replay_record_frame_end(const GameEngine* engine) {
+    if (state != REPLAY_RECORDING) {
+        return;
+    }
+
+    header.frames++;
+    // The update that ended the game is the last one, it is always checked
+    if (header.frames % REPLAY_HASH_INTERVAL == 0 || engine->base_state.game_over) {
+        if (!reserve(5)) {
+            header.frames--;
+            return;
+        }
+        buffer[used++] = TAG_HASH;
+        put_u32(&buffer[used], replay_state_hash(engine));
+        used += 4;
+    }
+    frame_start = used;
+}
+
+void replay_record_stop(void) {
+    if (state == REPLAY_RECORDING || state == REPLAY_FULL) {
+        seal();
+        DEBUG_PRINTF(false, "Replay: %lu frames in %lu bytes, seed %08lx\r\n",
+            (unsigned long)header.frames, (unsigned long)header.length, (unsigned long)header.seed);
+        state = REPLAY_IDLE;
+    }
+}
+
+ReplayState replay_get_state(void) {
+    return state;
+}
+
+const uint8_t* replay_get_recording(uint32_t* length) {
+    if (state == REPLAY_RECORDING) {
+        seal();
+    }
+    *length = (header.magic == REPLAY_MAGIC) ? header.length : 0;
+    return buffer;
+}
+
+void replay_dump(void) {
+    uint32_t length;
+    const uint8_t* data = replay_get_recording(&length);
+    char line[2 * 32 + 1];
+
+    DEBUG_PRINTF(false, "REPLAY BEGIN %lu\r\n", (unsigned long)length);
+    for (uint32_t offset = 0; offset < length; offset += 32) {
+        uint32_t count = (length - offset < 32) ? length - offset : 32;
+        for (uint32_t i = 0; i < count; i++) {
+            snprintf(&line[2 * i], 3, "%02X", data[offset + i]);
+        }
+        DEBUG_PRINTF(false, "%s\r\n", line);
+    }
+    DEBUG_PRINTF(false, "REPLAY END\r\n");
+}
+
+static uint32_t fnv1a(uint32_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+uint32_t replay_state_hash(const GameEngine* engine) {
+    uint32_t hash = FNV_OFFSET;
+    uint8_t game_over = engine->base_state.game_over;
+
+    // Field by field, struct padding is not state
+    if (engine->is_mp_game) {
+        const MultiPlayerState* multi = &engine->base_state.state_data.multi;
+        hash = fnv1a(hash, &multi->p1_score, sizeof(multi->p1_score));
+        hash = fnv1a(hash, &multi->p2_score, sizeof(multi->p2_score));
+        hash = fnv1a(hash, &multi->lives, sizeof(multi->lives));
+    }
+    else {
+        const SinglePlayerState* single = &engine->base_state.state_data.single;
+        hash = fnv1a(hash, &single->score, sizeof(single->score));
+        hash = fnv1a(hash, &single->lives, sizeof(single->lives));
+    }
+    hash = fnv1a(hash, &game_over, sizeof(game_over));
+
+    // Arena blocks are zeroed, so the padding in game data is stable
+    if (engine->game_data != NULL) {
+        hash = fnv1a(hash, engine->game_data, engine->game_data_size);
+    }
+
+    if (game_entities != NULL) {
+        for (entity_id_t id = entity_first(game_entities); id != ENTITY_NONE; id = entity_next(game_entities, id)) {
+            hash = fnv1a(hash, &id, sizeof(id));
+            hash = fnv1a(hash, &game_entities->pos_x[id], sizeof(coord_t));
+            hash = fnv1a(hash, &game_entities->pos_y[id], sizeof(coord_t));
+            hash = fnv1a(hash, &game_entities->vel_x[id], sizeof(int16_t));
+            hash = fnv1a(hash, &game_entities->vel_y[id], sizeof(int16_t));
+            hash = fnv1a(hash, &game_entities->sprite_id[id], 1);
+            hash = fnv1a(hash, &game_entities->flags[id], 1);
+        }
+    }
+    return hash;
+}
+
+bool replay_play(GameEngine* engine, const uint8_t* data, uint32_t length, ReplayResult* result) {
+    ReplayHeader recorded;
+    InputQueue queue;
+    uint8_t status[REPLAY_STATUS_MAX] = {0};
+    uint32_t pos = sizeof(ReplayHeader);
+    uint32_t dt = 0;
+    bool frame_open = false;
+
+    memset(result, 0, sizeof(ReplayResult));
+    if (length < sizeof(ReplayHeader) + 1) {
+        return false;
+    }
+    memcpy(&recorded, data, sizeof(recorded));
+    if (recorded.magic != REPLAY_MAGIC || recorded.version != REPLAY_VERSION ||
+        recorded.game_data_size != (uint16_t)engine->game_data_size || recorded.length > length) {
+        DEBUG_PRINTF(false, "Replay: recording does not fit this game\r\n");
+        return false;
+    }
+
+    // Recording stays off while the game runs, the recording played may be its own buffer
+    replay_record_stop();
+    state = REPLAY_PLAYING;
+
+    game_engine_init_seeded(engine, recorded.seed);
+    uint32_t now_ms = game_timers.last_ms;
+    input_queue_reset(&queue);
+
+    while (pos < recorded.length) {
+        uint8_t tag = data[pos++];
+
+        // An update runs once all its records are read, before the next update or its hash
+        if (frame_open && ((tag & TAG_FRAME) || tag == TAG_FRAME_LONG || tag == TAG_HASH || tag == TAG_END)) {
+            now_ms += dt;
+            game_engine_tick(engine, status, &queue, now_ms);
+            result->frames++;
+            frame_open = false;
+        }
+
+        if (tag & TAG_FRAME) {
+            dt = tag & FRAME_SHORT_MAX;
+            frame_open = true;
+        }
+        else if (tag == TAG_FRAME_LONG && pos + 4 <= recorded.length) {
+            dt = get_u32(&data[pos]);
+            pos += 4;
+            frame_open = true;
+        }
+        else if (tag == TAG_INPUT && pos + 2 <= recorded.length) {
+            input_queue_push(&queue, data[pos], data[pos + 1], 0);
+            pos += 2;
+        }
+        else if (tag == TAG_STATUS && pos + 1 <= recorded.length &&
+                 data[pos] <= REPLAY_STATUS_MAX && pos + 1 + data[pos] <= recorded.length) {
+            memcpy(status, &data[pos + 1], data[pos]);
+            pos += 1 + data[pos];
+        }
+        else if (tag == TAG_HASH && pos + 4 <= recorded.length) {
+            result->hashes_checked++;
+            if (get_u32(&data[pos]) != replay_state_hash(engine) && result->mismatch_frame == 0) {
+                result->mismatch_frame = result->frames;
+                DEBUG_PRINTF(false, "Replay: state differs at frame %lu\r\n", (unsigned long)result->frames);
+            }
+            pos += 4;
+        }
+        else if (tag == TAG_END) {
+            result->complete = true;
+            break;
+        }
+        else {
+            DEBUG_PRINTF(false, "Replay: bad record %02X at %lu\r\n", tag, (unsigned long)(pos - 1));
+            break;
+        }
+    }
+
+    state = REPLAY_IDLE;
+    return result->complete && result->mismatch_frame == 0;
+}
@@ -0,0 +1,227 @@
+/*
+ * game_engine_save.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Game_Engine/game_engine_save.h"
+#include "Game_Engine/game_engine_replay.h"
+#include "Console_Peripherals/Hardware/Drivers/flash_driver.h"
+#include "System/save_store.h"
+#include "Utils/debug_conf.h"
+#include <string.h>
+
+#define NO_KEY 0xFFFF
+
+typedef struct {
+    GameSaveHeader header;
+    __typeof__(((GameEngine*)0)->base_state) base_state;
+    TimerWheel timers;
+    GameRandom random;
+} SnapshotState;
+
+_Static_assert(sizeof(SnapshotState) + GAME_ARENA_SIZE <= GAME_SAVE_BUFFER_SIZE,
+    "GAME_SAVE_BUFFER_SIZE cannot hold a full arena");
+
+// Written from here by the save store, a new capture waits until it is done
+static uint8_t staging[GAME_SAVE_BUFFER_SIZE] __attribute__((aligned(4)));
+static uint16_t discard_key = NO_KEY;  // Waiting for the store
+static bool writing_snapshot = false;
+static GameSaveStats stats;
+
+static size_t region_bytes(const GameSaveDescriptor* save) {
+    size_t total = 0;
+    for (uint8_t i = 0; i < save->region_count; i++) {
+        total += save->regions[i].size;
+    }
+    return total;
+}
+
+void game_save_init(void) {
+    memset(&stats, 0, sizeof(stats));
+    discard_key = NO_KEY;
+    writing_snapshot = false;
+    save_store_init();
+}
+
+uint32_t game_save_capture(uint16_t key, const GameEngine* engine, const GameSaveDescriptor* save) {
+    if (engine == NULL || save == NULL) {
+        return 0;
+    }
+    if (save_store_busy() || discard_key != NO_KEY) {
+        stats.busy++;
+        return 0;
+    }
+
+    uint32_t start_us = get_current_us();
+    size_t arena_used = game_arena_used();
+    size_t regions = region_bytes(save);
+    size_t length = sizeof(SnapshotState) + arena_used + regions;
+
+    if (length > sizeof(staging)) {
+        DEBUG_PRINTF(false, "Save: Snapshot of %u bytes does not fit the staging buffer\r\n", (unsigned)length);
+        return 0;
+    }
+
+    SnapshotState* state = (SnapshotState*)staging;
+    state->header.magic = GAME_SAVE_MAGIC;
+    state->header.image_id = flash_driver_image_id();
+    state->header.format = GAME_SAVE_FORMAT;
+    state->header.game_version = save->version;
+    state->header.arena_used = (uint16_t)arena_used;
+    state->header.region_bytes = (uint16_t)regions;
+    memcpy(&state->base_state, &engine->base_state, sizeof(state->base_state));
+    memcpy(&state->timers, &game_timers, sizeof(state->timers));
+    memcpy(&state->random, &game_random, sizeof(state->random));
+
+    uint8_t* cursor = staging + sizeof(SnapshotState);
+    memcpy(cursor, game_arena_data(), arena_used);
+    cursor += arena_used;
+    for (uint8_t i = 0; i < save->region_count; i++) {
+        memcpy(cursor, save->regions[i].data, save->regions[i].size);
+        cursor += save->regions[i].size;
+    }
+
+    if (!save_store_begin(key, save->version, staging, (uint32_t)length)) {
+        DEBUG_PRINTF(false, "Save: Store full, waiting for compaction\r\n");
+        return 0;
+    }
+
+    writing_snapshot = true;
+    stats.snapshot_bytes = (uint32_t)length;
+    stats.capture_us = get_current_us() - start_us;
+    stats.write_us = 0;
+    stats.write_steps = 0;
+    return (uint32_t)length;
+}
+
+// The stored snapshot of key, if this image and game version can use it
+static const SnapshotState* find_snapshot(uint16_t key, const GameSaveDescriptor* save) {
+    SaveRecord record;
+
+    if (!save_store_find(key, &record) || record.length == 0) {
+        return NULL;
+    }
+
+    const SnapshotState* state = (const SnapshotState*)record.data;
+    if (record.length < sizeof(SnapshotState)
+        || state->header.magic != GAME_SAVE_MAGIC
+        || state->header.format != GAME_SAVE_FORMAT
+        || state->header.game_version != save->version
+        || state->header.image_id != flash_driver_image_id()
+        || state->header.region_bytes != region_bytes(save)
+        || record.length != sizeof(SnapshotState) + state->header.arena_used + state->header.region_bytes) {
+        DEBUG_PRINTF(false, "Save: Snapshot of game %u is from another build or version\r\n", (unsigned)key);
+        stats.rejected++;
+        return NULL;
+    }
+    return state;
+}
+
+bool game_save_resume(uint16_t key, GameEngine* engine, const GameSaveDescriptor* save) {
+    if (engine == NULL) {
+        return false;
+    }
+
+    uint32_t start_us = get_current_us();
+    const SnapshotState* state = (save != NULL) ? find_snapshot(key, save) : NULL;
+
+    // Init lays the arena out as it was when the snapshot was taken
+    game_engine_init_seeded(engine, get_random());
+    if (state == NULL) {
+        return false;
+    }
+    if (game_arena_used() != state->header.arena_used) {
+        DEBUG_PRINTF(false, "Save: Arena layout of game %u changed, starting fresh\r\n", (unsigned)key);
+        stats.rejected++;
+        return false;
+    }
+
+    // Snapshot is in flash, memory-mapped - copy straight back into place
+    memcpy(&engine->base_state, &state->base_state, sizeof(engine->base_state));
+    engine->base_state.paused = false;       // Resumed games run straight away
+    engine->base_state.is_reset = false;
+    engine->countdown_over = false;
+    engine->return_to_main_menu = false;
+
+    memcpy(&game_timers, &state->timers, sizeof(game_timers));
+    game_timers.paused = true;      // Time spent powered off is skipped on the next update
+    memcpy(&game_random, &state->random, sizeof(game_random));
+
+    const uint8_t* cursor = (const uint8_t*)state + sizeof(SnapshotState);
+    memcpy(game_arena_data(), cursor, state->header.arena_used);
+    cursor += state->header.arena_used;
+    for (uint8_t i = 0; i < save->region_count; i++) {
+        memcpy(save->regions[i].data, cursor, save->regions[i].size);
+        cursor += save->regions[i].size;
+    }
+
+    // A recording that started from the seed cannot reach this state
+    replay_record_stop();
+
+    if (save->on_restore) {
+        save->on_restore();
+    }
+
+    stats.restores++;
+    stats.restore_us = get_current_us() - start_us;
+    DEBUG_PRINTF(false, "Save: Game %u resumed from %lu bytes in %lu us\r\n", (unsigned)key,
+        (unsigned long)(sizeof(SnapshotState) + state->header.arena_used + state->header.region_bytes),
+        (unsigned long)stats.restore_us);
+    return true;
+}
+
+void game_save_discard(uint16_t key) {
+    if (!save_store_remove(key)) {
+        discard_key = key;      // Written after the save in progress
+    }
+}
+
+bool game_save_latest(uint16_t* key) {
+    SaveRecord record;
+
+    if (!save_store_latest(&record) || record.length == 0) {
+        return false;
+    }
+    *key = record.key;
+    return true;
+}
+
+bool game_save_service(bool game_active) {
+    if (save_store_busy()) {
+        uint32_t start_us = get_current_us();
+        uint32_t failures = save_store_get_stats()->write_failures;
+        bool more = save_store_step(GAME_SAVE_STEP_WORDS);
+
+        if (writing_snapshot) {
+            stats.write_us += get_current_us() - start_us;
+            stats.write_steps++;
+            if (!more) {
+                writing_snapshot = false;
+            }
+            if (!more && save_store_get_stats()->write_failures == failures) {
+                stats.saves++;
+                DEBUG_PRINTF(false, "Save: %lu bytes, capture %lu us, write %lu us over %u steps\r\n",
+                    (unsigned long)stats.snapshot_bytes, (unsigned long)stats.capture_us,
+                    (unsigned long)stats.write_us, (unsigned)stats.write_steps);
+            }
+        }
+        return more || discard_key != NO_KEY;
+    }
+
+    if (discard_key != NO_KEY && save_store_remove(discard_key)) {
+        discard_key = NO_KEY;
+        return true;
+    }
+
+    // Erasing stalls the CPU, only while no game is on screen
+    if (!game_active && save_store_needs_compaction()) {
+        save_store_compact();
+    }
+    return false;
+}
+
+const GameSaveStats* game_save_get_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,286 @@
+/*
+ * game_engine_timer.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Game_Engine/game_engine_timer.h"
+#include <string.h>
+
+TimerWheel game_timers;
+
+#define NO_LINK     TIMER_WHEEL_MAX_TIMERS
+#define SLOT_MASK   (TIMER_WHEEL_SLOTS - 1)
+
+// Wrap-safe "a is after b" on the tick counter
+static inline bool tick_after(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) > 0;
+}
+
+static uint32_t to_ticks(uint32_t ms) {
+    uint32_t ticks = (ms + TIMER_WHEEL_TICK_MS - 1) / TIMER_WHEEL_TICK_MS;
+
+    // Never the tick being processed, or a callback could re-arm itself forever
+    if (ticks == 0) {
+        ticks = 1;
+    }
+    if (ticks > TIMER_WHEEL_MAX_TICKS) {
+        ticks = TIMER_WHEEL_MAX_TICKS;
+    }
+    return ticks;
+}
+
+static WheelTimer* lookup(const TimerWheel* wheel, timer_id_t id) {
+    uint8_t index = id & 0xFF;
+
+    if (index >= TIMER_WHEEL_MAX_TIMERS) {
+        return NULL;
+    }
+
+    const WheelTimer* timer = &wheel->timers[index];
+    if (!timer->active || timer->generation != (uint8_t)(id >> 8)) {
+        return NULL;
+    }
+    return (WheelTimer*)timer;
+}
+
+// File the timer in the lowest level whose span covers its expiry
+static void link_timer(TimerWheel* wheel, uint8_t index) {
+    WheelTimer* timer = &wheel->timers[index];
+    uint32_t delta = timer->expires - wheel->tick;
+    uint8_t level = 0;
+
+    // Only a cascade can hand over a timer that is already due - it fires this tick
+    if ((int32_t)delta < 0) {
+        timer->expires = wheel->tick;
+        delta = 0;
+    }
+
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (1UL << (TIMER_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+
+    uint8_t slot = level * TIMER_WHEEL_SLOTS + ((timer->expires >> (TIMER_WHEEL_BITS * level)) & SLOT_MASK);
+    timer->slot = slot;
+    timer->prev = NO_LINK;
+    timer->next = wheel->slots[slot];
+    if (timer->next != NO_LINK) {
+        wheel->timers[timer->next].prev = index;
+    }
+    wheel->slots[slot] = index;
+}
+
+static void unlink_timer(TimerWheel* wheel, uint8_t index) {
+    WheelTimer* timer = &wheel->timers[index];
+
+    if (timer->prev != NO_LINK) {
+        wheel->timers[timer->prev].next = timer->next;
+    }
+    else {
+        wheel->slots[timer->slot] = timer->next;
+    }
+    if (timer->next != NO_LINK) {
+        wheel->timers[timer->next].prev = timer->prev;
+    }
+}
+
+static void release_timer(TimerWheel* wheel, uint8_t index) {
+    WheelTimer* timer = &wheel->timers[index];
+
+    timer->active = false;
+    timer->generation++;
+    timer->next = wheel->free_head;
+    wheel->free_head = index;
+    wheel->active_count--;
+}
+
+// Move every timer of an upper slot down to where it now belongs
+static void cascade(TimerWheel* wheel, uint8_t level) {
+    uint8_t slot = level * TIMER_WHEEL_SLOTS + ((wheel->tick >> (TIMER_WHEEL_BITS * level)) & SLOT_MASK);
+    uint8_t index = wheel->slots[slot];
+
+    wheel->slots[slot] = NO_LINK;
+    while (index != NO_LINK) {
+        uint8_t next = wheel->timers[index].next;
+        link_timer(wheel, index);
+        index = next;
+    }
+}
+
+static uint8_t run_tick(TimerWheel* wheel) {
+    uint32_t tick = ++wheel->tick;
+    uint8_t top = 0;
+    uint8_t fired = 0;
+
+    // Every 64 ticks the next level-1 slot comes due, every 4096 the next level-2 slot
+    while (top < TIMER_WHEEL_LEVELS - 1 && (tick & ((1UL << (TIMER_WHEEL_BITS * (top + 1))) - 1)) == 0) {
+        top++;
+    }
+    for (uint8_t level = top; level > 0; level--) {
+        cascade(wheel, level);
+    }
+
+    // Everything left in this slot expires on this tick
+    uint8_t slot = tick & SLOT_MASK;
+    while (wheel->slots[slot] != NO_LINK) {
+        uint8_t index = wheel->slots[slot];
+        WheelTimer* timer = &wheel->timers[index];
+        timer_callback_t callback = timer->callback;
+        void* context = timer->context;
+
+        unlink_timer(wheel, index);
+
+        // Re-armed or released before the callback, so it may cancel or restart itself
+        if (timer->period != 0) {
+            timer->expires += timer->period;
+            link_timer(wheel, index);
+        }
+        else {
+            release_timer(wheel, index);
+        }
+
+        callback(context);
+        fired++;
+    }
+    return fired;
+}
+
+void timer_wheel_init(TimerWheel* wheel, uint32_t now_ms) {
+    // Generations carry over, so ids handed out before the reset stay stale
+    for (uint8_t i = 0; i < TIMER_WHEEL_MAX_TIMERS; i++) {
+        uint8_t generation = wheel->timers[i].generation + 1;
+        memset(&wheel->timers[i], 0, sizeof(WheelTimer));
+        wheel->timers[i].generation = generation;
+        wheel->timers[i].next = i + 1;   // The last one ends on NO_LINK
+    }
+
+    memset(wheel->slots, NO_LINK, sizeof(wheel->slots));
+    wheel->tick = 0;
+    wheel->last_ms = now_ms;
+    wheel->free_head = 0;
+    wheel->active_count = 0;
+    wheel->paused = false;
+}
+
+uint8_t timer_wheel_advance(TimerWheel* wheel, uint32_t now_ms) {
+    if (wheel->paused) {
+        wheel->last_ms = now_ms;
+        return 0;
+    }
+
+    uint32_t ticks = (now_ms - wheel->last_ms) / TIMER_WHEEL_TICK_MS;
+    uint8_t fired = 0;
+
+    // Time past the cap is skipped, the timers move back with it like after a pause
+    if (ticks > TIMER_WHEEL_MAX_CATCHUP_MS / TIMER_WHEEL_TICK_MS) {
+        ticks = TIMER_WHEEL_MAX_CATCHUP_MS / TIMER_WHEEL_TICK_MS;
+        wheel->last_ms = now_ms - ticks * TIMER_WHEEL_TICK_MS;
+    }
+
+    wheel->last_ms += ticks * TIMER_WHEEL_TICK_MS;
+    while (ticks > 0) {
+        // Nothing to expire or cascade, skip the rest of the gap
+        if (wheel->active_count == 0) {
+            wheel->tick += ticks;
+            break;
+        }
+        fired += run_tick(wheel);
+        ticks--;
+    }
+    return fired;
+}
+
+void timer_wheel_pause(TimerWheel* wheel) {
+    wheel->paused = true;
+}
+
+void timer_wheel_resume(TimerWheel* wheel, uint32_t now_ms) {
+    if (wheel->paused) {
+        wheel->paused = false;
+        wheel->last_ms = now_ms;
+    }
+}
+
+timer_id_t timer_start(TimerWheel* wheel, uint32_t delay_ms, uint32_t period_ms,
+                       timer_callback_t callback, void* context) {
+    uint8_t index = wheel->free_head;
+
+    if (callback == NULL || index == NO_LINK) {
+        return TIMER_NONE;
+    }
+
+    WheelTimer* timer = &wheel->timers[index];
+    wheel->free_head = timer->next;
+    wheel->active_count++;
+
+    timer->callback = callback;
+    timer->context = context;
+    timer->expires = wheel->tick + to_ticks(delay_ms);
+    timer->period = (period_ms != 0) ? to_ticks(period_ms) : 0;
+    timer->active = true;
+    link_timer(wheel, index);
+
+    return ((timer_id_t)timer->generation << 8) | index;
+}
+
+bool timer_cancel(TimerWheel* wheel, timer_id_t id) {
+    if (lookup(wheel, id) == NULL) {
+        return false;
+    }
+
+    uint8_t index = id & 0xFF;
+    unlink_timer(wheel, index);
+    release_timer(wheel, index);
+    return true;
+}
+
+bool timer_restart(TimerWheel* wheel, timer_id_t id, uint32_t delay_ms) {
+    WheelTimer* timer = lookup(wheel, id);
+    if (timer == NULL) {
+        return false;
+    }
+
+    uint8_t index = id & 0xFF;
+    unlink_timer(wheel, index);
+    timer->expires = wheel->tick + to_ticks(delay_ms);
+    link_timer(wheel, index);
+    return true;
+}
+
+bool timer_set_period(TimerWheel* wheel, timer_id_t id, uint32_t period_ms) {
+    WheelTimer* timer = lookup(wheel, id);
+    if (timer == NULL || timer->period == 0) {
+        return false;
+    }
+
+    uint32_t period = to_ticks(period_ms);
+    if (period == timer->period) {
+        return true;
+    }
+
+    // Keep the start of the running period, fire on the next tick if that is already past
+    uint32_t expires = timer->expires - timer->period + period;
+    if (!tick_after(expires, wheel->tick)) {
+        expires = wheel->tick + 1;
+    }
+
+    uint8_t index = id & 0xFF;
+    unlink_timer(wheel, index);
+    timer->period = period;
+    timer->expires = expires;
+    link_timer(wheel, index);
+    return true;
+}
+
+bool timer_is_active(const TimerWheel* wheel, timer_id_t id) {
+    return lookup(wheel, id) != NULL;
+}
+
+uint32_t timer_remaining_ms(const TimerWheel* wheel, timer_id_t id) {
+    const WheelTimer* timer = lookup(wheel, id);
+    if (timer == NULL) {
+        return 0;
+    }
+    return (timer->expires - wheel->tick) * TIMER_WHEEL_TICK_MS;
+}
@@ -0,0 +1,197 @@
+/*
+ * game_engine_viewport.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Game_Engine/game_engine_viewport.h"
+#include <stdlib.h>
+
+// Round a non-negative pixel position to tile boundaries
+static int32_t snap_down(int32_t value, uint8_t tile_size) {
+    return (value / tile_size) * tile_size;
+}
+
+static int32_t snap_up(int32_t value, uint8_t tile_size) {
+    return ((value + tile_size - 1) / tile_size) * tile_size;
+}
+
+// Camera position on one axis that keeps the target inside the dead zone.
+// Moves that the display can't scroll in hardware repaint the whole window anyway,
+// so those recenter on the target instead of creeping one tile at a time.
+static int32_t follow_axis(int32_t cam, int32_t pos, coord_t size, coord_t view, coord_t margin,
+    int32_t world, uint8_t tile_size, bool recenter) {
+    if (world <= view) {
+        return 0;
+    }
+
+    bool before = pos < cam + margin;
+    bool after = pos + size > cam + view - margin;
+    if (!before && !after) {
+        return cam;
+    }
+
+    if (recenter) {
+        cam = pos + size / 2 - view / 2;
+        cam = (cam < 0) ? 0 : snap_down(cam, tile_size);
+    }
+    else if (before) {
+        cam = pos - margin;
+        cam = (cam < 0) ? 0 : snap_down(cam, tile_size);
+    }
+    else {
+        cam = snap_up(pos + size - view + margin, tile_size);
+    }
+
+    return (cam > world - view) ? world - view : cam;
+}
+
+// Clear and repaint a block of tiles that lies inside the window
+static void draw_tiles(const Viewport* vp, uint16_t first_col, uint16_t last_col,
+    uint16_t first_row, uint16_t last_row) {
+    const Tilemap* map = vp->map;
+    uint8_t ts = map->tile_size;
+
+    display_clear_region(viewport_to_screen_x(vp, first_col * ts), viewport_to_screen_y(vp, first_row * ts),
+        (last_col - first_col + 1) * ts, (last_row - first_row + 1) * ts);
+
+    if (map->draw_tile == NULL) {
+        return;
+    }
+
+    for (uint16_t row = first_row; row <= last_row; row++) {
+        const uint8_t* tile_row = &map->tiles[row * map->stride];
+        for (uint16_t col = first_col; col <= last_col; col++) {
+            map->draw_tile(tile_row[col],
+                viewport_to_screen_x(vp, col * ts),
+                viewport_to_screen_y(vp, row * ts));
+        }
+    }
+}
+
+// Repaint a full-width band of world rows - only the tiles under the window are visited,
+// whatever the size of the map
+static void draw_band(const Viewport* vp, int32_t world_y, coord_t rows) {
+    uint8_t ts = vp->map->tile_size;
+
+    draw_tiles(vp, vp->cam_x / ts, (vp->cam_x + vp->width - 1) / ts,
+        world_y / ts, (world_y + rows - 1) / ts);
+}
+
+void viewport_init(Viewport* vp, const Tilemap* map, coord_t area_x, coord_t area_y,
+    coord_t area_width, coord_t area_height) {
+    uint8_t ts = map->tile_size;
+    int32_t world_width = map->width * ts;
+    int32_t world_height = map->height * ts;
+    int32_t width = snap_down(area_width, ts);
+    int32_t height = snap_down(area_height, ts);
+
+    vp->map = map;
+    vp->width = (width < world_width) ? width : world_width;
+    vp->height = (height < world_height) ? height : world_height;
+
+    // Centre the window in the area it was given
+    vp->screen_x = area_x + (area_width - vp->width) / 2;
+    vp->screen_y = area_y + (area_height - vp->height) / 2;
+
+    vp->cam_x = 0;
+    vp->cam_y = 0;
+    vp->drawn_cam_x = 0;
+    vp->drawn_cam_y = 0;
+    vp->margin_x = snap_down(vp->width / 4, ts);
+    vp->margin_y = snap_down(vp->height / 4, ts);
+    vp->scroll_offset = 0;
+    vp->needs_full_redraw = true;
+
+    // Hardware scrolling shifts whole display rows, so the window's rows become the scrolling area
+    vp->hw_scroll = display_has_hw_scroll() && (world_height > vp->height);
+    if (vp->hw_scroll) {
+        display_set_scroll_area(vp->screen_y, vp->height);
+    }
+}
+
+void viewport_cleanup(Viewport* vp) {
+    if (vp->hw_scroll) {
+        display_reset_scroll();
+    }
+    vp->hw_scroll = false;
+    vp->scroll_offset = 0;
+    vp->needs_full_redraw = true;
+}
+
+void viewport_follow(Viewport* vp, int32_t world_x, int32_t world_y, coord_t width, coord_t height) {
+    const Tilemap* map = vp->map;
+    uint8_t ts = map->tile_size;
+
+    vp->cam_x = follow_axis(vp->cam_x, world_x, width, vp->width, vp->margin_x,
+        map->width * ts, ts, true);
+    vp->cam_y = follow_axis(vp->cam_y, world_y, height, vp->height, vp->margin_y,
+        map->height * ts, ts, !vp->hw_scroll);
+}
+
+void viewport_invalidate(Viewport* vp) {
+    vp->needs_full_redraw = true;
+}
+
+bool viewport_render(Viewport* vp) {
+    int32_t dx = vp->cam_x - vp->drawn_cam_x;
+    int32_t dy = vp->cam_y - vp->drawn_cam_y;
+
+    if (!vp->needs_full_redraw && dx == 0 && dy == 0) {
+        return false;
+    }
+
+    if (!vp->needs_full_redraw && dx == 0 && vp->hw_scroll && abs(dy) < vp->height) {
+        // Let the controller shift the window, then paint only the rows scrolled into view
+        vp->scroll_offset = (vp->scroll_offset + vp->height + dy) % vp->height;
+        display_set_scroll_offset(vp->scroll_offset);
+
+        if (dy > 0) {
+            draw_band(vp, vp->cam_y + vp->height - dy, dy);
+        }
+        else {
+            draw_band(vp, vp->cam_y, -dy);
+        }
+    }
+    else {
+        draw_band(vp, vp->cam_y, vp->height);
+    }
+
+    vp->drawn_cam_x = vp->cam_x;
+    vp->drawn_cam_y = vp->cam_y;
+    vp->needs_full_redraw = false;
+    return true;
+}
+
+bool viewport_is_visible(const Viewport* vp, int32_t world_x, int32_t world_y, coord_t width, coord_t height) {
+    return world_x >= vp->cam_x && world_x + width <= vp->cam_x + vp->width &&
+        world_y >= vp->cam_y && world_y + height <= vp->cam_y + vp->height;
+}
+
+coord_t viewport_to_screen_x(const Viewport* vp, int32_t world_x) {
+    return (coord_t)(vp->screen_x + (world_x - vp->cam_x));
+}
+
+coord_t viewport_to_screen_y(const Viewport* vp, int32_t world_y) {
+    return (coord_t)(vp->screen_y + (world_y - vp->cam_y));
+}
+
+// Repaint the tiles under a world rectangle, e.g. where a sprite was last frame.
+// The camera and window are tile aligned, so visible tiles are always whole.
+void viewport_redraw_world_rect(const Viewport* vp, int32_t world_x, int32_t world_y, coord_t width, coord_t height) {
+    uint8_t ts = vp->map->tile_size;
+    int32_t x1 = (world_x > vp->cam_x) ? world_x : vp->cam_x;
+    int32_t y1 = (world_y > vp->cam_y) ? world_y : vp->cam_y;
+    int32_t x2 = world_x + width;
+    int32_t y2 = world_y + height;
+
+    if (x2 > vp->cam_x + vp->width) x2 = vp->cam_x + vp->width;
+    if (y2 > vp->cam_y + vp->height) y2 = vp->cam_y + vp->height;
+
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+
+    draw_tiles(vp, x1 / ts, (x2 - 1) / ts, y1 / ts, (y2 - 1) / ts);
+}
@@ -0,0 +1,112 @@
+/*
+ * game_registry.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Game_Engine/game_registry.h"
+#include "Game_Engine/game_engine_arena.h"
+#include "Utils/debug_conf.h"
+
+// Bounds of the game_registry section, from the linker script (GNU ld also provides them
+// for any section named like a C identifier, which the host test build relies on)
+extern const GameDescriptor __start_game_registry[];
+extern const GameDescriptor __stop_game_registry[];
+
+static uint16_t assets_loaded_mask = 0;   // Bit per descriptor index
+static uint8_t asset_pool[GAME_ASSET_POOL_SIZE] __attribute__((aligned(GAME_ARENA_ALIGN)));
+static size_t asset_pool_used = 0;
+
+uint8_t game_registry_count(void) {
+    return (uint8_t)(__stop_game_registry - __start_game_registry);
+}
+
+const GameDescriptor* game_registry_get(uint8_t index) {
+    return (index < game_registry_count()) ? &__start_game_registry[index] : NULL;
+}
+
+const GameDescriptor* game_registry_find(ScreenType screen) {
+    for (const GameDescriptor* game = __start_game_registry; game < __stop_game_registry; game++) {
+        if (game->screen == screen) {
+            return game;
+        }
+    }
+    return NULL;
+}
+
+uint8_t game_registry_build_menu(GameMode mode, MenuItem* items, uint8_t max_items) {
+    uint8_t count = 0;
+
+    if (items == NULL) {
+        return 0;
+    }
+
+    // Insertion sort on menu_order - there are only a handful of games
+    for (const GameDescriptor* game = __start_game_registry; game < __stop_game_registry; game++) {
+        if (game->mode != mode || count >= max_items) {
+            continue;
+        }
+
+        uint8_t slot = count;
+        while (slot > 0) {
+            const GameDescriptor* prev = game_registry_find(items[slot - 1].screen);
+            if (prev == NULL || prev->menu_order <= game->menu_order) {
+                break;
+            }
+            items[slot] = items[slot - 1];
+            slot--;
+        }
+
+        items[slot] = (MenuItem){ (char*)game->name, 0, game->screen, 1, game->mode };
+        count++;
+    }
+
+    return count;
+}
+
+bool game_registry_assets_loaded(const GameDescriptor* game) {
+    uint8_t index = (uint8_t)(game - __start_game_registry);
+    return index < GAME_REGISTRY_MAX_GAMES && (assets_loaded_mask & (1u << index)) != 0;
+}
+
+GameEngine* game_registry_prepare(ScreenType screen) {
+    const GameDescriptor* game = game_registry_find(screen);
+    if (game == NULL || game->engine == NULL) {
+        return NULL;
+    }
+
+    if (game->arena_size > GAME_ARENA_SIZE) {
+        DEBUG_PRINTF(false, "Game Registry: %s needs %u arena bytes, only %u available\r\n",
+            game->name, (unsigned)game->arena_size, (unsigned)GAME_ARENA_SIZE);
+        return NULL;
+    }
+
+    // Assets are built on first use and kept for the rest of the boot
+    uint8_t index = (uint8_t)(game - __start_game_registry);
+    if (index < GAME_REGISTRY_MAX_GAMES && !game_registry_assets_loaded(game)) {
+        if (game->load_assets != NULL) {
+            game->load_assets();
+        }
+        assets_loaded_mask |= (uint16_t)(1u << index);
+    }
+
+    // The descriptor is the one place the input and mode are declared
+    game->engine->is_d_pad_game = (game->input == GAME_INPUT_DPAD);
+    game->engine->is_mp_game = (game->mode == GAME_MODE_MULTIPLAYER);
+
+    return game->engine;
+}
+
+void* game_registry_asset_alloc(size_t size) {
+    size_t aligned_size = GAME_ARENA_BLOCK(size);
+
+    if (aligned_size > GAME_ASSET_POOL_SIZE - asset_pool_used) {
+        DEBUG_PRINTF(false, "Game Registry: Asset pool full, %u bytes requested\r\n", (unsigned)size);
+        return NULL;
+    }
+
+    void* block = &asset_pool[asset_pool_used];
+    asset_pool_used += aligned_size;
+    return block;
+}
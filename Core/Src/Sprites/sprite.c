@@ -7,6 +7,7 @@
 
 #include "Sprites/sprite.h"
 #include <math.h>
+#include <string.h>
 #include <Utils/misc_utils.h>  // For get_current_ms()
 
 void sprite_draw(const Sprite* sprite, uint16_t x, uint16_t y, DisplayColor color) {
@@ -37,6 +38,76 @@ void sprite_draw_rotated(const Sprite* sprite, uint16_t x, uint16_t y, uint16_t
     }
 }
 
+size_t sprite_rotations_size(const Sprite* frames, uint8_t num_frames) {
+    size_t bitmap_bytes = ((frames[0].width + 7) / 8) * frames[0].height;
+    return 3 * num_frames * (sizeof(Sprite) + bitmap_bytes);
+}
+
+// Rotate one square frame clockwise by quarter_turns into dest
+static void rotate_bitmap(const Sprite* sprite, uint8_t quarter_turns, uint8_t* dest) {
+    uint8_t size = sprite->width;
+    uint8_t stride = (size + 7) / 8;
+
+    memset(dest, 0, stride * size);
+    for (uint8_t sy = 0; sy < size; sy++) {
+        for (uint8_t sx = 0; sx < size; sx++) {
+            if (!(sprite->bitmap[sy * stride + sx / 8] & (1 << (7 - (sx % 8))))) {
+                continue;
+            }
+
+            uint8_t rx, ry;
+            switch (quarter_turns) {
+            case 1:  rx = size - 1 - sy; ry = sx;               break;
+            case 2:  rx = size - 1 - sx; ry = size - 1 - sy;    break;
+            default: rx = sy;            ry = size - 1 - sx;    break;
+            }
+            dest[ry * stride + rx / 8] |= (uint8_t)(1 << (7 - (rx % 8)));
+        }
+    }
+}
+
+bool sprite_rotations_build(RotatedSprite* rotated, const Sprite* frames, uint8_t num_frames, void* buffer) {
+    if (buffer == NULL || num_frames == 0) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < num_frames; i++) {
+        if (frames[i].width != frames[0].width || frames[i].height != frames[0].width) {
+            return false;
+        }
+    }
+
+    // Sprite headers first, then the bitmaps they point at
+    Sprite* turns = (Sprite*)buffer;
+    uint8_t* bitmaps = (uint8_t*)&turns[3 * num_frames];
+    size_t bitmap_bytes = ((frames[0].width + 7) / 8) * frames[0].height;
+
+    for (uint8_t turn = 1; turn <= 3; turn++) {
+        for (uint8_t i = 0; i < num_frames; i++) {
+            Sprite* dest = &turns[(turn - 1) * num_frames + i];
+            rotate_bitmap(&frames[i], turn, bitmaps);
+            dest->bitmap = bitmaps;
+            dest->width = frames[i].width;
+            dest->height = frames[i].height;
+            bitmaps += bitmap_bytes;
+        }
+    }
+
+    rotated->source = frames;
+    rotated->turns = turns;
+    rotated->num_frames = num_frames;
+    return true;
+}
+
+const Sprite* sprite_rotation_get(const RotatedSprite* rotated, uint8_t frame, uint16_t angle) {
+    if (rotated->turns == NULL || frame >= rotated->num_frames || angle % 90 != 0) {
+        return NULL;
+    }
+
+    uint8_t turn = (angle / 90) % 4;
+    return (turn == 0) ? &rotated->source[frame] : &rotated->turns[(turn - 1) * rotated->num_frames + frame];
+}
+
 void sprite_draw_scaled(const Sprite* sprite, uint16_t x, uint16_t y, float scale, DisplayColor color) {
     uint16_t scaled_width = (uint16_t)(sprite->width * scale);
     uint16_t scaled_height = (uint16_t)(sprite->height * scale);
@@ -68,6 +139,18 @@ void animated_sprite_update(AnimatedSprite* sprite) {
     }
 }
 
+static void animated_sprite_next_frame(void* context) {
+    AnimatedSprite* sprite = (AnimatedSprite*)context;
+    sprite->current_frame = (sprite->current_frame + 1) % sprite->num_frames;
+}
+
+timer_id_t animated_sprite_start(AnimatedSprite* sprite, TimerWheel* wheel) {
+    if (sprite == NULL || sprite->num_frames == 0) {
+        return TIMER_NONE;
+    }
+    return timer_start(wheel, sprite->frame_delay, sprite->frame_delay, animated_sprite_next_frame, sprite);
+}
+
 void animated_sprite_draw(const AnimatedSprite* sprite, uint16_t x, uint16_t y, DisplayColor color) {
     sprite_draw(&sprite->frames[sprite->current_frame], x, y, color);
 }
@@ -3,6 +3,8 @@
  *
  *  Created on: Dec 6, 2024
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Added the USART2 RX and TX streams
  */
 
 
@@ -11,16 +13,24 @@
 DMA_HandleTypeDef hdma_adc1;
 DMA_HandleTypeDef hdma_dac1;
 DMA_HandleTypeDef hdma_spi1_tx;
+DMA_HandleTypeDef hdma_usart2_rx;
+DMA_HandleTypeDef hdma_usart2_tx;
 
 void MX_DMA_Init(void)
 {
-  __HAL_RCC_DMA1_CLK_ENABLE();  // For DAC
+  __HAL_RCC_DMA1_CLK_ENABLE();  // For DAC and USART2
   __HAL_RCC_DMA2_CLK_ENABLE();  // For ADC
 
   // Configure the NVIC for DMA
   HAL_NVIC_SetPriority(DMA1_Stream5_IRQn, 0, 0);  // For DAC
   HAL_NVIC_EnableIRQ(DMA1_Stream5_IRQn);          // For DAC
 
+  HAL_NVIC_SetPriority(DMA1_Stream6_IRQn, 0, 0);  // For USART2 TX
+  HAL_NVIC_EnableIRQ(DMA1_Stream6_IRQn);          // For USART2 TX
+
+  HAL_NVIC_SetPriority(DMA1_Stream7_IRQn, 0, 0);  // For USART2 RX
+  HAL_NVIC_EnableIRQ(DMA1_Stream7_IRQn);          // For USART2 RX
+
   HAL_NVIC_SetPriority(DMA2_Stream0_IRQn, 0, 0);  // For ADC
   HAL_NVIC_EnableIRQ(DMA2_Stream0_IRQn);          // For ADC
 
@@ -3,6 +3,8 @@
  *
  *  Created on: Dec 6, 2024
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      D-pad lines are plain inputs scanned from SysTick, their EXTI lines are no longer enabled
  */
 
 #include "System/Peripherals/gpio_conf.h"
@@ -65,7 +67,7 @@ void MX_GPIO_Init(void)
 
   /*Configure GPIO pins : PE9 PE11 PE13 */
   GPIO_InitStruct.Pin = GPIO_PIN_9 | GPIO_PIN_11 | GPIO_PIN_13;
-  GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
+  GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
   GPIO_InitStruct.Pull = GPIO_PULLDOWN;
   HAL_GPIO_Init(GPIOE, &GPIO_InitStruct);
 
@@ -91,7 +93,7 @@ void MX_GPIO_Init(void)
 
   /*Configure GPIO pin : PG14 */
   GPIO_InitStruct.Pin = GPIO_PIN_14;
-  GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
+  GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
   GPIO_InitStruct.Pull = GPIO_PULLDOWN;
   HAL_GPIO_Init(GPIOG, &GPIO_InitStruct);
 
@@ -102,12 +104,8 @@ void MX_GPIO_Init(void)
 //  HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
 
-  /* EXTI interrupt init*/
-  HAL_NVIC_SetPriority(EXTI9_5_IRQn, 0, 0);
-  HAL_NVIC_EnableIRQ(EXTI9_5_IRQn);
-
-  HAL_NVIC_SetPriority(EXTI15_10_IRQn, 0, 0);
-  HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
+  // No EXTI interrupts - the D-pad is sampled by pb_scan(), so contact bounce can no
+  // longer fire a burst of interrupts
 
 }
 
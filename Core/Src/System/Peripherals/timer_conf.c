@@ -3,49 +3,58 @@
  *
  *  Created on: Dec 15, 2024
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      TIM3 replaces TIM6 as the joystick ADC trigger
  */
 
 #include "System/Peripherals/timer_conf.h"
 
-TIM_HandleTypeDef htim6;
+TIM_HandleTypeDef htim3;
 TIM_HandleTypeDef htim4;
 
 /**
-  * @brief TIM6 Initialization Function
+  * @brief TIM3 Initialization Function
   * @param None
   * @retval None
   */
-void MX_TIM6_Init(void)
+void MX_TIM3_Init(void)
 {
 
-  /* USER CODE BEGIN TIM6_Init 0 */
-	__HAL_RCC_TIM6_CLK_ENABLE();
-  /* USER CODE END TIM6_Init 0 */
+  /* USER CODE BEGIN TIM3_Init 0 */
+	__HAL_RCC_TIM3_CLK_ENABLE();
+  /* USER CODE END TIM3_Init 0 */
 
+  TIM_ClockConfigTypeDef sClockSourceConfig = {0};
   TIM_MasterConfigTypeDef sMasterConfig = {0};
 
-  /* USER CODE BEGIN TIM6_Init 1 */
+  /* USER CODE BEGIN TIM3_Init 1 */
 
-  /* USER CODE END TIM6_Init 1 */
-  htim6.Instance = TIM6;
-  htim6.Init.Prescaler = 95; // Since APB1 clock is at 96 MHz
-  htim6.Init.CounterMode = TIM_COUNTERMODE_UP;
-  htim6.Init.Period = 9999;
-  htim6.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
-  if (HAL_TIM_Base_Init(&htim6) != HAL_OK)
+  /* USER CODE END TIM3_Init 1 */
+  htim3.Instance = TIM3;
+  htim3.Init.Prescaler = 95; // Since APB1 clock is at 96 MHz
+  htim3.Init.CounterMode = TIM_COUNTERMODE_UP;
+  htim3.Init.Period = (1000000 / JOYSTICK_SAMPLE_RATE_HZ) - 1;
+  htim3.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  htim3.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+  if (HAL_TIM_Base_Init(&htim3) != HAL_OK)
   {
     Error_Handler();
   }
-  sMasterConfig.MasterOutputTrigger = TIM_TRGO_RESET;
+  sClockSourceConfig.ClockSource = TIM_CLOCKSOURCE_INTERNAL;
+  if (HAL_TIM_ConfigClockSource(&htim3, &sClockSourceConfig) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  // Update event on TRGO starts an ADC1 conversion sequence, no interrupt is needed
+  sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
   sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
-  if (HAL_TIMEx_MasterConfigSynchronization(&htim6, &sMasterConfig) != HAL_OK)
+  if (HAL_TIMEx_MasterConfigSynchronization(&htim3, &sMasterConfig) != HAL_OK)
   {
     Error_Handler();
   }
-  /* USER CODE BEGIN TIM6_Init 2 */
-   HAL_NVIC_SetPriority(TIM6_DAC_IRQn, 0, 0);
-   HAL_NVIC_EnableIRQ(TIM6_DAC_IRQn);
-  /* USER CODE END TIM6_Init 2 */
+  /* USER CODE BEGIN TIM3_Init 2 */
+
+  /* USER CODE END TIM3_Init 2 */
 
 }
 
@@ -0,0 +1,394 @@
+/*
+ * save_store.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "System/save_store.h"
+#include "Console_Peripherals/Hardware/Drivers/flash_driver.h"
+#include "Utils/debug_conf.h"
+#include <string.h>
+
+#define SECTOR_MAGIC        0x31564153UL    // "SAV1"
+#define RECORD_MAGIC        0x31434552UL    // "REC1"
+#define COMMIT_MAGIC        0x544D4F43UL    // "COMT"
+
+// Sector: magic, generation, then records
+#define SECTOR_HEADER_SIZE  8
+// Record: magic, key | version << 16, sequence, length, CRC-32 of the payload,
+// the payload padded to whole words with 0xFF, then the commit word
+#define RECORD_HEADER_WORDS 5
+#define RECORD_HEADER_SIZE  (RECORD_HEADER_WORDS * 4)
+
+typedef enum {
+    SCAN_END,           // Erased, the log ends here
+    SCAN_RECORD,        // Committed record
+    SCAN_TORN,          // Header intact but never committed, skipped
+    SCAN_CORRUPT        // Nothing after this can be trusted
+} ScanResult;
+
+typedef struct {
+    bool active;
+    uint32_t base;                  // Offset of the record in the active sector
+    uint32_t header[RECORD_HEADER_WORDS];
+    const uint8_t* data;
+    uint32_t length;
+    uint32_t payload_words;
+    uint32_t next;                  // Words programmed so far
+    uint32_t total;
+} PendingRecord;
+
+static uint8_t active_sector = 0;
+static uint32_t generation = 0;
+static uint32_t write_offset = SECTOR_HEADER_SIZE;
+static uint32_t next_sequence = 1;
+static bool sector_full = false;
+static PendingRecord pending;
+static SaveStoreStats stats;
+
+static uint32_t read_word(uint8_t sector, uint32_t offset) {
+    uint32_t word;
+    memcpy(&word, flash_driver_save_sector(sector) + offset, sizeof(word));
+    return word;
+}
+
+static uint32_t payload_words(uint32_t length) {
+    return (length + 3) / 4;
+}
+
+static uint32_t record_size(uint32_t length) {
+    return RECORD_HEADER_SIZE + payload_words(length) * 4 + 4;
+}
+
+// CRC-32 (IEEE), a nibble at a time from a 16-entry table
+static uint32_t crc32(const uint8_t* data, uint32_t length) {
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (uint32_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+static ScanResult scan_record(uint8_t sector, uint32_t offset, SaveRecord* record) {
+    // No record is started where an empty one would not fit
+    if (offset + RECORD_HEADER_SIZE + 4 > FLASH_SAVE_SECTOR_SIZE) {
+        return SCAN_END;
+    }
+
+    uint32_t words[RECORD_HEADER_WORDS];
+    for (uint8_t i = 0; i < RECORD_HEADER_WORDS; i++) {
+        words[i] = read_word(sector, offset + i * 4);
+    }
+
+    if (words[0] != RECORD_MAGIC) {
+        // The magic is programmed after the rest of the header, an erased magic
+        // over a partly written header is a write cut short
+        bool erased = (words[0] == FLASH_ERASED_WORD);
+        for (uint8_t i = 1; i < RECORD_HEADER_WORDS && erased; i++) {
+            erased = (words[i] == FLASH_ERASED_WORD);
+        }
+        return erased ? SCAN_END : SCAN_CORRUPT;
+    }
+
+    uint32_t length = words[3];
+    if (length > FLASH_SAVE_SECTOR_SIZE || offset + record_size(length) > FLASH_SAVE_SECTOR_SIZE) {
+        return SCAN_CORRUPT;
+    }
+
+    record->key = (uint16_t)(words[1] & 0xFFFF);
+    record->version = (uint16_t)(words[1] >> 16);
+    record->sequence = words[2];
+    record->length = length;
+    record->data = flash_driver_save_sector(sector) + offset + RECORD_HEADER_SIZE;
+
+    uint32_t commit_offset = offset + RECORD_HEADER_SIZE + payload_words(length) * 4;
+    return (read_word(sector, commit_offset) == COMMIT_MAGIC) ? SCAN_RECORD : SCAN_TORN;
+}
+
+static bool record_intact(uint8_t sector, uint32_t offset, const SaveRecord* record) {
+    return crc32(record->data, record->length) == read_word(sector, offset + 16);
+}
+
+// Newest intact record of key in the active sector, or of any key when match_any
+static bool find_newest(uint16_t key, bool match_any, SaveRecord* record) {
+    uint32_t offset = SECTOR_HEADER_SIZE;
+    SaveRecord candidate;
+    bool found = false;
+
+    while (true) {
+        ScanResult result = scan_record(active_sector, offset, &candidate);
+        if (result == SCAN_END || result == SCAN_CORRUPT) {
+            break;
+        }
+        // Sequences rise along the log, so a later match is always newer
+        if (result == SCAN_RECORD && (match_any || candidate.key == key)
+            && record_intact(active_sector, offset, &candidate)) {
+            *record = candidate;
+            found = true;
+        }
+        offset += record_size(candidate.length);
+    }
+    return found;
+}
+
+// Walk the log to its end, counting what was cut short
+static void mount_sector(uint8_t sector) {
+    uint32_t offset = SECTOR_HEADER_SIZE;
+    SaveRecord record;
+
+    active_sector = sector;
+    generation = read_word(sector, 4);
+    next_sequence = 1;
+    sector_full = false;
+
+    while (true) {
+        ScanResult result = scan_record(sector, offset, &record);
+        if (result == SCAN_END) {
+            break;
+        }
+        if (result == SCAN_CORRUPT) {
+            // Appending after garbage would hide the new records, wait for compaction
+            sector_full = true;
+            stats.torn_records++;
+            break;
+        }
+        if (result == SCAN_TORN) {
+            stats.torn_records++;
+        }
+        if (record.sequence >= next_sequence) {
+            next_sequence = record.sequence + 1;
+        }
+        offset += record_size(record.length);
+    }
+
+    write_offset = offset;
+    stats.active_sector = sector;
+    stats.used_bytes = offset;
+}
+
+static bool format_sector(uint8_t sector, uint32_t new_generation) {
+    stats.erases++;
+    if (!flash_driver_erase_save_sector(sector)) {
+        return false;
+    }
+    // Generation first, the magic makes the sector valid
+    return flash_driver_program_word(sector, 4, new_generation)
+        && flash_driver_program_word(sector, 0, SECTOR_MAGIC);
+}
+
+bool save_store_init(void) {
+    memset(&stats, 0, sizeof(stats));
+    memset(&pending, 0, sizeof(pending));
+
+    bool valid[FLASH_SAVE_SECTOR_COUNT];
+    for (uint8_t sector = 0; sector < FLASH_SAVE_SECTOR_COUNT; sector++) {
+        valid[sector] = (read_word(sector, 0) == SECTOR_MAGIC);
+    }
+
+    if (valid[0] && valid[1]) {
+        // Compaction leaves the old sector valid until the next one, the newer generation wins
+        mount_sector((read_word(1, 4) > read_word(0, 4)) ? 1 : 0);
+    }
+    else if (valid[0] || valid[1]) {
+        mount_sector(valid[0] ? 0 : 1);
+    }
+    else {
+        DEBUG_PRINTF(false, "Save Store: No save data, formatting\r\n");
+        if (!format_sector(0, 1)) {
+            sector_full = true;
+            return false;
+        }
+        mount_sector(0);
+    }
+
+    DEBUG_PRINTF(false, "Save Store: Sector %u, generation %lu, %lu bytes used\r\n",
+        (unsigned)active_sector, (unsigned long)generation, (unsigned long)write_offset);
+    return true;
+}
+
+bool save_store_find(uint16_t key, SaveRecord* record) {
+    return find_newest(key, false, record);
+}
+
+bool save_store_latest(SaveRecord* record) {
+    return find_newest(0, true, record);
+}
+
+bool save_store_begin(uint16_t key, uint16_t version, const void* data, uint32_t length) {
+    if (pending.active || sector_full || (length > 0 && data == NULL)) {
+        return false;
+    }
+    if (write_offset + record_size(length) > FLASH_SAVE_SECTOR_SIZE) {
+        sector_full = true;
+        return false;
+    }
+
+    pending.base = write_offset;
+    pending.data = (const uint8_t*)data;
+    pending.length = length;
+    pending.payload_words = payload_words(length);
+    pending.header[0] = RECORD_MAGIC;
+    pending.header[1] = (uint32_t)key | ((uint32_t)version << 16);
+    pending.header[2] = next_sequence++;
+    pending.header[3] = length;
+    pending.header[4] = crc32(pending.data, length);
+    pending.next = 0;
+    pending.total = RECORD_HEADER_WORDS + pending.payload_words + 1;
+    pending.active = true;
+    return true;
+}
+
+bool save_store_remove(uint16_t key) {
+    return save_store_begin(key, 0, NULL, 0);
+}
+
+// Word n of the pending record in programming order: the header after its magic,
+// the magic, the payload, the commit word
+static void pending_word(uint32_t n, uint32_t* offset, uint32_t* value) {
+    if (n < RECORD_HEADER_WORDS - 1) {
+        *offset = pending.base + (n + 1) * 4;
+        *value = pending.header[n + 1];
+    }
+    else if (n == RECORD_HEADER_WORDS - 1) {
+        *offset = pending.base;
+        *value = pending.header[0];
+    }
+    else if (n < RECORD_HEADER_WORDS + pending.payload_words) {
+        uint32_t index = n - RECORD_HEADER_WORDS;
+        uint32_t remaining = pending.length - index * 4;
+        *value = FLASH_ERASED_WORD;
+        memcpy(value, pending.data + index * 4, (remaining < 4) ? remaining : 4);
+        *offset = pending.base + RECORD_HEADER_SIZE + index * 4;
+    }
+    else {
+        *offset = pending.base + RECORD_HEADER_SIZE + pending.payload_words * 4;
+        *value = COMMIT_MAGIC;
+    }
+}
+
+bool save_store_step(uint16_t max_words) {
+    for (uint16_t i = 0; i < max_words && pending.active; i++) {
+        uint32_t offset, value;
+        pending_word(pending.next, &offset, &value);
+
+        if (!flash_driver_program_word(active_sector, offset, value)) {
+            DEBUG_PRINTF(false, "Save Store: Write failed at 0x%lx\r\n", (unsigned long)offset);
+            // The record stays uncommitted, nothing more is appended until compaction
+            stats.write_failures++;
+            sector_full = true;
+            pending.active = false;
+            return false;
+        }
+
+        if (++pending.next == pending.total) {
+            write_offset += record_size(pending.length);
+            stats.records_written++;
+            stats.bytes_written += pending.length;
+            stats.used_bytes = write_offset;
+            pending.active = false;
+        }
+    }
+    return pending.active;
+}
+
+bool save_store_busy(void) {
+    return pending.active;
+}
+
+bool save_store_needs_compaction(void) {
+    return sector_full
+        || write_offset > (uint32_t)FLASH_SAVE_SECTOR_SIZE / 100 * SAVE_STORE_COMPACT_PERCENT;
+}
+
+static bool copy_record(uint8_t target, uint32_t offset, const SaveRecord* record) {
+    uint32_t size = record_size(record->length);
+    const uint8_t* source = record->data - RECORD_HEADER_SIZE;
+
+    // Same order as a new record: header words after the magic, magic, payload and commit
+    for (uint32_t i = 4; i < size; i += 4) {
+        uint32_t word;
+        memcpy(&word, source + i, sizeof(word));
+        if (!flash_driver_program_word(target, offset + i, word)) {
+            return false;
+        }
+    }
+    return flash_driver_program_word(target, offset, RECORD_MAGIC);
+}
+
+bool save_store_compact(void) {
+    if (pending.active) {
+        return false;
+    }
+
+    // Newest record of every key still in use, in log order
+    uint16_t keys[SAVE_STORE_MAX_KEYS];
+    uint8_t key_count = 0;
+    uint32_t offset = SECTOR_HEADER_SIZE;
+    SaveRecord record;
+
+    while (true) {
+        ScanResult result = scan_record(active_sector, offset, &record);
+        if (result == SCAN_END || result == SCAN_CORRUPT) {
+            break;
+        }
+        if (result == SCAN_RECORD) {
+            bool known = false;
+            for (uint8_t i = 0; i < key_count && !known; i++) {
+                known = (keys[i] == record.key);
+            }
+            if (!known && key_count < SAVE_STORE_MAX_KEYS) {
+                keys[key_count++] = record.key;
+            }
+        }
+        offset += record_size(record.length);
+    }
+
+    uint8_t target = (uint8_t)(1 - active_sector);
+    uint32_t target_offset = SECTOR_HEADER_SIZE;
+
+    stats.erases++;
+    if (!flash_driver_erase_save_sector(target)) {
+        stats.write_failures++;
+        return false;
+    }
+
+    for (uint8_t i = 0; i < key_count; i++) {
+        // Removed keys are left behind
+        if (!save_store_find(keys[i], &record) || record.length == 0) {
+            continue;
+        }
+        if (!copy_record(target, target_offset, &record)) {
+            stats.write_failures++;
+            return false;
+        }
+        target_offset += record_size(record.length);
+    }
+
+    // The header goes last, until then the old sector stays the active one
+    if (!flash_driver_program_word(target, 4, generation + 1)
+        || !flash_driver_program_word(target, 0, SECTOR_MAGIC)) {
+        stats.write_failures++;
+        return false;
+    }
+
+    uint32_t sequence = next_sequence;
+    mount_sector(target);
+    next_sequence = sequence;   // Tombstones dropped above may have held the highest
+    stats.compactions++;
+
+    DEBUG_PRINTF(false, "Save Store: Compacted to sector %u, %u keys, %lu bytes used\r\n",
+        (unsigned)active_sector, (unsigned)key_count, (unsigned long)write_offset);
+    return true;
+}
+
+const SaveStoreStats* save_store_get_stats(void) {
+    return &stats;
+}
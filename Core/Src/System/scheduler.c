@@ -0,0 +1,240 @@
+/*
+ * scheduler.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "System/scheduler.h"
+#include "Utils/debug_conf.h"
+#include <string.h>
+
+#ifndef UNITY_TEST
+#include "stm32f4xx.h"
+#else
+// No interrupts on the host
+#define __get_PRIMASK()     0U
+#define __disable_irq()
+#define __set_PRIMASK(x)    ((void)(x))
+#endif
+
+static SchedulerTask tasks[SCHEDULER_MAX_TASKS];
+static uint8_t task_count = 0;
+static SchedulerStats stats;
+static scheduler_clock_t clock_us = NULL;
+static scheduler_idle_t idle_hook = NULL;
+
+// Set from ISRs, one bit per task. The release time is written before the bit.
+static volatile uint32_t pending_events = 0;
+static volatile uint32_t event_release_us[SCHEDULER_MAX_TASKS];
+
+// Wrap-safe "a is at or after b" on the free-running clock
+static inline bool time_reached(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) >= 0;
+}
+
+void scheduler_init(scheduler_clock_t clock, scheduler_idle_t idle) {
+    memset(tasks, 0, sizeof(tasks));
+    memset(&stats, 0, sizeof(stats));
+    task_count = 0;
+    pending_events = 0;
+    clock_us = clock;
+    idle_hook = idle;
+}
+
+static uint8_t add_task(const char* name, scheduler_task_t run, uint32_t period_us,
+                        uint32_t deadline_us) {
+    if (task_count >= SCHEDULER_MAX_TASKS || run == NULL) {
+        DEBUG_PRINTF(false, "Scheduler: Cannot add task %s\r\n", name);
+        return SCHEDULER_NO_TASK;
+    }
+
+    SchedulerTask* task = &tasks[task_count];
+    task->name = name;
+    task->run = run;
+    task->period_us = period_us;
+    task->deadline_us = deadline_us;
+    // First release is one period from now so tasks added together stay in phase
+    task->next_release_us = clock_us() + period_us;
+
+    return task_count++;
+}
+
+uint8_t scheduler_add_periodic(const char* name, scheduler_task_t run, uint32_t period_us,
+                               uint32_t deadline_us) {
+    if (period_us == 0) {
+        return SCHEDULER_NO_TASK;
+    }
+    return add_task(name, run, period_us, deadline_us);
+}
+
+uint8_t scheduler_add_event(const char* name, scheduler_task_t run, uint32_t deadline_us) {
+    return add_task(name, run, 0, deadline_us);
+}
+
+void scheduler_signal(uint8_t task_id) {
+    if (task_id >= task_count) {
+        return;
+    }
+
+    uint32_t bit = 1UL << task_id;
+
+    // Called from ISRs and the main loop alike - masked so no other signal can come
+    // between the check and the write. Repeated signals before the task runs keep the
+    // first release time.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if ((pending_events & bit) == 0) {
+        event_release_us[task_id] = clock_us();
+        __atomic_fetch_or(&pending_events, bit, __ATOMIC_RELEASE);
+    }
+    __set_PRIMASK(primask);
+}
+
+bool scheduler_has_pending(void) {
+    return pending_events != 0;
+}
+
+// Highest priority task that is due, with the time it was released
+static int8_t next_due(uint32_t now, uint32_t* release_us) {
+    uint32_t events = __atomic_load_n(&pending_events, __ATOMIC_ACQUIRE);
+
+    for (uint8_t i = 0; i < task_count; i++) {
+        SchedulerTask* task = &tasks[i];
+        bool periodic_due = task->period_us != 0 && time_reached(now, task->next_release_us);
+        bool event_due = (events & (1UL << i)) != 0;
+
+        if (periodic_due && event_due) {
+            *release_us = time_reached(event_release_us[i], task->next_release_us)
+                              ? task->next_release_us : event_release_us[i];
+            return i;
+        }
+        if (periodic_due) {
+            *release_us = task->next_release_us;
+            return i;
+        }
+        if (event_due) {
+            *release_us = event_release_us[i];
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void run_task(uint8_t id, uint32_t release_us, uint32_t start_us) {
+    SchedulerTask* task = &tasks[id];
+
+    // Consume the release before running so a signal raised by the task itself, or an
+    // ISR during it, runs the task again
+    __atomic_fetch_and(&pending_events, ~(1UL << id), __ATOMIC_ACQ_REL);
+
+    if (task->period_us != 0 && time_reached(start_us, task->next_release_us)) {
+        task->next_release_us += task->period_us;
+
+        // Too far behind to catch up - drop the missed releases instead of bursting
+        if (time_reached(start_us, task->next_release_us)) {
+            uint32_t behind = (start_us - task->next_release_us) / task->period_us + 1;
+            task->skipped += behind;
+            task->next_release_us += behind * task->period_us;
+        }
+    }
+
+    task->run();
+
+    uint32_t end_us = clock_us();
+    uint32_t run_us = end_us - start_us;
+    uint32_t late_us = start_us - release_us;
+
+    task->runs++;
+    task->total_run_us += run_us;
+    if (run_us > task->max_run_us) {
+        task->max_run_us = run_us;
+    }
+    if (late_us > task->max_late_us) {
+        task->max_late_us = late_us;
+    }
+    if (task->deadline_us != 0 && end_us - release_us > task->deadline_us) {
+        task->missed++;
+    }
+    stats.busy_us += run_us;
+}
+
+// Time until the next periodic release, UINT32_MAX if only events are left
+static uint32_t time_to_next_release(uint32_t now) {
+    uint32_t earliest = UINT32_MAX;
+
+    for (uint8_t i = 0; i < task_count; i++) {
+        if (tasks[i].period_us == 0) {
+            continue;
+        }
+        uint32_t until = time_reached(now, tasks[i].next_release_us)
+                             ? 0 : tasks[i].next_release_us - now;
+        if (until < earliest) {
+            earliest = until;
+        }
+    }
+    return earliest;
+}
+
+bool scheduler_run_once(void) {
+    uint32_t now = clock_us();
+    uint32_t release_us;
+    int8_t id = next_due(now, &release_us);
+
+    if (id >= 0) {
+        run_task((uint8_t)id, release_us, now);
+        return true;
+    }
+
+    uint32_t idle_us = time_to_next_release(now);
+    if (idle_us >= SCHEDULER_MIN_IDLE_US && idle_hook != NULL) {
+        idle_hook(idle_us);
+        stats.idle_us += clock_us() - now;
+        stats.idle_calls++;
+    }
+    return false;
+}
+
+void scheduler_run(void) {
+    while (1) {
+        scheduler_run_once();
+    }
+}
+
+const SchedulerTask* scheduler_get_task(uint8_t task_id) {
+    return task_id < task_count ? &tasks[task_id] : NULL;
+}
+
+const SchedulerStats* scheduler_get_stats(void) {
+    return &stats;
+}
+
+void scheduler_reset_stats(void) {
+    for (uint8_t i = 0; i < task_count; i++) {
+        tasks[i].runs = 0;
+        tasks[i].missed = 0;
+        tasks[i].skipped = 0;
+        tasks[i].max_run_us = 0;
+        tasks[i].max_late_us = 0;
+        tasks[i].total_run_us = 0;
+    }
+    memset(&stats, 0, sizeof(stats));
+}
+
+void scheduler_report(void) {
+#if DEBUG_ENABLE
+    uint64_t total = stats.busy_us + stats.idle_us;
+
+    DEBUG_PRINTF(false, "Scheduler: %lu%% idle\r\n",
+        total ? (unsigned long)(stats.idle_us * 100 / total) : 0UL);
+
+    for (uint8_t i = 0; i < task_count; i++) {
+        const SchedulerTask* task = &tasks[i];
+        DEBUG_PRINTF(false, "  %-10s runs %lu avg %lu us max %lu us late %lu us missed %lu skipped %lu\r\n",
+            task->name, (unsigned long)task->runs,
+            task->runs ? (unsigned long)(task->total_run_us / task->runs) : 0UL,
+            (unsigned long)task->max_run_us, (unsigned long)task->max_late_us,
+            (unsigned long)task->missed, (unsigned long)task->skipped);
+    }
+#endif
+}
@@ -3,78 +3,260 @@
  *
  *  Created on: Apr 25, 2025
  *      Author: rohitimandi
+ *  Modified on: Oct 18, 2026
+ *      Added the DMA receive ring and span parsing
+ *      Added transmit queue statistics and overwriting puts
+ *      Added COBS framing with a sequence number and CRC, and delimited parsing
+ *      Frames carry a CRC-32 the STM32 CRC unit can compute, slice-by-4 in software
+ *      Circular buffer is a lock-free single producer, single consumer ring with span copies
+ *      Added the message slot pool, frames are received and read in place
+ *      Frame codec, its software CRC and the message parser moved to serial_frame.c, shared with the ESP32
  */
 #include "Utils/comm_utils.h"
 #include "Utils/debug_conf.h"
 
+
 // Circular buffer implementation
+// head and tail are free-running, the slot is the low bits
+#define CIRCULAR_BUFFER_MASK (CIRCULAR_BUFFER_SIZE - 1)
+
+_Static_assert((CIRCULAR_BUFFER_SIZE & CIRCULAR_BUFFER_MASK) == 0 && CIRCULAR_BUFFER_SIZE <= 32768,
+    "CIRCULAR_BUFFER_SIZE must be a power of two the uint16_t indices can count to");
+
 void circular_buffer_init(circular_buffer_t* cb) {
     if (cb == NULL) return;
 
     cb->head = 0;
     cb->tail = 0;
-    cb->count = 0;
     cb->overflow_count = 0;
     memset(cb->buffer, 0, CIRCULAR_BUFFER_SIZE);
 }
 
+// Producer side: copy in what fits, then publish it with one store of head
+uint16_t circular_buffer_write_span(circular_buffer_t* cb, const uint8_t* data, uint16_t length) {
+    if (cb == NULL || data == NULL) return 0;
+
+    uint16_t head = cb->head;
+    uint16_t space = CIRCULAR_BUFFER_SIZE - (uint16_t)(head - cb->tail);
+
+    if (length > space) {
+        cb->overflow_count += length - space;
+        length = space;
+    }
+    if (length == 0) {
+        return 0;
+    }
+
+    uint16_t position = head & CIRCULAR_BUFFER_MASK;
+    uint16_t first = CIRCULAR_BUFFER_SIZE - position;
+    if (first > length) {
+        first = length;
+    }
+    memcpy(&cb->buffer[position], data, first);
+    memcpy(cb->buffer, data + first, length - first);
+
+    // The bytes must be in the buffer before the consumer can see them
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    cb->head = head + length;
+    return length;
+}
+
 bool circular_buffer_put(circular_buffer_t* cb, uint8_t data) {
     if (cb == NULL) return false;
 
-    if (cb->count >= CIRCULAR_BUFFER_SIZE) {
+    uint16_t head = cb->head;
+
+    if ((uint16_t)(head - cb->tail) >= CIRCULAR_BUFFER_SIZE) {
         cb->overflow_count++;
         return false; // Buffer full
     }
 
-    cb->buffer[cb->head] = data;
-    cb->head = (cb->head + 1) % CIRCULAR_BUFFER_SIZE;
-    cb->count++;
+    cb->buffer[head & CIRCULAR_BUFFER_MASK] = data;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    cb->head = head + 1;
     return true;
 }
 
+// Consumer side: see head, then the bytes it covers
+uint16_t circular_buffer_peek_contiguous(const circular_buffer_t* cb, const uint8_t** data) {
+    if (cb == NULL || data == NULL) return 0;
+
+    uint16_t tail = cb->tail;
+    uint16_t available = (uint16_t)(cb->head - tail);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    uint16_t position = tail & CIRCULAR_BUFFER_MASK;
+    uint16_t to_end = CIRCULAR_BUFFER_SIZE - position;
+
+    *data = &cb->buffer[position];
+    return (available < to_end) ? available : to_end;
+}
+
+void circular_buffer_consume(circular_buffer_t* cb, uint16_t count) {
+    if (cb == NULL) return;
+
+    uint16_t tail = cb->tail;
+    uint16_t available = (uint16_t)(cb->head - tail);
+
+    // Reads of the slots are done before the producer may reuse them
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    cb->tail = tail + ((count < available) ? count : available);
+}
+
+uint16_t circular_buffer_peek(const circular_buffer_t* cb, uint8_t* buffer, uint16_t max_bytes) {
+    if (cb == NULL || buffer == NULL) return 0;
+
+    uint16_t tail = cb->tail;
+    uint16_t available = (uint16_t)(cb->head - tail);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    uint16_t to_peek = (available < max_bytes) ? available : max_bytes;
+    uint16_t position = tail & CIRCULAR_BUFFER_MASK;
+    uint16_t first = CIRCULAR_BUFFER_SIZE - position;
+    if (first > to_peek) {
+        first = to_peek;
+    }
+    memcpy(buffer, &cb->buffer[position], first);
+    memcpy(buffer + first, cb->buffer, to_peek - first);
+
+    return to_peek;
+}
+
+uint16_t circular_buffer_read_span(circular_buffer_t* cb, uint8_t* data, uint16_t max_bytes) {
+    uint16_t count = circular_buffer_peek(cb, data, max_bytes);
+
+    circular_buffer_consume(cb, count);
+    return count;
+}
+
 bool circular_buffer_get(circular_buffer_t* cb, uint8_t* data) {
     if (cb == NULL || data == NULL) return false;
 
-    if (cb->count == 0) {
+    uint16_t tail = cb->tail;
+
+    if (tail == cb->head) {
         return false; // Buffer empty
     }
 
-    *data = cb->buffer[cb->tail];
-    cb->tail = (cb->tail + 1) % CIRCULAR_BUFFER_SIZE;
-    cb->count--;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    *data = cb->buffer[tail & CIRCULAR_BUFFER_MASK];
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    cb->tail = tail + 1;
     return true;
 }
 
 uint16_t circular_buffer_available(const circular_buffer_t* cb) {
     if (cb == NULL) return 0;
-    return cb->count;
+    return (uint16_t)(cb->head - cb->tail);
 }
 
 uint16_t circular_buffer_free_space(const circular_buffer_t* cb) {
     if (cb == NULL) return 0;
-    return CIRCULAR_BUFFER_SIZE - cb->count;
+    return CIRCULAR_BUFFER_SIZE - (uint16_t)(cb->head - cb->tail);
 }
 
+// Consumer side, drops what is unread - the producer may keep writing
 void circular_buffer_flush(circular_buffer_t* cb) {
     if (cb == NULL) return;
 
-    cb->head = 0;
-    cb->tail = 0;
-    cb->count = 0;
+    cb->tail = cb->head;
 }
 
-uint16_t circular_buffer_peek(const circular_buffer_t* cb, uint8_t* buffer, uint16_t max_bytes) {
-    if (cb == NULL || buffer == NULL) return 0;
+// DMA receive ring implementation
+void dma_rx_ring_init(dma_rx_ring_t* ring, uint8_t* buffer, uint16_t size) {
+    if (ring == NULL || buffer == NULL) return;
+
+    ring->buffer = buffer;
+    ring->size = size;
+    ring->write_pos = 0;
+    ring->write_total = 0;
+    ring->gap_start = 0;
+    ring->restart_total = 0;
+    ring->restarts = 0;
+    ring->restarts_seen = 0;
+    ring->read_total = 0;
+    ring->overflow_count = 0;
+    ring->breaks = 0;
+}
 
-    uint16_t available = cb->count;
-    uint16_t to_peek = (available < max_bytes) ? available : max_bytes;
-    uint16_t tail = cb->tail;
+void dma_rx_ring_advance(dma_rx_ring_t* ring, uint16_t position) {
+    // Half transfer, transfer complete and IDLE events come at least twice per lap,
+    // so the distance since the last event is never ambiguous
+    uint16_t mask = ring->size - 1;
+    uint16_t delta = (uint16_t)(position - ring->write_pos) & mask;
+
+    ring->write_pos = position & mask;
+    ring->write_total += delta;
+}
+
+void dma_rx_ring_restart(dma_rx_ring_t* ring) {
+    // Skip the rest of the lap so totals and buffer positions stay in step
+    uint32_t mask = ring->size - 1;
+
+    ring->gap_start = ring->write_total;
+    ring->write_total = (ring->write_total + mask) & ~mask;
+    ring->write_pos = 0;
+    ring->restart_total = ring->write_total;
+    ring->restarts++;
+}
 
-    for (uint16_t i = 0; i < to_peek; i++) {
-        buffer[i] = cb->buffer[(tail + i) % CIRCULAR_BUFFER_SIZE];
+uint16_t dma_rx_ring_span(dma_rx_ring_t* ring, const uint8_t** data) {
+    if (ring == NULL || data == NULL) return 0;
+
+    uint32_t end;
+    uint16_t restarts;
+
+    // write_total from the same run of the DMA as restarts
+    do {
+        restarts = ring->restarts;
+        end = ring->write_total;
+    } while (restarts != ring->restarts);
+
+    if (restarts != ring->restarts_seen) {
+        // The DMA starts over at the top of the buffer, on top of anything not read yet
+        int32_t unread = (int32_t)(ring->gap_start - ring->read_total);
+        if (unread > 0) {
+            ring->overflow_count += (uint32_t)unread;
+        }
+        ring->read_total = ring->restart_total;
+        ring->restarts_seen = restarts;
+        ring->breaks++;
+        end = ring->write_total;
     }
 
-    return to_peek;
+    uint32_t available = end - ring->read_total;
+    if (available > ring->size) {
+        // The DMA went round past the reader, what is left in the buffer is mixed
+        ring->overflow_count += available;
+        ring->read_total = end;
+        ring->breaks++;
+        return 0;
+    }
+
+    uint16_t position = ring->read_total & (ring->size - 1);
+    uint16_t to_end = ring->size - position;
+
+    *data = &ring->buffer[position];
+    return (available < to_end) ? (uint16_t)available : to_end;
+}
+
+void dma_rx_ring_consume(dma_rx_ring_t* ring, uint16_t count) {
+    if (ring == NULL) return;
+    ring->read_total += count;
+}
+
+uint16_t dma_rx_ring_available(const dma_rx_ring_t* ring) {
+    if (ring == NULL) return 0;
+
+    uint32_t available = ring->write_total - ring->read_total;
+    return (available > ring->size) ? ring->size : (uint16_t)available;
+}
+
+void dma_rx_ring_flush(dma_rx_ring_t* ring) {
+    if (ring == NULL) return;
+
+    ring->restarts_seen = ring->restarts;
+    ring->read_total = ring->write_total;
 }
 
 // Message queue implementation
@@ -109,6 +291,22 @@ bool message_queue_put(message_queue_t* mq, const void* msg) {
     return true;
 }
 
+bool message_queue_put_overwrite(message_queue_t* mq, const void* msg) {
+    if (mq == NULL || msg == NULL || mq->queue_buffer == NULL) return false;
+
+    bool dropped = false;
+    if (mq->count >= mq->max_messages) {
+        // Make room by dropping the oldest message
+        mq->tail = (mq->tail + 1) % mq->max_messages;
+        mq->count--;
+        mq->overflow_count++;
+        dropped = true;
+    }
+
+    message_queue_put(mq, msg);
+    return dropped;
+}
+
 bool message_queue_get(message_queue_t* mq, void* msg) {
     if (mq == NULL || msg == NULL || mq->queue_buffer == NULL) return false;
 
@@ -150,63 +348,84 @@ void message_queue_flush(message_queue_t* mq) {
     // Don't reset message_size or max_messages - they're configuration
 }
 
-// Message parser implementation
-void message_parser_init(message_parser_t* parser, uint8_t* buffer, uint16_t buffer_size) {
-    if (parser == NULL || buffer == NULL) return;
+// Message slot pool implementation
+#define MESSAGE_POOL_READY_MASK (MESSAGE_POOL_MAX_SLOTS - 1)
 
-    parser->parse_buffer = buffer;
-    parser->parse_index = 0;
-    parser->expected_size = buffer_size;
-    parser->parsing_active = false;
-    memset(buffer, 0, buffer_size);
+static uint8_t message_pool_index(const message_pool_t* pool, const uint8_t* slot) {
+    return (uint8_t)((uint32_t)(slot - pool->storage) / pool->slot_size);
 }
 
-void message_parser_reset(message_parser_t* parser) {
-    if (parser == NULL) return;
+void message_pool_init(message_pool_t* pool, uint8_t* storage, uint8_t slot_count, uint16_t slot_size) {
+    if (pool == NULL || storage == NULL) return;
 
-    parser->parsing_active = false;
-    parser->parse_index = 0;
-    if (parser->parse_buffer != NULL) {
-        memset(parser->parse_buffer, 0, parser->expected_size);
+    if (slot_count > MESSAGE_POOL_MAX_SLOTS) {
+        slot_count = MESSAGE_POOL_MAX_SLOTS;
     }
+    pool->storage = storage;
+    pool->slot_size = slot_size;
+    pool->slot_count = slot_count;
+    pool->used_peak = 0;
+    pool->exhausted = 0;
+    message_pool_flush(pool);
 }
 
-bool message_parser_add_byte(message_parser_t* parser, uint8_t data, uint8_t start_byte) {
-    if (parser == NULL || parser->parse_buffer == NULL) return false;
+uint8_t* message_pool_acquire(message_pool_t* pool) {
+    if (pool == NULL) return NULL;
 
-    if (!parser->parsing_active) {
-        // Looking for start byte
-        if (data == start_byte) {
-            parser->parsing_active = true;
-            parser->parse_index = 0;
-            parser->parse_buffer[parser->parse_index++] = data;
-            return true;
-        }
-        // Ignore all other bytes when not parsing
-        return false;
-    } else {
-        // Currently parsing a message
-        if (parser->parse_index < parser->expected_size) {
-            parser->parse_buffer[parser->parse_index++] = data;
-            return true;
-        } else {
-            // Buffer overflow during parsing - reset
-            message_parser_reset(parser);
-            return false;
-        }
+    if (pool->free_slots == 0) {
+        pool->exhausted++;
+        return NULL;
+    }
+
+    uint8_t index = (uint8_t)__builtin_ctz(pool->free_slots);
+    pool->free_slots &= ~(1UL << index);
+
+    uint8_t used = pool->slot_count - message_pool_free(pool);
+    if (used > pool->used_peak) {
+        pool->used_peak = used;
     }
+    return &pool->storage[(uint32_t)index * pool->slot_size];
 }
 
-bool message_parser_is_complete(const message_parser_t* parser) {
-    if (parser == NULL) return false;
-    return (parser->parsing_active && parser->parse_index >= parser->expected_size);
+void message_pool_commit(message_pool_t* pool, const uint8_t* slot) {
+    if (pool == NULL || slot == NULL) return;
+
+    pool->ready[pool->ready_head & MESSAGE_POOL_READY_MASK] = message_pool_index(pool, slot);
+    pool->ready_head++;
+}
+
+const uint8_t* message_pool_borrow(message_pool_t* pool) {
+    if (pool == NULL || pool->ready_tail == pool->ready_head) return NULL;
+
+    uint8_t index = pool->ready[pool->ready_tail & MESSAGE_POOL_READY_MASK];
+    pool->ready_tail++;
+    return &pool->storage[(uint32_t)index * pool->slot_size];
 }
 
-uint8_t* message_parser_get_buffer(const message_parser_t* parser) {
-    if (parser == NULL) return NULL;
-    return parser->parse_buffer;
+void message_pool_release(message_pool_t* pool, const uint8_t* slot) {
+    if (pool == NULL || slot == NULL) return;
+
+    // Releasing twice, e.g. after a flush, leaves the slot free once
+    pool->free_slots |= 1UL << message_pool_index(pool, slot);
 }
 
+uint8_t message_pool_ready(const message_pool_t* pool) {
+    if (pool == NULL) return 0;
+    return (uint8_t)(pool->ready_head - pool->ready_tail);
+}
+
+uint8_t message_pool_free(const message_pool_t* pool) {
+    if (pool == NULL) return 0;
+    return (uint8_t)__builtin_popcount(pool->free_slots);
+}
+
+void message_pool_flush(message_pool_t* pool) {
+    if (pool == NULL) return;
+
+    pool->free_slots = (pool->slot_count == 32) ? 0xFFFFFFFFUL : (1UL << pool->slot_count) - 1;
+    pool->ready_head = 0;
+    pool->ready_tail = 0;
+}
 
 // Statistics implementation
 
@@ -240,6 +459,13 @@ void comm_stats_print(const comm_stats_t* stats) {
     DEBUG_PRINTF(false, "Parse errors: %lu\r\n", stats->parse_errors);
     DEBUG_PRINTF(false, "Buffer overflows: %lu\r\n", stats->buffer_overflows);
     DEBUG_PRINTF(false, "Queue overflows: %lu\r\n", stats->queue_overflows);
+    DEBUG_PRINTF(false, "TX frames sent: %lu\r\n", stats->tx_frames_sent);
+    DEBUG_PRINTF(false, "TX dropped: %lu, overwritten: %lu, errors: %lu\r\n",
+        stats->tx_dropped, stats->tx_overwritten, stats->tx_errors);
+    DEBUG_PRINTF(false, "TX queue depth: %u (peak %u)\r\n", stats->tx_queue_depth, stats->tx_queue_peak);
+    DEBUG_PRINTF(false, "TX longest send call: %lu us\r\n", stats->tx_send_us_max);
+    DEBUG_PRINTF(false, "RX frames lost: %lu\r\n", stats->rx_frames_lost);
+    DEBUG_PRINTF(false, "RX bytes copied: %lu\r\n", stats->rx_bytes_copied);
     DEBUG_PRINTF(false, "==============================\r\n");
 }
 
@@ -0,0 +1,187 @@
+/*
+ * latency_probe.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+
+#include "Utils/latency_probe.h"
+
+#if LATENCY_PROBE_ENABLE
+
+#include "Utils/misc_utils.h"
+#include "Utils/debug_conf.h"
+#include <string.h>
+
+typedef struct {
+    uint32_t edge_us;       // ISR timestamp of the edge
+    uint32_t consumed_us;   // When a game tick drained it
+    uint32_t tick;          // The tick that drained it
+    bool marked;            // The game said where the response is drawn
+    coord_t x1;             // Marked area, corners inclusive
+    coord_t y1;
+    coord_t x2;
+    coord_t y2;
+} LatencySample;
+
+static LatencyHistogram histograms[LATENCY_PROBE_GAMES];
+static LatencyHistogram* current = NULL;
+static LatencySample pending[LATENCY_PROBE_PENDING];
+static uint8_t pending_count = 0;
+static uint32_t tick_count = 0;
+
+static void record(LatencyHistogram* histogram, const LatencySample* sample, uint32_t now_us) {
+    uint32_t latency = now_us - sample->edge_us;
+    uint32_t bucket = latency / LATENCY_PROBE_BUCKET_US;
+
+    if (bucket >= LATENCY_PROBE_BUCKETS) {
+        bucket = LATENCY_PROBE_BUCKETS - 1;
+    }
+    histogram->buckets[bucket]++;
+
+    if (histogram->count == 0 || latency < histogram->min_us) {
+        histogram->min_us = latency;
+    }
+    if (latency > histogram->max_us) {
+        histogram->max_us = latency;
+    }
+    histogram->count++;
+    histogram->total_us += latency;
+    histogram->queued_us += sample->consumed_us - sample->edge_us;
+    histogram->ticks += tick_count - sample->tick;
+}
+
+void latency_probe_reset(void) {
+    memset(histograms, 0, sizeof(histograms));
+    current = NULL;
+    pending_count = 0;
+    tick_count = 0;
+}
+
+void latency_probe_begin(const char* game_name) {
+    current = NULL;
+    pending_count = 0;
+
+    for (uint8_t i = 0; i < LATENCY_PROBE_GAMES; i++) {
+        if (histograms[i].name == NULL) {
+            histograms[i].name = game_name;
+        }
+        if (strcmp(histograms[i].name, game_name) == 0) {
+            current = &histograms[i];
+            return;
+        }
+    }
+    DEBUG_PRINTF(false, "Latency: No histogram left for %s\r\n", game_name);
+}
+
+void latency_probe_tick(void) {
+    tick_count++;
+}
+
+void latency_probe_input(uint32_t edge_us) {
+    if (current == NULL) {
+        return;
+    }
+    if (pending_count >= LATENCY_PROBE_PENDING) {
+        current->dropped++;
+        return;
+    }
+
+    LatencySample* sample = &pending[pending_count++];
+    sample->edge_us = edge_us;
+    sample->consumed_us = get_current_us();
+    sample->tick = tick_count;
+    sample->marked = false;
+}
+
+void latency_probe_mark(coord_t x, coord_t y, coord_t size) {
+    for (uint8_t i = 0; i < pending_count; i++) {
+        LatencySample* sample = &pending[i];
+        if (sample->marked) {
+            continue;
+        }
+        sample->x1 = (x > size) ? x - size : 0;
+        sample->y1 = (y > size) ? y - size : 0;
+        sample->x2 = x + 2 * size - 1;
+        sample->y2 = y + 2 * size - 1;
+        sample->marked = true;
+    }
+}
+
+void latency_probe_flushed(bool drew, coord_t x1, coord_t y1, coord_t x2, coord_t y2) {
+    // A flush that drew nothing cannot show the response yet
+    if (!drew || pending_count == 0 || current == NULL) {
+        return;
+    }
+
+    uint32_t now = get_current_us();
+    uint8_t waiting = 0;
+    for (uint8_t i = 0; i < pending_count; i++) {
+        LatencySample* sample = &pending[i];
+        bool overlaps = !sample->marked ||
+            (sample->x1 <= x2 && x1 <= sample->x2 && sample->y1 <= y2 && y1 <= sample->y2);
+
+        // Drawing elsewhere on the screen, e.g. the score or a ghost, does not show the response
+        if (overlaps) {
+            record(current, sample, now);
+        }
+        else if (now - sample->edge_us >= LATENCY_PROBE_TIMEOUT_US) {
+            current->expired++;
+        }
+        else {
+            pending[waiting++] = *sample;
+        }
+    }
+    pending_count = waiting;
+}
+
+const LatencyHistogram* latency_probe_get(const char* game_name) {
+    for (uint8_t i = 0; i < LATENCY_PROBE_GAMES && histograms[i].name != NULL; i++) {
+        if (strcmp(histograms[i].name, game_name) == 0) {
+            return &histograms[i];
+        }
+    }
+    return NULL;
+}
+
+uint32_t latency_probe_percentile(const LatencyHistogram* histogram, uint8_t percent) {
+    if (histogram == NULL || histogram->count == 0) {
+        return 0;
+    }
+
+    // Smallest bucket holding at least percent of the samples
+    uint32_t target = (histogram->count * percent + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t bucket = 0; bucket < LATENCY_PROBE_BUCKETS; bucket++) {
+        seen += histogram->buckets[bucket];
+        if (seen >= target) {
+            return (bucket == LATENCY_PROBE_BUCKETS - 1) ? histogram->max_us
+                                                         : (bucket + 1) * LATENCY_PROBE_BUCKET_US;
+        }
+    }
+    return histogram->max_us;
+}
+
+void latency_probe_report(void) {
+    if (current == NULL || current->count == 0) {
+        return;
+    }
+
+    DEBUG_PRINTF(false, "Latency %s: %lu samples, min %lu us, p50 <%lu us, p95 <%lu us, max %lu us\r\n",
+        current->name, current->count, current->min_us,
+        latency_probe_percentile(current, 50), latency_probe_percentile(current, 95), current->max_us);
+    DEBUG_PRINTF(false, "Latency %s: mean %lu us, %lu us before a tick, %lu.%02lu ticks to the flush, %lu dropped, %lu expired\r\n",
+        current->name, (uint32_t)(current->total_us / current->count),
+        (uint32_t)(current->queued_us / current->count),
+        current->ticks / current->count, (current->ticks * 100 / current->count) % 100,
+        current->dropped, current->expired);
+
+    for (uint8_t bucket = 0; bucket < LATENCY_PROBE_BUCKETS; bucket++) {
+        if (current->buckets[bucket] > 0) {
+            DEBUG_PRINTF(false, "  %2u-%2u ms: %lu\r\n", bucket * LATENCY_PROBE_BUCKET_US / 1000,
+                (bucket + 1) * LATENCY_PROBE_BUCKET_US / 1000, current->buckets[bucket]);
+        }
+    }
+}
+
+#endif /* LATENCY_PROBE_ENABLE */
@@ -7,6 +7,7 @@
 
 
 #include <Utils/misc_utils.h>
+#include <stdbool.h>
 
 static uint32_t random_seed = 1;
 
@@ -33,6 +34,27 @@ uint32_t get_current_ms(void) {
     return HAL_GetTick();
 }
 
+uint32_t get_current_us(void) {
+    uint32_t ms;
+    uint32_t ticks;
+    bool tick_pending;
+
+    // Retry if the millisecond tick moved while the counter was read
+    do {
+        ms = HAL_GetTick();
+        ticks = SysTick->VAL;
+        tick_pending = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0;
+    } while (ms != HAL_GetTick());
+
+    // Called from an ISR that blocks SysTick, the counter may have wrapped without the tick
+    uint32_t load = SysTick->LOAD + 1;
+    if (tick_pending && ticks > load / 2) {
+        ms++;
+    }
+
+    return ms * 1000 + ((load - 1 - ticks) * 1000) / load;
+}
+
 void init_random(void) {
 	random_seed = HAL_GetTick();
 }
@@ -41,3 +63,13 @@ uint32_t get_random(void) {
     random_seed = random_seed * 1103515245 + 12345;
     return random_seed;
 }
+
+void cycle_counter_init(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t get_cycle_count(void) {
+    return DWT->CYCCNT;
+}
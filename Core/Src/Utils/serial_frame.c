@@ -0,0 +1,297 @@
+/*
+ * serial_frame.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: rohitimandi
+ */
+#include "Utils/serial_frame.h"
+#include <string.h>
+
+static uint32_t crc32_tables[4][256];
+static bool crc32_tables_ready = false;
+static uint32_t (*frame_crc)(const uint8_t* data, uint16_t length) = NULL;
+
+// Message parser implementation
+void message_parser_init(message_parser_t* parser, uint8_t* buffer, uint16_t buffer_size) {
+    if (parser == NULL || buffer == NULL) return;
+
+    parser->parse_buffer = buffer;
+    parser->parse_index = 0;
+    parser->expected_size = buffer_size;
+    parser->parsing_active = false;
+    parser->frame_complete = false;
+    parser->discarding = false;
+    parser->oversized_frames = 0;
+    memset(buffer, 0, buffer_size);
+}
+
+void message_parser_reset(message_parser_t* parser) {
+    if (parser == NULL) return;
+
+    parser->parsing_active = false;
+    parser->frame_complete = false;
+    parser->discarding = false;
+    parser->parse_index = 0;
+    if (parser->parse_buffer != NULL) {
+        memset(parser->parse_buffer, 0, parser->expected_size);
+    }
+}
+
+void message_parser_attach(message_parser_t* parser, uint8_t* buffer, uint16_t buffer_size) {
+    if (parser == NULL) return;
+
+    // Nothing is cleared, the message overwrites what the buffer held
+    parser->parse_buffer = buffer;
+    parser->expected_size = buffer_size;
+    parser->parsing_active = false;
+    parser->frame_complete = false;
+    parser->discarding = false;
+    parser->parse_index = 0;
+}
+
+bool message_parser_add_byte(message_parser_t* parser, uint8_t data, uint8_t start_byte) {
+    if (parser == NULL || parser->parse_buffer == NULL) return false;
+
+    if (!parser->parsing_active) {
+        // Looking for start byte
+        if (data == start_byte) {
+            parser->parsing_active = true;
+            parser->parse_index = 0;
+            parser->parse_buffer[parser->parse_index++] = data;
+            return true;
+        }
+        // Ignore all other bytes when not parsing
+        return false;
+    } else {
+        // Currently parsing a message
+        if (parser->parse_index < parser->expected_size) {
+            parser->parse_buffer[parser->parse_index++] = data;
+            return true;
+        } else {
+            // Buffer overflow during parsing - reset
+            message_parser_reset(parser);
+            return false;
+        }
+    }
+}
+
+uint16_t message_parser_add_span(message_parser_t* parser, const uint8_t* data, uint16_t length, uint8_t start_byte) {
+    if (parser == NULL || parser->parse_buffer == NULL || data == NULL) return 0;
+
+    uint16_t used = 0;
+
+    if (!parser->parsing_active) {
+        // Skip to the start byte
+        const uint8_t* start = memchr(data, start_byte, length);
+        if (start == NULL) {
+            return length;
+        }
+        used = (uint16_t)(start - data);
+        parser->parsing_active = true;
+        parser->parse_index = 0;
+    }
+
+    // Take at most the rest of this message, what follows belongs to the next one
+    uint16_t wanted = parser->expected_size - parser->parse_index;
+    uint16_t take = (uint16_t)(length - used);
+    if (take > wanted) {
+        take = wanted;
+    }
+
+    memcpy(&parser->parse_buffer[parser->parse_index], &data[used], take);
+    parser->parse_index += take;
+    return used + take;
+}
+
+uint16_t message_parser_add_delimited(message_parser_t* parser, const uint8_t* data, uint16_t length, uint8_t delimiter) {
+    if (parser == NULL || parser->parse_buffer == NULL || data == NULL) return 0;
+
+    const uint8_t* end = memchr(data, delimiter, length);
+    uint16_t take = (end != NULL) ? (uint16_t)(end - data) : length;
+
+    if (!parser->discarding) {
+        if (take > parser->expected_size - parser->parse_index) {
+            // Longer than any valid frame - noise, drop it up to the next delimiter
+            parser->discarding = true;
+            parser->parse_index = 0;
+            parser->oversized_frames++;
+        }
+        else {
+            memcpy(&parser->parse_buffer[parser->parse_index], data, take);
+            parser->parse_index += take;
+        }
+    }
+
+    if (end == NULL) {
+        return length;
+    }
+
+    // Delimiter: a frame ends here, back to back delimiters carry nothing
+    if (parser->discarding) {
+        parser->discarding = false;
+    }
+    else if (parser->parse_index > 0) {
+        parser->frame_complete = true;
+    }
+    return take + 1;
+}
+
+bool message_parser_is_complete(const message_parser_t* parser) {
+    if (parser == NULL) return false;
+    return parser->frame_complete
+        || (parser->parsing_active && parser->parse_index >= parser->expected_size);
+}
+
+uint8_t* message_parser_get_buffer(const message_parser_t* parser) {
+    if (parser == NULL) return NULL;
+    return parser->parse_buffer;
+}
+
+uint16_t message_parser_get_length(const message_parser_t* parser) {
+    if (parser == NULL) return 0;
+    return parser->parse_index;
+}
+
+
+// Serial frame implementation
+
+uint16_t cobs_encode(const uint8_t* data, uint16_t length, uint8_t* encoded) {
+    uint16_t code_index = 0;
+    uint16_t out = 1;
+    uint8_t code = 1;
+
+    for (uint16_t i = 0; i < length; i++) {
+        if (data[i] != 0) {
+            encoded[out++] = data[i];
+            code++;
+        }
+        if (data[i] == 0 || code == 0xFF) {
+            // Close the block: its code is the distance to the next zero
+            encoded[code_index] = code;
+            code_index = out++;
+            code = 1;
+        }
+    }
+    encoded[code_index] = code;
+    return out;
+}
+
+uint16_t cobs_decode(const uint8_t* encoded, uint16_t length, uint8_t* data) {
+    uint16_t in = 0;
+    uint16_t out = 0;
+
+    while (in < length) {
+        uint8_t code = encoded[in++];
+        if (code == 0 || in + code - 1 > length) {
+            return 0;
+        }
+
+        // Output never overtakes input, so decoding in place is safe
+        memmove(&data[out], &encoded[in], code - 1);
+        in += code - 1;
+        out += code - 1;
+
+        // A full block has no zero after it, nor does the last one
+        if (code != 0xFF && in < length) {
+            data[out++] = 0;
+        }
+    }
+    return out;
+}
+
+static void crc32_build_tables(void) {
+    for (uint16_t i = 0; i < 256; i++) {
+        uint32_t crc = (uint32_t)i << 24;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80000000UL) ? (crc << 1) ^ 0x04C11DB7UL : crc << 1;
+        }
+        crc32_tables[0][i] = crc;
+    }
+    // Table k advances a byte k further: four bytes are folded in per step
+    for (uint16_t i = 0; i < 256; i++) {
+        for (uint8_t k = 1; k < 4; k++) {
+            uint32_t prev = crc32_tables[k - 1][i];
+            crc32_tables[k][i] = (prev << 8) ^ crc32_tables[0][prev >> 24];
+        }
+    }
+    crc32_tables_ready = true;
+}
+
+// CRC-32/MPEG-2, slice-by-4 from 4 KB of tables built on first use
+uint32_t crc32_mpeg2(const uint8_t* data, uint16_t length, uint32_t crc) {
+    if (!crc32_tables_ready) {
+        crc32_build_tables();
+    }
+
+    while (length >= 4) {
+        crc ^= ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+        crc = crc32_tables[3][crc >> 24] ^ crc32_tables[2][(crc >> 16) & 0xFF]
+            ^ crc32_tables[1][(crc >> 8) & 0xFF] ^ crc32_tables[0][crc & 0xFF];
+        data += 4;
+        length -= 4;
+    }
+    while (length-- > 0) {
+        crc = (crc << 8) ^ crc32_tables[0][(crc >> 24) ^ *data++];
+    }
+    return crc;
+}
+
+void serial_frame_register_crc(uint32_t (*crc)(const uint8_t* data, uint16_t length)) {
+    frame_crc = crc;
+}
+
+static uint32_t serial_frame_crc(const uint8_t* data, uint16_t length) {
+    return (frame_crc != NULL) ? frame_crc(data, length) : crc32_mpeg2(data, length, 0xFFFFFFFFUL);
+}
+
+uint16_t serial_frame_encode(uint8_t type, uint16_t sequence, const uint8_t* payload, uint8_t length,
+    uint8_t* wire) {
+    uint8_t raw[SERIAL_FRAME_MAX_RAW_SIZE];
+
+    if (wire == NULL || length > SERIAL_FRAME_MAX_PAYLOAD) return 0;
+
+    raw[0] = type;
+    raw[1] = length;
+    raw[2] = (uint8_t)(sequence & 0xFF);
+    raw[3] = (uint8_t)(sequence >> 8);
+    if (payload != NULL && length > 0) {
+        memcpy(&raw[SERIAL_FRAME_HEADER_SIZE], payload, length);
+    }
+
+    uint16_t raw_length = SERIAL_FRAME_HEADER_SIZE + length;
+    uint32_t crc = serial_frame_crc(raw, raw_length);
+    for (uint8_t i = 0; i < SERIAL_FRAME_CRC_SIZE; i++) {
+        raw[raw_length++] = (uint8_t)(crc >> (8 * i));
+    }
+
+    wire[0] = SERIAL_FRAME_DELIMITER;
+    uint16_t encoded_length = cobs_encode(raw, raw_length, &wire[1]);
+    wire[1 + encoded_length] = SERIAL_FRAME_DELIMITER;
+    return encoded_length + 2;
+}
+
+serial_frame_status_t serial_frame_decode(uint8_t* buffer, uint16_t length, serial_frame_t* frame) {
+    if (buffer == NULL || frame == NULL) return SERIAL_FRAME_BAD_STUFFING;
+
+    uint16_t raw_length = cobs_decode(buffer, length, buffer);
+    if (raw_length == 0) {
+        return SERIAL_FRAME_BAD_STUFFING;
+    }
+    if (raw_length < SERIAL_FRAME_HEADER_SIZE + SERIAL_FRAME_CRC_SIZE
+        || buffer[1] != raw_length - SERIAL_FRAME_HEADER_SIZE - SERIAL_FRAME_CRC_SIZE) {
+        return SERIAL_FRAME_BAD_LENGTH;
+    }
+
+    const uint8_t* received = &buffer[raw_length - SERIAL_FRAME_CRC_SIZE];
+    uint32_t crc = serial_frame_crc(buffer, raw_length - SERIAL_FRAME_CRC_SIZE);
+    if (crc != ((uint32_t)received[0] | ((uint32_t)received[1] << 8)
+        | ((uint32_t)received[2] << 16) | ((uint32_t)received[3] << 24))) {
+        return SERIAL_FRAME_BAD_CRC;
+    }
+
+    frame->type = buffer[0];
+    frame->length = buffer[1];
+    frame->sequence = (uint16_t)(buffer[2] | (buffer[3] << 8));
+    frame->payload = &buffer[SERIAL_FRAME_HEADER_SIZE];
+    return SERIAL_FRAME_OK;
+}
@@ -21,6 +21,8 @@
  /* Private includes ----------------------------------------------------------*/
  /* USER CODE BEGIN Includes */
 #include "main.h"
+#include "System/scheduler.h"
+#include "Game_Engine/game_engine_save.h"
 #include <math.h>
 /* USER CODE END Includes */
 
@@ -31,7 +33,11 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
-
+/* Scheduler task periods, the game tick runs at FRAME_RATE */
+#define COMM_PUMP_PERIOD_US   5000
+#define AUDIO_PERIOD_US       5000
+#define UI_PERIOD_US          10000
+#define SAVE_PERIOD_US        5000
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -53,11 +59,14 @@ static uint32_t uart_test_counter = 0;
 static volatile uint8_t last_received_byte = 0;
 static volatile uint8_t new_data_received = 0;
 
+static uint8_t render_task_id = SCHEDULER_NO_TASK;
+static uint8_t comm_tx_task_id = SCHEDULER_NO_TASK;
+
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN PFP */
-
+static void scheduler_tasks_init(void);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
@@ -127,6 +136,83 @@ void uart_test_loop(void) {
 	//    }
 }
 
+/* Scheduler tasks */
+static void game_tick_task(void) {
+	if (console_ui_is_game_active()) {
+		console_ui_run_game();
+		scheduler_signal(render_task_id);
+	}
+}
+
+static void render_task(void) {
+	console_ui_render_game();
+}
+
+static void comm_tx_task(void) {
+	serial_comm_service_tx();
+}
+
+// UART interrupt: the last frame is out, the next one is started from the main loop
+static void comm_tx_done(void) {
+	scheduler_signal(comm_tx_task_id);
+}
+
+static void audio_task(void) {
+	audio_update();
+}
+
+static void ui_task(void) {
+	// Boot, welcome and error screens time out on their own
+	if (!console_ui_update_screen()) {
+		return;		// Display still initialising
+	}
+	if (console_ui_is_game_active()) {
+		return;
+	}
+
+	// Handle immediate WiFi status updates
+	if (serial_comm_needs_ui_update() && serial_comm_is_wifi_connected()) {
+		// Force immediate menu refresh to show correct WiFi status
+		display_manager_draw_status_bar(serial_comm_is_wifi_connected(), 0, 0, false);
+		serial_comm_clear_ui_update_flag();
+		DEBUG_PRINTF(false, "MAIN: Menu refreshed due to WiFi status change\r\n");
+	}
+	JoystickStatus js_status = joystick_get_status();
+	console_ui_handle_input(js_status);
+}
+
+static void save_task(void) {
+	// A few flash words per run, the CPU stalls while each one is programmed
+	game_save_service(console_ui_is_game_active());
+}
+
+static void idle_wait_for_interrupt(uint32_t idle_us) {
+	(void)idle_us;	// SysTick wakes the core every millisecond anyway
+
+	// With interrupts masked a signal raised after the check still ends WFI,
+	// its handler runs as soon as they are unmasked
+	__disable_irq();
+	if (!scheduler_has_pending()) {
+		__WFI();
+	}
+	__enable_irq();
+}
+
+static void scheduler_tasks_init(void) {
+	scheduler_init(get_current_us, idle_wait_for_interrupt);
+
+	// Added in priority order
+	scheduler_add_periodic("game", game_tick_task, FRAME_RATE * 1000, FRAME_RATE * 1000);
+	render_task_id = scheduler_add_event("render", render_task, FRAME_RATE * 1000);
+	comm_tx_task_id = scheduler_add_event("comm_tx", comm_tx_task, 0);
+	scheduler_add_periodic("comm", uart_test_loop, COMM_PUMP_PERIOD_US, COMM_PUMP_PERIOD_US);
+	scheduler_add_periodic("audio", audio_task, AUDIO_PERIOD_US, AUDIO_PERIOD_US);
+	scheduler_add_periodic("ui", ui_task, UI_PERIOD_US, 0);
+	scheduler_add_periodic("save", save_task, SAVE_PERIOD_US, 0);
+
+	serial_comm_register_tx_done_callback(comm_tx_done);
+}
+
 /* USER CODE END 0 */
 
 /**
@@ -159,7 +245,7 @@ int main(void)
 	//  display_write_string("Hello World", Font_7x10, DISPLAY_BLACK);
 
 	//  console_ui_show_screen(SCREEN_WELCOME); // Already shown in console_ui_init_with_default_menu() in console_peripherals_init()
-	console_ui_show_screen(SCREEN_MENU);
+	// The display comes up, then the welcome screen, then the menu - all from the ui task
 
 	// Start with a simple tone test
 	//  audio_play_tone(440, 1000);  // 440 Hz (A4) for 1 second
@@ -170,6 +256,7 @@ int main(void)
 	serial_comm_send_debug("STM32 UART Test Started\r\n", 100);
 	serial_comm_send_status(1, 0, "STM32 Ready for UART Test");
 
+	scheduler_tasks_init();
 
 	/* USER CODE END 2 */
 
@@ -180,8 +267,8 @@ int main(void)
 		/* USER CODE END WHILE */
 
 		/* USER CODE BEGIN 3 */
-		// Uart
-		uart_test_loop();
+		// Game tick, render, UART, audio and UI - sleeps when nothing is due
+		scheduler_run_once();
 		// Compute sine and cosine using FPU
 		//	  float rad = angle * 3.14159f / 180.0f;
 		//	      result_sin = sinf(rad);
@@ -210,22 +297,6 @@ int main(void)
 		//	  	DEBUG_PRINTF(0, "Selected menu item: %s\n", oled_get_selected_menu_item().title);
 
 
-		if (console_ui_is_game_active()) {
-			console_ui_run_game();
-
-			add_delay(1);  // Control game speed
-		}
-		else {
-			// Handle immediate WiFi status updates
-			if (serial_comm_needs_ui_update() && serial_comm_is_wifi_connected()) {
-				// Force immediate menu refresh to show correct WiFi status
-				display_manager_draw_status_bar(serial_comm_is_wifi_connected(), 0, 0, false);
-				serial_comm_clear_ui_update_flag();
-				DEBUG_PRINTF(false, "MAIN: Menu refreshed due to WiFi status change\r\n");
-			}
-			JoystickStatus js_status = joystick_get_status();
-			console_ui_handle_input(js_status);
-		}
 		//	  	bool wifi_connected = serial_comm_is_wifi_connected();
 		//	    DEBUG_PRINTF(false, "Wifi connected: %d\n", wifi_connected);
 
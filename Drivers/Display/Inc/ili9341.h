@@ -68,6 +68,11 @@ extern SPI_HandleTypeDef ILI9341_SPI_PORT;
 
 /****************************/
 
+// Vertical scrolling (VSCRDEF/VSCRSADD) always runs along the panel's 320 gate lines.
+// It only maps to screen rows when the rotation does not swap rows and columns.
+#define ILI9341_SCROLL_LINES 320
+#define ILI9341_SCROLL_ALONG_Y (!(ILI9341_ROTATION & ILI9341_MADCTL_MV))
+
 // Color definitions
 #define	ILI9341_BLACK   0x0000
 #define	ILI9341_BLUE    0x001F
@@ -82,13 +87,27 @@ extern SPI_HandleTypeDef ILI9341_SPI_PORT;
 // call before initializing any SPI devices
 void ILI9341_Unselect();
 
-void ILI9341_Init(void);
+// Reset and init as a state machine: start it, then step it from the main loop until it
+// returns true. Each step returns at the next reset or sleep-out wait instead of blocking.
+typedef enum {
+    ILI9341_INIT_IDLE,
+    ILI9341_INIT_RESET,         // Reset line held low
+    ILI9341_INIT_COMMANDS,      // Sending the command list, waits between some commands
+    ILI9341_INIT_DONE
+} ILI9341_InitState;
+
+void ILI9341_InitStart(void);
+bool ILI9341_InitStep(void);
+ILI9341_InitState ILI9341_GetInitState(void);
+void ILI9341_Init(void);        // Blocking, runs the state machine to the end
 void ILI9341_DrawPixel(uint16_t x, uint16_t y, uint16_t color);
 void ILI9341_WriteString(uint16_t x, uint16_t y, const char* str, FontDef font, uint16_t color, uint16_t bgcolor);
 void ILI9341_FillRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
 void ILI9341_FillScreen(uint16_t color);
 void ILI9341_DrawImage(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t* data);
 void ILI9341_InvertColors(bool invert);
+void ILI9341_SetVerticalScrollArea(uint16_t top_fixed, uint16_t scroll_height);
+void ILI9341_SetVerticalScrollStart(uint16_t line);
 
 #endif // __UNITY_TEST__
 
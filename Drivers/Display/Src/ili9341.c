@@ -4,10 +4,13 @@
  *      Author: afiskon -https://github.com/afiskon/stm32-ili9341/tree/master/Lib/ili9341
  *  Edited on: Apr 2, 2025
  *      Editor: Natsu
+ *  Modified on: Oct 18, 2026
+ *      Init runs as a state machine that returns while the panel is busy
  */
 
 #include "stm32f4xx_hal.h"
 #include "../Inc/ili9341.h"
+#include <string.h>
 
 static volatile bool ili9341_dma_done = false;
 
@@ -30,12 +33,6 @@ void ILI9341_Unselect() {
     HAL_GPIO_WritePin(ILI9341_CS_GPIO_Port, ILI9341_CS_Pin, GPIO_PIN_SET);
 }
 
-static void ILI9341_Reset() {
-    HAL_GPIO_WritePin(ILI9341_RES_GPIO_Port, ILI9341_RES_Pin, GPIO_PIN_RESET);
-    HAL_Delay(5);
-    HAL_GPIO_WritePin(ILI9341_RES_GPIO_Port, ILI9341_RES_Pin, GPIO_PIN_SET);
-}
-
 static void ILI9341_WriteCommand(uint8_t cmd) {
     HAL_GPIO_WritePin(ILI9341_DC_GPIO_Port, ILI9341_DC_Pin, GPIO_PIN_RESET);
     HAL_GPIO_WritePin(ILI9341_CS_GPIO_Port, ILI9341_CS_Pin, GPIO_PIN_RESET);
@@ -122,159 +119,124 @@ static void ILI9341_SetAddressWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint
     ILI9341_WriteCommand(0x2C); // RAMWR
 }
 
-void ILI9341_Init() {
-    ILI9341_Select();
-    ILI9341_Reset();
-
-    // command list is based on https://github.com/martnak/STM32-ILI9341
+// Init sequence, the command list is based on https://github.com/martnak/STM32-ILI9341.
+// After a command with a delay the panel needs that long before the next one.
+typedef struct {
+    uint8_t cmd;
+    uint8_t length;
+    uint16_t delay_ms;
+    uint8_t data[15];
+} ILI9341_InitCommand;
 
+static const ILI9341_InitCommand init_sequence[] = {
     // SOFTWARE RESET
-    ILI9341_WriteCommand(0x01);
-    HAL_Delay(1000);
-
+    { 0x01, 0, 1000, { 0 } },
     // POWER CONTROL A
-    ILI9341_WriteCommand(0xCB);
-    {
-        uint8_t data[] = { 0x39, 0x2C, 0x00, 0x34, 0x02 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0xCB, 5, 0, { 0x39, 0x2C, 0x00, 0x34, 0x02 } },
     // POWER CONTROL B
-    ILI9341_WriteCommand(0xCF);
-    {
-        uint8_t data[] = { 0x00, 0xC1, 0x30 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0xCF, 3, 0, { 0x00, 0xC1, 0x30 } },
     // DRIVER TIMING CONTROL A
-    ILI9341_WriteCommand(0xE8);
-    {
-        uint8_t data[] = { 0x85, 0x00, 0x78 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0xE8, 3, 0, { 0x85, 0x00, 0x78 } },
     // DRIVER TIMING CONTROL B
-    ILI9341_WriteCommand(0xEA);
-    {
-        uint8_t data[] = { 0x00, 0x00 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0xEA, 2, 0, { 0x00, 0x00 } },
     // POWER ON SEQUENCE CONTROL
-    ILI9341_WriteCommand(0xED);
-    {
-        uint8_t data[] = { 0x64, 0x03, 0x12, 0x81 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0xED, 4, 0, { 0x64, 0x03, 0x12, 0x81 } },
     // PUMP RATIO CONTROL
-    ILI9341_WriteCommand(0xF7);
-    {
-        uint8_t data[] = { 0x20 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0xF7, 1, 0, { 0x20 } },
     // POWER CONTROL,VRH[5:0]
-    ILI9341_WriteCommand(0xC0);
-    {
-        uint8_t data[] = { 0x23 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0xC0, 1, 0, { 0x23 } },
     // POWER CONTROL,SAP[2:0];BT[3:0]
-    ILI9341_WriteCommand(0xC1);
-    {
-        uint8_t data[] = { 0x10 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0xC1, 1, 0, { 0x10 } },
     // VCM CONTROL
-    ILI9341_WriteCommand(0xC5);
-    {
-        uint8_t data[] = { 0x3E, 0x28 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0xC5, 2, 0, { 0x3E, 0x28 } },
     // VCM CONTROL 2
-    ILI9341_WriteCommand(0xC7);
-    {
-        uint8_t data[] = { 0x86 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0xC7, 1, 0, { 0x86 } },
     // MEMORY ACCESS CONTROL
-    ILI9341_WriteCommand(0x36);
-    {
-        uint8_t data[] = { 0x48 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0x36, 1, 0, { 0x48 } },
     // PIXEL FORMAT
-    ILI9341_WriteCommand(0x3A);
-    {
-        uint8_t data[] = { 0x55 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0x3A, 1, 0, { 0x55 } },
     // FRAME RATIO CONTROL, STANDARD RGB COLOR
-    ILI9341_WriteCommand(0xB1);
-    {
-        uint8_t data[] = { 0x00, 0x18 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0xB1, 2, 0, { 0x00, 0x18 } },
     // DISPLAY FUNCTION CONTROL
-    ILI9341_WriteCommand(0xB6);
-    {
-        uint8_t data[] = { 0x08, 0x82, 0x27 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0xB6, 3, 0, { 0x08, 0x82, 0x27 } },
     // 3GAMMA FUNCTION DISABLE
-    ILI9341_WriteCommand(0xF2);
-    {
-        uint8_t data[] = { 0x00 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0xF2, 1, 0, { 0x00 } },
     // GAMMA CURVE SELECTED
-    ILI9341_WriteCommand(0x26);
-    {
-        uint8_t data[] = { 0x01 };
-        ILI9341_WriteData(data, sizeof(data));
-    }
-
+    { 0x26, 1, 0, { 0x01 } },
     // POSITIVE GAMMA CORRECTION
-    ILI9341_WriteCommand(0xE0);
-    {
-        uint8_t data[] = { 0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08, 0x4E, 0xF1,
-                           0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00 };
-        ILI9341_WriteData(data, sizeof(data));
+    { 0xE0, 15, 0, { 0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08, 0x4E, 0xF1,
+                     0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00 } },
+    // NEGATIVE GAMMA CORRECTION
+    { 0xE1, 15, 0, { 0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, 0x31, 0xC1,
+                     0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F } },
+    // EXIT SLEEP
+    { 0x11, 0, 120, { 0 } },
+    // TURN ON DISPLAY
+    { 0x29, 0, 0, { 0 } },
+    // MADCTL
+    { 0x36, 1, 0, { ILI9341_ROTATION } },
+};
+
+#define ILI9341_INIT_COMMAND_COUNT (sizeof(init_sequence) / sizeof(init_sequence[0]))
+#define ILI9341_RESET_PULSE_MS 5
+
+static ILI9341_InitState init_state = ILI9341_INIT_IDLE;
+static uint8_t init_index = 0;
+static uint32_t init_resume_ms = 0;
+
+void ILI9341_InitStart(void) {
+    ILI9341_Select();
+    HAL_GPIO_WritePin(ILI9341_RES_GPIO_Port, ILI9341_RES_Pin, GPIO_PIN_RESET);
+
+    init_state = ILI9341_INIT_RESET;
+    init_index = 0;
+    init_resume_ms = HAL_GetTick() + ILI9341_RESET_PULSE_MS;
+}
+
+bool ILI9341_InitStep(void) {
+    if (init_state == ILI9341_INIT_DONE) {
+        return true;
+    }
+    if (init_state == ILI9341_INIT_IDLE || (int32_t)(HAL_GetTick() - init_resume_ms) < 0) {
+        return false;
     }
 
-    // NEGATIVE GAMMA CORRECTION
-    ILI9341_WriteCommand(0xE1);
-    {
-        uint8_t data[] = { 0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, 0x31, 0xC1,
-                           0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F };
-        ILI9341_WriteData(data, sizeof(data));
+    if (init_state == ILI9341_INIT_RESET) {
+        HAL_GPIO_WritePin(ILI9341_RES_GPIO_Port, ILI9341_RES_Pin, GPIO_PIN_SET);
+        init_state = ILI9341_INIT_COMMANDS;
     }
 
-    // EXIT SLEEP
-    ILI9341_WriteCommand(0x11);
-    HAL_Delay(120);
+    // Send commands up to the next one the panel has to wait out
+    while (init_index < ILI9341_INIT_COMMAND_COUNT) {
+        const ILI9341_InitCommand* command = &init_sequence[init_index++];
 
-    // TURN ON DISPLAY
-    ILI9341_WriteCommand(0x29);
+        ILI9341_WriteCommand(command->cmd);
+        if (command->length > 0) {
+            // Sent by DMA from a RAM copy, like the rest of the driver
+            uint8_t data[sizeof(command->data)];
+            memcpy(data, command->data, command->length);
+            ILI9341_WriteData(data, command->length);
+        }
 
-    // MADCTL
-    ILI9341_WriteCommand(0x36);
-    {
-        uint8_t data[] = { ILI9341_ROTATION };
-        ILI9341_WriteData(data, sizeof(data));
+        if (command->delay_ms > 0) {
+            init_resume_ms = HAL_GetTick() + command->delay_ms;
+            return false;
+        }
     }
 
     ILI9341_Unselect();
+    init_state = ILI9341_INIT_DONE;
+    return true;
+}
+
+ILI9341_InitState ILI9341_GetInitState(void) {
+    return init_state;
+}
+
+void ILI9341_Init() {
+    ILI9341_InitStart();
+    while (!ILI9341_InitStep()) {
+    }
 }
 
 void ILI9341_DrawPixel(uint16_t x, uint16_t y, uint16_t color) {
@@ -430,3 +392,29 @@ void ILI9341_InvertColors(bool invert) {
     ILI9341_WriteCommand(invert ? 0x21 /* INVON */ : 0x20 /* INVOFF */);
     ILI9341_Unselect();
 }
+
+// Define the scrolling area: top fixed lines, scrolling lines, and the remaining bottom fixed lines
+void ILI9341_SetVerticalScrollArea(uint16_t top_fixed, uint16_t scroll_height) {
+    uint16_t bottom_fixed = ILI9341_SCROLL_LINES - top_fixed - scroll_height;
+
+    ILI9341_Select();
+    ILI9341_WriteCommand(0x33); // VSCRDEF
+    {
+        uint8_t data[] = { (top_fixed >> 8) & 0xFF, top_fixed & 0xFF,
+                           (scroll_height >> 8) & 0xFF, scroll_height & 0xFF,
+                           (bottom_fixed >> 8) & 0xFF, bottom_fixed & 0xFF };
+        ILI9341_WriteData(data, sizeof(data));
+    }
+    ILI9341_Unselect();
+}
+
+// Set the memory line shown at the top of the scrolling area
+void ILI9341_SetVerticalScrollStart(uint16_t line) {
+    ILI9341_Select();
+    ILI9341_WriteCommand(0x37); // VSCRSADD
+    {
+        uint8_t data[] = { (line >> 8) & 0xFF, line & 0xFF };
+        ILI9341_WriteData(data, sizeof(data));
+    }
+    ILI9341_Unselect();
+}
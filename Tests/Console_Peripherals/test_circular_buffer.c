@@ -0,0 +1,340 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Utils/comm_utils.h"
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define STRESS_BYTES    (2UL * 1024 * 1024)
+
+static circular_buffer_t cb;
+
+// A stale byte from an earlier lap never matches the byte expected in its place
+static uint8_t stream_byte(uint32_t index) {
+    return (uint8_t)((index * 2654435761UL) >> 24);
+}
+
+static uint32_t lcg_next(uint32_t* state) {
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 16;
+}
+
+static uint64_t cycles_now(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (uint64_t)clock();
+#endif
+}
+
+// The old ring, one shared count both sides wrote to
+typedef struct {
+    uint8_t buffer[CIRCULAR_BUFFER_SIZE];
+    volatile uint16_t head;
+    volatile uint16_t tail;
+    volatile uint16_t count;
+} counted_ring_t;
+
+static bool counted_put(counted_ring_t* ring, uint8_t data) {
+    if (ring->count >= CIRCULAR_BUFFER_SIZE) {
+        return false;
+    }
+    ring->buffer[ring->head] = data;
+    ring->head = (ring->head + 1) % CIRCULAR_BUFFER_SIZE;
+    ring->count++;
+    return true;
+}
+
+static bool counted_get(counted_ring_t* ring, uint8_t* data) {
+    if (ring->count == 0) {
+        return false;
+    }
+    *data = ring->buffer[ring->tail];
+    ring->tail = (ring->tail + 1) % CIRCULAR_BUFFER_SIZE;
+    ring->count--;
+    return true;
+}
+
+typedef struct {
+    uint32_t next;          // Index of the next stream byte
+    uint32_t errors;
+    uint32_t first_error;
+} stress_side_t;
+
+static void* stress_producer(void* arg) {
+    stress_side_t* side = arg;
+    uint8_t chunk[97];
+    uint32_t random = 1;
+
+    while (side->next < STRESS_BYTES) {
+        uint16_t length = 1 + lcg_next(&random) % sizeof(chunk);
+        uint16_t space = circular_buffer_free_space(&cb);
+
+        if (length > STRESS_BYTES - side->next) {
+            length = (uint16_t)(STRESS_BYTES - side->next);
+        }
+        if (length > space) {
+            length = space;
+        }
+        if (length == 0) {
+            sched_yield();      // Full, let the consumer run on a single core host
+            continue;
+        }
+
+        if (length == 1) {
+            circular_buffer_put(&cb, stream_byte(side->next));
+        }
+        else {
+            for (uint16_t i = 0; i < length; i++) {
+                chunk[i] = stream_byte(side->next + i);
+            }
+            circular_buffer_write_span(&cb, chunk, length);
+        }
+        side->next += length;
+    }
+    return NULL;
+}
+
+static void stress_check(stress_side_t* side, const uint8_t* data, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        if (data[i] != stream_byte(side->next + i) && side->errors++ == 0) {
+            side->first_error = side->next + i;
+        }
+    }
+    side->next += length;
+}
+
+static void* stress_consumer(void* arg) {
+    stress_side_t* side = arg;
+    uint8_t chunk[61];
+    const uint8_t* span;
+    uint32_t random = 2;
+
+    while (side->next < STRESS_BYTES) {
+        if (circular_buffer_available(&cb) == 0) {
+            sched_yield();
+            continue;
+        }
+        switch (lcg_next(&random) % 3) {
+            case 0: {
+                uint16_t length = circular_buffer_peek_contiguous(&cb, &span);
+                stress_check(side, span, length);
+                circular_buffer_consume(&cb, length);
+                break;
+            }
+            case 1: {
+                uint16_t length = circular_buffer_read_span(&cb, chunk, 1 + lcg_next(&random) % sizeof(chunk));
+                stress_check(side, chunk, length);
+                break;
+            }
+            default:
+                if (circular_buffer_get(&cb, chunk)) {
+                    stress_check(side, chunk, 1);
+                }
+                break;
+        }
+    }
+    return NULL;
+}
+
+TEST_GROUP(CircularBuffer);
+
+TEST_SETUP(CircularBuffer) {
+    circular_buffer_init(&cb);
+}
+
+TEST_TEAR_DOWN(CircularBuffer) {
+}
+
+TEST(CircularBuffer, PutAndGetAcrossIndexWrap) {
+    uint8_t data;
+
+    // Free-running indices just short of wrapping round
+    cb.head = 65530;
+    cb.tail = 65530;
+
+    for (uint16_t i = 0; i < 20; i++) {
+        TEST_ASSERT_TRUE(circular_buffer_put(&cb, (uint8_t)i));
+    }
+    TEST_ASSERT_EQUAL_UINT16(20, circular_buffer_available(&cb));
+    TEST_ASSERT_EQUAL_UINT16(CIRCULAR_BUFFER_SIZE - 20, circular_buffer_free_space(&cb));
+
+    for (uint16_t i = 0; i < 20; i++) {
+        TEST_ASSERT_TRUE(circular_buffer_get(&cb, &data));
+        TEST_ASSERT_EQUAL_UINT8(i, data);
+    }
+    TEST_ASSERT_FALSE(circular_buffer_get(&cb, &data));
+    TEST_ASSERT_EQUAL_UINT16(0, circular_buffer_available(&cb));
+}
+
+TEST(CircularBuffer, FullBufferCountsWhatItDrops) {
+    static uint8_t data[CIRCULAR_BUFFER_SIZE + 10];
+
+    for (uint16_t i = 0; i < sizeof(data); i++) {
+        data[i] = stream_byte(i);
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(CIRCULAR_BUFFER_SIZE - 6, circular_buffer_write_span(&cb, data, CIRCULAR_BUFFER_SIZE - 6));
+    TEST_ASSERT_EQUAL_UINT16(6, circular_buffer_write_span(&cb, &data[CIRCULAR_BUFFER_SIZE - 6], 16));
+    TEST_ASSERT_EQUAL_UINT32(10, cb.overflow_count);
+    TEST_ASSERT_FALSE(circular_buffer_put(&cb, 0x55));
+    TEST_ASSERT_EQUAL_UINT32(11, cb.overflow_count);
+    TEST_ASSERT_EQUAL_UINT16(0, circular_buffer_free_space(&cb));
+}
+
+TEST(CircularBuffer, SpansWrapRoundTheEnd) {
+    uint8_t data[100];
+    uint8_t out[100];
+    const uint8_t* span;
+
+    for (uint16_t i = 0; i < sizeof(data); i++) {
+        data[i] = stream_byte(i);
+    }
+
+    // 40 bytes before the end, 60 more from the top
+    cb.head = CIRCULAR_BUFFER_SIZE - 40;
+    cb.tail = CIRCULAR_BUFFER_SIZE - 40;
+    TEST_ASSERT_EQUAL_UINT16(100, circular_buffer_write_span(&cb, data, sizeof(data)));
+    TEST_ASSERT_EQUAL_MEMORY(data, &cb.buffer[CIRCULAR_BUFFER_SIZE - 40], 40);
+    TEST_ASSERT_EQUAL_MEMORY(&data[40], cb.buffer, 60);
+
+    // Copying peek sees both parts and leaves them in place
+    TEST_ASSERT_EQUAL_UINT16(100, circular_buffer_peek(&cb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY(data, out, sizeof(data));
+    TEST_ASSERT_EQUAL_UINT16(100, circular_buffer_available(&cb));
+
+    // In place, one side of the end at a time
+    TEST_ASSERT_EQUAL_UINT16(40, circular_buffer_peek_contiguous(&cb, &span));
+    TEST_ASSERT_EQUAL_PTR(&cb.buffer[CIRCULAR_BUFFER_SIZE - 40], span);
+    circular_buffer_consume(&cb, 25);
+    TEST_ASSERT_EQUAL_UINT16(15, circular_buffer_peek_contiguous(&cb, &span));
+    circular_buffer_consume(&cb, 15);
+    TEST_ASSERT_EQUAL_UINT16(60, circular_buffer_peek_contiguous(&cb, &span));
+    TEST_ASSERT_EQUAL_PTR(cb.buffer, span);
+
+    TEST_ASSERT_EQUAL_UINT16(60, circular_buffer_read_span(&cb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY(&data[40], out, 60);
+    TEST_ASSERT_EQUAL_UINT16(0, circular_buffer_peek_contiguous(&cb, &span));
+}
+
+TEST(CircularBuffer, ConsumeNeverPassesTheWriter) {
+    uint8_t data[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    circular_buffer_write_span(&cb, data, sizeof(data));
+    circular_buffer_consume(&cb, 100);
+    TEST_ASSERT_EQUAL_UINT16(0, circular_buffer_available(&cb));
+    TEST_ASSERT_EQUAL_UINT16(CIRCULAR_BUFFER_SIZE, circular_buffer_free_space(&cb));
+}
+
+TEST(CircularBuffer, FlushOnlyMovesTheReader) {
+    uint8_t data[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    uint8_t out[8];
+
+    circular_buffer_write_span(&cb, data, 5);
+    uint16_t head = cb.head;
+    circular_buffer_flush(&cb);
+    TEST_ASSERT_EQUAL_UINT16(head, cb.head);
+    TEST_ASSERT_EQUAL_UINT16(0, circular_buffer_available(&cb));
+
+    // The producer carries on where it was
+    circular_buffer_write_span(&cb, &data[5], 3);
+    TEST_ASSERT_EQUAL_UINT16(3, circular_buffer_read_span(&cb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY(&data[5], out, 3);
+}
+
+TEST(CircularBuffer, TwoThreadsPassEveryByteInOrder) {
+    stress_side_t producer = { 0 };
+    stress_side_t consumer = { 0 };
+    pthread_t producer_thread;
+    pthread_t consumer_thread;
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&consumer_thread, NULL, stress_consumer, &consumer));
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer_thread, NULL, stress_producer, &producer));
+    pthread_join(producer_thread, NULL);
+    pthread_join(consumer_thread, NULL);
+
+    if (consumer.errors != 0) {
+        printf("\nCircularBuffer: first wrong byte at %lu\n", (unsigned long)consumer.first_error);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, consumer.errors);
+    TEST_ASSERT_EQUAL_UINT32(STRESS_BYTES, consumer.next);
+    TEST_ASSERT_EQUAL_UINT32(0, cb.overflow_count);
+    TEST_ASSERT_EQUAL_UINT16(0, circular_buffer_available(&cb));
+}
+
+TEST(CircularBuffer, BytesPerCycle) {
+    static counted_ring_t counted;
+    static uint8_t chunk[256];
+    const uint32_t total = 4UL * 1024 * 1024;
+    volatile uint32_t sink = 0;
+    const uint8_t* span;
+    uint8_t data;
+    uint64_t start;
+
+    memset(&counted, 0, sizeof(counted));
+    for (uint16_t i = 0; i < sizeof(chunk); i++) {
+        chunk[i] = stream_byte(i);
+    }
+
+    // Old: a byte at a time through the shared count
+    start = cycles_now();
+    for (uint32_t done = 0; done < total; done += sizeof(chunk)) {
+        for (uint16_t i = 0; i < sizeof(chunk); i++) {
+            counted_put(&counted, chunk[i]);
+        }
+        while (counted_get(&counted, &data)) {
+            sink += data;
+        }
+    }
+    uint64_t counted_cycles = cycles_now() - start;
+
+    // New, a byte at a time
+    start = cycles_now();
+    for (uint32_t done = 0; done < total; done += sizeof(chunk)) {
+        for (uint16_t i = 0; i < sizeof(chunk); i++) {
+            circular_buffer_put(&cb, chunk[i]);
+        }
+        while (circular_buffer_get(&cb, &data)) {
+            sink += data;
+        }
+    }
+    uint64_t byte_cycles = cycles_now() - start;
+
+    // New, spans in and read in place, the way the parser takes them
+    start = cycles_now();
+    for (uint32_t done = 0; done < total; done += sizeof(chunk)) {
+        circular_buffer_write_span(&cb, chunk, sizeof(chunk));
+        uint16_t length;
+        while ((length = circular_buffer_peek_contiguous(&cb, &span)) > 0) {
+            sink += span[length - 1];
+            circular_buffer_consume(&cb, length);
+        }
+    }
+    uint64_t span_cycles = cycles_now() - start;
+
+    (void)sink;
+    TEST_ASSERT_EQUAL_UINT32(0, cb.overflow_count);
+#if defined(__x86_64__) || defined(__i386__)
+    const char* unit = "TSC cycle";
+#else
+    const char* unit = "clock tick";
+#endif
+    printf("\nCircularBuffer: bytes per %s through the ring - shared count byte at a time %.3f, "
+        "head/tail byte at a time %.3f, 256 byte spans %.3f\n", unit,
+        (double)total / counted_cycles, (double)total / byte_cycles, (double)total / span_cycles);
+}
+
+TEST_GROUP_RUNNER(CircularBuffer) {
+    RUN_TEST_CASE(CircularBuffer, PutAndGetAcrossIndexWrap);
+    RUN_TEST_CASE(CircularBuffer, FullBufferCountsWhatItDrops);
+    RUN_TEST_CASE(CircularBuffer, SpansWrapRoundTheEnd);
+    RUN_TEST_CASE(CircularBuffer, ConsumeNeverPassesTheWriter);
+    RUN_TEST_CASE(CircularBuffer, FlushOnlyMovesTheReader);
+    RUN_TEST_CASE(CircularBuffer, TwoThreadsPassEveryByteInOrder);
+    RUN_TEST_CASE(CircularBuffer, BytesPerCycle);
+}
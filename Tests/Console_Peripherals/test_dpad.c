@@ -1,18 +1,23 @@
 #include <stdint.h>
 #include "../Unity/unity.h"
 #include "../Unity/unity_fixture.h"
-#include "Console_Peripherals/d_pad.h"
-#include "Console_Peripherals/push_button.h"
-#include "Console_Peripherals/Drivers/push_button_driver.h"
+#include "Console_Peripherals/Hardware/d_pad.h"
+#include "Console_Peripherals/Hardware/push_button.h"
+#include "Console_Peripherals/Hardware/Drivers/push_button_driver.h"
 #include "Console_Peripherals/types.h"
 #include "../Mocks/Inc/mock_push_button_driver.h"
+#include "Console_Peripherals/Hardware/input_events.h"
 
-// Helper function that sets mock d-pad states
+// Helper function that sets mock d-pad states and scans until they are debounced
 static void set_dpad_direction(uint8_t up, uint8_t right, uint8_t down, uint8_t left) {
     mock_dpad_up_state = up;
     mock_dpad_right_state = right;
     mock_dpad_down_state = down;
     mock_dpad_left_state = left;
+
+    for (uint8_t i = 0; i < BUTTON_DEBOUNCE_SCANS; i++) {
+        pb_scan();
+    }
 }
 
 TEST_GROUP(DPad);
@@ -23,6 +28,7 @@ TEST_SETUP(DPad) {
     mock_dpad_right_state = 0;
     mock_dpad_down_state = 0;
     mock_dpad_left_state = 0;
+    pb_init();
 
     // Reset d-pad status (call update with no buttons pressed)
     update_d_pad_status();
@@ -210,6 +216,27 @@ TEST(DPad, GetStatusClearsIsNewOnly) {
 }
 
 
+TEST(DPad, EveryChangeIsQueued) {
+    input_queue_reset(&input_events);
+
+    // Up, release and left before anyone reads the status
+    set_dpad_direction(1, 0, 0, 0);
+    update_d_pad_status();
+    set_dpad_direction(0, 0, 0, 0);
+    update_d_pad_status();
+    set_dpad_direction(0, 0, 0, 1);
+    update_d_pad_status();
+
+    // The status only has the latest, the queue has all three
+    TEST_ASSERT_EQUAL(DPAD_DIR_LEFT, d_pad_get_status().direction);
+    TEST_ASSERT_EQUAL(3, input_queue_count(&input_events));
+
+    InputEvent event;
+    input_queue_pop(&input_events, &event);
+    TEST_ASSERT_EQUAL(INPUT_SOURCE_DPAD, event.source);
+    TEST_ASSERT_EQUAL(DPAD_DIR_UP, event.state);
+}
+
 TEST_GROUP_RUNNER(DPad) {
     RUN_TEST_CASE(DPad, InitialState);
     RUN_TEST_CASE(DPad, UpDirection);
@@ -221,4 +248,5 @@ TEST_GROUP_RUNNER(DPad) {
     RUN_TEST_CASE(DPad, NoChangeInDirection);
     RUN_TEST_CASE(DPad, DirectionChangedFlag);
     RUN_TEST_CASE(DPad, GetStatusClearsIsNewOnly);
+    RUN_TEST_CASE(DPad, EveryChangeIsQueued);
 }
\ No newline at end of file
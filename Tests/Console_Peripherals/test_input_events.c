@@ -0,0 +1,77 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Console_Peripherals/Hardware/input_events.h"
+#include "Console_Peripherals/types.h"
+
+static InputQueue queue;
+
+TEST_GROUP(InputEvents);
+
+TEST_SETUP(InputEvents) {
+    input_queue_reset(&queue);
+}
+
+TEST_TEAR_DOWN(InputEvents) {
+}
+
+TEST(InputEvents, EventsComeOutInOrderWithTheirTimestamps) {
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_UP, 1000);
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_LEFT, 1250);
+
+    InputEvent event;
+    TEST_ASSERT_TRUE(input_queue_pop(&queue, &event));
+    TEST_ASSERT_EQUAL(DPAD_DIR_UP, event.state);
+    TEST_ASSERT_EQUAL_UINT32(1000, event.timestamp_us);
+
+    TEST_ASSERT_TRUE(input_queue_pop(&queue, &event));
+    TEST_ASSERT_EQUAL(DPAD_DIR_LEFT, event.state);
+    TEST_ASSERT_EQUAL_UINT32(1250, event.timestamp_us);
+
+    TEST_ASSERT_FALSE(input_queue_pop(&queue, &event));
+}
+
+TEST(InputEvents, FullQueueDropsNewEvents) {
+    for (uint8_t i = 0; i < INPUT_QUEUE_SIZE; i++) {
+        TEST_ASSERT_TRUE(input_queue_push(&queue, INPUT_SOURCE_JOYSTICK, i, i));
+    }
+
+    TEST_ASSERT_FALSE(input_queue_push(&queue, INPUT_SOURCE_JOYSTICK, 99, 99));
+    TEST_ASSERT_EQUAL(1, queue.dropped);
+    TEST_ASSERT_EQUAL(INPUT_QUEUE_SIZE, input_queue_count(&queue));
+
+    // The oldest events are kept
+    InputEvent event;
+    input_queue_pop(&queue, &event);
+    TEST_ASSERT_EQUAL(0, event.state);
+}
+
+TEST(InputEvents, IndicesWrapAround) {
+    InputEvent event;
+
+    // Push and pop past the 8-bit index range
+    for (uint16_t i = 0; i < 300; i++) {
+        TEST_ASSERT_TRUE(input_queue_push(&queue, INPUT_SOURCE_DPAD, (uint8_t)i, i));
+        TEST_ASSERT_TRUE(input_queue_pop(&queue, &event));
+        TEST_ASSERT_EQUAL_UINT32(i, event.timestamp_us);
+    }
+    TEST_ASSERT_EQUAL(0, input_queue_count(&queue));
+}
+
+TEST(InputEvents, FlushDropsQueuedEvents) {
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_UP, 0);
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_DOWN, 0);
+
+    input_queue_flush(&queue);
+
+    InputEvent event;
+    TEST_ASSERT_FALSE(input_queue_pop(&queue, &event));
+    TEST_ASSERT_TRUE(input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_LEFT, 0));
+    TEST_ASSERT_EQUAL(1, input_queue_count(&queue));
+}
+
+TEST_GROUP_RUNNER(InputEvents) {
+    RUN_TEST_CASE(InputEvents, EventsComeOutInOrderWithTheirTimestamps);
+    RUN_TEST_CASE(InputEvents, FullQueueDropsNewEvents);
+    RUN_TEST_CASE(InputEvents, IndicesWrapAround);
+    RUN_TEST_CASE(InputEvents, FlushDropsQueuedEvents);
+}
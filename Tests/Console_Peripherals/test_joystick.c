@@ -1,7 +1,7 @@
 #include "../Unity/unity.h"
 #include "../Unity/unity_fixture.h"
-#include "Console_Peripherals/joystick.h"
-#include "Console_Peripherals/Drivers/joystick_driver.h" 
+#include "Console_Peripherals/Hardware/joystick.h"
+#include "Console_Peripherals/Hardware/Drivers/joystick_driver.h" 
 
 TEST_GROUP(Joystick);
 
@@ -92,6 +92,63 @@ TEST(Joystick, StatusUpdateTest) {
     TEST_ASSERT_EQUAL(0, status.is_new);  // Should not be new
 }
 
+TEST(Joystick, FilterAveragesOneAxis) {
+    // Y/X interleaved like the DMA buffer
+    uint16_t samples[] = { 100, 2000, 100, 2010, 100, 2020, 100, 2030 };
+
+    TEST_ASSERT_EQUAL(2015, joystick_filter_samples(&samples[1], 4, 2));
+    TEST_ASSERT_EQUAL(100, joystick_filter_samples(&samples[0], 4, 2));
+}
+
+TEST(Joystick, FilterRejectsSpikes) {
+    uint16_t samples[] = { 2048, 2050, 4095, 2046, 2048, 0, 2052, 2044 };
+
+    // The spike and the dropout are the extremes that get dropped
+    TEST_ASSERT_EQUAL(2048, joystick_filter_samples(samples, 8, 1));
+}
+
+TEST(Joystick, DeadZoneSnapsToCenter) {
+    TEST_ASSERT_EQUAL(JOYSTICK_ADC_CENTER, joystick_apply_calibration(2100, 2100 - JOYSTICK_DEAD_ZONE, JOYSTICK_DEAD_ZONE));
+    TEST_ASSERT_EQUAL(JOYSTICK_ADC_CENTER, joystick_apply_calibration(2000, 2000 + JOYSTICK_DEAD_ZONE, JOYSTICK_DEAD_ZONE));
+    TEST_ASSERT_EQUAL(JOYSTICK_ADC_CENTER + 100, joystick_apply_calibration(2148, 2048, JOYSTICK_DEAD_ZONE));
+}
+
+TEST(Joystick, CalibrationMovesCenter) {
+    TEST_ASSERT_TRUE(joystick_calibrate(2150, 1950));
+    TEST_ASSERT_EQUAL(2150, joystick_get_calibration()->center_x);
+
+    // Offsets are kept relative to the measured rest position and clamped to the ADC range
+    TEST_ASSERT_EQUAL(JOYSTICK_ADC_CENTER - 500, joystick_apply_calibration(1650, 2150, JOYSTICK_DEAD_ZONE));
+    TEST_ASSERT_EQUAL(JOYSTICK_ADC_MAX, joystick_apply_calibration(4095, 1950, JOYSTICK_DEAD_ZONE));
+    TEST_ASSERT_EQUAL(0, joystick_apply_calibration(0, 2150, JOYSTICK_DEAD_ZONE));
+}
+
+TEST(Joystick, CalibrationIgnoresHeldStick) {
+    TEST_ASSERT_FALSE(joystick_calibrate(3000, 2048));
+    TEST_ASSERT_EQUAL(JOYSTICK_ADC_CENTER, joystick_get_calibration()->center_x);
+    TEST_ASSERT_EQUAL(JOYSTICK_ADC_CENTER, joystick_get_calibration()->center_y);
+}
+
+TEST(Joystick, StatusUsesCalibratedValues) {
+    // Rest position off center - first update calibrates, stick reads centered
+    joystick_driver_set_values(2200, 2048, 0);
+    update_joystick_status();
+    TEST_ASSERT_EQUAL(JS_DIR_CENTERED, joystick_get_status().direction);
+
+    // A push that would be right of a centered stick is only 250 counts from rest here
+    joystick_driver_set_values(2200 + 250, 2048, 0);
+    update_joystick_status();
+    TEST_ASSERT_EQUAL(JS_DIR_CENTERED, joystick_get_status().direction);
+
+    joystick_driver_set_values(2200 + 500, 2048, 1);
+    update_joystick_status();
+    JoystickStatus status = joystick_get_status();
+    TEST_ASSERT_EQUAL(JS_DIR_RIGHT, status.direction);
+    TEST_ASSERT_EQUAL(1, status.button);
+    TEST_ASSERT_EQUAL(1, status.is_new);
+    TEST_ASSERT_EQUAL(0, joystick_get_status().is_new);
+}
+
 TEST_GROUP_RUNNER(Joystick) {
     RUN_TEST_CASE(Joystick, CenterPosition);
     RUN_TEST_CASE(Joystick, LeftDirection);
@@ -105,4 +162,10 @@ TEST_GROUP_RUNNER(Joystick) {
     RUN_TEST_CASE(Joystick, OutOfRangeHigh);
     RUN_TEST_CASE(Joystick, ThresholdTests);
     RUN_TEST_CASE(Joystick, StatusUpdateTest);
+    RUN_TEST_CASE(Joystick, FilterAveragesOneAxis);
+    RUN_TEST_CASE(Joystick, FilterRejectsSpikes);
+    RUN_TEST_CASE(Joystick, DeadZoneSnapsToCenter);
+    RUN_TEST_CASE(Joystick, CalibrationMovesCenter);
+    RUN_TEST_CASE(Joystick, CalibrationIgnoresHeldStick);
+    RUN_TEST_CASE(Joystick, StatusUsesCalibratedValues);
 }
@@ -1,40 +1,50 @@
 #include <stdint.h>
 #include "../Unity/unity.h"
 #include "../Unity/unity_fixture.h"
-#include "Console_Peripherals/push_button.h"
-#include "Console_Peripherals/Drivers/push_button_driver.h"
+#include "Console_Peripherals/Hardware/push_button.h"
+#include "Console_Peripherals/Hardware/d_pad.h"
+#include "Console_Peripherals/Hardware/Drivers/push_button_driver.h"
 #include "../Mocks/Inc/mock_push_button_driver.h"
+#include "Console_Peripherals/Hardware/input_events.h"
+
+// Run the SysTick scan a number of times with the current mock pin states
+static void scan(uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        pb_scan();
+    }
+}
+
+// Scan until the current mock pin states are debounced
+static void settle(void) {
+    scan(BUTTON_DEBOUNCE_SCANS);
+}
 
 // Helper function for edge detection
-static void detect_button1_press(uint8_t button_state, uint32_t initial_time, uint32_t debounced_time) {
+static void detect_button1_press(uint8_t button_state) {
     // Set initial state
     mock_pb1_state = button_state;
 
-    // First check - Button change detected but not debounced
-    mock_tick_count = initial_time;
+    // First check - Button change seen but not debounced
+    scan(BUTTON_DEBOUNCE_SCANS - 1);
     TEST_ASSERT_EQUAL(0, pb1_get_state());
 
-    // Second check - After debounce time
-    mock_tick_count = debounced_time;
+    // Second check - After the last debounce scan
+    scan(1);
     TEST_ASSERT_EQUAL(button_state, pb1_get_state());
 
-    // Third check - Edge detected, should be 0
+    // Third check - Edge taken, should be 0
     TEST_ASSERT_EQUAL(0, pb1_get_state());
 }
 
-static void detect_button2_press(uint8_t button_state, uint32_t initial_time, uint32_t debounced_time) {
-    // Set initial state
+static void detect_button2_press(uint8_t button_state) {
     mock_pb2_state = button_state;
 
-    // First check - Button change detected but not debounced
-    mock_tick_count = initial_time;
+    scan(BUTTON_DEBOUNCE_SCANS - 1);
     TEST_ASSERT_EQUAL(0, pb2_get_state());
 
-    // Second check - After debounce time
-    mock_tick_count = debounced_time;
+    scan(1);
     TEST_ASSERT_EQUAL(button_state, pb2_get_state());
 
-    // Third check - Edge detected, should be 0
     TEST_ASSERT_EQUAL(0, pb2_get_state());
 }
 
@@ -65,6 +75,8 @@ TEST_SETUP(PushButton) {
     mock_dpad_down_state = 0;
     mock_tick_count = 0;
     pb_init();
+    update_d_pad_status();      // Back to no direction after the previous test
+    input_queue_reset(&input_events);
 }
 
 TEST_TEAR_DOWN(PushButton) {
@@ -72,6 +84,7 @@ TEST_TEAR_DOWN(PushButton) {
 }
 
 TEST(PushButton, InitialState) {
+    settle();
     TEST_ASSERT_EQUAL(0, pb1_get_state());
     TEST_ASSERT_EQUAL(0, pb2_get_state());
     TEST_ASSERT_EQUAL(0, dpad_pin_left_get_state());
@@ -81,33 +94,30 @@ TEST(PushButton, InitialState) {
 }
 
 TEST(PushButton, SinglePress) {
-    detect_button1_press(1, 150, 300);
+    detect_button1_press(1);
 }
 
 TEST(PushButton, ButtonBounce) {
-    // Initial press with bounce
-    mock_pb1_state = 1;
-    mock_tick_count = 10;
-    TEST_ASSERT_EQUAL(0, pb1_get_state());
-
-    // Bounce
-    mock_pb1_state = 0;
-    mock_tick_count = 20;
+    // Contact bounce - the reading never holds for a full debounce
+    for (uint8_t i = 0; i < 10; i++) {
+        mock_pb1_state = (i + 1) & 1;
+        scan(1);
+    }
     TEST_ASSERT_EQUAL(0, pb1_get_state());
 
     // Stable press
-    detect_button1_press(1, 150, 300);
+    detect_button1_press(1);
 }
 
 TEST(PushButton, MultiplePress) {
     // First press
-    detect_button1_press(1, 150, 300);
+    detect_button1_press(1);
 
     // Release and wait for debounce
-    detect_button1_press(0, 450, 600);
+    detect_button1_press(0);
 
     // Second press
-    detect_button2_press(1, 750, 900);
+    detect_button2_press(1);
 }
 
 TEST(PushButton, TwoButtonsIndependent) {
@@ -116,12 +126,12 @@ TEST(PushButton, TwoButtonsIndependent) {
     mock_pb2_state = 1;
 
     // Initial check for both
-    mock_tick_count = 150;
+    scan(1);
     TEST_ASSERT_EQUAL(0, pb1_get_state());
     TEST_ASSERT_EQUAL(0, pb2_get_state());
 
     // After debounce time, both should trigger
-    mock_tick_count = 300;
+    settle();
     TEST_ASSERT_EQUAL(1, pb1_get_state());
     TEST_ASSERT_EQUAL(1, pb2_get_state());
 
@@ -131,94 +141,108 @@ TEST(PushButton, TwoButtonsIndependent) {
 
     // Release button 1 only
     mock_pb1_state = 0;
-
-    // Process release for button 1
-    mock_tick_count = 450;
-    TEST_ASSERT_EQUAL(0, pb1_get_state());
-    mock_tick_count = 600;
+    settle();
     TEST_ASSERT_EQUAL(0, pb1_get_state());  // Still 0 since it's a release
+    TEST_ASSERT_EQUAL(BUTTON_PB1, pb_take_released(BUTTON_PB1 | BUTTON_PB2));
 
     // Button 2 should remain unchanged
     TEST_ASSERT_EQUAL(0, pb2_get_state());  // Already triggered and reset
+    TEST_ASSERT_EQUAL(1, pb2_is_down());
 
     // Press button 1 again
-    detect_button1_press(1, 750, 900);
+    detect_button1_press(1);
     TEST_ASSERT_EQUAL(0, pb2_get_state());  // Button 2 should still remain unchanged
 }
 
 TEST(PushButton, QuickPressIgnored) {
     mock_pb1_state = 1;
-    mock_tick_count = 10;
-    TEST_ASSERT_EQUAL(0, pb1_get_state());
+    scan(BUTTON_DEBOUNCE_SCANS - 1);
 
     mock_pb1_state = 0;
-    mock_tick_count = 20;
+    settle();
     TEST_ASSERT_EQUAL(0, pb1_get_state());
+    TEST_ASSERT_EQUAL(0, pb_take_released(BUTTON_PB1));
 }
 
 TEST(PushButton, LongPress) {
     // Initial press detection
-    detect_button1_press(1, 150, 300);
+    detect_button1_press(1);
+
+    // Held edge once the hold counter rolls over
+    scan((1U << BUTTON_HOLD_BITS) - 2);
+    TEST_ASSERT_EQUAL(0, pb_take_held(BUTTON_PB1));
+    scan(1);
+    TEST_ASSERT_EQUAL(BUTTON_PB1, pb_take_held(BUTTON_PB1));
 
     // Long press should not trigger again
-    mock_tick_count = 1000;
+    scan(1U << BUTTON_HOLD_BITS);
     TEST_ASSERT_EQUAL(0, pb1_get_state());
+    TEST_ASSERT_EQUAL(0, pb_take_held(BUTTON_PB1));
+
+    // A new press is held again
+    detect_button1_press(0);
+    detect_button1_press(1);
+    scan(1U << BUTTON_HOLD_BITS);
+    TEST_ASSERT_EQUAL(BUTTON_PB1, pb_take_held(BUTTON_PB1));
 }
 
 // New tests for D-pad functionality
 TEST(PushButton, DPadLeftState) {
     // Test low state
     set_dpad_left_state(0);
+    settle();
     TEST_ASSERT_EQUAL(0, dpad_pin_left_get_state());
 
     // Test high state
     set_dpad_left_state(1);
+    settle();
     TEST_ASSERT_EQUAL(1, dpad_pin_left_get_state());
 
     // Test toggling back to low
     set_dpad_left_state(0);
+    settle();
     TEST_ASSERT_EQUAL(0, dpad_pin_left_get_state());
 }
 
 TEST(PushButton, DPadRightState) {
-    // Test low state
     set_dpad_right_state(0);
+    settle();
     TEST_ASSERT_EQUAL(0, dpad_pin_right_get_state());
 
-    // Test high state
     set_dpad_right_state(1);
+    settle();
     TEST_ASSERT_EQUAL(1, dpad_pin_right_get_state());
 
-    // Test toggling back to low
     set_dpad_right_state(0);
+    settle();
     TEST_ASSERT_EQUAL(0, dpad_pin_right_get_state());
 }
 
 TEST(PushButton, DPadUpState) {
-    // Test low state
     set_dpad_up_state(0);
+    settle();
     TEST_ASSERT_EQUAL(0, dpad_pin_up_get_state());
 
-    // Test high state
     set_dpad_up_state(1);
+    settle();
     TEST_ASSERT_EQUAL(1, dpad_pin_up_get_state());
 
-    // Test toggling back to low
     set_dpad_up_state(0);
+    settle();
     TEST_ASSERT_EQUAL(0, dpad_pin_up_get_state());
 }
 
 TEST(PushButton, DPadDownState) {
-    // Test low state
     set_dpad_down_state(0);
+    settle();
     TEST_ASSERT_EQUAL(0, dpad_pin_down_get_state());
 
-    // Test high state
     set_dpad_down_state(1);
+    settle();
     TEST_ASSERT_EQUAL(1, dpad_pin_down_get_state());
 
-    // Test toggling back to low
     set_dpad_down_state(0);
+    settle();
     TEST_ASSERT_EQUAL(0, dpad_pin_down_get_state());
 }
 
@@ -228,6 +252,7 @@ TEST(PushButton, DPadIndependence) {
     set_dpad_right_state(0);
     set_dpad_up_state(1);
     set_dpad_down_state(0);
+    settle();
 
     // Verify each direction reports correct state independently
     TEST_ASSERT_EQUAL(1, dpad_pin_left_get_state());
@@ -240,6 +265,7 @@ TEST(PushButton, DPadIndependence) {
     set_dpad_right_state(1);
     set_dpad_up_state(0);
     set_dpad_down_state(1);
+    settle();
 
     // Verify states changed correctly
     TEST_ASSERT_EQUAL(0, dpad_pin_left_get_state());
@@ -257,19 +283,20 @@ TEST(PushButton, DPadAndButtonsIndependence) {
     set_dpad_up_state(1);
     set_dpad_down_state(0);
 
-    // Check D-pad direct readings
+    // Nothing is taken before the debounce
+    scan(1);
+    TEST_ASSERT_EQUAL(0, dpad_pin_left_get_state());
+    TEST_ASSERT_EQUAL(0, dpad_pin_up_get_state());
+    TEST_ASSERT_EQUAL(0, pb1_get_state());
+    TEST_ASSERT_EQUAL(0, pb2_get_state());
+
+    // After debounce time, one scan took every input
+    settle();
+    TEST_ASSERT_EQUAL(BUTTON_PB1 | BUTTON_DPAD_LEFT | BUTTON_DPAD_UP, pb_get_levels());
     TEST_ASSERT_EQUAL(1, dpad_pin_left_get_state());
     TEST_ASSERT_EQUAL(0, dpad_pin_right_get_state());
     TEST_ASSERT_EQUAL(1, dpad_pin_up_get_state());
     TEST_ASSERT_EQUAL(0, dpad_pin_down_get_state());
-
-    // Check debounced button readings (initially 0 due to debounce)
-    mock_tick_count = 50;
-    TEST_ASSERT_EQUAL(0, pb1_get_state());
-    TEST_ASSERT_EQUAL(0, pb2_get_state());
-
-    // After debounce time
-    mock_tick_count = 200;
     TEST_ASSERT_EQUAL(1, pb1_get_state());
     TEST_ASSERT_EQUAL(0, pb2_get_state());
 
@@ -283,6 +310,43 @@ TEST(PushButton, DPadAndButtonsIndependence) {
     TEST_ASSERT_EQUAL(0, dpad_pin_down_get_state());
 }
 
+TEST(PushButton, DPadBounceQueuesNoEvents) {
+    // A bouncing contact used to fire one EXTI interrupt per edge
+    for (uint8_t i = 0; i < 10; i++) {
+        set_dpad_up_state((i + 1) & 1);
+        scan(1);
+    }
+    TEST_ASSERT_EQUAL(0, input_queue_count(&input_events));
+
+    // The settled press is a single event
+    set_dpad_up_state(1);
+    settle();
+    TEST_ASSERT_EQUAL(1, input_queue_count(&input_events));
+}
+
+TEST(PushButton, DebouncerEdgeMasks) {
+    Debouncer debouncer;
+    debouncer_reset(&debouncer);
+
+    for (uint8_t i = 0; i < BUTTON_DEBOUNCE_SCANS; i++) {
+        debouncer_update(&debouncer, BUTTON_PB2 | BUTTON_DPAD_DOWN);
+    }
+    TEST_ASSERT_EQUAL(BUTTON_PB2 | BUTTON_DPAD_DOWN, debouncer.pressed);
+    TEST_ASSERT_EQUAL(0, debouncer.released);
+
+    // Releases and presses in the same update
+    for (uint8_t i = 0; i < BUTTON_DEBOUNCE_SCANS; i++) {
+        debouncer_update(&debouncer, BUTTON_PB1 | BUTTON_DPAD_DOWN);
+    }
+    TEST_ASSERT_EQUAL(BUTTON_PB1, debouncer.pressed);
+    TEST_ASSERT_EQUAL(BUTTON_PB2, debouncer.released);
+    TEST_ASSERT_EQUAL(BUTTON_PB1 | BUTTON_DPAD_DOWN, debouncer.state);
+
+    // Edges last for one update only
+    debouncer_update(&debouncer, BUTTON_PB1 | BUTTON_DPAD_DOWN);
+    TEST_ASSERT_EQUAL(0, debouncer.pressed | debouncer.released);
+}
+
 TEST_GROUP_RUNNER(PushButton) {
     RUN_TEST_CASE(PushButton, InitialState);
     RUN_TEST_CASE(PushButton, SinglePress);
@@ -297,4 +361,6 @@ TEST_GROUP_RUNNER(PushButton) {
     RUN_TEST_CASE(PushButton, DPadDownState);
     RUN_TEST_CASE(PushButton, DPadIndependence);
     RUN_TEST_CASE(PushButton, DPadAndButtonsIndependence);
-}
\ No newline at end of file
+    RUN_TEST_CASE(PushButton, DPadBounceQueuesNoEvents);
+    RUN_TEST_CASE(PushButton, DebouncerEdgeMasks);
+}
@@ -0,0 +1,202 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Utils/comm_utils.h"
+#include "Communication/serial_comm_types.h"
+#include "Mocks/Inc/mock_crc_driver.h"
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+
+// CRC-32/MPEG-2 of bytes (i * 37 + 11) for i < length
+static const struct {
+    uint16_t length;
+    uint32_t crc;
+} vectors[] = {
+    { 0, 0xFFFFFFFFUL },
+    { 1, 0x654374D5UL },
+    { 2, 0x2C26156CUL },
+    { 3, 0xE46881E8UL },
+    { 4, 0x71127394UL },
+    { 5, 0xEB541273UL },
+    { 7, 0x03A400A3UL },
+    { 250, 0x1E850AAEUL }
+};
+
+static uint8_t data[SERIAL_FRAME_MAX_RAW_SIZE];
+
+// One bit at a time, the definition the tables and the CRC unit have to agree with
+static uint32_t crc32_bitwise(const uint8_t* bytes, uint16_t length) {
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (uint16_t i = 0; i < length; i++) {
+        crc ^= (uint32_t)bytes[i] << 24;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80000000UL) ? (crc << 1) ^ 0x04C11DB7UL : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// The old frame check, over the whole 255 byte message
+static uint8_t xor_checksum(const uint8_t* bytes, uint16_t length) {
+    uint8_t checksum = 0;
+
+    for (uint16_t i = 0; i < length; i++) {
+        checksum ^= bytes[i];
+    }
+    return checksum;
+}
+
+static double seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+TEST_GROUP(SerialCrc);
+
+TEST_SETUP(SerialCrc) {
+    for (uint16_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 37 + 11);
+    }
+    mock_crc_reset();
+    serial_frame_register_crc(NULL);
+}
+
+TEST_TEAR_DOWN(SerialCrc) {
+    serial_frame_register_crc(NULL);
+}
+
+TEST(SerialCrc, CheckValueOfEveryImplementation) {
+    const uint8_t* check = (const uint8_t*)"123456789";
+
+    TEST_ASSERT_EQUAL_HEX32(0x0376E6E7UL, crc32_bitwise(check, 9));
+    TEST_ASSERT_EQUAL_HEX32(0x0376E6E7UL, crc32_mpeg2(check, 9, 0xFFFFFFFFUL));
+    TEST_ASSERT_EQUAL_HEX32(0x0376E6E7UL, crc_driver_compute(check, 9));
+}
+
+TEST(SerialCrc, ImplementationsAgreeOnTheSharedVectors) {
+    for (uint8_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+        TEST_ASSERT_EQUAL_HEX32(vectors[i].crc, crc32_bitwise(data, vectors[i].length));
+        TEST_ASSERT_EQUAL_HEX32(vectors[i].crc, crc32_mpeg2(data, vectors[i].length, 0xFFFFFFFFUL));
+        TEST_ASSERT_EQUAL_HEX32(vectors[i].crc, crc_driver_compute(data, vectors[i].length));
+    }
+
+    // Every length and alignment, so each tail size meets each table step
+    for (uint16_t offset = 0; offset < 4; offset++) {
+        for (uint16_t length = 0; length + offset <= sizeof(data); length += 5) {
+            uint32_t expected = crc32_bitwise(&data[offset], length);
+            TEST_ASSERT_EQUAL_HEX32(expected, crc32_mpeg2(&data[offset], length, 0xFFFFFFFFUL));
+            TEST_ASSERT_EQUAL_HEX32(expected, crc_driver_compute(&data[offset], length));
+        }
+    }
+}
+
+TEST(SerialCrc, CrcCanContinueAcrossBuffers) {
+    uint32_t crc = crc32_mpeg2(data, 13, 0xFFFFFFFFUL);
+    crc = crc32_mpeg2(&data[13], 100, crc);
+    TEST_ASSERT_EQUAL_HEX32(crc32_bitwise(data, 113), crc);
+}
+
+TEST(SerialCrc, UnitIsFedAWordAtATime) {
+    TEST_ASSERT_EQUAL_HEX32(crc32_bitwise(data, 127), crc_driver_compute(data, 127));
+    TEST_ASSERT_EQUAL_UINT32(31, mock_crc_words_fed());
+}
+
+TEST(SerialCrc, FramesCheckedByTheUnitMatchSoftware) {
+    uint8_t payload[40];
+    uint8_t hardware[SERIAL_FRAME_MAX_WIRE_SIZE];
+    uint8_t software[SERIAL_FRAME_MAX_WIRE_SIZE];
+    serial_frame_t frame;
+
+    memcpy(payload, data, sizeof(payload));
+    uint16_t length = serial_frame_encode(MSG_TYPE_DATA, 300, payload, sizeof(payload), software);
+
+    serial_frame_register_crc(crc_driver_compute);
+    TEST_ASSERT_EQUAL_UINT16(length, serial_frame_encode(MSG_TYPE_DATA, 300, payload, sizeof(payload), hardware));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(software, hardware, length);
+    TEST_ASSERT_EQUAL(SERIAL_FRAME_OK, serial_frame_decode(&software[1], length - 2, &frame));
+    TEST_ASSERT_EQUAL_UINT32(2, mock_crc_computations());
+}
+
+TEST(SerialCrc, CatchesWhatTheXorChecksumMissed) {
+    uint8_t frame[SERIAL_FRAME_MAX_RAW_SIZE];
+    uint16_t length = 120;
+
+    memcpy(frame, data, length);
+    uint8_t xor_before = xor_checksum(frame, length);
+    uint32_t crc_before = crc32_mpeg2(frame, length, 0xFFFFFFFFUL);
+
+    // Two bytes swapped
+    uint8_t swap = frame[10];
+    frame[10] = frame[11];
+    frame[11] = swap;
+    TEST_ASSERT_EQUAL_HEX8(xor_before, xor_checksum(frame, length));
+    TEST_ASSERT_NOT_EQUAL(crc_before, crc32_mpeg2(frame, length, 0xFFFFFFFFUL));
+
+    // The same bit flipped in two bytes
+    memcpy(frame, data, length);
+    frame[3] ^= 0x04;
+    frame[90] ^= 0x04;
+    TEST_ASSERT_EQUAL_HEX8(xor_before, xor_checksum(frame, length));
+    TEST_ASSERT_NOT_EQUAL(crc_before, crc32_mpeg2(frame, length, 0xFFFFFFFFUL));
+
+    // Every burst of up to 32 bits
+    for (uint16_t bit = 0; bit + 32 <= length * 8; bit += 29) {
+        memcpy(frame, data, length);
+        for (uint8_t i = 0; i < 32; i += 3) {
+            frame[(bit + i) / 8] ^= (uint8_t)(0x80 >> ((bit + i) % 8));
+        }
+        TEST_ASSERT_NOT_EQUAL(crc_before, crc32_mpeg2(frame, length, 0xFFFFFFFFUL));
+    }
+}
+
+TEST(SerialCrc, CostAgainstTheXorChecksum) {
+    const uint32_t rounds = 100000;
+    volatile uint32_t sink = 0;
+    clock_t start;
+
+    // Old: XOR over all 255 bytes of every message
+    start = clock();
+    for (uint32_t i = 0; i < rounds; i++) {
+        data[0] = (uint8_t)i;
+        sink += xor_checksum(data, 255);
+    }
+    double xor_full = seconds_since(start);
+
+    // New: CRC over the header and payload only, for game data and for an ACK
+    start = clock();
+    for (uint32_t i = 0; i < rounds; i++) {
+        data[0] = (uint8_t)i;
+        sink += crc32_mpeg2(data, 4 + 116, 0xFFFFFFFFUL);
+    }
+    double crc_game_data = seconds_since(start);
+
+    start = clock();
+    for (uint32_t i = 0; i < rounds; i++) {
+        data[0] = (uint8_t)i;
+        sink += crc32_mpeg2(data, 4, 0xFFFFFFFFUL);
+    }
+    double crc_ack = seconds_since(start);
+
+    start = clock();
+    for (uint32_t i = 0; i < rounds; i++) {
+        data[0] = (uint8_t)i;
+        sink += crc32_bitwise(data, 4 + 116);
+    }
+    double crc_bitwise = seconds_since(start);
+
+    (void)sink;
+    printf("\nSerialCrc: ns per message - XOR over 255 bytes %.0f, slice-by-4 CRC-32 over game data %.0f, "
+        "over an ACK %.0f, bit at a time over game data %.0f\n",
+        xor_full * 1e9 / rounds, crc_game_data * 1e9 / rounds, crc_ack * 1e9 / rounds,
+        crc_bitwise * 1e9 / rounds);
+}
+
+TEST_GROUP_RUNNER(SerialCrc) {
+    RUN_TEST_CASE(SerialCrc, CheckValueOfEveryImplementation);
+    RUN_TEST_CASE(SerialCrc, ImplementationsAgreeOnTheSharedVectors);
+    RUN_TEST_CASE(SerialCrc, CrcCanContinueAcrossBuffers);
+    RUN_TEST_CASE(SerialCrc, UnitIsFedAWordAtATime);
+    RUN_TEST_CASE(SerialCrc, FramesCheckedByTheUnitMatchSoftware);
+    RUN_TEST_CASE(SerialCrc, CatchesWhatTheXorChecksumMissed);
+    RUN_TEST_CASE(SerialCrc, CostAgainstTheXorChecksum);
+}
@@ -0,0 +1,353 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Utils/comm_utils.h"
+#include "Console_Peripherals/Hardware/serial_comm_core.h"
+#include "Mocks/Inc/mock_uart_driver.h"
+#include "Mocks/Inc/mock_utils.h"
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+
+#define MAX_FRAMES      64
+#define STREAM_SIZE     (MAX_FRAMES * (SERIAL_FRAME_MAX_WIRE_SIZE + 16))
+#define GAME_DATA_SIZE  116     // sizeof(uart_game_data_t)
+
+typedef struct {
+    uint8_t type;
+    uint8_t length;
+    uint16_t sequence;
+    uint8_t payload[SERIAL_FRAME_MAX_PAYLOAD];
+} received_frame_t;
+
+static message_parser_t parser;
+static uint8_t parse_buffer[SERIAL_FRAME_MAX_ENCODED_SIZE];
+static received_frame_t received[MAX_FRAMES];
+static uint16_t received_count;
+static uint16_t bad_frames;
+
+static uint8_t stream[STREAM_SIZE];
+static uint16_t stream_length;
+
+static uint32_t lcg_state;
+
+static uint32_t next_random(void) {
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return lcg_state >> 16;
+}
+
+static uint16_t append_frame(uint8_t type, uint16_t sequence, const uint8_t* payload, uint8_t length) {
+    uint16_t size = serial_frame_encode(type, sequence, payload, length, &stream[stream_length]);
+    stream_length += size;
+    return size;
+}
+
+static void append_noise(uint16_t length, bool with_zeros) {
+    for (uint16_t i = 0; i < length; i++) {
+        uint8_t byte = (uint8_t)next_random();
+        stream[stream_length++] = (with_zeros || byte != 0) ? byte : 0x5A;
+    }
+}
+
+static void fill_payload(uint8_t* payload, uint8_t length, uint8_t seed) {
+    for (uint16_t i = 0; i < length; i++) {
+        // Zeros and long zero-free runs both appear
+        payload[i] = (i % 7 == 3) ? 0 : (uint8_t)(seed + i);
+    }
+}
+
+// The receive side, fed in chunks of 1 to max_chunk bytes as the DMA would deliver them
+static void feed(uint16_t max_chunk) {
+    for (uint16_t sent = 0; sent < stream_length;) {
+        uint16_t chunk = 1 + next_random() % max_chunk;
+        if (chunk > stream_length - sent) {
+            chunk = stream_length - sent;
+        }
+
+        uint16_t offset = 0;
+        while (offset < chunk) {
+            offset += message_parser_add_delimited(&parser, &stream[sent + offset], chunk - offset,
+                SERIAL_FRAME_DELIMITER);
+            if (message_parser_is_complete(&parser)) {
+                serial_frame_t frame;
+                if (serial_frame_decode(message_parser_get_buffer(&parser),
+                    message_parser_get_length(&parser), &frame) == SERIAL_FRAME_OK) {
+                    TEST_ASSERT_TRUE(received_count < MAX_FRAMES);
+                    received_frame_t* out = &received[received_count++];
+                    out->type = frame.type;
+                    out->length = frame.length;
+                    out->sequence = frame.sequence;
+                    memcpy(out->payload, frame.payload, frame.length);
+                }
+                else {
+                    bad_frames++;
+                }
+                message_parser_reset(&parser);
+            }
+        }
+        sent += chunk;
+    }
+}
+
+static void collect_message(const uart_message_view_t* msg) {
+    received_frame_t* out = &received[received_count++];
+    out->type = msg->msg_type;
+    out->length = msg->length;
+    memcpy(out->payload, msg->data, msg->length);
+}
+
+TEST_GROUP(SerialFrame);
+
+TEST_SETUP(SerialFrame) {
+    message_parser_init(&parser, parse_buffer, sizeof(parse_buffer));
+    received_count = 0;
+    bad_frames = 0;
+    stream_length = 0;
+    lcg_state = 777;
+}
+
+TEST_TEAR_DOWN(SerialFrame) {
+}
+
+// Known-good frames, both ends encode them with this codec
+TEST(SerialFrame, FramesMatchTheReferenceEncoding) {
+    static const uint8_t ack[] = { 0x00, 0x02, 0x05, 0x07, 0x02, 0x01, 0x71, 0x88, 0xAF, 0xC3, 0x00 };
+    static const uint8_t chat[] = {
+        0x00, 0x04, 0x08, 0x03, 0xFF, 0x02, 0x48, 0x06, 0x69, 0x1B, 0xF0, 0x24, 0x18, 0x00
+    };
+    static const uint8_t chat_payload[] = { 0x48, 0x00, 0x69 };
+    uint8_t wire[SERIAL_FRAME_MAX_WIRE_SIZE];
+
+    TEST_ASSERT_EQUAL_UINT16(sizeof(ack), serial_frame_encode(MSG_TYPE_ACK, 0x0102, NULL, 0, wire));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(ack, wire, sizeof(ack));
+
+    TEST_ASSERT_EQUAL_UINT16(sizeof(chat), serial_frame_encode(MSG_TYPE_CHAT, 0x00FF, chat_payload, 3, wire));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(chat, wire, sizeof(chat));
+
+    serial_frame_t frame;
+    TEST_ASSERT_EQUAL(SERIAL_FRAME_OK, serial_frame_decode(&wire[1], sizeof(chat) - 2, &frame));
+    TEST_ASSERT_EQUAL_UINT8(MSG_TYPE_CHAT, frame.type);
+    TEST_ASSERT_EQUAL_UINT16(0x00FF, frame.sequence);
+    TEST_ASSERT_EQUAL_UINT8(3, frame.length);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(chat_payload, frame.payload, 3);
+}
+
+TEST(SerialFrame, SmallMessagesCostTensOfBytes) {
+    uint8_t wire[SERIAL_FRAME_MAX_WIRE_SIZE];
+    uint8_t payload[SERIAL_FRAME_MAX_PAYLOAD];
+
+    // Was sizeof(uart_message_t) = 255 bytes each
+    TEST_ASSERT_EQUAL_UINT16(11, serial_frame_encode(MSG_TYPE_HEARTBEAT, 7, NULL, 0, wire));
+
+    fill_payload(payload, GAME_DATA_SIZE, 1);
+    TEST_ASSERT_EQUAL_UINT16(GAME_DATA_SIZE + 11, serial_frame_encode(MSG_TYPE_DATA, 7, payload, GAME_DATA_SIZE, wire));
+
+    // Worst case stuffing stays within the wire buffer
+    memset(payload, 0xFF, sizeof(payload));
+    TEST_ASSERT_TRUE(serial_frame_encode(MSG_TYPE_DATA, 0xFFFF, payload, SERIAL_FRAME_MAX_PAYLOAD, wire)
+        <= SERIAL_FRAME_MAX_WIRE_SIZE);
+    memset(payload, 0, sizeof(payload));
+    TEST_ASSERT_EQUAL_UINT16(SERIAL_FRAME_MAX_RAW_SIZE + 3,
+        serial_frame_encode(MSG_TYPE_DATA, 0, payload, SERIAL_FRAME_MAX_PAYLOAD, wire));
+}
+
+TEST(SerialFrame, PayloadsSurviveArbitraryChunking) {
+    static uint8_t payloads[MAX_FRAMES][SERIAL_FRAME_MAX_PAYLOAD];
+    // 246 fills exactly one 254 byte COBS block with the header and CRC
+    static const uint8_t lengths[] = { 0, 1, 3, 116, 246, 247, 250, 200 };
+    uint8_t count = 24;
+
+    for (uint8_t f = 0; f < count; f++) {
+        uint8_t length = lengths[f % sizeof(lengths)];
+        if (f % 3 == 0) {
+            memset(payloads[f], 0xFF, length);      // No zeros at all, full COBS blocks
+        }
+        else if (f % 3 == 1) {
+            memset(payloads[f], 0, length);
+        }
+        else {
+            fill_payload(payloads[f], length, f);
+        }
+        append_frame(MSG_TYPE_DATA, f, payloads[f], length);
+    }
+
+    feed(40);
+
+    TEST_ASSERT_EQUAL_UINT16(count, received_count);
+    TEST_ASSERT_EQUAL_UINT16(0, bad_frames);
+    for (uint8_t f = 0; f < count; f++) {
+        uint8_t length = lengths[f % sizeof(lengths)];
+        TEST_ASSERT_EQUAL_UINT16(f, received[f].sequence);
+        TEST_ASSERT_EQUAL_UINT8(length, received[f].length);
+        if (length > 0) {
+            TEST_ASSERT_EQUAL_MEMORY(payloads[f], received[f].payload, length);
+        }
+    }
+}
+
+TEST(SerialFrame, NoiseAndCutFramesCostOnlyThemselves) {
+    uint8_t payload[GAME_DATA_SIZE];
+    uint16_t start;
+
+    fill_payload(payload, sizeof(payload), 9);
+
+    append_noise(30, false);                    // Joined mid-stream
+    append_frame(MSG_TYPE_DATA, 0, payload, sizeof(payload));
+
+    start = stream_length;                      // Cut off halfway, the rest never sent
+    append_frame(MSG_TYPE_DATA, 1, payload, sizeof(payload));
+    stream_length = start + 60;
+
+    append_frame(MSG_TYPE_DATA, 2, payload, sizeof(payload));
+
+    start = stream_length;                      // One bit flipped on the wire
+    append_frame(MSG_TYPE_DATA, 3, payload, sizeof(payload));
+    stream[start + 40] ^= 0x10;
+
+    append_frame(MSG_TYPE_DATA, 4, payload, sizeof(payload));
+    append_noise(25, true);                     // Line noise with zeros in it
+    append_frame(MSG_TYPE_ACK, 5, NULL, 0);
+
+    feed(32);
+
+    TEST_ASSERT_EQUAL_UINT16(4, received_count);
+    TEST_ASSERT_EQUAL_UINT16(0, received[0].sequence);
+    TEST_ASSERT_EQUAL_UINT16(2, received[1].sequence);
+    TEST_ASSERT_EQUAL_UINT16(4, received[2].sequence);
+    TEST_ASSERT_EQUAL_UINT16(5, received[3].sequence);
+    TEST_ASSERT_EQUAL_MEMORY(payload, received[2].payload, sizeof(payload));
+    TEST_ASSERT_TRUE(bad_frames >= 3);
+}
+
+TEST(SerialFrame, CorruptedFramesAreNeverAccepted) {
+    static uint8_t payloads[MAX_FRAMES][40];
+    bool corrupted[MAX_FRAMES];
+    uint16_t clean = 0;
+
+    for (uint8_t f = 0; f < MAX_FRAMES; f++) {
+        uint8_t length = 1 + next_random() % sizeof(payloads[f]);
+        uint16_t start = stream_length;
+        uint16_t size;
+
+        fill_payload(payloads[f], sizeof(payloads[f]), (uint8_t)next_random());
+        size = append_frame(MSG_TYPE_DATA, f, payloads[f], length);
+
+        corrupted[f] = (next_random() % 3) == 0;
+        if (corrupted[f]) {
+            switch (next_random() % 3) {
+            case 0:     // Bit error inside the frame
+                stream[start + 1 + next_random() % (size - 2)] ^= (uint8_t)(1 << (next_random() % 8));
+                break;
+            case 1:     // Cut short
+                stream_length = start + 1 + next_random() % (size - 3);
+                break;
+            default:    // Bytes dropped from the middle
+                memmove(&stream[start + 3], &stream[start + 5], size - 5);
+                stream_length -= 2;
+                break;
+            }
+        }
+        else {
+            clean++;
+        }
+    }
+
+    feed(64);
+
+    // Every clean frame gets through, nothing else does
+    TEST_ASSERT_EQUAL_UINT16(clean, received_count);
+    for (uint16_t i = 0; i < received_count; i++) {
+        uint16_t f = received[i].sequence;
+        TEST_ASSERT_FALSE(corrupted[f]);
+        TEST_ASSERT_EQUAL_MEMORY(payloads[f], received[i].payload, received[i].length);
+    }
+}
+
+TEST(SerialFrame, RunLongerThanAnyFrameIsSkipped) {
+    append_noise(3 * SERIAL_FRAME_MAX_WIRE_SIZE, false);
+    append_frame(MSG_TYPE_HEARTBEAT, 1, NULL, 0);
+
+    feed(100);
+
+    TEST_ASSERT_EQUAL_UINT16(1, received_count);
+    TEST_ASSERT_EQUAL_UINT8(MSG_TYPE_HEARTBEAT, received[0].type);
+    TEST_ASSERT_EQUAL_UINT32(1, parser.oversized_frames);
+}
+
+TEST(SerialFrame, SerialCoreCountsFramesMissingFromTheSequence) {
+    uint8_t payload[GAME_DATA_SIZE];
+
+    mock_uart_reset();
+    mock_time_reset();
+    hardware_serial_init();
+    hardware_serial_register_callback(collect_message);
+
+    fill_payload(payload, sizeof(payload), 3);
+    append_frame(MSG_TYPE_DATA, 40, payload, sizeof(payload));
+    append_frame(MSG_TYPE_DATA, 41, payload, sizeof(payload));
+    append_frame(MSG_TYPE_DATA, 44, payload, sizeof(payload));     // 42 and 43 were lost
+    append_noise(10, true);
+    append_frame(MSG_TYPE_STATUS, 45, payload, 34);
+    mock_uart_receive(stream, stream_length);
+
+    TEST_ASSERT_TRUE(hardware_serial_is_message_ready());
+    hardware_serial_process_incoming();
+
+    const comm_stats_t* stats = hardware_serial_get_comm_stats();
+    TEST_ASSERT_EQUAL_UINT16(4, received_count);
+    TEST_ASSERT_EQUAL_UINT8(MSG_TYPE_STATUS, received[3].type);
+    TEST_ASSERT_EQUAL_UINT8(34, received[3].length);
+    TEST_ASSERT_EQUAL_MEMORY(payload, received[2].payload, sizeof(payload));
+    TEST_ASSERT_EQUAL_UINT32(2, stats->rx_frames_lost);
+    TEST_ASSERT_EQUAL_UINT32(4, stats->messages_parsed);
+    TEST_ASSERT_EQUAL_UINT32(stream_length, stats->bytes_received);
+    hardware_serial_register_callback(NULL);
+}
+
+TEST(SerialFrame, Throughput) {
+    uint8_t payload[GAME_DATA_SIZE];
+    uint8_t wire[SERIAL_FRAME_MAX_WIRE_SIZE];
+    const uint32_t rounds = 20000;
+    uint32_t decoded = 0;
+    uint32_t wire_bytes = 0;
+
+    // Game data frames per second on the 115200 baud link, 10 bits a byte
+    fill_payload(payload, sizeof(payload), 5);
+    uint16_t frame_size = serial_frame_encode(MSG_TYPE_DATA, 0, payload, sizeof(payload), wire);
+    uint32_t frames_per_second = 11520 / frame_size;
+    TEST_ASSERT_TRUE(frames_per_second >= 2 * (11520 / sizeof(uart_message_t)));
+
+    // Encode, parse and decode on the host
+    clock_t start = clock();
+    for (uint32_t i = 0; i < rounds; i++) {
+        payload[0] = (uint8_t)i;
+        uint16_t size = serial_frame_encode(MSG_TYPE_DATA, (uint16_t)i, payload, sizeof(payload), wire);
+        uint16_t used = message_parser_add_delimited(&parser, wire, size, SERIAL_FRAME_DELIMITER);
+        used += message_parser_add_delimited(&parser, &wire[used], size - used, SERIAL_FRAME_DELIMITER);
+        wire_bytes += size;
+
+        serial_frame_t frame;
+        if (message_parser_is_complete(&parser)
+            && serial_frame_decode(message_parser_get_buffer(&parser), message_parser_get_length(&parser), &frame) == SERIAL_FRAME_OK
+            && frame.payload[0] == (uint8_t)i) {
+            decoded++;
+        }
+        message_parser_reset(&parser);
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    TEST_ASSERT_EQUAL_UINT32(rounds, decoded);
+    printf("\nSerialFrame: %u byte game data frames, %lu/s on the link (was %lu/s), host %.1f MB/s\n",
+        frame_size, (unsigned long)frames_per_second, (unsigned long)(11520 / sizeof(uart_message_t)),
+        seconds > 0 ? wire_bytes / seconds / 1e6 : 0.0);
+}
+
+TEST_GROUP_RUNNER(SerialFrame) {
+    RUN_TEST_CASE(SerialFrame, FramesMatchTheReferenceEncoding);
+    RUN_TEST_CASE(SerialFrame, SmallMessagesCostTensOfBytes);
+    RUN_TEST_CASE(SerialFrame, PayloadsSurviveArbitraryChunking);
+    RUN_TEST_CASE(SerialFrame, NoiseAndCutFramesCostOnlyThemselves);
+    RUN_TEST_CASE(SerialFrame, CorruptedFramesAreNeverAccepted);
+    RUN_TEST_CASE(SerialFrame, RunLongerThanAnyFrameIsSkipped);
+    RUN_TEST_CASE(SerialFrame, SerialCoreCountsFramesMissingFromTheSequence);
+    RUN_TEST_CASE(SerialFrame, Throughput);
+}
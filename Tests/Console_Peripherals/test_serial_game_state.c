@@ -0,0 +1,362 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Utils/comm_utils.h"
+#include "Communication/serial_comm_game_state.h"
+#include "Console_Peripherals/Hardware/serial_comm_core.h"
+#include "Mocks/Inc/mock_uart_driver.h"
+#include "Mocks/Inc/mock_utils.h"
+#include "esp32/main/helpers/game-state/game_state_encoder.h"
+#include <string.h>
+#include <stdio.h>
+
+#define MSGPACK_SIZE 256
+
+// MessagePack as the server sends it, written and read back through a memory buffer
+static uint8_t msgpack[MSGPACK_SIZE];
+static uint16_t msgpack_length;
+static uint16_t msgpack_position;
+static cmp_ctx_t cmp;
+
+static uint8_t encoded[GAME_STATE_MAX_SIZE];
+static uint8_t received[SERIAL_FRAME_MAX_PAYLOAD];
+static uint8_t received_length;
+static uint16_t received_count;
+
+static bool msgpack_reader(cmp_ctx_t* ctx, void* data, size_t limit) {
+    (void)ctx;
+    if (msgpack_position + limit > msgpack_length) {
+        return false;
+    }
+    memcpy(data, &msgpack[msgpack_position], limit);
+    msgpack_position += limit;
+    return true;
+}
+
+static bool msgpack_skipper(cmp_ctx_t* ctx, size_t count) {
+    (void)ctx;
+    if (msgpack_position + count > msgpack_length) {
+        return false;
+    }
+    msgpack_position += count;
+    return true;
+}
+
+static size_t msgpack_writer(cmp_ctx_t* ctx, const void* data, size_t count) {
+    (void)ctx;
+    if (msgpack_length + count > sizeof(msgpack)) {
+        return 0;
+    }
+    memcpy(&msgpack[msgpack_length], data, count);
+    msgpack_length += count;
+    return count;
+}
+
+static void write_key(const char* key) {
+    cmp_write_str(&cmp, key, strlen(key));
+}
+
+static void write_position(uint8_t x, uint8_t y) {
+    cmp_write_array(&cmp, 2);
+    cmp_write_uinteger(&cmp, x);
+    cmp_write_uinteger(&cmp, y);
+}
+
+// Servers that do not acknowledge inputs leave "input" out
+static void write_player(const game_state_player_t* player) {
+    cmp_write_map(&cmp, (player->input_ack != 0) ? 6 : 5);
+    if (player->input_ack != 0) {
+        write_key("input");
+        cmp_write_uinteger(&cmp, player->input_ack);
+    }
+    write_key("score");
+    cmp_write_uinteger(&cmp, player->score);
+    write_key("alive");
+    cmp_write_bool(&cmp, player->alive);
+    write_key("head");
+    write_position(player->head_x, player->head_y);
+    write_key("direction");
+    cmp_write_uinteger(&cmp, player->direction);
+    write_key("length");
+    cmp_write_uinteger(&cmp, player->length);
+}
+
+static void write_state(const game_state_t* state) {
+    cmp_write_map(&cmp, 3);
+    write_key("players");
+    cmp_write_array(&cmp, state->player_count);
+    for (uint8_t i = 0; i < state->player_count; i++) {
+        write_player(&state->players[i]);
+    }
+    write_key("food");
+    write_position(state->food_x, state->food_y);
+    write_key("tick");
+    cmp_write_uinteger(&cmp, state->tick);
+}
+
+// What the ESP32 does with the "data" value of a game state message
+static bool read_state(game_state_t* state) {
+    cmp_object_t map;
+    uint32_t map_size;
+
+    msgpack_position = 0;
+    return cmp_read_object(&cmp, &map) && cmp_object_as_map(&map, &map_size) &&
+        game_state_read_msgpack(&cmp, map_size, state);
+}
+
+static void assert_states_equal(const game_state_t* sent, const uart_game_state_t* decoded) {
+    TEST_ASSERT_EQUAL_UINT32(sent->tick, decoded->tick);
+    TEST_ASSERT_EQUAL_UINT8(sent->food_x, decoded->food_x);
+    TEST_ASSERT_EQUAL_UINT8(sent->food_y, decoded->food_y);
+    TEST_ASSERT_EQUAL_UINT8(sent->player_count, decoded->player_count);
+    for (uint8_t i = 0; i < sent->player_count; i++) {
+        TEST_ASSERT_EQUAL_UINT8(sent->players[i].head_x, decoded->players[i].head_x);
+        TEST_ASSERT_EQUAL_UINT8(sent->players[i].head_y, decoded->players[i].head_y);
+        TEST_ASSERT_EQUAL_UINT8(sent->players[i].length, decoded->players[i].length);
+        TEST_ASSERT_EQUAL_UINT8(sent->players[i].direction, decoded->players[i].direction);
+        TEST_ASSERT_EQUAL(sent->players[i].alive, decoded->players[i].alive);
+        TEST_ASSERT_EQUAL_UINT16(sent->players[i].score, decoded->players[i].score);
+        TEST_ASSERT_EQUAL_UINT16(sent->players[i].input_ack, decoded->players[i].input_ack);
+    }
+}
+
+static void collect_message(const uart_message_view_t* msg) {
+    if (msg->msg_type == MSG_TYPE_GAME_STATE) {
+        memcpy(received, msg->data, msg->length);
+        received_length = msg->length;
+        received_count++;
+    }
+}
+
+static const game_state_t sample_state = {
+    .tick = 0x01020304UL,
+    .food_x = 7,
+    .food_y = 3,
+    .player_count = 2,
+    .players = {
+        { .head_x = 5, .head_y = 2, .length = 12, .direction = 1, .alive = true, .score = 0x0B0A, .input_ack = 0x0D0C },
+        { .head_x = 14, .head_y = 6, .length = 9, .direction = 3, .alive = false, .score = 4 }
+    }
+};
+
+TEST_GROUP(SerialGameState);
+
+TEST_SETUP(SerialGameState) {
+    memset(msgpack, 0, sizeof(msgpack));
+    msgpack_length = 0;
+    msgpack_position = 0;
+    cmp_init(&cmp, NULL, msgpack_reader, msgpack_skipper, msgpack_writer);
+    received_length = 0;
+    received_count = 0;
+}
+
+TEST_TEAR_DOWN(SerialGameState) {
+    hardware_serial_register_callback(NULL);
+}
+
+TEST(SerialGameState, LayoutIsLittleEndianWithFixedWidths) {
+    static const uint8_t expected[] = {
+        GAME_STATE_VERSION, 2, 0x04, 0x03, 0x02, 0x01, 7, 3,
+        5, 2, 12, 1, GAME_STATE_FLAG_ALIVE, 0x0A, 0x0B, 0x0C, 0x0D,
+        14, 6, 9, 3, 0, 4, 0, 0, 0
+    };
+
+    TEST_ASSERT_EQUAL(sizeof(expected), game_state_encode(&sample_state, encoded));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, encoded, sizeof(expected));
+}
+
+TEST(SerialGameState, ServerMapRoundTripsToTheStm32) {
+    game_state_t read;
+    uart_game_state_t decoded;
+
+    write_state(&sample_state);
+    TEST_ASSERT_TRUE(read_state(&read));
+    TEST_ASSERT_EQUAL_UINT16(msgpack_length, msgpack_position);
+
+    uint8_t length = (uint8_t)game_state_encode(&read, encoded);
+    TEST_ASSERT_TRUE(game_state_decode(encoded, length, &decoded));
+    assert_states_equal(&sample_state, &decoded);
+}
+
+TEST(SerialGameState, EveryFieldRoundTripsAtItsLimits) {
+    game_state_t state;
+    uart_game_state_t decoded;
+
+    for (uint8_t players = 0; players <= GAME_STATE_MAX_PLAYERS; players++) {
+        for (uint8_t pattern = 0; pattern < 4; pattern++) {
+            memset(&state, 0, sizeof(state));
+            state.tick = (pattern & 1) ? 0xFFFFFFFFUL : 0x80000001UL * pattern;
+            state.food_x = (pattern & 2) ? 255 : pattern;
+            state.food_y = (pattern & 1) ? 0 : 255;
+            state.player_count = players;
+            for (uint8_t i = 0; i < players; i++) {
+                state.players[i].head_x = (uint8_t)(255 - pattern - i);
+                state.players[i].head_y = (uint8_t)(pattern * 60 + i);
+                state.players[i].length = (pattern & 1) ? 255 : 1;
+                state.players[i].direction = (uint8_t)(pattern + i);
+                state.players[i].alive = ((pattern + i) & 1) != 0;
+                state.players[i].score = (pattern & 2) ? 0xFFFF : (uint16_t)(0x0100 * pattern + i);
+                state.players[i].input_ack = (pattern & 1) ? 0xFFFF : (uint16_t)(pattern * i);
+            }
+
+            msgpack_length = 0;
+            write_state(&state);
+            game_state_t read;
+            TEST_ASSERT_TRUE(read_state(&read));
+
+            uint8_t length = (uint8_t)game_state_encode(&read, encoded);
+            TEST_ASSERT_EQUAL_UINT8(GAME_STATE_SIZE(players), length);
+            TEST_ASSERT_TRUE(game_state_decode(encoded, length, &decoded));
+            assert_states_equal(&state, &decoded);
+        }
+    }
+}
+
+TEST(SerialGameState, DecoderRejectsAnythingButAWholeStateOfItsVersion) {
+    uart_game_state_t decoded;
+    uart_game_state_t untouched;
+    uint8_t length = (uint8_t)game_state_encode(&sample_state, encoded);
+
+    memset(&decoded, 0x5A, sizeof(decoded));
+    untouched = decoded;
+
+    // Truncated anywhere, or with bytes after the last record
+    for (uint8_t i = 0; i < length; i++) {
+        TEST_ASSERT_FALSE(game_state_decode(encoded, i, &decoded));
+    }
+    TEST_ASSERT_FALSE(game_state_decode(encoded, length + 1, &decoded));
+
+    encoded[0] = GAME_STATE_VERSION + 1;
+    TEST_ASSERT_FALSE(game_state_decode(encoded, length, &decoded));
+    encoded[0] = GAME_STATE_VERSION;
+
+    encoded[1] = GAME_STATE_MAX_PLAYERS + 1;
+    TEST_ASSERT_FALSE(game_state_decode(encoded, GAME_STATE_SIZE(GAME_STATE_MAX_PLAYERS + 1), &decoded));
+    encoded[1] = 1;
+    TEST_ASSERT_FALSE(game_state_decode(encoded, length, &decoded));
+
+    TEST_ASSERT_EQUAL_MEMORY(&untouched, &decoded, sizeof(decoded));
+}
+
+TEST(SerialGameState, EncoderRejectsStatesThatDoNotFit) {
+    game_state_t read;
+    game_state_player_t player = sample_state.players[0];
+
+    // Score wider than its two bytes
+    cmp_write_map(&cmp, 3);
+    write_key("tick");
+    cmp_write_uinteger(&cmp, 1);
+    write_key("food");
+    write_position(1, 1);
+    write_key("players");
+    cmp_write_array(&cmp, 1);
+    cmp_write_map(&cmp, 5);
+    write_key("head");
+    write_position(1, 1);
+    write_key("length");
+    cmp_write_uinteger(&cmp, 3);
+    write_key("direction");
+    cmp_write_uinteger(&cmp, 0);
+    write_key("alive");
+    cmp_write_bool(&cmp, true);
+    write_key("score");
+    cmp_write_uinteger(&cmp, 70000);
+    TEST_ASSERT_FALSE(read_state(&read));
+
+    // A coordinate off the byte grid
+    msgpack_length = 0;
+    cmp_write_map(&cmp, 1);
+    write_key("food");
+    cmp_write_array(&cmp, 2);
+    cmp_write_uinteger(&cmp, 300);
+    cmp_write_uinteger(&cmp, 1);
+    TEST_ASSERT_FALSE(read_state(&read));
+
+    // More players than the message holds
+    msgpack_length = 0;
+    cmp_write_map(&cmp, 1);
+    write_key("players");
+    cmp_write_array(&cmp, GAME_STATE_MAX_PLAYERS + 1);
+    for (uint8_t i = 0; i <= GAME_STATE_MAX_PLAYERS; i++) {
+        write_player(&player);
+    }
+    TEST_ASSERT_FALSE(read_state(&read));
+
+    // No tick
+    msgpack_length = 0;
+    cmp_write_map(&cmp, 2);
+    write_key("food");
+    write_position(1, 1);
+    write_key("players");
+    cmp_write_array(&cmp, 0);
+    TEST_ASSERT_FALSE(read_state(&read));
+}
+
+TEST(SerialGameState, EncoderSkipsKeysItDoesNotKnow) {
+    game_state_t read;
+    uart_game_state_t decoded;
+
+    cmp_write_map(&cmp, 5);
+    write_key("tick");
+    cmp_write_uinteger(&cmp, sample_state.tick);
+    write_key("session");
+    write_key("a1b2c3");
+    write_key("food");
+    write_position(sample_state.food_x, sample_state.food_y);
+    write_key("bounds");
+    cmp_write_map(&cmp, 2);
+    write_key("w");
+    cmp_write_array(&cmp, 1);
+    cmp_write_uinteger(&cmp, 16);
+    write_key("h");
+    cmp_write_integer(&cmp, -8);
+    write_key("players");
+    cmp_write_array(&cmp, 2);
+    write_player(&sample_state.players[0]);
+    write_player(&sample_state.players[1]);
+
+    TEST_ASSERT_TRUE(read_state(&read));
+    TEST_ASSERT_EQUAL_UINT16(msgpack_length, msgpack_position);
+    TEST_ASSERT_TRUE(game_state_decode(encoded, (uint8_t)game_state_encode(&read, encoded), &decoded));
+    assert_states_equal(&sample_state, &decoded);
+}
+
+TEST(SerialGameState, FramedStatePassesTheSerialCore) {
+    uint8_t stream[SERIAL_FRAME_MAX_WIRE_SIZE];
+    uart_game_state_t decoded;
+
+    mock_uart_reset();
+    mock_time_reset();
+    hardware_serial_init();
+    hardware_serial_register_callback(collect_message);
+
+    uint8_t length = (uint8_t)game_state_encode(&sample_state, encoded);
+    uint16_t wire = serial_frame_encode(MSG_TYPE_GAME_STATE, 1, encoded, length, stream);
+    mock_uart_receive(stream, wire);
+
+    TEST_ASSERT_TRUE(hardware_serial_is_message_ready());
+    hardware_serial_process_incoming();
+    TEST_ASSERT_EQUAL_UINT16(1, received_count);
+    TEST_ASSERT_TRUE(game_state_decode(received, received_length, &decoded));
+    assert_states_equal(&sample_state, &decoded);
+
+    // Against the same state as text in a game data message, as the server sent it before
+    uart_game_data_t text;
+    memset(&text, 0, sizeof(text));
+    strcpy(text.data_type, "game_state");
+    strcpy(text.game_data, "p1:len:12,alive:1;p2:len:9,alive:0;food:x:7,y:3;scores:2826,4");
+    uint16_t text_wire = serial_frame_encode(MSG_TYPE_DATA, 2, (const uint8_t*)&text, sizeof(text), stream);
+
+    printf("\nSerialGameState: payload %u bytes, was %u; on the wire %u bytes, was %u\n",
+        (unsigned)length, (unsigned)sizeof(text), (unsigned)wire, (unsigned)text_wire);
+    TEST_ASSERT_TRUE(wire * 3 < text_wire);
+}
+
+TEST_GROUP_RUNNER(SerialGameState) {
+    RUN_TEST_CASE(SerialGameState, LayoutIsLittleEndianWithFixedWidths);
+    RUN_TEST_CASE(SerialGameState, ServerMapRoundTripsToTheStm32);
+    RUN_TEST_CASE(SerialGameState, EveryFieldRoundTripsAtItsLimits);
+    RUN_TEST_CASE(SerialGameState, DecoderRejectsAnythingButAWholeStateOfItsVersion);
+    RUN_TEST_CASE(SerialGameState, EncoderRejectsStatesThatDoNotFit);
+    RUN_TEST_CASE(SerialGameState, EncoderSkipsKeysItDoesNotKnow);
+    RUN_TEST_CASE(SerialGameState, FramedStatePassesTheSerialCore);
+}
@@ -0,0 +1,243 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Utils/comm_utils.h"
+#include <string.h>
+
+#define RING_SIZE   64
+#define FRAME_SIZE  10
+#define FRAME_START 0xAA
+#define MAX_FRAMES  64
+
+static uint8_t dma_buffer[RING_SIZE];
+static dma_rx_ring_t ring;
+static uint16_t dma_position;       // Where the simulated DMA writes next
+
+static message_parser_t parser;
+static uint8_t parse_buffer[FRAME_SIZE];
+static uint8_t frames[MAX_FRAMES][FRAME_SIZE];
+static uint16_t frame_count;
+
+static uint32_t lcg_state;
+
+static uint32_t next_random(void) {
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return lcg_state >> 16;
+}
+
+static void make_frame(uint8_t* frame, uint8_t sequence) {
+    frame[0] = FRAME_START;
+    for (uint8_t i = 1; i < FRAME_SIZE; i++) {
+        // No start byte inside a frame, so noise between frames cannot fake one
+        frame[i] = (uint8_t)(sequence + i * 7) & 0x7F;
+    }
+}
+
+// Circular DMA: the half transfer and transfer complete events fire as the position
+// passes them, the IDLE event at the end of the burst
+static void dma_receive(const uint8_t* data, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        dma_buffer[dma_position++] = data[i];
+        if (dma_position == RING_SIZE / 2) {
+            dma_rx_ring_advance(&ring, RING_SIZE / 2);
+        }
+        else if (dma_position == RING_SIZE) {
+            dma_rx_ring_advance(&ring, RING_SIZE);
+            dma_position = 0;
+        }
+    }
+    dma_rx_ring_advance(&ring, dma_position);
+}
+
+// The serial core's parse loop
+static void drain(void) {
+    const uint8_t* span;
+    uint16_t length;
+    uint32_t breaks = ring.breaks;
+
+    while (true) {
+        length = dma_rx_ring_span(&ring, &span);
+        if (ring.breaks != breaks) {
+            breaks = ring.breaks;
+            message_parser_reset(&parser);
+        }
+        if (length == 0) {
+            break;
+        }
+
+        dma_rx_ring_consume(&ring, message_parser_add_span(&parser, span, length, FRAME_START));
+        if (message_parser_is_complete(&parser)) {
+            TEST_ASSERT_TRUE(frame_count < MAX_FRAMES);
+            memcpy(frames[frame_count++], message_parser_get_buffer(&parser), FRAME_SIZE);
+            message_parser_reset(&parser);
+        }
+    }
+}
+
+TEST_GROUP(SerialRx);
+
+TEST_SETUP(SerialRx) {
+    memset(dma_buffer, 0, sizeof(dma_buffer));
+    dma_rx_ring_init(&ring, dma_buffer, RING_SIZE);
+    message_parser_init(&parser, parse_buffer, FRAME_SIZE);
+    dma_position = 0;
+    frame_count = 0;
+    lcg_state = 12345;
+}
+
+TEST_TEAR_DOWN(SerialRx) {
+}
+
+TEST(SerialRx, SpanStopsAtTheEndOfTheBuffer) {
+    uint8_t data[RING_SIZE];
+    const uint8_t* span;
+
+    for (uint16_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)i;
+    }
+
+    dma_receive(data, 50);
+    TEST_ASSERT_EQUAL_UINT16(50, dma_rx_ring_span(&ring, &span));
+    TEST_ASSERT_EQUAL_PTR(dma_buffer, span);
+    dma_rx_ring_consume(&ring, 50);
+
+    // 14 bytes up to the end, 16 more from the top
+    dma_receive(data, 30);
+    TEST_ASSERT_EQUAL_UINT16(30, dma_rx_ring_available(&ring));
+    TEST_ASSERT_EQUAL_UINT16(14, dma_rx_ring_span(&ring, &span));
+    TEST_ASSERT_EQUAL_PTR(&dma_buffer[50], span);
+    dma_rx_ring_consume(&ring, 14);
+    TEST_ASSERT_EQUAL_UINT16(16, dma_rx_ring_span(&ring, &span));
+    TEST_ASSERT_EQUAL_PTR(dma_buffer, span);
+    TEST_ASSERT_EQUAL_MEMORY(&data[14], span, 16);
+    dma_rx_ring_consume(&ring, 16);
+
+    TEST_ASSERT_EQUAL_UINT16(0, dma_rx_ring_span(&ring, &span));
+    TEST_ASSERT_EQUAL_UINT32(0, ring.overflow_count);
+}
+
+TEST(SerialRx, ParserTakesNoMoreThanOneMessage) {
+    uint8_t stream[3 + 2 * FRAME_SIZE];
+    uint16_t used;
+
+    memset(stream, 0x11, 3);
+    make_frame(&stream[3], 1);
+    make_frame(&stream[3 + FRAME_SIZE], 2);
+
+    // Noise before the start byte is skipped, the second frame is left for the next call
+    used = message_parser_add_span(&parser, stream, sizeof(stream), FRAME_START);
+    TEST_ASSERT_EQUAL_UINT16(3 + FRAME_SIZE, used);
+    TEST_ASSERT_TRUE(message_parser_is_complete(&parser));
+    TEST_ASSERT_EQUAL_MEMORY(&stream[3], message_parser_get_buffer(&parser), FRAME_SIZE);
+
+    // A message split across spans
+    message_parser_reset(&parser);
+    used = message_parser_add_span(&parser, &stream[3 + FRAME_SIZE], 4, FRAME_START);
+    TEST_ASSERT_EQUAL_UINT16(4, used);
+    TEST_ASSERT_FALSE(message_parser_is_complete(&parser));
+    used = message_parser_add_span(&parser, &stream[3 + FRAME_SIZE + 4], FRAME_SIZE - 4, FRAME_START);
+    TEST_ASSERT_EQUAL_UINT16(FRAME_SIZE - 4, used);
+    TEST_ASSERT_TRUE(message_parser_is_complete(&parser));
+    TEST_ASSERT_EQUAL_MEMORY(&stream[3 + FRAME_SIZE], message_parser_get_buffer(&parser), FRAME_SIZE);
+}
+
+TEST(SerialRx, MessagesSurviveArbitraryDmaBoundaries) {
+    static uint8_t stream[MAX_FRAMES * (FRAME_SIZE + 3)];
+    static uint8_t expected[MAX_FRAMES][FRAME_SIZE];
+    uint16_t length = 0;
+
+    // Frames with up to 3 noise bytes between them
+    for (uint8_t f = 0; f < MAX_FRAMES; f++) {
+        uint8_t noise = next_random() % 4;
+        memset(&stream[length], 0x20 + f, noise);
+        length += noise;
+        make_frame(expected[f], f);
+        memcpy(&stream[length], expected[f], FRAME_SIZE);
+        length += FRAME_SIZE;
+    }
+
+    // Bursts of 1 to 31 bytes, drained after each one
+    for (uint16_t sent = 0; sent < length;) {
+        uint16_t burst = 1 + next_random() % 31;
+        if (burst > length - sent) {
+            burst = length - sent;
+        }
+        dma_receive(&stream[sent], burst);
+        sent += burst;
+        drain();
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(MAX_FRAMES, frame_count);
+    for (uint8_t f = 0; f < MAX_FRAMES; f++) {
+        TEST_ASSERT_EQUAL_MEMORY(expected[f], frames[f], FRAME_SIZE);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, ring.overflow_count);
+}
+
+TEST(SerialRx, LappedReaderDropsTheBufferAndResyncs) {
+    uint8_t frame[FRAME_SIZE];
+
+    // More than a whole buffer arrives before the reader runs
+    for (uint8_t f = 0; f < 8; f++) {
+        make_frame(frame, f);
+        dma_receive(frame, FRAME_SIZE);
+    }
+    drain();
+    TEST_ASSERT_EQUAL_UINT32(8 * FRAME_SIZE, ring.overflow_count);
+    TEST_ASSERT_EQUAL_UINT16(0, frame_count);
+
+    // The next frame is read whole
+    make_frame(frame, 9);
+    dma_receive(frame, FRAME_SIZE);
+    drain();
+    TEST_ASSERT_EQUAL_UINT16(1, frame_count);
+    TEST_ASSERT_EQUAL_MEMORY(frame, frames[0], FRAME_SIZE);
+}
+
+TEST(SerialRx, RestartAfterAnErrorDropsThePartialMessage) {
+    uint8_t frame[FRAME_SIZE];
+
+    make_frame(frame, 1);
+    dma_receive(frame, 6);
+    drain();
+
+    // A receive error stops the DMA, the rest of the frame is lost and reception starts over
+    dma_rx_ring_restart(&ring);
+    dma_position = 0;
+
+    make_frame(frame, 2);
+    dma_receive(frame, FRAME_SIZE);
+    drain();
+
+    TEST_ASSERT_EQUAL_UINT16(1, frame_count);
+    TEST_ASSERT_EQUAL_MEMORY(frame, frames[0], FRAME_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(1, ring.breaks);
+    TEST_ASSERT_EQUAL_UINT32(0, ring.overflow_count);
+}
+
+TEST(SerialRx, UnreadBytesAreDroppedOnRestart) {
+    uint8_t frame[FRAME_SIZE];
+
+    // A whole frame is in the buffer when the error comes, the reader has not run yet
+    make_frame(frame, 1);
+    dma_receive(frame, FRAME_SIZE);
+    dma_rx_ring_restart(&ring);
+    dma_position = 0;
+
+    // The restarted DMA writes over it
+    make_frame(frame, 2);
+    dma_receive(frame, FRAME_SIZE);
+    drain();
+
+    TEST_ASSERT_EQUAL_UINT16(1, frame_count);
+    TEST_ASSERT_EQUAL_MEMORY(frame, frames[0], FRAME_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(FRAME_SIZE, ring.overflow_count);
+}
+
+TEST_GROUP_RUNNER(SerialRx) {
+    RUN_TEST_CASE(SerialRx, SpanStopsAtTheEndOfTheBuffer);
+    RUN_TEST_CASE(SerialRx, ParserTakesNoMoreThanOneMessage);
+    RUN_TEST_CASE(SerialRx, MessagesSurviveArbitraryDmaBoundaries);
+    RUN_TEST_CASE(SerialRx, LappedReaderDropsTheBufferAndResyncs);
+    RUN_TEST_CASE(SerialRx, RestartAfterAnErrorDropsThePartialMessage);
+    RUN_TEST_CASE(SerialRx, UnreadBytesAreDroppedOnRestart);
+}
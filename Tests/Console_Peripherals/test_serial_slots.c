@@ -0,0 +1,201 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Utils/comm_utils.h"
+#include "Console_Peripherals/Hardware/serial_comm_core.h"
+#include "Mocks/Inc/mock_uart_driver.h"
+#include "Mocks/Inc/mock_utils.h"
+#include <string.h>
+#include <stdio.h>
+
+#define POOL_SLOTS      4
+#define POOL_SLOT_SIZE  16
+#define GAME_DATA_SIZE  116     // sizeof(uart_game_data_t)
+
+static message_pool_t pool;
+static uint8_t pool_storage[POOL_SLOTS * POOL_SLOT_SIZE];
+
+static uint8_t stream[CIRCULAR_BUFFER_SIZE];
+static uint16_t stream_length;
+
+static uint16_t handled;
+static uint8_t handled_types[16];
+static bool handled_in_place;
+
+static uint16_t append_frame(uint8_t type, uint16_t sequence, const uint8_t* payload, uint8_t length) {
+    uint16_t size = serial_frame_encode(type, sequence, payload, length, &stream[stream_length]);
+    stream_length += size;
+    return size;
+}
+
+static void fill_payload(uint8_t* payload, uint8_t length, uint8_t seed) {
+    for (uint16_t i = 0; i < length; i++) {
+        payload[i] = (i % 7 == 3) ? 0 : (uint8_t)(seed + i);
+    }
+}
+
+static void handle_message(const uart_message_view_t* msg) {
+    // The decoded header is still in front of the payload, nothing was copied out
+    handled_in_place &= msg->data[-4] == msg->msg_type && msg->data[-3] == msg->length;
+    handled_types[handled++ % sizeof(handled_types)] = msg->msg_type;
+}
+
+TEST_GROUP(SerialSlots);
+
+TEST_SETUP(SerialSlots) {
+    message_pool_init(&pool, pool_storage, POOL_SLOTS, POOL_SLOT_SIZE);
+    stream_length = 0;
+    handled = 0;
+    handled_in_place = true;
+    mock_uart_reset();
+    mock_time_reset();
+    hardware_serial_init();
+    hardware_serial_register_callback(handle_message);
+}
+
+TEST_TEAR_DOWN(SerialSlots) {
+    hardware_serial_register_callback(NULL);
+}
+
+TEST(SerialSlots, PoolLendsSlotsInTheOrderTheyWereCommitted) {
+    uint8_t* a = message_pool_acquire(&pool);
+    uint8_t* b = message_pool_acquire(&pool);
+    uint8_t* c = message_pool_acquire(&pool);
+
+    TEST_ASSERT_NOT_NULL(c);
+    TEST_ASSERT_TRUE(a != b && b != c && a != c);
+    TEST_ASSERT_EQUAL_UINT8(1, message_pool_free(&pool));
+
+    message_pool_commit(&pool, b);
+    message_pool_commit(&pool, a);
+    TEST_ASSERT_EQUAL_UINT8(2, message_pool_ready(&pool));
+    TEST_ASSERT_EQUAL_PTR(b, message_pool_borrow(&pool));
+    TEST_ASSERT_EQUAL_PTR(a, message_pool_borrow(&pool));
+    TEST_ASSERT_NULL(message_pool_borrow(&pool));
+
+    // Borrowed slots stay out of the pool until they are released
+    TEST_ASSERT_EQUAL_UINT8(1, message_pool_free(&pool));
+    message_pool_release(&pool, a);
+    message_pool_release(&pool, b);
+    message_pool_release(&pool, c);        // Acquired and never committed
+    TEST_ASSERT_EQUAL_UINT8(POOL_SLOTS, message_pool_free(&pool));
+    TEST_ASSERT_EQUAL_UINT8(3, pool.used_peak);
+}
+
+TEST(SerialSlots, PoolRunsOutAndRecovers) {
+    uint8_t* slots[POOL_SLOTS];
+
+    for (uint8_t i = 0; i < POOL_SLOTS; i++) {
+        slots[i] = message_pool_acquire(&pool);
+        TEST_ASSERT_NOT_NULL(slots[i]);
+    }
+    TEST_ASSERT_NULL(message_pool_acquire(&pool));
+    TEST_ASSERT_EQUAL_UINT32(1, pool.exhausted);
+
+    message_pool_release(&pool, slots[2]);
+    TEST_ASSERT_EQUAL_PTR(slots[2], message_pool_acquire(&pool));
+
+    // A slot released after a flush is free once, not twice
+    message_pool_commit(&pool, slots[0]);
+    const uint8_t* borrowed = message_pool_borrow(&pool);
+    message_pool_flush(&pool);
+    message_pool_release(&pool, borrowed);
+    TEST_ASSERT_EQUAL_UINT8(POOL_SLOTS, message_pool_free(&pool));
+    TEST_ASSERT_EQUAL_UINT8(0, message_pool_ready(&pool));
+}
+
+TEST(SerialSlots, ReceivedFramesAreCopiedOnce) {
+    uint8_t payload[GAME_DATA_SIZE];
+    uint32_t wire_bytes = 0;
+    uint32_t raw_bytes = 0;
+    uint32_t payload_bytes = 0;
+    const uint16_t frames = 6;
+
+    // Game data and heartbeats, the traffic of a multiplayer session
+    for (uint16_t i = 0; i < frames; i++) {
+        uint8_t length = (i % 2 == 0) ? GAME_DATA_SIZE : 0;
+        fill_payload(payload, length, (uint8_t)i);
+        wire_bytes += append_frame((i % 2 == 0) ? MSG_TYPE_DATA : MSG_TYPE_HEARTBEAT, i, payload, length);
+        raw_bytes += SERIAL_FRAME_HEADER_SIZE + length + SERIAL_FRAME_CRC_SIZE;
+        payload_bytes += length;
+    }
+    mock_uart_receive(stream, stream_length);
+
+    TEST_ASSERT_TRUE(hardware_serial_is_message_ready());
+    hardware_serial_process_incoming();
+    TEST_ASSERT_EQUAL_UINT16(frames, handled);
+    TEST_ASSERT_TRUE(handled_in_place);
+
+    // Out of the DMA buffer into the slot without the delimiters, then decoded where it lies
+    const comm_stats_t* stats = hardware_serial_get_comm_stats();
+    uint32_t expected = (wire_bytes - 2 * frames) + raw_bytes;
+    TEST_ASSERT_EQUAL_UINT32(expected, stats->rx_bytes_copied);
+
+    // Before: the same two steps, then the payload into a uart_message_t, into the queue
+    // and out of it again
+    uint32_t queued = expected + payload_bytes + 2 * frames * sizeof(uart_message_t);
+    printf("\nSerialSlots: bytes copied per received frame %lu, was %lu; receive RAM %u bytes, was %u\n",
+        (unsigned long)(stats->rx_bytes_copied / frames), (unsigned long)(queued / frames),
+        (unsigned)(RX_SLOT_COUNT * RX_SLOT_SIZE),
+        (unsigned)(MESSAGE_QUEUE_SIZE * sizeof(uart_message_t) + SERIAL_FRAME_MAX_ENCODED_SIZE));
+    TEST_ASSERT_TRUE(RX_SLOT_COUNT * RX_SLOT_SIZE
+        < MESSAGE_QUEUE_SIZE * sizeof(uart_message_t) + SERIAL_FRAME_MAX_ENCODED_SIZE);
+}
+
+TEST(SerialSlots, BorrowedMessagesHoldBackTheRestInTheDmaBuffer) {
+    uart_message_view_t borrowed[RX_SLOT_COUNT];
+    uart_message_view_t extra;
+
+    for (uint16_t i = 0; i < RX_SLOT_COUNT + 3; i++) {
+        append_frame(MSG_TYPE_HEARTBEAT, i, NULL, 0);
+    }
+    mock_uart_receive(stream, stream_length);
+
+    // Every slot is lent out and kept
+    TEST_ASSERT_TRUE(hardware_serial_is_message_ready());
+    for (uint8_t i = 0; i < RX_SLOT_COUNT; i++) {
+        TEST_ASSERT_TRUE(hardware_serial_borrow_message(&borrowed[i]));
+        TEST_ASSERT_EQUAL_UINT16(i, borrowed[i].sequence);
+    }
+    TEST_ASSERT_FALSE(hardware_serial_is_message_ready());
+    TEST_ASSERT_FALSE(hardware_serial_borrow_message(&extra));
+
+    // The last three frames waited in the DMA buffer, none were lost
+    for (uint8_t i = 0; i < RX_SLOT_COUNT; i++) {
+        hardware_serial_release_message(&borrowed[i]);
+    }
+    TEST_ASSERT_TRUE(hardware_serial_is_message_ready());
+    hardware_serial_process_incoming();
+
+    const comm_stats_t* stats = hardware_serial_get_comm_stats();
+    TEST_ASSERT_EQUAL_UINT16(3, handled);
+    TEST_ASSERT_EQUAL_UINT32(RX_SLOT_COUNT + 3, stats->messages_parsed);
+    TEST_ASSERT_EQUAL_UINT32(0, stats->rx_frames_lost);
+    TEST_ASSERT_EQUAL_UINT32(1, stats->queue_overflows);     // One stall, however often it was polled
+    TEST_ASSERT_EQUAL_UINT32(0, hardware_serial_get_drop_count());
+}
+
+TEST(SerialSlots, FramesLongerThanAnySlotAreSkipped) {
+    uint8_t payload[RX_SLOT_MAX_PAYLOAD + 20];
+
+    fill_payload(payload, sizeof(payload), 9);
+    append_frame(MSG_TYPE_DATA, 0, payload, sizeof(payload));
+    append_frame(MSG_TYPE_CHAT, 1, payload, RX_SLOT_MAX_PAYLOAD);
+    append_frame(MSG_TYPE_HEARTBEAT, 2, NULL, 0);
+    mock_uart_receive(stream, stream_length);
+
+    TEST_ASSERT_TRUE(hardware_serial_is_message_ready());
+    hardware_serial_process_incoming();
+
+    TEST_ASSERT_EQUAL_UINT16(2, handled);
+    TEST_ASSERT_EQUAL_UINT8(MSG_TYPE_CHAT, handled_types[0]);
+    TEST_ASSERT_EQUAL_UINT8(MSG_TYPE_HEARTBEAT, handled_types[1]);
+    TEST_ASSERT_TRUE(handled_in_place);
+}
+
+TEST_GROUP_RUNNER(SerialSlots) {
+    RUN_TEST_CASE(SerialSlots, PoolLendsSlotsInTheOrderTheyWereCommitted);
+    RUN_TEST_CASE(SerialSlots, PoolRunsOutAndRecovers);
+    RUN_TEST_CASE(SerialSlots, ReceivedFramesAreCopiedOnce);
+    RUN_TEST_CASE(SerialSlots, BorrowedMessagesHoldBackTheRestInTheDmaBuffer);
+    RUN_TEST_CASE(SerialSlots, FramesLongerThanAnySlotAreSkipped);
+}
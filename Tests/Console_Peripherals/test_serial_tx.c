@@ -0,0 +1,200 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Console_Peripherals/Hardware/serial_comm_core.h"
+#include "Mocks/Inc/mock_uart_driver.h"
+#include "Mocks/Inc/mock_utils.h"
+#include <string.h>
+
+static uint32_t tx_done_calls;
+
+static uart_message_t make_message(MessageType type, uint8_t id) {
+    uart_message_t msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.start_byte = MSG_START_BYTE;
+    msg.msg_type = type;
+    msg.length = 1;
+    msg.data[0] = id;
+    msg.end_byte = MSG_END_BYTE;
+    return msg;
+}
+
+static UART_Status queue(MessageType type, uint8_t id, tx_priority_t priority, tx_full_policy_t policy) {
+    uart_message_t msg = make_message(type, id);
+    return hardware_serial_queue_message(&msg, priority, policy);
+}
+
+// Frame the DMA is sending, without its delimiters
+static serial_frame_t sending_frame(void) {
+    static uint8_t wire[SERIAL_FRAME_MAX_WIRE_SIZE];
+    serial_frame_t frame;
+
+    memcpy(wire, mock_uart_tx_data(), mock_uart_tx_size());
+    TEST_ASSERT_EQUAL(SERIAL_FRAME_OK, serial_frame_decode(&wire[1], mock_uart_tx_size() - 2, &frame));
+    return frame;
+}
+
+// Id of the frame the DMA is sending
+static uint8_t sending_id(void) {
+    return sending_frame().payload[0];
+}
+
+// End the frame in flight and start the next, as the comm_tx task does
+static void next_frame(void) {
+    mock_uart_complete_tx(true);
+    hardware_serial_service_tx();
+}
+
+static void count_tx_done(void) {
+    tx_done_calls++;
+}
+
+TEST_GROUP(SerialTx);
+
+TEST_SETUP(SerialTx) {
+    mock_uart_reset();
+    mock_time_reset();
+    hardware_serial_init();
+    tx_done_calls = 0;
+    hardware_serial_register_tx_done_callback(count_tx_done);
+}
+
+TEST_TEAR_DOWN(SerialTx) {
+    hardware_serial_register_tx_done_callback(NULL);
+}
+
+TEST(SerialTx, SendStartsTheDmaAndReturns) {
+    uart_message_t msg = make_message(MSG_TYPE_STATUS, 1);
+
+    TEST_ASSERT_EQUAL(UART_OK, hardware_serial_send_message(&msg));
+
+    TEST_ASSERT_TRUE(mock_uart_tx_active());
+    serial_frame_t frame = sending_frame();
+    TEST_ASSERT_EQUAL_UINT8(MSG_TYPE_STATUS, frame.type);
+    TEST_ASSERT_EQUAL_UINT8(1, frame.length);
+    TEST_ASSERT_EQUAL_UINT8(1, frame.payload[0]);
+    TEST_ASSERT_EQUAL_UINT16(0, hardware_serial_get_comm_stats()->tx_queue_depth);
+
+    // Delimiters, stuffing code, 4 header bytes, the payload byte and the CRC
+    uint16_t wire_size = mock_uart_tx_size();
+    TEST_ASSERT_EQUAL_UINT16(2 + 1 + 4 + 1 + SERIAL_FRAME_CRC_SIZE, wire_size);
+
+    // Counted once it is out
+    TEST_ASSERT_EQUAL_UINT32(0, hardware_serial_get_comm_stats()->tx_frames_sent);
+    mock_uart_complete_tx(true);
+    TEST_ASSERT_EQUAL_UINT32(1, hardware_serial_get_comm_stats()->tx_frames_sent);
+    TEST_ASSERT_EQUAL_UINT32(wire_size, hardware_serial_get_comm_stats()->bytes_sent);
+    TEST_ASSERT_EQUAL_UINT32(1, tx_done_calls);
+}
+
+TEST(SerialTx, FramesWaitForTheOneInFlight) {
+    for (uint8_t id = 1; id <= 3; id++) {
+        TEST_ASSERT_EQUAL(UART_OK, queue(MSG_TYPE_STATUS, id, TX_PRIORITY_NORMAL, TX_FULL_DROP_NEWEST));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(1, mock_uart_tx_count());
+    TEST_ASSERT_EQUAL_UINT8(1, sending_id());
+    TEST_ASSERT_EQUAL_UINT16(2, hardware_serial_get_comm_stats()->tx_queue_depth);
+
+    // Nothing starts until the frame in flight is done
+    hardware_serial_service_tx();
+    TEST_ASSERT_EQUAL_UINT32(1, mock_uart_tx_count());
+
+    next_frame();
+    TEST_ASSERT_EQUAL_UINT8(2, sending_id());
+    next_frame();
+    TEST_ASSERT_EQUAL_UINT8(3, sending_id());
+    TEST_ASSERT_EQUAL_UINT16(2, sending_frame().sequence);
+    next_frame();
+    TEST_ASSERT_FALSE(mock_uart_tx_active());
+
+    const comm_stats_t* stats = hardware_serial_get_comm_stats();
+    TEST_ASSERT_EQUAL_UINT32(3, stats->tx_frames_sent);
+    TEST_ASSERT_EQUAL_UINT16(0, stats->tx_queue_depth);
+    TEST_ASSERT_EQUAL_UINT16(2, stats->tx_queue_peak);
+}
+
+TEST(SerialTx, InputGoesBeforeWaitingStatusTraffic) {
+    queue(MSG_TYPE_STATUS, 1, TX_PRIORITY_NORMAL, TX_FULL_DROP_NEWEST);
+    queue(MSG_TYPE_STATUS, 2, TX_PRIORITY_NORMAL, TX_FULL_DROP_NEWEST);
+    queue(MSG_TYPE_HEARTBEAT, 3, TX_PRIORITY_NORMAL, TX_FULL_DROP_NEWEST);
+    queue(MSG_TYPE_DATA, 10, TX_PRIORITY_HIGH, TX_FULL_DROP_OLDEST);
+    queue(MSG_TYPE_DATA, 11, TX_PRIORITY_HIGH, TX_FULL_DROP_OLDEST);
+
+    // The frame already on the wire finishes first
+    TEST_ASSERT_EQUAL_UINT8(1, sending_id());
+    next_frame();
+    TEST_ASSERT_EQUAL_UINT8(10, sending_id());
+    next_frame();
+    TEST_ASSERT_EQUAL_UINT8(11, sending_id());
+    next_frame();
+    TEST_ASSERT_EQUAL_UINT8(2, sending_id());
+    next_frame();
+    TEST_ASSERT_EQUAL_UINT8(3, sending_id());
+}
+
+TEST(SerialTx, FullQueueDropsTheNewestStatus) {
+    // One in flight and a full queue behind it
+    for (uint8_t id = 1; id <= TX_QUEUE_NORMAL_SIZE + 1; id++) {
+        TEST_ASSERT_EQUAL(UART_OK, queue(MSG_TYPE_STATUS, id, TX_PRIORITY_NORMAL, TX_FULL_DROP_NEWEST));
+    }
+
+    TEST_ASSERT_EQUAL(UART_BUSY, queue(MSG_TYPE_STATUS, 99, TX_PRIORITY_NORMAL, TX_FULL_DROP_NEWEST));
+    TEST_ASSERT_EQUAL_UINT32(1, hardware_serial_get_comm_stats()->tx_dropped);
+
+    for (uint8_t id = 2; id <= TX_QUEUE_NORMAL_SIZE + 1; id++) {
+        next_frame();
+        TEST_ASSERT_EQUAL_UINT8(id, sending_id());
+    }
+    next_frame();
+    TEST_ASSERT_FALSE(mock_uart_tx_active());
+}
+
+TEST(SerialTx, FullQueueReplacesTheOldestInput) {
+    queue(MSG_TYPE_STATUS, 1, TX_PRIORITY_NORMAL, TX_FULL_DROP_NEWEST);
+    for (uint8_t id = 10; id < 10 + TX_QUEUE_HIGH_SIZE + 2; id++) {
+        TEST_ASSERT_EQUAL(UART_OK, queue(MSG_TYPE_DATA, id, TX_PRIORITY_HIGH, TX_FULL_DROP_OLDEST));
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, hardware_serial_get_comm_stats()->tx_overwritten);
+    TEST_ASSERT_EQUAL_UINT16(TX_QUEUE_HIGH_SIZE, hardware_serial_get_comm_stats()->tx_queue_depth);
+
+    // The two oldest inputs gave way
+    for (uint8_t id = 12; id < 10 + TX_QUEUE_HIGH_SIZE + 2; id++) {
+        next_frame();
+        TEST_ASSERT_EQUAL_UINT8(id, sending_id());
+    }
+}
+
+TEST(SerialTx, FrameThatCannotStartIsKeptForTheNextTry) {
+    mock_uart_fail_next_send(UART_BUSY);
+    TEST_ASSERT_EQUAL(UART_OK, queue(MSG_TYPE_ACK, 5, TX_PRIORITY_NORMAL, TX_FULL_DROP_NEWEST));
+    TEST_ASSERT_FALSE(mock_uart_tx_active());
+    TEST_ASSERT_EQUAL_UINT32(1, hardware_serial_get_comm_stats()->tx_errors);
+
+    hardware_serial_service_tx();
+    TEST_ASSERT_TRUE(mock_uart_tx_active());
+    TEST_ASSERT_EQUAL_UINT8(5, sending_id());
+}
+
+TEST(SerialTx, FailedTransmissionIsCountedAndTheQueueMovesOn) {
+    queue(MSG_TYPE_STATUS, 1, TX_PRIORITY_NORMAL, TX_FULL_DROP_NEWEST);
+    queue(MSG_TYPE_STATUS, 2, TX_PRIORITY_NORMAL, TX_FULL_DROP_NEWEST);
+
+    mock_uart_complete_tx(false);
+    TEST_ASSERT_EQUAL_UINT32(1, hardware_serial_get_comm_stats()->tx_errors);
+    TEST_ASSERT_EQUAL_UINT32(0, hardware_serial_get_comm_stats()->tx_frames_sent);
+    TEST_ASSERT_EQUAL_UINT32(1, tx_done_calls);
+
+    hardware_serial_service_tx();
+    TEST_ASSERT_EQUAL_UINT8(2, sending_id());
+}
+
+TEST_GROUP_RUNNER(SerialTx) {
+    RUN_TEST_CASE(SerialTx, SendStartsTheDmaAndReturns);
+    RUN_TEST_CASE(SerialTx, FramesWaitForTheOneInFlight);
+    RUN_TEST_CASE(SerialTx, InputGoesBeforeWaitingStatusTraffic);
+    RUN_TEST_CASE(SerialTx, FullQueueDropsTheNewestStatus);
+    RUN_TEST_CASE(SerialTx, FullQueueReplacesTheOldestInput);
+    RUN_TEST_CASE(SerialTx, FrameThatCannotStartIsKeptForTheNextTry);
+    RUN_TEST_CASE(SerialTx, FailedTransmissionIsCountedAndTheQueueMovesOn);
+}
@@ -0,0 +1,120 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Console_Peripherals/UI/ui_screen.h"
+#include <string.h>
+
+static char events[32];
+static uint8_t event_count;
+static bool ready;
+static uint32_t drops;
+
+static void log_event(char event) {
+    if (event_count < sizeof(events) - 1) {
+        events[event_count++] = event;
+    }
+}
+
+static uint32_t count_drops(void) { return drops; }
+
+static void a_enter(void) { log_event('A'); }
+static void a_exit(void) { log_event('a'); }
+static void a_done(void) { log_event('!'); }
+static void b_enter(void) { log_event('B'); }
+static bool wait_until_ready(uint32_t elapsed_ms) { (void)elapsed_ms; return ready; }
+
+static const UiScreen timed = {
+    .name = "timed", .enter = a_enter, .exit = a_exit, .done = a_done, .duration_ms = 3000
+};
+static const UiScreen polled = {
+    .name = "polled", .enter = b_enter, .update = wait_until_ready, .duration_ms = UI_SCREEN_FOREVER
+};
+
+static void show_polled(void) {
+    log_event('>');
+    ui_screen_show(&polled, 0);
+}
+
+static const UiScreen chained = {
+    .name = "chained", .enter = a_enter, .done = show_polled, .duration_ms = 100
+};
+
+TEST_GROUP(UiScreen);
+
+TEST_SETUP(UiScreen) {
+    memset(events, 0, sizeof(events));
+    event_count = 0;
+    ready = false;
+    drops = 0;
+    ui_screen_init(count_drops);
+}
+
+TEST_TEAR_DOWN(UiScreen) {
+}
+
+TEST(UiScreen, TimedScreenRunsHooksAndTimesOut) {
+    ui_screen_show(&timed, 1000);
+    TEST_ASSERT_EQUAL_STRING("A", events);
+
+    TEST_ASSERT_TRUE(ui_screen_update(3999));
+    TEST_ASSERT_EQUAL_PTR(&timed, ui_screen_current());
+
+    TEST_ASSERT_FALSE(ui_screen_update(4000));
+    TEST_ASSERT_EQUAL_STRING("Aa!", events);
+    TEST_ASSERT_NULL(ui_screen_current());
+}
+
+TEST(UiScreen, PolledScreenWaitsForItsUpdate) {
+    ui_screen_show(&polled, 0);
+
+    TEST_ASSERT_TRUE(ui_screen_update(60000));
+    ready = true;
+    TEST_ASSERT_FALSE(ui_screen_update(60010));
+}
+
+TEST(UiScreen, ReplacingSkipsDone) {
+    ui_screen_show(&timed, 0);
+    ui_screen_show(&polled, 500);
+
+    TEST_ASSERT_EQUAL_STRING("AaB", events);
+    TEST_ASSERT_EQUAL_PTR(&polled, ui_screen_current());
+}
+
+TEST(UiScreen, LeaveRunsExitOnly) {
+    ui_screen_show(&timed, 0);
+    ui_screen_leave(10);
+
+    TEST_ASSERT_EQUAL_STRING("Aa", events);
+    TEST_ASSERT_FALSE(ui_screen_update(10000));
+}
+
+TEST(UiScreen, DoneMayShowTheNextScreen) {
+    ui_screen_show(&chained, 0);
+
+    TEST_ASSERT_TRUE(ui_screen_update(100));
+    TEST_ASSERT_EQUAL_STRING("A>B", events);
+    TEST_ASSERT_EQUAL_PTR(&polled, ui_screen_current());
+}
+
+TEST(UiScreen, CountsDropsAndTimeOnScreen) {
+    ui_screen_show(&timed, 0);
+    drops = 3;
+    ui_screen_update(3000);
+
+    ui_screen_show(&polled, 3000);
+    drops = 5;
+    ui_screen_leave(3200);
+
+    const UiScreenStats* stats = ui_screen_get_stats();
+    TEST_ASSERT_EQUAL_UINT32(2, stats->shown);
+    TEST_ASSERT_EQUAL_UINT32(3000, stats->longest_ms);
+    TEST_ASSERT_EQUAL_UINT32(5, stats->dropped);
+}
+
+TEST_GROUP_RUNNER(UiScreen) {
+    RUN_TEST_CASE(UiScreen, TimedScreenRunsHooksAndTimesOut);
+    RUN_TEST_CASE(UiScreen, PolledScreenWaitsForItsUpdate);
+    RUN_TEST_CASE(UiScreen, ReplacingSkipsDone);
+    RUN_TEST_CASE(UiScreen, LeaveRunsExitOnly);
+    RUN_TEST_CASE(UiScreen, DoneMayShowTheNextScreen);
+    RUN_TEST_CASE(UiScreen, CountsDropsAndTimeOnScreen);
+}
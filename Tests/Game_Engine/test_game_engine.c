@@ -2,6 +2,7 @@
 #include "unity_fixture.h"
 #include "Game_Engine/game_engine.h"
 #include "Console_Peripherals/types.h"
+#include "Console_Peripherals/Hardware/push_button.h"
 #include "Mocks/Inc/mock_display_driver.h"
 #include "Mocks/Inc/mock_push_button_driver.h"
 #include "Mocks/Inc/mock_utils.h"
@@ -44,6 +45,14 @@ static void test_game_cleanup(void) {
     cleanup_called = true;
 }
 
+// Sets button 2 and runs the SysTick scan until the level is debounced
+static void set_pb2(uint8_t state) {
+    mock_pb2_state = state;
+    for (uint8_t i = 0; i < BUTTON_DEBOUNCE_SCANS; i++) {
+        pb_scan();
+    }
+}
+
 // Test engine instance
 static GameEngine test_engine;
 static TestGameData test_game_data;
@@ -101,8 +110,8 @@ TEST(GameEngine, InitializationSetsDefaultState) {
     game_engine_init(&test_engine);
 
     TEST_ASSERT_TRUE(init_called);
-    TEST_ASSERT_EQUAL_UINT32(0, test_engine.base_state.score);
-    TEST_ASSERT_EQUAL_UINT8(3, test_engine.base_state.lives);
+    TEST_ASSERT_EQUAL_UINT32(0, test_engine.base_state.state_data.single.score);
+    TEST_ASSERT_EQUAL_UINT8(DEFAULT_LIVES, test_engine.base_state.state_data.single.lives);
     TEST_ASSERT_FALSE(test_engine.base_state.paused);
     TEST_ASSERT_FALSE(test_engine.base_state.game_over);
     TEST_ASSERT_FALSE(test_engine.base_state.is_reset);
@@ -285,15 +294,15 @@ TEST(GameEngine, ButtonTwoShortPressTriggersReset) {
     TEST_ASSERT_FALSE(test_engine.base_state.is_reset);
 
     // Simulate Button 2 press
-    mock_pb2_state = 1;
-    mock_tick_count = 100;  // Start time
+    set_pb2(1);
+    mock_time_set_ms(100);  // Start time
 
     JoystickStatus js = { JS_DIR_CENTERED, 0, 0 };
     game_engine_update(&test_engine, &js);
 
     // Simulate button release after a short duration (< BUTTON_RESTART_MAX_DURATION)
-    mock_pb2_state = 0;
-    mock_tick_count = 500;  // Less than 1.2 seconds
+    set_pb2(0);
+    mock_time_set_ms(500);  // Less than 1.2 seconds
     game_engine_update(&test_engine, &js);
 
     // Verify reset flag is set
@@ -307,15 +316,15 @@ TEST(GameEngine, ButtonTwoLongPressTriggersReturnToMainMenu) {
     TEST_ASSERT_FALSE(test_engine.return_to_main_menu);
 
     // Simulate Button 2 long press
-    mock_pb2_state = 1;
-    mock_tick_count = 100;  // Start time
+    set_pb2(1);
+    mock_time_set_ms(100);  // Start time
 
     JoystickStatus js = { JS_DIR_CENTERED, 0, 0 };
     game_engine_update(&test_engine, &js);
 
     // Simulate button release after a long duration (≥ BUTTON_MENU_MIN_DURATION)
-    mock_pb2_state = 0;
-    mock_tick_count = 3100;  // More than 3 seconds
+    set_pb2(0);
+    mock_time_set_ms(3100);  // More than 3 seconds
     game_engine_update(&test_engine, &js);
 
     // Verify return to main menu flag is set
@@ -329,15 +338,15 @@ TEST(GameEngine, ButtonTwoNoEffectWhenGameOver) {
     test_engine.base_state.game_over = true;
 
     // Simulate Button 2 short press
-    mock_pb2_state = 1;
-    mock_tick_count = 100;
+    set_pb2(1);
+    mock_time_set_ms(100);
 
     JoystickStatus js = { JS_DIR_CENTERED, 0, 0 };
     game_engine_update(&test_engine, &js);
 
     // Simulate button release
-    mock_pb2_state = 0;
-    mock_tick_count = 500;
+    set_pb2(0);
+    mock_time_set_ms(500);
     game_engine_update(&test_engine, &js);
 
     // Reset flag should not be set during game over
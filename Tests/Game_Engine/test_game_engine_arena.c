@@ -0,0 +1,66 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Game_Engine/game_engine_arena.h"
+
+TEST_GROUP(GameArena);
+
+TEST_SETUP(GameArena) {
+    game_arena_reset();
+}
+
+TEST_TEAR_DOWN(GameArena) {
+    game_arena_reset();
+}
+
+TEST(GameArena, AllocationsAreAlignedAndZeroed) {
+    uint8_t* first = (uint8_t*)game_arena_alloc(3);
+    uint8_t* second = (uint8_t*)game_arena_alloc(16);
+
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_NOT_NULL(second);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)first % GAME_ARENA_ALIGN);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)second % GAME_ARENA_ALIGN);
+    TEST_ASSERT_EQUAL_PTR(first + GAME_ARENA_ALIGN, second);
+
+    for (uint8_t i = 0; i < 16; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, second[i]);
+    }
+}
+
+TEST(GameArena, ResetReleasesEverything) {
+    uint8_t* block = (uint8_t*)game_arena_alloc(64);
+    block[0] = 0xAA;
+
+    game_arena_reset();
+    TEST_ASSERT_EQUAL(0, game_arena_used());
+
+    // The next session gets the same memory back, cleared
+    uint8_t* again = (uint8_t*)game_arena_alloc(64);
+    TEST_ASSERT_EQUAL_PTR(block, again);
+    TEST_ASSERT_EQUAL_UINT8(0, again[0]);
+}
+
+TEST(GameArena, ExhaustedPoolReturnsNull) {
+    TEST_ASSERT_NOT_NULL(game_arena_alloc(GAME_ARENA_SIZE - GAME_ARENA_ALIGN));
+    TEST_ASSERT_NULL(game_arena_alloc(2 * GAME_ARENA_ALIGN));
+    TEST_ASSERT_NOT_NULL(game_arena_alloc(GAME_ARENA_ALIGN));
+    TEST_ASSERT_EQUAL(GAME_ARENA_SIZE, game_arena_used());
+}
+
+TEST(GameArena, PeakIsPerSession) {
+    game_arena_alloc(128);
+    TEST_ASSERT_EQUAL(128, game_arena_peak());
+
+    // A new session does not inherit the last one's peak
+    game_arena_reset();
+    game_arena_alloc(32);
+    TEST_ASSERT_EQUAL(32, game_arena_peak());
+    TEST_ASSERT_EQUAL(32, game_arena_used());
+}
+
+TEST_GROUP_RUNNER(GameArena) {
+    RUN_TEST_CASE(GameArena, AllocationsAreAlignedAndZeroed);
+    RUN_TEST_CASE(GameArena, ResetReleasesEverything);
+    RUN_TEST_CASE(GameArena, ExhaustedPoolReturnsNull);
+    RUN_TEST_CASE(GameArena, PeakIsPerSession);
+}
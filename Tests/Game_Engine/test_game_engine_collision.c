@@ -0,0 +1,150 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Game_Engine/game_engine_collision.h"
+#include "Game_Engine/game_engine_arena.h"
+
+#define LAYER_PLAYER  0x01
+#define LAYER_ENEMY   0x02
+#define LAYER_PICKUP  0x04
+
+static entity_id_t hits_a[16];
+static entity_id_t hits_b[16];
+static uint8_t hit_count;
+static bool destroy_on_hit;
+
+static void record_collision(entity_id_t a, entity_id_t b) {
+    if (hit_count < 16) {
+        hits_a[hit_count] = a;
+        hits_b[hit_count] = b;
+    }
+    hit_count++;
+
+    if (destroy_on_hit) {
+        entity_destroy(game_entities, b);
+    }
+}
+
+TEST_GROUP(Collision);
+
+TEST_SETUP(Collision) {
+    game_arena_reset();
+    entity_store_create();
+    collision_world_create(TILE_SIZE, record_collision);
+    hit_count = 0;
+    destroy_on_hit = false;
+}
+
+TEST_TEAR_DOWN(Collision) {
+    game_arena_reset();
+}
+
+TEST(Collision, BoxesOverlapOnlyWhenInteriorsIntersect) {
+    TEST_ASSERT_TRUE(collision_boxes_overlap(0, 0, 8, 8, 7, 7, 8, 8));
+    TEST_ASSERT_FALSE(collision_boxes_overlap(0, 0, 8, 8, 8, 0, 8, 8));  // Touching edges
+    TEST_ASSERT_FALSE(collision_boxes_overlap(0, 0, 8, 8, 0, 8, 8, 8));
+}
+
+TEST(Collision, OverlappingPairIsReported) {
+    entity_id_t player = entity_create(game_entities, 100, 100, 0, 0);
+    entity_id_t enemy = entity_create(game_entities, 100 + SPRITE_SIZE / 2, 100, 0, 0);
+    collision_set_aabb(game_collisions, player, SPRITE_SIZE, SPRITE_SIZE, LAYER_PLAYER, LAYER_ENEMY);
+    collision_set_aabb(game_collisions, enemy, SPRITE_SIZE, SPRITE_SIZE, LAYER_ENEMY, 0);
+
+    collision_update(game_collisions, game_entities);
+
+    TEST_ASSERT_EQUAL(1, hit_count);
+    TEST_ASSERT_EQUAL(player, hits_a[0]);
+    TEST_ASSERT_EQUAL(enemy, hits_b[0]);
+}
+
+TEST(Collision, MaskFiltersLayers) {
+    entity_id_t player = entity_create(game_entities, 100, 100, 0, 0);
+    entity_id_t pickup = entity_create(game_entities, 100, 100, 0, 0);
+    collision_set_aabb(game_collisions, player, SPRITE_SIZE, SPRITE_SIZE, LAYER_PLAYER, LAYER_ENEMY);
+    collision_set_aabb(game_collisions, pickup, SPRITE_SIZE, SPRITE_SIZE, LAYER_PICKUP, 0);
+
+    collision_update(game_collisions, game_entities);
+
+    TEST_ASSERT_EQUAL(0, hit_count);
+}
+
+TEST(Collision, MutualPairIsReportedOnce) {
+    entity_id_t first = entity_create(game_entities, 40, 40, 0, 0);
+    entity_id_t second = entity_create(game_entities, 44, 44, 0, 0);
+    collision_set_aabb(game_collisions, first, SPRITE_SIZE, SPRITE_SIZE, LAYER_PLAYER, LAYER_PLAYER);
+    collision_set_aabb(game_collisions, second, SPRITE_SIZE, SPRITE_SIZE, LAYER_PLAYER, LAYER_PLAYER);
+
+    collision_update(game_collisions, game_entities);
+
+    TEST_ASSERT_EQUAL(1, hit_count);
+}
+
+TEST(Collision, PairAcrossCellBoundaryIsFound) {
+    // Boxes straddle the edge between two grid cells
+    entity_id_t player = entity_create(game_entities, COLLISION_CELL_SIZE - 2, 0, 0, 0);
+    entity_id_t enemy = entity_create(game_entities, COLLISION_CELL_SIZE + 1, 0, 0, 0);
+    collision_set_aabb(game_collisions, player, SPRITE_SIZE, SPRITE_SIZE, LAYER_PLAYER, LAYER_ENEMY);
+    collision_set_aabb(game_collisions, enemy, SPRITE_SIZE, SPRITE_SIZE, LAYER_ENEMY, 0);
+
+    collision_update(game_collisions, game_entities);
+
+    TEST_ASSERT_EQUAL(1, hit_count);
+}
+
+TEST(Collision, TileCollidersMatchOnSameCell) {
+    entity_id_t player = entity_create(game_entities, TILE_SIZE * 3, TILE_SIZE * 2, 0, 0);
+    entity_id_t same = entity_create(game_entities, TILE_SIZE * 3 + TILE_SIZE / 2 - 1, TILE_SIZE * 2, 0, 0);
+    entity_id_t next = entity_create(game_entities, TILE_SIZE * 4, TILE_SIZE * 2, 0, 0);
+    collision_set_tile(game_collisions, player, LAYER_PLAYER, LAYER_PICKUP);
+    collision_set_tile(game_collisions, same, LAYER_PICKUP, 0);
+    collision_set_tile(game_collisions, next, LAYER_PICKUP, 0);
+
+    collision_update(game_collisions, game_entities);
+
+    TEST_ASSERT_EQUAL(1, hit_count);
+    TEST_ASSERT_EQUAL(same, hits_b[0]);
+}
+
+TEST(Collision, FarEntitiesAreNotCandidates) {
+    entity_id_t player = entity_create(game_entities, 0, 0, 0, 0);
+    collision_set_aabb(game_collisions, player, SPRITE_SIZE, SPRITE_SIZE, LAYER_PLAYER, LAYER_PICKUP);
+
+    // A row of pickups well away from the player
+    for (uint8_t i = 0; i < 10; i++) {
+        entity_id_t pickup = entity_create(game_entities, COLLISION_CELL_SIZE * 3 + i * SPRITE_SIZE,
+            COLLISION_CELL_SIZE * 3, 0, 0);
+        collision_set_aabb(game_collisions, pickup, SPRITE_SIZE, SPRITE_SIZE, LAYER_PICKUP, 0);
+    }
+
+    collision_update(game_collisions, game_entities);
+
+    TEST_ASSERT_EQUAL(0, hit_count);
+    TEST_ASSERT_EQUAL(0, game_collisions->candidate_pairs);
+}
+
+TEST(Collision, DestroyedEntitiesAreSkipped) {
+    entity_id_t first = entity_create(game_entities, 40, 40, 0, 0);
+    entity_id_t second = entity_create(game_entities, 40, 40, 0, 0);
+    entity_id_t pickup = entity_create(game_entities, 40, 40, 0, 0);
+    collision_set_aabb(game_collisions, first, SPRITE_SIZE, SPRITE_SIZE, LAYER_PLAYER, LAYER_PICKUP);
+    collision_set_aabb(game_collisions, second, SPRITE_SIZE, SPRITE_SIZE, LAYER_PLAYER, LAYER_PICKUP);
+    collision_set_aabb(game_collisions, pickup, SPRITE_SIZE, SPRITE_SIZE, LAYER_PICKUP, 0);
+    destroy_on_hit = true;
+
+    collision_update(game_collisions, game_entities);
+
+    // The first player takes the pickup, the second never sees it
+    TEST_ASSERT_EQUAL(1, hit_count);
+    TEST_ASSERT_EQUAL(first, hits_a[0]);
+}
+
+TEST_GROUP_RUNNER(Collision) {
+    RUN_TEST_CASE(Collision, BoxesOverlapOnlyWhenInteriorsIntersect);
+    RUN_TEST_CASE(Collision, OverlappingPairIsReported);
+    RUN_TEST_CASE(Collision, MaskFiltersLayers);
+    RUN_TEST_CASE(Collision, MutualPairIsReportedOnce);
+    RUN_TEST_CASE(Collision, PairAcrossCellBoundaryIsFound);
+    RUN_TEST_CASE(Collision, TileCollidersMatchOnSameCell);
+    RUN_TEST_CASE(Collision, FarEntitiesAreNotCandidates);
+    RUN_TEST_CASE(Collision, DestroyedEntitiesAreSkipped);
+}
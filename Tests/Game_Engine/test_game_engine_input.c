@@ -0,0 +1,111 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Game_Engine/game_engine_input.h"
+#include <string.h>
+
+static InputQueue queue;
+static TurnBuffer turns;
+static GameEngine engine;
+static uint8_t heading;
+
+// Snake rules - any turn but straight back
+static bool not_reversing(uint8_t current, uint8_t next) {
+    return !((current == DPAD_DIR_UP && next == DPAD_DIR_DOWN) ||
+             (current == DPAD_DIR_DOWN && next == DPAD_DIR_UP) ||
+             (current == DPAD_DIR_LEFT && next == DPAD_DIR_RIGHT) ||
+             (current == DPAD_DIR_RIGHT && next == DPAD_DIR_LEFT));
+}
+
+static void queue_turns(const InputEvent* event) {
+    if (event->source == INPUT_SOURCE_DPAD) {
+        turn_buffer_push(&turns, event->state);
+    }
+}
+
+// One game tick: drain the queue, take a turn, optionally move
+static void tick(bool move) {
+    game_engine_drain_input(&engine, &queue);
+
+    uint8_t turn = turn_buffer_take(&turns, heading, not_reversing);
+    if (turn != 0) {
+        heading = turn;
+    }
+    if (move) {
+        turn_buffer_step(&turns);
+    }
+}
+
+TEST_GROUP(GameEngineInput);
+
+TEST_SETUP(GameEngineInput) {
+    input_queue_reset(&queue);
+    memset(&engine, 0, sizeof(engine));
+    engine.on_input_event = queue_turns;
+    heading = DPAD_DIR_RIGHT;
+    turn_buffer_reset(&turns, heading);
+}
+
+TEST_TEAR_DOWN(GameEngineInput) {
+}
+
+TEST(GameEngineInput, DrainHandsEveryEventToTheGame) {
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_UP, 100);
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, 0, 200);
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_LEFT, 300);
+
+    TEST_ASSERT_EQUAL(3, game_engine_drain_input(&engine, &queue));
+    TEST_ASSERT_EQUAL(0, input_queue_count(&queue));
+    TEST_ASSERT_EQUAL(2, turns.count);   // The release is not a turn
+}
+
+TEST(GameEngineInput, QuickTurnsWithinOneStepAreBothKept) {
+    // Up then left between two movement steps
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_UP, 10000);
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, 0, 40000);
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_LEFT, 60000);
+
+    tick(false);
+    TEST_ASSERT_EQUAL(DPAD_DIR_UP, heading);
+
+    // Still the same step - left waits instead of reversing the snake
+    tick(true);
+    TEST_ASSERT_EQUAL(DPAD_DIR_UP, heading);
+
+    tick(true);
+    TEST_ASSERT_EQUAL(DPAD_DIR_LEFT, heading);
+}
+
+TEST(GameEngineInput, ReversingTurnsAreDiscarded) {
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_LEFT, 0);
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_DOWN, 0);
+
+    tick(true);
+
+    TEST_ASSERT_EQUAL(DPAD_DIR_DOWN, heading);
+    TEST_ASSERT_EQUAL(0, turns.count);
+}
+
+TEST(GameEngineInput, RepeatedPressesAreOneTurn) {
+    turn_buffer_push(&turns, DPAD_DIR_UP);
+    turn_buffer_push(&turns, DPAD_DIR_UP);
+    turn_buffer_push(&turns, DPAD_DIR_RIGHT);
+
+    TEST_ASSERT_EQUAL(2, turns.count);
+}
+
+TEST(GameEngineInput, TurnBufferHasAFixedSize) {
+    uint8_t pattern[] = { DPAD_DIR_UP, DPAD_DIR_LEFT, DPAD_DIR_DOWN, DPAD_DIR_RIGHT, DPAD_DIR_UP };
+
+    for (uint8_t i = 0; i < GAME_TURN_BUFFER_SIZE; i++) {
+        TEST_ASSERT_TRUE(turn_buffer_push(&turns, pattern[i]));
+    }
+    TEST_ASSERT_FALSE(turn_buffer_push(&turns, pattern[GAME_TURN_BUFFER_SIZE]));
+}
+
+TEST_GROUP_RUNNER(GameEngineInput) {
+    RUN_TEST_CASE(GameEngineInput, DrainHandsEveryEventToTheGame);
+    RUN_TEST_CASE(GameEngineInput, QuickTurnsWithinOneStepAreBothKept);
+    RUN_TEST_CASE(GameEngineInput, ReversingTurnsAreDiscarded);
+    RUN_TEST_CASE(GameEngineInput, RepeatedPressesAreOneTurn);
+    RUN_TEST_CASE(GameEngineInput, TurnBufferHasAFixedSize);
+}
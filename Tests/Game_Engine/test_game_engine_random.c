@@ -0,0 +1,80 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Game_Engine/game_engine_random.h"
+
+static GameRandom rng;
+
+TEST_GROUP(GameRandom);
+
+TEST_SETUP(GameRandom) {
+    game_random_seed(&rng, 1234);
+}
+
+TEST_TEAR_DOWN(GameRandom) {
+}
+
+TEST(GameRandom, MatchesTheReferenceGenerator) {
+    // xoshiro128** from state {1, 2, 3, 4}
+    rng.s[0] = 1;
+    rng.s[1] = 2;
+    rng.s[2] = 3;
+    rng.s[3] = 4;
+
+    TEST_ASSERT_EQUAL_UINT32(11520, game_random_next(&rng));
+    TEST_ASSERT_EQUAL_UINT32(0, game_random_next(&rng));
+    TEST_ASSERT_EQUAL_UINT32(5927040, game_random_next(&rng));
+}
+
+TEST(GameRandom, SameSeedGivesTheSameStream) {
+    GameRandom other;
+    game_random_seed(&other, 1234);
+
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL_UINT32(game_random_next(&other), game_random_next(&rng));
+    }
+}
+
+TEST(GameRandom, SeedsGiveDifferentStreams) {
+    GameRandom other;
+    game_random_seed(&other, 1235);
+
+    int same = 0;
+    for (int i = 0; i < 100; i++) {
+        if (game_random_next(&other) == game_random_next(&rng)) {
+            same++;
+        }
+    }
+    TEST_ASSERT_EQUAL(0, same);
+}
+
+TEST(GameRandom, ZeroSeedIsUsable) {
+    game_random_seed(&rng, 0);
+
+    TEST_ASSERT_FALSE(rng.s[0] == 0 && rng.s[1] == 0 && rng.s[2] == 0 && rng.s[3] == 0);
+    TEST_ASSERT_NOT_EQUAL(game_random_next(&rng), game_random_next(&rng));
+}
+
+TEST(GameRandom, BelowStaysInRangeAndCoversIt) {
+    uint16_t counts[10] = {0};
+
+    for (int i = 0; i < 10000; i++) {
+        uint32_t value = game_random_below(&rng, 10);
+        TEST_ASSERT_LESS_THAN_UINT32(10, value);
+        counts[value]++;
+    }
+    // Roughly 1000 each
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_UINT16_WITHIN(150, 1000, counts[i]);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, game_random_below(&rng, 1));
+    TEST_ASSERT_EQUAL_UINT32(0, game_random_below(&rng, 0));
+}
+
+TEST_GROUP_RUNNER(GameRandom) {
+    RUN_TEST_CASE(GameRandom, MatchesTheReferenceGenerator);
+    RUN_TEST_CASE(GameRandom, SameSeedGivesTheSameStream);
+    RUN_TEST_CASE(GameRandom, SeedsGiveDifferentStreams);
+    RUN_TEST_CASE(GameRandom, ZeroSeedIsUsable);
+    RUN_TEST_CASE(GameRandom, BelowStaysInRangeAndCoversIt);
+}
@@ -0,0 +1,257 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Game_Engine/game_engine.h"
+#include "Game_Engine/game_engine_replay.h"
+#include "Game_Engine/Games/Single_Player/snake_game.h"
+#include "Mocks/Inc/mock_push_button_driver.h"
+#include "Mocks/Inc/mock_utils.h"
+#include <string.h>
+#include <stddef.h>
+
+// A small game whose state depends on time, input and the random stream
+typedef struct {
+    uint32_t position;
+    uint32_t rolls;
+    uint16_t steps;
+    uint8_t heading;
+} ReplayGameData;
+
+static GameEngine replay_engine;
+static uint8_t recording[REPLAY_BUFFER_SIZE];
+static uint32_t recording_length;
+static bool play_differently;     // Makes the replayed game go its own way
+static uint32_t now_ms;
+
+static ReplayGameData* game_data(void) {
+    return (ReplayGameData*)replay_engine.game_data;
+}
+
+static void roll(void* context) {
+    (void)context;
+    game_data()->rolls += game_random_below(&game_random, 100);
+    game_data()->steps++;
+}
+
+static void replay_game_init(void) {
+    game_data()->position = game_random_below(&game_random, 1000);
+    timer_start(&game_timers, 50, 50, roll, NULL);
+}
+
+static void replay_game_input(const InputEvent* event) {
+    game_data()->position += event->state;
+}
+
+static void replay_game_update(DPAD_STATUS status) {
+    if (status.direction != 0) {
+        game_data()->heading = status.direction;
+    }
+    if (play_differently && game_data()->steps == 5) {
+        game_data()->position++;
+    }
+}
+
+static void replay_game_cleanup(void) {
+}
+
+// One console frame - the clock moves on, then the engine updates
+static void run_frame(uint32_t dt, uint8_t direction) {
+    DPAD_STATUS status = {.direction = direction, .is_new = 0};
+
+    now_ms += dt;
+    mock_time_set_ms(now_ms);
+    game_engine_update(&replay_engine, &status);
+}
+
+static void keep_recording(void) {
+    const uint8_t* data = replay_get_recording(&recording_length);
+    memcpy(recording, data, recording_length);
+}
+
+TEST_GROUP(Replay);
+
+TEST_SETUP(Replay) {
+    memset(&replay_engine, 0, sizeof(replay_engine));
+    replay_engine.init = replay_game_init;
+    replay_engine.update_func.update_dpad = replay_game_update;
+    replay_engine.on_input_event = replay_game_input;
+    replay_engine.cleanup = replay_game_cleanup;
+    replay_engine.game_data_size = sizeof(ReplayGameData);
+    replay_engine.is_d_pad_game = true;
+
+    mock_pb1_state = 0;
+    mock_pb2_state = 0;
+    play_differently = false;
+    recording_length = 0;
+    now_ms = 1000;
+    mock_time_set_ms(now_ms);
+    replay_record_stop();
+}
+
+TEST_TEAR_DOWN(Replay) {
+    replay_record_stop();
+}
+
+static void record_session(void) {
+    game_engine_init_seeded(&replay_engine, 0xC0FFEE);
+
+    for (uint8_t frame = 0; frame < 100; frame++) {
+        if (frame % 7 == 0) {
+            input_queue_push(&input_events, INPUT_SOURCE_DPAD, frame % 4 + 1, 0);
+        }
+        // Frames are not evenly spaced on the console
+        run_frame(16 + frame % 3, (frame / 10) % 5);
+    }
+    replay_record_stop();
+    keep_recording();
+}
+
+TEST(Replay, RecordedSessionPlaysBackTheSame) {
+    record_session();
+    uint32_t recorded_hash = replay_state_hash(&replay_engine);
+    ReplayGameData recorded = *game_data();
+
+    ReplayResult result;
+    TEST_ASSERT_TRUE(replay_play(&replay_engine, recording, recording_length, &result));
+
+    TEST_ASSERT_TRUE(result.complete);
+    TEST_ASSERT_EQUAL_UINT32(100, result.frames);
+    TEST_ASSERT_EQUAL_UINT32(100 / REPLAY_HASH_INTERVAL, result.hashes_checked);
+    TEST_ASSERT_EQUAL_UINT32(0, result.mismatch_frame);
+    TEST_ASSERT_EQUAL_UINT32(recorded_hash, replay_state_hash(&replay_engine));
+    TEST_ASSERT_EQUAL_UINT32(recorded.position, game_data()->position);
+    TEST_ASSERT_EQUAL_UINT32(recorded.rolls, game_data()->rolls);
+}
+
+TEST(Replay, RecordingIsCompact) {
+    record_session();
+
+    // A byte per update, a few per input and status change, five per hash
+    TEST_ASSERT_LESS_THAN_UINT32(sizeof(ReplayHeader) + 100 + 15 * 3 + 10 * 4 + 7 * 5 + 1, recording_length);
+}
+
+TEST(Replay, DivergingGameIsCaught) {
+    record_session();
+    play_differently = true;
+
+    ReplayResult result;
+    TEST_ASSERT_FALSE(replay_play(&replay_engine, recording, recording_length, &result));
+
+    // The fifth roll is 250 ms in, about 15 updates, and the hash after it is the first to differ
+    TEST_ASSERT_TRUE(result.complete);
+    TEST_ASSERT_EQUAL_UINT32(REPLAY_HASH_INTERVAL, result.mismatch_frame);
+}
+
+TEST(Replay, PausedTimeIsNotReplayed) {
+    game_engine_init_seeded(&replay_engine, 7);
+
+    for (uint8_t frame = 0; frame < 20; frame++) {
+        run_frame(16, 0);
+    }
+    replay_engine.base_state.paused = true;
+    for (uint8_t frame = 0; frame < 50; frame++) {
+        run_frame(16, 0);
+    }
+    replay_engine.base_state.paused = false;
+    for (uint8_t frame = 0; frame < 12; frame++) {
+        run_frame(16, 0);
+    }
+    uint16_t recorded_steps = game_data()->steps;
+    replay_record_stop();
+    keep_recording();
+
+    ReplayResult result;
+    TEST_ASSERT_TRUE(replay_play(&replay_engine, recording, recording_length, &result));
+    TEST_ASSERT_EQUAL_UINT32(32, result.frames);
+    TEST_ASSERT_EQUAL_UINT16(recorded_steps, game_data()->steps);
+}
+
+TEST(Replay, FullBufferKeepsWholeUpdates) {
+    game_engine_init_seeded(&replay_engine, 99);
+
+    // Every update carries an input, the buffer runs out long before this ends
+    for (uint16_t frame = 0; frame < REPLAY_BUFFER_SIZE; frame++) {
+        input_queue_push(&input_events, INPUT_SOURCE_DPAD, 1, 0);
+        run_frame(200, frame % 2);
+    }
+    TEST_ASSERT_EQUAL(REPLAY_FULL, replay_get_state());
+    replay_record_stop();
+    keep_recording();
+
+    ReplayHeader header;
+    memcpy(&header, recording, sizeof(header));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(REPLAY_BUFFER_SIZE, recording_length);
+
+    ReplayResult result;
+    TEST_ASSERT_TRUE(replay_play(&replay_engine, recording, recording_length, &result));
+    TEST_ASSERT_EQUAL_UINT32(header.frames, result.frames);
+}
+
+// Steers a snake at its food - x first, then y
+static uint8_t chase_food(const SnakeGameData* snake) {
+    if (snake->food.x != snake->snake.head_x) {
+        return (snake->food.x > snake->snake.head_x) ? DPAD_DIR_RIGHT : DPAD_DIR_LEFT;
+    }
+    return (snake->food.y > snake->snake.head_y) ? DPAD_DIR_DOWN : DPAD_DIR_UP;
+}
+
+TEST(Replay, SnakeSessionPlaysBackToTheSameEnd) {
+    uint8_t direction = DPAD_DIR_RIGHT;
+
+    game_engine_init_seeded(&snake_game_engine, 0x5EED);
+    SnakeGameData* snake = (SnakeGameData*)snake_game_engine.game_data;
+
+    // Turns come through the event queue as the D-pad posts them, the food is placed from the seed
+    for (uint16_t frame = 0; frame < 3000 && !snake_game_engine.base_state.game_over; frame++) {
+        uint8_t wanted = chase_food(snake);
+        if (wanted != direction) {
+            direction = wanted;
+            input_queue_push(&input_events, INPUT_SOURCE_DPAD, direction, 0);
+        }
+
+        DPAD_STATUS status = {.direction = direction, .is_new = 0};
+        now_ms += 16 + frame % 3;
+        mock_time_set_ms(now_ms);
+        game_engine_update(&snake_game_engine, &status);
+    }
+    TEST_ASSERT_GREATER_THAN_UINT32(0, snake_game_engine.base_state.state_data.single.score);
+    replay_record_stop();
+    keep_recording();
+    uint32_t recorded_hash = replay_state_hash(&snake_game_engine);
+    game_engine_cleanup(&snake_game_engine);
+
+    ReplayResult result;
+    TEST_ASSERT_TRUE(replay_play(&snake_game_engine, recording, recording_length, &result));
+    TEST_ASSERT_TRUE(result.complete);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, result.hashes_checked);
+    TEST_ASSERT_EQUAL_UINT32(recorded_hash, replay_state_hash(&snake_game_engine));
+    game_engine_cleanup(&snake_game_engine);
+
+    // Another seed puts the food elsewhere and the replay runs into it
+    recording[offsetof(ReplayHeader, seed)] ^= 1;
+    TEST_ASSERT_FALSE(replay_play(&snake_game_engine, recording, recording_length, &result));
+    TEST_ASSERT_NOT_EQUAL(0, result.mismatch_frame);
+    game_engine_cleanup(&snake_game_engine);
+}
+
+TEST(Replay, RecordingOfAnotherGameIsRefused) {
+    record_session();
+    replay_engine.game_data_size = sizeof(ReplayGameData) + 4;
+
+    ReplayResult result;
+    TEST_ASSERT_FALSE(replay_play(&replay_engine, recording, recording_length, &result));
+    TEST_ASSERT_EQUAL_UINT32(0, result.frames);
+
+    recording[0] ^= 0xFF;
+    replay_engine.game_data_size = sizeof(ReplayGameData);
+    TEST_ASSERT_FALSE(replay_play(&replay_engine, recording, recording_length, &result));
+}
+
+TEST_GROUP_RUNNER(Replay) {
+    RUN_TEST_CASE(Replay, RecordedSessionPlaysBackTheSame);
+    RUN_TEST_CASE(Replay, RecordingIsCompact);
+    RUN_TEST_CASE(Replay, DivergingGameIsCaught);
+    RUN_TEST_CASE(Replay, PausedTimeIsNotReplayed);
+    RUN_TEST_CASE(Replay, FullBufferKeepsWholeUpdates);
+    RUN_TEST_CASE(Replay, SnakeSessionPlaysBackToTheSameEnd);
+    RUN_TEST_CASE(Replay, RecordingOfAnotherGameIsRefused);
+}
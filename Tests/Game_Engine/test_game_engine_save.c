@@ -0,0 +1,230 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Game_Engine/game_engine.h"
+#include "Game_Engine/game_engine_save.h"
+#include "System/save_store.h"
+#include "Mocks/Inc/mock_flash_driver.h"
+#include "Mocks/Inc/mock_push_button_driver.h"
+#include "Mocks/Inc/mock_utils.h"
+#include <string.h>
+
+#define SAVE_KEY 3
+
+// A small game with state in the arena, on the timers, in the random stream and in a static
+typedef struct {
+    uint32_t position;
+    uint32_t rolls;
+    uint16_t steps;
+} SaveGameData;
+
+static GameEngine save_engine;
+static timer_id_t roll_timer;
+static uint32_t restored_calls;
+static uint32_t now_ms;
+
+static const GameSaveRegion save_regions[] = {
+    { &roll_timer, sizeof(roll_timer) }
+};
+
+static GameSaveDescriptor save_descriptor = {
+    .version = 1,
+    .regions = save_regions,
+    .region_count = 1
+};
+
+static SaveGameData* game_data(void) {
+    return (SaveGameData*)save_engine.game_data;
+}
+
+static void roll(void* context) {
+    (void)context;
+    game_data()->rolls += game_random_below(&game_random, 100);
+    game_data()->steps++;
+}
+
+static void save_game_init(void) {
+    game_data()->position = game_random_below(&game_random, 1000);
+    // Extra arena use, laid out again by init on restore
+    game_arena_alloc(40);
+    roll_timer = timer_start(&game_timers, 50, 50, roll, NULL);
+}
+
+static void save_game_update(DPAD_STATUS status) {
+    game_data()->position += status.direction;
+}
+
+static void save_game_cleanup(void) {
+}
+
+static void save_game_restored(void) {
+    restored_calls++;
+}
+
+static void run_frames(uint16_t count) {
+    DPAD_STATUS status = {.direction = 1, .is_new = 0};
+
+    for (uint16_t i = 0; i < count; i++) {
+        now_ms += 16;
+        mock_time_set_ms(now_ms);
+        game_engine_update(&save_engine, &status);
+    }
+}
+
+static void write_out(void) {
+    while (game_save_service(true)) {
+    }
+}
+
+TEST_GROUP(GameSave);
+
+TEST_SETUP(GameSave) {
+    memset(&save_engine, 0, sizeof(save_engine));
+    save_engine.init = save_game_init;
+    save_engine.update_func.update_dpad = save_game_update;
+    save_engine.cleanup = save_game_cleanup;
+    save_engine.game_data_size = sizeof(SaveGameData);
+    save_engine.is_d_pad_game = true;
+    save_descriptor.version = 1;
+    save_descriptor.on_restore = save_game_restored;
+    restored_calls = 0;
+
+    mock_pb1_state = 0;
+    mock_pb2_state = 0;
+    now_ms = 1000;
+    mock_time_set_ms(now_ms);
+    mock_flash_reset();
+    game_save_init();
+    game_engine_init_seeded(&save_engine, 1234);
+}
+
+TEST_TEAR_DOWN(GameSave) {
+}
+
+TEST(GameSave, SnapshotIsWrittenBetweenFrames) {
+    run_frames(20);
+
+    uint32_t size = game_save_capture(SAVE_KEY, &save_engine, &save_descriptor);
+    TEST_ASSERT_TRUE(size > sizeof(GameSaveHeader) + sizeof(TimerWheel) + sizeof(GameRandom)
+        + game_arena_used() + sizeof(roll_timer));
+
+    // One service call programs GAME_SAVE_STEP_WORDS words, the record adds 6 to the payload
+    uint16_t calls = 0;
+    while (game_save_service(true)) {
+        calls++;
+        // The game keeps running while it is written
+        run_frames(1);
+    }
+    calls++;
+
+    const GameSaveStats* stats = game_save_get_stats();
+    uint32_t words = (size + 3) / 4 + 6;
+    TEST_ASSERT_EQUAL_UINT16((words + GAME_SAVE_STEP_WORDS - 1) / GAME_SAVE_STEP_WORDS, calls);
+    TEST_ASSERT_EQUAL_UINT16(calls, stats->write_steps);
+    TEST_ASSERT_EQUAL_UINT32(size, stats->snapshot_bytes);
+    TEST_ASSERT_EQUAL_UINT32(1, stats->saves);
+
+    uint16_t key = 0;
+    TEST_ASSERT_TRUE(game_save_latest(&key));
+    TEST_ASSERT_EQUAL_UINT16(SAVE_KEY, key);
+}
+
+TEST(GameSave, ResumedSessionContinuesLikeTheOriginal) {
+    run_frames(30);
+    game_save_capture(SAVE_KEY, &save_engine, &save_descriptor);
+    write_out();
+
+    // Where the original goes from here
+    run_frames(40);
+    SaveGameData expected = *game_data();
+    uint32_t expected_draw = game_random_next(&game_random);
+    TEST_ASSERT_TRUE(expected.steps > 0);
+
+    // Power cycle: a fresh session on another seed, then the resume
+    game_engine_cleanup(&save_engine);
+    now_ms += 60000;
+    mock_time_set_ms(now_ms);
+    game_save_init();
+    TEST_ASSERT_TRUE(game_save_resume(SAVE_KEY, &save_engine, &save_descriptor));
+    TEST_ASSERT_EQUAL_UINT32(1, restored_calls);
+    TEST_ASSERT_FALSE(save_engine.base_state.paused);
+
+    // The time it was off is not played
+    run_frames(40);
+    TEST_ASSERT_EQUAL_UINT32(expected.position, game_data()->position);
+    TEST_ASSERT_EQUAL_UINT32(expected.rolls, game_data()->rolls);
+    TEST_ASSERT_EQUAL_UINT16(expected.steps, game_data()->steps);
+    TEST_ASSERT_EQUAL_UINT32(expected_draw, game_random_next(&game_random));
+    TEST_ASSERT_EQUAL_UINT32(1, game_save_get_stats()->restores);
+}
+
+TEST(GameSave, PausedGameResumesRunning) {
+    run_frames(5);
+    save_engine.base_state.paused = true;
+    game_save_capture(SAVE_KEY, &save_engine, &save_descriptor);
+    write_out();
+
+    game_engine_cleanup(&save_engine);
+    TEST_ASSERT_TRUE(game_save_resume(SAVE_KEY, &save_engine, &save_descriptor));
+    TEST_ASSERT_FALSE(save_engine.base_state.paused);
+}
+
+TEST(GameSave, SnapshotOfAnotherImageIsNotRestored) {
+    run_frames(30);
+    game_save_capture(SAVE_KEY, &save_engine, &save_descriptor);
+    write_out();
+    uint32_t saved_steps = game_data()->steps;
+
+    mock_flash_set_image_id(2);
+    game_engine_cleanup(&save_engine);
+    TEST_ASSERT_FALSE(game_save_resume(SAVE_KEY, &save_engine, &save_descriptor));
+
+    // Started fresh instead
+    TEST_ASSERT_NOT_EQUAL(saved_steps, game_data()->steps);
+    TEST_ASSERT_EQUAL_UINT16(0, game_data()->steps);
+    TEST_ASSERT_EQUAL_UINT32(0, restored_calls);
+    TEST_ASSERT_EQUAL_UINT32(1, game_save_get_stats()->rejected);
+}
+
+TEST(GameSave, SnapshotOfAnotherGameVersionIsNotRestored) {
+    run_frames(30);
+    game_save_capture(SAVE_KEY, &save_engine, &save_descriptor);
+    write_out();
+
+    save_descriptor.version = 2;
+    game_engine_cleanup(&save_engine);
+    TEST_ASSERT_FALSE(game_save_resume(SAVE_KEY, &save_engine, &save_descriptor));
+    TEST_ASSERT_EQUAL_UINT16(0, game_data()->steps);
+}
+
+TEST(GameSave, CaptureWaitsForTheWriteInProgress) {
+    TEST_ASSERT_TRUE(game_save_capture(SAVE_KEY, &save_engine, &save_descriptor) > 0);
+    TEST_ASSERT_EQUAL_UINT32(0, game_save_capture(SAVE_KEY, &save_engine, &save_descriptor));
+    TEST_ASSERT_EQUAL_UINT32(1, game_save_get_stats()->busy);
+
+    write_out();
+    TEST_ASSERT_TRUE(game_save_capture(SAVE_KEY, &save_engine, &save_descriptor) > 0);
+}
+
+TEST(GameSave, DiscardedGameIsNotResumed) {
+    uint16_t key;
+
+    game_save_capture(SAVE_KEY, &save_engine, &save_descriptor);
+    // Game over while the snapshot is still being written - the discard follows it
+    game_save_discard(SAVE_KEY);
+    write_out();
+    write_out();
+
+    TEST_ASSERT_FALSE(game_save_latest(&key));
+    game_engine_cleanup(&save_engine);
+    TEST_ASSERT_FALSE(game_save_resume(SAVE_KEY, &save_engine, &save_descriptor));
+}
+
+TEST_GROUP_RUNNER(GameSave) {
+    RUN_TEST_CASE(GameSave, SnapshotIsWrittenBetweenFrames);
+    RUN_TEST_CASE(GameSave, ResumedSessionContinuesLikeTheOriginal);
+    RUN_TEST_CASE(GameSave, PausedGameResumesRunning);
+    RUN_TEST_CASE(GameSave, SnapshotOfAnotherImageIsNotRestored);
+    RUN_TEST_CASE(GameSave, SnapshotOfAnotherGameVersionIsNotRestored);
+    RUN_TEST_CASE(GameSave, CaptureWaitsForTheWriteInProgress);
+    RUN_TEST_CASE(GameSave, DiscardedGameIsNotResumed);
+}
@@ -0,0 +1,274 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Game_Engine/game_engine_timer.h"
+#include <string.h>
+
+static TimerWheel wheel;
+static uint8_t fire_count[4];
+static char order[16];
+static uint8_t order_length;
+static uint32_t fired_at[8];
+static uint8_t fired_at_count;
+static uint32_t now_ms;
+static timer_id_t self_id;
+
+static void count_fire(void* context) {
+    uint8_t index = (uint8_t)(uintptr_t)context;
+    fire_count[index]++;
+    if (fired_at_count < 8) {
+        fired_at[fired_at_count++] = now_ms;
+    }
+}
+
+static void log_fire(void* context) {
+    if (order_length < sizeof(order) - 1) {
+        order[order_length++] = (char)(uintptr_t)context;
+    }
+}
+
+static void cancel_self(void* context) {
+    count_fire(context);
+    timer_cancel(&wheel, self_id);
+}
+
+// Advance one millisecond at a time, like a game updating every frame
+static void run_until(uint32_t end_ms) {
+    while (now_ms < end_ms) {
+        now_ms++;
+        timer_wheel_advance(&wheel, now_ms);
+    }
+}
+
+TEST_GROUP(GameTimer);
+
+TEST_SETUP(GameTimer) {
+    memset(fire_count, 0, sizeof(fire_count));
+    memset(order, 0, sizeof(order));
+    memset(fired_at, 0, sizeof(fired_at));
+    order_length = 0;
+    fired_at_count = 0;
+    now_ms = 0;
+    self_id = TIMER_NONE;
+    timer_wheel_init(&wheel, now_ms);
+}
+
+TEST_TEAR_DOWN(GameTimer) {
+}
+
+TEST(GameTimer, OneShotFiresOnceAtItsDelay) {
+    timer_id_t id = timer_start(&wheel, 300, 0, count_fire, (void*)0);
+
+    run_until(299);
+    TEST_ASSERT_EQUAL(0, fire_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, timer_remaining_ms(&wheel, id));
+
+    run_until(1000);
+    TEST_ASSERT_EQUAL(1, fire_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(300, fired_at[0]);
+    TEST_ASSERT_FALSE(timer_is_active(&wheel, id));
+}
+
+TEST(GameTimer, PeriodicTimerStaysOnItsGrid) {
+    timer_start(&wheel, 500, 500, count_fire, (void*)0);
+
+    run_until(2600);
+
+    TEST_ASSERT_EQUAL(5, fire_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(500, fired_at[0]);
+    TEST_ASSERT_EQUAL_UINT32(2500, fired_at[4]);
+}
+
+TEST(GameTimer, LargeStepFiresEveryExpiryInOrder) {
+    timer_start(&wheel, 20, 20, count_fire, (void*)0);
+
+    // A slow frame catches up on every period it missed
+    now_ms = 90;
+    TEST_ASSERT_EQUAL(4, timer_wheel_advance(&wheel, now_ms));
+    TEST_ASSERT_EQUAL(4, fire_count[0]);
+}
+
+TEST(GameTimer, StallCatchesUpOnlyTheCap) {
+    timer_id_t id = timer_start(&wheel, 100, 100, count_fire, (void*)0);
+
+    // A second-long stall runs one period, not ten, and the rest is dropped
+    now_ms = 1000;
+    TEST_ASSERT_EQUAL(1, timer_wheel_advance(&wheel, now_ms));
+    TEST_ASSERT_EQUAL_UINT32(100, timer_remaining_ms(&wheel, id));
+
+    run_until(1099);
+    TEST_ASSERT_EQUAL(1, fire_count[0]);
+    run_until(1100);
+    TEST_ASSERT_EQUAL(2, fire_count[0]);
+}
+
+TEST(GameTimer, CancelStopsTimerAndStaleIdIsRejected) {
+    timer_id_t id = timer_start(&wheel, 100, 0, count_fire, (void*)0);
+
+    TEST_ASSERT_TRUE(timer_cancel(&wheel, id));
+    TEST_ASSERT_FALSE(timer_cancel(&wheel, id));
+
+    // The slot is reused, the old id must not reach the new timer
+    timer_id_t reused = timer_start(&wheel, 100, 0, count_fire, (void*)1);
+    TEST_ASSERT_NOT_EQUAL(id, reused);
+    TEST_ASSERT_FALSE(timer_cancel(&wheel, id));
+    TEST_ASSERT_FALSE(timer_restart(&wheel, id, 10));
+
+    run_until(200);
+    TEST_ASSERT_EQUAL(0, fire_count[0]);
+    TEST_ASSERT_EQUAL(1, fire_count[1]);
+}
+
+TEST(GameTimer, RestartPushesTheExpiryBack) {
+    timer_id_t id = timer_start(&wheel, 100, 0, count_fire, (void*)0);
+
+    run_until(80);
+    TEST_ASSERT_TRUE(timer_restart(&wheel, id, 100));
+    run_until(179);
+    TEST_ASSERT_EQUAL(0, fire_count[0]);
+
+    run_until(180);
+    TEST_ASSERT_EQUAL(1, fire_count[0]);
+}
+
+TEST(GameTimer, SetPeriodKeepsTheRunningPeriodStart) {
+    timer_id_t id = timer_start(&wheel, 500, 500, count_fire, (void*)0);
+
+    run_until(300);
+    TEST_ASSERT_TRUE(timer_set_period(&wheel, id, 400));
+    run_until(399);
+    TEST_ASSERT_EQUAL(0, fire_count[0]);
+    run_until(800);
+    TEST_ASSERT_EQUAL(2, fire_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(400, fired_at[0]);
+    TEST_ASSERT_EQUAL_UINT32(800, fired_at[1]);
+
+    // Already past the shorter period - fires on the next tick
+    run_until(1000);
+    TEST_ASSERT_TRUE(timer_set_period(&wheel, id, 100));
+    run_until(1001);
+    TEST_ASSERT_EQUAL(3, fire_count[0]);
+}
+
+TEST(GameTimer, SetPeriodRejectsOneShots) {
+    timer_id_t id = timer_start(&wheel, 100, 0, count_fire, (void*)0);
+    TEST_ASSERT_FALSE(timer_set_period(&wheel, id, 50));
+}
+
+TEST(GameTimer, PausedTimeDoesNotCount) {
+    timer_id_t id = timer_start(&wheel, 1000, 0, count_fire, (void*)0);
+
+    run_until(600);
+    timer_wheel_pause(&wheel);
+    run_until(5000);
+    TEST_ASSERT_EQUAL(0, fire_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(400, timer_remaining_ms(&wheel, id));
+
+    timer_wheel_resume(&wheel, now_ms);
+    run_until(5399);
+    TEST_ASSERT_EQUAL(0, fire_count[0]);
+    run_until(5400);
+    TEST_ASSERT_EQUAL(1, fire_count[0]);
+}
+
+TEST(GameTimer, TimersCascadeAcrossLevels) {
+    // 64 ms and 4096 ms are the level boundaries
+    timer_start(&wheel, 63, 0, count_fire, (void*)0);
+    timer_start(&wheel, 65, 0, count_fire, (void*)1);
+    timer_start(&wheel, 4100, 0, count_fire, (void*)2);
+    timer_start(&wheel, 200000, 0, count_fire, (void*)3);
+
+    run_until(210000);
+
+    TEST_ASSERT_EQUAL(1, fire_count[0]);
+    TEST_ASSERT_EQUAL(1, fire_count[1]);
+    TEST_ASSERT_EQUAL(1, fire_count[2]);
+    TEST_ASSERT_EQUAL(1, fire_count[3]);
+    TEST_ASSERT_EQUAL_UINT32(63, fired_at[0]);
+    TEST_ASSERT_EQUAL_UINT32(65, fired_at[1]);
+    TEST_ASSERT_EQUAL_UINT32(4100, fired_at[2]);
+    TEST_ASSERT_EQUAL_UINT32(200000, fired_at[3]);
+}
+
+TEST(GameTimer, StartedMidRotationStillFiresOnTime) {
+    run_until(4000);
+    timer_start(&wheel, 150, 0, count_fire, (void*)0);
+    timer_start(&wheel, 5000, 0, count_fire, (void*)1);
+
+    run_until(10000);
+
+    TEST_ASSERT_EQUAL_UINT32(4150, fired_at[0]);
+    TEST_ASSERT_EQUAL_UINT32(9000, fired_at[1]);
+}
+
+TEST(GameTimer, ClockWrapKeepsTheDelay) {
+    now_ms = 0xFFFFFFFFu - 50;
+    timer_wheel_init(&wheel, now_ms);
+    timer_start(&wheel, 100, 0, count_fire, (void*)0);
+
+    now_ms += 99;
+    timer_wheel_advance(&wheel, now_ms);
+    TEST_ASSERT_EQUAL(0, fire_count[0]);
+    now_ms += 1;
+    timer_wheel_advance(&wheel, now_ms);
+    TEST_ASSERT_EQUAL(1, fire_count[0]);
+}
+
+TEST(GameTimer, SameTickTimersAllFire) {
+    timer_start(&wheel, 50, 0, log_fire, (void*)'a');
+    timer_start(&wheel, 50, 0, log_fire, (void*)'b');
+    timer_start(&wheel, 40, 0, log_fire, (void*)'c');
+
+    run_until(60);
+
+    TEST_ASSERT_EQUAL(3, order_length);
+    TEST_ASSERT_EQUAL('c', order[0]);
+}
+
+TEST(GameTimer, CallbackMayCancelItself) {
+    self_id = timer_start(&wheel, 100, 100, cancel_self, (void*)0);
+
+    run_until(1000);
+
+    TEST_ASSERT_EQUAL(1, fire_count[0]);
+    TEST_ASSERT_FALSE(timer_is_active(&wheel, self_id));
+}
+
+TEST(GameTimer, PoolHasAFixedSize) {
+    for (uint8_t i = 0; i < TIMER_WHEEL_MAX_TIMERS; i++) {
+        TEST_ASSERT_NOT_EQUAL(TIMER_NONE, timer_start(&wheel, 100, 0, count_fire, (void*)0));
+    }
+    TEST_ASSERT_EQUAL(TIMER_NONE, timer_start(&wheel, 100, 0, count_fire, (void*)0));
+
+    // Fired one-shots go back to the pool
+    run_until(100);
+    TEST_ASSERT_NOT_EQUAL(TIMER_NONE, timer_start(&wheel, 100, 0, count_fire, (void*)0));
+}
+
+TEST(GameTimer, InitDropsEveryTimer) {
+    timer_id_t id = timer_start(&wheel, 100, 100, count_fire, (void*)0);
+
+    timer_wheel_init(&wheel, now_ms);
+    run_until(500);
+
+    TEST_ASSERT_EQUAL(0, fire_count[0]);
+    TEST_ASSERT_FALSE(timer_is_active(&wheel, id));
+}
+
+TEST_GROUP_RUNNER(GameTimer) {
+    RUN_TEST_CASE(GameTimer, OneShotFiresOnceAtItsDelay);
+    RUN_TEST_CASE(GameTimer, PeriodicTimerStaysOnItsGrid);
+    RUN_TEST_CASE(GameTimer, LargeStepFiresEveryExpiryInOrder);
+    RUN_TEST_CASE(GameTimer, StallCatchesUpOnlyTheCap);
+    RUN_TEST_CASE(GameTimer, CancelStopsTimerAndStaleIdIsRejected);
+    RUN_TEST_CASE(GameTimer, RestartPushesTheExpiryBack);
+    RUN_TEST_CASE(GameTimer, SetPeriodKeepsTheRunningPeriodStart);
+    RUN_TEST_CASE(GameTimer, SetPeriodRejectsOneShots);
+    RUN_TEST_CASE(GameTimer, PausedTimeDoesNotCount);
+    RUN_TEST_CASE(GameTimer, TimersCascadeAcrossLevels);
+    RUN_TEST_CASE(GameTimer, StartedMidRotationStillFiresOnTime);
+    RUN_TEST_CASE(GameTimer, ClockWrapKeepsTheDelay);
+    RUN_TEST_CASE(GameTimer, SameTickTimersAllFire);
+    RUN_TEST_CASE(GameTimer, CallbackMayCancelItself);
+    RUN_TEST_CASE(GameTimer, PoolHasAFixedSize);
+    RUN_TEST_CASE(GameTimer, InitDropsEveryTimer);
+}
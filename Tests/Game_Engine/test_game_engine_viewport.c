@@ -0,0 +1,119 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Game_Engine/game_engine_viewport.h"
+#include "Mocks/Inc/mock_display_driver.h"
+#include <string.h>
+
+#define MAP_WIDTH   40      // 320 x 240 world pixels, larger than the 128 x 64 test screen
+#define MAP_HEIGHT  30
+#define TILE        8
+
+static uint8_t tiles[MAP_HEIGHT][MAP_WIDTH];
+static Tilemap map;
+static Viewport vp;
+
+static uint16_t tiles_drawn;
+static coord_t first_tile_x;
+static coord_t first_tile_y;
+
+static void count_tile(uint8_t tile, coord_t screen_x, coord_t screen_y) {
+    (void)tile;
+    if (tiles_drawn == 0) {
+        first_tile_x = screen_x;
+        first_tile_y = screen_y;
+    }
+    tiles_drawn++;
+}
+
+TEST_GROUP(GameViewport);
+
+TEST_SETUP(GameViewport) {
+    mock_display_reset_state();
+    memset(tiles, 0, sizeof(tiles));
+    tiles_drawn = 0;
+
+    map.tiles = &tiles[0][0];
+    map.width = MAP_WIDTH;
+    map.height = MAP_HEIGHT;
+    map.stride = MAP_WIDTH;
+    map.tile_size = TILE;
+    map.draw_tile = count_tile;
+
+    // Game area below a 12 pixel status bar, 52 rows high
+    viewport_init(&vp, &map, 0, 12, 128, 52);
+}
+
+TEST_TEAR_DOWN(GameViewport) {
+    viewport_cleanup(&vp);
+}
+
+TEST(GameViewport, WindowIsWholeTilesCentredInTheArea) {
+    TEST_ASSERT_EQUAL(128, vp.width);
+    TEST_ASSERT_EQUAL(48, vp.height);      // 52 rows fit 6 whole tiles
+    TEST_ASSERT_EQUAL(0, vp.screen_x);
+    TEST_ASSERT_EQUAL(14, vp.screen_y);    // The 4 spare rows split above and below
+    TEST_ASSERT_FALSE(vp.hw_scroll);
+}
+
+TEST(GameViewport, WorldMapsToScreenThroughTheCamera) {
+    TEST_ASSERT_EQUAL(0, viewport_to_screen_x(&vp, 0));
+    TEST_ASSERT_EQUAL(14, viewport_to_screen_y(&vp, 0));
+
+    // Followed to the far corner, the camera stops at the map's edge
+    viewport_follow(&vp, 312, 232, TILE, TILE);
+    TEST_ASSERT_EQUAL_INT32(320 - 128, vp.cam_x);
+    TEST_ASSERT_EQUAL_INT32(240 - 48, vp.cam_y);
+    TEST_ASSERT_EQUAL(120, viewport_to_screen_x(&vp, 312));
+    TEST_ASSERT_EQUAL(14 + 40, viewport_to_screen_y(&vp, 232));
+
+    TEST_ASSERT_TRUE(viewport_is_visible(&vp, 312, 232, TILE, TILE));
+    TEST_ASSERT_FALSE(viewport_is_visible(&vp, 0, 0, TILE, TILE));
+    TEST_ASSERT_FALSE(viewport_is_visible(&vp, 320 - 128 - 1, 232, TILE, TILE));  // Straddles the left edge
+}
+
+TEST(GameViewport, CameraHoldsInsideTheDeadZone) {
+    viewport_follow(&vp, 160, 120, TILE, TILE);
+    int32_t cam_x = vp.cam_x;
+    int32_t cam_y = vp.cam_y;
+
+    // A tile's move that stays clear of the margins leaves the camera where it was
+    viewport_follow(&vp, 168, 120, TILE, TILE);
+    TEST_ASSERT_EQUAL_INT32(cam_x, vp.cam_x);
+    TEST_ASSERT_EQUAL_INT32(cam_y, vp.cam_y);
+    TEST_ASSERT_EQUAL_INT32(0, vp.cam_x % TILE);
+    TEST_ASSERT_EQUAL_INT32(0, vp.cam_y % TILE);
+}
+
+TEST(GameViewport, RenderPaintsOnlyTheWindow) {
+    viewport_follow(&vp, 160, 120, TILE, TILE);
+
+    TEST_ASSERT_TRUE(viewport_render(&vp));
+    TEST_ASSERT_EQUAL(16 * 6, tiles_drawn);
+    TEST_ASSERT_EQUAL(vp.screen_x, first_tile_x);
+    TEST_ASSERT_EQUAL(vp.screen_y, first_tile_y);
+
+    // Nothing moved, nothing to paint
+    TEST_ASSERT_FALSE(viewport_render(&vp));
+}
+
+TEST(GameViewport, RedrawIsClippedToTheWindow) {
+    // Two tiles wide, one of them left of the window
+    viewport_follow(&vp, 160, 120, TILE, TILE);
+    viewport_redraw_world_rect(&vp, vp.cam_x - TILE, vp.cam_y, 2 * TILE, TILE);
+    TEST_ASSERT_EQUAL(1, tiles_drawn);
+    TEST_ASSERT_EQUAL(vp.screen_x, first_tile_x);
+    TEST_ASSERT_EQUAL(vp.screen_y, first_tile_y);
+
+    // Wholly off-screen
+    tiles_drawn = 0;
+    viewport_redraw_world_rect(&vp, 0, 0, TILE, TILE);
+    TEST_ASSERT_EQUAL(0, tiles_drawn);
+}
+
+TEST_GROUP_RUNNER(GameViewport) {
+    RUN_TEST_CASE(GameViewport, WindowIsWholeTilesCentredInTheArea);
+    RUN_TEST_CASE(GameViewport, WorldMapsToScreenThroughTheCamera);
+    RUN_TEST_CASE(GameViewport, CameraHoldsInsideTheDeadZone);
+    RUN_TEST_CASE(GameViewport, RenderPaintsOnlyTheWindow);
+    RUN_TEST_CASE(GameViewport, RedrawIsClippedToTheWindow);
+}
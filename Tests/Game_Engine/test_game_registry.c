@@ -0,0 +1,113 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Game_Engine/game_registry.h"
+
+static uint8_t assets_loads;
+
+static void count_asset_load(void) {
+    assets_loads++;
+}
+
+static GameEngine test_engine_a;
+static GameEngine test_engine_b;
+static GameEngine test_engine_big;
+
+// Registered alongside whatever games are linked into the test build
+REGISTER_GAME(test_game_late) = {
+    .name = "Test Late",
+    .screen = SCREEN_GAME_4,
+    .mode = GAME_MODE_SINGLE_PLAYER,
+    .input = GAME_INPUT_JOYSTICK,
+    .menu_order = 201,
+    .engine = &test_engine_a,
+    .load_assets = count_asset_load
+};
+
+REGISTER_GAME(test_game_early) = {
+    .name = "Test Early",
+    .screen = SCREEN_GAME_3,
+    .mode = GAME_MODE_SINGLE_PLAYER,
+    .input = GAME_INPUT_DPAD,
+    .menu_order = 200,
+    .engine = &test_engine_b
+};
+
+REGISTER_GAME(test_game_too_big) = {
+    .name = "Test Too Big",
+    .screen = SCREEN_MP_GAME_5,
+    .mode = GAME_MODE_MULTIPLAYER,
+    .input = GAME_INPUT_DPAD,
+    .menu_order = 200,
+    .arena_size = GAME_ARENA_SIZE + 1,
+    .engine = &test_engine_big
+};
+
+static int8_t menu_index_of(const MenuItem* items, uint8_t count, ScreenType screen) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (items[i].screen == screen) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+TEST_GROUP(GameRegistry);
+
+TEST_SETUP(GameRegistry) {
+}
+
+TEST_TEAR_DOWN(GameRegistry) {
+}
+
+TEST(GameRegistry, FindsRegisteredGames) {
+    TEST_ASSERT_TRUE(game_registry_count() >= 3);
+    TEST_ASSERT_EQUAL_PTR(&test_game_early, game_registry_find(SCREEN_GAME_3));
+    TEST_ASSERT_NULL(game_registry_find(SCREEN_WELCOME));
+}
+
+TEST(GameRegistry, MenuIsSortedAndFilteredByMode) {
+    MenuItem items[GAME_REGISTRY_MAX_GAMES];
+    uint8_t count = game_registry_build_menu(GAME_MODE_SINGLE_PLAYER, items, GAME_REGISTRY_MAX_GAMES);
+
+    int8_t early = menu_index_of(items, count, SCREEN_GAME_3);
+    int8_t late = menu_index_of(items, count, SCREEN_GAME_4);
+    TEST_ASSERT_TRUE(early >= 0);
+    TEST_ASSERT_EQUAL(early + 1, late);
+    TEST_ASSERT_EQUAL_STRING("Test Early", items[early].title);
+    TEST_ASSERT_EQUAL(1, items[early].is_game);
+    TEST_ASSERT_EQUAL(-1, menu_index_of(items, count, SCREEN_MP_GAME_5));
+}
+
+TEST(GameRegistry, MenuRespectsCapacity) {
+    MenuItem items[1];
+    TEST_ASSERT_EQUAL(1, game_registry_build_menu(GAME_MODE_SINGLE_PLAYER, items, 1));
+}
+
+TEST(GameRegistry, AssetsLoadOnFirstLaunchOnly) {
+    assets_loads = 0;
+
+    TEST_ASSERT_EQUAL_PTR(&test_engine_a, game_registry_prepare(SCREEN_GAME_4));
+    TEST_ASSERT_EQUAL_PTR(&test_engine_a, game_registry_prepare(SCREEN_GAME_4));
+
+    TEST_ASSERT_EQUAL(1, assets_loads);
+    TEST_ASSERT_TRUE(game_registry_assets_loaded(&test_game_late));
+    TEST_ASSERT_FALSE(test_engine_a.is_d_pad_game);
+}
+
+TEST(GameRegistry, GameLargerThanArenaIsRefused) {
+    TEST_ASSERT_NULL(game_registry_prepare(SCREEN_MP_GAME_5));
+}
+
+TEST(GameRegistry, AssetPoolIsBounded) {
+    TEST_ASSERT_NOT_NULL(game_registry_asset_alloc(8));
+    TEST_ASSERT_NULL(game_registry_asset_alloc(GAME_ASSET_POOL_SIZE));
+}
+
+TEST_GROUP_RUNNER(GameRegistry) {
+    RUN_TEST_CASE(GameRegistry, FindsRegisteredGames);
+    RUN_TEST_CASE(GameRegistry, MenuIsSortedAndFilteredByMode);
+    RUN_TEST_CASE(GameRegistry, MenuRespectsCapacity);
+    RUN_TEST_CASE(GameRegistry, AssetsLoadOnFirstLaunchOnly);
+    RUN_TEST_CASE(GameRegistry, GameLargerThanArenaIsRefused);
+    RUN_TEST_CASE(GameRegistry, AssetPoolIsBounded);
+}
@@ -0,0 +1,180 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Game_Engine/game_engine_input.h"
+#include "Console_Peripherals/Hardware/display_manager.h"
+#include "Utils/latency_probe.h"
+#include "Mocks/Inc/mock_utils.h"
+#include "Mocks/Inc/mock_display_driver.h"
+#include <string.h>
+
+static InputQueue queue;
+static GameEngine engine;
+
+// One frame of the game loop: a tick drains the input, the game draws if asked, then the flush
+static void frame(uint32_t tick_us, uint32_t flush_us, bool draws) {
+    mock_time_set_us(tick_us);
+    latency_probe_tick();
+    game_engine_drain_input(&engine, &queue);
+
+    mock_display_set_changed(draws);
+    mock_time_set_us(flush_us);
+    display_manager_update();
+}
+
+// A frame whose game marks its response at the tile (mark_x, mark_y), then draws only x1, y1 to x2, y2
+static void frame_drawing(uint32_t tick_us, uint32_t flush_us, coord_t mark_x, coord_t mark_y,
+    coord_t x1, coord_t y1, coord_t x2, coord_t y2) {
+    mock_time_set_us(tick_us);
+    latency_probe_tick();
+    game_engine_drain_input(&engine, &queue);
+    latency_probe_mark(mark_x, mark_y, 8);
+
+    mock_display_set_dirty_region(x1, y1, x2, y2);
+    mock_time_set_us(flush_us);
+    display_manager_update();
+}
+
+TEST_GROUP(LatencyProbe);
+
+TEST_SETUP(LatencyProbe) {
+    input_queue_reset(&queue);
+    memset(&engine, 0, sizeof(engine));
+    mock_time_reset();
+    mock_display_reset_state();
+    latency_probe_reset();
+    latency_probe_begin("Snake");
+}
+
+TEST_TEAR_DOWN(LatencyProbe) {
+}
+
+TEST(LatencyProbe, EdgeToFlushIsRecorded) {
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_UP, 1000);
+    frame(5000, 9000, true);
+
+    const LatencyHistogram* snake = latency_probe_get("Snake");
+    TEST_ASSERT_NOT_NULL(snake);
+    TEST_ASSERT_EQUAL_UINT32(1, snake->count);
+    TEST_ASSERT_EQUAL_UINT32(8000, snake->max_us);
+    TEST_ASSERT_EQUAL_UINT32(4000, (uint32_t)snake->queued_us);
+    TEST_ASSERT_EQUAL_UINT32(1, snake->buckets[8000 / LATENCY_PROBE_BUCKET_US]);
+}
+
+TEST(LatencyProbe, FlushesThatDrawNothingKeepWaiting) {
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_LEFT, 0);
+
+    // The turn only shows on the next movement step
+    frame(2000, 3000, false);
+    frame(12000, 13000, false);
+    frame(22000, 25000, true);
+
+    const LatencyHistogram* snake = latency_probe_get("Snake");
+    TEST_ASSERT_EQUAL_UINT32(1, snake->count);
+    TEST_ASSERT_EQUAL_UINT32(25000, snake->min_us);
+    TEST_ASSERT_EQUAL_UINT32(2, snake->ticks);
+}
+
+TEST(LatencyProbe, ReleasesAreNotTimed) {
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_UP, 0);
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, 0, 100);
+    frame(1000, 2000, true);
+
+    TEST_ASSERT_EQUAL_UINT32(1, latency_probe_get("Snake")->count);
+}
+
+TEST(LatencyProbe, EachGameHasItsOwnHistogram) {
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_UP, 0);
+    frame(1000, 3000, true);
+
+    latency_probe_begin("Pacman");
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_UP, 10000);
+    frame(11000, 30000, true);
+
+    // Back to the first game, its samples are kept
+    latency_probe_begin("Snake");
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_DOWN, 40000);
+    frame(41000, 44000, true);
+
+    TEST_ASSERT_EQUAL_UINT32(2, latency_probe_get("Snake")->count);
+    TEST_ASSERT_EQUAL_UINT32(4000, latency_probe_get("Snake")->max_us);
+    TEST_ASSERT_EQUAL_UINT32(1, latency_probe_get("Pacman")->count);
+    TEST_ASSERT_EQUAL_UINT32(20000, latency_probe_get("Pacman")->max_us);
+    TEST_ASSERT_NULL(latency_probe_get("Tetris"));
+}
+
+TEST(LatencyProbe, PercentilesComeFromTheBuckets) {
+    // Nine fast responses and one slow one
+    for (uint8_t i = 0; i < 9; i++) {
+        input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_UP + (i & 1), i * 100000);
+        frame(i * 100000 + 1000, i * 100000 + 3000, true);
+    }
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_UP, 1000000);
+    frame(1010000, 1050000, true);
+
+    const LatencyHistogram* snake = latency_probe_get("Snake");
+    TEST_ASSERT_EQUAL_UINT32(LATENCY_PROBE_BUCKET_US, latency_probe_percentile(snake, 50));
+    TEST_ASSERT_EQUAL_UINT32(LATENCY_PROBE_BUCKET_US, latency_probe_percentile(snake, 90));
+    TEST_ASSERT_EQUAL_UINT32(52000, latency_probe_percentile(snake, 100));
+}
+
+TEST(LatencyProbe, InputsBeyondThePendingLimitAreDropped) {
+    for (uint8_t i = 0; i < LATENCY_PROBE_PENDING + 2; i++) {
+        input_queue_push(&queue, INPUT_SOURCE_JOYSTICK, JS_DIR_LEFT + (i & 1), 0);
+    }
+    frame(1000, 2000, true);
+
+    const LatencyHistogram* snake = latency_probe_get("Snake");
+    TEST_ASSERT_EQUAL_UINT32(LATENCY_PROBE_PENDING, snake->count);
+    TEST_ASSERT_EQUAL_UINT32(2, snake->dropped);
+}
+
+TEST(LatencyProbe, FlushesElsewhereKeepWaiting) {
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_UP, 0);
+
+    // The score is redrawn first, the sprite's move lands a tile above it later
+    frame_drawing(1000, 2000, 40, 40, 0, 0, 60, 10);
+    TEST_ASSERT_EQUAL_UINT32(0, latency_probe_get("Snake")->count);
+
+    frame_drawing(11000, 12000, 40, 40, 40, 32, 47, 39);
+    TEST_ASSERT_EQUAL_UINT32(1, latency_probe_get("Snake")->count);
+    TEST_ASSERT_EQUAL_UINT32(12000, latency_probe_get("Snake")->min_us);
+}
+
+TEST(LatencyProbe, MarkStopsAtTheScreenEdge) {
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_LEFT, 0);
+
+    // Tile (0, 0) marks up to the second tile, not round to the far side
+    frame_drawing(1000, 2000, 0, 0, 16, 0, 23, 7);
+    TEST_ASSERT_EQUAL_UINT32(0, latency_probe_get("Snake")->count);
+    frame_drawing(3000, 4000, 0, 0, 0, 0, 7, 7);
+    TEST_ASSERT_EQUAL_UINT32(1, latency_probe_get("Snake")->count);
+}
+
+TEST(LatencyProbe, UndrawnMarksExpire) {
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_UP, 0);
+
+    frame_drawing(1000, 2000, 40, 40, 0, 0, 7, 7);
+    frame_drawing(LATENCY_PROBE_TIMEOUT_US, LATENCY_PROBE_TIMEOUT_US + 1000, 40, 40, 0, 0, 7, 7);
+
+    const LatencyHistogram* snake = latency_probe_get("Snake");
+    TEST_ASSERT_EQUAL_UINT32(0, snake->count);
+    TEST_ASSERT_EQUAL_UINT32(1, snake->expired);
+
+    // The next input is timed on its own
+    input_queue_push(&queue, INPUT_SOURCE_DPAD, DPAD_DIR_DOWN, LATENCY_PROBE_TIMEOUT_US + 5000);
+    frame_drawing(LATENCY_PROBE_TIMEOUT_US + 6000, LATENCY_PROBE_TIMEOUT_US + 7000, 40, 40, 40, 40, 47, 47);
+    TEST_ASSERT_EQUAL_UINT32(1, snake->count);
+    TEST_ASSERT_EQUAL_UINT32(2000, snake->max_us);
+}
+
+TEST_GROUP_RUNNER(LatencyProbe) {
+    RUN_TEST_CASE(LatencyProbe, EdgeToFlushIsRecorded);
+    RUN_TEST_CASE(LatencyProbe, FlushesThatDrawNothingKeepWaiting);
+    RUN_TEST_CASE(LatencyProbe, ReleasesAreNotTimed);
+    RUN_TEST_CASE(LatencyProbe, EachGameHasItsOwnHistogram);
+    RUN_TEST_CASE(LatencyProbe, PercentilesComeFromTheBuckets);
+    RUN_TEST_CASE(LatencyProbe, InputsBeyondThePendingLimitAreDropped);
+    RUN_TEST_CASE(LatencyProbe, FlushesElsewhereKeepWaiting);
+    RUN_TEST_CASE(LatencyProbe, MarkStopsAtTheScreenEdge);
+    RUN_TEST_CASE(LatencyProbe, UndrawnMarksExpire);
+}
@@ -0,0 +1,231 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_body_sync.h"
+#include "Game_Engine/game_engine_arena.h"
+#include "Communication/serial_comm_game_state.h"
+#include "esp32/main/helpers/game-state/body_sync_encoder.h"
+#include <string.h>
+#include <stdio.h>
+
+#define GRID_WIDTH  (DISPLAY_WIDTH / MP_DEVICE_TILE_SIZE)
+
+// Server stand-in - the opponent in cells, going round a loop clear of the screen's edges
+// and growing every few ticks
+static game_state_player_t server;
+static uint32_t server_tick;
+
+static body_sync_track_t track;     // ESP32 side
+static BodySync sync;               // STM32 side
+static SnakeState opponent;
+static uint8_t payload[BODY_SYNC_MAX_SIZE];
+
+static void server_init(uint8_t body_length) {
+    memset(&server, 0, sizeof(server));
+    server.head_x = 3 + body_length;
+    server.head_y = 3;
+    server.body_length = body_length;
+    for (uint8_t i = 0; i < body_length; i++) {
+        server.body_x[i] = server.head_x - 1 - i;
+        server.body_y[i] = server.head_y;
+    }
+    server_tick = 0;
+}
+
+// Right 7, down 2, left 7, up 2 - the loop through cells 3..10, 3..5
+static void server_step(bool grow) {
+    uint32_t lap = server_tick % 18;
+
+    if (grow && server.body_length < BODY_SYNC_MAX_SEGMENTS) {
+        server.body_length++;
+    }
+    memmove(&server.body_x[1], &server.body_x[0], server.body_length - 1);
+    memmove(&server.body_y[1], &server.body_y[0], server.body_length - 1);
+    server.body_x[0] = server.head_x;
+    server.body_y[0] = server.head_y;
+
+    if (lap < 7)       { server.head_x++; }
+    else if (lap < 9)  { server.head_y++; }
+    else if (lap < 16) { server.head_x--; }
+    else               { server.head_y--; }
+    server_tick++;
+}
+
+// ESP32 encodes, the frame crosses the UART, the STM32 decodes and applies
+static size_t send(bool deliver, bool* applied) {
+    uart_body_sync_t body_sync;
+    size_t length = body_sync_encode(&track, 2, server_tick, &server, payload);
+
+    TEST_ASSERT_NOT_EQUAL(0, length);
+    if (deliver) {
+        TEST_ASSERT_TRUE(body_sync_decode(payload, (uint8_t)length, &body_sync));
+        TEST_ASSERT_EQUAL_UINT8(2, body_sync.player_id);
+        *applied = mp_body_sync_apply(&sync, &opponent, &body_sync);
+    }
+    return length;
+}
+
+static void assert_matches_server(void) {
+    coord_t* body_x = snake_body_x(&opponent);
+    coord_t* body_y = snake_body_y(&opponent);
+
+    TEST_ASSERT_EQUAL_UINT32(server_tick, sync.tick);
+    TEST_ASSERT_EQUAL(server.head_x * MP_DEVICE_TILE_SIZE, opponent.head_x);
+    TEST_ASSERT_EQUAL(server.head_y * MP_DEVICE_TILE_SIZE, opponent.head_y);
+    TEST_ASSERT_EQUAL_UINT8(server.body_length, opponent.length);
+    for (uint8_t i = 0; i < server.body_length; i++) {
+        TEST_ASSERT_EQUAL(server.body_x[i] * MP_DEVICE_TILE_SIZE, body_x[i]);
+        TEST_ASSERT_EQUAL(server.body_y[i] * MP_DEVICE_TILE_SIZE, body_y[i]);
+    }
+}
+
+TEST_GROUP(MpSnakeBodySync);
+
+TEST_SETUP(MpSnakeBodySync) {
+    game_arena_reset();
+    entity_store_create();
+    snake_helper_init_snake(&opponent, 0x20, 0x20, DPAD_DIR_LEFT);
+    mp_body_sync_init(&sync);
+    body_sync_reset(&track);
+    server_init(4);
+}
+
+TEST_TEAR_DOWN(MpSnakeBodySync) {
+    game_arena_reset();
+}
+
+TEST(MpSnakeBodySync, KeyframeRebuildsTheBody) {
+    bool applied = false;
+
+    TEST_ASSERT_EQUAL(BODY_SYNC_KEYFRAME_SIZE(4), send(true, &applied));
+    TEST_ASSERT_TRUE(applied);
+    TEST_ASSERT_TRUE(sync.synced);
+    TEST_ASSERT_EQUAL_UINT32(1, sync.keyframes);
+    TEST_ASSERT_EQUAL_UINT8(DPAD_DIR_RIGHT, opponent.direction);
+    assert_matches_server();
+}
+
+TEST(MpSnakeBodySync, DeltasFollowTheServerEveryTick) {
+    bool applied = false;
+
+    send(true, &applied);
+    for (uint32_t i = 0; i < 200; i++) {
+        server_step(i % 5 == 0);
+        send(true, &applied);
+        TEST_ASSERT_TRUE(applied);
+        assert_matches_server();
+    }
+
+    // One keyframe per interval, everything else a delta
+    TEST_ASSERT_EQUAL_UINT32(1 + 200 / BODY_SYNC_KEYFRAME_INTERVAL, sync.keyframes);
+    TEST_ASSERT_EQUAL_UINT32(200 - 200 / BODY_SYNC_KEYFRAME_INTERVAL, sync.deltas);
+    TEST_ASSERT_EQUAL_UINT32(0, sync.gaps);
+}
+
+TEST(MpSnakeBodySync, SkippedTicksCarrySeveralMoves) {
+    bool applied = false;
+
+    send(true, &applied);
+    for (uint32_t i = 1; i <= 60; i++) {
+        server_step(false);
+        if (i % BODY_SYNC_MAX_MOVES == 0) {
+            size_t length = send(true, &applied);
+            TEST_ASSERT_TRUE(length == BODY_SYNC_DELTA_SIZE || track.keyframe_tick == server_tick);
+            TEST_ASSERT_TRUE(applied);
+            assert_matches_server();
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, sync.gaps);
+
+    // More moves than a delta holds is a keyframe
+    for (uint8_t i = 0; i <= BODY_SYNC_MAX_MOVES; i++) {
+        server_step(false);
+    }
+    TEST_ASSERT_EQUAL(BODY_SYNC_KEYFRAME_SIZE(server.body_length), send(true, &applied));
+    assert_matches_server();
+}
+
+TEST(MpSnakeBodySync, DeltaSizeDoesNotDependOnLength) {
+    bool applied = false;
+    size_t short_delta;
+
+    send(true, &applied);
+    server_step(false);
+    short_delta = send(true, &applied);
+
+    // Grown to the longest body the STM32 holds
+    while (server.body_length < SNAKE_MAX_LENGTH) {
+        server_step(true);
+        send(true, &applied);
+    }
+    server_step(false);
+    TEST_ASSERT_EQUAL(BODY_SYNC_DELTA_SIZE, short_delta);
+    TEST_ASSERT_EQUAL(BODY_SYNC_DELTA_SIZE, send(true, &applied));
+    assert_matches_server();
+
+    printf("\nMpSnakeBodySync: delta %u bytes at 4 and %u segments, keyframe %u, body as cell pairs %u\n",
+        (unsigned)short_delta, (unsigned)SNAKE_MAX_LENGTH,
+        (unsigned)BODY_SYNC_KEYFRAME_SIZE(SNAKE_MAX_LENGTH), (unsigned)(2 * SNAKE_MAX_LENGTH));
+}
+
+TEST(MpSnakeBodySync, LostDeltaWaitsForTheKeyframe) {
+    bool applied = false;
+    uint32_t ignored = 0;
+
+    send(true, &applied);
+    server_step(false);
+    send(false, &applied);
+
+    // The STM32 is a tick behind and cannot place the next moves
+    server_step(false);
+    send(true, &applied);
+    TEST_ASSERT_FALSE(applied);
+    TEST_ASSERT_FALSE(sync.synced);
+
+    while (true) {
+        server_step(false);
+        send(true, &applied);
+        if (applied) {
+            break;
+        }
+        ignored++;
+    }
+    TEST_ASSERT_TRUE(sync.synced);
+    TEST_ASSERT_EQUAL_UINT32(2, sync.keyframes);
+    TEST_ASSERT_EQUAL_UINT32(ignored + 1, sync.gaps);
+    TEST_ASSERT_TRUE(ignored < BODY_SYNC_KEYFRAME_INTERVAL);
+    assert_matches_server();
+
+    // A delta seen again is not applied twice
+    uart_body_sync_t repeated;
+    server_step(false);
+    send(true, &applied);
+    TEST_ASSERT_TRUE(body_sync_decode(payload, BODY_SYNC_DELTA_SIZE, &repeated));
+    TEST_ASSERT_FALSE(mp_body_sync_apply(&sync, &opponent, &repeated));
+    TEST_ASSERT_EQUAL_UINT32(1, sync.stale);
+    assert_matches_server();
+}
+
+TEST(MpSnakeBodySync, MovesAcrossTheEdgeAreOneCell) {
+    // Head wrapped to column 0 from the last column, one move right
+    server.head_x = 0;
+    server.body_length = 2;
+    server.body_x[0] = GRID_WIDTH - 1;
+    server.body_x[1] = GRID_WIDTH - 2;
+    server.body_y[0] = server.body_y[1] = server.head_y;
+    TEST_ASSERT_EQUAL(BODY_SYNC_KEYFRAME_SIZE(2), body_sync_encode(&track, 2, 0, &server, payload));
+    TEST_ASSERT_EQUAL_HEX8(BODY_SYNC_CODE_RIGHT | (BODY_SYNC_CODE_RIGHT << 2), payload[BODY_SYNC_KEYFRAME_HEADER_SIZE]);
+
+    // A body that is not a chain of neighbouring cells is not sent
+    server.body_y[1] = server.head_y + 1;
+    TEST_ASSERT_EQUAL(0, body_sync_encode(&track, 2, 1, &server, payload));
+    TEST_ASSERT_FALSE(track.valid);
+}
+
+TEST_GROUP_RUNNER(MpSnakeBodySync) {
+    RUN_TEST_CASE(MpSnakeBodySync, KeyframeRebuildsTheBody);
+    RUN_TEST_CASE(MpSnakeBodySync, DeltasFollowTheServerEveryTick);
+    RUN_TEST_CASE(MpSnakeBodySync, SkippedTicksCarrySeveralMoves);
+    RUN_TEST_CASE(MpSnakeBodySync, DeltaSizeDoesNotDependOnLength);
+    RUN_TEST_CASE(MpSnakeBodySync, LostDeltaWaitsForTheKeyframe);
+    RUN_TEST_CASE(MpSnakeBodySync, MovesAcrossTheEdgeAreOneCell);
+}
@@ -0,0 +1,267 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_jitter.h"
+#include "Game_Engine/game_engine_arena.h"
+#include "Communication/serial_comm_game_state.h"
+#include "esp32/main/helpers/game-state/body_sync_encoder.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TICK_MS         100
+#define FRAME_MS        10
+#define TRACE_TICKS     100
+
+// Arrival times in ms from the server's tick 0 of one body sync per tick. Steady is a link
+// with a few ms of jitter; wifi adds tens of ms per message and three stalls where the
+// websocket delivers several states at once.
+static const uint16_t steady_trace[TRACE_TICKS] = {
+    20, 119, 221, 323, 418, 518, 624, 722, 818, 920,
+    1022, 1118, 1222, 1319, 1418, 1518, 1621, 1721, 1818, 1919,
+    2018, 2122, 2221, 2318, 2424, 2522, 2618, 2719, 2823, 2923,
+    3022, 3118, 3222, 3322, 3421, 3518, 3619, 3718, 3822, 3924,
+    4019, 4120, 4221, 4319, 4422, 4518, 4622, 4720, 4822, 4924,
+    5023, 5119, 5218, 5322, 5422, 5523, 5619, 5720, 5818, 5922,
+    6023, 6118, 6222, 6318, 6422, 6519, 6621, 6723, 6822, 6921,
+    7024, 7120, 7221, 7322, 7421, 7520, 7620, 7719, 7824, 7919,
+    8023, 8124, 8219, 8318, 8422, 8520, 8622, 8721, 8820, 8923,
+    9021, 9120, 9222, 9318, 9418, 9522, 9621, 9719, 9824, 9920,
+};
+
+static const uint16_t wifi_trace[TRACE_TICKS] = {
+    44, 187, 278, 330, 434, 565, 668, 769, 888, 983,
+    1033, 1136, 1259, 1385, 1433, 1532, 1664, 1782, 1861, 1974,
+    2069, 2127, 2284, 2621, 2623, 2623, 2661, 2741, 2856, 2975,
+    3075, 3188, 3235, 3346, 3482, 3576, 3695, 3760, 3842, 3980,
+    4095, 4160, 4278, 4370, 4473, 4554, 4644, 4735, 4847, 4944,
+    5054, 5400, 5404, 5404, 5461, 5525, 5643, 5778, 5893, 5972,
+    6065, 6141, 6290, 6331, 6483, 6575, 6675, 6776, 6875, 6938,
+    7086, 7176, 7232, 7349, 7433, 7551, 7681, 8050, 8054, 8054,
+    8054, 8144, 8293, 8337, 8471, 8528, 8634, 8751, 8873, 8944,
+    9057, 9169, 9271, 9385, 9440, 9539, 9687, 9784, 9886, 9986,
+};
+
+// How the opponent's head moved on screen, frame by frame
+typedef struct {
+    uint32_t moves;
+    uint32_t uneven_ms;     // Sum of each move's distance from a tick after the last
+    uint32_t stalls;        // No move for more than one and a half ticks
+    uint32_t jumps;         // More than one cell in a frame
+} Smoothness;
+
+// Server stand-in - the opponent in cells, going round a loop clear of the screen's edges
+static game_state_player_t server;
+static uart_body_sync_t messages[TRACE_TICKS];     // As decoded on the STM32
+static uint8_t heads_x[TRACE_TICKS];
+static uint8_t heads_y[TRACE_TICKS];
+
+static JitterBuffer jitter;
+static BodySync direct;
+static SnakeState shown;
+
+// Right 7, down 2, left 7, up 2 from cell (7, 3)
+static void server_step(uint32_t tick) {
+    uint32_t lap = tick % 18;
+
+    memmove(&server.body_x[1], &server.body_x[0], server.body_length - 1);
+    memmove(&server.body_y[1], &server.body_y[0], server.body_length - 1);
+    server.body_x[0] = server.head_x;
+    server.body_y[0] = server.head_y;
+
+    if (lap < 7)       { server.head_x++; }
+    else if (lap < 9)  { server.head_y++; }
+    else if (lap < 16) { server.head_x--; }
+    else               { server.head_y--; }
+}
+
+// Everything the ESP32 sends over the game, one body sync per tick
+static void record_server(void) {
+    body_sync_track_t track;
+    uint8_t payload[BODY_SYNC_MAX_SIZE];
+
+    memset(&server, 0, sizeof(server));
+    server.head_x = 7;
+    server.head_y = 3;
+    server.body_length = 4;
+    for (uint8_t i = 0; i < server.body_length; i++) {
+        server.body_x[i] = server.head_x - 1 - i;
+        server.body_y[i] = server.head_y;
+    }
+
+    body_sync_reset(&track);
+    for (uint32_t tick = 0; tick < TRACE_TICKS; tick++) {
+        if (tick > 0) {
+            server_step(tick - 1);
+        }
+        size_t length = body_sync_encode(&track, 2, tick, &server, payload);
+        TEST_ASSERT_TRUE(body_sync_decode(payload, (uint8_t)length, &messages[tick]));
+        heads_x[tick] = server.head_x;
+        heads_y[tick] = server.head_y;
+    }
+}
+
+static void assert_shows_tick(uint32_t tick) {
+    TEST_ASSERT_EQUAL(heads_x[tick] * MP_DEVICE_TILE_SIZE, shown.head_x);
+    TEST_ASSERT_EQUAL(heads_y[tick] * MP_DEVICE_TILE_SIZE, shown.head_y);
+}
+
+// Frames at FRAME_MS, each delivers what has arrived and draws. Without the buffer a body sync
+// is applied as it lands, as before.
+static Smoothness replay(const uint16_t* trace, bool buffered) {
+    Smoothness result = { 0 };
+    uint32_t next = 0;
+    uint32_t last_move_ms = 0;
+    bool moving = false;
+    coord_t last_x = shown.head_x;
+    coord_t last_y = shown.head_y;
+
+    for (uint32_t now = 0; now <= trace[TRACE_TICKS - 1] + (uint32_t)MP_JITTER_MAX_DELAY_MS; now += FRAME_MS) {
+        while (next < TRACE_TICKS && trace[next] <= now) {
+            if (buffered) {
+                mp_jitter_push(&jitter, &messages[next], now);
+            }
+            else {
+                mp_body_sync_apply(&direct, &shown, &messages[next]);
+            }
+            next++;
+        }
+        if (buffered) {
+            mp_jitter_update(&jitter, &shown, now);
+
+            // What is shown from the server is the server's snake at that tick
+            if (jitter.showing && jitter.shown_tick == jitter.shown_sync_tick) {
+                assert_shows_tick(jitter.shown_tick);
+            }
+        }
+
+        if (shown.head_x == last_x && shown.head_y == last_y) {
+            continue;
+        }
+        uint32_t cells = (uint32_t)(abs(shown.head_x - last_x) + abs(shown.head_y - last_y)) / MP_DEVICE_TILE_SIZE;
+        if (moving) {
+            result.moves++;
+            result.uneven_ms += (uint32_t)abs((int32_t)(now - last_move_ms) - TICK_MS);
+            result.jumps += (cells > 1);
+            result.stalls += (now - last_move_ms > TICK_MS + TICK_MS / 2);
+        }
+        moving = true;
+        last_move_ms = now;
+        last_x = shown.head_x;
+        last_y = shown.head_y;
+
+        // Stops on the server's last tick, past it the buffer would move on without snapshots
+        if ((buffered ? jitter.shown_sync_tick : direct.tick) == TRACE_TICKS - 1) {
+            break;
+        }
+    }
+
+    assert_shows_tick(TRACE_TICKS - 1);
+    return result;
+}
+
+TEST_GROUP(MpSnakeJitter);
+
+TEST_SETUP(MpSnakeJitter) {
+    game_arena_reset();
+    entity_store_create();
+    snake_helper_init_snake(&shown, 0x40, 0x20, DPAD_DIR_RIGHT);
+    mp_jitter_init(&jitter, TICK_MS, MP_JITTER_DEFAULT_DELAY_MS);
+    mp_body_sync_init(&direct);
+    record_server();
+}
+
+TEST_TEAR_DOWN(MpSnakeJitter) {
+    game_arena_reset();
+}
+
+TEST(MpSnakeJitter, SteadyLinkMovesOncePerTick) {
+    Smoothness smooth = replay(steady_trace, true);
+
+    TEST_ASSERT_EQUAL_UINT32(0, smooth.stalls);
+    TEST_ASSERT_EQUAL_UINT32(0, smooth.jumps);
+    TEST_ASSERT_TRUE(smooth.uneven_ms / smooth.moves <= 2);
+    TEST_ASSERT_EQUAL_UINT32(0, jitter.extrapolated);
+    TEST_ASSERT_EQUAL_UINT32(0, jitter.late);
+    TEST_ASSERT_TRUE(jitter.delay_ms < MP_JITTER_DEFAULT_DELAY_MS + 20);
+}
+
+TEST(MpSnakeJitter, JitteryLinkIsSmoothedOut) {
+    Smoothness applied = replay(wifi_trace, false);
+
+    // Again through the buffer, from the first tick
+    snake_helper_init_snake(&shown, 0x40, 0x20, DPAD_DIR_RIGHT);
+    Smoothness smooth = replay(wifi_trace, true);
+
+    printf("\nMpSnakeJitter: wifi trace applied on arrival %lu ms off a tick per move, %lu stalls %lu jumps;"
+        " buffered %lu ms, %lu stalls %lu jumps (%lu extrapolated, %lu corrected), delay %lu ms at %lu ms jitter\n",
+        (unsigned long)(applied.uneven_ms / applied.moves), (unsigned long)applied.stalls, (unsigned long)applied.jumps,
+        (unsigned long)(smooth.uneven_ms / smooth.moves), (unsigned long)smooth.stalls, (unsigned long)smooth.jumps,
+        (unsigned long)jitter.extrapolated, (unsigned long)jitter.corrections,
+        (unsigned long)jitter.delay_ms, (unsigned long)mp_jitter_ms(&jitter));
+
+    TEST_ASSERT_TRUE(smooth.uneven_ms < applied.uneven_ms / 4);
+    TEST_ASSERT_TRUE(smooth.stalls + smooth.jumps < applied.stalls + applied.jumps);
+    TEST_ASSERT_TRUE(jitter.delay_ms > MP_JITTER_DEFAULT_DELAY_MS);
+    TEST_ASSERT_TRUE(jitter.delay_ms <= MP_JITTER_MAX_DELAY_MS);
+    TEST_ASSERT_EQUAL_UINT32(0, jitter.dropped);
+}
+
+TEST(MpSnakeJitter, GapIsExtrapolatedThenCorrected) {
+    uint32_t now = 0;
+
+    // On time up to tick 15, heading left with the turn up at tick 17
+    for (uint32_t tick = 0; tick <= 15; tick++) {
+        now = tick * TICK_MS;
+        mp_jitter_push(&jitter, &messages[tick], now);
+        mp_jitter_update(&jitter, &shown, now);
+    }
+
+    // Ticks 16 and 17 are held up - the snake moves on left for two ticks, then waits
+    uint32_t due_17 = 17 * TICK_MS + MP_JITTER_DEFAULT_DELAY_MS;
+    for (now += FRAME_MS; now <= due_17 + 2 * TICK_MS; now += FRAME_MS) {
+        mp_jitter_update(&jitter, &shown, now);
+    }
+    TEST_ASSERT_EQUAL_UINT32(MP_JITTER_MAX_EXTRAPOLATION, jitter.extrapolated);
+    TEST_ASSERT_EQUAL(heads_x[15] * MP_DEVICE_TILE_SIZE - MP_JITTER_MAX_EXTRAPOLATION * SPRITE_SIZE, shown.head_x);
+    TEST_ASSERT_EQUAL(heads_y[15] * MP_DEVICE_TILE_SIZE, shown.head_y);
+
+    // They land with the two after, the snake is put back on the server's path
+    for (uint32_t tick = 16; tick <= 19; tick++) {
+        mp_jitter_push(&jitter, &messages[tick], now);
+    }
+    TEST_ASSERT_TRUE(mp_jitter_update(&jitter, &shown, now));
+    TEST_ASSERT_TRUE(jitter.late >= 2);
+    TEST_ASSERT_EQUAL_UINT32(1, jitter.corrections);
+    TEST_ASSERT_EQUAL_UINT32(jitter.shown_sync_tick, jitter.shown_tick);
+    TEST_ASSERT_TRUE(jitter.shown_tick >= 17);
+    assert_shows_tick(jitter.shown_tick);
+}
+
+TEST(MpSnakeJitter, DeltaOfSeveralMovesIsShownATickApart) {
+    uart_body_sync_t delta = messages[4];
+
+    // The ESP32 sent nothing for ticks 1 to 3, its tick 4 delta carries all four moves
+    delta.move_count = 4;
+    delta.codes[0] = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        delta.codes[0] |= (uint8_t)(body_sync_code(messages[1 + i].codes, 0) << (2 * i));
+    }
+
+    mp_jitter_push(&jitter, &messages[0], 0);
+    mp_jitter_push(&jitter, &delta, 4 * TICK_MS);
+    TEST_ASSERT_EQUAL_UINT8(5, jitter.count);
+
+    for (uint32_t tick = 1; tick <= 4; tick++) {
+        TEST_ASSERT_TRUE(mp_jitter_update(&jitter, &shown, tick * TICK_MS + MP_JITTER_DEFAULT_DELAY_MS));
+        TEST_ASSERT_EQUAL_UINT32(tick, jitter.shown_sync_tick);
+        assert_shows_tick(tick);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, jitter.sync.gaps);
+}
+
+TEST_GROUP_RUNNER(MpSnakeJitter) {
+    RUN_TEST_CASE(MpSnakeJitter, SteadyLinkMovesOncePerTick);
+    RUN_TEST_CASE(MpSnakeJitter, JitteryLinkIsSmoothedOut);
+    RUN_TEST_CASE(MpSnakeJitter, GapIsExtrapolatedThenCorrected);
+    RUN_TEST_CASE(MpSnakeJitter, DeltaOfSeveralMovesIsShownATickApart);
+}
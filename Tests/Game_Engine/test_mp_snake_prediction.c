@@ -0,0 +1,264 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "Game_Engine/Games/Multi_Player/Snake_Game/mp_snake_game_prediction.h"
+#include "Game_Engine/game_engine_arena.h"
+#include <stdio.h>
+
+#define START_X         64
+#define START_Y         40
+#define SNAKE_LENGTH    4
+#define MAX_IN_FLIGHT   32
+
+// Server stand-in - runs the same movement one tick per step, sees inputs and is seen
+// `latency` steps late
+typedef struct {
+    uint32_t arrival;
+    uint16_t sequence;
+    uint8_t direction;
+} InputInFlight;
+
+typedef struct {
+    uint32_t arrival;
+    PredictionServerState state;
+} StateInFlight;
+
+static SnakeState client;
+static SnakeState server;
+static SnakePrediction prediction;
+
+static uint32_t now;        // Steps of the wall clock
+static uint32_t latency;
+static uint32_t server_tick;
+static uint16_t server_ack;
+
+static InputInFlight inputs[MAX_IN_FLIGHT];
+static uint8_t input_count;
+static StateInFlight states[MAX_IN_FLIGHT];
+static uint8_t state_count;
+static uint32_t echo_arrival;       // When the server's state first showed the last press
+
+static void init_snake(SnakeState* snake) {
+    snake_helper_init_snake(snake, START_X, START_Y, DPAD_DIR_RIGHT);
+    snake->length = SNAKE_LENGTH;
+}
+
+static void press(uint8_t direction) {
+    uint16_t sequence = mp_prediction_apply_input(&prediction, &client, direction);
+
+    TEST_ASSERT_NOT_EQUAL(0, sequence);
+    TEST_ASSERT_TRUE(input_count < MAX_IN_FLIGHT);
+    inputs[input_count++] = (InputInFlight){ now + latency, sequence, direction };
+    echo_arrival = 0;
+}
+
+static void deliver_states(void) {
+    uint8_t kept = 0;
+
+    for (uint8_t i = 0; i < state_count; i++) {
+        if (states[i].arrival <= now) {
+            if (echo_arrival == 0 && states[i].state.direction == client.direction) {
+                echo_arrival = now;
+            }
+            mp_prediction_reconcile(&prediction, &client, &states[i].state);
+        }
+        else {
+            states[kept++] = states[i];
+        }
+    }
+    state_count = kept;
+}
+
+// The server applies what has arrived, moves and sends its state
+static void server_step(void) {
+    uint8_t kept = 0;
+
+    for (uint8_t i = 0; i < input_count; i++) {
+        if (inputs[i].arrival <= now) {
+            snake_helper_apply_direction_change(&server, inputs[i].direction);
+            server_ack = inputs[i].sequence;
+        }
+        else {
+            inputs[kept++] = inputs[i];
+        }
+    }
+    input_count = kept;
+
+    snake_helper_move_snake(&server);
+    server_tick++;
+
+    TEST_ASSERT_TRUE(state_count < MAX_IN_FLIGHT);
+    states[state_count++] = (StateInFlight){ now + latency, {
+        .tick = server_tick,
+        .head_x = server.head_x,
+        .head_y = server.head_y,
+        .direction = server.direction,
+        .length = server.length,
+        .input_ack = server_ack
+    } };
+}
+
+// One step of the wall clock, press 0 for none
+static void run_step(uint8_t direction) {
+    deliver_states();
+    if (direction != 0) {
+        press(direction);
+    }
+    mp_prediction_step(&prediction, &client);
+    server_step();
+    now++;
+}
+
+// Lets everything in flight land, the client runs `lead` ticks ahead of the server
+static void settle(uint32_t lead) {
+    for (uint32_t i = 0; i < 2 * latency + 1; i++) {
+        run_step(0);
+    }
+    for (uint32_t i = 0; i < lead; i++) {
+        snake_helper_move_snake(&server);
+        server_tick++;
+    }
+}
+
+static void assert_converged(void) {
+    TEST_ASSERT_EQUAL_UINT8(0, mp_prediction_pending_inputs(&prediction));
+    TEST_ASSERT_EQUAL_UINT32(server_tick, prediction.tick);
+    TEST_ASSERT_EQUAL(server.head_x, client.head_x);
+    TEST_ASSERT_EQUAL(server.head_y, client.head_y);
+    TEST_ASSERT_EQUAL_UINT8(server.direction, client.direction);
+    TEST_ASSERT_EQUAL_MEMORY(snake_body_x(&server), snake_body_x(&client), client.length * sizeof(coord_t));
+    TEST_ASSERT_EQUAL_MEMORY(snake_body_y(&server), snake_body_y(&client), client.length * sizeof(coord_t));
+}
+
+// A route around the screen, a turn every few steps
+static uint8_t route(uint32_t step) {
+    static const uint8_t turns[] = { DPAD_DIR_DOWN, DPAD_DIR_LEFT, DPAD_DIR_UP, DPAD_DIR_RIGHT };
+    return (step % 5 == 2) ? turns[(step / 5) % 4] : 0;
+}
+
+// Starts the client `lead` ticks ahead, the server's tick 0 is its start
+static void start(uint32_t link_latency, uint32_t lead) {
+    latency = link_latency;
+    for (uint32_t i = 0; i < lead; i++) {
+        mp_prediction_step(&prediction, &client);
+    }
+}
+
+TEST_GROUP(MpSnakePrediction);
+
+TEST_SETUP(MpSnakePrediction) {
+    // Both snakes' bodies in the arena like the game's
+    game_arena_reset();
+    entity_store_create();
+    init_snake(&client);
+    init_snake(&server);
+    mp_prediction_init(&prediction, &client, 0);
+
+    now = 0;
+    server_tick = 0;
+    server_ack = 0;
+    input_count = 0;
+    state_count = 0;
+    echo_arrival = 0;
+}
+
+TEST_TEAR_DOWN(MpSnakePrediction) {
+    game_arena_reset();
+}
+
+TEST(MpSnakePrediction, TurnShowsOnTheNextMove) {
+    const uint32_t link = 3;
+
+    start(link, link);
+    run_step(DPAD_DIR_DOWN);
+    TEST_ASSERT_EQUAL(START_X + link * SPRITE_SIZE, client.head_x);
+    TEST_ASSERT_EQUAL(START_Y + SPRITE_SIZE, client.head_y);
+
+    // Without prediction the turn was drawn once the server's state came back with it
+    uint32_t pressed = now - 1;
+    while (echo_arrival == 0) {
+        run_step(0);
+    }
+    printf("\nMpSnakePrediction: input to screen 1 step, was %lu with %lu steps each way\n",
+        (unsigned long)(echo_arrival - pressed + 1), (unsigned long)link);
+    TEST_ASSERT_TRUE(echo_arrival - pressed + 1 > 2 * link);
+    TEST_ASSERT_EQUAL_UINT32(0, prediction.rollbacks);
+}
+
+TEST(MpSnakePrediction, InputsThatArriveInTimeNeedNoCorrection) {
+    start(3, 3);
+    for (uint32_t i = 0; i < 120; i++) {
+        run_step(route(i));
+    }
+    settle(3);
+
+    // The server's moves are the ones the client already showed
+    TEST_ASSERT_EQUAL_UINT32(0, prediction.rollbacks);
+    TEST_ASSERT_EQUAL_UINT32(0, prediction.snaps);
+    assert_converged();
+}
+
+TEST(MpSnakePrediction, LateInputsAreRolledBackAndReplayed) {
+    // Not ahead - every input reaches the server some moves after the client made the turn
+    start(2, 0);
+    for (uint32_t i = 0; i < 120; i++) {
+        run_step(route(i));
+    }
+    TEST_ASSERT_TRUE(prediction.rollbacks > 0);
+    TEST_ASSERT_TRUE(prediction.replayed_ticks >= prediction.rollbacks);
+    TEST_ASSERT_EQUAL_UINT32(0, prediction.snaps);
+
+    settle(0);
+    assert_converged();
+    printf("MpSnakePrediction: 24 late turns, %lu rollbacks replaying %lu moves\n",
+        (unsigned long)prediction.rollbacks, (unsigned long)prediction.replayed_ticks);
+}
+
+TEST(MpSnakePrediction, ServerStateOutsideTheWindowIsTaken) {
+    PredictionServerState ahead = {
+        .tick = 40, .head_x = 24, .head_y = 48, .direction = DPAD_DIR_UP,
+        .length = SNAKE_LENGTH + 1, .input_ack = 0
+    };
+
+    mp_prediction_apply_input(&prediction, &client, DPAD_DIR_DOWN);
+    TEST_ASSERT_TRUE(mp_prediction_reconcile(&prediction, &client, &ahead));
+    TEST_ASSERT_EQUAL_UINT32(1, prediction.snaps);
+    TEST_ASSERT_EQUAL_UINT32(40, prediction.tick);
+    TEST_ASSERT_EQUAL(24, client.head_x);
+    TEST_ASSERT_EQUAL_UINT8(SNAKE_LENGTH + 1, client.length);
+
+    // The unacknowledged turn is still the player's, DOWN after UP is not
+    TEST_ASSERT_EQUAL_UINT8(DPAD_DIR_UP, client.direction);
+    TEST_ASSERT_EQUAL_UINT8(1, mp_prediction_pending_inputs(&prediction));
+
+    // A state that agrees changes nothing
+    mp_prediction_step(&prediction, &client);
+    PredictionServerState agreed = {
+        .tick = 41, .head_x = client.head_x, .head_y = client.head_y, .direction = client.direction,
+        .length = client.length, .input_ack = 1
+    };
+    TEST_ASSERT_FALSE(mp_prediction_reconcile(&prediction, &client, &agreed));
+    TEST_ASSERT_EQUAL_UINT8(0, mp_prediction_pending_inputs(&prediction));
+}
+
+TEST(MpSnakePrediction, TwoPressesInOneMoveCannotReverse) {
+    // UP then LEFT while moving RIGHT would put the head back on the body
+    TEST_ASSERT_NOT_EQUAL(0, mp_prediction_apply_input(&prediction, &client, DPAD_DIR_UP));
+    TEST_ASSERT_EQUAL(0, mp_prediction_apply_input(&prediction, &client, DPAD_DIR_LEFT));
+    TEST_ASSERT_NOT_EQUAL(0, mp_prediction_apply_input(&prediction, &client, DPAD_DIR_DOWN));
+    TEST_ASSERT_EQUAL_UINT8(DPAD_DIR_DOWN, client.direction);
+
+    // A full history drops the oldest
+    for (uint8_t i = 0; i < MP_PREDICTION_INPUTS; i++) {
+        mp_prediction_apply_input(&prediction, &client, (i % 2) ? DPAD_DIR_DOWN : DPAD_DIR_UP);
+    }
+    TEST_ASSERT_EQUAL_UINT8(MP_PREDICTION_INPUTS, mp_prediction_pending_inputs(&prediction));
+    TEST_ASSERT_EQUAL_UINT32(2, prediction.inputs_dropped);
+}
+
+TEST_GROUP_RUNNER(MpSnakePrediction) {
+    RUN_TEST_CASE(MpSnakePrediction, TurnShowsOnTheNextMove);
+    RUN_TEST_CASE(MpSnakePrediction, InputsThatArriveInTimeNeedNoCorrection);
+    RUN_TEST_CASE(MpSnakePrediction, LateInputsAreRolledBackAndReplayed);
+    RUN_TEST_CASE(MpSnakePrediction, ServerStateOutsideTheWindowIsTaken);
+    RUN_TEST_CASE(MpSnakePrediction, TwoPressesInOneMoveCannotReverse);
+}
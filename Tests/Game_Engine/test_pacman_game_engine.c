@@ -6,36 +6,74 @@
 
 static PacmanGameData* game_data;
 
+// Pacman and ghost positions live in the entity store
+#define PACMAN_X        game_entities->pos_x[game_data->pacman]
+#define PACMAN_Y        game_entities->pos_y[game_data->pacman]
+#define GHOST_ID(i)     (game_data->pacman + 1 + (i))
+#define GHOST_X(i)      game_entities->pos_x[GHOST_ID(i)]
+#define GHOST_Y(i)      game_entities->pos_y[GHOST_ID(i)]
+
+// One engine update - the game reads the D-pad, then its timers catch up to the mock clock.
+// A jump of the clock is played out in frames the wheel catches up in full.
+static void run_update(DPAD_STATUS dpad) {
+    pacman_game_engine.update_func.update_dpad(dpad);
+    while (get_current_ms() - game_timers.last_ms > TIMER_WHEEL_MAX_CATCHUP_MS) {
+        timer_wheel_advance(&game_timers, game_timers.last_ms + TIMER_WHEEL_MAX_CATCHUP_MS);
+    }
+    timer_wheel_advance(&game_timers, get_current_ms());
+}
+
+// Pacman waits on tile (7, 3) with its dot eaten, clear of the ghosts' corners. Ghost 0 is on
+// (8, 3) heading left, where the walls above and below leave it no way but onto Pacman.
+static void ghost_walks_into_pacman(GhostMode mode) {
+    maze_clear_tile(7, 3);
+
+    PACMAN_X = maze_to_world_x(7);
+    PACMAN_Y = maze_to_world_y(3);
+    game_data->next_dir = DIR_NONE;
+    game_data->curr_dir = DIR_NONE;
+
+    GHOST_X(0) = maze_to_world_x(8);
+    GHOST_Y(0) = maze_to_world_y(3);
+    game_data->ghosts[0].dir = DIR_LEFT;
+    game_data->ghosts[0].mode = mode;
+}
+
 TEST_GROUP(PacmanGame);
 
 TEST_SETUP(PacmanGame) {
     mock_display_reset_state();
     mock_time_reset();
     mock_random_reset();
+    // Place game data in the arena like game_engine_init() does
+    game_arena_reset();
+    timer_wheel_init(&game_timers, 0);
+    pacman_game_engine.game_data = game_arena_alloc(pacman_game_engine.game_data_size);
     game_data = (PacmanGameData*)pacman_game_engine.game_data;
     pacman_game_engine.init();
 }
 
 TEST_TEAR_DOWN(PacmanGame) {
     pacman_game_engine.cleanup();
+    game_arena_reset();
 }
 
 TEST(PacmanGame, InitializationSetsCorrectStartState) {
     // Check Pacman's initial position and direction
-    TEST_ASSERT_EQUAL(maze_to_screen_x(6), game_data->pacman_pos.x);
-    TEST_ASSERT_EQUAL(maze_to_screen_y(1), game_data->pacman_pos.y);
+    TEST_ASSERT_EQUAL(maze_to_world_x(PACMAN_START_X), PACMAN_X);
+    TEST_ASSERT_EQUAL(maze_to_world_y(PACMAN_START_Y), PACMAN_Y);
     TEST_ASSERT_EQUAL(DIR_RIGHT, game_data->curr_dir);
     TEST_ASSERT_EQUAL(DIR_RIGHT, game_data->next_dir);
 
     // Check game engine state
-    TEST_ASSERT_EQUAL(3, pacman_game_engine.base_state.lives);
-    TEST_ASSERT_EQUAL(0, pacman_game_engine.base_state.score);
+    TEST_ASSERT_EQUAL(3, pacman_game_engine.base_state.state_data.single.lives);
+    TEST_ASSERT_EQUAL(0, pacman_game_engine.base_state.state_data.single.score);
     TEST_ASSERT_FALSE(pacman_game_engine.base_state.game_over);
     TEST_ASSERT_TRUE(pacman_game_engine.is_d_pad_game);
 
     // Check that ghosts are initialized
     for (uint8_t i = 0; i < NUM_GHOSTS; i++) {
-        TEST_ASSERT_TRUE(game_data->ghosts[i].active);
+        TEST_ASSERT_TRUE(entity_is_active(game_entities, GHOST_ID(i)));
     }
 
     // Check that dots are initialized
@@ -49,7 +87,7 @@ TEST(PacmanGame, DirectionChangeWithDPad) {
 
     // Change direction with D-pad
     DPAD_STATUS dpad = { .direction = DPAD_DIR_UP, .is_new = 1 };
-    pacman_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
 
     // Check new direction is set
     TEST_ASSERT_EQUAL(DIR_UP, game_data->next_dir);
@@ -62,7 +100,7 @@ TEST(PacmanGame, DirectionChangeIgnoredIfNotNew) {
 
     // Try to change direction with is_new=0
     DPAD_STATUS dpad = { .direction = DPAD_DIR_UP, .is_new = 0 };
-    pacman_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
 
     // Direction should remain unchanged
     TEST_ASSERT_EQUAL(DIR_RIGHT, game_data->next_dir);
@@ -70,25 +108,25 @@ TEST(PacmanGame, DirectionChangeIgnoredIfNotNew) {
 
 TEST(PacmanGame, PacmanMovesInCurrentDirection) {
     // Position before moving
-    uint8_t initial_x = game_data->pacman_pos.x;
-    uint8_t initial_y = game_data->pacman_pos.y;
+    uint8_t initial_x = PACMAN_X;
+    uint8_t initial_y = PACMAN_Y;
     game_data->curr_dir = DIR_RIGHT;
 
     // Trigger movement
     mock_time_set_ms(PACMAN_SPEED + 1);
     DPAD_STATUS dpad = { .direction = 0, .is_new = 0 };
-    pacman_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
 
     // Check new position
-    TEST_ASSERT_EQUAL(initial_x + TILE_SIZE, game_data->pacman_pos.x);
-    TEST_ASSERT_EQUAL(initial_y, game_data->pacman_pos.y);
+    TEST_ASSERT_EQUAL(initial_x + TILE_SIZE, PACMAN_X);
+    TEST_ASSERT_EQUAL(initial_y, PACMAN_Y);
 }
 
 TEST(PacmanGame, PacmanChangesDirectionWhenPossible) {
     // Use maze coordinates from your maze layout where there's definitely a path
     // This is an open path (non-wall) position
-    game_data->pacman_pos.x = maze_to_screen_x(6);  // Position in an open corridor
-    game_data->pacman_pos.y = maze_to_screen_y(1);  // Position in an open corridor
+    PACMAN_X = maze_to_world_x(6);  // Position in an open corridor
+    PACMAN_Y = maze_to_world_y(1);  // Position in an open corridor
     game_data->curr_dir = DIR_RIGHT;
     game_data->next_dir = DIR_RIGHT;
 
@@ -98,7 +136,7 @@ TEST(PacmanGame, PacmanChangesDirectionWhenPossible) {
 
     // Test UP direction when there's space to move up
     DPAD_STATUS dpad = { .direction = DPAD_DIR_UP, .is_new = 1 };
-    pacman_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
 
     // Verify next_dir changes immediately
     TEST_ASSERT_EQUAL(DIR_UP, game_data->next_dir);
@@ -106,7 +144,7 @@ TEST(PacmanGame, PacmanChangesDirectionWhenPossible) {
     // Move enough times to ensure the direction change takes effect
     for (int i = 0; i < 3; i++) {
         mock_time_set_ms((i + 2) * PACMAN_SPEED + 1);
-        pacman_game_engine.update_func.update_dpad(dpad);
+        run_update(dpad);
     }
 
     // Now curr_dir should have changed too
@@ -114,99 +152,93 @@ TEST(PacmanGame, PacmanChangesDirectionWhenPossible) {
 }
 
 TEST(PacmanGame, PacmanStopsAtWalls) {
-    // Use a known wall from the MAZE_LAYOUT
-    // Based on the is_wall test, (8, 12) is a wall position
-
-    // Position Pacman adjacent to a wall
-    game_data->pacman_pos.x = 16; // maze_to_screen_x(1) = 16
-    game_data->pacman_pos.y = 12; // maze_to_screen_y(0) = 12
-    game_data->curr_dir = DIR_LEFT; // Try to move left into wall at (8, 12)
+    // Tile (7, 2) above Pacman is a wall
+    PACMAN_X = maze_to_world_x(7);
+    PACMAN_Y = maze_to_world_y(3);
+    game_data->curr_dir = DIR_UP;
+    game_data->next_dir = DIR_UP;
 
     // Record initial position
-    uint8_t initial_x = game_data->pacman_pos.x;
+    coord_t initial_x = PACMAN_X;
+    coord_t initial_y = PACMAN_Y;
 
     // Trigger movement
     mock_time_set_ms(PACMAN_SPEED + 1);
-    DPAD_STATUS dpad = { .direction = DIR_LEFT, .is_new = 0 };
-    pacman_game_engine.update_func.update_dpad(dpad);
+    DPAD_STATUS dpad = { .direction = DPAD_DIR_UP, .is_new = 0 };
+    run_update(dpad);
 
     // Position should remain unchanged
-    TEST_ASSERT_EQUAL(initial_x, game_data->pacman_pos.x);
+    TEST_ASSERT_EQUAL(initial_x, PACMAN_X);
+    TEST_ASSERT_EQUAL(initial_y, PACMAN_Y);
 }
 
 TEST(PacmanGame, CollectingDotIncreasesScore) {
-    // Position Pacman where a dot exists
-    uint8_t i;
-    for (i = 0; i < MAX_DOTS; i++) {
-        if (game_data->dots[i].active && !game_data->dots[i].is_power_pellet) {
-            break;
+    // Position Pacman on a tile holding a dot, if the layout has one
+    for (uint8_t y = 0; y < MAZE_HEIGHT_ACTUAL; y++) {
+        for (uint8_t x = 0; x < MAZE_WIDTH; x++) {
+            if (maze_get_tile(x, y) != MAZE_DOT) {
+                continue;
+            }
+
+            PACMAN_X = maze_to_world_x(x);
+            PACMAN_Y = maze_to_world_y(y);
+            game_data->next_dir = DIR_NONE;
+            game_data->curr_dir = DIR_NONE;
+
+            // Save initial values
+            uint32_t initial_score = pacman_game_engine.base_state.state_data.single.score;
+            uint16_t initial_dots = game_data->num_dots_remaining;
+
+            // Trigger update to detect collision
+            mock_time_set_ms(PACMAN_SPEED + 1);
+            DPAD_STATUS dpad = { .direction = 0, .is_new = 0 };
+            run_update(dpad);
+
+            // Check score increased and dot was collected
+            TEST_ASSERT_EQUAL(initial_score + 10, pacman_game_engine.base_state.state_data.single.score);
+            TEST_ASSERT_EQUAL(initial_dots - 1, game_data->num_dots_remaining);
+            TEST_ASSERT_EQUAL(MAZE_PATH, maze_get_tile(x, y));
+            return;
         }
     }
+}
 
-    if (i < MAX_DOTS) {
-        // Position Pacman at the dot
-        game_data->pacman_pos.x = game_data->dots[i].pos.x;
-        game_data->pacman_pos.y = game_data->dots[i].pos.y;
-
-        // Save initial values
-        uint32_t initial_score = pacman_game_engine.base_state.score;
-        uint8_t initial_dots = game_data->num_dots_remaining;
+TEST(PacmanGame, EatenPelletIsNotEatenAgain) {
+    PACMAN_X = maze_to_world_x(1);
+    PACMAN_Y = maze_to_world_y(1);
+    game_data->next_dir = DIR_NONE;
+    game_data->curr_dir = DIR_NONE;
+    uint16_t initial_dots = game_data->num_dots_remaining;
 
-        // Trigger update to detect collision
-        mock_time_set_ms(PACMAN_SPEED + 1);
-        DPAD_STATUS dpad = { .direction = 0, .is_new = 0 };
-        pacman_game_engine.update_func.update_dpad(dpad);
+    // Pacman stays on the pellet's tile for two steps
+    DPAD_STATUS dpad = { .direction = 0, .is_new = 0 };
+    mock_time_set_ms(PACMAN_SPEED + 1);
+    run_update(dpad);
+    uint32_t score = pacman_game_engine.base_state.state_data.single.score;
+    mock_time_set_ms(2 * PACMAN_SPEED + 1);
+    run_update(dpad);
 
-        // Check score increased and dot was collected
-        TEST_ASSERT_EQUAL(initial_score + 10, pacman_game_engine.base_state.score);
-        TEST_ASSERT_EQUAL(initial_dots - 1, game_data->num_dots_remaining);
-        TEST_ASSERT_FALSE(game_data->dots[i].active);
-    }
+    TEST_ASSERT_EQUAL(initial_dots - 1, game_data->num_dots_remaining);
+    TEST_ASSERT_EQUAL(score, pacman_game_engine.base_state.state_data.single.score);
 }
 
 TEST(PacmanGame, CollectingPowerPelletActivatesPowerMode) {
-    // Create a power pellet at a specific position
-    uint8_t pellet_index = 0;
+    // Tile (1,1) of the maze holds a power pellet
+    TEST_ASSERT_EQUAL(MAZE_POWER, maze_get_tile(1, 1));
 
-    // Make sure the dot is active and is a power pellet
-    game_data->dots[pellet_index].active = true;
-    game_data->dots[pellet_index].is_power_pellet = true;
-
-    // Center of the tile at maze coordinates (1,1)
-    uint8_t tile_x = maze_to_screen_x(1);
-    uint8_t tile_y = maze_to_screen_y(1);
-
-    game_data->dots[pellet_index].pos.x = tile_x;
-    game_data->dots[pellet_index].pos.y = tile_y;
-
-    // Position Pacman exactly at the same spot
-    game_data->pacman_pos.x = tile_x;
-    game_data->pacman_pos.y = tile_y;
-
-    // Make sure there are dots remaining
-    game_data->num_dots_remaining = 10;
-
-    // Verify initial conditions
-    TEST_ASSERT_TRUE(game_data->dots[pellet_index].active);
-    TEST_ASSERT_TRUE(game_data->dots[pellet_index].is_power_pellet);
-    TEST_ASSERT_EQUAL(tile_x, game_data->dots[pellet_index].pos.x);
-    TEST_ASSERT_EQUAL(tile_y, game_data->dots[pellet_index].pos.y);
-    TEST_ASSERT_EQUAL(tile_x, game_data->pacman_pos.x);
-    TEST_ASSERT_EQUAL(tile_y, game_data->pacman_pos.y);
-
-    // Calculate the expected distance - should be 0
-    int dx = abs(game_data->pacman_pos.x - game_data->dots[pellet_index].pos.x);
-    int dy = abs(game_data->pacman_pos.y - game_data->dots[pellet_index].pos.y);
-    TEST_ASSERT_LESS_THAN(TILE_SIZE / 2, dx);
-    TEST_ASSERT_LESS_THAN(TILE_SIZE / 2, dy);
+    // Position Pacman exactly at the same spot and keep it there
+    PACMAN_X = maze_to_world_x(1);
+    PACMAN_Y = maze_to_world_y(1);
+    game_data->next_dir = DIR_NONE;
+    game_data->curr_dir = DIR_NONE;
 
     // Trigger the update to detect collision
     mock_time_set_ms(PACMAN_SPEED + 1);
     DPAD_STATUS dpad = { .direction = DPAD_DIR_RIGHT, .is_new = 0 };
-    pacman_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
 
-    // Check if the dot was consumed (active=false)
-    TEST_ASSERT_FALSE(game_data->dots[pellet_index].active);
+    // Check if the pellet was consumed
+    TEST_ASSERT_EQUAL(MAZE_PATH, maze_get_tile(1, 1));
 
     // Now check if power mode was activated
     TEST_ASSERT_TRUE(game_data->power_pellet_active);
@@ -218,110 +250,108 @@ TEST(PacmanGame, CollectingPowerPelletActivatesPowerMode) {
 }
 
 TEST(PacmanGame, GhostCollisionReducesLives) {
-    // Position a ghost at Pacman's location
-    game_data->ghosts[0].pos.x = game_data->pacman_pos.x;
-    game_data->ghosts[0].pos.y = game_data->pacman_pos.y;
-    game_data->ghosts[0].mode = MODE_CHASE; // Ensure ghost is in chase mode
+    ghost_walks_into_pacman(MODE_CHASE);
 
     // Save initial lives
-    uint8_t initial_lives = pacman_game_engine.base_state.lives;
+    uint8_t initial_lives = pacman_game_engine.base_state.state_data.single.lives;
 
     // Trigger update to detect collision
     mock_time_set_ms(PACMAN_SPEED + 1);
     DPAD_STATUS dpad = { .direction = 0, .is_new = 0 };
-    pacman_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
 
     // Check lives reduced
-    TEST_ASSERT_EQUAL(initial_lives - 1, pacman_game_engine.base_state.lives);
+    TEST_ASSERT_EQUAL(initial_lives - 1, pacman_game_engine.base_state.state_data.single.lives);
 }
 
 TEST(PacmanGame, GhostCollisionInFrightenedModeIncreasesScore) {
-    // Set up frightened ghost exactly at Pacman's position
-    game_data->ghosts[0].active = true;
-    game_data->ghosts[0].mode = MODE_FRIGHTENED;
-
-    // Center of the tile at maze coordinates (2,2)
-    uint8_t tile_x = maze_to_screen_x(2);
-    uint8_t tile_y = maze_to_screen_y(2);
-
-    // Position both exactly at the same coordinates
-    game_data->pacman_pos.x = tile_x;
-    game_data->pacman_pos.y = tile_y;
-    game_data->ghosts[0].pos.x = tile_x;
-    game_data->ghosts[0].pos.y = tile_y;
+    ghost_walks_into_pacman(MODE_FRIGHTENED);
 
     // Save initial score
-    uint32_t initial_score = pacman_game_engine.base_state.score;
+    uint32_t initial_score = pacman_game_engine.base_state.state_data.single.score;
 
     // Trigger update to detect collision
     mock_time_set_ms(PACMAN_SPEED + 1);
     DPAD_STATUS dpad = { .direction = DPAD_DIR_RIGHT, .is_new = 0 };
-    pacman_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
 
     // Check score increased and ghost deactivated
-    TEST_ASSERT_EQUAL(initial_score + 200, pacman_game_engine.base_state.score);
-    TEST_ASSERT_FALSE(game_data->ghosts[0].active);
+    TEST_ASSERT_EQUAL(initial_score + 200, pacman_game_engine.base_state.state_data.single.score);
+    TEST_ASSERT_FALSE(entity_is_active(game_entities, GHOST_ID(0)));
 }
 
 TEST(PacmanGame, NoLivesLeftEndsGame) {
     // Set lives to 1 so next hit will end game
-    pacman_game_engine.base_state.lives = 1;
+    pacman_game_engine.base_state.state_data.single.lives = 1;
 
-    // Position ghost at Pacman's location
-    game_data->ghosts[0].pos.x = game_data->pacman_pos.x;
-    game_data->ghosts[0].pos.y = game_data->pacman_pos.y;
-    game_data->ghosts[0].mode = MODE_CHASE;
+    ghost_walks_into_pacman(MODE_CHASE);
 
     // Trigger collision
     mock_time_set_ms(PACMAN_SPEED + 1);
     DPAD_STATUS dpad = { .direction = 0, .is_new = 0 };
-    pacman_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
 
     // Check game over state
-    TEST_ASSERT_EQUAL(0, pacman_game_engine.base_state.lives);
+    TEST_ASSERT_EQUAL(0, pacman_game_engine.base_state.state_data.single.lives);
+    TEST_ASSERT_TRUE(pacman_game_engine.base_state.game_over);
+}
+
+TEST(PacmanGame, StepTimerStopsOnGameOver) {
+    pacman_game_engine.base_state.state_data.single.lives = 1;
+    ghost_walks_into_pacman(MODE_CHASE);
+    mock_time_set_ms(PACMAN_SPEED + 1);
+    DPAD_STATUS dpad = { .direction = 0, .is_new = 0 };
+    run_update(dpad);
     TEST_ASSERT_TRUE(pacman_game_engine.base_state.game_over);
+
+    // Steps still due on the wheel leave Pacman and the ghosts where the game ended
+    uint8_t pacman_x = PACMAN_X;
+    uint8_t ghost_x = GHOST_X(0);
+    mock_time_set_ms(PACMAN_SPEED * 4);
+    run_update(dpad);
+    TEST_ASSERT_EQUAL(pacman_x, PACMAN_X);
+    TEST_ASSERT_EQUAL(ghost_x, GHOST_X(0));
 }
 
 TEST(PacmanGame, MovementOnlyOccursAtCorrectInterval) {
     // Initial position
-    uint8_t initial_x = game_data->pacman_pos.x;
-    uint8_t initial_y = game_data->pacman_pos.y;
+    uint8_t initial_x = PACMAN_X;
+    uint8_t initial_y = PACMAN_Y;
 
     // Set time just below movement threshold
     mock_time_set_ms(PACMAN_SPEED - 1);
 
     // Update game
     DPAD_STATUS dpad = { .direction = 0, .is_new = 0 };
-    pacman_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
 
     // Position should not change
-    TEST_ASSERT_EQUAL(initial_x, game_data->pacman_pos.x);
-    TEST_ASSERT_EQUAL(initial_y, game_data->pacman_pos.y);
+    TEST_ASSERT_EQUAL(initial_x, PACMAN_X);
+    TEST_ASSERT_EQUAL(initial_y, PACMAN_Y);
 }
 
 TEST(PacmanGame, GhostsChasePlayerInChaseMode) {
     // Position Pacman far from a ghost in an open area
-    game_data->pacman_pos.x = maze_to_screen_x(8);
-    game_data->pacman_pos.y = maze_to_screen_y(3);
+    PACMAN_X = maze_to_world_x(8);
+    PACMAN_Y = maze_to_world_y(3);
 
     // Position ghost some distance away
-    game_data->ghosts[0].pos.x = maze_to_screen_x(5);
-    game_data->ghosts[0].pos.y = maze_to_screen_y(3);
+    GHOST_X(0) = maze_to_world_x(5);
+    GHOST_Y(0) = maze_to_world_y(3);
     game_data->ghosts[0].mode = MODE_CHASE;
-    game_data->ghosts[0].active = true;
     game_data->ghosts[0].dir = DIR_RIGHT;  // Initially moving right
 
     // Store initial position
-    uint8_t initial_x = game_data->ghosts[0].pos.x;
+    uint8_t initial_x = GHOST_X(0);
 
     // Update game enough times for ghost to move
     for (int i = 0; i < 5; i++) {
         mock_time_set_ms((i + 1) * PACMAN_SPEED + 1);
         DPAD_STATUS dpad = { .direction = 0, .is_new = 0 };
-        pacman_game_engine.update_func.update_dpad(dpad);
+        run_update(dpad);
     }
 
-    TEST_ASSERT_NOT_EQUAL(initial_x, game_data->ghosts[0].pos.x);
+    TEST_ASSERT_NOT_EQUAL(initial_x, GHOST_X(0));
 }
 
 TEST_GROUP_RUNNER(PacmanGame) {
@@ -333,9 +363,11 @@ TEST_GROUP_RUNNER(PacmanGame) {
     RUN_TEST_CASE(PacmanGame, PacmanStopsAtWalls);
     RUN_TEST_CASE(PacmanGame, CollectingDotIncreasesScore);
     RUN_TEST_CASE(PacmanGame, CollectingPowerPelletActivatesPowerMode);
+    RUN_TEST_CASE(PacmanGame, EatenPelletIsNotEatenAgain);
     RUN_TEST_CASE(PacmanGame, GhostCollisionReducesLives);
     RUN_TEST_CASE(PacmanGame, GhostCollisionInFrightenedModeIncreasesScore);
     RUN_TEST_CASE(PacmanGame, NoLivesLeftEndsGame);
+    RUN_TEST_CASE(PacmanGame, StepTimerStopsOnGameOver);
     RUN_TEST_CASE(PacmanGame, MovementOnlyOccursAtCorrectInterval);
     RUN_TEST_CASE(PacmanGame, GhostsChasePlayerInChaseMode);
 }
\ No newline at end of file
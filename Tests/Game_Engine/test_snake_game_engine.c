@@ -1,58 +1,73 @@
 #include "unity.h"
 #include "unity_fixture.h"
-#include "Game_Engine/Games/snake_game.h"
+#include "Game_Engine/Games/Single_Player/snake_game.h"
 #include "Mocks/Inc/mock_utils.h"
 #include "Mocks/Inc/mock_display_driver.h"
 
 static SnakeGameData* game_data;
 
+// One engine update - the game reads the D-pad, then its timers catch up to the mock clock.
+// A jump of the clock is played out in frames the wheel catches up in full.
+static void run_update(DPAD_STATUS dpad) {
+    snake_game_engine.update_func.update_dpad(dpad);
+    while (get_current_ms() - game_timers.last_ms > TIMER_WHEEL_MAX_CATCHUP_MS) {
+        timer_wheel_advance(&game_timers, game_timers.last_ms + TIMER_WHEEL_MAX_CATCHUP_MS);
+    }
+    timer_wheel_advance(&game_timers, get_current_ms());
+}
+
 TEST_GROUP(SnakeGame);
 
 TEST_SETUP(SnakeGame) {
     mock_display_reset_state();
     mock_time_reset();
     mock_random_reset();
+    // Place game data in the arena like game_engine_init() does
+    game_arena_reset();
+    timer_wheel_init(&game_timers, 0);
+    snake_game_engine.game_data = game_arena_alloc(snake_game_engine.game_data_size);
     game_data = (SnakeGameData*)snake_game_engine.game_data;
     snake_game_engine.init();
 }
 
 TEST_TEAR_DOWN(SnakeGame) {
     snake_game_engine.cleanup();
+    game_arena_reset();
 }
 
 TEST(SnakeGame, InitializationSetsCorrectStartState) {
-    TEST_ASSERT_EQUAL(DISPLAY_WIDTH / 2, game_data->head_x);
-    TEST_ASSERT_EQUAL(DISPLAY_HEIGHT / 2, game_data->head_y);
-    TEST_ASSERT_EQUAL(DPAD_DIR_RIGHT, game_data->direction);
-    TEST_ASSERT_EQUAL(1, game_data->length);
-    TEST_ASSERT_EQUAL(3, snake_game_engine.base_state.lives);
-    TEST_ASSERT_EQUAL(0, snake_game_engine.base_state.score);
+    TEST_ASSERT_EQUAL(DISPLAY_WIDTH / 2, game_data->snake.head_x);
+    TEST_ASSERT_EQUAL(DISPLAY_HEIGHT / 2, game_data->snake.head_y);
+    TEST_ASSERT_EQUAL(DPAD_DIR_RIGHT, game_data->snake.direction);
+    TEST_ASSERT_EQUAL(1, game_data->snake.length);
+    TEST_ASSERT_EQUAL(DEFAULT_LIVES, snake_game_engine.base_state.state_data.single.lives);
+    TEST_ASSERT_EQUAL(0, snake_game_engine.base_state.state_data.single.score);
     TEST_ASSERT_TRUE(snake_game_engine.is_d_pad_game);
 }
 
 TEST(SnakeGame, BodyFollowsHead) {
-    game_data->length = 2;
-    uint8_t initial_body_x = game_data->head_x;
-    uint8_t initial_body_y = game_data->head_y;
+    game_data->snake.length = 2;
+    uint8_t initial_body_x = game_data->snake.head_x;
+    uint8_t initial_body_y = game_data->snake.head_y;
 
     DPAD_STATUS dpad = { .direction = DPAD_DIR_RIGHT, .is_new = 1 };
     mock_time_set_ms(SNAKE_SPEED + 1);
-    snake_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
 
-    TEST_ASSERT_EQUAL(initial_body_x, game_data->body[0].x);
-    TEST_ASSERT_EQUAL(initial_body_y, game_data->body[0].y);
+    TEST_ASSERT_EQUAL(initial_body_x, snake_body_x(&game_data->snake)[0]);
+    TEST_ASSERT_EQUAL(initial_body_y, snake_body_y(&game_data->snake)[0]);
 }
 
 TEST(SnakeGame, DirectionChangeIgnoredIfNotNew) {
-    game_data->direction = DPAD_DIR_RIGHT;
+    game_data->snake.direction = DPAD_DIR_RIGHT;
     DPAD_STATUS dpad = { .direction = DPAD_DIR_UP, .is_new = 0 };
-    snake_game_engine.update_func.update_dpad(dpad);
-    TEST_ASSERT_EQUAL(DPAD_DIR_RIGHT, game_data->direction);
+    run_update(dpad);
+    TEST_ASSERT_EQUAL(DPAD_DIR_RIGHT, game_data->snake.direction);
 }
 
 TEST(SnakeGame, SnakeMovesSpriteWidthInDirectionOfMovement) {
-    uint8_t initial_x = game_data->head_x;
-    uint8_t initial_y = game_data->head_y;
+    uint8_t initial_x = game_data->snake.head_x;
+    uint8_t initial_y = game_data->snake.head_y;
 
     DPAD_STATUS dpad = {
         .direction = DPAD_DIR_RIGHT,
@@ -60,61 +75,61 @@ TEST(SnakeGame, SnakeMovesSpriteWidthInDirectionOfMovement) {
     };
 
     mock_time_set_ms(SNAKE_SPEED + 1);
-    snake_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
 
-    TEST_ASSERT_EQUAL(initial_x + SPRITE_SIZE, game_data->head_x);
-    TEST_ASSERT_EQUAL(initial_y, game_data->head_y);
+    TEST_ASSERT_EQUAL(initial_x + SPRITE_SIZE, game_data->snake.head_x);
+    TEST_ASSERT_EQUAL(initial_y, game_data->snake.head_y);
 }
 
 TEST(SnakeGame, CannotReverseDirection) {
-    game_data->direction = DPAD_DIR_RIGHT;
+    game_data->snake.direction = DPAD_DIR_RIGHT;
     DPAD_STATUS dpad = { .direction = DPAD_DIR_LEFT, .is_new = 1 };
-    snake_game_engine.update_func.update_dpad(dpad);
-    TEST_ASSERT_EQUAL(DPAD_DIR_RIGHT, game_data->direction);
+    run_update(dpad);
+    TEST_ASSERT_EQUAL(DPAD_DIR_RIGHT, game_data->snake.direction);
 }
 
 TEST(SnakeGame, SnakeWrapsHorizontally) {
-    game_data->head_x = DISPLAY_WIDTH - SPRITE_SIZE;
+    game_data->snake.head_x = DISPLAY_WIDTH - SPRITE_SIZE;
     DPAD_STATUS dpad = { .direction = DPAD_DIR_RIGHT, .is_new = 1 };
     mock_time_set_ms(SNAKE_SPEED + 1);
-    snake_game_engine.update_func.update_dpad(dpad);
-    TEST_ASSERT_EQUAL(BORDER_OFFSET, game_data->head_x);
+    run_update(dpad);
+    TEST_ASSERT_EQUAL(BORDER_OFFSET, game_data->snake.head_x);
 }
 
 TEST(SnakeGame, SnakeSpeedIncreases) {
-    uint8_t initial_x = game_data->head_x;
-    snake_game_engine.base_state.score = 200;
+    uint8_t initial_x = game_data->snake.head_x;
+    snake_game_engine.base_state.state_data.single.score = 200;
     mock_time_set_ms(SNAKE_SPEED - 180);  // Less than reduced speed threshold
     DPAD_STATUS dpad = { .direction = DPAD_DIR_RIGHT, .is_new = 1 };
-    snake_game_engine.update_func.update_dpad(dpad);
-    TEST_ASSERT_NOT_EQUAL(initial_x, game_data->head_x);
+    run_update(dpad);
+    TEST_ASSERT_NOT_EQUAL(initial_x, game_data->snake.head_x);
 }
 
 TEST(SnakeGame, SnakeWrapsVertically) {
-    game_data->head_y = DISPLAY_HEIGHT - SPRITE_SIZE;
+    game_data->snake.head_y = DISPLAY_HEIGHT - SPRITE_SIZE;
     DPAD_STATUS dpad = { .direction = DPAD_DIR_DOWN, .is_new = 1 };
     mock_time_set_ms(SNAKE_SPEED + 1);
-    snake_game_engine.update_func.update_dpad(dpad);
-    TEST_ASSERT_EQUAL(GAME_AREA_TOP, game_data->head_y);
+    run_update(dpad);
+    TEST_ASSERT_EQUAL(GAME_AREA_TOP, game_data->snake.head_y);
 }
 
 TEST(SnakeGame, MovementOnlyOccursAtCorrectInterval) {
-    uint8_t initial_x = game_data->head_x;
+    uint8_t initial_x = game_data->snake.head_x;
     mock_time_set_ms(SNAKE_SPEED - 1);
     DPAD_STATUS dpad = { .direction = DPAD_DIR_RIGHT, .is_new = 1 };
-    snake_game_engine.update_func.update_dpad(dpad);
-    TEST_ASSERT_EQUAL(initial_x, game_data->head_x);
+    run_update(dpad);
+    TEST_ASSERT_EQUAL(initial_x, game_data->snake.head_x);
 }
 
 TEST(SnakeGame, SnakeLengthLimitedToMaxSize) {
     for (int i = 0; i < 65; i++) {
-        game_data->food.x = game_data->head_x + SPRITE_SIZE;
-        game_data->food.y = game_data->head_y;
+        game_data->food.x = game_data->snake.head_x + SPRITE_SIZE;
+        game_data->food.y = game_data->snake.head_y;
         mock_time_set_ms((i + 1) * SNAKE_SPEED + 1);
         DPAD_STATUS dpad = { .direction = DPAD_DIR_RIGHT, .is_new = 1 };
-        snake_game_engine.update_func.update_dpad(dpad);
+        run_update(dpad);
     }
-    TEST_ASSERT_LESS_OR_EQUAL(64, game_data->length);
+    TEST_ASSERT_LESS_OR_EQUAL(64, game_data->snake.length);
 }
 
 
@@ -126,14 +141,14 @@ TEST(SnakeGame, FoodSpawnsInBoundsAfterCollection) {
     TEST_ASSERT_LESS_THAN(DISPLAY_HEIGHT - BORDER_OFFSET - SPRITE_SIZE, game_data->food.y);
 
     // Trigger food respawn through collection
-    game_data->head_x = game_data->food.x - SPRITE_SIZE;
-    game_data->head_y = game_data->food.y;
+    game_data->snake.head_x = game_data->food.x - SPRITE_SIZE;
+    game_data->snake.head_y = game_data->food.y;
 
-    mock_random_set_next_value(50);
+    game_random_seed(&game_random, 50);
     mock_time_set_ms(SNAKE_SPEED + 1);
 
     DPAD_STATUS dpad = { .direction = DPAD_DIR_RIGHT, .is_new = 1 };
-    snake_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
 
     // Check new food position is also in bounds
     TEST_ASSERT_GREATER_OR_EQUAL(BORDER_OFFSET, game_data->food.x);
@@ -147,17 +162,17 @@ TEST(SnakeGame, FoodRelocatesAfterCollection) {
     uint8_t old_food_y = game_data->food.y;
 
     // Move snake to food
-    game_data->head_x = old_food_x - SPRITE_SIZE;  // Position just before food
-    game_data->head_y = old_food_y;
+    game_data->snake.head_x = old_food_x - SPRITE_SIZE;  // Position just before food
+    game_data->snake.head_y = old_food_y;
 
-    mock_random_set_next_value(50);
+    game_random_seed(&game_random, 50);
     mock_time_set_ms(SNAKE_SPEED + 1);
 
     DPAD_STATUS dpad = { .direction = DPAD_DIR_RIGHT, .is_new = 1 };
-    snake_game_engine.update_func.update_dpad(dpad);  // This movement should collect food
+    run_update(dpad);  // This movement should collect food
 
     mock_time_set_ms(SNAKE_SPEED * 2);  // Wait for another update
-    snake_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
 
     TEST_ASSERT_NOT_EQUAL(old_food_x, game_data->food.x);
     TEST_ASSERT_NOT_EQUAL(old_food_y, game_data->food.y);
@@ -168,42 +183,62 @@ TEST(SnakeGame, SnakeCollectsFood) {
     mock_time_set_ms(SNAKE_SPEED + 1);
 
     // Position the food where snake will collide
-    game_data->food.x = game_data->head_x + SPRITE_SIZE;
-    game_data->food.y = game_data->head_y;
+    game_data->food.x = game_data->snake.head_x + SPRITE_SIZE;
+    game_data->food.y = game_data->snake.head_y;
 
     DPAD_STATUS dpad = { .direction = DPAD_DIR_RIGHT, .is_new = 1 };
-    snake_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
 
-    TEST_ASSERT_EQUAL(2, game_data->length);
-    TEST_ASSERT_EQUAL(10, snake_game_engine.base_state.score);
+    TEST_ASSERT_EQUAL(2, game_data->snake.length);
+    TEST_ASSERT_EQUAL(10, snake_game_engine.base_state.state_data.single.score);
 }
 
 
 TEST(SnakeGame, SnakeSelfCollisionReducesLives) {
     // Set up collision with body segment. Length must be sufficiently large for self collision to occur
     // Chose 10 based on experience
-    game_data->length = 10;
-    game_data->body[1].x = game_data->head_x + SPRITE_SIZE;
-    game_data->body[1].y = game_data->head_y;
+    snake_game_engine.base_state.state_data.single.lives = 3;
+    game_data->snake.length = 10;
+    snake_body_x(&game_data->snake)[1] = game_data->snake.head_x + SPRITE_SIZE;
+    snake_body_y(&game_data->snake)[1] = game_data->snake.head_y;
 
     DPAD_STATUS dpad = { .direction = DPAD_DIR_RIGHT, .is_new = 1 };
     mock_time_set_ms(SNAKE_SPEED + 1);
-    snake_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
 
-    TEST_ASSERT_EQUAL(2, snake_game_engine.base_state.lives);  // Should decrease from 3 to 2
+    TEST_ASSERT_EQUAL(2, snake_game_engine.base_state.state_data.single.lives);  // Should decrease from 3 to 2
 }
 
 TEST(SnakeGame, SelfCollisionWithNoLivesEndsGame) {
-    snake_game_engine.base_state.lives = 1;
-    game_data->length = 10;
-    game_data->body[1].x = game_data->head_x + SPRITE_SIZE;
-    game_data->body[1].y = game_data->head_y;
+    snake_game_engine.base_state.state_data.single.lives = 1;
+    game_data->snake.length = 10;
+    snake_body_x(&game_data->snake)[1] = game_data->snake.head_x + SPRITE_SIZE;
+    snake_body_y(&game_data->snake)[1] = game_data->snake.head_y;
     DPAD_STATUS dpad = { .direction = DPAD_DIR_RIGHT, .is_new = 1 };
     mock_time_set_ms(SNAKE_SPEED + 1);
-    snake_game_engine.update_func.update_dpad(dpad);
+    run_update(dpad);
     TEST_ASSERT_TRUE(snake_game_engine.base_state.game_over);
 }
 
+TEST(SnakeGame, StepTimerStopsOnGameOver) {
+    snake_game_engine.base_state.state_data.single.lives = 1;
+    game_data->snake.length = 10;
+    snake_body_x(&game_data->snake)[1] = game_data->snake.head_x + SPRITE_SIZE;
+    snake_body_y(&game_data->snake)[1] = game_data->snake.head_y;
+    DPAD_STATUS dpad = { .direction = DPAD_DIR_RIGHT, .is_new = 1 };
+    mock_time_set_ms(SNAKE_SPEED + 1);
+    run_update(dpad);
+    TEST_ASSERT_TRUE(snake_game_engine.base_state.game_over);
+
+    // Steps still due on the wheel leave the snake where it died
+    coord_t head_x = game_data->snake.head_x;
+    coord_t head_y = game_data->snake.head_y;
+    mock_time_set_ms(SNAKE_SPEED * 4);
+    run_update(dpad);
+    TEST_ASSERT_EQUAL(head_x, game_data->snake.head_x);
+    TEST_ASSERT_EQUAL(head_y, game_data->snake.head_y);
+}
+
 TEST(SnakeGame, DPadGameFlagIsSet) {
     TEST_ASSERT_TRUE(snake_game_engine.is_d_pad_game);
 }
@@ -224,5 +259,6 @@ TEST_GROUP_RUNNER(SnakeGame) {
     RUN_TEST_CASE(SnakeGame, SnakeCollectsFood);
     RUN_TEST_CASE(SnakeGame, SnakeSelfCollisionReducesLives);
     RUN_TEST_CASE(SnakeGame, SelfCollisionWithNoLivesEndsGame);
+    RUN_TEST_CASE(SnakeGame, StepTimerStopsOnGameOver);
     RUN_TEST_CASE(SnakeGame, DPadGameFlagIsSet);
 }
\ No newline at end of file
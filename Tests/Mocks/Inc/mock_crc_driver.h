@@ -0,0 +1,14 @@
+#ifndef MOCK_CRC_DRIVER_H_
+#define MOCK_CRC_DRIVER_H_
+
+#include <stdint.h>
+#include "Console_Peripherals/Hardware/Drivers/crc_driver.h"
+
+// Bit-level model of the CRC unit, fed the way the driver feeds it: whole words,
+// byte-reversed, with the tail finished by crc32_mpeg2()
+
+void mock_crc_reset(void);
+uint32_t mock_crc_words_fed(void);     // Since the last reset
+uint32_t mock_crc_computations(void);
+
+#endif
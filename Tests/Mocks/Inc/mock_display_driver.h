@@ -2,8 +2,9 @@
 #define MOCK_DISPLAY_DRIVER_H
 
 #include <stdint.h>
-#include "Console_Peripherals/oled.h"
-#include "Console_Peripherals/Drivers/display_driver.h"
+#include <stdbool.h>
+#include "Console_Peripherals/Hardware/Drivers/display_driver.h"
+#include "Console_Peripherals/UI/menu_system.h"
 
 // Mock state tracking structure 
 typedef struct {
@@ -30,5 +31,7 @@ uint8_t display_buffer[DISPLAY_WIDTH * DISPLAY_HEIGHT / 8];
 void mock_display_reset_state(void);
 void mock_display_get_state(MockDisplayState* state);
 void mock_display_get_buffer(uint8_t* buffer, uint16_t size);
+void mock_display_set_changed(bool changed);   // As if the game drew since the last update
+void mock_display_set_dirty_region(coord_t x1, coord_t y1, coord_t x2, coord_t y2);   // Drew only there
 
 #endif // MOCK_DISPLAY_DRIVER_H
\ No newline at end of file
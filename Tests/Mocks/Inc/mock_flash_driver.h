@@ -0,0 +1,20 @@
+#ifndef MOCK_FLASH_DRIVER_H_
+#define MOCK_FLASH_DRIVER_H_
+
+#include <stdint.h>
+#include "Console_Peripherals/Hardware/Drivers/flash_driver.h"
+
+// RAM-backed save sectors. Programming can only clear bits, like the real flash.
+
+// Erase both sectors to 0xFF and clear the counters
+void mock_flash_reset(void);
+// Program only count more words, then fail every program - power lost mid-write.
+// A negative count writes without limit.
+void mock_flash_fail_after(int32_t count);
+void mock_flash_set_image_id(uint32_t id);
+
+uint32_t mock_flash_words_programmed(void);
+uint32_t mock_flash_erase_count(uint8_t sector);
+uint8_t* mock_flash_sector(uint8_t sector);    // Writable, to corrupt data in tests
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef MOCK_SERIAL_COMM_H_
+#define MOCK_SERIAL_COMM_H_
+
+#include <stdbool.h>
+#include "Communication/serial_comm.h"
+
+// Network error the engine sees, none until set
+void mock_serial_comm_set_network_error(const char* message);
+void mock_serial_comm_reset(void);
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef MOCK_UART_DRIVER_H_
+#define MOCK_UART_DRIVER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Console_Peripherals/Hardware/Drivers/uart_driver.h"
+
+// UART_PORT_2 with DMA transmission that only finishes when the test says so
+
+void mock_uart_reset(void);
+void mock_uart_fail_next_send(UART_Status status);
+
+// End the transmission in flight, as the TX complete interrupt would
+void mock_uart_complete_tx(bool ok);
+
+bool mock_uart_tx_active(void);
+uint32_t mock_uart_tx_count(void);             // DMA transmissions started
+const uint8_t* mock_uart_tx_data(void);        // Of the last one
+uint16_t mock_uart_tx_size(void);
+
+// Bytes arriving on RX: the DMA writes them into the ring, then the IDLE event fires
+void mock_uart_receive(const uint8_t* data, uint16_t length);
+
+#endif
@@ -6,9 +6,11 @@
 
 // Original function from misc_utils.h
 uint32_t get_current_ms(void);
+uint32_t get_current_us(void);
 
 // Test helper functions
 void mock_time_set_ms(uint32_t ms);
+void mock_time_set_us(uint32_t us);
 uint32_t mock_time_get_ms(void);
 void mock_time_reset(void);
 
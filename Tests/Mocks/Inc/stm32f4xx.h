@@ -0,0 +1,7 @@
+// Tests/Mocks/Inc/stm32f4xx.h
+#ifndef __STM32F4xx_H
+#define __STM32F4xx_H
+
+#include "stm32f4xx_hal.h"
+
+#endif
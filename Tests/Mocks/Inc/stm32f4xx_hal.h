@@ -28,6 +28,10 @@ typedef struct {
     uint32_t dummy;
 } SPI_HandleTypeDef;
 
+typedef struct {
+    uint32_t dummy;
+} DAC_HandleTypeDef;
+
 // Add HAL status type that's commonly used
 typedef enum {
     HAL_OK = 0x00,
@@ -7,7 +7,7 @@
 #ifdef UNITY_TEST
 #include <stdint.h>
 #include <stdbool.h>
-#include "Console_Peripherals/Drivers/audio_driver.h"
+#include "Console_Peripherals/Hardware/Drivers/audio_driver.h"
 #include "../Inc/mock_audio_driver.h"
 
 uint16_t mock_dac_value = 0;
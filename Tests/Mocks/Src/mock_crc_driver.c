@@ -0,0 +1,50 @@
+#include "../Inc/mock_crc_driver.h"
+#include "Utils/comm_utils.h"
+#include <string.h>
+
+static uint32_t data_register = 0xFFFFFFFFUL;
+static uint32_t words_fed = 0;
+static uint32_t computations = 0;
+
+// One write to DR: 32 bits shifted in MSB first
+static void unit_write(uint32_t word) {
+    data_register ^= word;
+    for (uint8_t bit = 0; bit < 32; bit++) {
+        data_register = (data_register & 0x80000000UL) ? (data_register << 1) ^ 0x04C11DB7UL : data_register << 1;
+    }
+    words_fed++;
+}
+
+static uint32_t byte_reverse(uint32_t word) {
+    return (word >> 24) | ((word >> 8) & 0xFF00UL) | ((word << 8) & 0xFF0000UL) | (word << 24);
+}
+
+void mock_crc_reset(void) {
+    data_register = 0xFFFFFFFFUL;
+    words_fed = 0;
+    computations = 0;
+}
+
+uint32_t mock_crc_words_fed(void) {
+    return words_fed;
+}
+
+uint32_t mock_crc_computations(void) {
+    return computations;
+}
+
+void crc_driver_init(void) {
+}
+
+uint32_t crc_driver_compute(const uint8_t* data, uint16_t length) {
+    uint16_t words = length / 4;
+    uint32_t word;
+
+    data_register = 0xFFFFFFFFUL;
+    for (uint16_t i = 0; i < words; i++) {
+        memcpy(&word, &data[i * 4], sizeof(word));
+        unit_write(byte_reverse(word));
+    }
+    computations++;
+    return crc32_mpeg2(&data[words * 4], length % 4, data_register);
+}
@@ -1,6 +1,9 @@
 #include "../Inc/mock_display_driver.h"
 #include <string.h>
 
+// Where display_manager.c starts the OLED menu, its scrollbar is drawn from there
+#define MENU_START_Y    35
+
 // Define the font data and structure
 const uint16_t Font7x10_data[] = {
     // Mock font data
@@ -8,8 +11,8 @@ const uint16_t Font7x10_data[] = {
 };
 
 FontDef Font_7x10 = {
-    .FontWidth = 7,
-    .FontHeight = 10,
+    .width = 7,
+    .height = 10,
     .data = Font7x10_data
 };
 
@@ -25,6 +28,8 @@ static uint8_t error_displayed = 0;
 static uint8_t scrollbar_drawn = 0;
 static uint8_t thumb_positions[MAX_MENU_ITEMS] = { 0 };
 static uint8_t num_thumb_draws = 0;
+static bool display_changed = false;
+static coord_t dirty_x1, dirty_y1, dirty_x2, dirty_y2;
 
 void mock_display_reset_state(void) {
     memset(display_buffer, 0, sizeof(display_buffer));
@@ -38,7 +43,7 @@ void mock_display_reset_state(void) {
     scrollbar_drawn = 0;
     memset(thumb_positions, 0, sizeof(thumb_positions));
     num_thumb_draws = 0;
-
+    display_changed = false;
 }
 
 void mock_display_get_state(MockDisplayState* state) {
@@ -64,6 +69,14 @@ void display_init(void) {
     display_clear();
 }
 
+void display_init_start(void) {
+    display_init();
+}
+
+bool display_init_poll(void) {
+    return display_initialized;
+}
+
 void display_clear(void) {
     memset(display_buffer, 0, sizeof(display_buffer));
     current_color = DISPLAY_BLACK;
@@ -75,6 +88,28 @@ void display_clear(void) {
 
 void display_update(void) {
     screen_updated++;
+    display_changed = false;
+}
+
+bool display_get_dirty_region(coord_t* x1, coord_t* y1, coord_t* x2, coord_t* y2) {
+    *x1 = dirty_x1;
+    *y1 = dirty_y1;
+    *x2 = dirty_x2;
+    *y2 = dirty_y2;
+    return display_changed;
+}
+
+void mock_display_set_changed(bool changed) {
+    mock_display_set_dirty_region(0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1);
+    display_changed = changed;
+}
+
+void mock_display_set_dirty_region(coord_t x1, coord_t y1, coord_t x2, coord_t y2) {
+    dirty_x1 = x1;
+    dirty_y1 = y1;
+    dirty_x2 = x2;
+    dirty_y2 = y2;
+    display_changed = true;
 }
 
 void display_set_cursor(uint8_t x, uint8_t y) {
@@ -84,7 +119,7 @@ void display_set_cursor(uint8_t x, uint8_t y) {
 
 void display_write_string(char* str, FontDef font, DisplayColor color) {
     current_color = color;
-    cursor_x += strlen(str) * font.FontWidth;
+    cursor_x += strlen(str) * font.width;
     // Set some bits in the buffer to simulate text
     if (color == DISPLAY_WHITE) {
         uint16_t buffer_index = cursor_y * (DISPLAY_WIDTH / 8) + (cursor_x / 8);
@@ -96,7 +131,7 @@ void display_write_string(char* str, FontDef font, DisplayColor color) {
 }
 
 void display_write_string_centered(char* str, FontDef font, uint8_t y, DisplayColor color) {
-    uint8_t str_width = strlen(str) * font.FontWidth;
+    uint8_t str_width = strlen(str) * font.width;
     cursor_x = (DISPLAY_WIDTH - str_width) / 2;
     cursor_y = y;
     current_color = color;
@@ -125,6 +160,11 @@ void display_draw_rectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, Disp
     screen_updated++;
 }
 
+void display_draw_horizontal_line(coord_t x, coord_t y, coord_t length, DisplayColor color) {
+    current_color = color;
+    screen_updated++;
+}
+
 void display_fill_rectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, DisplayColor color) {
     current_color = color;
     // Check if this is a scrollbar thumb
@@ -232,4 +272,25 @@ void display_draw_bitmap(uint8_t x, uint8_t y, const uint8_t* bitmap, uint8_t wi
 
     current_color = color;
     screen_updated++;
-}
\ No newline at end of file
+}
+
+void display_clear_region(coord_t x, coord_t y, coord_t width, coord_t height) {
+    display_fill_rectangle(x, y, x + width - 1, y + height - 1, DISPLAY_BLACK);
+}
+
+// The OLED has no hardware scrolling - the viewport falls back to repainting
+void display_set_scroll_area(coord_t top, coord_t height) {
+    (void)top;
+    (void)height;
+}
+
+void display_set_scroll_offset(coord_t offset) {
+    (void)offset;
+}
+
+void display_reset_scroll(void) {
+}
+
+bool display_has_hw_scroll(void) {
+    return false;
+}
@@ -0,0 +1,85 @@
+#include "../Inc/mock_flash_driver.h"
+#include <string.h>
+
+static uint8_t sectors[FLASH_SAVE_SECTOR_COUNT][FLASH_SAVE_SECTOR_SIZE] __attribute__((aligned(4)));
+static uint32_t erase_counts[FLASH_SAVE_SECTOR_COUNT];
+static uint32_t words_programmed = 0;
+static int32_t words_until_failure = -1;
+static uint32_t image_id = 1;
+static bool initialised = false;
+
+void mock_flash_reset(void) {
+    memset(sectors, 0xFF, sizeof(sectors));
+    memset(erase_counts, 0, sizeof(erase_counts));
+    words_programmed = 0;
+    words_until_failure = -1;
+    image_id = 1;
+    initialised = true;
+}
+
+static void ensure_initialised(void) {
+    // Fresh flash reads erased, even before the first reset
+    if (!initialised) {
+        mock_flash_reset();
+    }
+}
+
+void mock_flash_fail_after(int32_t count) {
+    words_until_failure = count;
+}
+
+void mock_flash_set_image_id(uint32_t id) {
+    image_id = id;
+}
+
+uint32_t mock_flash_words_programmed(void) {
+    return words_programmed;
+}
+
+uint32_t mock_flash_erase_count(uint8_t sector) {
+    return (sector < FLASH_SAVE_SECTOR_COUNT) ? erase_counts[sector] : 0;
+}
+
+uint8_t* mock_flash_sector(uint8_t sector) {
+    ensure_initialised();
+    return sectors[sector];
+}
+
+bool flash_driver_erase_save_sector(uint8_t sector) {
+    ensure_initialised();
+    if (sector >= FLASH_SAVE_SECTOR_COUNT || words_until_failure == 0) {
+        return false;
+    }
+    memset(sectors[sector], 0xFF, FLASH_SAVE_SECTOR_SIZE);
+    erase_counts[sector]++;
+    return true;
+}
+
+bool flash_driver_program_word(uint8_t sector, uint32_t offset, uint32_t value) {
+    ensure_initialised();
+    if (sector >= FLASH_SAVE_SECTOR_COUNT || offset > FLASH_SAVE_SECTOR_SIZE - 4 || (offset & 3) != 0) {
+        return false;
+    }
+    if (words_until_failure == 0) {
+        return false;
+    }
+    if (words_until_failure > 0) {
+        words_until_failure--;
+    }
+
+    uint32_t word;
+    memcpy(&word, &sectors[sector][offset], sizeof(word));
+    word &= value;
+    memcpy(&sectors[sector][offset], &word, sizeof(word));
+    words_programmed++;
+    return true;
+}
+
+const uint8_t* flash_driver_save_sector(uint8_t sector) {
+    ensure_initialised();
+    return sectors[sector];
+}
+
+uint32_t flash_driver_image_id(void) {
+    return image_id;
+}
@@ -1,5 +1,5 @@
 #ifdef UNITY_TEST
-#include "Console_Peripherals/Drivers/joystick_driver.h"
+#include "Console_Peripherals/Hardware/Drivers/joystick_driver.h"
 
 // Test-specific global variables
 static uint16_t test_x = 2048, test_y = 2048;
@@ -28,7 +28,7 @@ void joystick_driver_get_adc_values(uint16_t* x, uint16_t* y) {
     *y = test_y;
 }
 
-void joystick_driver_tim_callback(void* htim) {
+void joystick_driver_adc_half_callback(void* hadc) {
     // Empty stub for testing
 }
 
@@ -36,13 +36,4 @@ void joystick_driver_adc_callback(void* hadc) {
     // Empty stub for testing
 }
 
-// Mock implementations for interrupt control
-void __disable_irq(void) {
-    // Simulate disabling interrupts for testing
-}
-
-void __enable_irq(void) {
-    // Simulate enabling interrupts for testing
-}
-
 #endif
\ No newline at end of file
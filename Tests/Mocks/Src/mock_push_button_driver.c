@@ -1,6 +1,6 @@
 #ifdef UNITY_TEST
 #include <stdint.h>
-#include "Console_Peripherals/Drivers/push_button_driver.h"
+#include "Console_Peripherals/Hardware/Drivers/push_button_driver.h"
 #include "../Inc/mock_push_button_driver.h"
 
 void mock_pb_driver_reset(void);
@@ -42,6 +42,15 @@ uint8_t read_dpad_pin_down(void) {
     return mock_dpad_down_state;
 }
 
+uint16_t PB_Driver_ReadInputs(void) {
+    return (mock_pb1_state ? BUTTON_PB1 : 0) |
+           (mock_pb2_state ? BUTTON_PB2 : 0) |
+           (mock_dpad_up_state ? BUTTON_DPAD_UP : 0) |
+           (mock_dpad_right_state ? BUTTON_DPAD_RIGHT : 0) |
+           (mock_dpad_down_state ? BUTTON_DPAD_DOWN : 0) |
+           (mock_dpad_left_state ? BUTTON_DPAD_LEFT : 0);
+}
+
 void mock_pb_driver_reset(void) {
     mock_pb1_state = 0;
     mock_pb2_state = 0;
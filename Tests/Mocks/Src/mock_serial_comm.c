@@ -0,0 +1,19 @@
+#include "../Inc/mock_serial_comm.h"
+
+static const char* network_error = NULL;
+
+bool serial_comm_has_network_error(void) {
+    return network_error != NULL;
+}
+
+const char* serial_comm_get_error_message(void) {
+    return network_error ? network_error : "";
+}
+
+void mock_serial_comm_set_network_error(const char* message) {
+    network_error = message;
+}
+
+void mock_serial_comm_reset(void) {
+    network_error = NULL;
+}
@@ -0,0 +1,103 @@
+#include "../Inc/mock_uart_driver.h"
+
+static void (*tx_callback)(bool) = NULL;
+static bool tx_active = false;
+static uint32_t tx_count = 0;
+static const uint8_t* tx_data = NULL;
+static uint16_t tx_size = 0;
+static UART_Status next_send_status = UART_OK;
+static dma_rx_ring_t* rx_ring = NULL;
+static uint16_t rx_position = 0;
+
+void mock_uart_reset(void) {
+    tx_callback = NULL;
+    tx_active = false;
+    tx_count = 0;
+    tx_data = NULL;
+    tx_size = 0;
+    next_send_status = UART_OK;
+    rx_ring = NULL;
+    rx_position = 0;
+}
+
+void mock_uart_fail_next_send(UART_Status status) {
+    next_send_status = status;
+}
+
+void mock_uart_complete_tx(bool ok) {
+    if (tx_active) {
+        tx_active = false;
+        if (tx_callback != NULL) {
+            tx_callback(ok);
+        }
+    }
+}
+
+bool mock_uart_tx_active(void) {
+    return tx_active;
+}
+
+uint32_t mock_uart_tx_count(void) {
+    return tx_count;
+}
+
+const uint8_t* mock_uart_tx_data(void) {
+    return tx_data;
+}
+
+uint16_t mock_uart_tx_size(void) {
+    return tx_size;
+}
+
+void mock_uart_receive(const uint8_t* data, uint16_t length) {
+    if (rx_ring == NULL) {
+        return;
+    }
+    for (uint16_t i = 0; i < length; i++) {
+        rx_ring->buffer[rx_position] = data[i];
+        rx_position = (rx_position + 1) & (rx_ring->size - 1);
+        if (rx_position == 0 || rx_position == rx_ring->size / 2) {
+            dma_rx_ring_advance(rx_ring, rx_position);
+        }
+    }
+    dma_rx_ring_advance(rx_ring, rx_position);
+}
+
+UART_Status UART_Init(void) {
+    return UART_OK;
+}
+
+UART_Status UART_StartRxDma(UART_Port port, dma_rx_ring_t* ring) {
+    (void)port;
+    rx_ring = ring;
+    rx_position = 0;
+    return UART_OK;
+}
+
+UART_Status UART_DisableRxInterrupt(UART_Port port) {
+    (void)port;
+    return UART_OK;
+}
+
+UART_Status UART_RegisterTxCompleteCallback(UART_Port port, void (*callback)(bool)) {
+    (void)port;
+    tx_callback = callback;
+    return UART_OK;
+}
+
+UART_Status UART_SendBufferDma(UART_Port port, const uint8_t* pData, uint16_t size) {
+    (void)port;
+    if (next_send_status != UART_OK) {
+        UART_Status status = next_send_status;
+        next_send_status = UART_OK;
+        return status;
+    }
+    if (tx_active) {
+        return UART_BUSY;
+    }
+    tx_active = true;
+    tx_count++;
+    tx_data = pData;
+    tx_size = size;
+    return UART_OK;
+}
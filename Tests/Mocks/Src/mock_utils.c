@@ -1,6 +1,7 @@
 #include "../Inc/mock_utils.h"
 
 static uint32_t current_ms = 0;
+static uint32_t current_us_part = 0;   // Microseconds past current_ms
 static uint32_t next_random_value = 0;
 static uint8_t mock_random_initialized = 0;
 
@@ -11,6 +12,12 @@ uint32_t get_current_ms(void) {
 
 void mock_time_set_ms(uint32_t ms) {
     current_ms = ms;
+    current_us_part = 0;
+}
+
+void mock_time_set_us(uint32_t us) {
+    current_ms = us / 1000;
+    current_us_part = us % 1000;
 }
 
 uint32_t mock_time_get_ms(void) {
@@ -19,6 +26,11 @@ uint32_t mock_time_get_ms(void) {
 
 void mock_time_reset(void) {
     current_ms = 0;
+    current_us_part = 0;
+}
+
+uint32_t get_current_us(void) {
+    return current_ms * 1000 + current_us_part;
 }
 
 // Random functions
@@ -37,4 +49,12 @@ void mock_random_set_next_value(uint32_t value) {
 void mock_random_reset(void) {
     next_random_value = 0;
     mock_random_initialized = 0;
-}
\ No newline at end of file
+}
+
+// Cycle counter - no DWT on the host
+void cycle_counter_init(void) {
+}
+
+uint32_t get_cycle_count(void) {
+    return 0;
+}
@@ -0,0 +1,32 @@
+// Tests/Simulation/sim.h
+//
+// Headless simulation of the console. The real game controller, engine, games,
+// display manager and display driver run on the host against a virtual clock,
+// scripted or random D-pad input and an ILI9341 backend that only counts what
+// would have been sent to the panel.
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Counting display backend, one set of counters per measured span
+typedef struct {
+    uint64_t draw_calls;    // ILI9341 drawing calls
+    uint64_t pixels;        // Pixels written to panel RAM
+    uint64_t spi_bytes;     // Commands, parameters and pixel data on the SPI bus
+} SimDisplayCounters;
+
+extern SimDisplayCounters sim_display;
+void sim_display_reset(void);
+
+// Virtual clock, get_current_ms() / get_current_us() read it
+void sim_clock_advance_us(uint32_t us);
+uint64_t sim_clock_us(void);
+
+// Input seen by d_pad_get_status() and posted to the input event queue
+void sim_input_seed(uint32_t seed);
+void sim_input_set_script(const char* script);     // e.g. "R20,U10,L15" - direction and frames, looped
+void sim_input_next_frame(void);                   // Scripted, or random turns without a script
+
+#endif // SIM_H
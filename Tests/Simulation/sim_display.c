@@ -0,0 +1,108 @@
+#include "sim.h"
+#include "Console_Peripherals/Hardware/Drivers/display_driver.h"
+
+// Bytes the real driver puts on the bus, see ili9341.c
+#define ADDRESS_WINDOW_BYTES    (3 + 4 + 4)     // CASET, RASET and RAMWR with their parameters
+#define BYTES_PER_PIXEL         2
+
+SimDisplayCounters sim_display;
+
+static ILI9341_InitState init_state = ILI9341_INIT_IDLE;
+
+void sim_display_reset(void) {
+    sim_display.draw_calls = 0;
+    sim_display.pixels = 0;
+    sim_display.spi_bytes = 0;
+}
+
+static void count_window(uint32_t pixels) {
+    sim_display.draw_calls++;
+    sim_display.pixels += pixels;
+    sim_display.spi_bytes += ADDRESS_WINDOW_BYTES + pixels * BYTES_PER_PIXEL;
+}
+
+void ILI9341_InitStart(void) {
+    init_state = ILI9341_INIT_RESET;
+}
+
+bool ILI9341_InitStep(void) {
+    // No panel to wait for
+    init_state = ILI9341_INIT_DONE;
+    return true;
+}
+
+ILI9341_InitState ILI9341_GetInitState(void) {
+    return init_state;
+}
+
+void ILI9341_Init(void) {
+    init_state = ILI9341_INIT_DONE;
+}
+
+void ILI9341_DrawPixel(uint16_t x, uint16_t y, uint16_t color) {
+    (void)color;
+    if (x < ILI9341_WIDTH && y < ILI9341_HEIGHT) {
+        count_window(1);
+    }
+}
+
+void ILI9341_WriteString(uint16_t x, uint16_t y, const char* str, FontDef font, uint16_t color, uint16_t bgcolor) {
+    (void)color;
+    (void)bgcolor;
+
+    // Same wrapping as the driver, every character is its own window
+    while (*str) {
+        if (x + font.width >= ILI9341_WIDTH) {
+            x = 0;
+            y += font.height;
+            if (y + font.height >= ILI9341_HEIGHT) {
+                break;
+            }
+            if (*str == ' ') {
+                str++;
+                continue;
+            }
+        }
+        count_window((uint32_t)font.width * font.height);
+        x += font.width;
+        str++;
+    }
+}
+
+void ILI9341_FillRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    (void)color;
+    if ((x >= ILI9341_WIDTH) || (y >= ILI9341_HEIGHT)) return;
+    if ((x + w - 1) >= ILI9341_WIDTH) w = ILI9341_WIDTH - x;
+    if ((y + h - 1) >= ILI9341_HEIGHT) h = ILI9341_HEIGHT - y;
+
+    count_window((uint32_t)w * h);
+}
+
+void ILI9341_FillScreen(uint16_t color) {
+    ILI9341_FillRectangle(0, 0, ILI9341_WIDTH, ILI9341_HEIGHT, color);
+}
+
+void ILI9341_DrawImage(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t* data) {
+    (void)data;
+    if ((x >= ILI9341_WIDTH) || (y >= ILI9341_HEIGHT)) return;
+    if ((x + w - 1) >= ILI9341_WIDTH) return;
+    if ((y + h - 1) >= ILI9341_HEIGHT) return;
+
+    count_window((uint32_t)w * h);
+}
+
+void ILI9341_InvertColors(bool invert) {
+    (void)invert;
+    sim_display.spi_bytes += 1;
+}
+
+void ILI9341_SetVerticalScrollArea(uint16_t top_fixed, uint16_t scroll_height) {
+    (void)top_fixed;
+    (void)scroll_height;
+    sim_display.spi_bytes += 1 + 6;     // VSCRDEF
+}
+
+void ILI9341_SetVerticalScrollStart(uint16_t line) {
+    (void)line;
+    sim_display.spi_bytes += 1 + 2;     // VSCRSADD
+}
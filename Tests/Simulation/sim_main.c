@@ -0,0 +1,307 @@
+#include "sim.h"
+#include "Application/game_controller.h"
+#include "Game_Engine/game_registry.h"
+#include "Game_Engine/game_engine_replay.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+
+#define FRAME_US            (FRAME_RATE * 1000UL)
+#define BOOT_TIMEOUT_FRAMES 1000
+
+typedef struct {
+    uint32_t games;
+    uint32_t game_overs;            // Games that ended on their own, the rest hit the frame cap
+    uint64_t frames;
+    uint64_t score;
+    uint64_t tick_ns;               // Host time in update and render
+    uint64_t worst_tick_ns;
+    uint64_t worst_tick_frame;      // Frame of the game the worst tick was in
+    SimDisplayCounters display;
+} SimReport;
+
+static uint64_t host_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+// One scheduler frame: the game tick, then the render it signals
+static uint64_t run_frame(void) {
+    sim_clock_advance_us(FRAME_US);
+    sim_input_next_frame();
+
+    uint64_t start = host_ns();
+    game_controller_update();
+    game_controller_render_game();
+    uint64_t elapsed = host_ns() - start;
+
+    // The save task runs between frames
+    game_save_service(game_controller_is_game_active());
+    return elapsed;
+}
+
+// Boot, welcome screen and menu, as on the console
+static bool boot_to_menu(void) {
+    game_controller_init_with_default_menu();
+
+    for (uint32_t frame = 0; frame < BOOT_TIMEOUT_FRAMES; frame++) {
+        sim_clock_advance_us(FRAME_US);
+        game_controller_update_screen();
+        if (game_controller_get_state() == APP_STATE_MENU) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void run_game(const GameDescriptor* game, uint32_t max_frames, SimReport* report) {
+    GameEngine* engine = game->engine;
+    uint32_t frames = 0;
+
+    game_controller_start_game(game->screen);
+    if (!game_controller_is_game_active()) {
+        return;
+    }
+
+    sim_display_reset();
+    while (game_controller_is_game_active() && !engine->base_state.game_over && frames < max_frames) {
+        uint64_t tick_ns = run_frame();
+
+        report->tick_ns += tick_ns;
+        if (tick_ns > report->worst_tick_ns) {
+            report->worst_tick_ns = tick_ns;
+            report->worst_tick_frame = frames;
+        }
+        frames++;
+    }
+
+    report->games++;
+    report->frames += frames;
+    report->score += engine->base_state.state_data.single.score;
+    report->game_overs += engine->base_state.game_over ? 1 : 0;
+    report->display.draw_calls += sim_display.draw_calls;
+    report->display.pixels += sim_display.pixels;
+    report->display.spi_bytes += sim_display.spi_bytes;
+
+    // Leave like a long B press, the game over countdown is not game throughput.
+    // Every game starts fresh, so its save-state goes as it would after the countdown.
+    engine->return_to_main_menu = true;
+    game_controller_update();
+    game_save_discard(game->screen);
+    while (game_save_service(false)) {
+    }
+}
+
+static void print_report(const char* name, const SimReport* report) {
+    double frames = report->frames ? (double)report->frames : 1.0;
+    double seconds = report->tick_ns / 1e9;
+
+    printf("%-14s %6u %6u %10llu %12.0f %9.1f %10.0f %10.0f %9.2f %9.2f %8.1f\n",
+        name, report->games, report->game_overs, (unsigned long long)report->frames,
+        seconds > 0 ? report->frames / seconds : 0.0,
+        report->display.draw_calls / frames, report->display.pixels / frames,
+        report->display.spi_bytes / frames,
+        report->tick_ns / frames / 1000.0, report->worst_tick_ns / 1000.0,
+        report->games ? (double)report->score / report->games : 0.0);
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// A replay_dump() capture from the debug channel - lines other than the dump around it are skipped
+static uint32_t load_capture(const char* path, uint8_t* data, uint32_t size) {
+    FILE* file = fopen(path, "r");
+    char line[256];
+    unsigned long expected = 0;
+    uint32_t length = 0;
+    bool inside = false;
+
+    if (file == NULL) {
+        printf("Cannot open %s\n", path);
+        return 0;
+    }
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char* begin = strstr(line, "REPLAY BEGIN ");
+        if (begin != NULL) {
+            expected = strtoul(begin + strlen("REPLAY BEGIN "), NULL, 10);
+            length = 0;
+            inside = true;
+            continue;
+        }
+        if (!inside) {
+            continue;
+        }
+        if (strstr(line, "REPLAY END") != NULL) {
+            break;
+        }
+
+        // Data lines are hex pairs and nothing else
+        size_t count = strlen(line);
+        while (count > 0 && isspace((unsigned char)line[count - 1])) {
+            count--;
+        }
+        bool hex = count > 0 && count % 2 == 0;
+        for (size_t i = 0; hex && i < count; i++) {
+            hex = hex_value(line[i]) >= 0;
+        }
+        for (size_t i = 0; hex && i < count && length < size; i += 2) {
+            data[length++] = (uint8_t)(hex_value(line[i]) << 4 | hex_value(line[i + 1]));
+        }
+    }
+    fclose(file);
+
+    if (!inside || length != expected) {
+        printf("%s holds no whole replay capture (%u of %lu bytes)\n", path, length, expected);
+        return 0;
+    }
+    return length;
+}
+
+// The recording of the last game, as replay_dump() prints it
+static bool save_capture(const char* path) {
+    uint32_t length;
+    const uint8_t* data = replay_get_recording(&length);
+    FILE* file = fopen(path, "w");
+
+    if (file == NULL || length == 0) {
+        printf("No recording written to %s\n", path);
+        if (file != NULL) {
+            fclose(file);
+        }
+        return false;
+    }
+    fprintf(file, "REPLAY BEGIN %u\r\n", length);
+    for (uint32_t i = 0; i < length; i++) {
+        fprintf(file, "%02X%s", data[i], (i % 32 == 31 || i == length - 1) ? "\r\n" : "");
+    }
+    fprintf(file, "REPLAY END\r\n");
+    fclose(file);
+    return true;
+}
+
+// Runs a capture through the game it was recorded on, the one whose game data has its size
+static int replay_capture(const char* path, const char* filter) {
+    static uint8_t data[REPLAY_BUFFER_SIZE];
+    uint32_t length = load_capture(path, data, sizeof(data));
+    ReplayHeader header;
+
+    if (length < sizeof(header)) {
+        return 1;
+    }
+    memcpy(&header, data, sizeof(header));
+
+    for (uint8_t i = 0; i < game_registry_count(); i++) {
+        const GameDescriptor* game = game_registry_get(i);
+
+        if (game->engine->game_data_size != header.game_data_size ||
+            (filter != NULL && strstr(game->name, filter) == NULL)) {
+            continue;
+        }
+
+        ReplayResult result;
+        GameEngine* engine = game_registry_prepare(game->screen);
+        bool same = replay_play(engine, data, length, &result);
+        game_engine_cleanup(engine);
+
+        printf("%s: seed %08X, %u of %u frames, %u hashes checked, ", game->name,
+            header.seed, result.frames, header.frames, result.hashes_checked);
+        if (result.mismatch_frame != 0) {
+            printf("state differs from frame %u\n", result.mismatch_frame);
+        }
+        else {
+            printf(result.complete ? "all match\n" : "recording cut short\n");
+        }
+        return same ? 0 : 1;
+    }
+    printf("No game has %u bytes of game data\n", header.game_data_size);
+    return 1;
+}
+
+static void usage(const char* program) {
+    printf("Usage: %s [-n games] [-s seed] [-g game] [-i script] [-f max_frames] [-w capture]\n", program);
+    printf("       %s -r capture [-g game]\n", program);
+    printf("  -n  games per game type (default 1000)\n");
+    printf("  -s  seed for random input and game sessions (default 1)\n");
+    printf("  -g  only games whose name contains this\n");
+    printf("  -i  scripted D-pad input instead of random, e.g. R20,U10,L15,-5\n");
+    printf("  -f  frames before a game is stopped (default 20000)\n");
+    printf("  -w  write the last game's recording as replay_dump() prints it\n");
+    printf("  -r  replay a replay_dump() capture and check its state hashes\n");
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t games = 1000;
+    uint32_t seed = 1;
+    uint32_t max_frames = 20000;
+    const char* filter = NULL;
+    const char* script = NULL;
+    const char* capture_in = NULL;
+    const char* capture_out = NULL;
+    int option;
+
+    while ((option = getopt(argc, argv, "n:s:g:i:f:r:w:h")) != -1) {
+        switch (option) {
+        case 'n': games = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 's': seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'g': filter = optarg; break;
+        case 'i': script = optarg; break;
+        case 'f': max_frames = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'r': capture_in = optarg; break;
+        case 'w': capture_out = optarg; break;
+        default:
+            usage(argv[0]);
+            return (option == 'h') ? 0 : 1;
+        }
+    }
+
+    sim_input_seed(seed);
+    sim_input_set_script(script);
+
+    if (!boot_to_menu()) {
+        printf("Console did not reach the menu\n");
+        return 1;
+    }
+    if (capture_in != NULL) {
+        return replay_capture(capture_in, filter);
+    }
+
+    printf("%-14s %6s %6s %10s %12s %9s %10s %10s %9s %9s %8s\n",
+        "game", "games", "over", "frames", "ticks/s", "draws/f", "pixels/f", "spi B/f",
+        "mean us", "worst us", "score");
+
+    for (uint8_t i = 0; i < game_registry_count(); i++) {
+        const GameDescriptor* game = game_registry_get(i);
+
+        // Multiplayer games need the ESP32 and a server
+        if (game->mode != GAME_MODE_SINGLE_PLAYER || game->input != GAME_INPUT_DPAD) {
+            continue;
+        }
+        if (filter != NULL && strstr(game->name, filter) == NULL) {
+            continue;
+        }
+
+        SimReport report;
+        memset(&report, 0, sizeof(report));
+        for (uint32_t n = 0; n < games; n++) {
+            run_game(game, max_frames, &report);
+        }
+        print_report(game->name, &report);
+    }
+
+    const GameSaveStats* saves = game_save_get_stats();
+    printf("\nsave-states: %u written, last %u bytes, %u service calls\n",
+        saves->saves, saves->snapshot_bytes, saves->write_steps);
+
+    if (capture_out != NULL && !save_capture(capture_out)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include "sim.h"
+#include "Console_Peripherals/types.h"
+#include "Console_Peripherals/Hardware/d_pad.h"
+#include "Communication/serial_comm.h"
+#include "Communication/serial_comm_protocol.h"
+#include "Game_Engine/game_engine_random.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_CORE_MHZ 100    // get_cycle_count() runs at the console's core clock
+
+static uint64_t clock_us = 0;
+static uint8_t held_direction = 0;
+static uint16_t hold_frames = 0;
+static GameRandom input_rng;
+static const char* script = NULL;
+static const char* script_pos = NULL;
+
+// Virtual clock
+void sim_clock_advance_us(uint32_t us) {
+    clock_us += us;
+}
+
+uint64_t sim_clock_us(void) {
+    return clock_us;
+}
+
+uint32_t get_current_ms(void) {
+    return (uint32_t)(clock_us / 1000);
+}
+
+uint32_t get_current_us(void) {
+    return (uint32_t)clock_us;
+}
+
+uint32_t get_cycle_count(void) {
+    return (uint32_t)(clock_us * SIM_CORE_MHZ);
+}
+
+void add_delay(uint32_t ms) {
+    clock_us += (uint64_t)ms * 1000;
+}
+
+// Session seeds come from here, so a run is repeatable from its seed
+uint32_t get_random(void) {
+    return game_random_next(&input_rng);
+}
+
+// Input
+void sim_input_seed(uint32_t seed) {
+    game_random_seed(&input_rng, seed);
+    held_direction = 0;
+    hold_frames = 0;
+}
+
+void sim_input_set_script(const char* new_script) {
+    script = new_script;
+    script_pos = new_script;
+}
+
+static uint8_t script_direction(char c) {
+    switch (toupper((unsigned char)c)) {
+    case 'U': return DPAD_DIR_UP;
+    case 'R': return DPAD_DIR_RIGHT;
+    case 'D': return DPAD_DIR_DOWN;
+    case 'L': return DPAD_DIR_LEFT;
+    default:  return 0;            // '-' releases
+    }
+}
+
+// Next "<direction><frames>" step of the script, from the start again at its end
+static void next_script_step(void) {
+    if (*script_pos == '\0') {
+        script_pos = script;
+    }
+
+    held_direction = script_direction(*script_pos++);
+    hold_frames = (uint16_t)strtoul(script_pos, (char**)&script_pos, 10);
+    if (hold_frames == 0) {
+        hold_frames = 1;
+    }
+    while (*script_pos == ',' || *script_pos == ' ') {
+        script_pos++;
+    }
+}
+
+// Short presses now and then, released in between like a thumb on a D-pad
+static void next_random_step(void) {
+    static const uint8_t directions[] = { DPAD_DIR_UP, DPAD_DIR_RIGHT, DPAD_DIR_DOWN, DPAD_DIR_LEFT };
+
+    if (held_direction == 0 && game_random_below(&input_rng, 8) == 0) {
+        held_direction = directions[game_random_below(&input_rng, 4)];
+        hold_frames = (uint16_t)(2 + game_random_below(&input_rng, 5));
+    }
+    else {
+        held_direction = 0;
+        hold_frames = (uint16_t)(1 + game_random_below(&input_rng, 10));
+    }
+}
+
+void sim_input_next_frame(void) {
+    if (hold_frames == 0) {
+        if (script != NULL && *script != '\0') {
+            next_script_step();
+        }
+        else {
+            next_random_step();
+        }
+    }
+    hold_frames--;
+
+    // The real d_pad.c queues the change, as the SysTick scan would
+    update_d_pad_status();
+}
+
+// Buttons, read by d_pad.c and the engine
+uint8_t dpad_pin_up_get_state(void) { return held_direction == DPAD_DIR_UP; }
+uint8_t dpad_pin_right_get_state(void) { return held_direction == DPAD_DIR_RIGHT; }
+uint8_t dpad_pin_down_get_state(void) { return held_direction == DPAD_DIR_DOWN; }
+uint8_t dpad_pin_left_get_state(void) { return held_direction == DPAD_DIR_LEFT; }
+
+// Nobody pauses or restarts a simulated game
+uint8_t pb1_get_state(void) { return 0; }
+uint8_t pb2_get_state(void) { return 0; }
+uint8_t pb2_is_down(void) { return 0; }
+
+JoystickStatus joystick_get_status(void) {
+    JoystickStatus status = { .direction = JS_DIR_CENTERED, .is_new = 0, .button = 0 };
+    return status;
+}
+
+// No ESP32 on the host - offline, no errors
+bool serial_comm_is_wifi_connected(void) { return false; }
+bool serial_comm_has_network_error(void) { return false; }
+const char* serial_comm_get_error_message(void) { return ""; }
+uint32_t serial_comm_get_drop_count(void) { return 0; }
+
+UART_Status protocol_send_status(uint8_t system_status, uint8_t error_code, const char* message) {
+    (void)system_status;
+    (void)error_code;
+    (void)message;
+    return UART_OK;
+}
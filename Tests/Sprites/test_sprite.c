@@ -149,12 +149,41 @@ TEST(Sprite, NullHandling) {
     animated_sprite_draw(NULL, 0, 0, DISPLAY_WHITE);
 }
 
+TEST(Sprite, QuarterTurnCache) {
+    static const Sprite square_frames[] = {
+        {test_bitmap, 8, 8},
+        {test_bitmap, 8, 8}
+    };
+    static uint8_t buffer[3 * 2 * (sizeof(Sprite) + 8)] __attribute__((aligned(8)));
+    RotatedSprite rotated = { 0 };
+
+    // Only square frames can be turned in place
+    TEST_ASSERT_FALSE(sprite_rotations_build(&rotated, test_frames, 2, buffer));
+
+    TEST_ASSERT_EQUAL(sizeof(buffer), sprite_rotations_size(square_frames, 2));
+    TEST_ASSERT_TRUE(sprite_rotations_build(&rotated, square_frames, 2, buffer));
+
+    // No turn is the source frame, angles off the quarter turns are not cached
+    TEST_ASSERT_EQUAL_PTR(&square_frames[1], sprite_rotation_get(&rotated, 1, 0));
+    TEST_ASSERT_NULL(sprite_rotation_get(&rotated, 0, 45));
+
+    // A quarter turn of the checkerboard is the inverted checkerboard
+    const Sprite* turned = sprite_rotation_get(&rotated, 0, 90);
+    TEST_ASSERT_NOT_NULL(turned);
+    TEST_ASSERT_EQUAL_HEX8(0x55, turned->bitmap[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xAA, turned->bitmap[1]);
+
+    // Half a turn brings it back
+    TEST_ASSERT_EQUAL_MEMORY(test_bitmap, sprite_rotation_get(&rotated, 0, 180)->bitmap, 8);
+}
+
 // Test Group Runner
 TEST_GROUP_RUNNER(Sprite) {
     RUN_TEST_CASE(Sprite, BasicDrawing);
     RUN_TEST_CASE(Sprite, RotatedDrawing);
     RUN_TEST_CASE(Sprite, ScaledDrawing);
     RUN_TEST_CASE(Sprite, AnimationUpdate);
+    RUN_TEST_CASE(Sprite, QuarterTurnCache);
     // RUN_TEST_CASE(Sprite, AnimatedDrawing);
     // RUN_TEST_CASE(Sprite, NullHandling);
 }
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "System/save_store.h"
+#include "Mocks/Inc/mock_flash_driver.h"
+#include <string.h>
+
+static uint8_t payload_a[100];
+static uint8_t payload_b[37];    // Not a whole number of words
+
+static void write_record(uint16_t key, uint16_t version, const void* data, uint32_t length) {
+    TEST_ASSERT_TRUE(save_store_begin(key, version, data, length));
+    while (save_store_step(4)) {
+    }
+}
+
+TEST_GROUP(SaveStore);
+
+TEST_SETUP(SaveStore) {
+    mock_flash_reset();
+    for (uint16_t i = 0; i < sizeof(payload_a); i++) {
+        payload_a[i] = (uint8_t)(i * 3);
+    }
+    for (uint16_t i = 0; i < sizeof(payload_b); i++) {
+        payload_b[i] = (uint8_t)(0xA0 + i);
+    }
+    save_store_init();
+}
+
+TEST_TEAR_DOWN(SaveStore) {
+}
+
+TEST(SaveStore, BlankFlashIsFormattedEmpty) {
+    SaveRecord record;
+
+    TEST_ASSERT_EQUAL_UINT32(1, mock_flash_erase_count(0));
+    TEST_ASSERT_EQUAL_UINT8(0, save_store_get_stats()->active_sector);
+    TEST_ASSERT_FALSE(save_store_find(1, &record));
+    TEST_ASSERT_FALSE(save_store_latest(&record));
+
+    // Mounting again finds the formatted sector instead of erasing it
+    save_store_init();
+    TEST_ASSERT_EQUAL_UINT32(1, mock_flash_erase_count(0));
+}
+
+TEST(SaveStore, RecordIsWrittenInStepsAndOnlyVisibleWhenCommitted) {
+    SaveRecord record;
+    uint8_t steps = 0;
+
+    TEST_ASSERT_TRUE(save_store_begin(7, 3, payload_b, sizeof(payload_b)));
+    TEST_ASSERT_TRUE(save_store_busy());
+    TEST_ASSERT_FALSE(save_store_begin(8, 1, payload_a, sizeof(payload_a)));
+
+    while (save_store_step(2)) {
+        TEST_ASSERT_FALSE(save_store_find(7, &record));
+        steps++;
+    }
+
+    // 5 header words, 10 payload words and the commit word, 2 per step
+    TEST_ASSERT_EQUAL_UINT8(7, steps);
+    TEST_ASSERT_EQUAL_UINT32(16, mock_flash_words_programmed() - 2);
+    TEST_ASSERT_TRUE(save_store_find(7, &record));
+    TEST_ASSERT_EQUAL_UINT16(7, record.key);
+    TEST_ASSERT_EQUAL_UINT16(3, record.version);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(payload_b), record.length);
+    TEST_ASSERT_EQUAL_MEMORY(payload_b, record.data, sizeof(payload_b));
+    TEST_ASSERT_EQUAL_UINT32(1, save_store_get_stats()->records_written);
+}
+
+TEST(SaveStore, NewestRecordOfEachKeyWins) {
+    SaveRecord record;
+
+    write_record(1, 1, payload_a, sizeof(payload_a));
+    write_record(2, 1, payload_b, sizeof(payload_b));
+    payload_a[0] = 0x55;
+    write_record(1, 2, payload_a, sizeof(payload_a));
+
+    TEST_ASSERT_TRUE(save_store_find(1, &record));
+    TEST_ASSERT_EQUAL_UINT16(2, record.version);
+    TEST_ASSERT_EQUAL_HEX8(0x55, record.data[0]);
+
+    TEST_ASSERT_TRUE(save_store_find(2, &record));
+    TEST_ASSERT_EQUAL_MEMORY(payload_b, record.data, sizeof(payload_b));
+
+    TEST_ASSERT_TRUE(save_store_latest(&record));
+    TEST_ASSERT_EQUAL_UINT16(1, record.key);
+}
+
+TEST(SaveStore, WriteCutShortKeepsThePreviousRecord) {
+    SaveRecord record;
+
+    write_record(1, 1, payload_a, sizeof(payload_a));
+    payload_a[0] = 0x55;
+
+    // Power goes halfway through the payload of the next save
+    mock_flash_fail_after(12);
+    TEST_ASSERT_TRUE(save_store_begin(1, 2, payload_a, sizeof(payload_a)));
+    while (save_store_step(4)) {
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, save_store_get_stats()->write_failures);
+
+    // Back on after the reset
+    mock_flash_fail_after(-1);
+    save_store_init();
+    TEST_ASSERT_EQUAL_UINT32(1, save_store_get_stats()->torn_records);
+    TEST_ASSERT_TRUE(save_store_find(1, &record));
+    TEST_ASSERT_EQUAL_UINT16(1, record.version);
+    TEST_ASSERT_EQUAL_HEX8(0, record.data[0]);
+
+    // New records go after the torn one
+    write_record(1, 3, payload_a, sizeof(payload_a));
+    TEST_ASSERT_TRUE(save_store_find(1, &record));
+    TEST_ASSERT_EQUAL_UINT16(3, record.version);
+}
+
+TEST(SaveStore, CorruptPayloadFallsBackToTheOlderRecord) {
+    SaveRecord record;
+
+    write_record(1, 1, payload_a, sizeof(payload_a));
+    write_record(1, 2, payload_a, sizeof(payload_a));
+    TEST_ASSERT_TRUE(save_store_find(1, &record));
+
+    // A bit of the newer payload reads back wrong
+    mock_flash_sector(0)[record.data - mock_flash_sector(0) + 10] ^= 0x01;
+
+    TEST_ASSERT_TRUE(save_store_find(1, &record));
+    TEST_ASSERT_EQUAL_UINT16(1, record.version);
+}
+
+TEST(SaveStore, RemovedKeyHasAnEmptyRecord) {
+    SaveRecord record;
+
+    write_record(1, 1, payload_a, sizeof(payload_a));
+    TEST_ASSERT_TRUE(save_store_remove(1));
+    while (save_store_step(4)) {
+    }
+
+    TEST_ASSERT_TRUE(save_store_find(1, &record));
+    TEST_ASSERT_EQUAL_UINT32(0, record.length);
+    TEST_ASSERT_TRUE(save_store_latest(&record));
+    TEST_ASSERT_EQUAL_UINT32(0, record.length);
+}
+
+TEST(SaveStore, FullSectorIsCompactedIntoTheOther) {
+    static uint8_t large[4096];
+    SaveRecord record;
+    uint16_t writes = 0;
+
+    write_record(2, 1, payload_b, sizeof(payload_b));
+    write_record(3, 1, payload_a, sizeof(payload_a));
+    TEST_ASSERT_TRUE(save_store_remove(3));
+    while (save_store_step(64)) {
+    }
+
+    // Each save marked with its number
+    large[0] = 1;
+    while (save_store_begin(1, 1, large, sizeof(large))) {
+        while (save_store_step(64)) {
+        }
+        large[0] = (uint8_t)(++writes + 1);
+    }
+    TEST_ASSERT_TRUE(save_store_needs_compaction());
+    TEST_ASSERT_EQUAL_UINT16(31, writes);
+
+    TEST_ASSERT_TRUE(save_store_compact());
+    TEST_ASSERT_EQUAL_UINT8(1, save_store_get_stats()->active_sector);
+    TEST_ASSERT_EQUAL_UINT32(1, mock_flash_erase_count(1));
+    TEST_ASSERT_FALSE(save_store_needs_compaction());
+
+    // Newest of each key survives, the removed key is gone
+    TEST_ASSERT_TRUE(save_store_find(1, &record));
+    TEST_ASSERT_EQUAL_UINT8(writes, record.data[0]);
+    TEST_ASSERT_TRUE(save_store_find(2, &record));
+    TEST_ASSERT_EQUAL_MEMORY(payload_b, record.data, sizeof(payload_b));
+    TEST_ASSERT_FALSE(save_store_find(3, &record));
+
+    // Remounting picks the newer generation
+    save_store_init();
+    TEST_ASSERT_EQUAL_UINT8(1, save_store_get_stats()->active_sector);
+    TEST_ASSERT_TRUE(save_store_find(2, &record));
+
+    // The next compaction goes back to the first sector
+    TEST_ASSERT_TRUE(save_store_compact());
+    TEST_ASSERT_EQUAL_UINT8(0, save_store_get_stats()->active_sector);
+    TEST_ASSERT_EQUAL_UINT32(2, mock_flash_erase_count(0));
+}
+
+TEST(SaveStore, CompactionCutShortKeepsTheOldSector) {
+    SaveRecord record;
+
+    write_record(1, 1, payload_a, sizeof(payload_a));
+    write_record(2, 1, payload_b, sizeof(payload_b));
+
+    mock_flash_fail_after(20);
+    TEST_ASSERT_FALSE(save_store_compact());
+
+    mock_flash_fail_after(-1);
+    save_store_init();
+    TEST_ASSERT_EQUAL_UINT8(0, save_store_get_stats()->active_sector);
+    TEST_ASSERT_TRUE(save_store_find(1, &record));
+    TEST_ASSERT_EQUAL_MEMORY(payload_a, record.data, sizeof(payload_a));
+    TEST_ASSERT_TRUE(save_store_find(2, &record));
+}
+
+TEST_GROUP_RUNNER(SaveStore) {
+    RUN_TEST_CASE(SaveStore, BlankFlashIsFormattedEmpty);
+    RUN_TEST_CASE(SaveStore, RecordIsWrittenInStepsAndOnlyVisibleWhenCommitted);
+    RUN_TEST_CASE(SaveStore, NewestRecordOfEachKeyWins);
+    RUN_TEST_CASE(SaveStore, WriteCutShortKeepsThePreviousRecord);
+    RUN_TEST_CASE(SaveStore, CorruptPayloadFallsBackToTheOlderRecord);
+    RUN_TEST_CASE(SaveStore, RemovedKeyHasAnEmptyRecord);
+    RUN_TEST_CASE(SaveStore, FullSectorIsCompactedIntoTheOther);
+    RUN_TEST_CASE(SaveStore, CompactionCutShortKeepsTheOldSector);
+}
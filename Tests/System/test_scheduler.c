@@ -0,0 +1,224 @@
+#include "unity.h"
+#include "unity_fixture.h"
+#include "System/scheduler.h"
+#include <string.h>
+
+// Virtual clock - time only moves when a task, the idle hook or the polling loop says so
+#define SYSTICK_US  1000
+#define POLL_US     50
+
+static uint32_t now_us;
+static uint32_t task_cost_us;
+static uint32_t last_idle_request_us;
+static char order[32];
+static uint8_t order_length;
+static uint8_t event_task;
+
+static uint32_t virtual_clock(void) {
+    return now_us;
+}
+
+// WFI returns on the next SysTick at the latest
+static void virtual_idle(uint32_t idle_us) {
+    last_idle_request_us = idle_us;
+    now_us += idle_us < SYSTICK_US ? idle_us : SYSTICK_US;
+}
+
+static void log_run(char name) {
+    if (order_length < sizeof(order) - 1) {
+        order[order_length++] = name;
+    }
+    now_us += task_cost_us;
+}
+
+static void task_a(void) { log_run('a'); }
+static void task_b(void) { log_run('b'); }
+static void task_e(void) { log_run('e'); }
+
+static void task_hog(void) {
+    log_run('h');
+    now_us += 35000;
+}
+
+static void task_a_signals_event(void) {
+    log_run('a');
+    scheduler_signal(event_task);
+}
+
+static void run_for(uint32_t duration_us) {
+    uint32_t end_us = now_us + duration_us;
+
+    while ((int32_t)(now_us - end_us) < 0) {
+        uint32_t before = now_us;
+        scheduler_run_once();
+        if (now_us == before) {
+            now_us += POLL_US;     // Polling a short gap still takes time
+        }
+    }
+}
+
+TEST_GROUP(Scheduler);
+
+TEST_SETUP(Scheduler) {
+    now_us = 0;
+    task_cost_us = 100;
+    last_idle_request_us = 0;
+    order_length = 0;
+    memset(order, 0, sizeof(order));
+    event_task = SCHEDULER_NO_TASK;
+    scheduler_init(virtual_clock, virtual_idle);
+}
+
+TEST_TEAR_DOWN(Scheduler) {
+}
+
+TEST(Scheduler, PeriodicTaskRunsOncePerPeriod) {
+    uint8_t id = scheduler_add_periodic("a", task_a, 10000, 10000);
+
+    run_for(105000);
+
+    const SchedulerTask* task = scheduler_get_task(id);
+    TEST_ASSERT_EQUAL_UINT32(10, task->runs);
+    TEST_ASSERT_EQUAL_UINT32(0, task->missed);
+    TEST_ASSERT_EQUAL_UINT32(0, task->skipped);
+    TEST_ASSERT_EQUAL_UINT32(100, task->max_run_us);
+}
+
+TEST(Scheduler, ReleasesStayOnTheGrid) {
+    // A 700 us task on a 10 ms period must not drift the next release
+    task_cost_us = 700;
+    uint8_t id = scheduler_add_periodic("a", task_a, 10000, 0);
+
+    run_for(95000);
+
+    TEST_ASSERT_EQUAL_UINT32(9, scheduler_get_task(id)->runs);
+    TEST_ASSERT_EQUAL_UINT32(100000, scheduler_get_task(id)->next_release_us);
+}
+
+TEST(Scheduler, EarlierTasksRunFirst) {
+    scheduler_add_periodic("a", task_a, 10000, 0);
+    scheduler_add_periodic("b", task_b, 10000, 0);
+
+    run_for(20500);
+
+    TEST_ASSERT_EQUAL_STRING("abab", order);
+}
+
+TEST(Scheduler, EventTaskRunsOnlyWhenSignalled) {
+    event_task = scheduler_add_event("e", task_e, 0);
+
+    run_for(30000);
+    TEST_ASSERT_EQUAL(0, order_length);
+
+    scheduler_signal(event_task);
+    scheduler_signal(event_task);   // Signals before it runs are one release
+    TEST_ASSERT_TRUE(scheduler_has_pending());
+    run_for(5000);
+
+    TEST_ASSERT_EQUAL_STRING("e", order);
+    TEST_ASSERT_FALSE(scheduler_has_pending());
+}
+
+TEST(Scheduler, EventSignalledByATaskRunsRightAfterIt) {
+    scheduler_add_periodic("a", task_a_signals_event, 16000, 16000);
+    event_task = scheduler_add_event("e", task_e, 16000);
+    scheduler_add_periodic("b", task_b, 16000, 0);
+
+    run_for(16000);
+    scheduler_run_once();
+    scheduler_run_once();
+    scheduler_run_once();
+
+    // The render-style event outranks the later periodic task
+    TEST_ASSERT_EQUAL_STRING("aeb", order);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler_get_task(event_task)->max_late_us);
+}
+
+TEST(Scheduler, SleepsUntilTheNextRelease) {
+    scheduler_add_periodic("a", task_a, 10000, 0);
+
+    // Nothing due at the start - the whole gap is offered to the idle hook
+    TEST_ASSERT_FALSE(scheduler_run_once());
+    TEST_ASSERT_EQUAL_UINT32(10000, last_idle_request_us);
+
+    run_for(100000);
+
+    const SchedulerStats* stats = scheduler_get_stats();
+    TEST_ASSERT_EQUAL_UINT32(1000, (uint32_t)stats->busy_us);
+    TEST_ASSERT_TRUE(stats->idle_us >= 90000);
+}
+
+TEST(Scheduler, ShortGapsArePolled) {
+    task_cost_us = 9500;
+    scheduler_add_periodic("a", task_a, 10000, 0);
+
+    run_for(10000);
+    scheduler_run_once();           // The task runs, 500 us are left
+    uint32_t idle_calls = scheduler_get_stats()->idle_calls;
+
+    TEST_ASSERT_FALSE(scheduler_run_once());
+    TEST_ASSERT_EQUAL_UINT32(idle_calls, scheduler_get_stats()->idle_calls);
+}
+
+TEST(Scheduler, LateFinishCountsAsDeadlineMiss) {
+    task_cost_us = 3000;
+    uint8_t id = scheduler_add_periodic("a", task_a, 10000, 2000);
+
+    run_for(50000);
+
+    const SchedulerTask* task = scheduler_get_task(id);
+    TEST_ASSERT_EQUAL_UINT32(task->runs, task->missed);
+    TEST_ASSERT_EQUAL_UINT32(3000, task->max_run_us);
+}
+
+TEST(Scheduler, OverrunSkipsReleasesInsteadOfBursting) {
+    uint8_t id = scheduler_add_periodic("a", task_a, 10000, 10000);
+    scheduler_add_periodic("h", task_hog, 100000, 0);
+
+    // At 100 ms the second task holds the core for 35 ms
+    run_for(101000);
+    scheduler_run_once();           // The 110 ms release runs late, 120 and 130 are dropped
+
+    const SchedulerTask* task = scheduler_get_task(id);
+    TEST_ASSERT_EQUAL_UINT32(2, task->skipped);
+    TEST_ASSERT_EQUAL_UINT32(1, task->missed);
+    TEST_ASSERT_EQUAL_UINT32(140000, task->next_release_us);
+
+    // Back on the grid - one run per period again
+    uint32_t runs = task->runs;
+    run_for(50000);
+    TEST_ASSERT_EQUAL_UINT32(runs + 5, task->runs);
+}
+
+TEST(Scheduler, ClockWrapKeepsThePeriod) {
+    now_us = 0xFFFFFFFFu - 25000;
+    scheduler_init(virtual_clock, virtual_idle);
+    uint8_t id = scheduler_add_periodic("a", task_a, 10000, 10000);
+
+    run_for(105000);
+
+    TEST_ASSERT_EQUAL_UINT32(10, scheduler_get_task(id)->runs);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler_get_task(id)->skipped);
+}
+
+TEST(Scheduler, TableHasAFixedSize) {
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        TEST_ASSERT_NOT_EQUAL(SCHEDULER_NO_TASK, scheduler_add_event("e", task_e, 0));
+    }
+    TEST_ASSERT_EQUAL(SCHEDULER_NO_TASK, scheduler_add_event("e", task_e, 0));
+    TEST_ASSERT_EQUAL(SCHEDULER_NO_TASK, scheduler_add_periodic("a", task_a, 0, 0));
+}
+
+TEST_GROUP_RUNNER(Scheduler) {
+    RUN_TEST_CASE(Scheduler, PeriodicTaskRunsOncePerPeriod);
+    RUN_TEST_CASE(Scheduler, ReleasesStayOnTheGrid);
+    RUN_TEST_CASE(Scheduler, EarlierTasksRunFirst);
+    RUN_TEST_CASE(Scheduler, EventTaskRunsOnlyWhenSignalled);
+    RUN_TEST_CASE(Scheduler, EventSignalledByATaskRunsRightAfterIt);
+    RUN_TEST_CASE(Scheduler, SleepsUntilTheNextRelease);
+    RUN_TEST_CASE(Scheduler, ShortGapsArePolled);
+    RUN_TEST_CASE(Scheduler, LateFinishCountsAsDeadlineMiss);
+    RUN_TEST_CASE(Scheduler, OverrunSkipsReleasesInsteadOfBursting);
+    RUN_TEST_CASE(Scheduler, ClockWrapKeepsThePeriod);
+    RUN_TEST_CASE(Scheduler, TableHasAFixedSize);
+}
@@ -3,14 +3,38 @@
 static void RunAllTests(void) {
     RUN_TEST_GROUP(Joystick);
     RUN_TEST_GROUP(PushButton);
-    RUN_TEST_GROUP(OLED);
+    // RUN_TEST_GROUP(OLED);
     RUN_TEST_GROUP(GameMenu);
     RUN_TEST_GROUP(GameEngine);
     RUN_TEST_GROUP(Sprite);
     RUN_TEST_GROUP(SnakeGame);
     RUN_TEST_GROUP(PacmanGameMaze);
+    RUN_TEST_GROUP(GameViewport);
     RUN_TEST_GROUP(PacmanGame);
+    RUN_TEST_GROUP(Collision);
+    RUN_TEST_GROUP(GameArena);
+    RUN_TEST_GROUP(GameRegistry);
+    RUN_TEST_GROUP(GameEngineInput);
     RUN_TEST_GROUP(DPad);
+    RUN_TEST_GROUP(InputEvents);
+    RUN_TEST_GROUP(LatencyProbe);
+    RUN_TEST_GROUP(Scheduler);
+    RUN_TEST_GROUP(GameTimer);
+    RUN_TEST_GROUP(UiScreen);
+    RUN_TEST_GROUP(GameRandom);
+    RUN_TEST_GROUP(Replay);
+    RUN_TEST_GROUP(SaveStore);
+    RUN_TEST_GROUP(GameSave);
+    RUN_TEST_GROUP(SerialRx);
+    RUN_TEST_GROUP(SerialTx);
+    RUN_TEST_GROUP(SerialFrame);
+    RUN_TEST_GROUP(SerialCrc);
+    RUN_TEST_GROUP(CircularBuffer);
+    RUN_TEST_GROUP(SerialSlots);
+    RUN_TEST_GROUP(SerialGameState);
+    RUN_TEST_GROUP(MpSnakePrediction);
+    RUN_TEST_GROUP(MpSnakeBodySync);
+    RUN_TEST_GROUP(MpSnakeJitter);
     // RUN_TEST_GROUP(Audio);
 }
 
@@ -0,0 +1,116 @@
+#include "body_sync_encoder.h"
+#include <string.h>
+
+// Move that takes a snake from one cell to its neighbour. A step of more than one cell is the
+// move that wrapped around the edge of the grid.
+static bool move_code(uint8_t from_x, uint8_t from_y, uint8_t to_x, uint8_t to_y, uint8_t* code) {
+    int dx = (int)to_x - (int)from_x;
+    int dy = (int)to_y - (int)from_y;
+
+    if (dy == 0 && dx != 0) {
+        *code = (dx == 1 || dx < -1) ? BODY_SYNC_CODE_RIGHT : BODY_SYNC_CODE_LEFT;
+        return true;
+    }
+    if (dx == 0 && dy != 0) {
+        *code = (dy == 1 || dy < -1) ? BODY_SYNC_CODE_DOWN : BODY_SYNC_CODE_UP;
+        return true;
+    }
+    return false;
+}
+
+// Code of segment index, the move out of it towards the head
+static bool segment_code(const game_state_player_t* player, uint8_t index, uint8_t* code) {
+    uint8_t to_x = (index == 0) ? player->head_x : player->body_x[index - 1];
+    uint8_t to_y = (index == 0) ? player->head_y : player->body_y[index - 1];
+
+    return move_code(player->body_x[index], player->body_y[index], to_x, to_y, code);
+}
+
+static void write_header(uint8_t* out, uint8_t kind, uint8_t player_id, uint32_t tick) {
+    out[0] = kind;
+    out[1] = player_id;
+    out[2] = (uint8_t)(tick & 0xFF);
+    out[3] = (uint8_t)((tick >> 8) & 0xFF);
+    out[4] = (uint8_t)((tick >> 16) & 0xFF);
+    out[5] = (uint8_t)((tick >> 24) & 0xFF);
+}
+
+static size_t encode_keyframe(uint8_t player_id, uint32_t tick, const game_state_player_t* player, uint8_t* out) {
+    uint8_t* codes = &out[BODY_SYNC_KEYFRAME_HEADER_SIZE];
+
+    memset(codes, 0, BODY_SYNC_CODE_BYTES(player->body_length));
+    for (uint8_t i = 0; i < player->body_length; i++) {
+        uint8_t code;
+        if (!segment_code(player, i, &code)) {
+            return 0;
+        }
+        codes[i / 4] |= (uint8_t)(code << (2 * (i % 4)));
+    }
+
+    write_header(out, BODY_SYNC_KIND_KEYFRAME, player_id, tick);
+    out[6] = player->head_x;
+    out[7] = player->head_y;
+    out[8] = player->body_length;
+    return BODY_SYNC_KEYFRAME_SIZE(player->body_length);
+}
+
+// The last moves are the codes of the segments the old head moved through, newest first
+static size_t encode_delta(const body_sync_track_t* track, uint8_t player_id, uint32_t tick,
+    const game_state_player_t* player, uint8_t* out) {
+    uint8_t move_count = (uint8_t)(tick - track->tick);
+    uint8_t moves = 0;
+
+    if (player->body_length < move_count ||
+        player->body_x[move_count - 1] != track->head_x || player->body_y[move_count - 1] != track->head_y) {
+        return 0;
+    }
+
+    for (uint8_t i = 0; i < move_count; i++) {
+        uint8_t code;
+        if (!segment_code(player, move_count - 1 - i, &code)) {
+            return 0;
+        }
+        moves |= (uint8_t)(code << (2 * i));
+    }
+
+    write_header(out, BODY_SYNC_KIND_DELTA, player_id, tick);
+    out[6] = move_count;
+    out[7] = moves;
+    out[8] = player->body_length;
+    return BODY_SYNC_DELTA_SIZE;
+}
+
+void body_sync_reset(body_sync_track_t* track) {
+    memset(track, 0, sizeof(*track));
+}
+
+size_t body_sync_encode(body_sync_track_t* track, uint8_t player_id, uint32_t tick,
+    const game_state_player_t* player, uint8_t* out) {
+    size_t length = 0;
+
+    if (!track || !player || !out || player->body_length > BODY_SYNC_MAX_SEGMENTS) {
+        return 0;
+    }
+
+    // Deltas need the STM32 to hold the previous tick, and only carry a few moves
+    uint32_t elapsed = tick - track->tick;
+    if (track->valid && elapsed >= 1 && elapsed <= BODY_SYNC_MAX_MOVES &&
+        tick - track->keyframe_tick < BODY_SYNC_KEYFRAME_INTERVAL) {
+        length = encode_delta(track, player_id, tick, player, out);
+    }
+
+    if (length == 0) {
+        length = encode_keyframe(player_id, tick, player, out);
+        if (length == 0) {
+            track->valid = false;
+            return 0;
+        }
+        track->keyframe_tick = tick;
+    }
+
+    track->valid = true;
+    track->tick = tick;
+    track->head_x = player->head_x;
+    track->head_y = player->head_y;
+    return length;
+}
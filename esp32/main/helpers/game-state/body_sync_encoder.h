@@ -0,0 +1,50 @@
+#ifndef BODY_SYNC_ENCODER_H
+#define BODY_SYNC_ENCODER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "game_state_encoder.h"
+
+// Body Sync Message - must match the STM32's serial_comm_types.h
+// One player's body as 2-bit moves, code k is the move from body segment k to segment k - 1,
+// the head being segment -1. Codes are packed four to a byte, code k at bits 2 * (k % 4).
+// Keyframe, the whole body anchored at the head:
+//   kind (1) | player id (1) | tick (4) | head x (1) | head y (1) | length (1) | codes
+// Delta, the moves since the previous tick it was sent for, oldest in the low bits, and the
+// length after them; the tail is trimmed to it:
+//   kind (1) | player id (1) | tick (4) | move count (1) | moves (1) | length (1)
+#define BODY_SYNC_KIND_KEYFRAME         1
+#define BODY_SYNC_KIND_DELTA            2
+#define BODY_SYNC_MAX_SEGMENTS          64
+#define BODY_SYNC_MAX_MOVES             4
+#define BODY_SYNC_CODE_BYTES(segments)  (((segments) + 3) / 4)
+#define BODY_SYNC_KEYFRAME_HEADER_SIZE  9
+#define BODY_SYNC_KEYFRAME_SIZE(segments) (BODY_SYNC_KEYFRAME_HEADER_SIZE + BODY_SYNC_CODE_BYTES(segments))
+#define BODY_SYNC_DELTA_SIZE            9
+#define BODY_SYNC_MAX_SIZE              BODY_SYNC_KEYFRAME_SIZE(BODY_SYNC_MAX_SEGMENTS)
+#define BODY_SYNC_CODE_UP               0
+#define BODY_SYNC_CODE_RIGHT            1
+#define BODY_SYNC_CODE_DOWN             2
+#define BODY_SYNC_CODE_LEFT             3
+
+#define BODY_SYNC_KEYFRAME_INTERVAL     32  // Ticks between keyframes, bounds how long a lost delta shows
+
+// What the STM32 was last sent for one player
+typedef struct {
+    bool valid;
+    uint32_t tick;
+    uint32_t keyframe_tick;
+    uint8_t head_x;
+    uint8_t head_y;
+} body_sync_track_t;
+
+void body_sync_reset(body_sync_track_t* track);
+
+// Writes a delta for the player's body at tick, or a keyframe when one is due or the body does
+// not follow on from the last one sent. out holds BODY_SYNC_MAX_SIZE bytes. Returns the length,
+// 0 if the body is not a chain of neighbouring cells and nothing can be sent.
+size_t body_sync_encode(body_sync_track_t* track, uint8_t player_id, uint32_t tick,
+    const game_state_player_t* player, uint8_t* out);
+
+#endif // BODY_SYNC_ENCODER_H
@@ -0,0 +1,263 @@
+#include "game_state_encoder.h"
+#include <string.h>
+
+#define SKIP_DEPTH_LIMIT 4
+
+// Fields every record has to carry
+#define STATE_HAS_TICK      0x01
+#define STATE_HAS_FOOD      0x02
+#define STATE_HAS_PLAYERS   0x04
+#define STATE_HAS_ALL       (STATE_HAS_TICK | STATE_HAS_FOOD | STATE_HAS_PLAYERS)
+
+#define PLAYER_HAS_HEAD         0x01
+#define PLAYER_HAS_LENGTH       0x02
+#define PLAYER_HAS_DIRECTION    0x04
+#define PLAYER_HAS_ALIVE        0x08
+#define PLAYER_HAS_SCORE        0x10
+#define PLAYER_HAS_ALL          0x1F
+
+static bool skip_value(cmp_ctx_t* cmp, const cmp_object_t* obj, uint8_t depth) {
+    uint32_t size = 0;
+    int8_t ext_type;
+
+    if (cmp_object_as_str(obj, &size) || cmp_object_as_bin(obj, &size) ||
+        cmp_object_as_ext(obj, &ext_type, &size)) {
+        return size == 0 || cmp->skip(cmp, size);
+    }
+
+    uint32_t children = 0;
+    if (cmp_object_as_array(obj, &size)) {
+        children = size;
+    }
+    else if (cmp_object_as_map(obj, &size)) {
+        children = size * 2;
+    }
+    else {
+        return true; // Scalars are read whole with the object
+    }
+
+    if (depth == 0) {
+        return false;
+    }
+    for (uint32_t i = 0; i < children; i++) {
+        cmp_object_t child;
+        if (!cmp_read_object(cmp, &child) || !skip_value(cmp, &child, depth - 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool read_key(cmp_ctx_t* cmp, char* key, uint32_t size) {
+    cmp_object_t key_obj;
+    uint32_t key_length;
+
+    if (!cmp_read_object(cmp, &key_obj) || !cmp_object_as_str(&key_obj, &key_length)) {
+        return false;
+    }
+    if (key_length >= size) {
+        // Longer than any key we know, skip it and match nothing
+        key[0] = '\0';
+        return key_length == 0 || cmp->skip(cmp, key_length);
+    }
+    return cmp_object_to_str(cmp, &key_obj, key, size);
+}
+
+static bool read_uint(const cmp_object_t* obj, uint32_t max, uint32_t* value) {
+    uint64_t wide;
+    int64_t signed_wide;
+
+    // Some encoders send small non-negative numbers as signed types
+    if (!cmp_object_as_uinteger(obj, &wide)) {
+        if (!cmp_object_as_sinteger(obj, &signed_wide) || signed_wide < 0) {
+            return false;
+        }
+        wide = (uint64_t)signed_wide;
+    }
+    if (wide > max) {
+        return false;
+    }
+    *value = (uint32_t)wide;
+    return true;
+}
+
+static bool read_u8(const cmp_object_t* obj, uint8_t* value) {
+    uint32_t wide;
+
+    if (!read_uint(obj, UINT8_MAX, &wide)) {
+        return false;
+    }
+    *value = (uint8_t)wide;
+    return true;
+}
+
+// [x, y] in server cells
+static bool read_position(cmp_ctx_t* cmp, const cmp_object_t* obj, uint8_t* x, uint8_t* y) {
+    cmp_object_t coord;
+    uint32_t size;
+
+    if (!cmp_object_as_array(obj, &size) || size != 2) {
+        return false;
+    }
+    return cmp_read_object(cmp, &coord) && read_u8(&coord, x) &&
+        cmp_read_object(cmp, &coord) && read_u8(&coord, y);
+}
+
+static bool read_body(cmp_ctx_t* cmp, const cmp_object_t* obj, game_state_player_t* player) {
+    uint32_t size;
+
+    if (!cmp_object_as_array(obj, &size) || size > GAME_STATE_MAX_BODY) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < size; i++) {
+        cmp_object_t cell;
+        if (!cmp_read_object(cmp, &cell) ||
+            !read_position(cmp, &cell, &player->body_x[i], &player->body_y[i])) {
+            return false;
+        }
+    }
+    player->body_length = (uint8_t)size;
+    return true;
+}
+
+static bool read_player(cmp_ctx_t* cmp, const cmp_object_t* obj, game_state_player_t* player) {
+    uint32_t map_size;
+    uint8_t found = 0;
+
+    if (!cmp_object_as_map(obj, &map_size)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < map_size; i++) {
+        char key[16];
+        cmp_object_t value;
+        uint32_t wide;
+
+        if (!read_key(cmp, key, sizeof(key)) || !cmp_read_object(cmp, &value)) {
+            return false;
+        }
+
+        if (strcmp(key, "head") == 0) {
+            if (!read_position(cmp, &value, &player->head_x, &player->head_y)) return false;
+            found |= PLAYER_HAS_HEAD;
+        }
+        else if (strcmp(key, "length") == 0) {
+            if (!read_u8(&value, &player->length)) return false;
+            found |= PLAYER_HAS_LENGTH;
+        }
+        else if (strcmp(key, "direction") == 0) {
+            if (!read_u8(&value, &player->direction)) return false;
+            found |= PLAYER_HAS_DIRECTION;
+        }
+        else if (strcmp(key, "alive") == 0) {
+            if (!cmp_object_as_bool(&value, &player->alive)) return false;
+            found |= PLAYER_HAS_ALIVE;
+        }
+        else if (strcmp(key, "score") == 0) {
+            if (!read_uint(&value, UINT16_MAX, &wide)) return false;
+            player->score = (uint16_t)wide;
+            found |= PLAYER_HAS_SCORE;
+        }
+        else if (strcmp(key, "input") == 0) {
+            if (!read_uint(&value, UINT16_MAX, &wide)) return false;
+            player->input_ack = (uint16_t)wide;
+        }
+        else if (strcmp(key, "body") == 0) {
+            if (!read_body(cmp, &value, player)) return false;
+        }
+        else if (!skip_value(cmp, &value, SKIP_DEPTH_LIMIT)) {
+            return false;
+        }
+    }
+
+    return found == PLAYER_HAS_ALL;
+}
+
+static bool read_players(cmp_ctx_t* cmp, const cmp_object_t* obj, game_state_t* state) {
+    uint32_t count;
+
+    if (!cmp_object_as_array(obj, &count) || count > GAME_STATE_MAX_PLAYERS) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        cmp_object_t player;
+        if (!cmp_read_object(cmp, &player) || !read_player(cmp, &player, &state->players[i])) {
+            return false;
+        }
+    }
+    state->player_count = (uint8_t)count;
+    return true;
+}
+
+bool game_state_read_msgpack(cmp_ctx_t* cmp, uint32_t map_size, game_state_t* state) {
+    uint8_t found = 0;
+
+    if (!cmp || !state) {
+        return false;
+    }
+    memset(state, 0, sizeof(*state));
+
+    for (uint32_t i = 0; i < map_size; i++) {
+        char key[16];
+        cmp_object_t value;
+
+        if (!read_key(cmp, key, sizeof(key)) || !cmp_read_object(cmp, &value)) {
+            return false;
+        }
+
+        if (strcmp(key, "tick") == 0) {
+            if (!read_uint(&value, UINT32_MAX, &state->tick)) return false;
+            found |= STATE_HAS_TICK;
+        }
+        else if (strcmp(key, "food") == 0) {
+            if (!read_position(cmp, &value, &state->food_x, &state->food_y)) return false;
+            found |= STATE_HAS_FOOD;
+        }
+        else if (strcmp(key, "players") == 0) {
+            if (!read_players(cmp, &value, state)) return false;
+            found |= STATE_HAS_PLAYERS;
+        }
+        else if (!skip_value(cmp, &value, SKIP_DEPTH_LIMIT)) {
+            return false;
+        }
+    }
+
+    return found == STATE_HAS_ALL;
+}
+
+size_t game_state_encode(const game_state_t* state, uint8_t* out) {
+    uint8_t player_count = state->player_count;
+
+    if (player_count > GAME_STATE_MAX_PLAYERS) {
+        player_count = GAME_STATE_MAX_PLAYERS;
+    }
+
+    out[0] = GAME_STATE_VERSION;
+    out[1] = player_count;
+    out[2] = (uint8_t)(state->tick & 0xFF);
+    out[3] = (uint8_t)((state->tick >> 8) & 0xFF);
+    out[4] = (uint8_t)((state->tick >> 16) & 0xFF);
+    out[5] = (uint8_t)((state->tick >> 24) & 0xFF);
+    out[6] = state->food_x;
+    out[7] = state->food_y;
+
+    uint8_t* record = &out[GAME_STATE_HEADER_SIZE];
+    for (uint8_t i = 0; i < player_count; i++) {
+        const game_state_player_t* player = &state->players[i];
+
+        record[0] = player->head_x;
+        record[1] = player->head_y;
+        record[2] = player->length;
+        record[3] = player->direction;
+        record[4] = player->alive ? GAME_STATE_FLAG_ALIVE : 0;
+        record[5] = (uint8_t)(player->score & 0xFF);
+        record[6] = (uint8_t)(player->score >> 8);
+        record[7] = (uint8_t)(player->input_ack & 0xFF);
+        record[8] = (uint8_t)(player->input_ack >> 8);
+        record += GAME_STATE_PLAYER_SIZE;
+    }
+
+    return GAME_STATE_SIZE(player_count);
+}
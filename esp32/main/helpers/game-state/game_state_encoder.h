@@ -0,0 +1,59 @@
+#ifndef GAME_STATE_ENCODER_H
+#define GAME_STATE_ENCODER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "../../../components/cmp/cmp.h"
+
+// Game State Message - must match the STM32's serial_comm_types.h
+// Little-endian, fixed field widths, positions in server cells:
+//   version (1) | player count (1) | tick (4) | food x (1) | food y (1) | player records
+// and each player record, in player id order:
+//   head x (1) | head y (1) | length (1) | direction (1) | flags (1) | score (2) | input ack (2)
+// input ack is the sequence of the last of the player's inputs the server applied.
+#define GAME_STATE_VERSION          2
+#define GAME_STATE_MAX_PLAYERS      2
+#define GAME_STATE_HEADER_SIZE      8
+#define GAME_STATE_PLAYER_SIZE      9
+#define GAME_STATE_SIZE(players)    (GAME_STATE_HEADER_SIZE + (players) * GAME_STATE_PLAYER_SIZE)
+#define GAME_STATE_MAX_SIZE         GAME_STATE_SIZE(GAME_STATE_MAX_PLAYERS)
+#define GAME_STATE_FLAG_ALIVE       0x01
+#define GAME_STATE_MAX_BODY         64  // Body cells kept per player, for body sync
+
+typedef struct {
+    uint8_t head_x;
+    uint8_t head_y;
+    uint8_t length;
+    uint8_t direction;
+    bool alive;
+    uint16_t score;
+    uint16_t input_ack;
+    uint8_t body_length;                    // 0 if the server sent no body
+    uint8_t body_x[GAME_STATE_MAX_BODY];    // Segment 0 next to the head
+    uint8_t body_y[GAME_STATE_MAX_BODY];
+} game_state_player_t;
+
+typedef struct {
+    uint32_t tick;
+    uint8_t food_x;
+    uint8_t food_y;
+    uint8_t player_count;
+    game_state_player_t players[GAME_STATE_MAX_PLAYERS];
+} game_state_t;
+
+// Reads the server's state map, the "data" value of a game_state or player_update message:
+//   { "tick": uint, "food": [x, y],
+//     "players": [ { "head": [x, y], "length": uint, "direction": uint, "alive": bool, "score": uint,
+//                    "input": uint, "body": [[x, y], ...] } ] }
+// "input" is optional, 0 when the server has applied none of the player's inputs.
+// "body" is optional, the segments behind the head; it is not part of the game state message
+// but is sent as body sync, see body_sync_encoder.h.
+// Keys may come in any order, unknown keys are skipped. The map header has already been read.
+// False if a field is missing or does not fit its width.
+bool game_state_read_msgpack(cmp_ctx_t* cmp, uint32_t map_size, game_state_t* state);
+
+// Writes the message into out, which holds GAME_STATE_MAX_SIZE bytes. Returns its length.
+size_t game_state_encode(const game_state_t* state, uint8_t* out);
+
+#endif // GAME_STATE_ENCODER_H
@@ -164,6 +164,11 @@ esp_err_t ws_to_server_convert_game_data(const uart_game_data_t* uart_msg,
     if (strlen(uart_msg->metadata) > 0) {
         map_size++;
     }
+    // Inputs carry the sequence the game state acknowledges them by
+    bool is_input = (strcmp(uart_msg->data_type, "player_action") == 0);
+    if (is_input) {
+        map_size++;
+    }
 
     // Write the map header
     if (!cmp_write_map(&cmp, map_size)) {
@@ -199,6 +204,15 @@ esp_err_t ws_to_server_convert_game_data(const uart_game_data_t* uart_msg,
         return ESP_FAIL;
     }
 
+    // Write "sequence" field for inputs
+    if (is_input) {
+        if (!cmp_write_str(&cmp, "sequence", 8) ||
+            !cmp_write_uint(&cmp, uart_msg->sequence_num)) {
+            ESP_LOGE(TAG, "Failed to write sequence field");
+            return ESP_FAIL;
+        }
+    }
+
     // Write "metadata" field if provided
     if (strlen(uart_msg->metadata) > 0) {
         if (!cmp_write_str(&cmp, "metadata", 8) ||
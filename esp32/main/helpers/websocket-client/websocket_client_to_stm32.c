@@ -1,8 +1,12 @@
 #include "websocket_client_to_stm32.h"
 #include "esp_log.h"
+#include "body_sync_encoder.h"
 
 static const char* TAG = "WS_TO_STM32";
 
+// What each player's body on the STM32 was last synced to
+static body_sync_track_t body_tracks[GAME_STATE_MAX_PLAYERS];
+
 // WebSocket → STM32 conversion functions
 void ws_to_stm32_handle_connection_message(const char* message_id, const char* message_text) {
     ESP_LOGI(TAG, "Handling server connection message: id=%s, message=%s",
@@ -85,6 +89,30 @@ void ws_to_stm32_handle_game_data(const char* data_type, const char* game_data,
         metadata ? metadata : "");
 }
 
+void ws_to_stm32_handle_game_state(const game_state_t* state) {
+    ESP_LOGI(TAG, "Handling server game state: tick=%lu, players=%d",
+        state->tick, state->player_count);
+
+    // Forward as the binary game state message, the STM32 reads it without parsing text
+    uart_send_game_state(state);
+
+    // Bodies follow as their own messages, mostly a few bytes of moves since the last tick
+    for (uint8_t i = 0; i < state->player_count; i++) {
+        uint8_t payload[BODY_SYNC_MAX_SIZE];
+        size_t length;
+
+        if (state->players[i].body_length == 0) {
+            continue;
+        }
+        length = body_sync_encode(&body_tracks[i], i + 1, state->tick, &state->players[i], payload);
+        if (length == 0) {
+            ESP_LOGW(TAG, "Player %d body is not a chain of cells, not synced", i + 1);
+            continue;
+        }
+        uart_send_body_sync(payload, length);
+    }
+}
+
 // Specific StatusMessage handlers
 void ws_to_stm32_handle_player_assignment(const char* player_data) {
     ESP_LOGI(TAG, "Handling player assignment: %s", player_data ? player_data : "null");
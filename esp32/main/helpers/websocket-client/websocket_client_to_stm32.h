@@ -13,6 +13,7 @@ void ws_to_stm32_handle_command_message(const char* command, const char* command
     const char* session_id);
 void ws_to_stm32_handle_game_data(const char* data_type, const char* game_data,
     const char* metadata, const char* session_id);
+void ws_to_stm32_handle_game_state(const game_state_t* state);
 void ws_to_stm32_handle_chat_message(const char* message, const char* metadata);
 
 // Specific StatusMessage handlers
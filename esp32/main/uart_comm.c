@@ -7,13 +7,15 @@ static const char* TAG = "UART_COMM";
 static QueueHandle_t uart_queue = NULL;
 static TaskHandle_t uart_task_handle = NULL;
 static bool uart_initialized = false;
+static uint16_t tx_sequence = 0;
 
 // Statistics
 static struct {
     uint32_t messages_sent;
     uint32_t messages_received;
     uint32_t errors;
-    uint32_t checksum_errors;
+    uint32_t crc_errors;
+    uint32_t frames_lost;       // Gaps in the received sequence numbers
 } uart_stats = { 0 };
 
 // Callback functions
@@ -27,7 +29,8 @@ static uart_tile_size_validation_callback_t tile_size_validation_callback = NULL
 
 // Private function declarations
 static void uart_event_task(void* pvParameters);
-static uint8_t calculate_checksum(const uint8_t* data, size_t length);
+static size_t frame_encode(const uart_message_t* msg, uint16_t sequence, uint8_t* wire);
+static bool frame_decode(uint8_t* buffer, size_t length, uart_message_t* msg, uint16_t* sequence);
 static bool validate_message(const uart_message_t* msg);
 static void process_received_message(const uart_message_t* msg);
 static esp_err_t uart_send_raw_message(const uart_message_t* msg);
@@ -74,49 +77,50 @@ void uart_deinit_ack_system(void) {
     ack_tracker.waiting_for_ack = false;
 }
 
-// Calculate simple checksum
-static uint8_t calculate_checksum(const uint8_t* data, size_t length) {
-    uint8_t checksum = 0;
-    // Calculate checksum for all bytes except checksum and end_byte (last 2 bytes)
-    for (size_t i = 0; i < length - 2; i++) {
-        checksum ^= data[i];
-    }
-    ESP_LOGD(TAG, "Calculated checksum: 0x%02X for %zu bytes", checksum, length - 2);
-    return checksum;
+// Whole frame with both delimiters, wire holds SERIAL_FRAME_MAX_WIRE_SIZE bytes
+static size_t frame_encode(const uart_message_t* msg, uint16_t sequence, uint8_t* wire) {
+    return serial_frame_encode(msg->msg_type, sequence, msg->data, msg->length, wire);
 }
 
-// Validate received message
-static bool validate_message(const uart_message_t* msg) {
-    // Check start and end bytes
-    if (msg->start_byte != 0xAA || msg->end_byte != 0x55) {
-        ESP_LOGW(TAG, "Invalid message delimiters: start=0x%02X, end=0x%02X",
-            msg->start_byte, msg->end_byte);
+// Decode the bytes between two delimiters into msg
+static bool frame_decode(uint8_t* buffer, size_t length, uart_message_t* msg, uint16_t* sequence) {
+    serial_frame_t frame;
+    serial_frame_status_t status = serial_frame_decode(buffer, (uint16_t)length, &frame);
+    if (status == SERIAL_FRAME_BAD_CRC) {
+        ESP_LOGW(TAG, "CRC mismatch in a %zu byte frame", length);
+        uart_stats.crc_errors++;
+        return false;
+    }
+    if (status != SERIAL_FRAME_OK) {
+        ESP_LOGW(TAG, "Malformed frame: %zu bytes", length);
         return false;
     }
 
+    memset(msg, 0, sizeof(*msg));
+    msg->start_byte = 0xAA;
+    msg->msg_type = frame.type;
+    msg->length = frame.length;
+    memcpy(msg->data, frame.payload, frame.length);
+    msg->end_byte = 0x55;
+    *sequence = frame.sequence;
+    return true;
+}
+
+// Validate received message - framing and CRC were checked when it was decoded
+static bool validate_message(const uart_message_t* msg) {
     // Check message type
-    if (msg->msg_type < UART_MSG_GAME_DATA || msg->msg_type > UART_MSG_TILE_SIZE_VALIDATION) {
+    if (msg->msg_type < UART_MSG_GAME_DATA || msg->msg_type > UART_MSG_BODY_SYNC) {
         ESP_LOGW(TAG, "Invalid message type: 0x%02X", msg->msg_type);
         return false;
     }
 
 
     // Check length
-    if (msg->length > 250) {
+    if (msg->length > SERIAL_FRAME_MAX_PAYLOAD) {
         ESP_LOGW(TAG, "Invalid message length: %d", msg->length);
         return false;
     }
 
-    // Calculate and verify checksum
-    uint8_t calculated_checksum = calculate_checksum((const uint8_t*)msg,
-        sizeof(uart_message_t) - 1);
-    if (msg->checksum != calculated_checksum) {
-        ESP_LOGW(TAG, "Checksum mismatch: expected=0x%02X, calculated=0x%02X",
-            msg->checksum, calculated_checksum);
-        uart_stats.checksum_errors++;
-        return false;
-    }
-
     return true;
 }
 
@@ -239,10 +243,14 @@ static esp_err_t uart_send_raw_message(const uart_message_t* msg) {
 
     // print_message_hex("SENDING", msg);
 
-    int bytes_written = uart_write_bytes(UART_PORT_NUM, msg, sizeof(uart_message_t));
-    if (bytes_written != sizeof(uart_message_t)) {
-        ESP_LOGE(TAG, "Failed to write complete message: %d/%zu bytes",
-            bytes_written, sizeof(uart_message_t));
+    // Only the used part of the payload goes on the wire
+    uint8_t wire[SERIAL_FRAME_MAX_WIRE_SIZE];
+    size_t wire_length = frame_encode(msg, tx_sequence++, wire);
+
+    int bytes_written = uart_write_bytes(UART_PORT_NUM, wire, wire_length);
+    if (bytes_written != (int)wire_length) {
+        ESP_LOGE(TAG, "Failed to write complete frame: %d/%zu bytes",
+            bytes_written, wire_length);
         uart_stats.errors++;
         return ESP_FAIL;
     }
@@ -251,8 +259,8 @@ static esp_err_t uart_send_raw_message(const uart_message_t* msg) {
     vTaskDelay(pdMS_TO_TICKS(10));
 
     uart_stats.messages_sent++;
-    ESP_LOGI(TAG, "Sent message type: 0x%02X, length: %d, total size: %zu",
-        msg->msg_type, msg->length, sizeof(uart_message_t));
+    ESP_LOGI(TAG, "Sent message type: 0x%02X, length: %d, frame size: %zu",
+        msg->msg_type, msg->length, wire_length);
     return ESP_OK;
 }
 
@@ -260,9 +268,12 @@ static esp_err_t uart_send_raw_message(const uart_message_t* msg) {
 static void uart_event_task(void* pvParameters) {
     uart_event_t event;
     uint8_t* data_buffer = (uint8_t*)malloc(UART_RX_BUFFER_SIZE);
+    static uint8_t frame[SERIAL_FRAME_MAX_ENCODED_SIZE];
+    message_parser_t parser;        // Splits the stream at the delimiters, like the STM32's receiver
     uart_message_t msg;
-    size_t msg_index = 0;
-    bool receiving_message = false;
+    uint16_t sequence;
+    uint16_t sequence_expected = 0;
+    bool sequence_valid = false;
 
     if (!data_buffer) {
         ESP_LOGE(TAG, "Failed to allocate data buffer");
@@ -270,6 +281,7 @@ static void uart_event_task(void* pvParameters) {
         return;
     }
 
+    message_parser_init(&parser, frame, sizeof(frame));
     ESP_LOGI(TAG, "UART event task started");
 
     while (1) {
@@ -280,40 +292,32 @@ static void uart_event_task(void* pvParameters) {
                 int len = uart_read_bytes(UART_PORT_NUM, data_buffer,
                     event.size, pdMS_TO_TICKS(100));
 
-                if (len > 0) {
-                    // Process received bytes
-                    for (int i = 0; i < len; i++) {
-                        uint8_t byte = data_buffer[i];
+                // Collect bytes up to each delimiter, then decode the frame
+                for (int i = 0; i < len; ) {
+                    uint32_t oversized = parser.oversized_frames;
+                    i += message_parser_add_delimited(&parser, &data_buffer[i], (uint16_t)(len - i),
+                        SERIAL_FRAME_DELIMITER);
+                    if (parser.oversized_frames != oversized) {
+                        ESP_LOGW(TAG, "Frame too long, skipping to the next delimiter");
+                        uart_stats.errors++;
+                    }
+                    if (!message_parser_is_complete(&parser)) {
+                        continue;
+                    }
 
-                        if (!receiving_message && byte == 0xAA) {
-                            // Start of new message
-                            receiving_message = true;
-                            msg_index = 0;
-                            ((uint8_t*)&msg)[msg_index++] = byte;
-                        }
-                        else if (receiving_message) {
-                            ((uint8_t*)&msg)[msg_index++] = byte;
-
-                            // Check if we have a complete message
-                            if (msg_index >= sizeof(uart_message_t)) {
-                                if (validate_message(&msg)) {
-                                    process_received_message(&msg);
-                                }
-                                else {
-                                    uart_stats.errors++;
-                                }
-                                receiving_message = false;
-                                msg_index = 0;
-                            }
-
-                            // Reset if message is too long
-                            if (msg_index >= sizeof(uart_message_t)) {
-                                receiving_message = false;
-                                msg_index = 0;
-                                ESP_LOGW(TAG, "Message too long, resetting");
-                            }
+                    if (frame_decode(frame, message_parser_get_length(&parser), &msg, &sequence)
+                        && validate_message(&msg)) {
+                        if (sequence_valid && sequence != sequence_expected) {
+                            uart_stats.frames_lost += (uint16_t)(sequence - sequence_expected);
                         }
+                        sequence_expected = sequence + 1;
+                        sequence_valid = true;
+                        process_received_message(&msg);
                     }
+                    else {
+                        uart_stats.errors++;
+                    }
+                    message_parser_attach(&parser, frame, sizeof(frame));
                 }
             }
             break;
@@ -483,7 +487,7 @@ esp_err_t uart_send_message(uart_message_type_t type, const uint8_t* data, size_
         memcpy(msg.data, data, length);
     }
 
-    msg.checksum = calculate_checksum((const uint8_t*)&msg, sizeof(uart_message_t));
+    // Sequence number and CRC are added when the frame is encoded
     msg.end_byte = 0x55;
 
     return uart_send_raw_message(&msg);
@@ -507,6 +511,22 @@ esp_err_t uart_send_game_data(const char* data_type, const char* game_data, cons
         sizeof(game_payload));
 }
 
+esp_err_t uart_send_game_state(const game_state_t* state) {
+    uint8_t payload[GAME_STATE_MAX_SIZE];
+    size_t length = game_state_encode(state, payload);
+
+    ESP_LOGI(TAG, "Sending game state: tick=%lu, players=%d, %zu bytes",
+        state->tick, state->player_count, length);
+
+    return uart_send_message(UART_MSG_GAME_STATE, payload, length);
+}
+
+esp_err_t uart_send_body_sync(const uint8_t* payload, size_t length) {
+    ESP_LOGD(TAG, "Sending body sync: kind=%d, player=%d, %zu bytes", payload[0], payload[1], length);
+
+    return uart_send_message(UART_MSG_BODY_SYNC, payload, length);
+}
+
 esp_err_t uart_send_chat_message(const char* message, const char* sender, const char* chat_type) {
     uart_chat_message_t chat_payload;
     memset(&chat_payload, 0, sizeof(chat_payload));
@@ -678,5 +698,6 @@ void uart_print_stats(void) {
     ESP_LOGI(TAG, "  Messages sent: %" PRIu32, uart_stats.messages_sent);
     ESP_LOGI(TAG, "  Messages received: %" PRIu32, uart_stats.messages_received);
     ESP_LOGI(TAG, "  Errors: %" PRIu32, uart_stats.errors);
-    ESP_LOGI(TAG, "  Checksum errors: %" PRIu32, uart_stats.checksum_errors);
+    ESP_LOGI(TAG, "  CRC errors: %" PRIu32, uart_stats.crc_errors);
+    ESP_LOGI(TAG, "  Frames lost: %" PRIu32, uart_stats.frames_lost);
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 
 // Include common status types from STM32 folder
 #include "../../Core/Inc/Console_Peripherals/Hardware/common_status_types.h"
+#include "./helpers/game-state/game_state_encoder.h"
 
 // UART Configuration
 #define UART_PORT_NUM           UART_NUM_2
@@ -40,6 +41,10 @@
 #define UART_MAX_MESSAGE_LENGTH (256)
 #define UART_TIMEOUT_MS         (1000)
 
+// Frame Format - serial_frame.h, the codec the STM32 builds as well:
+//   0x00 | COBS( type | length | sequence lo | sequence hi | payload | CRC, 4 bytes LE ) | 0x00
+#include "../../Core/Inc/Utils/serial_frame.h"
+
 // WebSocket Protocol Message Types (for ESP32 to send to server)
 #define WS_MSG_TYPE_CONNECTION              "connection"
 #define WS_MSG_TYPE_TILE_SIZE_VALIDATION    "tile_size_validation"
@@ -58,16 +63,18 @@ typedef enum {
     UART_MSG_NACK = 0x06,
     UART_MSG_HEARTBEAT = 0x07,
     UART_MSG_CHAT = 0x08,
-    UART_MSG_TILE_SIZE_VALIDATION = 0x09 // For TileSizeValidationMessage
+    UART_MSG_TILE_SIZE_VALIDATION = 0x09, // For TileSizeValidationMessage
+    UART_MSG_GAME_STATE = 0x0A, // Binary game state, see game_state_encoder.h
+    UART_MSG_BODY_SYNC = 0x0B // One player's body, see body_sync_encoder.h
 } uart_message_type_t;
 
-// Message Structure
+// Message Structure - held in memory only, the wire carries the frame above
 typedef struct {
     uint8_t start_byte;     // 0xAA - Start delimiter
     uint8_t msg_type;       // Message type from uart_message_type_t
     uint8_t length;         // Data length (0-250)
     uint8_t data[250];      // Payload data
-    uint8_t checksum;       // Simple checksum
+    uint8_t checksum;       // Not used, the frame has a CRC
     uint8_t end_byte;       // 0x55 - End delimiter
 } uart_message_t;
 
@@ -137,6 +144,8 @@ esp_err_t uart_comm_init(void);
 esp_err_t uart_comm_deinit(void);
 esp_err_t uart_send_message(uart_message_type_t type, const uint8_t* data, size_t length);
 esp_err_t uart_send_game_data(const char* data_type, const char* game_data, const char* metadata);
+esp_err_t uart_send_game_state(const game_state_t* state);
+esp_err_t uart_send_body_sync(const uint8_t* payload, size_t length);
 esp_err_t uart_send_chat_message(const char* message, const char* sender, const char* chat_type);
 esp_err_t uart_send_command(const char* command, const char* parameters);
 esp_err_t uart_send_status(system_status_type_t system_status, uint8_t error_code, const char* message);
@@ -21,8 +21,10 @@ typedef struct {
     char command_data[128];
     char session_id[64];
     char status_data[128];
+    game_state_t game_state;
     bool found_type;
     bool found_id;
+    bool found_game_state;
 } msgpack_parse_data_t;
 
 // WebSocket client handle (global for access from callbacks and helpers)
@@ -236,6 +238,18 @@ static void process_msgpack_data(const uint8_t* data, size_t len) {
                     g_parse_data.status_data[sizeof(g_parse_data.status_data) - 1] = '\0';
                 }
             }
+            else if (cmp_object_is_map(&value_obj)) {
+                // Structured game state - encoded for the STM32 as it is read, no text in between
+                uint32_t state_size;
+                if (!cmp_object_as_map(&value_obj, &state_size) ||
+                    !game_state_read_msgpack(&cmp, state_size, &g_parse_data.game_state)) {
+                    ESP_LOGE(TAG, "Invalid game state map");
+                    return;
+                }
+                g_parse_data.found_game_state = true;
+                ESP_LOGI(TAG, "Found game state: tick=%" PRIu32 ", players=%d",
+                    g_parse_data.game_state.tick, g_parse_data.game_state.player_count);
+            }
         }
         else if (strcmp(key, "player_id") == 0) {
             if (cmp_object_is_str(&value_obj)) {
@@ -316,11 +330,17 @@ static void process_msgpack_data(const uint8_t* data, size_t len) {
             }
         }
 
-        // Route all messages to STM32 converter
-        ws_to_stm32_process_server_message(g_parse_data.type_str, g_parse_data.message_id, g_parse_data.message_text,
-            g_parse_data.data_type, g_parse_data.game_data, g_parse_data.metadata,
-            g_parse_data.status_type, g_parse_data.command, g_parse_data.command_data,
-            g_parse_data.session_id, g_parse_data.player_id, g_parse_data.status_data);
+        if (g_parse_data.found_game_state) {
+            // Structured state goes to the STM32 as the binary game state message
+            ws_to_stm32_handle_game_state(&g_parse_data.game_state);
+        }
+        else {
+            // Route all messages to STM32 converter
+            ws_to_stm32_process_server_message(g_parse_data.type_str, g_parse_data.message_id, g_parse_data.message_text,
+                g_parse_data.data_type, g_parse_data.game_data, g_parse_data.metadata,
+                g_parse_data.status_type, g_parse_data.command, g_parse_data.command_data,
+                g_parse_data.session_id, g_parse_data.player_id, g_parse_data.status_data);
+        }
 
         // Call game callback if registered (for compatibility)
         if (game_callback && strlen(g_parse_data.data_type) > 0) {